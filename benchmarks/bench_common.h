@@ -0,0 +1,60 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2014-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef PCL_BENCHMARKS_BENCH_COMMON_H_
+#define PCL_BENCHMARKS_BENCH_COMMON_H_
+
+#include <pcl/point_cloud.h>
+#include <pcl/common/generate.h>
+
+/** \brief Fill a cloud with \a nr_points points drawn uniformly in [-extent, extent]^3. The seed is fixed,
+  * so that every run of a benchmark works on the same data. Only x, y and z are set.
+  * \param[in] nr_points the number of points
+  * \param[in] extent the half size of the cube holding the points
+  * \param[out] output the generated unorganized cloud
+  */
+template <typename PointT> inline void
+generateUniformCloud (int nr_points, float extent, pcl::PointCloud<PointT> &output)
+{
+  pcl::common::UniformGenerator<float>::Parameters params (-extent, extent, 42);
+  pcl::common::CloudGenerator<PointT, pcl::common::UniformGenerator<float> > generator (params);
+  generator.fill (nr_points, 1, output);
+}
+
+#endif  // PCL_BENCHMARKS_BENCH_COMMON_H_
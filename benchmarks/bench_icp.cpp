@@ -0,0 +1,126 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2014-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * $Id$
+ *
+ */
+
+#include <benchmark/benchmark.h>
+#include <pcl/point_types.h>
+#include <pcl/common/transforms.h>
+#include <pcl/io/pcd_io.h>
+#include <pcl/registration/icp.h>
+
+#include "bench_common.h"
+
+using namespace pcl;
+
+PointCloud<PointXYZ>::Ptr cloud_source (new PointCloud<PointXYZ>);
+PointCloud<PointXYZ>::Ptr cloud_target (new PointCloud<PointXYZ>);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+BM_IterativeClosestPoint_Fixture (benchmark::State &state)
+{
+  IterativeClosestPoint<PointXYZ, PointXYZ> icp;
+  icp.setInputSource (cloud_source);
+  icp.setInputTarget (cloud_target);
+  icp.setMaxCorrespondenceDistance (0.05);
+  icp.setMaximumIterations (static_cast<int> (state.range (0)));
+  icp.setTransformationEpsilon (0);
+  icp.setEuclideanFitnessEpsilon (0);
+
+  PointCloud<PointXYZ> output;
+  while (state.KeepRunning ())
+  {
+    icp.align (output);
+    benchmark::DoNotOptimize (output.points.data ());
+  }
+  state.counters["fitness_score"] = icp.getFitnessScore ();
+}
+BENCHMARK (BM_IterativeClosestPoint_Fixture)->Arg (10)->Arg (50)->Unit (benchmark::kMillisecond);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+BM_IterativeClosestPoint_Synthetic (benchmark::State &state)
+{
+  PointCloud<PointXYZ>::Ptr target (new PointCloud<PointXYZ>);
+  generateUniformCloud (static_cast<int> (state.range (0)), 1.0f, *target);
+
+  Eigen::Affine3f transform = Eigen::Affine3f::Identity ();
+  transform.translation () << 0.02f, -0.01f, 0.01f;
+  transform.rotate (Eigen::AngleAxisf (0.05f, Eigen::Vector3f::UnitZ ()));
+  PointCloud<PointXYZ>::Ptr source (new PointCloud<PointXYZ>);
+  transformPointCloud (*target, *source, transform);
+
+  IterativeClosestPoint<PointXYZ, PointXYZ> icp;
+  icp.setInputSource (source);
+  icp.setInputTarget (target);
+  icp.setMaxCorrespondenceDistance (0.1);
+  icp.setMaximumIterations (20);
+  icp.setTransformationEpsilon (0);
+  icp.setEuclideanFitnessEpsilon (0);
+
+  PointCloud<PointXYZ> output;
+  while (state.KeepRunning ())
+  {
+    icp.align (output);
+    benchmark::DoNotOptimize (output.points.data ());
+  }
+  state.SetItemsProcessed (state.iterations () * source->points.size ());
+}
+BENCHMARK (BM_IterativeClosestPoint_Synthetic)->RangeMultiplier (4)->Range (1 << 12, 1 << 16)->Unit (benchmark::kMillisecond);
+
+/* ---[ */
+int
+main (int argc, char** argv)
+{
+  benchmark::Initialize (&argc, argv);
+  if (argc < 3)
+  {
+    std::cerr << "No test files given. Please download `bun0.pcd` and `bun4.pcd` and pass their paths to the benchmark." << std::endl;
+    return (-1);
+  }
+
+  if (io::loadPCDFile (argv[1], *cloud_source) < 0 || io::loadPCDFile (argv[2], *cloud_target) < 0)
+  {
+    std::cerr << "Failed to read test files. Please download `bun0.pcd` and `bun4.pcd` and pass their paths to the benchmark." << std::endl;
+    return (-1);
+  }
+
+  benchmark::RunSpecifiedBenchmarks ();
+  return (0);
+}
+/* ]--- */
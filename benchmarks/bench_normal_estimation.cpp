@@ -0,0 +1,134 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2014-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * $Id$
+ *
+ */
+
+#include <benchmark/benchmark.h>
+#include <pcl/point_types.h>
+#include <pcl/io/pcd_io.h>
+#include <pcl/search/kdtree.h>
+#include <pcl/features/normal_3d.h>
+#include <pcl/features/normal_3d_omp.h>
+
+#include "bench_common.h"
+
+using namespace pcl;
+
+PointCloud<PointXYZ>::Ptr cloud (new PointCloud<PointXYZ>);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+BM_NormalEstimation_Fixture (benchmark::State &state)
+{
+  NormalEstimation<PointXYZ, Normal> ne;
+  ne.setInputCloud (cloud);
+  ne.setSearchMethod (search::KdTree<PointXYZ>::Ptr (new search::KdTree<PointXYZ>));
+  ne.setKSearch (static_cast<int> (state.range (0)));
+
+  PointCloud<Normal> output;
+  while (state.KeepRunning ())
+  {
+    ne.compute (output);
+    benchmark::DoNotOptimize (output.points.data ());
+  }
+  state.SetItemsProcessed (state.iterations () * cloud->points.size ());
+}
+BENCHMARK (BM_NormalEstimation_Fixture)->Arg (10)->Arg (30)->Unit (benchmark::kMillisecond);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+BM_NormalEstimationOMP_Fixture (benchmark::State &state)
+{
+  NormalEstimationOMP<PointXYZ, Normal> ne (static_cast<unsigned int> (state.range (1)));
+  ne.setInputCloud (cloud);
+  ne.setSearchMethod (search::KdTree<PointXYZ>::Ptr (new search::KdTree<PointXYZ>));
+  ne.setKSearch (static_cast<int> (state.range (0)));
+
+  PointCloud<Normal> output;
+  while (state.KeepRunning ())
+  {
+    ne.compute (output);
+    benchmark::DoNotOptimize (output.points.data ());
+  }
+  state.SetItemsProcessed (state.iterations () * cloud->points.size ());
+}
+BENCHMARK (BM_NormalEstimationOMP_Fixture)->Args ({10, 0})->Args ({30, 0})->Args ({30, 1})->Args ({30, 4})
+  ->Unit (benchmark::kMillisecond)->UseRealTime ();
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+BM_NormalEstimation_Synthetic (benchmark::State &state)
+{
+  PointCloud<PointXYZ>::Ptr input (new PointCloud<PointXYZ>);
+  generateUniformCloud (static_cast<int> (state.range (0)), 1.0f, *input);
+
+  NormalEstimation<PointXYZ, Normal> ne;
+  ne.setInputCloud (input);
+  ne.setSearchMethod (search::KdTree<PointXYZ>::Ptr (new search::KdTree<PointXYZ>));
+  ne.setKSearch (20);
+
+  PointCloud<Normal> output;
+  while (state.KeepRunning ())
+  {
+    ne.compute (output);
+    benchmark::DoNotOptimize (output.points.data ());
+  }
+  state.SetItemsProcessed (state.iterations () * input->points.size ());
+}
+BENCHMARK (BM_NormalEstimation_Synthetic)->RangeMultiplier (8)->Range (1 << 12, 1 << 18)->Unit (benchmark::kMillisecond);
+
+/* ---[ */
+int
+main (int argc, char** argv)
+{
+  benchmark::Initialize (&argc, argv);
+  if (argc < 2)
+  {
+    std::cerr << "No test file given. Please download `bun0.pcd` and pass its path to the benchmark." << std::endl;
+    return (-1);
+  }
+
+  if (io::loadPCDFile (argv[1], *cloud) < 0)
+  {
+    std::cerr << "Failed to read test file. Please download `bun0.pcd` and pass its path to the benchmark." << std::endl;
+    return (-1);
+  }
+
+  benchmark::RunSpecifiedBenchmarks ();
+  return (0);
+}
+/* ]--- */
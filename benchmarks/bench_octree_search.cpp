@@ -0,0 +1,163 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2014-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * $Id$
+ *
+ */
+
+#include <benchmark/benchmark.h>
+#include <pcl/point_types.h>
+#include <pcl/filters/filter.h>
+#include <pcl/io/pcd_io.h>
+#include <pcl/octree/octree_search.h>
+
+#include "bench_common.h"
+
+using namespace pcl;
+
+PointCloud<PointXYZ>::Ptr cloud (new PointCloud<PointXYZ>);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+BM_OctreePointCloudSearch_Build (benchmark::State &state)
+{
+  const double resolution = static_cast<double> (state.range (0)) * 0.001;
+  while (state.KeepRunning ())
+  {
+    octree::OctreePointCloudSearch<PointXYZ> octree (resolution);
+    octree.setInputCloud (cloud);
+    octree.addPointsFromInputCloud ();
+    benchmark::DoNotOptimize (octree.getLeafCount ());
+  }
+  state.SetItemsProcessed (state.iterations () * cloud->points.size ());
+}
+// Resolutions of 5mm, 1cm and 5cm
+BENCHMARK (BM_OctreePointCloudSearch_Build)->Arg (5)->Arg (10)->Arg (50)->Unit (benchmark::kMillisecond);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+BM_OctreePointCloudSearch_NearestKSearch (benchmark::State &state)
+{
+  octree::OctreePointCloudSearch<PointXYZ> octree (0.01);
+  octree.setInputCloud (cloud);
+  octree.addPointsFromInputCloud ();
+  const int k = static_cast<int> (state.range (0));
+
+  std::vector<int> k_indices (k);
+  std::vector<float> k_sqr_distances (k);
+  while (state.KeepRunning ())
+  {
+    for (size_t i = 0; i < cloud->points.size (); i += 10)
+    {
+      octree.nearestKSearch (cloud->points[i], k, k_indices, k_sqr_distances);
+      benchmark::DoNotOptimize (k_indices.data ());
+    }
+  }
+  state.SetItemsProcessed (state.iterations () * ((cloud->points.size () + 9) / 10));
+}
+BENCHMARK (BM_OctreePointCloudSearch_NearestKSearch)->Arg (1)->Arg (10)->Arg (50)->Unit (benchmark::kMillisecond);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+BM_OctreePointCloudSearch_RadiusSearch (benchmark::State &state)
+{
+  octree::OctreePointCloudSearch<PointXYZ> octree (0.01);
+  octree.setInputCloud (cloud);
+  octree.addPointsFromInputCloud ();
+  const double radius = static_cast<double> (state.range (0)) * 0.001;
+
+  std::vector<int> k_indices;
+  std::vector<float> k_sqr_distances;
+  while (state.KeepRunning ())
+  {
+    for (size_t i = 0; i < cloud->points.size (); i += 10)
+    {
+      octree.radiusSearch (cloud->points[i], radius, k_indices, k_sqr_distances);
+      benchmark::DoNotOptimize (k_indices.data ());
+    }
+  }
+  state.SetItemsProcessed (state.iterations () * ((cloud->points.size () + 9) / 10));
+}
+// Radii of 5mm, 1cm and 2cm
+BENCHMARK (BM_OctreePointCloudSearch_RadiusSearch)->Arg (5)->Arg (10)->Arg (20)->Unit (benchmark::kMillisecond);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+BM_OctreePointCloudSearch_VoxelSearch_Synthetic (benchmark::State &state)
+{
+  PointCloud<PointXYZ>::Ptr input (new PointCloud<PointXYZ>);
+  generateUniformCloud (static_cast<int> (state.range (0)), 1.0f, *input);
+  octree::OctreePointCloudSearch<PointXYZ> octree (0.05);
+  octree.setInputCloud (input);
+  octree.addPointsFromInputCloud ();
+
+  std::vector<int> indices;
+  while (state.KeepRunning ())
+  {
+    for (size_t i = 0; i < input->points.size (); i += 10)
+    {
+      octree.voxelSearch (input->points[i], indices);
+      benchmark::DoNotOptimize (indices.data ());
+    }
+  }
+  state.SetItemsProcessed (state.iterations () * ((input->points.size () + 9) / 10));
+}
+BENCHMARK (BM_OctreePointCloudSearch_VoxelSearch_Synthetic)->RangeMultiplier (8)->Range (1 << 12, 1 << 21)->Unit (benchmark::kMillisecond);
+
+/* ---[ */
+int
+main (int argc, char** argv)
+{
+  benchmark::Initialize (&argc, argv);
+  if (argc < 2)
+  {
+    std::cerr << "No test file given. Please download `table_scene_mug_stereo_textured.pcd` and pass its path to the benchmark." << std::endl;
+    return (-1);
+  }
+
+  PointCloud<PointXYZ> cloud_with_nans;
+  if (io::loadPCDFile (argv[1], cloud_with_nans) < 0)
+  {
+    std::cerr << "Failed to read test file. Please download `table_scene_mug_stereo_textured.pcd` and pass its path to the benchmark." << std::endl;
+    return (-1);
+  }
+  // Queries are taken from the cloud itself, so they all need to be valid
+  std::vector<int> indices;
+  removeNaNFromPointCloud (cloud_with_nans, *cloud, indices);
+
+  benchmark::RunSpecifiedBenchmarks ();
+  return (0);
+}
+/* ]--- */
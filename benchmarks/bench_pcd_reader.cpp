@@ -0,0 +1,119 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2014-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * $Id$
+ *
+ */
+
+#include <benchmark/benchmark.h>
+#include <boost/filesystem.hpp>
+#include <pcl/point_types.h>
+#include <pcl/io/pcd_io.h>
+
+#include "bench_common.h"
+
+using namespace pcl;
+
+std::string pcd_file;
+std::string tmp_dir;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+BM_PCDReader_Fixture (benchmark::State &state)
+{
+  PCDReader reader;
+  PCLPointCloud2 output;
+  while (state.KeepRunning ())
+  {
+    if (reader.read (pcd_file, output) < 0)
+    {
+      state.SkipWithError ("Failed to read the test file");
+      break;
+    }
+  }
+  state.SetBytesProcessed (state.iterations () * output.data.size ());
+  state.SetItemsProcessed (state.iterations () * output.width * output.height);
+}
+BENCHMARK (BM_PCDReader_Fixture)->Unit (benchmark::kMillisecond);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/** \brief Write a synthetic cloud in the storage format selected by state.range (1) (0: ASCII,
+  * 1: binary, 2: binary compressed) and time reading it back.
+  */
+void
+BM_PCDReader_Synthetic (benchmark::State &state)
+{
+  static const char* formats[] = { "ascii", "binary", "binary_compressed" };
+  const int format = static_cast<int> (state.range (1));
+  const std::string file_name = tmp_dir + "/bench_pcd_reader_" + formats[format] + ".pcd";
+
+  PointCloud<PointXYZ> input;
+  generateUniformCloud (static_cast<int> (state.range (0)), 10.0f, input);
+  PCDWriter writer;
+  if (format == 0)
+    writer.writeASCII (file_name, input);
+  else if (format == 1)
+    writer.writeBinary (file_name, input);
+  else
+    writer.writeBinaryCompressed (file_name, input);
+
+  PCDReader reader;
+  PointCloud<PointXYZ> output;
+  while (state.KeepRunning ())
+    reader.read (file_name, output);
+  state.SetItemsProcessed (state.iterations () * input.points.size ());
+
+  boost::filesystem::remove (file_name);
+}
+BENCHMARK (BM_PCDReader_Synthetic)->ArgsProduct ({{1 << 16, 1 << 20}, {0, 1, 2}})->Unit (benchmark::kMillisecond);
+
+/* ---[ */
+int
+main (int argc, char** argv)
+{
+  benchmark::Initialize (&argc, argv);
+  if (argc < 2)
+  {
+    std::cerr << "No test file given. Please download `table_scene_mug_stereo_textured.pcd` and pass its path to the benchmark." << std::endl;
+    return (-1);
+  }
+
+  pcd_file = argv[1];
+  tmp_dir = boost::filesystem::temp_directory_path ().string ();
+
+  benchmark::RunSpecifiedBenchmarks ();
+  return (0);
+}
+/* ]--- */
@@ -0,0 +1,323 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2014-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <benchmark/benchmark.h>
+#include <pcl/point_types.h>
+#include <pcl/point_types_conversion.h>
+#include <pcl/common/random.h>
+#include <pcl/common/quantized_descriptors.h>
+#include <pcl/search/quantized_descriptors.h>
+#include <pcl/registration/correspondence_estimation.h>
+
+using namespace pcl;
+
+// Every benchmark matches the same number of query descriptors against libraries of growing size
+const int nr_queries = 1000;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/** \brief Fill a cloud with SHOT-like descriptors: a quarter of the bins set, normalized to unit length. The
+  * queries are the first descriptors, perturbed, so that each has a clear nearest neighbor.
+  */
+void
+generateSHOT (int nr_targets, PointCloud<SHOT352> &targets, PointCloud<SHOT352> &queries)
+{
+  common::UniformGenerator<float> generator (0.0f, 1.0f, 42);
+  targets.resize (nr_targets);
+  for (int p = 0; p < nr_targets; ++p)
+  {
+    for (int i = 0; i < 9; ++i)
+      targets[p].rf[i] = 0.0f;
+    float norm = 0.0f;
+    for (int i = 0; i < 352; ++i)
+    {
+      const float value = generator.run ();
+      targets[p].descriptor[i] = value < 0.25f ? generator.run () : 0.0f;
+      norm += targets[p].descriptor[i] * targets[p].descriptor[i];
+    }
+    for (int i = 0; i < 352; ++i)
+      targets[p].descriptor[i] /= std::sqrt (norm);
+  }
+  queries.resize (std::min (nr_queries, nr_targets));
+  for (size_t p = 0; p < queries.size (); ++p)
+  {
+    queries[p] = targets[p];
+    for (int i = 0; i < 352; ++i)
+      if (queries[p].descriptor[i] > 0.0f)
+        queries[p].descriptor[i] += 0.02f * generator.run ();
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/** \brief Fill a cloud with FPFH-like signatures: three histograms of 11 bins summing to 100 each. */
+void
+generateFPFH (int nr_targets, PointCloud<FPFHSignature33> &targets, PointCloud<FPFHSignature33> &queries)
+{
+  common::UniformGenerator<float> generator (0.0f, 1.0f, 42);
+  targets.resize (nr_targets);
+  for (int p = 0; p < nr_targets; ++p)
+  {
+    for (int h = 0; h < 3; ++h)
+    {
+      float sum = 0.0f;
+      for (int i = 0; i < 11; ++i)
+      {
+        const float value = generator.run ();
+        targets[p].histogram[h * 11 + i] = value * value * value;
+        sum += targets[p].histogram[h * 11 + i];
+      }
+      for (int i = 0; i < 11; ++i)
+        targets[p].histogram[h * 11 + i] *= 100.0f / sum;
+    }
+  }
+  queries.resize (std::min (nr_queries, nr_targets));
+  for (size_t p = 0; p < queries.size (); ++p)
+  {
+    queries[p] = targets[p];
+    for (int i = 0; i < 33; ++i)
+      queries[p].histogram[i] += 0.5f * generator.run ();
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Byte level brute force search, on range (1) threads (0 for all the cores)
+void
+BM_NearestDescriptors_QuantizedSHOT352 (benchmark::State &state)
+{
+  PointCloud<SHOT352> targets, queries;
+  generateSHOT (static_cast<int> (state.range (0)), targets, queries);
+  PointCloud<QuantizedSHOT352> quantized_targets, quantized_queries;
+  PointCloudSHOT352toQuantizedSHOT352 (targets, quantized_targets);
+  PointCloudSHOT352toQuantizedSHOT352 (queries, quantized_queries);
+
+  std::vector<int> indices;
+  std::vector<float> sqr_distances;
+  while (state.KeepRunning ())
+  {
+    nearestDescriptors (quantized_queries, quantized_targets, indices, sqr_distances,
+                        static_cast<unsigned int> (state.range (1)));
+    benchmark::DoNotOptimize (indices.data ());
+  }
+  state.SetItemsProcessed (state.iterations () * quantized_queries.size ());
+}
+BENCHMARK (BM_NearestDescriptors_QuantizedSHOT352)->ArgsProduct ({{1 << 10, 1 << 12, 1 << 14, 1 << 16}, {1, 0}})->Unit (benchmark::kMillisecond);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Reference: the same brute force search on the float descriptors
+void
+BM_BruteForce_SHOT352 (benchmark::State &state)
+{
+  PointCloud<SHOT352> targets, queries;
+  generateSHOT (static_cast<int> (state.range (0)), targets, queries);
+
+  std::vector<int> indices (queries.size ());
+  while (state.KeepRunning ())
+  {
+    for (size_t q = 0; q < queries.size (); ++q)
+    {
+      const Eigen::Map<const Eigen::Matrix<float, 352, 1> > query (queries[q].descriptor);
+      float best = std::numeric_limits<float>::max ();
+      for (size_t t = 0; t < targets.size (); ++t)
+      {
+        const float distance = (Eigen::Map<const Eigen::Matrix<float, 352, 1> > (targets[t].descriptor) - query).squaredNorm ();
+        if (distance < best)
+        {
+          best = distance;
+          indices[q] = static_cast<int> (t);
+        }
+      }
+    }
+    benchmark::DoNotOptimize (indices.data ());
+  }
+  state.SetItemsProcessed (state.iterations () * queries.size ());
+}
+BENCHMARK (BM_BruteForce_SHOT352)->RangeMultiplier (4)->Range (1 << 10, 1 << 16)->Unit (benchmark::kMillisecond);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+inline const float*
+descriptorOf (const SHOT352 &point) { return (point.descriptor); }
+
+inline const float*
+descriptorOf (const FPFHSignature33 &point) { return (point.histogram); }
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/** \brief Fraction of the correspondences whose match is the exact nearest neighbor of the float descriptors. */
+template <typename PointT, int N> double
+recall (const PointCloud<PointT> &targets, const PointCloud<PointT> &queries, const Correspondences &correspondences)
+{
+  typedef Eigen::Map<const Eigen::Matrix<float, N, 1> > Descriptor;
+  int hits = 0;
+  for (size_t c = 0; c < correspondences.size (); ++c)
+  {
+    const Descriptor query (descriptorOf (queries[correspondences[c].index_query]));
+    float best = std::numeric_limits<float>::max ();
+    int nearest = -1;
+    for (size_t t = 0; t < targets.size (); ++t)
+    {
+      const float distance = (Descriptor (descriptorOf (targets[t])) - query).squaredNorm ();
+      if (distance < best)
+      {
+        best = distance;
+        nearest = static_cast<int> (t);
+      }
+    }
+    if (correspondences[c].index_match == nearest)
+      ++hits;
+  }
+  return (static_cast<double> (hits) / static_cast<double> (queries.size ()));
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// The search of CorrespondenceEstimation (its kd-tree unless \a tree is given), built once outside of the timed loop
+template <typename PointT> void
+matchWithCorrespondenceEstimation (benchmark::State &state,
+                                   const typename PointCloud<PointT>::Ptr &targets,
+                                   const typename PointCloud<PointT>::Ptr &queries,
+                                   Correspondences &correspondences,
+                                   const typename search::KdTree<PointT>::Ptr &tree = typename search::KdTree<PointT>::Ptr ())
+{
+  registration::CorrespondenceEstimation<PointT, PointT> estimation;
+  if (tree)
+    estimation.setSearchMethodTarget (tree);
+  estimation.setInputTarget (targets);
+  estimation.setInputSource (queries);
+  estimation.determineCorrespondences (correspondences);
+  while (state.KeepRunning ())
+  {
+    estimation.determineCorrespondences (correspondences);
+    benchmark::DoNotOptimize (correspondences.data ());
+  }
+  state.SetItemsProcessed (state.iterations () * queries->size ());
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+BM_CorrespondenceEstimation_SHOT352 (benchmark::State &state)
+{
+  PointCloud<SHOT352>::Ptr targets (new PointCloud<SHOT352>), queries (new PointCloud<SHOT352>);
+  generateSHOT (static_cast<int> (state.range (0)), *targets, *queries);
+  Correspondences correspondences;
+  matchWithCorrespondenceEstimation<SHOT352> (state, targets, queries, correspondences);
+  state.counters["recall"] = recall<SHOT352, 352> (*targets, *queries, correspondences);
+}
+BENCHMARK (BM_CorrespondenceEstimation_SHOT352)->RangeMultiplier (4)->Range (1 << 10, 1 << 16)->Unit (benchmark::kMillisecond);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+BM_CorrespondenceEstimation_QuantizedSHOT352 (benchmark::State &state)
+{
+  PointCloud<SHOT352> targets, queries;
+  generateSHOT (static_cast<int> (state.range (0)), targets, queries);
+  PointCloud<QuantizedSHOT352>::Ptr quantized_targets (new PointCloud<QuantizedSHOT352>);
+  PointCloud<QuantizedSHOT352>::Ptr quantized_queries (new PointCloud<QuantizedSHOT352>);
+  PointCloudSHOT352toQuantizedSHOT352 (targets, *quantized_targets);
+  PointCloudSHOT352toQuantizedSHOT352 (queries, *quantized_queries);
+  Correspondences correspondences;
+  matchWithCorrespondenceEstimation<QuantizedSHOT352> (state, quantized_targets, quantized_queries, correspondences);
+  state.counters["recall"] = recall<SHOT352, 352> (targets, queries, correspondences);
+}
+BENCHMARK (BM_CorrespondenceEstimation_QuantizedSHOT352)->RangeMultiplier (4)->Range (1 << 10, 1 << 16)->Unit (benchmark::kMillisecond);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// CorrespondenceEstimation on the byte codes, through setSearchMethodTarget
+void
+BM_CorrespondenceEstimation_QuantizedSHOT352_ByteSearch (benchmark::State &state)
+{
+  PointCloud<SHOT352> targets, queries;
+  generateSHOT (static_cast<int> (state.range (0)), targets, queries);
+  PointCloud<QuantizedSHOT352>::Ptr quantized_targets (new PointCloud<QuantizedSHOT352>);
+  PointCloud<QuantizedSHOT352>::Ptr quantized_queries (new PointCloud<QuantizedSHOT352>);
+  PointCloudSHOT352toQuantizedSHOT352 (targets, *quantized_targets);
+  PointCloudSHOT352toQuantizedSHOT352 (queries, *quantized_queries);
+  search::KdTree<QuantizedSHOT352>::Ptr byte_search (new search::QuantizedDescriptorSearch<QuantizedSHOT352>);
+  Correspondences correspondences;
+  matchWithCorrespondenceEstimation<QuantizedSHOT352> (state, quantized_targets, quantized_queries, correspondences, byte_search);
+  state.counters["recall"] = recall<SHOT352, 352> (targets, queries, correspondences);
+}
+BENCHMARK (BM_CorrespondenceEstimation_QuantizedSHOT352_ByteSearch)->RangeMultiplier (4)->Range (1 << 10, 1 << 16)->Unit (benchmark::kMillisecond);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+BM_NearestDescriptors_QuantizedFPFHSignature33 (benchmark::State &state)
+{
+  PointCloud<FPFHSignature33> targets, queries;
+  generateFPFH (static_cast<int> (state.range (0)), targets, queries);
+  PointCloud<QuantizedFPFHSignature33> quantized_targets, quantized_queries;
+  PointCloudFPFHSignature33toQuantizedFPFHSignature33 (targets, quantized_targets);
+  PointCloudFPFHSignature33toQuantizedFPFHSignature33 (queries, quantized_queries);
+
+  std::vector<int> indices;
+  std::vector<float> sqr_distances;
+  while (state.KeepRunning ())
+  {
+    nearestDescriptors (quantized_queries, quantized_targets, indices, sqr_distances,
+                        static_cast<unsigned int> (state.range (1)));
+    benchmark::DoNotOptimize (indices.data ());
+  }
+  state.SetItemsProcessed (state.iterations () * quantized_queries.size ());
+}
+BENCHMARK (BM_NearestDescriptors_QuantizedFPFHSignature33)->ArgsProduct ({{1 << 10, 1 << 12, 1 << 14, 1 << 16}, {1, 0}})->Unit (benchmark::kMillisecond);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+BM_CorrespondenceEstimation_FPFHSignature33 (benchmark::State &state)
+{
+  PointCloud<FPFHSignature33>::Ptr targets (new PointCloud<FPFHSignature33>), queries (new PointCloud<FPFHSignature33>);
+  generateFPFH (static_cast<int> (state.range (0)), *targets, *queries);
+  Correspondences correspondences;
+  matchWithCorrespondenceEstimation<FPFHSignature33> (state, targets, queries, correspondences);
+  state.counters["recall"] = recall<FPFHSignature33, 33> (*targets, *queries, correspondences);
+}
+BENCHMARK (BM_CorrespondenceEstimation_FPFHSignature33)->RangeMultiplier (4)->Range (1 << 10, 1 << 16)->Unit (benchmark::kMillisecond);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+BM_CorrespondenceEstimation_QuantizedFPFHSignature33_ByteSearch (benchmark::State &state)
+{
+  PointCloud<FPFHSignature33> targets, queries;
+  generateFPFH (static_cast<int> (state.range (0)), targets, queries);
+  PointCloud<QuantizedFPFHSignature33>::Ptr quantized_targets (new PointCloud<QuantizedFPFHSignature33>);
+  PointCloud<QuantizedFPFHSignature33>::Ptr quantized_queries (new PointCloud<QuantizedFPFHSignature33>);
+  PointCloudFPFHSignature33toQuantizedFPFHSignature33 (targets, *quantized_targets);
+  PointCloudFPFHSignature33toQuantizedFPFHSignature33 (queries, *quantized_queries);
+  search::KdTree<QuantizedFPFHSignature33>::Ptr byte_search (new search::QuantizedDescriptorSearch<QuantizedFPFHSignature33>);
+  Correspondences correspondences;
+  matchWithCorrespondenceEstimation<QuantizedFPFHSignature33> (state, quantized_targets, quantized_queries, correspondences, byte_search);
+  state.counters["recall"] = recall<FPFHSignature33, 33> (targets, queries, correspondences);
+}
+BENCHMARK (BM_CorrespondenceEstimation_QuantizedFPFHSignature33_ByteSearch)->RangeMultiplier (4)->Range (1 << 10, 1 << 16)->Unit (benchmark::kMillisecond);
+
+BENCHMARK_MAIN ();
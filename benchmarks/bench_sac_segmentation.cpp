@@ -0,0 +1,133 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2014-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * $Id$
+ *
+ */
+
+#include <benchmark/benchmark.h>
+#include <pcl/point_types.h>
+#include <pcl/common/random.h>
+#include <pcl/io/pcd_io.h>
+#include <pcl/sample_consensus/method_types.h>
+#include <pcl/sample_consensus/model_types.h>
+#include <pcl/segmentation/sac_segmentation.h>
+
+using namespace pcl;
+
+PointCloud<PointXYZ>::Ptr cloud (new PointCloud<PointXYZ>);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/** \brief Generate a noisy z = 0 plane covering a fraction of the points and uniform clutter for the rest. */
+void
+generatePlaneWithOutliers (int nr_points, float inlier_ratio, PointCloud<PointXYZ> &output)
+{
+  common::UniformGenerator<float> uniform (-1.0f, 1.0f, 42);
+  common::NormalGenerator<float> noise (0.0f, 0.002f, 43);
+  output.points.resize (nr_points);
+  output.width = nr_points;
+  output.height = 1;
+  output.is_dense = true;
+  const int nr_inliers = static_cast<int> (inlier_ratio * static_cast<float> (nr_points));
+  for (int i = 0; i < nr_points; ++i)
+  {
+    output.points[i].x = uniform.run ();
+    output.points[i].y = uniform.run ();
+    output.points[i].z = i < nr_inliers ? noise.run () : uniform.run ();
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+runPlaneSegmentation (benchmark::State &state, const PointCloud<PointXYZ>::ConstPtr &input, int method)
+{
+  SACSegmentation<PointXYZ> seg;
+  seg.setInputCloud (input);
+  seg.setModelType (SACMODEL_PLANE);
+  seg.setMethodType (method);
+  seg.setDistanceThreshold (0.01);
+  seg.setMaxIterations (1000);
+  seg.setOptimizeCoefficients (true);
+
+  PointIndices inliers;
+  ModelCoefficients coefficients;
+  while (state.KeepRunning ())
+  {
+    seg.segment (inliers, coefficients);
+    benchmark::DoNotOptimize (inliers.indices.data ());
+  }
+  state.SetItemsProcessed (state.iterations () * input->points.size ());
+  state.counters["inliers"] = static_cast<double> (inliers.indices.size ());
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+BM_SACSegmentation_Plane_Fixture (benchmark::State &state)
+{
+  runPlaneSegmentation (state, cloud, static_cast<int> (state.range (0)));
+}
+BENCHMARK (BM_SACSegmentation_Plane_Fixture)->Arg (SAC_RANSAC)->Arg (SAC_MSAC)->Arg (SAC_LMEDS)->Unit (benchmark::kMillisecond);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+BM_SACSegmentation_Plane_Synthetic (benchmark::State &state)
+{
+  PointCloud<PointXYZ>::Ptr input (new PointCloud<PointXYZ>);
+  generatePlaneWithOutliers (static_cast<int> (state.range (0)), 0.5f, *input);
+  runPlaneSegmentation (state, input, SAC_RANSAC);
+}
+BENCHMARK (BM_SACSegmentation_Plane_Synthetic)->RangeMultiplier (8)->Range (1 << 12, 1 << 21)->Unit (benchmark::kMillisecond);
+
+/* ---[ */
+int
+main (int argc, char** argv)
+{
+  benchmark::Initialize (&argc, argv);
+  if (argc < 2)
+  {
+    std::cerr << "No test file given. Please download `sac_plane_test.pcd` and pass its path to the benchmark." << std::endl;
+    return (-1);
+  }
+
+  if (io::loadPCDFile (argv[1], *cloud) < 0)
+  {
+    std::cerr << "Failed to read test file. Please download `sac_plane_test.pcd` and pass its path to the benchmark." << std::endl;
+    return (-1);
+  }
+
+  benchmark::RunSpecifiedBenchmarks ();
+  return (0);
+}
+/* ]--- */
@@ -0,0 +1,146 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2014-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <benchmark/benchmark.h>
+#include <pcl/point_types.h>
+#include <pcl/common/transforms.h>
+
+#include "bench_common.h"
+
+using namespace pcl;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+Eigen::Affine3f
+getTransform ()
+{
+  return (Eigen::Translation3f (1.0f, -2.0f, 0.5f) * Eigen::AngleAxisf (0.4f, Eigen::Vector3f::UnitZ ()));
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Reference: the point by point scalar loop transformPointCloud used before
+void
+BM_TransformPointCloud_Scalar (benchmark::State &state)
+{
+  PointCloud<PointXYZ> input, output;
+  generateUniformCloud (static_cast<int> (state.range (0)), 10.0f, input);
+  const Eigen::Affine3f transform = getTransform ();
+
+  while (state.KeepRunning ())
+  {
+    output = input;
+    for (size_t i = 0; i < output.size (); ++i)
+    {
+      const Eigen::Vector3f pt (input[i].x, input[i].y, input[i].z);
+      output[i].x = transform (0, 0) * pt[0] + transform (0, 1) * pt[1] + transform (0, 2) * pt[2] + transform (0, 3);
+      output[i].y = transform (1, 0) * pt[0] + transform (1, 1) * pt[1] + transform (1, 2) * pt[2] + transform (1, 3);
+      output[i].z = transform (2, 0) * pt[0] + transform (2, 1) * pt[1] + transform (2, 2) * pt[2] + transform (2, 3);
+    }
+    benchmark::DoNotOptimize (output.points.data ());
+  }
+  state.SetItemsProcessed (state.iterations () * input.size ());
+}
+BENCHMARK (BM_TransformPointCloud_Scalar)->RangeMultiplier (8)->Range (1 << 12, 1 << 21)->Unit (benchmark::kMicrosecond);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+BM_TransformPointCloud (benchmark::State &state)
+{
+  PointCloud<PointXYZ> input, output;
+  generateUniformCloud (static_cast<int> (state.range (0)), 10.0f, input);
+  const Eigen::Affine3f transform = getTransform ();
+
+  while (state.KeepRunning ())
+  {
+    transformPointCloud (input, output, transform);
+    benchmark::DoNotOptimize (output.points.data ());
+  }
+  state.SetItemsProcessed (state.iterations () * input.size ());
+}
+BENCHMARK (BM_TransformPointCloud)->RangeMultiplier (8)->Range (1 << 12, 1 << 21)->Unit (benchmark::kMicrosecond);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+BM_TransformPointCloud_InPlace (benchmark::State &state)
+{
+  PointCloud<PointXYZ> cloud;
+  generateUniformCloud (static_cast<int> (state.range (0)), 10.0f, cloud);
+  const Eigen::Affine3f transform = getTransform ();
+
+  while (state.KeepRunning ())
+  {
+    transformPointCloud (cloud, transform);
+    benchmark::DoNotOptimize (cloud.points.data ());
+  }
+  state.SetItemsProcessed (state.iterations () * cloud.size ());
+}
+BENCHMARK (BM_TransformPointCloud_InPlace)->RangeMultiplier (8)->Range (1 << 12, 1 << 21)->Unit (benchmark::kMicrosecond);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+BM_TransformPointCloud_Double (benchmark::State &state)
+{
+  PointCloud<PointXYZ> input, output;
+  generateUniformCloud (static_cast<int> (state.range (0)), 10.0f, input);
+  const Eigen::Affine3d transform = getTransform ().cast<double> ();
+
+  while (state.KeepRunning ())
+  {
+    transformPointCloud (input, output, transform);
+    benchmark::DoNotOptimize (output.points.data ());
+  }
+  state.SetItemsProcessed (state.iterations () * input.size ());
+}
+BENCHMARK (BM_TransformPointCloud_Double)->RangeMultiplier (8)->Range (1 << 12, 1 << 21)->Unit (benchmark::kMicrosecond);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+BM_TransformPointCloudWithNormals (benchmark::State &state)
+{
+  PointCloud<PointNormal> input, output;
+  generateUniformCloud (static_cast<int> (state.range (0)), 10.0f, input);
+  const Eigen::Affine3f transform = getTransform ();
+
+  while (state.KeepRunning ())
+  {
+    transformPointCloudWithNormals (input, output, transform);
+    benchmark::DoNotOptimize (output.points.data ());
+  }
+  state.SetItemsProcessed (state.iterations () * input.size ());
+}
+BENCHMARK (BM_TransformPointCloudWithNormals)->RangeMultiplier (8)->Range (1 << 12, 1 << 21)->Unit (benchmark::kMicrosecond);
+
+BENCHMARK_MAIN ();
@@ -0,0 +1,113 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2014-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * $Id$
+ *
+ */
+
+#include <benchmark/benchmark.h>
+#include <pcl/point_types.h>
+#include <pcl/io/pcd_io.h>
+#include <pcl/filters/voxel_grid.h>
+
+#include "bench_common.h"
+
+using namespace pcl;
+
+PointCloud<PointXYZ>::Ptr cloud (new PointCloud<PointXYZ>);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+BM_VoxelGrid_Fixture (benchmark::State &state)
+{
+  const float leaf_size = static_cast<float> (state.range (0)) * 0.001f;
+  VoxelGrid<PointXYZ> grid;
+  grid.setInputCloud (cloud);
+  grid.setLeafSize (leaf_size, leaf_size, leaf_size);
+
+  PointCloud<PointXYZ> output;
+  while (state.KeepRunning ())
+  {
+    grid.filter (output);
+    benchmark::DoNotOptimize (output.points.data ());
+  }
+  state.SetItemsProcessed (state.iterations () * cloud->points.size ());
+  state.counters["output_points"] = static_cast<double> (output.points.size ());
+}
+// Leaf sizes of 5mm, 1cm and 5cm
+BENCHMARK (BM_VoxelGrid_Fixture)->Arg (5)->Arg (10)->Arg (50)->Unit (benchmark::kMillisecond);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+BM_VoxelGrid_Synthetic (benchmark::State &state)
+{
+  PointCloud<PointXYZ>::Ptr input (new PointCloud<PointXYZ>);
+  generateUniformCloud (static_cast<int> (state.range (0)), 10.0f, *input);
+
+  VoxelGrid<PointXYZ> grid;
+  grid.setInputCloud (input);
+  grid.setLeafSize (0.1f, 0.1f, 0.1f);
+
+  PointCloud<PointXYZ> output;
+  while (state.KeepRunning ())
+  {
+    grid.filter (output);
+    benchmark::DoNotOptimize (output.points.data ());
+  }
+  state.SetItemsProcessed (state.iterations () * input->points.size ());
+}
+BENCHMARK (BM_VoxelGrid_Synthetic)->RangeMultiplier (8)->Range (1 << 12, 1 << 21)->Unit (benchmark::kMillisecond);
+
+/* ---[ */
+int
+main (int argc, char** argv)
+{
+  benchmark::Initialize (&argc, argv);
+  if (argc < 2)
+  {
+    std::cerr << "No test file given. Please download `table_scene_mug_stereo_textured.pcd` and pass its path to the benchmark." << std::endl;
+    return (-1);
+  }
+
+  if (io::loadPCDFile (argv[1], *cloud) < 0)
+  {
+    std::cerr << "Failed to read test file. Please download `table_scene_mug_stereo_textured.pcd` and pass its path to the benchmark." << std::endl;
+    return (-1);
+  }
+
+  benchmark::RunSpecifiedBenchmarks ();
+  return (0);
+}
+/* ]--- */
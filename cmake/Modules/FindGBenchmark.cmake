@@ -0,0 +1,41 @@
+###############################################################################
+# Find Google Benchmark
+#
+# This sets the following variables:
+# GBENCHMARK_FOUND - True if Google Benchmark was found.
+# GBENCHMARK_INCLUDE_DIRS - Directories containing the Google Benchmark include files.
+# GBENCHMARK_LIBRARIES - Libraries needed to use Google Benchmark.
+
+if(CMAKE_SYSTEM_NAME STREQUAL Linux)
+    set(CMAKE_INCLUDE_PATH ${CMAKE_INCLUDE_PATH} /usr /usr/local)
+endif(CMAKE_SYSTEM_NAME STREQUAL Linux)
+if(APPLE)
+  list(APPEND CMAKE_INCLUDE_PATH /opt/local)
+  set(CMAKE_FIND_FRAMEWORK NEVER)
+endif()
+
+find_path(GBENCHMARK_INCLUDE_DIR benchmark/benchmark.h
+    HINTS "${GBENCHMARK_ROOT}" "$ENV{GBENCHMARK_ROOT}"
+    PATHS "$ENV{PROGRAMFILES}/benchmark" "$ENV{PROGRAMW6432}/benchmark"
+    PATH_SUFFIXES include)
+
+find_library(GBENCHMARK_LIBRARY benchmark
+    HINTS "${GBENCHMARK_ROOT}" "$ENV{GBENCHMARK_ROOT}"
+    PATHS "$ENV{PROGRAMFILES}/benchmark" "$ENV{PROGRAMW6432}/benchmark"
+    PATH_SUFFIXES lib lib64)
+
+set(GBENCHMARK_INCLUDE_DIRS ${GBENCHMARK_INCLUDE_DIR})
+set(GBENCHMARK_LIBRARIES ${GBENCHMARK_LIBRARY})
+if(WIN32)
+  list(APPEND GBENCHMARK_LIBRARIES shlwapi)
+endif(WIN32)
+set(CMAKE_FIND_FRAMEWORK)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(GBenchmark DEFAULT_MSG GBENCHMARK_INCLUDE_DIR GBENCHMARK_LIBRARY)
+
+mark_as_advanced(GBENCHMARK_INCLUDE_DIR GBENCHMARK_LIBRARY)
+
+if(GBENCHMARK_FOUND)
+  message(STATUS "Google Benchmark found (include: ${GBENCHMARK_INCLUDE_DIRS}, lib: ${GBENCHMARK_LIBRARIES})")
+endif(GBENCHMARK_FOUND)
@@ -455,6 +455,63 @@ macro(PCL_ADD_TEST _name _exename)
     add_dependencies(tests ${_exename})
 endmacro(PCL_ADD_TEST)
 
+###############################################################################
+# Add a benchmark target.
+# Running the "benchmarks" target executes every benchmark and stores its
+# results as JSON in ${PCL_BENCHMARK_OUTPUT_DIR}/${_name}.json.
+# _name The benchmark name.
+# _exename The exe name.
+# ARGN :
+#    FILES the source files for the benchmark
+#    ARGUMENTS Arguments for benchmark executable
+#    LINK_WITH link benchmark executable with libraries
+macro(PCL_ADD_BENCHMARK _name _exename)
+    set(options)
+    set(oneValueArgs)
+    set(multiValueArgs FILES ARGUMENTS LINK_WITH)
+    cmake_parse_arguments(PCL_ADD_BENCHMARK "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN} )
+    add_executable(${_exename} ${PCL_ADD_BENCHMARK_FILES})
+    if(NOT WIN32)
+      set_target_properties(${_exename} PROPERTIES RUNTIME_OUTPUT_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR})
+    endif(NOT WIN32)
+    if(PCL_BENCHMARK_CXX_FLAGS)
+      set_target_properties(${_exename} PROPERTIES COMPILE_FLAGS "${PCL_BENCHMARK_CXX_FLAGS}")
+    endif(PCL_BENCHMARK_CXX_FLAGS)
+    target_link_libraries(${_exename} ${PCL_ADD_BENCHMARK_LINK_WITH} ${GBENCHMARK_LIBRARIES} ${CLANG_LIBRARIES})
+    #
+    # Only link if needed
+    if(CMAKE_SYSTEM_NAME STREQUAL "Darwin")
+      if(NOT CMAKE_CXX_COMPILER_ID STREQUAL "Clang")
+        set_target_properties(${_exename} PROPERTIES LINK_FLAGS -Wl)
+      endif()
+      target_link_libraries(${_exename} pthread)
+    elseif(UNIX AND NOT ANDROID)
+      set_target_properties(${_exename} PROPERTIES LINK_FLAGS -Wl,--as-needed)
+      # Google Benchmark requires pthread
+      target_link_libraries(${_exename} pthread)
+    elseif(CMAKE_COMPILER_IS_GNUCXX AND MINGW)
+      set_target_properties(${_exename} PROPERTIES LINK_FLAGS "-Wl,--allow-multiple-definition -Wl,--as-needed")
+    elseif(WIN32)
+      set_target_properties(${_exename} PROPERTIES LINK_FLAGS_RELEASE /OPT:REF)
+    endif()
+    #
+    # must link explicitly against boost only on Windows
+    target_link_libraries(${_exename} ${Boost_LIBRARIES})
+    #
+    if(USE_PROJECT_FOLDERS)
+      set_target_properties(${_exename} PROPERTIES FOLDER "Benchmarks")
+    endif(USE_PROJECT_FOLDERS)
+
+    add_custom_target(run_${_exename}
+                      COMMAND ${_exename} ${PCL_ADD_BENCHMARK_ARGUMENTS}
+                              "--benchmark_out=${PCL_BENCHMARK_OUTPUT_DIR}/${_name}.json"
+                              "--benchmark_out_format=json"
+                      DEPENDS ${_exename}
+                      WORKING_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR}
+                      VERBATIM)
+    add_dependencies(benchmarks run_${_exename})
+endmacro(PCL_ADD_BENCHMARK)
+
 ###############################################################################
 # Add an example target.
 # _name The example name.
@@ -0,0 +1,303 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2014-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PCL_COLUMNAR_POINT_CLOUD_H_
+#define PCL_COLUMNAR_POINT_CLOUD_H_
+
+#include <string>
+#include <vector>
+#include <pcl/pcl_macros.h>
+#include <pcl/PCLHeader.h>
+#include <pcl/PCLPointField.h>
+#include <pcl/PCLPointCloud2.h>
+#include <pcl/point_cloud.h>
+#include <pcl/point_traits.h>
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+namespace pcl
+{
+  /** \brief ColumnarPointCloud stores a point cloud field by field (structure of arrays):
+    * every field described by a pcl::PCLPointField gets its own contiguous array, holding
+    * \a count consecutive values of type \a datatype per point. The \a offset member of
+    * the fields is unused and always 0.
+    *
+    * Kernels that only touch a few fields (e.g. x, y and z) stream through exactly the
+    * memory they need.
+    * Use pcl::toColumnarPointCloud and pcl::fromColumnarPointCloud to convert from/to a
+    * pcl::PointCloud<PointT>, and pcl::toPCLPointCloud2 / pcl::fromPCLPointCloud2 for
+    * the binary blob representation.
+    *
+    * \code
+    * pcl::ColumnarPointCloud columnar;
+    * pcl::toColumnarPointCloud (*cloud, columnar);
+    * Eigen::Vector4f centroid;
+    * pcl::compute3DCentroid (columnar, centroid);
+    * const float *x = columnar.getColumn<float> ("x");
+    * \endcode
+    * \author Point Cloud Library
+    * \ingroup common
+    */
+  class PCL_EXPORTS ColumnarPointCloud
+  {
+    public:
+      typedef boost::shared_ptr<ColumnarPointCloud> Ptr;
+      typedef boost::shared_ptr<const ColumnarPointCloud> ConstPtr;
+
+      /** \brief Empty constructor. */
+      ColumnarPointCloud () : header (), width (0), height (0), is_dense (true), fields_ (), columns_ () {}
+
+      /** \brief Resize the cloud, keeping all fields. New values are zero initialized.
+        * \param[in] width the new width of the cloud
+        * \param[in] height the new height of the cloud
+        */
+      void
+      resize (uint32_t width, uint32_t height = 1);
+
+      /** \brief Remove all points and fields. */
+      void
+      clear ();
+
+      /** \brief Number of points in the cloud. */
+      inline size_t
+      size () const { return (static_cast<size_t> (width) * static_cast<size_t> (height)); }
+
+      /** \brief Return true if the cloud has no points. */
+      inline bool
+      empty () const { return (size () == 0); }
+
+      /** \brief Add a field to the cloud, sized to the current number of points and zero
+        * initialized. If a field with the same name exists already, it is replaced.
+        * \param[in] name the name of the field
+        * \param[in] datatype the type of a single value (see pcl::PCLPointField::PointFieldTypes)
+        * \param[in] count the number of values per point
+        * \return the index of the field
+        */
+      int
+      addField (const std::string &name, uint8_t datatype, uint32_t count = 1);
+
+      /** \brief Remove a field from the cloud.
+        * \param[in] name the name of the field
+        * \return false if no field with that name exists
+        */
+      bool
+      removeField (const std::string &name);
+
+      /** \brief Get the index of a field, or -1 if it does not exist.
+        * \param[in] name the name of the field
+        */
+      int
+      getFieldIndex (const std::string &name) const;
+
+      /** \brief Get the description of all fields. */
+      inline const std::vector<pcl::PCLPointField>&
+      getFields () const { return (fields_); }
+
+      /** \brief Get the raw data of a field, or NULL if \a index is out of range or the cloud is empty. */
+      inline uint8_t*
+      getColumnData (int index)
+      {
+        if (index < 0 || index >= static_cast<int> (columns_.size ()) || columns_[index].empty ())
+          return (NULL);
+        return (&columns_[index][0]);
+      }
+
+      /** \brief Get the raw data of a field, or NULL if \a index is out of range or the cloud is empty. */
+      inline const uint8_t*
+      getColumnData (int index) const
+      {
+        if (index < 0 || index >= static_cast<int> (columns_.size ()) || columns_[index].empty ())
+          return (NULL);
+        return (&columns_[index][0]);
+      }
+
+      /** \brief Get the values of a field. Value i * count + j holds element j of point i.
+        * \param[in] name the name of the field
+        * \return NULL if the field does not exist or its datatype does not match T
+        */
+      template <typename T> inline T*
+      getColumn (const std::string &name)
+      {
+        int index = getFieldIndex (name);
+        if (index == -1 || fields_[index].datatype != traits::asEnum<T>::value)
+          return (NULL);
+        return (reinterpret_cast<T*> (getColumnData (index)));
+      }
+
+      /** \brief Get the values of a field. Value i * count + j holds element j of point i.
+        * \param[in] name the name of the field
+        * \return NULL if the field does not exist or its datatype does not match T
+        */
+      template <typename T> inline const T*
+      getColumn (const std::string &name) const
+      {
+        int index = getFieldIndex (name);
+        if (index == -1 || fields_[index].datatype != traits::asEnum<T>::value)
+          return (NULL);
+        return (reinterpret_cast<const T*> (getColumnData (index)));
+      }
+
+      /** \brief Return true if the cloud has float x, y and z fields. */
+      bool
+      hasXYZ () const;
+
+      /** \brief The point cloud header. */
+      pcl::PCLHeader header;
+
+      /** \brief The point cloud width (if organized as an image-structure). */
+      uint32_t width;
+
+      /** \brief The point cloud height (if organized as an image-structure). */
+      uint32_t height;
+
+      /** \brief True if no points are invalid (e.g., have NaN or Inf values). */
+      bool is_dense;
+
+    private:
+      /** \brief The description of every field. */
+      std::vector<pcl::PCLPointField> fields_;
+
+      /** \brief The data of every field, one contiguous array per entry of fields_. */
+      std::vector<std::vector<uint8_t> > columns_;
+  };
+
+  /** \brief Convert a pcl::PointCloud<PointT> into its columnar representation.
+    * \param[in] cloud the input point cloud
+    * \param[out] columnar the resultant columnar cloud, one column per field of PointT
+    * \ingroup common
+    */
+  template <typename PointT> void
+  toColumnarPointCloud (const pcl::PointCloud<PointT> &cloud, pcl::ColumnarPointCloud &columnar);
+
+  /** \brief Convert a columnar cloud into a pcl::PointCloud<PointT>. Fields of PointT that
+    * are not present in \a columnar are left default initialized.
+    * \param[in] columnar the input columnar cloud
+    * \param[out] cloud the resultant point cloud
+    * \ingroup common
+    */
+  template <typename PointT> void
+  fromColumnarPointCloud (const pcl::ColumnarPointCloud &columnar, pcl::PointCloud<PointT> &cloud);
+
+  /** \brief Convert a columnar cloud into a PCLPointCloud2 binary blob (fields packed in order).
+    * \param[in] columnar the input columnar cloud
+    * \param[out] msg the resultant PCLPointCloud2 binary blob
+    * \ingroup common
+    */
+  PCL_EXPORTS void
+  toPCLPointCloud2 (const pcl::ColumnarPointCloud &columnar, pcl::PCLPointCloud2 &msg);
+
+  /** \brief Convert a PCLPointCloud2 binary blob into a columnar cloud.
+    * \param[in] msg the input PCLPointCloud2 binary blob
+    * \param[out] columnar the resultant columnar cloud, one column per field of \a msg
+    * \ingroup common
+    */
+  PCL_EXPORTS void
+  fromPCLPointCloud2 (const pcl::PCLPointCloud2 &msg, pcl::ColumnarPointCloud &columnar);
+
+  /** \brief Apply an affine transform to the x, y and z fields of a columnar cloud.
+    * \param[in] cloud_in the input point cloud
+    * \param[out] cloud_out the resultant output point cloud
+    * \param[in] transform an affine transformation (typically a rigid transformation)
+    * \param[in] copy_all_fields flag that controls whether the contents of the fields
+    * (other than x, y, z) should be copied into the new transformed cloud
+    * \note Can be used with cloud_in equal to cloud_out
+    * \ingroup common
+    */
+  PCL_EXPORTS void
+  transformPointCloud (const pcl::ColumnarPointCloud &cloud_in,
+                       pcl::ColumnarPointCloud &cloud_out,
+                       const Eigen::Affine3f &transform,
+                       bool copy_all_fields = true);
+
+  /** \brief Apply a rigid transform defined by a 4x4 matrix to a columnar cloud.
+    * \param[in] cloud_in the input point cloud
+    * \param[out] cloud_out the resultant output point cloud
+    * \param[in] transform a rigid transformation
+    * \param[in] copy_all_fields flag that controls whether the contents of the fields
+    * (other than x, y, z) should be copied into the new transformed cloud
+    * \note Can be used with cloud_in equal to cloud_out
+    * \ingroup common
+    */
+  inline void
+  transformPointCloud (const pcl::ColumnarPointCloud &cloud_in,
+                       pcl::ColumnarPointCloud &cloud_out,
+                       const Eigen::Matrix4f &transform,
+                       bool copy_all_fields = true)
+  {
+    Eigen::Affine3f t (transform);
+    transformPointCloud (cloud_in, cloud_out, t, copy_all_fields);
+  }
+
+  /** \brief Get the minimum and maximum values on each of the 3 (x-y-z) dimensions of a columnar cloud.
+    * \param[in] cloud the input point cloud
+    * \param[out] min_pt the resultant minimum bounds
+    * \param[out] max_pt the resultant maximum bounds
+    * \ingroup common
+    */
+  PCL_EXPORTS void
+  getMinMax3D (const pcl::ColumnarPointCloud &cloud, Eigen::Vector4f &min_pt, Eigen::Vector4f &max_pt);
+
+  /** \brief Compute the 3D (X-Y-Z) centroid of a columnar cloud.
+    * \param[in] cloud the input point cloud
+    * \param[out] centroid the output centroid
+    * \return number of valid point used to determine the centroid. In case of dense point clouds, this is the same as the size of input cloud.
+    * \note if return value is 0, the centroid is not changed, thus not valid.
+    * The last compononent of the vector is set to 1, this allow to transform the centroid vector with 4x4 matrices.
+    * \ingroup common
+    */
+  PCL_EXPORTS unsigned int
+  compute3DCentroid (const pcl::ColumnarPointCloud &cloud, Eigen::Vector4f &centroid);
+
+  /** \brief Compute the 3x3 covariance matrix of a columnar cloud.
+    * Note: the covariance matrix is not normalized with the number of points.
+    * \param[in] cloud the input point cloud
+    * \param[in] centroid the centroid of the set of points in the cloud
+    * \param[out] covariance_matrix the resultant 3x3 covariance matrix
+    * \return number of valid point used to determine the covariance matrix.
+    * In case of dense point clouds, this is the same as the size of input cloud.
+    * \note if return value is 0, the covariance matrix is not changed, thus not valid.
+    * \ingroup common
+    */
+  PCL_EXPORTS unsigned int
+  computeCovarianceMatrix (const pcl::ColumnarPointCloud &cloud,
+                           const Eigen::Vector4f &centroid,
+                           Eigen::Matrix3f &covariance_matrix);
+}
+
+#include <pcl/impl/columnar_point_cloud.hpp>
+
+#endif  //#ifndef PCL_COLUMNAR_POINT_CLOUD_H_
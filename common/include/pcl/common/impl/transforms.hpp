@@ -37,6 +37,282 @@
  *
  */
 
+#include <boost/preprocessor/seq/for_each.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+namespace pcl
+{
+  namespace detail
+  {
+    /** \brief Number of points above which the cloud transforms are split over
+      * OpenMP threads (when PCL is compiled with OpenMP).
+      */
+    const int TRANSFORM_OMP_MIN_POINTS = 65536;
+
+    /** \brief Number of points handed to transformPoints4D at once. */
+    const int TRANSFORM_BLOCK_SIZE = 256;
+
+    /** \brief True for the point types known to store x, y, z and a padding value
+      * in the data[4] array of PCL_ADD_POINT4D.
+      */
+    template <typename PointT>
+    struct HasPoint4D { static const bool value = false; };
+
+    /** \brief True for the point types known to store normal_x, normal_y, normal_z
+      * and a padding value in the data_n[4] array of PCL_ADD_NORMAL4D.
+      */
+    template <typename PointT>
+    struct HasNormal4D { static const bool value = false; };
+
+#define PCL_DETAIL_HAS_POINT4D(r, data, POINT_TYPE) \
+    template <> struct HasPoint4D<POINT_TYPE> { static const bool value = true; };
+#define PCL_DETAIL_HAS_NORMAL4D(r, data, POINT_TYPE) \
+    template <> struct HasNormal4D<POINT_TYPE> { static const bool value = true; };
+    BOOST_PP_SEQ_FOR_EACH (PCL_DETAIL_HAS_POINT4D, _, PCL_XYZ_POINT_TYPES)
+    BOOST_PP_SEQ_FOR_EACH (PCL_DETAIL_HAS_NORMAL4D, _, PCL_NORMAL_POINT_TYPES)
+#undef PCL_DETAIL_HAS_POINT4D
+#undef PCL_DETAIL_HAS_NORMAL4D
+
+    /** \brief Applies a rigid (SE3) or rotation-only (SO3) transform to the 4 floats
+      * starting at \a src (x, y, z and the padding value of PCL_ADD_POINT4D /
+      * PCL_ADD_NORMAL4D), writing the result to \a tgt. The padding value is copied
+      * unchanged. \a src and \a tgt may be the same.
+      */
+    template <typename Scalar>
+    struct Transformer
+    {
+      Transformer (const Eigen::Matrix<Scalar, 4, 4> &transform) : tf (transform) {}
+
+      inline void
+      se3 (const float *src, float *tgt) const
+      {
+        const Scalar x = src[0], y = src[1], z = src[2];
+        tgt[0] = static_cast<float> (tf (0, 0) * x + tf (0, 1) * y + tf (0, 2) * z + tf (0, 3));
+        tgt[1] = static_cast<float> (tf (1, 0) * x + tf (1, 1) * y + tf (1, 2) * z + tf (1, 3));
+        tgt[2] = static_cast<float> (tf (2, 0) * x + tf (2, 1) * y + tf (2, 2) * z + tf (2, 3));
+        tgt[3] = src[3];
+      }
+
+      inline void
+      so3 (const float *src, float *tgt) const
+      {
+        const Scalar x = src[0], y = src[1], z = src[2];
+        tgt[0] = static_cast<float> (tf (0, 0) * x + tf (0, 1) * y + tf (0, 2) * z);
+        tgt[1] = static_cast<float> (tf (1, 0) * x + tf (1, 1) * y + tf (1, 2) * z);
+        tgt[2] = static_cast<float> (tf (2, 0) * x + tf (2, 1) * y + tf (2, 2) * z);
+        tgt[3] = src[3];
+      }
+
+      const Eigen::Matrix<Scalar, 4, 4> tf;
+    };
+
+    /** \brief Where x, y, z and the normal are stored in a point given to transformPoints4D. */
+    struct Point4DLayout
+    {
+      /** \brief The size of a point in bytes. */
+      size_t size;
+      /** \brief The offset of the data[4] array of PCL_ADD_POINT4D. */
+      size_t xyz_offset;
+      /** \brief The offset of the data_n[4] array of PCL_ADD_NORMAL4D, or -1 to
+        * leave the normals alone.
+        */
+      int normal_offset;
+    };
+
+    /** \brief Implementation of transformPoints4D for points of \a Size bytes, or of
+      * layout.size bytes if \a Size is 0.
+      */
+    template <size_t Size, typename TransformerT> inline void
+    transformPoints4DOfSize (const TransformerT &tf, const Point4DLayout &layout, int nr_points,
+                             const void *src, const int *src_indices, void *tgt,
+                             bool copy_all_fields, bool check_finite)
+    {
+      // Local copies, the stores to the points could otherwise alias the layout
+      const size_t size = Size ? Size : layout.size, xyz_offset = layout.xyz_offset;
+      const int normal_offset = layout.normal_offset;
+      const char *src_bytes = static_cast<const char*> (src);
+      char *tgt_bytes = static_cast<char*> (tgt);
+      for (int i = 0; i < nr_points; ++i)
+      {
+        const char *src_point = src_bytes + static_cast<size_t> (src_indices ? src_indices[i] : i) * size;
+        char *tgt_point = tgt_bytes + static_cast<size_t> (i) * size;
+        // Copy the other fields in the same pass
+        if (copy_all_fields)
+          memcpy (tgt_point, src_point, size);
+        const float *p = reinterpret_cast<const float*> (src_point + xyz_offset);
+        // Dataset might contain NaNs and Infs, so check for them first
+        if (check_finite && (!pcl_isfinite (p[0]) || !pcl_isfinite (p[1]) || !pcl_isfinite (p[2])))
+          continue;
+        tf.se3 (p, reinterpret_cast<float*> (tgt_point + xyz_offset));
+        if (normal_offset >= 0)
+          tf.so3 (reinterpret_cast<const float*> (src_point + normal_offset),
+                  reinterpret_cast<float*> (tgt_point + normal_offset));
+      }
+    }
+
+    /** \brief Transforms \a nr_points points, through their 4-float data (and data_n)
+      * arrays described by \a layout.
+      * \param[in] tf the transformer, providing se3 () and so3 () like Transformer
+      * \param[in] layout the layout of the points
+      * \param[in] nr_points the number of points to transform
+      * \param[in] src the first source point
+      * \param[in] src_indices the indices of the source points, or NULL to use the
+      * first \a nr_points ones
+      * \param[out] tgt the first target point, may be \a src
+      * \param[in] copy_all_fields if true, the source points are first copied to the
+      * target as a whole
+      * \param[in] check_finite if true, the x, y, z (and normal) of the source points
+      * with a non-finite x, y or z are not transformed
+      */
+    template <typename TransformerT> inline void
+    transformPoints4D (const TransformerT &tf, const Point4DLayout &layout, int nr_points,
+                       const void *src, const int *src_indices, void *tgt,
+                       bool copy_all_fields, bool check_finite)
+    {
+      // The common point sizes get a copy of known size
+      switch (layout.size)
+      {
+        case 16:
+          transformPoints4DOfSize<16> (tf, layout, nr_points, src, src_indices, tgt, copy_all_fields, check_finite);
+          break;
+        case 32:
+          transformPoints4DOfSize<32> (tf, layout, nr_points, src, src_indices, tgt, copy_all_fields, check_finite);
+          break;
+        case 48:
+          transformPoints4DOfSize<48> (tf, layout, nr_points, src, src_indices, tgt, copy_all_fields, check_finite);
+          break;
+        case 64:
+          transformPoints4DOfSize<64> (tf, layout, nr_points, src, src_indices, tgt, copy_all_fields, check_finite);
+          break;
+        default:
+          transformPoints4DOfSize<0> (tf, layout, nr_points, src, src_indices, tgt, copy_all_fields, check_finite);
+      }
+    }
+
+    /** \brief Transforms points with a float transform, see the template version for
+      * the parameters. Compiled into the library, which uses SSE2 if it was built with
+      * it: the instruction set used does not depend on the compiler flags of the caller.
+      */
+    PCL_EXPORTS void
+    transformPoints4D (const Eigen::Matrix4f &transform, const Point4DLayout &layout, int nr_points,
+                       const void *src, const int *src_indices, void *tgt,
+                       bool copy_all_fields, bool check_finite);
+
+    /** \brief Transforms points with a double transform, see the template version for
+      * the parameters. Compiled into the library, which uses AVX if it was built with it.
+      */
+    PCL_EXPORTS void
+    transformPoints4D (const Eigen::Matrix4d &transform, const Point4DLayout &layout, int nr_points,
+                       const void *src, const int *src_indices, void *tgt,
+                       bool copy_all_fields, bool check_finite);
+
+    /** \brief Scalar version of transformPoints4D for the other scalar types. */
+    template <typename Scalar> inline void
+    transformPoints4D (const Eigen::Matrix<Scalar, 4, 4> &transform, const Point4DLayout &layout, int nr_points,
+                       const void *src, const int *src_indices, void *tgt,
+                       bool copy_all_fields, bool check_finite)
+    {
+      transformPoints4D (Transformer<Scalar> (transform), layout, nr_points, src, src_indices, tgt,
+                         copy_all_fields, check_finite);
+    }
+
+    /** \brief Transforms the points (and normals if \a WithNormals) of a cloud, or of
+      * the given indices of a cloud, block by block. Point types with the
+      * PCL_ADD_POINT4D (and PCL_ADD_NORMAL4D) layout go through transformPoints4D,
+      * any other point type through its x, y, z (and normal_x, normal_y, normal_z)
+      * fields.
+      */
+    template <typename PointT, typename Scalar, bool WithNormals>
+    class CloudTransformer
+    {
+      public:
+        typedef boost::integral_constant<bool, HasPoint4D<PointT>::value &&
+                                               (!WithNormals || HasNormal4D<PointT>::value)> UsePoints4D;
+        typedef boost::integral_constant<bool, WithNormals> TransformNormals;
+
+        CloudTransformer (const pcl::PointCloud<PointT> &cloud_in, const std::vector<int> *indices,
+                          pcl::PointCloud<PointT> &cloud_out, const Eigen::Matrix<Scalar, 4, 4> &transform,
+                          bool copy_all_fields)
+          : cloud_in_ (cloud_in), indices_ (indices), cloud_out_ (cloud_out), tf_ (transform)
+          , copy_all_fields_ (copy_all_fields), check_finite_ (!cloud_in.is_dense)
+        {}
+
+        /** \brief Transform all the points, in parallel for large clouds. */
+        void
+        run () const
+        {
+          const int nr_points = static_cast<int> (cloud_out_.points.size ());
+          const int nr_blocks = (nr_points + TRANSFORM_BLOCK_SIZE - 1) / TRANSFORM_BLOCK_SIZE;
+#ifdef _OPENMP
+#pragma omp parallel for if (nr_points >= TRANSFORM_OMP_MIN_POINTS)
+#endif
+          for (int b = 0; b < nr_blocks; ++b)
+            transform (b * TRANSFORM_BLOCK_SIZE, std::min (nr_points, (b + 1) * TRANSFORM_BLOCK_SIZE), UsePoints4D ());
+        }
+
+      private:
+        void
+        transform (int begin, int end, boost::true_type) const
+        {
+          const Point4DLayout layout = { sizeof (PointT), offsetof (PointT, data), normalOffset (TransformNormals ()) };
+          transformPoints4D (tf_, layout, end - begin,
+                             indices_ ? &cloud_in_.points[0] : &cloud_in_.points[begin],
+                             indices_ ? &(*indices_)[begin] : NULL,
+                             &cloud_out_.points[begin], copy_all_fields_, check_finite_);
+        }
+
+        void
+        transform (int begin, int end, boost::false_type) const
+        {
+          for (int i = begin; i < end; ++i)
+          {
+            const PointT &src = indices_ ? cloud_in_.points[(*indices_)[i]] : cloud_in_.points[i];
+            PointT &tgt = cloud_out_.points[i];
+            // Copy the other fields in the same pass
+            if (copy_all_fields_)
+              tgt = src;
+            // Dataset might contain NaNs and Infs, so check for them first
+            if (check_finite_ && (!pcl_isfinite (src.x) || !pcl_isfinite (src.y) || !pcl_isfinite (src.z)))
+              continue;
+            const Scalar x = src.x, y = src.y, z = src.z;
+            tgt.x = static_cast<float> (tf_ (0, 0) * x + tf_ (0, 1) * y + tf_ (0, 2) * z + tf_ (0, 3));
+            tgt.y = static_cast<float> (tf_ (1, 0) * x + tf_ (1, 1) * y + tf_ (1, 2) * z + tf_ (1, 3));
+            tgt.z = static_cast<float> (tf_ (2, 0) * x + tf_ (2, 1) * y + tf_ (2, 2) * z + tf_ (2, 3));
+            so3 (src, tgt, TransformNormals ());
+          }
+        }
+
+        template <typename PointNormalT> inline void
+        so3 (const PointNormalT &src, PointNormalT &tgt, boost::true_type) const
+        {
+          const Scalar nx = src.normal_x, ny = src.normal_y, nz = src.normal_z;
+          tgt.normal_x = static_cast<float> (tf_ (0, 0) * nx + tf_ (0, 1) * ny + tf_ (0, 2) * nz);
+          tgt.normal_y = static_cast<float> (tf_ (1, 0) * nx + tf_ (1, 1) * ny + tf_ (1, 2) * nz);
+          tgt.normal_z = static_cast<float> (tf_ (2, 0) * nx + tf_ (2, 1) * ny + tf_ (2, 2) * nz);
+        }
+
+        template <typename PointNormalT> inline void
+        so3 (const PointNormalT &, PointNormalT &, boost::false_type) const {}
+
+        static inline int
+        normalOffset (boost::true_type) { return (static_cast<int> (offsetof (PointT, data_n))); }
+
+        static inline int
+        normalOffset (boost::false_type) { return (-1); }
+
+        const pcl::PointCloud<PointT> &cloud_in_;
+        const std::vector<int> *indices_;
+        pcl::PointCloud<PointT> &cloud_out_;
+        const Eigen::Matrix<Scalar, 4, 4> tf_;
+        const bool copy_all_fields_;
+        const bool check_finite_;
+    };
+  } // namespace detail
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 template <typename PointT, typename Scalar> void
 pcl::transformPointCloud (const pcl::PointCloud<PointT> &cloud_in, 
@@ -50,44 +326,14 @@ pcl::transformPointCloud (const pcl::PointCloud<PointT> &cloud_in,
     cloud_out.is_dense = cloud_in.is_dense;
     cloud_out.width    = cloud_in.width;
     cloud_out.height   = cloud_in.height;
-    cloud_out.points.reserve (cloud_in.points.size ());
-    if (copy_all_fields)
-      cloud_out.points.assign (cloud_in.points.begin (), cloud_in.points.end ());
-    else
-      cloud_out.points.resize (cloud_in.points.size ());
+    cloud_out.points.resize (cloud_in.points.size ());
     cloud_out.sensor_orientation_ = cloud_in.sensor_orientation_;
     cloud_out.sensor_origin_      = cloud_in.sensor_origin_;
   }
-
-  if (cloud_in.is_dense)
-  {
-    // If the dataset is dense, simply transform it!
-    for (size_t i = 0; i < cloud_out.points.size (); ++i)
-    {
-      //cloud_out.points[i].getVector3fMap () = transform * cloud_in.points[i].getVector3fMap ();
-      Eigen::Matrix<Scalar, 3, 1> pt (cloud_in[i].x, cloud_in[i].y, cloud_in[i].z);
-      cloud_out[i].x = static_cast<float> (transform (0, 0) * pt.coeffRef (0) + transform (0, 1) * pt.coeffRef (1) + transform (0, 2) * pt.coeffRef (2) + transform (0, 3));
-      cloud_out[i].y = static_cast<float> (transform (1, 0) * pt.coeffRef (0) + transform (1, 1) * pt.coeffRef (1) + transform (1, 2) * pt.coeffRef (2) + transform (1, 3));
-      cloud_out[i].z = static_cast<float> (transform (2, 0) * pt.coeffRef (0) + transform (2, 1) * pt.coeffRef (1) + transform (2, 2) * pt.coeffRef (2) + transform (2, 3));
-    }
-  }
   else
-  {
-    // Dataset might contain NaNs and Infs, so check for them first,
-    // otherwise we get errors during the multiplication (?)
-    for (size_t i = 0; i < cloud_out.points.size (); ++i)
-    {
-      if (!pcl_isfinite (cloud_in.points[i].x) || 
-          !pcl_isfinite (cloud_in.points[i].y) || 
-          !pcl_isfinite (cloud_in.points[i].z))
-        continue;
-      //cloud_out.points[i].getVector3fMap () = transform * cloud_in.points[i].getVector3fMap ();
-      Eigen::Matrix<Scalar, 3, 1> pt (cloud_in[i].x, cloud_in[i].y, cloud_in[i].z);
-      cloud_out[i].x = static_cast<float> (transform (0, 0) * pt.coeffRef (0) + transform (0, 1) * pt.coeffRef (1) + transform (0, 2) * pt.coeffRef (2) + transform (0, 3));
-      cloud_out[i].y = static_cast<float> (transform (1, 0) * pt.coeffRef (0) + transform (1, 1) * pt.coeffRef (1) + transform (1, 2) * pt.coeffRef (2) + transform (1, 3));
-      cloud_out[i].z = static_cast<float> (transform (2, 0) * pt.coeffRef (0) + transform (2, 1) * pt.coeffRef (1) + transform (2, 2) * pt.coeffRef (2) + transform (2, 3));
-    }
-  }
+    copy_all_fields = false;
+
+  pcl::detail::CloudTransformer<PointT, Scalar, false> (cloud_in, NULL, cloud_out, transform.matrix (), copy_all_fields).run ();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -108,40 +354,7 @@ pcl::transformPointCloud (const pcl::PointCloud<PointT> &cloud_in,
   cloud_out.sensor_orientation_ = cloud_in.sensor_orientation_;
   cloud_out.sensor_origin_      = cloud_in.sensor_origin_;
 
-  if (cloud_in.is_dense)
-  {
-    // If the dataset is dense, simply transform it!
-    for (size_t i = 0; i < npts; ++i)
-    {
-      // Copy fields first, then transform xyz data
-      if (copy_all_fields)
-        cloud_out.points[i] = cloud_in.points[indices[i]];
-      //cloud_out.points[i].getVector3fMap () = transform*cloud_out.points[i].getVector3fMap ();
-      Eigen::Matrix<Scalar, 3, 1> pt (cloud_in[indices[i]].x, cloud_in[indices[i]].y, cloud_in[indices[i]].z);
-      cloud_out[i].x = static_cast<float> (transform (0, 0) * pt.coeffRef (0) + transform (0, 1) * pt.coeffRef (1) + transform (0, 2) * pt.coeffRef (2) + transform (0, 3));
-      cloud_out[i].y = static_cast<float> (transform (1, 0) * pt.coeffRef (0) + transform (1, 1) * pt.coeffRef (1) + transform (1, 2) * pt.coeffRef (2) + transform (1, 3));
-      cloud_out[i].z = static_cast<float> (transform (2, 0) * pt.coeffRef (0) + transform (2, 1) * pt.coeffRef (1) + transform (2, 2) * pt.coeffRef (2) + transform (2, 3));
-    }
-  }
-  else
-  {
-    // Dataset might contain NaNs and Infs, so check for them first,
-    // otherwise we get errors during the multiplication (?)
-    for (size_t i = 0; i < npts; ++i)
-    {
-      if (copy_all_fields)
-        cloud_out.points[i] = cloud_in.points[indices[i]];
-      if (!pcl_isfinite (cloud_in.points[indices[i]].x) || 
-          !pcl_isfinite (cloud_in.points[indices[i]].y) || 
-          !pcl_isfinite (cloud_in.points[indices[i]].z))
-        continue;
-      //cloud_out.points[i].getVector3fMap () = transform*cloud_out.points[i].getVector3fMap ();
-      Eigen::Matrix<Scalar, 3, 1> pt (cloud_in[indices[i]].x, cloud_in[indices[i]].y, cloud_in[indices[i]].z);
-      cloud_out[i].x = static_cast<float> (transform (0, 0) * pt.coeffRef (0) + transform (0, 1) * pt.coeffRef (1) + transform (0, 2) * pt.coeffRef (2) + transform (0, 3));
-      cloud_out[i].y = static_cast<float> (transform (1, 0) * pt.coeffRef (0) + transform (1, 1) * pt.coeffRef (1) + transform (1, 2) * pt.coeffRef (2) + transform (1, 3));
-      cloud_out[i].z = static_cast<float> (transform (2, 0) * pt.coeffRef (0) + transform (2, 1) * pt.coeffRef (1) + transform (2, 2) * pt.coeffRef (2) + transform (2, 3));
-    }
-  }
+  pcl::detail::CloudTransformer<PointT, Scalar, false> (cloud_in, &indices, cloud_out, transform.matrix (), copy_all_fields).run ();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -153,63 +366,19 @@ pcl::transformPointCloudWithNormals (const pcl::PointCloud<PointT> &cloud_in,
 {
   if (&cloud_in != &cloud_out)
   {
-    // Note: could be replaced by cloud_out = cloud_in
     cloud_out.header   = cloud_in.header;
     cloud_out.width    = cloud_in.width;
     cloud_out.height   = cloud_in.height;
     cloud_out.is_dense = cloud_in.is_dense;
-    cloud_out.points.reserve (cloud_out.points.size ());
-    if (copy_all_fields)
-      cloud_out.points.assign (cloud_in.points.begin (), cloud_in.points.end ());
-    else
-      cloud_out.points.resize (cloud_in.points.size ());
+    cloud_out.points.resize (cloud_in.points.size ());
     cloud_out.sensor_orientation_ = cloud_in.sensor_orientation_;
     cloud_out.sensor_origin_      = cloud_in.sensor_origin_;
   }
-
-  // If the data is dense, we don't need to check for NaN
-  if (cloud_in.is_dense)
-  {
-    for (size_t i = 0; i < cloud_out.points.size (); ++i)
-    {
-      //cloud_out.points[i].getVector3fMap() = transform * cloud_in.points[i].getVector3fMap ();
-      Eigen::Matrix<Scalar, 3, 1> pt (cloud_in[i].x, cloud_in[i].y, cloud_in[i].z);
-      cloud_out[i].x = static_cast<float> (transform (0, 0) * pt.coeffRef (0) + transform (0, 1) * pt.coeffRef (1) + transform (0, 2) * pt.coeffRef (2) + transform (0, 3));
-      cloud_out[i].y = static_cast<float> (transform (1, 0) * pt.coeffRef (0) + transform (1, 1) * pt.coeffRef (1) + transform (1, 2) * pt.coeffRef (2) + transform (1, 3));
-      cloud_out[i].z = static_cast<float> (transform (2, 0) * pt.coeffRef (0) + transform (2, 1) * pt.coeffRef (1) + transform (2, 2) * pt.coeffRef (2) + transform (2, 3));
-
-      // Rotate normals (WARNING: transform.rotation () uses SVD internally!)
-      //cloud_out.points[i].getNormalVector3fMap() = transform.rotation () * cloud_in.points[i].getNormalVector3fMap ();
-      Eigen::Matrix<Scalar, 3, 1> nt (cloud_in[i].normal_x, cloud_in[i].normal_y, cloud_in[i].normal_z);
-      cloud_out[i].normal_x = static_cast<float> (transform (0, 0) * nt.coeffRef (0) + transform (0, 1) * nt.coeffRef (1) + transform (0, 2) * nt.coeffRef (2));
-      cloud_out[i].normal_y = static_cast<float> (transform (1, 0) * nt.coeffRef (0) + transform (1, 1) * nt.coeffRef (1) + transform (1, 2) * nt.coeffRef (2));
-      cloud_out[i].normal_z = static_cast<float> (transform (2, 0) * nt.coeffRef (0) + transform (2, 1) * nt.coeffRef (1) + transform (2, 2) * nt.coeffRef (2));
-    }
-  }
-  // Dataset might contain NaNs and Infs, so check for them first.
   else
-  {
-    for (size_t i = 0; i < cloud_out.points.size (); ++i)
-    {
-      if (!pcl_isfinite (cloud_in.points[i].x) || 
-          !pcl_isfinite (cloud_in.points[i].y) || 
-          !pcl_isfinite (cloud_in.points[i].z))
-        continue;
-
-      //cloud_out.points[i].getVector3fMap() = transform * cloud_in.points[i].getVector3fMap ();
-      Eigen::Matrix<Scalar, 3, 1> pt (cloud_in[i].x, cloud_in[i].y, cloud_in[i].z);
-      cloud_out[i].x = static_cast<float> (transform (0, 0) * pt.coeffRef (0) + transform (0, 1) * pt.coeffRef (1) + transform (0, 2) * pt.coeffRef (2) + transform (0, 3));
-      cloud_out[i].y = static_cast<float> (transform (1, 0) * pt.coeffRef (0) + transform (1, 1) * pt.coeffRef (1) + transform (1, 2) * pt.coeffRef (2) + transform (1, 3));
-      cloud_out[i].z = static_cast<float> (transform (2, 0) * pt.coeffRef (0) + transform (2, 1) * pt.coeffRef (1) + transform (2, 2) * pt.coeffRef (2) + transform (2, 3));
-
-      // Rotate normals
-      //cloud_out.points[i].getNormalVector3fMap() = transform.rotation () * cloud_in.points[i].getNormalVector3fMap ();
-      Eigen::Matrix<Scalar, 3, 1> nt (cloud_in[i].normal_x, cloud_in[i].normal_y, cloud_in[i].normal_z);
-      cloud_out[i].normal_x = static_cast<float> (transform (0, 0) * nt.coeffRef (0) + transform (0, 1) * nt.coeffRef (1) + transform (0, 2) * nt.coeffRef (2));
-      cloud_out[i].normal_y = static_cast<float> (transform (1, 0) * nt.coeffRef (0) + transform (1, 1) * nt.coeffRef (1) + transform (1, 2) * nt.coeffRef (2));
-      cloud_out[i].normal_z = static_cast<float> (transform (2, 0) * nt.coeffRef (0) + transform (2, 1) * nt.coeffRef (1) + transform (2, 2) * nt.coeffRef (2));
-    }
-  }
+    copy_all_fields = false;
+
+  // Normals are only rotated (WARNING: transform.rotation () would use SVD internally!)
+  pcl::detail::CloudTransformer<PointT, Scalar, true> (cloud_in, NULL, cloud_out, transform.matrix (), copy_all_fields).run ();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -230,56 +399,24 @@ pcl::transformPointCloudWithNormals (const pcl::PointCloud<PointT> &cloud_in,
   cloud_out.sensor_orientation_ = cloud_in.sensor_orientation_;
   cloud_out.sensor_origin_      = cloud_in.sensor_origin_;
 
-  // If the data is dense, we don't need to check for NaN
-  if (cloud_in.is_dense)
-  {
-    for (size_t i = 0; i < cloud_out.points.size (); ++i)
-    {
-      // Copy fields first, then transform
-      if (copy_all_fields)
-        cloud_out.points[i] = cloud_in.points[indices[i]];
-      //cloud_out.points[i].getVector3fMap() = transform * cloud_in.points[i].getVector3fMap ();
-      Eigen::Matrix<Scalar, 3, 1> pt (cloud_in[indices[i]].x, cloud_in[indices[i]].y, cloud_in[indices[i]].z);
-      cloud_out[i].x = static_cast<float> (transform (0, 0) * pt.coeffRef (0) + transform (0, 1) * pt.coeffRef (1) + transform (0, 2) * pt.coeffRef (2) + transform (0, 3));
-      cloud_out[i].y = static_cast<float> (transform (1, 0) * pt.coeffRef (0) + transform (1, 1) * pt.coeffRef (1) + transform (1, 2) * pt.coeffRef (2) + transform (1, 3));
-      cloud_out[i].z = static_cast<float> (transform (2, 0) * pt.coeffRef (0) + transform (2, 1) * pt.coeffRef (1) + transform (2, 2) * pt.coeffRef (2) + transform (2, 3));
-
-      // Rotate normals
-      //cloud_out.points[i].getNormalVector3fMap() = transform.rotation () * cloud_in.points[i].getNormalVector3fMap ();
-      Eigen::Matrix<Scalar, 3, 1> nt (cloud_in[indices[i]].normal_x, cloud_in[indices[i]].normal_y, cloud_in[indices[i]].normal_z);
-      cloud_out[i].normal_x = static_cast<float> (transform (0, 0) * nt.coeffRef (0) + transform (0, 1) * nt.coeffRef (1) + transform (0, 2) * nt.coeffRef (2));
-      cloud_out[i].normal_y = static_cast<float> (transform (1, 0) * nt.coeffRef (0) + transform (1, 1) * nt.coeffRef (1) + transform (1, 2) * nt.coeffRef (2));
-      cloud_out[i].normal_z = static_cast<float> (transform (2, 0) * nt.coeffRef (0) + transform (2, 1) * nt.coeffRef (1) + transform (2, 2) * nt.coeffRef (2));
-    }
-  }
-  // Dataset might contain NaNs and Infs, so check for them first.
-  else
-  {
-    for (size_t i = 0; i < cloud_out.points.size (); ++i)
-    {
-      // Copy fields first, then transform
-      if (copy_all_fields)
-        cloud_out.points[i] = cloud_in.points[indices[i]];
-
-      if (!pcl_isfinite (cloud_in.points[indices[i]].x) || 
-          !pcl_isfinite (cloud_in.points[indices[i]].y) || 
-          !pcl_isfinite (cloud_in.points[indices[i]].z))
-        continue;
-
-      //cloud_out.points[i].getVector3fMap() = transform * cloud_in.points[i].getVector3fMap ();
-      Eigen::Matrix<Scalar, 3, 1> pt (cloud_in[indices[i]].x, cloud_in[indices[i]].y, cloud_in[indices[i]].z);
-      cloud_out[i].x = static_cast<float> (transform (0, 0) * pt.coeffRef (0) + transform (0, 1) * pt.coeffRef (1) + transform (0, 2) * pt.coeffRef (2) + transform (0, 3));
-      cloud_out[i].y = static_cast<float> (transform (1, 0) * pt.coeffRef (0) + transform (1, 1) * pt.coeffRef (1) + transform (1, 2) * pt.coeffRef (2) + transform (1, 3));
-      cloud_out[i].z = static_cast<float> (transform (2, 0) * pt.coeffRef (0) + transform (2, 1) * pt.coeffRef (1) + transform (2, 2) * pt.coeffRef (2) + transform (2, 3));
-
-      // Rotate normals
-      //cloud_out.points[i].getNormalVector3fMap() = transform.rotation () * cloud_in.points[i].getNormalVector3fMap ();
-      Eigen::Matrix<Scalar, 3, 1> nt (cloud_in[indices[i]].normal_x, cloud_in[indices[i]].normal_y, cloud_in[indices[i]].normal_z);
-      cloud_out[i].normal_x = static_cast<float> (transform (0, 0) * nt.coeffRef (0) + transform (0, 1) * nt.coeffRef (1) + transform (0, 2) * nt.coeffRef (2));
-      cloud_out[i].normal_y = static_cast<float> (transform (1, 0) * nt.coeffRef (0) + transform (1, 1) * nt.coeffRef (1) + transform (1, 2) * nt.coeffRef (2));
-      cloud_out[i].normal_z = static_cast<float> (transform (2, 0) * nt.coeffRef (0) + transform (2, 1) * nt.coeffRef (1) + transform (2, 2) * nt.coeffRef (2));
-    }
-  }
+  pcl::detail::CloudTransformer<PointT, Scalar, true> (cloud_in, &indices, cloud_out, transform.matrix (), copy_all_fields).run ();
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT, typename Scalar> inline void
+pcl::transformPointCloud (pcl::PointCloud<PointT> &cloud,
+                          const Eigen::Transform<Scalar, 3, Eigen::Affine> &transform)
+{
+  transformPointCloud (cloud, cloud, transform, true);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT, typename Scalar> inline void
+pcl::transformPointCloudWithNormals (pcl::PointCloud<PointT> &cloud,
+                                     const Eigen::Transform<Scalar, 3, Eigen::Affine> &transform)
+{
+  transformPointCloudWithNormals (cloud, cloud, transform, true);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
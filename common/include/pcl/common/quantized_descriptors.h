@@ -0,0 +1,171 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2014-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PCL_COMMON_QUANTIZED_DESCRIPTORS_H_
+#define PCL_COMMON_QUANTIZED_DESCRIPTORS_H_
+
+#include <vector>
+
+#include <pcl/pcl_macros.h>
+#include <pcl/point_types.h>
+#include <pcl/point_cloud.h>
+
+/**
+  * \file pcl/common/quantized_descriptors.h
+  * Distances and nearest neighbor search computed directly on the byte codes of quantized descriptors
+  * \ingroup common
+  */
+
+/*@{*/
+namespace pcl
+{
+  /** \brief Compute the squared Euclidean distance between the restored bins of two quantized SHOT
+    * descriptors, working on the byte codes without restoring them.
+    * \param[in] a the first descriptor
+    * \param[in] b the second descriptor
+    * \return the squared distance, or NaN if either descriptor has a non-finite bin
+    * \ingroup common
+    */
+  PCL_EXPORTS float
+  squaredDescriptorDistance (const QuantizedSHOT352 &a, const QuantizedSHOT352 &b);
+
+  /** \brief Compute the squared Euclidean distance between the restored bins of two quantized FPFH
+    * signatures, working on the byte codes without restoring them.
+    * \param[in] a the first signature
+    * \param[in] b the second signature
+    * \return the squared distance, or NaN if either signature has a non-finite bin
+    * \ingroup common
+    */
+  PCL_EXPORTS float
+  squaredDescriptorDistance (const QuantizedFPFHSignature33 &a, const QuantizedFPFHSignature33 &b);
+
+  /** \brief Find the nearest target descriptor of every query descriptor by brute force on the byte codes.
+    *
+    * Descriptors with a non-finite bin are skipped as targets. A query with a non-finite bin, or with no
+    * valid target, gets the index -1 and an infinite distance. The result does not depend on the number of
+    * threads; ties are resolved towards the lower target index.
+    *
+    * The search is exhaustive, its cost grows with the number of queries times the number of targets.
+    * Each pair costs one 352 byte dot product, about 50 ns on one core of a recent x86 CPU, which is 2 to
+    * 5 times less than the same scan on SHOT352 descriptors (see benchmarks/bench_quantized_descriptors.cpp).
+    * It is meant for libraries of up to a few thousand descriptors: 1000 queries against 4096 targets take
+    * about 0.2 s per thread. For larger libraries use a KdTreeFLANN, e.g. through CorrespondenceEstimation,
+    * whose cost per query grows more slowly with the number of targets. To run the same scan inside
+    * CorrespondenceEstimation, give it a pcl::search::QuantizedDescriptorSearch as target search method.
+    * \param[in] queries the query descriptors
+    * \param[in] targets the descriptors to search in
+    * \param[out] indices the index of the nearest target of every query
+    * \param[out] sqr_distances the squared distance to the nearest target of every query
+    * \param[in] nr_threads the number of threads to use, 0 for automatic (only used with OpenMP)
+    * \ingroup common
+    */
+  PCL_EXPORTS void
+  nearestDescriptors (const PointCloud<QuantizedSHOT352> &queries,
+                      const PointCloud<QuantizedSHOT352> &targets,
+                      std::vector<int> &indices,
+                      std::vector<float> &sqr_distances,
+                      unsigned int nr_threads = 1);
+
+  /** \brief Find the nearest target signature of every query signature by brute force on the byte codes.
+    * See the QuantizedSHOT352 overload for the handling of non-finite bins and the size of the libraries
+    * this exhaustive search is meant for. A 33 byte dot product costs about 10 ns, but kd-trees are also
+    * efficient on 33 bins, so prefer KdTreeFLANN for all but small libraries.
+    * \param[in] queries the query signatures
+    * \param[in] targets the signatures to search in
+    * \param[out] indices the index of the nearest target of every query
+    * \param[out] sqr_distances the squared distance to the nearest target of every query
+    * \param[in] nr_threads the number of threads to use, 0 for automatic (only used with OpenMP)
+    * \ingroup common
+    */
+  PCL_EXPORTS void
+  nearestDescriptors (const PointCloud<QuantizedFPFHSignature33> &queries,
+                      const PointCloud<QuantizedFPFHSignature33> &targets,
+                      std::vector<int> &indices,
+                      std::vector<float> &sqr_distances,
+                      unsigned int nr_threads = 1);
+
+  /** \brief Compute the squared norm of the byte codes of every descriptor of a cloud, the part of
+    * squaredDescriptorDistances () that only depends on the targets.
+    * \param[in] descriptors the quantized SHOT descriptors
+    * \param[out] code_norms the sum of the squared codes of every descriptor
+    * \ingroup common
+    */
+  PCL_EXPORTS void
+  squaredCodeNorms (const PointCloud<QuantizedSHOT352> &descriptors, std::vector<uint32_t> &code_norms);
+
+  /** \brief Compute the squared norm of the byte codes of every signature of a cloud, the part of
+    * squaredDescriptorDistances () that only depends on the targets.
+    * \param[in] descriptors the quantized FPFH signatures
+    * \param[out] code_norms the sum of the squared codes of every signature
+    * \ingroup common
+    */
+  PCL_EXPORTS void
+  squaredCodeNorms (const PointCloud<QuantizedFPFHSignature33> &descriptors, std::vector<uint32_t> &code_norms);
+
+  /** \brief Compute the squared Euclidean distances between the restored bins of one quantized SHOT
+    * descriptor and of every descriptor of a cloud, working on the byte codes. This is the scan behind
+    * pcl::search::QuantizedDescriptorSearch.
+    * \param[in] query the query descriptor
+    * \param[in] targets the descriptors to compare the query with
+    * \param[in] target_code_norms the output of squaredCodeNorms () for \a targets
+    * \param[out] sqr_distances the squared distance to every target, NaN if the query or the target
+    * has a non-finite bin
+    * \ingroup common
+    */
+  PCL_EXPORTS void
+  squaredDescriptorDistances (const QuantizedSHOT352 &query,
+                              const PointCloud<QuantizedSHOT352> &targets,
+                              const std::vector<uint32_t> &target_code_norms,
+                              std::vector<float> &sqr_distances);
+
+  /** \brief Compute the squared Euclidean distances between the restored bins of one quantized FPFH
+    * signature and of every signature of a cloud, working on the byte codes.
+    * \param[in] query the query signature
+    * \param[in] targets the signatures to compare the query with
+    * \param[in] target_code_norms the output of squaredCodeNorms () for \a targets
+    * \param[out] sqr_distances the squared distance to every target, NaN if the query or the target
+    * has a non-finite bin
+    * \ingroup common
+    */
+  PCL_EXPORTS void
+  squaredDescriptorDistances (const QuantizedFPFHSignature33 &query,
+                              const PointCloud<QuantizedFPFHSignature33> &targets,
+                              const std::vector<uint32_t> &target_code_norms,
+                              std::vector<float> &sqr_distances);
+}
+/*@}*/
+
+#endif  // PCL_COMMON_QUANTIZED_DESCRIPTORS_H_
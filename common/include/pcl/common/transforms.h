@@ -54,6 +54,9 @@ namespace pcl
     * \param[in] copy_all_fields flag that controls whether the contents of the fields
     * (other than x, y, z) should be copied into the new transformed cloud
     * \note Can be used with cloud_in equal to cloud_out
+    * \note Points of the PCL types with x, y, z in a 4D data array are transformed with
+    * SSE2 (float) or AVX (double) when libpcl_common was built with them, other point types
+    * through their x, y, z fields. Clouds of 65536 points or more are split over threads when compiled with OpenMP.
     * \ingroup common
     */
   template <typename PointT, typename Scalar> void 
@@ -126,6 +129,22 @@ namespace pcl
     return (transformPointCloud<PointT, float> (cloud_in, indices, cloud_out, transform, copy_all_fields));
   }
 
+  /** \brief Apply an affine transform defined by an Eigen Transform to a point cloud in place
+    * \param[in,out] cloud the point cloud to transform
+    * \param[in] transform an affine transformation (typically a rigid transformation)
+    * \ingroup common
+    */
+  template <typename PointT, typename Scalar> inline void
+  transformPointCloud (pcl::PointCloud<PointT> &cloud,
+                       const Eigen::Transform<Scalar, 3, Eigen::Affine> &transform);
+
+  template <typename PointT> inline void
+  transformPointCloud (pcl::PointCloud<PointT> &cloud,
+                       const Eigen::Affine3f &transform)
+  {
+    return (transformPointCloud<PointT, float> (cloud, transform));
+  }
+
   /** \brief Transform a point cloud and rotate its normals using an Eigen transform.
     * \param[in] cloud_in the input point cloud
     * \param[out] cloud_out the resultant output point cloud
@@ -206,6 +225,21 @@ namespace pcl
     return (transformPointCloudWithNormals<PointT, float> (cloud_in, indices, cloud_out, transform, copy_all_fields));
   }
 
+  /** \brief Transform a point cloud and rotate its normals using an Eigen transform, in place.
+    * \param[in,out] cloud the point cloud to transform
+    * \param[in] transform an affine transformation (typically a rigid transformation)
+    */
+  template <typename PointT, typename Scalar> inline void
+  transformPointCloudWithNormals (pcl::PointCloud<PointT> &cloud,
+                                  const Eigen::Transform<Scalar, 3, Eigen::Affine> &transform);
+
+  template <typename PointT> inline void
+  transformPointCloudWithNormals (pcl::PointCloud<PointT> &cloud,
+                                  const Eigen::Affine3f &transform)
+  {
+    return (transformPointCloudWithNormals<PointT, float> (cloud, transform));
+  }
+
   /** \brief Apply a rigid transform defined by a 4x4 matrix
     * \param[in] cloud_in the input point cloud
     * \param[out] cloud_out the resultant output point cloud
@@ -0,0 +1,139 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2014-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef PCL_IMPL_COLUMNAR_POINT_CLOUD_HPP_
+#define PCL_IMPL_COLUMNAR_POINT_CLOUD_HPP_
+
+#include <cstring>
+#include <pcl/for_each_type.h>
+#include <pcl/console/print.h>
+
+namespace pcl
+{
+  namespace detail
+  {
+    // Copies one field of every point of a PointCloud<PointT> into its own column.
+    template <typename PointT>
+    struct ColumnGatherer
+    {
+      ColumnGatherer (const pcl::PointCloud<PointT> &cloud, pcl::ColumnarPointCloud &columnar)
+        : cloud_ (cloud), columnar_ (columnar)
+      {}
+
+      template <typename Tag> void
+      operator () ()
+      {
+        typedef typename traits::datatype<PointT, Tag>::type FieldT;
+        const size_t offset = traits::offset<PointT, Tag>::value;
+
+        int index = columnar_.addField (traits::name<PointT, Tag>::value,
+                                        traits::datatype<PointT, Tag>::value,
+                                        traits::datatype<PointT, Tag>::size);
+        uint8_t *column = columnar_.getColumnData (index);
+        for (size_t i = 0; i < cloud_.points.size (); ++i, column += sizeof (FieldT))
+          memcpy (column, reinterpret_cast<const uint8_t*> (&cloud_.points[i]) + offset, sizeof (FieldT));
+      }
+
+      const pcl::PointCloud<PointT> &cloud_;
+      pcl::ColumnarPointCloud &columnar_;
+    };
+
+    // Copies one column back into the matching field of every point of a PointCloud<PointT>.
+    template <typename PointT>
+    struct ColumnScatterer
+    {
+      ColumnScatterer (const pcl::ColumnarPointCloud &columnar, pcl::PointCloud<PointT> &cloud)
+        : columnar_ (columnar), cloud_ (cloud)
+      {}
+
+      template <typename Tag> void
+      operator () ()
+      {
+        typedef typename traits::datatype<PointT, Tag>::type FieldT;
+        const size_t offset = traits::offset<PointT, Tag>::value;
+
+        int index = columnar_.getFieldIndex (traits::name<PointT, Tag>::value);
+        if (index == -1 || !FieldMatches<PointT, Tag> () (columnar_.getFields ()[index]))
+        {
+          PCL_WARN ("[pcl::fromColumnarPointCloud] Failed to find match for field '%s'.\n", traits::name<PointT, Tag>::value);
+          return;
+        }
+
+        const uint8_t *column = columnar_.getColumnData (index);
+        for (size_t i = 0; i < cloud_.points.size (); ++i, column += sizeof (FieldT))
+          memcpy (reinterpret_cast<uint8_t*> (&cloud_.points[i]) + offset, column, sizeof (FieldT));
+      }
+
+      const pcl::ColumnarPointCloud &columnar_;
+      pcl::PointCloud<PointT> &cloud_;
+    };
+  } // namespace detail
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> void
+pcl::toColumnarPointCloud (const pcl::PointCloud<PointT> &cloud, pcl::ColumnarPointCloud &columnar)
+{
+  columnar.clear ();
+  columnar.header   = cloud.header;
+  columnar.is_dense = cloud.is_dense;
+  if (static_cast<size_t> (cloud.width) * cloud.height == cloud.points.size ())
+    columnar.resize (cloud.width, cloud.height);
+  else
+    columnar.resize (static_cast<uint32_t> (cloud.points.size ()), 1);
+
+  detail::ColumnGatherer<PointT> gatherer (cloud, columnar);
+  for_each_type<typename traits::fieldList<PointT>::type> (gatherer);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> void
+pcl::fromColumnarPointCloud (const pcl::ColumnarPointCloud &columnar, pcl::PointCloud<PointT> &cloud)
+{
+  cloud.header   = columnar.header;
+  cloud.width    = columnar.width;
+  cloud.height   = columnar.height;
+  cloud.is_dense = columnar.is_dense;
+  cloud.points.resize (columnar.size ());
+
+  detail::ColumnScatterer<PointT> scatterer (columnar, cloud);
+  for_each_type<typename traits::fieldList<PointT>::type> (scatterer);
+}
+
+#endif  //#ifndef PCL_IMPL_COLUMNAR_POINT_CLOUD_HPP_
+
@@ -0,0 +1,132 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2010-2011, Willow Garage, Inc.
+ *  Copyright (c) 2012-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PCL_COMMON_IMPL_NEIGHBORHOODS_HPP_
+#define PCL_COMMON_IMPL_NEIGHBORHOODS_HPP_
+
+#include <pcl/neighborhoods.h>
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+template <typename SearchFunctor> void
+pcl::detail::searchNeighborhoods (const SearchFunctor &search, int nr_queries, unsigned int nr_threads,
+                                  Neighborhoods &neighborhoods)
+{
+  neighborhoods.clear ();
+  if (nr_queries <= 0)
+    return;
+
+#ifdef _OPENMP
+  if (nr_threads == 0)
+    nr_threads = omp_get_num_procs ();
+#else
+  nr_threads = 1;
+#endif
+
+  // Small blocks keep the load balanced, while still amortizing the scheduling cost
+  const int block_size = 64;
+  const int nr_blocks = (nr_queries + block_size - 1) / block_size;
+  nr_threads = std::min (nr_threads, static_cast<unsigned int> (nr_blocks));
+
+  std::vector<std::vector<int> > thread_indices (nr_threads);
+  std::vector<std::vector<float> > thread_sqr_distances (nr_threads);
+  std::vector<unsigned int> block_thread (nr_blocks);
+  std::vector<size_t> block_start (nr_blocks);
+
+  std::vector<size_t> &offsets = neighborhoods.offsets;
+  offsets.assign (nr_queries + 1, 0);
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nr_threads)
+#endif
+  {
+#ifdef _OPENMP
+    const unsigned int thread = omp_get_thread_num ();
+#else
+    const unsigned int thread = 0;
+#endif
+    std::vector<int> &buffer_indices = thread_indices[thread];
+    std::vector<float> &buffer_sqr_distances = thread_sqr_distances[thread];
+    std::vector<int> k_indices;
+    std::vector<float> k_sqr_distances;
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for (int b = 0; b < nr_blocks; ++b)
+    {
+      block_thread[b] = thread;
+      block_start[b] = buffer_indices.size ();
+
+      const int end = std::min (nr_queries, (b + 1) * block_size);
+      for (int q = b * block_size; q < end; ++q)
+      {
+        int nr_neighbors = search (q, k_indices, k_sqr_distances);
+        nr_neighbors = std::max (0, std::min (nr_neighbors, static_cast<int> (k_indices.size ())));
+        offsets[q + 1] = nr_neighbors;
+        buffer_indices.insert (buffer_indices.end (), k_indices.begin (), k_indices.begin () + nr_neighbors);
+        buffer_sqr_distances.insert (buffer_sqr_distances.end (), k_sqr_distances.begin (), k_sqr_distances.begin () + nr_neighbors);
+      }
+    }
+  }
+
+  for (int q = 0; q < nr_queries; ++q)
+    offsets[q + 1] += offsets[q];
+
+  neighborhoods.indices.resize (offsets[nr_queries]);
+  neighborhoods.sqr_distances.resize (offsets[nr_queries]);
+
+  // Move the results of each block from the buffer of its thread to their final position
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nr_threads)
+#endif
+  for (int b = 0; b < nr_blocks; ++b)
+  {
+    const size_t begin = offsets[b * block_size];
+    const size_t count = offsets[std::min (nr_queries, (b + 1) * block_size)] - begin;
+    if (count == 0)
+      continue;
+    const std::vector<int> &buffer_indices = thread_indices[block_thread[b]];
+    const std::vector<float> &buffer_sqr_distances = thread_sqr_distances[block_thread[b]];
+    std::copy (buffer_indices.begin () + block_start[b], buffer_indices.begin () + block_start[b] + count,
+               neighborhoods.indices.begin () + begin);
+    std::copy (buffer_sqr_distances.begin () + block_start[b], buffer_sqr_distances.begin () + block_start[b] + count,
+               neighborhoods.sqr_distances.begin () + begin);
+  }
+}
+
+#endif  // PCL_COMMON_IMPL_NEIGHBORHOODS_HPP_
@@ -89,6 +89,8 @@
   (pcl::UniqueShapeContext1960) \
   (pcl::SHOT352)                \
   (pcl::SHOT1344)               \
+  (pcl::QuantizedFPFHSignature33) \
+  (pcl::QuantizedSHOT352)       \
   (pcl::PointUV)                \
   (pcl::ReferenceFrame)         \
   (pcl::PointDEM)
@@ -1294,6 +1296,26 @@ namespace pcl
     friend std::ostream& operator << (std::ostream& os, const SHOT1344& p);
   };
 
+  PCL_EXPORTS std::ostream& operator << (std::ostream& os, const QuantizedSHOT352& p);
+  /** \brief A point structure holding a SHOT352 descriptor quantized to one byte per bin, which takes a
+    * little more than a quarter of the memory. The local reference frame is kept as is.
+    *
+    * The bins are quantized relative to the largest bin of the descriptor, which is kept in scale: a bin
+    * value v is stored as round (v / scale * maxCode ()), and the code 255 marks a non-finite bin. See
+    * pcl::SHOT352toQuantizedSHOT352 and pcl::QuantizedSHOT352toSHOT352.
+    * \ingroup common
+    */
+  struct QuantizedSHOT352
+  {
+    uint8_t descriptor[352];
+    float scale;
+    float rf[9];
+    static int descriptorSize () { return 352; }
+    static int maxCode () { return 254; }
+
+    friend std::ostream& operator << (std::ostream& os, const QuantizedSHOT352& p);
+  };
+
 
   /** \brief A structure representing the Local Reference Frame of a point.
     *  \ingroup common
@@ -1355,6 +1377,24 @@ namespace pcl
     friend std::ostream& operator << (std::ostream& os, const FPFHSignature33& p);
   };
 
+  PCL_EXPORTS std::ostream& operator << (std::ostream& os, const QuantizedFPFHSignature33& p);
+  /** \brief A point structure holding a FPFHSignature33 quantized to one byte per bin, which takes a quarter
+    * of the memory.
+    *
+    * A bin value v in [0, 100] is stored as round (v * quantizationScale ()), and the code 255 marks a
+    * non-finite bin. See pcl::FPFHSignature33toQuantizedFPFHSignature33 and
+    * pcl::QuantizedFPFHSignature33toFPFHSignature33.
+    * \ingroup common
+    */
+  struct QuantizedFPFHSignature33
+  {
+    uint8_t histogram[33];
+    static int descriptorSize () { return 33; }
+    static float quantizationScale () { return 2.54f; }
+
+    friend std::ostream& operator << (std::ostream& os, const QuantizedFPFHSignature33& p);
+  };
+
   PCL_EXPORTS std::ostream& operator << (std::ostream& os, const VFHSignature308& p);
   /** \brief A point structure representing the Viewpoint Feature Histogram (VFH).
     * \ingroup common
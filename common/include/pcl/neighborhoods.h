@@ -0,0 +1,180 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2010-2011, Willow Garage, Inc.
+ *  Copyright (c) 2012-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#ifndef PCL_COMMON_NEIGHBORHOODS_H_
+#define PCL_COMMON_NEIGHBORHOODS_H_
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <boost/shared_ptr.hpp>
+#include <pcl/pcl_macros.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace pcl
+{
+  /** \brief Neighborhoods stores the results of a batch of nearest neighbor searches in a compressed sparse
+    * row layout: the neighbors of query \a i are stored in \a indices and \a sqr_distances in the
+    * range [offsets[i], offsets[i + 1]).
+    *
+    * Compared to a std::vector<std::vector<int> >, this layout needs three allocations per batch instead
+    * of two per query point, and can be reused across batches without freeing memory.
+    * \ingroup common
+    */
+  struct Neighborhoods
+  {
+    /** \brief Start of the neighbors of each query point. Holds size () + 1 elements. */
+    std::vector<size_t> offsets;
+    /** \brief Indices of the neighbors of all query points, concatenated. */
+    std::vector<int> indices;
+    /** \brief Squared distances to the neighbors of all query points, concatenated. */
+    std::vector<float> sqr_distances;
+
+    typedef boost::shared_ptr<Neighborhoods> Ptr;
+    typedef boost::shared_ptr<const Neighborhoods> ConstPtr;
+
+    /** \brief Empty constructor. */
+    Neighborhoods () : offsets (1, 0), indices (), sqr_distances ()
+    {}
+
+    /** \brief Get the number of query points. */
+    inline size_t
+    size () const
+    {
+      return (offsets.empty () ? 0 : offsets.size () - 1);
+    }
+
+    /** \brief Get the number of neighbors found for a query point.
+      * \param[in] query the index of the query point in the batch
+      */
+    inline size_t
+    getNumberOfNeighbors (size_t query) const
+    {
+      return (offsets[query + 1] - offsets[query]);
+    }
+
+    /** \brief Copy the neighbors of a query point into separate vectors.
+      * \param[in] query the index of the query point in the batch
+      * \param[out] k_indices the indices of the neighbors
+      * \param[out] k_sqr_distances the squared distances to the neighbors
+      */
+    inline void
+    getNeighbors (size_t query, std::vector<int> &k_indices, std::vector<float> &k_sqr_distances) const
+    {
+      k_indices.assign (indices.begin () + offsets[query], indices.begin () + offsets[query + 1]);
+      k_sqr_distances.assign (sqr_distances.begin () + offsets[query], sqr_distances.begin () + offsets[query + 1]);
+    }
+
+    /** \brief Remove all query results, keeping the allocated memory. */
+    inline void
+    clear ()
+    {
+      offsets.assign (1, 0);
+      indices.clear ();
+      sqr_distances.clear ();
+    }
+  };
+
+  namespace detail
+  {
+    /** \brief Search functor forwarding a query to the nearestKSearch (cloud, index, ...) method of
+      * a search object (pcl::search::Search or pcl::KdTree).
+      */
+    template <typename SearchT, typename CloudT>
+    struct NearestKSearchFunctor
+    {
+      NearestKSearchFunctor (const SearchT &search, const CloudT &cloud, const std::vector<int> &indices, int k)
+        : search_ (search), cloud_ (cloud), indices_ (indices), k_ (k)
+      {}
+
+      inline int
+      operator () (int query, std::vector<int> &k_indices, std::vector<float> &k_sqr_distances) const
+      {
+        return (search_.nearestKSearch (cloud_, indices_.empty () ? query : indices_[query], k_, k_indices, k_sqr_distances));
+      }
+
+      const SearchT &search_;
+      const CloudT &cloud_;
+      const std::vector<int> &indices_;
+      int k_;
+    };
+
+    /** \brief Search functor forwarding a query to the radiusSearch (cloud, index, ...) method of
+      * a search object (pcl::search::Search or pcl::KdTree).
+      */
+    template <typename SearchT, typename CloudT>
+    struct RadiusSearchFunctor
+    {
+      RadiusSearchFunctor (const SearchT &search, const CloudT &cloud, const std::vector<int> &indices,
+                           double radius, unsigned int max_nn)
+        : search_ (search), cloud_ (cloud), indices_ (indices), radius_ (radius), max_nn_ (max_nn)
+      {}
+
+      inline int
+      operator () (int query, std::vector<int> &k_indices, std::vector<float> &k_sqr_distances) const
+      {
+        return (search_.radiusSearch (cloud_, indices_.empty () ? query : indices_[query], radius_, k_indices, k_sqr_distances, max_nn_));
+      }
+
+      const SearchT &search_;
+      const CloudT &cloud_;
+      const std::vector<int> &indices_;
+      double radius_;
+      unsigned int max_nn_;
+    };
+
+    /** \brief Run a batch of searches in parallel and gather the results in a Neighborhoods structure.
+      *
+      * The queries are processed in blocks. Each thread appends the results of its blocks to its own
+      * buffers, which are then copied to their final position once the number of neighbors of every
+      * query is known. No memory is allocated per query point.
+      * \param[in] search a functor with the signature int (int query, std::vector<int>&, std::vector<float>&)
+      * \param[in] nr_queries the number of queries in the batch
+      * \param[in] nr_threads the number of threads to use (0 sets the value to the number of cores)
+      * \param[out] neighborhoods the resultant neighborhoods
+      */
+    template <typename SearchFunctor> void
+    searchNeighborhoods (const SearchFunctor &search, int nr_queries, unsigned int nr_threads,
+                         Neighborhoods &neighborhoods);
+  }
+}
+
+#include <pcl/impl/neighborhoods.hpp>
+
+#endif  // PCL_COMMON_NEIGHBORHOODS_H_
@@ -40,6 +40,7 @@
 #define PCL_POINT_REPRESENTATION_H_
 
 #include <pcl/point_types.h>
+#include <pcl/point_types_conversion.h>
 #include <pcl/pcl_macros.h>
 #include <pcl/for_each_type.h>
 
@@ -410,6 +411,28 @@ namespace pcl
   class DefaultPointRepresentation <FPFHSignature33> : public DefaultFeatureRepresentation <FPFHSignature33>
   {};
 
+  //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+  /** \brief Represents a QuantizedFPFHSignature33 by its restored bin values, so that distances are comparable to
+    * the ones between FPFHSignature33 points and non-finite bins are caught by isValid ().
+    */
+  template <>
+  class DefaultPointRepresentation <QuantizedFPFHSignature33> : public PointRepresentation <QuantizedFPFHSignature33>
+  {
+    public:
+      DefaultPointRepresentation ()
+      {
+        nr_dimensions_ = 33;
+      }
+
+      virtual void
+      copyToFloatArray (const QuantizedFPFHSignature33 &p, float * out) const
+      {
+        const float step = 1.0f / QuantizedFPFHSignature33::quantizationScale ();
+        for (int i = 0; i < nr_dimensions_; ++i)
+          out[i] = detail::dequantizeDescriptorBin (p.histogram[i], step);
+      }
+  };
+
   //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
   template <>
   class DefaultPointRepresentation <VFHSignature308> : public DefaultFeatureRepresentation <VFHSignature308>
@@ -491,6 +514,28 @@ namespace pcl
       }
   };
 
+  //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+  /** \brief Represents a QuantizedSHOT352 by its restored bin values, so that distances are comparable to the ones
+    * between SHOT352 points and non-finite bins are caught by isValid ().
+    */
+  template <>
+  class DefaultPointRepresentation<QuantizedSHOT352> : public PointRepresentation<QuantizedSHOT352>
+  {
+    public:
+      DefaultPointRepresentation ()
+      {
+        nr_dimensions_ = 352;
+      }
+
+      virtual void
+      copyToFloatArray (const QuantizedSHOT352 &p, float * out) const
+      {
+        const float step = p.scale / static_cast<float> (QuantizedSHOT352::maxCode ());
+        for (int i = 0; i < nr_dimensions_; ++i)
+          out[i] = detail::dequantizeDescriptorBin (p.descriptor[i], step);
+      }
+  };
+
   //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
   template <>
   class DefaultPointRepresentation<SHOT1344> : public PointRepresentation<SHOT1344>
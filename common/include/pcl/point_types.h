@@ -210,6 +210,11 @@ namespace pcl
     */
   struct SHOT1344;
 
+  /** \brief Members: uint8_t descriptor[352], float scale, float rf[9]
+    * \ingroup common
+    */
+  struct QuantizedSHOT352;
+
   /** \brief Members: Axis x_axis, y_axis, z_axis
     * \ingroup common
     */
@@ -259,6 +264,11 @@ namespace pcl
     * \ingroup common
     */
   struct FPFHSignature33;
+
+  /** \brief Members: uint8_t histogram[33]
+    * \ingroup common
+    */
+  struct QuantizedFPFHSignature33;
   
   /** \brief Members: float vfh[308]
     * \ingroup common
@@ -605,10 +615,20 @@ POINT_CLOUD_REGISTER_POINT_STRUCT (pcl::SHOT1344,
     (float[9], rf, rf)
 )
 
+POINT_CLOUD_REGISTER_POINT_STRUCT (pcl::QuantizedSHOT352,
+    (uint8_t[352], descriptor, shot_u8)
+    (float, scale, scale)
+    (float[9], rf, rf)
+)
+
 POINT_CLOUD_REGISTER_POINT_STRUCT (pcl::FPFHSignature33,
     (float[33], histogram, fpfh)
 )
 
+POINT_CLOUD_REGISTER_POINT_STRUCT (pcl::QuantizedFPFHSignature33,
+    (uint8_t[33], histogram, fpfh_u8)
+)
+
 POINT_CLOUD_REGISTER_POINT_STRUCT (pcl::BRISKSignature512,
     (float, scale, brisk_scale)
     (float, orientation, brisk_orientation)
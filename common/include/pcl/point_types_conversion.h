@@ -40,6 +40,8 @@
 #define PCL_TYPE_CONVERSIONS_H
 
 #include <limits>
+#include <pcl/point_types.h>
+#include <pcl/point_cloud.h>
 
 namespace pcl
 {
@@ -389,6 +391,156 @@ namespace pcl
     out.width = width_;
     out.height = height_;
   }
+
+  namespace detail
+  {
+    /** \brief Quantize a descriptor bin to a byte, the code 255 is reserved for non-finite bins.
+      * \param[in] value the bin value
+      * \param[in] scale the factor that maps the bin values to [0, 254]
+      */
+    inline uint8_t
+    quantizeDescriptorBin (float value, float scale)
+    {
+      if (!pcl_isfinite (value))
+        return (255);
+      const float code = value * scale + 0.5f;
+      if (code <= 0.0f)
+        return (0);
+      return (code >= 254.0f ? 254 : static_cast<uint8_t> (code));
+    }
+
+    /** \brief Restore a descriptor bin from its byte code.
+      * \param[in] code the quantized bin
+      * \param[in] step the bin value of code 1, i.e. the inverse of the factor the bin was quantized with
+      */
+    inline float
+    dequantizeDescriptorBin (uint8_t code, float step)
+    {
+      if (code == 255)
+        return (std::numeric_limits<float>::quiet_NaN ());
+      return (static_cast<float> (code) * step);
+    }
+
+    /** \brief Convert every point of a descriptor cloud, keeping its header and organization. */
+    template <typename PointInT, typename PointOutT> inline void
+    convertDescriptorCloud (const PointCloud<PointInT> &in, PointCloud<PointOutT> &out,
+                            void (*convert) (const PointInT&, PointOutT&))
+    {
+      out.header   = in.header;
+      out.width    = in.width;
+      out.height   = in.height;
+      out.is_dense = in.is_dense;
+      out.points.resize (in.points.size ());
+      for (size_t i = 0; i < in.points.size (); ++i)
+        convert (in.points[i], out.points[i]);
+    }
+  }
+
+  /** \brief Quantize a FPFHSignature33 to one byte per bin
+    * \param[in] in the input FPFH signature
+    * \param[out] out the output quantized FPFH signature
+    */
+  inline void
+  FPFHSignature33toQuantizedFPFHSignature33 (const FPFHSignature33 &in,
+                                             QuantizedFPFHSignature33 &out)
+  {
+    const float scale = QuantizedFPFHSignature33::quantizationScale ();
+    for (int i = 0; i < 33; ++i)
+      out.histogram[i] = detail::quantizeDescriptorBin (in.histogram[i], scale);
+  }
+
+  /** \brief Restore a FPFHSignature33 from its quantized form
+    * \param[in] in the input quantized FPFH signature
+    * \param[out] out the output FPFH signature
+    */
+  inline void
+  QuantizedFPFHSignature33toFPFHSignature33 (const QuantizedFPFHSignature33 &in,
+                                             FPFHSignature33 &out)
+  {
+    const float step = 1.0f / QuantizedFPFHSignature33::quantizationScale ();
+    for (int i = 0; i < 33; ++i)
+      out.histogram[i] = detail::dequantizeDescriptorBin (in.histogram[i], step);
+  }
+
+  /** \brief Quantize a SHOT352 descriptor to one byte per bin, relative to its largest finite bin. The
+    * reference frame is copied as is.
+    * \param[in] in the input SHOT descriptor
+    * \param[out] out the output quantized SHOT descriptor
+    */
+  inline void
+  SHOT352toQuantizedSHOT352 (const SHOT352 &in,
+                             QuantizedSHOT352 &out)
+  {
+    float max_bin = 0.0f;
+    for (int i = 0; i < 352; ++i)
+      if (pcl_isfinite (in.descriptor[i]) && in.descriptor[i] > max_bin)
+        max_bin = in.descriptor[i];
+    out.scale = max_bin;
+    const float factor = max_bin > 0.0f ? static_cast<float> (QuantizedSHOT352::maxCode ()) / max_bin : 0.0f;
+    for (int i = 0; i < 352; ++i)
+      out.descriptor[i] = detail::quantizeDescriptorBin (in.descriptor[i], factor);
+    for (int i = 0; i < 9; ++i)
+      out.rf[i] = in.rf[i];
+  }
+
+  /** \brief Restore a SHOT352 descriptor from its quantized form
+    * \param[in] in the input quantized SHOT descriptor
+    * \param[out] out the output SHOT descriptor
+    */
+  inline void
+  QuantizedSHOT352toSHOT352 (const QuantizedSHOT352 &in,
+                             SHOT352 &out)
+  {
+    const float step = in.scale / static_cast<float> (QuantizedSHOT352::maxCode ());
+    for (int i = 0; i < 352; ++i)
+      out.descriptor[i] = detail::dequantizeDescriptorBin (in.descriptor[i], step);
+    for (int i = 0; i < 9; ++i)
+      out.rf[i] = in.rf[i];
+  }
+
+  /** \brief Quantize a FPFHSignature33 cloud to one byte per bin
+    * \param[in] in the input FPFH signature cloud
+    * \param[out] out the output quantized FPFH signature cloud
+    */
+  inline void
+  PointCloudFPFHSignature33toQuantizedFPFHSignature33 (const PointCloud<FPFHSignature33> &in,
+                                                       PointCloud<QuantizedFPFHSignature33> &out)
+  {
+    detail::convertDescriptorCloud (in, out, &FPFHSignature33toQuantizedFPFHSignature33);
+  }
+
+  /** \brief Restore a FPFHSignature33 cloud from its quantized form
+    * \param[in] in the input quantized FPFH signature cloud
+    * \param[out] out the output FPFH signature cloud
+    */
+  inline void
+  PointCloudQuantizedFPFHSignature33toFPFHSignature33 (const PointCloud<QuantizedFPFHSignature33> &in,
+                                                       PointCloud<FPFHSignature33> &out)
+  {
+    detail::convertDescriptorCloud (in, out, &QuantizedFPFHSignature33toFPFHSignature33);
+  }
+
+  /** \brief Quantize a SHOT352 cloud to one byte per bin
+    * \param[in] in the input SHOT descriptor cloud
+    * \param[out] out the output quantized SHOT descriptor cloud
+    */
+  inline void
+  PointCloudSHOT352toQuantizedSHOT352 (const PointCloud<SHOT352> &in,
+                                       PointCloud<QuantizedSHOT352> &out)
+  {
+    detail::convertDescriptorCloud (in, out, &SHOT352toQuantizedSHOT352);
+  }
+
+  /** \brief Restore a SHOT352 cloud from its quantized form
+    * \param[in] in the input quantized SHOT descriptor cloud
+    * \param[out] out the output SHOT descriptor cloud
+    */
+  inline void
+  PointCloudQuantizedSHOT352toSHOT352 (const PointCloud<QuantizedSHOT352> &in,
+                                       PointCloud<SHOT352> &out)
+  {
+    detail::convertDescriptorCloud (in, out, &QuantizedSHOT352toSHOT352);
+  }
 }
 
 #endif //#ifndef PCL_TYPE_CONVERSIONS_H
@@ -0,0 +1,415 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2014-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <pcl/columnar_point_cloud.h>
+#include <pcl/common/io.h>
+#include <pcl/console/print.h>
+#include <algorithm>
+#include <cfloat>
+#include <cstring>
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::ColumnarPointCloud::resize (uint32_t width, uint32_t height)
+{
+  this->width  = width;
+  this->height = height;
+  for (size_t d = 0; d < fields_.size (); ++d)
+    columns_[d].resize (size () * getFieldSize (fields_[d].datatype) * fields_[d].count);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::ColumnarPointCloud::clear ()
+{
+  width = height = 0;
+  fields_.clear ();
+  columns_.clear ();
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+int
+pcl::ColumnarPointCloud::addField (const std::string &name, uint8_t datatype, uint32_t count)
+{
+  pcl::PCLPointField field;
+  field.name     = name;
+  field.offset   = 0;
+  field.datatype = datatype;
+  field.count    = std::max<uint32_t> (count, 1);
+
+  int index = getFieldIndex (name);
+  if (index == -1)
+  {
+    index = static_cast<int> (fields_.size ());
+    fields_.push_back (field);
+    columns_.push_back (std::vector<uint8_t> ());
+  }
+  else
+  {
+    fields_[index] = field;
+    columns_[index].clear ();
+  }
+  columns_[index].resize (size () * getFieldSize (datatype) * field.count);
+  return (index);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+bool
+pcl::ColumnarPointCloud::removeField (const std::string &name)
+{
+  int index = getFieldIndex (name);
+  if (index == -1)
+    return (false);
+  fields_.erase (fields_.begin () + index);
+  columns_.erase (columns_.begin () + index);
+  return (true);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+int
+pcl::ColumnarPointCloud::getFieldIndex (const std::string &name) const
+{
+  for (size_t d = 0; d < fields_.size (); ++d)
+    if (fields_[d].name == name)
+      return (static_cast<int> (d));
+  return (-1);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+bool
+pcl::ColumnarPointCloud::hasXYZ () const
+{
+  // Look at the field layout only: the columns of an empty cloud hold no data
+  const char *names[3] = { "x", "y", "z" };
+  for (int d = 0; d < 3; ++d)
+  {
+    int index = getFieldIndex (names[d]);
+    if (index == -1 || fields_[index].datatype != pcl::PCLPointField::FLOAT32 || fields_[index].count > 1)
+      return (false);
+  }
+  return (true);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::toPCLPointCloud2 (const pcl::ColumnarPointCloud &columnar, pcl::PCLPointCloud2 &msg)
+{
+  const std::vector<pcl::PCLPointField> &fields = columnar.getFields ();
+
+  msg.header   = columnar.header;
+  msg.width    = columnar.width;
+  msg.height   = columnar.height;
+  msg.is_dense = columnar.is_dense;
+  msg.fields   = fields;
+
+  // Pack the fields one after another
+  uint32_t offset = 0;
+  for (size_t d = 0; d < msg.fields.size (); ++d)
+  {
+    msg.fields[d].offset = offset;
+    offset += getFieldSize (fields[d].datatype) * std::max<uint32_t> (fields[d].count, 1);
+  }
+  msg.point_step = offset;
+  msg.row_step   = msg.point_step * msg.width;
+  msg.data.resize (columnar.size () * msg.point_step);
+
+  for (size_t d = 0; d < fields.size (); ++d)
+  {
+    const size_t field_size = getFieldSize (fields[d].datatype) * std::max<uint32_t> (fields[d].count, 1);
+    const uint8_t *column = columnar.getColumnData (static_cast<int> (d));
+    uint8_t *data = msg.data.empty () ? NULL : &msg.data[msg.fields[d].offset];
+    for (size_t i = 0; i < columnar.size (); ++i, column += field_size, data += msg.point_step)
+      memcpy (data, column, field_size);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::fromPCLPointCloud2 (const pcl::PCLPointCloud2 &msg, pcl::ColumnarPointCloud &columnar)
+{
+  columnar.clear ();
+  columnar.header   = msg.header;
+  columnar.is_dense = msg.is_dense == 1;
+  columnar.resize (msg.width, msg.height);
+
+  for (size_t d = 0; d < msg.fields.size (); ++d)
+  {
+    const pcl::PCLPointField &field = msg.fields[d];
+    // Skip padding and fields of unknown type
+    if (field.name == "_" || getFieldSize (field.datatype) == 0)
+      continue;
+
+    const uint32_t count = std::max<uint32_t> (field.count, 1);
+    const size_t field_size = getFieldSize (field.datatype) * count;
+    uint8_t *column = columnar.getColumnData (columnar.addField (field.name, field.datatype, count));
+    // Empty cloud or no data: keep the field, there is nothing to copy
+    if (column == NULL || msg.data.empty ())
+      continue;
+    for (uint32_t row = 0; row < msg.height; ++row)
+    {
+      const uint8_t *data = &msg.data[row * msg.row_step + field.offset];
+      for (uint32_t col = 0; col < msg.width; ++col, column += field_size, data += msg.point_step)
+        memcpy (column, data, field_size);
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::transformPointCloud (const pcl::ColumnarPointCloud &cloud_in,
+                          pcl::ColumnarPointCloud &cloud_out,
+                          const Eigen::Affine3f &transform,
+                          bool copy_all_fields)
+{
+  if (!cloud_in.hasXYZ ())
+  {
+    PCL_ERROR ("[pcl::transformPointCloud] Input cloud has no float x, y and z fields!\n");
+    return;
+  }
+
+  if (&cloud_in != &cloud_out)
+  {
+    if (copy_all_fields)
+      cloud_out = cloud_in;
+    else
+    {
+      cloud_out.clear ();
+      cloud_out.header   = cloud_in.header;
+      cloud_out.is_dense = cloud_in.is_dense;
+      cloud_out.resize (cloud_in.width, cloud_in.height);
+      cloud_out.addField ("x", pcl::PCLPointField::FLOAT32);
+      cloud_out.addField ("y", pcl::PCLPointField::FLOAT32);
+      cloud_out.addField ("z", pcl::PCLPointField::FLOAT32);
+    }
+  }
+
+  const float *x_in = cloud_in.getColumn<float> ("x");
+  const float *y_in = cloud_in.getColumn<float> ("y");
+  const float *z_in = cloud_in.getColumn<float> ("z");
+  float *x_out = cloud_out.getColumn<float> ("x");
+  float *y_out = cloud_out.getColumn<float> ("y");
+  float *z_out = cloud_out.getColumn<float> ("z");
+  const int nr_points = static_cast<int> (cloud_in.size ());
+
+  const float m00 = transform (0, 0), m01 = transform (0, 1), m02 = transform (0, 2), m03 = transform (0, 3);
+  const float m10 = transform (1, 0), m11 = transform (1, 1), m12 = transform (1, 2), m13 = transform (1, 3);
+  const float m20 = transform (2, 0), m21 = transform (2, 1), m22 = transform (2, 2), m23 = transform (2, 3);
+
+  if (cloud_in.is_dense)
+  {
+    for (int i = 0; i < nr_points; ++i)
+    {
+      const float x = x_in[i], y = y_in[i], z = z_in[i];
+      x_out[i] = m00 * x + m01 * y + m02 * z + m03;
+      y_out[i] = m10 * x + m11 * y + m12 * z + m13;
+      z_out[i] = m20 * x + m21 * y + m22 * z + m23;
+    }
+  }
+  else
+  {
+    for (int i = 0; i < nr_points; ++i)
+    {
+      const float x = x_in[i], y = y_in[i], z = z_in[i];
+      if (!pcl_isfinite (x) || !pcl_isfinite (y) || !pcl_isfinite (z))
+      {
+        x_out[i] = x;
+        y_out[i] = y;
+        z_out[i] = z;
+        continue;
+      }
+      x_out[i] = m00 * x + m01 * y + m02 * z + m03;
+      y_out[i] = m10 * x + m11 * y + m12 * z + m13;
+      z_out[i] = m20 * x + m21 * y + m22 * z + m23;
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::getMinMax3D (const pcl::ColumnarPointCloud &cloud, Eigen::Vector4f &min_pt, Eigen::Vector4f &max_pt)
+{
+  min_pt.setConstant (FLT_MAX);
+  max_pt.setConstant (-FLT_MAX);
+  if (!cloud.hasXYZ ())
+  {
+    PCL_ERROR ("[pcl::getMinMax3D] Input cloud has no float x, y and z fields!\n");
+    return;
+  }
+
+  const float *columns[3] = { cloud.getColumn<float> ("x"), cloud.getColumn<float> ("y"), cloud.getColumn<float> ("z") };
+  const int nr_points = static_cast<int> (cloud.size ());
+  bool found = false;
+
+  // If the data is dense, we don't need to check for NaN
+  if (cloud.is_dense)
+  {
+    // One pass per column, each one a plain min/max reduction
+    for (int d = 0; d < 3; ++d)
+    {
+      const float *values = columns[d];
+      float min_v = FLT_MAX, max_v = -FLT_MAX;
+      for (int i = 0; i < nr_points; ++i)
+      {
+        min_v = values[i] < min_v ? values[i] : min_v;
+        max_v = values[i] > max_v ? values[i] : max_v;
+      }
+      min_pt[d] = min_v;
+      max_pt[d] = max_v;
+    }
+    found = nr_points > 0;
+  }
+  // NaN or Inf values could exist => check for them
+  else
+  {
+    for (int i = 0; i < nr_points; ++i)
+    {
+      const float x = columns[0][i], y = columns[1][i], z = columns[2][i];
+      if (!pcl_isfinite (x) || !pcl_isfinite (y) || !pcl_isfinite (z))
+        continue;
+      min_pt[0] = std::min (min_pt[0], x); max_pt[0] = std::max (max_pt[0], x);
+      min_pt[1] = std::min (min_pt[1], y); max_pt[1] = std::max (max_pt[1], y);
+      min_pt[2] = std::min (min_pt[2], z); max_pt[2] = std::max (max_pt[2], z);
+      found = true;
+    }
+  }
+
+  // Same homogeneous coordinate as the bounds computed on pcl::PointCloud<PointT>
+  if (found)
+    min_pt[3] = max_pt[3] = 1.0f;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+unsigned int
+pcl::compute3DCentroid (const pcl::ColumnarPointCloud &cloud, Eigen::Vector4f &centroid)
+{
+  if (cloud.empty () || !cloud.hasXYZ ())
+    return (0);
+
+  const float *x = cloud.getColumn<float> ("x");
+  const float *y = cloud.getColumn<float> ("y");
+  const float *z = cloud.getColumn<float> ("z");
+  const int nr_points = static_cast<int> (cloud.size ());
+
+  double sum_x = 0, sum_y = 0, sum_z = 0;
+  unsigned int point_count = 0;
+  // If the data is dense, we don't need to check for NaN
+  if (cloud.is_dense)
+  {
+    for (int i = 0; i < nr_points; ++i)
+    {
+      sum_x += x[i];
+      sum_y += y[i];
+      sum_z += z[i];
+    }
+    point_count = static_cast<unsigned int> (nr_points);
+  }
+  // NaN or Inf values could exist => check for them
+  else
+  {
+    for (int i = 0; i < nr_points; ++i)
+    {
+      if (!pcl_isfinite (x[i]) || !pcl_isfinite (y[i]) || !pcl_isfinite (z[i]))
+        continue;
+      sum_x += x[i];
+      sum_y += y[i];
+      sum_z += z[i];
+      ++point_count;
+    }
+  }
+
+  if (point_count == 0)
+    return (0);
+  centroid[0] = static_cast<float> (sum_x / point_count);
+  centroid[1] = static_cast<float> (sum_y / point_count);
+  centroid[2] = static_cast<float> (sum_z / point_count);
+  centroid[3] = 1;
+  return (point_count);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+unsigned int
+pcl::computeCovarianceMatrix (const pcl::ColumnarPointCloud &cloud,
+                              const Eigen::Vector4f &centroid,
+                              Eigen::Matrix3f &covariance_matrix)
+{
+  if (cloud.empty () || !cloud.hasXYZ ())
+    return (0);
+
+  const float *x = cloud.getColumn<float> ("x");
+  const float *y = cloud.getColumn<float> ("y");
+  const float *z = cloud.getColumn<float> ("z");
+  const int nr_points = static_cast<int> (cloud.size ());
+  const float cx = centroid[0], cy = centroid[1], cz = centroid[2];
+
+  // Upper triangle: xx, xy, xz, yy, yz, zz
+  float xx = 0, xy = 0, xz = 0, yy = 0, yz = 0, zz = 0;
+  unsigned int point_count = 0;
+  // If the data is dense, we don't need to check for NaN
+  if (cloud.is_dense)
+  {
+    for (int i = 0; i < nr_points; ++i)
+    {
+      const float dx = x[i] - cx, dy = y[i] - cy, dz = z[i] - cz;
+      xx += dx * dx; xy += dx * dy; xz += dx * dz;
+      yy += dy * dy; yz += dy * dz;
+      zz += dz * dz;
+    }
+    point_count = static_cast<unsigned int> (nr_points);
+  }
+  // NaN or Inf values could exist => check for them
+  else
+  {
+    for (int i = 0; i < nr_points; ++i)
+    {
+      if (!pcl_isfinite (x[i]) || !pcl_isfinite (y[i]) || !pcl_isfinite (z[i]))
+        continue;
+      const float dx = x[i] - cx, dy = y[i] - cy, dz = z[i] - cz;
+      xx += dx * dx; xy += dx * dy; xz += dx * dz;
+      yy += dy * dy; yz += dy * dz;
+      zz += dz * dz;
+      ++point_count;
+    }
+  }
+
+  if (point_count == 0)
+    return (0);
+  covariance_matrix << xx, xy, xz,
+                       xy, yy, yz,
+                       xz, yz, zz;
+  return (point_count);
+}
+
@@ -324,6 +324,17 @@ namespace pcl
     return (os);
   }
 
+  std::ostream& 
+  operator << (std::ostream& os, const QuantizedSHOT352& p)
+  {
+    for (int i = 0; i < 9; ++i)
+    os << (i == 0 ? "(" : "") << p.rf[i] << (i < 8 ? ", " : ")");
+    for (size_t i = 0; i < 352; ++i)
+    os << (i == 0 ? "(" : "") << static_cast<int> (p.descriptor[i]) << (i < 351 ? ", " : ")");
+    os << " x " << p.scale;
+    return (os);
+  }
+
   std::ostream& 
   operator << (std::ostream& os, const ReferenceFrame& p)
   {
@@ -342,6 +353,14 @@ namespace pcl
     return (os);
   }
 
+  std::ostream& 
+  operator << (std::ostream& os, const QuantizedFPFHSignature33& p)
+  {
+    for (int i = 0; i < 33; ++i)
+    os << (i == 0 ? "(" : "") << static_cast<int> (p.histogram[i]) << (i < 32 ? ", " : ")");
+    return (os);
+  }
+
   std::ostream& 
   operator << (std::ostream& os, const VFHSignature308& p)
   {
@@ -0,0 +1,287 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2014-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <pcl/common/quantized_descriptors.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#if defined __SSE2__
+#include <emmintrin.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace
+{
+  inline const uint8_t*
+  codes (const pcl::QuantizedSHOT352 &p)
+  {
+    return (p.descriptor);
+  }
+
+  inline const uint8_t*
+  codes (const pcl::QuantizedFPFHSignature33 &p)
+  {
+    return (p.histogram);
+  }
+
+  /** \brief The bin value of code 1. */
+  inline double
+  step (const pcl::QuantizedSHOT352 &p)
+  {
+    return (static_cast<double> (p.scale) / pcl::QuantizedSHOT352::maxCode ());
+  }
+
+  inline double
+  step (const pcl::QuantizedFPFHSignature33 &)
+  {
+    return (1.0 / pcl::QuantizedFPFHSignature33::quantizationScale ());
+  }
+
+  /** \brief Check that no bin holds the non-finite code 255. */
+  template <typename PointT> inline bool
+  isValid (const PointT &p)
+  {
+    return (std::memchr (codes (p), 255, PointT::descriptorSize ()) == NULL);
+  }
+
+  /** \brief Sum of the products of two byte arrays. The sums are exact: 352 * 254^2 fits in 32 bits. */
+  inline uint32_t
+  dotProduct (const uint8_t *a, const uint8_t *b, int size)
+  {
+    uint32_t sum = 0;
+    int i = 0;
+#if defined __SSE2__
+    const __m128i zero = _mm_setzero_si128 ();
+    __m128i acc = zero;
+    for (; i + 16 <= size; i += 16)
+    {
+      const __m128i va = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (a + i));
+      const __m128i vb = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (b + i));
+      // Widen to 16 bits, multiply and add pairs into 32 bit lanes
+      acc = _mm_add_epi32 (acc, _mm_madd_epi16 (_mm_unpacklo_epi8 (va, zero), _mm_unpacklo_epi8 (vb, zero)));
+      acc = _mm_add_epi32 (acc, _mm_madd_epi16 (_mm_unpackhi_epi8 (va, zero), _mm_unpackhi_epi8 (vb, zero)));
+    }
+    acc = _mm_add_epi32 (acc, _mm_shuffle_epi32 (acc, _MM_SHUFFLE (1, 0, 3, 2)));
+    acc = _mm_add_epi32 (acc, _mm_shuffle_epi32 (acc, _MM_SHUFFLE (2, 3, 0, 1)));
+    sum = static_cast<uint32_t> (_mm_cvtsi128_si32 (acc));
+#endif
+    for (; i < size; ++i)
+      sum += static_cast<uint32_t> (a[i]) * b[i];
+    return (sum);
+  }
+
+  /** \brief Combine the byte level sums into the squared distance between the restored bins:
+    * |s_a a - s_b b|^2 = s_a^2 |a|^2 + s_b^2 |b|^2 - 2 s_a s_b a.b
+    */
+  inline float
+  combine (double step_a, uint32_t norm_a, double step_b, uint32_t norm_b, uint32_t dot)
+  {
+    const double distance = step_a * step_a * norm_a + step_b * step_b * norm_b - 2.0 * step_a * step_b * dot;
+    return (distance > 0.0 ? static_cast<float> (distance) : 0.0f);
+  }
+
+  template <typename PointT> inline float
+  squaredDistance (const PointT &a, const PointT &b)
+  {
+    if (!isValid (a) || !isValid (b))
+      return (std::numeric_limits<float>::quiet_NaN ());
+    const int size = PointT::descriptorSize ();
+    return (combine (step (a), dotProduct (codes (a), codes (a), size),
+                     step (b), dotProduct (codes (b), codes (b), size),
+                     dotProduct (codes (a), codes (b), size)));
+  }
+
+  template <typename PointT> void
+  nearest (const pcl::PointCloud<PointT> &queries,
+           const pcl::PointCloud<PointT> &targets,
+           std::vector<int> &indices,
+           std::vector<float> &sqr_distances,
+           unsigned int nr_threads)
+  {
+    const int size = PointT::descriptorSize ();
+    const int nr_queries = static_cast<int> (queries.points.size ());
+    const int nr_targets = static_cast<int> (targets.points.size ());
+
+    // The squared norms of the targets are shared by all the queries
+    std::vector<uint32_t> target_norms (nr_targets);
+    std::vector<char> target_valid (nr_targets);
+    for (int j = 0; j < nr_targets; ++j)
+    {
+      target_valid[j] = isValid (targets.points[j]);
+      target_norms[j] = dotProduct (codes (targets.points[j]), codes (targets.points[j]), size);
+    }
+
+    indices.assign (nr_queries, -1);
+    sqr_distances.assign (nr_queries, std::numeric_limits<float>::infinity ());
+
+#ifdef _OPENMP
+    if (nr_threads == 0)
+      nr_threads = omp_get_num_procs ();
+#pragma omp parallel for num_threads(nr_threads) schedule(dynamic, 16)
+#else
+    (void) nr_threads;
+#endif
+    for (int i = 0; i < nr_queries; ++i)
+    {
+      const PointT &query = queries.points[i];
+      if (!isValid (query))
+        continue;
+      const uint32_t query_norm = dotProduct (codes (query), codes (query), size);
+      const double query_step = step (query);
+      for (int j = 0; j < nr_targets; ++j)
+      {
+        if (!target_valid[j])
+          continue;
+        const float distance = combine (query_step, query_norm,
+                                        step (targets.points[j]), target_norms[j],
+                                        dotProduct (codes (query), codes (targets.points[j]), size));
+        if (distance < sqr_distances[i])
+        {
+          sqr_distances[i] = distance;
+          indices[i] = j;
+        }
+      }
+    }
+  }
+
+  template <typename PointT> void
+  codeNorms (const pcl::PointCloud<PointT> &descriptors, std::vector<uint32_t> &code_norms)
+  {
+    code_norms.resize (descriptors.points.size ());
+    for (size_t j = 0; j < descriptors.points.size (); ++j)
+      code_norms[j] = dotProduct (codes (descriptors.points[j]), codes (descriptors.points[j]), PointT::descriptorSize ());
+  }
+
+  template <typename PointT> void
+  distances (const PointT &query,
+             const pcl::PointCloud<PointT> &targets,
+             const std::vector<uint32_t> &target_code_norms,
+             std::vector<float> &sqr_distances)
+  {
+    const int size = PointT::descriptorSize ();
+    const size_t nr_targets = targets.points.size ();
+    sqr_distances.resize (nr_targets);
+    if (!isValid (query))
+    {
+      std::fill (sqr_distances.begin (), sqr_distances.end (), std::numeric_limits<float>::quiet_NaN ());
+      return;
+    }
+    const uint32_t query_norm = dotProduct (codes (query), codes (query), size);
+    const double query_step = step (query);
+    for (size_t j = 0; j < nr_targets; ++j)
+    {
+      const PointT &target = targets.points[j];
+      sqr_distances[j] = isValid (target) ?
+        combine (query_step, query_norm, step (target), target_code_norms[j], dotProduct (codes (query), codes (target), size)) :
+        std::numeric_limits<float>::quiet_NaN ();
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+float
+pcl::squaredDescriptorDistance (const QuantizedSHOT352 &a, const QuantizedSHOT352 &b)
+{
+  return (squaredDistance (a, b));
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+float
+pcl::squaredDescriptorDistance (const QuantizedFPFHSignature33 &a, const QuantizedFPFHSignature33 &b)
+{
+  return (squaredDistance (a, b));
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::nearestDescriptors (const PointCloud<QuantizedSHOT352> &queries,
+                         const PointCloud<QuantizedSHOT352> &targets,
+                         std::vector<int> &indices,
+                         std::vector<float> &sqr_distances,
+                         unsigned int nr_threads)
+{
+  nearest (queries, targets, indices, sqr_distances, nr_threads);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::nearestDescriptors (const PointCloud<QuantizedFPFHSignature33> &queries,
+                         const PointCloud<QuantizedFPFHSignature33> &targets,
+                         std::vector<int> &indices,
+                         std::vector<float> &sqr_distances,
+                         unsigned int nr_threads)
+{
+  nearest (queries, targets, indices, sqr_distances, nr_threads);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::squaredCodeNorms (const PointCloud<QuantizedSHOT352> &descriptors, std::vector<uint32_t> &code_norms)
+{
+  codeNorms (descriptors, code_norms);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::squaredCodeNorms (const PointCloud<QuantizedFPFHSignature33> &descriptors, std::vector<uint32_t> &code_norms)
+{
+  codeNorms (descriptors, code_norms);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::squaredDescriptorDistances (const QuantizedSHOT352 &query,
+                                 const PointCloud<QuantizedSHOT352> &targets,
+                                 const std::vector<uint32_t> &target_code_norms,
+                                 std::vector<float> &sqr_distances)
+{
+  distances (query, targets, target_code_norms, sqr_distances);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::squaredDescriptorDistances (const QuantizedFPFHSignature33 &query,
+                                 const PointCloud<QuantizedFPFHSignature33> &targets,
+                                 const std::vector<uint32_t> &target_code_norms,
+                                 std::vector<float> &sqr_distances)
+{
+  distances (query, targets, target_code_norms, sqr_distances);
+}
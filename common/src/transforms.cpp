@@ -0,0 +1,154 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2014-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <pcl/common/quantized_descriptors.h>
+
+
+#include <pcl/common/transforms.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+#if defined(__SSE2__)
+  /** \brief Transformer for float transforms using SSE2. */
+  struct TransformerSSE2
+  {
+    TransformerSSE2 (const Eigen::Matrix4f &transform)
+    {
+      // One register per column; the last row is replaced by 0 so that the padding
+      // lane can simply be merged back from the source afterwards
+      for (int i = 0; i < 4; ++i)
+        c[i] = _mm_setr_ps (transform (0, i), transform (1, i), transform (2, i), 0.0f);
+      mask_xyz = _mm_castsi128_ps (_mm_setr_epi32 (-1, -1, -1, 0));
+    }
+
+    inline void
+    se3 (const float *src, float *tgt) const
+    {
+      const __m128 p = _mm_loadu_ps (src);
+      const __m128 r = _mm_add_ps (_mm_add_ps (_mm_add_ps (_mm_mul_ps (c[0], _mm_shuffle_ps (p, p, 0x00)),
+                                                           _mm_mul_ps (c[1], _mm_shuffle_ps (p, p, 0x55))),
+                                               _mm_mul_ps (c[2], _mm_shuffle_ps (p, p, 0xAA))),
+                                   c[3]);
+      _mm_storeu_ps (tgt, _mm_or_ps (_mm_and_ps (mask_xyz, r), _mm_andnot_ps (mask_xyz, p)));
+    }
+
+    inline void
+    so3 (const float *src, float *tgt) const
+    {
+      const __m128 p = _mm_loadu_ps (src);
+      const __m128 r = _mm_add_ps (_mm_add_ps (_mm_mul_ps (c[0], _mm_shuffle_ps (p, p, 0x00)),
+                                               _mm_mul_ps (c[1], _mm_shuffle_ps (p, p, 0x55))),
+                                   _mm_mul_ps (c[2], _mm_shuffle_ps (p, p, 0xAA)));
+      _mm_storeu_ps (tgt, _mm_or_ps (_mm_and_ps (mask_xyz, r), _mm_andnot_ps (mask_xyz, p)));
+    }
+
+    __m128 c[4];
+    __m128 mask_xyz;
+  };
+#endif
+
+#if defined(__AVX__)
+  /** \brief Transformer for double transforms using AVX. */
+  struct TransformerAVX
+  {
+    TransformerAVX (const Eigen::Matrix4d &transform)
+    {
+      for (int i = 0; i < 4; ++i)
+        c[i] = _mm256_setr_pd (transform (0, i), transform (1, i), transform (2, i), 0.0);
+      mask_xyz = _mm_castsi128_ps (_mm_setr_epi32 (-1, -1, -1, 0));
+    }
+
+    inline void
+    se3 (const float *src, float *tgt) const
+    {
+      const __m128 p = _mm_loadu_ps (src);
+      const __m256d r = _mm256_add_pd (_mm256_add_pd (_mm256_add_pd (_mm256_mul_pd (c[0], _mm256_set1_pd (src[0])),
+                                                                      _mm256_mul_pd (c[1], _mm256_set1_pd (src[1]))),
+                                                      _mm256_mul_pd (c[2], _mm256_set1_pd (src[2]))),
+                                       c[3]);
+      _mm_storeu_ps (tgt, _mm_or_ps (_mm_and_ps (mask_xyz, _mm256_cvtpd_ps (r)), _mm_andnot_ps (mask_xyz, p)));
+    }
+
+    inline void
+    so3 (const float *src, float *tgt) const
+    {
+      const __m128 p = _mm_loadu_ps (src);
+      const __m256d r = _mm256_add_pd (_mm256_add_pd (_mm256_mul_pd (c[0], _mm256_set1_pd (src[0])),
+                                                      _mm256_mul_pd (c[1], _mm256_set1_pd (src[1]))),
+                                       _mm256_mul_pd (c[2], _mm256_set1_pd (src[2])));
+      _mm_storeu_ps (tgt, _mm_or_ps (_mm_and_ps (mask_xyz, _mm256_cvtpd_ps (r)), _mm_andnot_ps (mask_xyz, p)));
+    }
+
+    __m256d c[4];
+    __m128 mask_xyz;
+  };
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::detail::transformPoints4D (const Eigen::Matrix4f &transform, const Point4DLayout &layout, int nr_points,
+                                const void *src, const int *src_indices, void *tgt,
+                                bool copy_all_fields, bool check_finite)
+{
+#if defined(__SSE2__)
+  const TransformerSSE2 tf (transform);
+#else
+  const Transformer<float> tf (transform);
+#endif
+  transformPoints4D (tf, layout, nr_points, src, src_indices, tgt, copy_all_fields, check_finite);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::detail::transformPoints4D (const Eigen::Matrix4d &transform, const Point4DLayout &layout, int nr_points,
+                                const void *src, const int *src_indices, void *tgt,
+                                bool copy_all_fields, bool check_finite)
+{
+#if defined(__AVX__)
+  const TransformerAVX tf (transform);
+#else
+  const Transformer<double> tf (transform);
+#endif
+  transformPoints4D (tf, layout, nr_points, src, src_indices, tgt, copy_all_fields, check_finite);
+}
@@ -103,6 +103,7 @@ namespace pcl
         min_radius_(0.1),
         point_density_radius_(0.2),
         descriptor_length_ (),
+        x_axis_seeds_ (),
         rng_alg_ (),
         rng_ (new boost::uniform_01<boost::mt19937> (rng_alg_))
       {
@@ -174,7 +175,15 @@ namespace pcl
         * (e.g. the nearest neighbor didn't return any neighbors)
         */
       bool
-      computePoint (size_t index, const pcl::PointCloud<PointNT> &normals, float rf[9], std::vector<float> &desc);
+      computePoint (size_t index, const pcl::PointCloud<PointNT> &normals, float rf[9], std::vector<float> &desc) const;
+
+      /** \brief Estimate the descriptor of the point at position \a index in \a indices_. The neighbor
+        * buffers are not used, computePoint () runs its own search.
+        * \param[in] index the position of the query point in \a indices_
+        * \param[out] output the resultant descriptor
+        */
+      bool
+      computePointFeature (size_t index, std::vector<int> &, std::vector<float> &, PointOutT &output) const;
 
       /** \brief Estimate the actual feature.
         * \param[out] output the resultant feature
@@ -212,6 +221,11 @@ namespace pcl
       /** \brief Descriptor length */
       size_t descriptor_length_;
 
+      /** \brief Three random numbers per index, drawn in index order before the estimation
+        * so that the X axes do not depend on the number of threads.
+        */
+      std::vector<float> x_axis_seeds_;
+
       /** \brief Boost-based random number generator algorithm. */
       boost::mt19937 rng_alg_;
 
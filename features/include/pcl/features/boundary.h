@@ -118,7 +118,7 @@ namespace pcl
       bool 
       isBoundaryPoint (const pcl::PointCloud<PointInT> &cloud, 
                        int q_idx, const std::vector<int> &indices, 
-                       const Eigen::Vector4f &u, const Eigen::Vector4f &v, const float angle_threshold);
+                       const Eigen::Vector4f &u, const Eigen::Vector4f &v, const float angle_threshold) const;
 
       /** \brief Check whether a point is a boundary point in a planar patch of projected points given by indices.
         * \note A coordinate system u-v-n must be computed a-priori using \a getCoordinateSystemOnPlane
@@ -133,7 +133,7 @@ namespace pcl
       isBoundaryPoint (const pcl::PointCloud<PointInT> &cloud, 
                        const PointInT &q_point, 
                        const std::vector<int> &indices, 
-                       const Eigen::Vector4f &u, const Eigen::Vector4f &v, const float angle_threshold);
+                       const Eigen::Vector4f &u, const Eigen::Vector4f &v, const float angle_threshold) const;
 
       /** \brief Set the decision boundary (angle threshold) that marks points as boundary or regular. 
         * (default \f$\pi / 2.0\f$) 
@@ -159,7 +159,7 @@ namespace pcl
         */
       inline void 
       getCoordinateSystemOnPlane (const PointNT &p_coeff, 
-                                  Eigen::Vector4f &u, Eigen::Vector4f &v)
+                                  Eigen::Vector4f &u, Eigen::Vector4f &v) const
       {
         pcl::Vector4fMapConst p_coeff_v = p_coeff.getNormalVector4fMap ();
         v = p_coeff_v.unitOrthogonal ();
@@ -175,6 +175,16 @@ namespace pcl
       void 
       computeFeature (PointCloudOut &output);
 
+      /** \brief Estimate whether the point at position \a index in \a indices_ lies on a surface boundary.
+        * \param[in] index the position of the query point in \a indices_
+        * \param[in,out] nn_indices a buffer for the neighbor indices
+        * \param[in,out] nn_dists a buffer for the neighbor distances
+        * \param[out] output the resultant boundary estimate
+        */
+      bool
+      computePointFeature (size_t index, std::vector<int> &nn_indices, std::vector<float> &nn_dists,
+                           PointOutT &output) const;
+
       /** \brief The decision boundary (angle threshold) that marks points as boundary or regular. (default \f$\pi / 2.0\f$) */
       float angle_threshold_;
   };
@@ -51,6 +51,10 @@
 #include <pcl/pcl_base.h>
 #include <pcl/search/search.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace pcl
 {
   /** \brief Solve the eigenvalues and eigenvectors of a given 3x3 covariance matrix, and estimate the least-squares
@@ -131,7 +135,7 @@ namespace pcl
         feature_name_ (), search_method_surface_ (),
         surface_(), tree_(),
         search_parameter_(0), search_radius_(0), k_(0),
-        fake_surface_(false)
+        fake_surface_(false), threads_ (1)
       {}
             
       /** \brief Empty destructor */
@@ -209,6 +213,27 @@ namespace pcl
         return (search_radius_);
       }
 
+      /** \brief Set the number of threads used to estimate the features. Estimators whose per point
+        * computation is independent split the indices among the threads; the others ignore the setting.
+        * The *OMP classes share the computation of their base estimator and use all threads by default.
+        * \param[in] nr_threads the number of hardware threads to use (0 sets the value back to automatic)
+        */
+      inline void
+      setNumberOfThreads (unsigned int nr_threads = 0)
+      {
+#ifdef _OPENMP
+        threads_ = nr_threads != 0 ? nr_threads : static_cast<unsigned int> (omp_get_num_procs ());
+#else
+        if (nr_threads > 1)
+          PCL_WARN ("[pcl::%s::setNumberOfThreads] PCL was compiled without OpenMP, using a single thread.\n", getClassName ().c_str ());
+        threads_ = 1;
+#endif
+      }
+
+      /** \brief Get the number of threads used to estimate the features. */
+      inline unsigned int
+      getNumberOfThreads () const { return (threads_); }
+
       /** \brief Base method for feature estimation for all points given in
         * <setInputCloud (), setIndices ()> using the surface in setSearchSurface ()
         * and the spatial locator in setSearchMethod ()
@@ -256,6 +281,47 @@ namespace pcl
       /** \brief If no surface is given, we use the input PointCloud as the surface. */
       bool fake_surface_;
 
+      /** \brief The number of threads the scheduler should use. */
+      unsigned int threads_;
+
+      /** \brief Estimate the feature of a single query point. Estimators that override this method (or
+        * computeFeatureBlock ()) can use computeFeatureForAllIndices () as their computeFeature () body
+        * and get the multi-threaded loop for free. It is called concurrently for different indices, so it
+        * must not modify the estimator; all the scratch space it needs lives on the stack or in the
+        * neighbor buffers.
+        * \param[in] index the position of the query point in \a indices_ (and of the result in the output)
+        * \param[in,out] nn_indices a buffer for the neighbor indices, owned by the calling thread
+        * \param[in,out] nn_dists a buffer for the neighbor distances, owned by the calling thread
+        * \param[out] output the estimated feature
+        * \return false if the feature could not be estimated (and \a output holds NaN values), true otherwise
+        */
+      virtual bool
+      computePointFeature (size_t index, std::vector<int> &nn_indices, std::vector<float> &nn_dists,
+                           PointOutT &output) const;
+
+      /** \brief Estimate the features of the query points [begin, end) of \a indices_. The default calls
+        * computePointFeature () for each of them; estimators that are faster on several points at once
+        * override this method instead. Like computePointFeature (), it is called concurrently for different
+        * blocks and must not modify the estimator.
+        * \param[in] begin the position of the first query point in \a indices_
+        * \param[in] end the position after the last query point in \a indices_
+        * \param[out] output the resultant features, already resized to the number of indices
+        * \return false if a feature could not be estimated (and holds NaN values), true otherwise
+        */
+      virtual bool
+      computeFeatureBlock (int begin, int end, PointCloudOut &output) const;
+
+      /** \brief Call computeFeatureBlock () for consecutive blocks of indices, splitting the blocks among
+        * \a threads_ threads. If a worker thread throws, the block with the lowest failing index is estimated
+        * again on the calling thread once all threads have finished, so the exception reaches the caller with
+        * its original type.
+        * \param[out] output the resultant features, already resized to the number of indices
+        * \param[in] block_size the number of indices per block
+        * \return true if the feature could be estimated at every index
+        */
+      bool
+      computeFeatureForAllIndices (PointCloudOut &output, int block_size = 64) const;
+
       /** \brief Search for k-nearest neighbors using the spatial locator from
         * \a setSearchmethod, and the given surface from \a setSearchSurface.
         * \param[in] index the index of the query point
@@ -70,8 +70,8 @@ namespace pcl
     *     doesn't have finite 3D coordinates. Therefore, any point that contains
     *     NaN data on x, y, or z, will have its FPFH feature property set to NaN.
     *
-    * \note The code is stateful as we do not expect this class to be multicore parallelized. Please look at
-    * \ref FPFHEstimationOMP for examples on parallel implementations of the FPFH (Fast Point Feature Histogram).
+    * \note The SPFH signatures and then the FPFH signatures are split among the threads given to
+    * setNumberOfThreads (), see also \ref FPFHEstimationOMP.
     *
     * \author Radu B. Rusu
     * \ingroup features
@@ -90,13 +90,14 @@ namespace pcl
       using Feature<PointInT, PointOutT>::input_;
       using Feature<PointInT, PointOutT>::surface_;
       using FeatureFromNormals<PointInT, PointNT, PointOutT>::normals_;
+      using Feature<PointInT, PointOutT>::threads_;
 
       typedef typename Feature<PointInT, PointOutT>::PointCloudOut PointCloudOut;
 
       /** \brief Empty constructor. */
       FPFHEstimation () : 
         nr_bins_f1_ (11), nr_bins_f2_ (11), nr_bins_f3_ (11), 
-        hist_f1_ (), hist_f2_ (), hist_f3_ (), fpfh_histogram_ (),
+        hist_f1_ (), hist_f2_ (), hist_f3_ (), fpfh_histogram_ (), spfh_hist_lookup_ (),
         d_pi_ (1.0f / (2.0f * static_cast<float> (M_PI)))
       {
         feature_name_ = "FPFHEstimation";
@@ -151,7 +152,7 @@ namespace pcl
                                 const Eigen::MatrixXf &hist_f3, 
                                 const std::vector<int> &indices, 
                                 const std::vector<float> &dists, 
-                                Eigen::VectorXf &fpfh_histogram);
+                                Eigen::VectorXf &fpfh_histogram) const;
 
       /** \brief Set the number of subdivisions for each angular feature interval.
         * \param[in] nr_bins_f1 number of subdivisions for the first angular feature
@@ -199,6 +200,18 @@ namespace pcl
       void 
       computeFeature (PointCloudOut &output);
 
+      /** \brief Weight the SPFH signatures of the neighbors of one query point into its FPFH signature. Called
+        * concurrently by computeFeatureForAllIndices () once computeSPFHSignatures () is done.
+        * \param[in] index the position of the query point in \a indices_
+        * \param[in,out] nn_indices a buffer for the neighbor indices
+        * \param[in,out] nn_dists a buffer for the neighbor distances
+        * \param[out] output the FPFH signature
+        * \return false if the point has no finite coordinates or no neighbors, true otherwise
+        */
+      bool
+      computePointFeature (size_t index, std::vector<int> &nn_indices, std::vector<float> &nn_dists,
+                           PointOutT &output) const;
+
       /** \brief The number of subdivisions for each angular feature interval. */
       int nr_bins_f1_, nr_bins_f2_, nr_bins_f3_;
 
@@ -214,6 +227,9 @@ namespace pcl
       /** \brief Placeholder for a point's FPFH signature. */
       Eigen::VectorXf fpfh_histogram_;
 
+      /** \brief The row of the SPFH signature of each surface point in the hist_f* matrices. */
+      std::vector<int> spfh_hist_lookup_;
+
       /** \brief Float constant = 1.0 / (2.0 * M_PI) */
       float d_pi_; 
   };
@@ -49,6 +49,9 @@ namespace pcl
   /** \brief FPFHEstimationOMP estimates the Fast Point Feature Histogram (FPFH) descriptor for a given point cloud
     * dataset containing points and normals, in parallel, using the OpenMP standard.
     *
+    * \note This is an FPFHEstimation that uses all available threads by default, see
+    * FPFHEstimation::setNumberOfThreads ().
+    *
     * \note If you use this code in any academic work, please cite:
     *
     *   - R.B. Rusu, N. Blodow, M. Beetz.
@@ -89,27 +92,23 @@ namespace pcl
       using FPFHEstimation<PointInT, PointNT, PointOutT>::hist_f2_;
       using FPFHEstimation<PointInT, PointNT, PointOutT>::hist_f3_;
       using FPFHEstimation<PointInT, PointNT, PointOutT>::weightPointSPFHSignature;
+      using Feature<PointInT, PointOutT>::threads_;
 
       typedef typename Feature<PointInT, PointOutT>::PointCloudOut PointCloudOut;
 
       /** \brief Initialize the scheduler and set the number of threads to use.
         * \param[in] nr_threads the number of hardware threads to use (0 sets the value back to automatic)
         */
-      FPFHEstimationOMP (unsigned int nr_threads = 0) : nr_bins_f1_ (11), nr_bins_f2_ (11), nr_bins_f3_ (11), threads_ (nr_threads)
+      FPFHEstimationOMP (unsigned int nr_threads = 0) : nr_bins_f1_ (11), nr_bins_f2_ (11), nr_bins_f3_ (11)
       {
         feature_name_ = "FPFHEstimationOMP";
+        this->setNumberOfThreads (nr_threads);
       }
 
-      /** \brief Initialize the scheduler and set the number of threads to use.
-        * \param[in] nr_threads the number of hardware threads to use (0 sets the value back to automatic)
-        */
-      inline void 
-      setNumberOfThreads (unsigned int nr_threads = 0) { threads_ = nr_threads; }
-
     private:
       /** \brief Estimate the Fast Point Feature Histograms (FPFH) descriptors at a set of points given by
         * <setInputCloud (), setIndices ()> using the surface in setSearchSurface () and the spatial locator in
-        * setSearchMethod ()
+        * setSearchMethod (), with the bin counts set in nr_bins_f1_, nr_bins_f2_ and nr_bins_f3_
         * \param[out] output the resultant point cloud model dataset that contains the FPFH feature estimates
         */
       void 
@@ -118,9 +117,6 @@ namespace pcl
     public:
       /** \brief The number of subdivisions for each angular feature interval. */
       int nr_bins_f1_, nr_bins_f2_, nr_bins_f3_;
-    private:
-      /** \brief The number of threads the scheduler should use. */
-      unsigned int threads_;
   };
 }
 
@@ -128,7 +128,7 @@ pcl::ShapeContext3DEstimation<PointInT, PointNT, PointOutT>::initCompute ()
 //////////////////////////////////////////////////////////////////////////////////////////////
 template <typename PointInT, typename PointNT, typename PointOutT> bool
 pcl::ShapeContext3DEstimation<PointInT, PointNT, PointOutT>::computePoint (
-    size_t index, const pcl::PointCloud<PointNT> &normals, float rf[9], std::vector<float> &desc)
+    size_t index, const pcl::PointCloud<PointNT> &normals, float rf[9], std::vector<float> &desc) const
 {
   // The RF is formed as this x_axis | y_axis | normal
   Eigen::Map<Eigen::Vector3f> x_axis (rf);
@@ -166,9 +166,9 @@ pcl::ShapeContext3DEstimation<PointInT, PointNT, PointOutT>::computePoint (
   normal = normals[minIndex].getNormalVector3fMap ();
 
   // Compute and store the RF direction
-  x_axis[0] = static_cast<float> (rnd ());
-  x_axis[1] = static_cast<float> (rnd ());
-  x_axis[2] = static_cast<float> (rnd ());
+  x_axis[0] = x_axis_seeds_[3 * index + 0];
+  x_axis[1] = x_axis_seeds_[3 * index + 1];
+  x_axis[2] = x_axis_seeds_[3 * index + 2];
   if (!pcl::utils::equal (normal[2], 0.0f))
     x_axis[2] = - (normal[0]*x_axis[0] + normal[1]*x_axis[1]) / normal[2];
   else if (!pcl::utils::equal (normal[1], 0.0f))
@@ -274,35 +274,46 @@ pcl::ShapeContext3DEstimation<PointInT, PointNT, PointOutT>::computePoint (
   return (true);
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointInT, typename PointNT, typename PointOutT> bool
+pcl::ShapeContext3DEstimation<PointInT, PointNT, PointOutT>::computePointFeature (
+    size_t point_index, std::vector<int> &, std::vector<float> &, PointOutT &output) const
+{
+  // If the point is not finite, set the descriptor to NaN and continue
+  if (!isFinite ((*input_)[(*indices_)[point_index]]))
+  {
+    for (size_t i = 0; i < descriptor_length_; ++i)
+      output.descriptor[i] = std::numeric_limits<float>::quiet_NaN ();
+
+    memset (output.rf, 0, sizeof (output.rf[0]) * 9);
+    return (false);
+  }
+
+  std::vector<float> descriptor (descriptor_length_);
+  bool valid = computePoint (point_index, *normals_, output.rf, descriptor);
+  for (size_t j = 0; j < descriptor_length_; ++j)
+    output.descriptor[j] = descriptor[j];
+  return (valid);
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////
 template <typename PointInT, typename PointNT, typename PointOutT> void
 pcl::ShapeContext3DEstimation<PointInT, PointNT, PointOutT>::computeFeature (PointCloudOut &output)
 {
   assert (descriptor_length_ == 1980);
 
-  output.is_dense = true;
-  // Iterate over all points and compute the descriptors
-	for (size_t point_index = 0; point_index < indices_->size (); point_index++)
+  // Draw the random X axes serially and in index order, the result does not depend on the number of threads
+  x_axis_seeds_.resize (3 * indices_->size ());
+  for (size_t point_index = 0; point_index < indices_->size (); point_index++)
   {
-    //output[point_index].descriptor.resize (descriptor_length_);
-
-    // If the point is not finite, set the descriptor to NaN and continue
     if (!isFinite ((*input_)[(*indices_)[point_index]]))
-    {
-      for (size_t i = 0; i < descriptor_length_; ++i)
-        output[point_index].descriptor[i] = std::numeric_limits<float>::quiet_NaN ();
-
-      memset (output[point_index].rf, 0, sizeof (output[point_index].rf[0]) * 9);
-      output.is_dense = false;
       continue;
-    }
-
-    std::vector<float> descriptor (descriptor_length_);
-    if (!computePoint (point_index, *normals_, output[point_index].rf, descriptor))
-      output.is_dense = false;
-    for (size_t j = 0; j < descriptor_length_; ++j)
-      output[point_index].descriptor[j] = descriptor[j];
+    x_axis_seeds_[3 * point_index + 0] = static_cast<float> (rnd ());
+    x_axis_seeds_[3 * point_index + 1] = static_cast<float> (rnd ());
+    x_axis_seeds_[3 * point_index + 2] = static_cast<float> (rnd ());
   }
+
+  output.is_dense = this->computeFeatureForAllIndices (output);
 }
 
 #define PCL_INSTANTIATE_ShapeContext3DEstimation(T,NT,OutT) template class PCL_EXPORTS pcl::ShapeContext3DEstimation<T,NT,OutT>;
@@ -50,7 +50,7 @@ pcl::BoundaryEstimation<PointInT, PointNT, PointOutT>::isBoundaryPoint (
       const pcl::PointCloud<PointInT> &cloud, int q_idx, 
       const std::vector<int> &indices, 
       const Eigen::Vector4f &u, const Eigen::Vector4f &v, 
-      const float angle_threshold)
+      const float angle_threshold) const
 {
   return (isBoundaryPoint (cloud, cloud.points[q_idx], indices, u, v, angle_threshold));
 }
@@ -61,7 +61,7 @@ pcl::BoundaryEstimation<PointInT, PointNT, PointOutT>::isBoundaryPoint (
       const pcl::PointCloud<PointInT> &cloud, const PointInT &q_point, 
       const std::vector<int> &indices, 
       const Eigen::Vector4f &u, const Eigen::Vector4f &v, 
-      const float angle_threshold)
+      const float angle_threshold) const
 {
   if (indices.size () < 3)
     return (false);
@@ -113,61 +113,32 @@ pcl::BoundaryEstimation<PointInT, PointNT, PointOutT>::isBoundaryPoint (
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////
-template <typename PointInT, typename PointNT, typename PointOutT> void
-pcl::BoundaryEstimation<PointInT, PointNT, PointOutT>::computeFeature (PointCloudOut &output)
+template <typename PointInT, typename PointNT, typename PointOutT> bool
+pcl::BoundaryEstimation<PointInT, PointNT, PointOutT>::computePointFeature (
+    size_t index, std::vector<int> &nn_indices, std::vector<float> &nn_dists, PointOutT &output) const
 {
-  // Allocate enough space to hold the results
-  // \note This resize is irrelevant for a radiusSearch ().
-  std::vector<int> nn_indices (k_);
-  std::vector<float> nn_dists (k_);
-
-  Eigen::Vector4f u = Eigen::Vector4f::Zero (), v = Eigen::Vector4f::Zero ();
-
-  output.is_dense = true;
   // Save a few cycles by not checking every point for NaN/Inf values if the cloud is set to dense
-  if (input_->is_dense)
+  if ((!input_->is_dense && !isFinite ((*input_)[(*indices_)[index]])) ||
+      this->searchForNeighbors ((*indices_)[index], search_parameter_, nn_indices, nn_dists) == 0)
   {
-    // Iterating over the entire index vector
-    for (size_t idx = 0; idx < indices_->size (); ++idx)
-    {
-      if (this->searchForNeighbors ((*indices_)[idx], search_parameter_, nn_indices, nn_dists) == 0)
-      {
-        output.points[idx].boundary_point = std::numeric_limits<uint8_t>::quiet_NaN ();
-        output.is_dense = false;
-        continue;
-      }
-
-      // Obtain a coordinate system on the least-squares plane
-      //v = normals_->points[(*indices_)[idx]].getNormalVector4fMap ().unitOrthogonal ();
-      //u = normals_->points[(*indices_)[idx]].getNormalVector4fMap ().cross3 (v);
-      getCoordinateSystemOnPlane (normals_->points[(*indices_)[idx]], u, v);
-
-      // Estimate whether the point is lying on a boundary surface or not
-      output.points[idx].boundary_point = isBoundaryPoint (*surface_, input_->points[(*indices_)[idx]], nn_indices, u, v, angle_threshold_);
-    }
-  }
-  else
-  {
-    // Iterating over the entire index vector
-    for (size_t idx = 0; idx < indices_->size (); ++idx)
-    {
-      if (!isFinite ((*input_)[(*indices_)[idx]]) ||
-          this->searchForNeighbors ((*indices_)[idx], search_parameter_, nn_indices, nn_dists) == 0)
-      {
-        output.points[idx].boundary_point = std::numeric_limits<uint8_t>::quiet_NaN ();
-        output.is_dense = false;
-        continue;
-      }
-
-      // Obtain a coordinate system on the least-squares plane
-      //v = normals_->points[(*indices_)[idx]].getNormalVector4fMap ().unitOrthogonal ();
-      //u = normals_->points[(*indices_)[idx]].getNormalVector4fMap ().cross3 (v);
-      getCoordinateSystemOnPlane (normals_->points[(*indices_)[idx]], u, v);
-
-      // Estimate whether the point is lying on a boundary surface or not
-      output.points[idx].boundary_point = isBoundaryPoint (*surface_, input_->points[(*indices_)[idx]], nn_indices, u, v, angle_threshold_);
-    }
+    output.boundary_point = std::numeric_limits<uint8_t>::quiet_NaN ();
+    return (false);
   }
+
+  // Obtain a coordinate system on the least-squares plane
+  Eigen::Vector4f u = Eigen::Vector4f::Zero (), v = Eigen::Vector4f::Zero ();
+  getCoordinateSystemOnPlane (normals_->points[(*indices_)[index]], u, v);
+
+  // Estimate whether the point is lying on a boundary surface or not
+  output.boundary_point = isBoundaryPoint (*surface_, input_->points[(*indices_)[index]], nn_indices, u, v, angle_threshold_);
+  return (true);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointInT, typename PointNT, typename PointOutT> void
+pcl::BoundaryEstimation<PointInT, PointNT, PointOutT>::computeFeature (PointCloudOut &output)
+{
+  output.is_dense = this->computeFeatureForAllIndices (output);
 }
 
 #define PCL_INSTANTIATE_BoundaryEstimation(PointInT,PointNT,PointOutT) template class PCL_EXPORTS pcl::BoundaryEstimation<PointInT, PointNT, PointOutT>;
@@ -42,6 +42,7 @@
 #define PCL_FEATURES_IMPL_FEATURE_H_
 
 #include <pcl/search/pcl_search.h>
+#include <pcl/exceptions.h>
 
 //////////////////////////////////////////////////////////////////////////////////////////////
 inline void
@@ -222,6 +223,88 @@ pcl::Feature<PointInT, PointOutT>::compute (PointCloudOut &output)
   deinitCompute ();
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointInT, typename PointOutT> bool
+pcl::Feature<PointInT, PointOutT>::computePointFeature (size_t, std::vector<int> &, std::vector<float> &,
+                                                        PointOutT &) const
+{
+  PCL_ERROR ("[pcl::%s::computePointFeature] The estimator does not support per point feature estimation!\n", getClassName ().c_str ());
+  return (false);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointInT, typename PointOutT> bool
+pcl::Feature<PointInT, PointOutT>::computeFeatureBlock (int begin, int end, PointCloudOut &output) const
+{
+  // Allocate enough space to hold the results
+  // \note This resize is irrelevant for a radiusSearch ().
+  std::vector<int> nn_indices (k_);
+  std::vector<float> nn_dists (k_);
+
+  bool all_valid = true;
+  for (int idx = begin; idx < end; ++idx)
+    if (!computePointFeature (idx, nn_indices, nn_dists, output.points[idx]))
+      all_valid = false;
+  return (all_valid);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointInT, typename PointOutT> bool
+pcl::Feature<PointInT, PointOutT>::computeFeatureForAllIndices (PointCloudOut &output, int block_size) const
+{
+  const int nr_indices = static_cast<int> (indices_->size ());
+
+#ifdef _OPENMP
+  if (threads_ > 1)
+  {
+    const int nr_blocks = (nr_indices + block_size - 1) / block_size;
+    bool all_valid = true;
+    // Exceptions must not leave the parallel region. Remember the lowest block that threw, the
+    // estimation of that block is repeated below on the calling thread to rethrow the original exception
+    int failed_block = nr_blocks;
+    std::string error_message;
+
+#pragma omp parallel for reduction (&& : all_valid) schedule (dynamic) num_threads (threads_)
+    for (int block = 0; block < nr_blocks; ++block)
+    {
+      try
+      {
+        if (!computeFeatureBlock (block * block_size, std::min (nr_indices, (block + 1) * block_size), output))
+          all_valid = false;
+      }
+      catch (const std::exception &e)
+      {
+#pragma omp critical (feature_compute_exception)
+        if (block < failed_block)
+        {
+          failed_block = block;
+          error_message = e.what ();
+        }
+      }
+      catch (...)
+      {
+#pragma omp critical (feature_compute_exception)
+        if (block < failed_block)
+        {
+          failed_block = block;
+          error_message = "unknown exception";
+        }
+      }
+    }
+
+    if (failed_block < nr_blocks)
+    {
+      // computeFeatureBlock () does not modify the estimator, so it throws the same exception again
+      computeFeatureBlock (failed_block * block_size, std::min (nr_indices, (failed_block + 1) * block_size), output);
+      throw pcl::PCLException (error_message, __FILE__, "computeFeatureForAllIndices");
+    }
+    return (all_valid);
+  }
+#endif
+
+  return (computeFeatureBlock (0, nr_indices, output));
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////////
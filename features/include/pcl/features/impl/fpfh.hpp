@@ -105,7 +105,7 @@ pcl::FPFHEstimation<PointInT, PointNT, PointOutT>::computePointSPFHSignature (
 template <typename PointInT, typename PointNT, typename PointOutT> void
 pcl::FPFHEstimation<PointInT, PointNT, PointOutT>::weightPointSPFHSignature (
     const Eigen::MatrixXf &hist_f1, const Eigen::MatrixXf &hist_f2, const Eigen::MatrixXf &hist_f3,
-    const std::vector<int> &indices, const std::vector<float> &dists, Eigen::VectorXf &fpfh_histogram)
+    const std::vector<int> &indices, const std::vector<float> &dists, Eigen::VectorXf &fpfh_histogram) const
 {
   assert (indices.size () == dists.size ());
   double sum_f1 = 0.0, sum_f2 = 0.0, sum_f3 = 0.0;
@@ -179,7 +179,7 @@ pcl::FPFHEstimation<PointInT, PointNT, PointOutT>::computeSPFHSignatures (std::v
   std::vector<int> nn_indices (k_);
   std::vector<float> nn_dists (k_);
 
-  std::set<int> spfh_indices;
+  std::vector<int> spfh_indices_vec;
   spfh_hist_lookup.resize (surface_->points.size ());
 
   // Build a list of (unique) indices for which we will need to compute SPFH signatures
@@ -187,6 +187,7 @@ pcl::FPFHEstimation<PointInT, PointNT, PointOutT>::computeSPFHSignatures (std::v
   if (surface_ != input_ ||
       indices_->size () != surface_->points.size ())
   { 
+    std::set<int> spfh_indices;
     for (size_t idx = 0; idx < indices_->size (); ++idx)
     {
       int p_idx = (*indices_)[idx];
@@ -195,27 +196,31 @@ pcl::FPFHEstimation<PointInT, PointNT, PointOutT>::computeSPFHSignatures (std::v
 
       spfh_indices.insert (nn_indices.begin (), nn_indices.end ());
     }
+    spfh_indices_vec.assign (spfh_indices.begin (), spfh_indices.end ());
   }
   else
   {
     // Special case: When a feature must be computed at every point, there is no need for a neighborhood search
+    spfh_indices_vec.resize (indices_->size ());
     for (size_t idx = 0; idx < indices_->size (); ++idx)
-      spfh_indices.insert (static_cast<int> (idx));
+      spfh_indices_vec[idx] = static_cast<int> (idx);
   }
 
   // Initialize the arrays that will store the SPFH signatures
-  size_t data_size = spfh_indices.size ();
+  size_t data_size = spfh_indices_vec.size ();
   hist_f1.setZero (data_size, nr_bins_f1_);
   hist_f2.setZero (data_size, nr_bins_f2_);
   hist_f3.setZero (data_size, nr_bins_f3_);
 
-  // Compute SPFH signatures for every point that needs them
-  std::set<int>::iterator spfh_indices_itr = spfh_indices.begin ();
-  for (int i = 0; i < static_cast<int> (spfh_indices.size ()); ++i)
+  // Compute SPFH signatures for every point that needs them. Each point only writes its own row
+  // and lookup entry, so the points can be split among the threads.
+#ifdef _OPENMP
+#pragma omp parallel for firstprivate (nn_indices, nn_dists) schedule (dynamic, 64) num_threads (threads_)
+#endif
+  for (int i = 0; i < static_cast<int> (spfh_indices_vec.size ()); ++i)
   {
     // Get the next point index
-    int p_idx = *spfh_indices_itr;
-    ++spfh_indices_itr;
+    int p_idx = spfh_indices_vec[i];
 
     // Find the neighborhood around p_idx
     if (this->searchForNeighbors (*surface_, p_idx, search_parameter_, nn_indices, nn_dists) == 0)
@@ -230,74 +235,40 @@ pcl::FPFHEstimation<PointInT, PointNT, PointOutT>::computeSPFHSignatures (std::v
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////
-template <typename PointInT, typename PointNT, typename PointOutT> void
-pcl::FPFHEstimation<PointInT, PointNT, PointOutT>::computeFeature (PointCloudOut &output)
+template <typename PointInT, typename PointNT, typename PointOutT> bool
+pcl::FPFHEstimation<PointInT, PointNT, PointOutT>::computePointFeature (
+    size_t index, std::vector<int> &nn_indices, std::vector<float> &nn_dists, PointOutT &output) const
 {
-  // Allocate enough space to hold the NN search results
-  // \note This resize is irrelevant for a radiusSearch ().
-  std::vector<int> nn_indices (k_);
-  std::vector<float> nn_dists (k_);
-
-  std::vector<int> spfh_hist_lookup;
-  computeSPFHSignatures (spfh_hist_lookup, hist_f1_, hist_f2_, hist_f3_);
-
-  output.is_dense = true;
   // Save a few cycles by not checking every point for NaN/Inf values if the cloud is set to dense
-  if (input_->is_dense)
+  if ((!input_->is_dense && !isFinite ((*input_)[(*indices_)[index]])) ||
+      this->searchForNeighbors ((*indices_)[index], search_parameter_, nn_indices, nn_dists) == 0)
   {
-    // Iterate over the entire index vector
-    for (size_t idx = 0; idx < indices_->size (); ++idx)
-    {
-      if (this->searchForNeighbors ((*indices_)[idx], search_parameter_, nn_indices, nn_dists) == 0)
-      {
-        for (int d = 0; d < fpfh_histogram_.size (); ++d)
-          output.points[idx].histogram[d] = std::numeric_limits<float>::quiet_NaN ();
-    
-        output.is_dense = false;
-        continue;
-      }
-
-      // ... and remap the nn_indices values so that they represent row indices in the spfh_hist_* matrices 
-      // instead of indices into surface_->points
-      for (size_t i = 0; i < nn_indices.size (); ++i)
-        nn_indices[i] = spfh_hist_lookup[nn_indices[i]];
-
-      // Compute the FPFH signature (i.e. compute a weighted combination of local SPFH signatures) ...
-      weightPointSPFHSignature (hist_f1_, hist_f2_, hist_f3_, nn_indices, nn_dists, fpfh_histogram_);
-
-      // ...and copy it into the output cloud
-      for (int d = 0; d < fpfh_histogram_.size (); ++d)
-        output.points[idx].histogram[d] = fpfh_histogram_[d];
-    }
+    for (int d = 0; d < nr_bins_f1_ + nr_bins_f2_ + nr_bins_f3_; ++d)
+      output.histogram[d] = std::numeric_limits<float>::quiet_NaN ();
+    return (false);
   }
-  else
-  {
-    // Iterate over the entire index vector
-    for (size_t idx = 0; idx < indices_->size (); ++idx)
-    {
-      if (!isFinite ((*input_)[(*indices_)[idx]]) ||
-          this->searchForNeighbors ((*indices_)[idx], search_parameter_, nn_indices, nn_dists) == 0)
-      {
-        for (int d = 0; d < fpfh_histogram_.size (); ++d)
-          output.points[idx].histogram[d] = std::numeric_limits<float>::quiet_NaN ();
-    
-        output.is_dense = false;
-        continue;
-      }
 
-      // ... and remap the nn_indices values so that they represent row indices in the spfh_hist_* matrices 
-      // instead of indices into surface_->points
-      for (size_t i = 0; i < nn_indices.size (); ++i)
-        nn_indices[i] = spfh_hist_lookup[nn_indices[i]];
+  // ... and remap the nn_indices values so that they represent row indices in the spfh_hist_* matrices 
+  // instead of indices into surface_->points
+  for (size_t i = 0; i < nn_indices.size (); ++i)
+    nn_indices[i] = spfh_hist_lookup_[nn_indices[i]];
 
-      // Compute the FPFH signature (i.e. compute a weighted combination of local SPFH signatures) ...
-      weightPointSPFHSignature (hist_f1_, hist_f2_, hist_f3_, nn_indices, nn_dists, fpfh_histogram_);
+  // Compute the FPFH signature (i.e. compute a weighted combination of local SPFH signatures) ...
+  Eigen::VectorXf fpfh_histogram;
+  weightPointSPFHSignature (hist_f1_, hist_f2_, hist_f3_, nn_indices, nn_dists, fpfh_histogram);
 
-      // ...and copy it into the output cloud
-      for (int d = 0; d < fpfh_histogram_.size (); ++d)
-        output.points[idx].histogram[d] = fpfh_histogram_[d];
-    }
-  }
+  // ...and copy it into the output cloud
+  for (int d = 0; d < fpfh_histogram.size (); ++d)
+    output.histogram[d] = fpfh_histogram[d];
+  return (true);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointInT, typename PointNT, typename PointOutT> void
+pcl::FPFHEstimation<PointInT, PointNT, PointOutT>::computeFeature (PointCloudOut &output)
+{
+  computeSPFHSignatures (spfh_hist_lookup_, hist_f1_, hist_f2_, hist_f3_);
+  output.is_dense = this->computeFeatureForAllIndices (output);
 }
 
 #define PCL_INSTANTIATE_FPFHEstimation(T,NT,OutT) template class PCL_EXPORTS pcl::FPFHEstimation<T,NT,OutT>;
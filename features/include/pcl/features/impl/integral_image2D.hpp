@@ -41,6 +41,76 @@
 #define PCL_INTEGRAL_IMAGE2D_IMPL_H_
 
 #include <cstddef>
+#include <algorithm>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace pcl
+{
+  namespace detail
+  {
+    /** \brief Add the \a size values of \a src to those of \a tgt. */
+    template <typename T> inline void
+    addIntegralImageRow (const T *src, T *tgt, size_t size)
+    {
+      for (size_t i = 0; i < size; ++i)
+        tgt[i] += src[i];
+    }
+
+#if defined(__SSE2__)
+    inline void
+    addIntegralImageRow (const double *src, double *tgt, size_t size)
+    {
+      size_t i = 0;
+      for (; i + 2 <= size; i += 2)
+        _mm_storeu_pd (tgt + i, _mm_add_pd (_mm_loadu_pd (tgt + i), _mm_loadu_pd (src + i)));
+      for (; i < size; ++i)
+        tgt[i] += src[i];
+    }
+
+    inline void
+    addIntegralImageRow (const unsigned *src, unsigned *tgt, size_t size)
+    {
+      size_t i = 0;
+      for (; i + 4 <= size; i += 4)
+      {
+        const __m128i sum = _mm_add_epi32 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (tgt + i)),
+                                           _mm_loadu_si128 (reinterpret_cast<const __m128i*> (src + i)));
+        _mm_storeu_si128 (reinterpret_cast<__m128i*> (tgt + i), sum);
+      }
+      for (; i < size; ++i)
+        tgt[i] += src[i];
+    }
+#endif
+
+    /** \brief Turn an image whose rows hold prefix sums into an integral image, by adding every row to the
+      * next one. The rows depend on each other, so the threads split the columns instead.
+      * \param[in,out] image the values of the image, row after row
+      * \param[in] row_size the number of values per row
+      * \param[in] nr_rows the number of rows
+      * \param[in] nr_threads the number of threads to use
+      */
+    template <typename T> void
+    accumulateIntegralImageRows (T *image, size_t row_size, size_t nr_rows, unsigned nr_threads)
+    {
+      // Bands of whole cache lines, so that the threads do not write to the same lines
+      const size_t line_size = std::max<size_t> (64 / sizeof (T), 1);
+      const size_t band_size = ((row_size + nr_threads - 1) / nr_threads + line_size - 1) / line_size * line_size;
+      const int nr_bands = static_cast<int> ((row_size + band_size - 1) / band_size);
+#ifdef _OPENMP
+#pragma omp parallel for schedule (static) num_threads (nr_threads)
+#endif
+      for (int band = 0; band < nr_bands; ++band)
+      {
+        const size_t begin = band * band_size;
+        const size_t size = std::min (begin + band_size, row_size) - begin;
+        for (size_t rowIdx = 1; rowIdx < nr_rows; ++rowIdx)
+          addIntegralImageRow (image + (rowIdx - 1) * row_size + begin, image + rowIdx * row_size + begin, size);
+      }
+    }
+  }
+}
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 template <typename DataType, unsigned Dimension> void
@@ -154,68 +224,80 @@ template <typename DataType, unsigned Dimension> void
 pcl::IntegralImage2D<DataType, Dimension>::computeIntegralImages (
     const DataType *data, unsigned row_stride, unsigned element_stride)
 {
-  ElementType* previous_row = &first_order_integral_image_[0];
-  ElementType* current_row  = previous_row + (width_ + 1);
-  memset (previous_row, 0, sizeof (ElementType) * (width_ + 1));
-
-  unsigned* count_previous_row = &finite_values_integral_image_[0];
-  unsigned* count_current_row  = count_previous_row + (width_ + 1);
-  memset (count_previous_row, 0, sizeof (unsigned) * (width_ + 1));
-
-  if (!compute_second_order_integral_images_)
+  typedef typename IntegralImageTypeTraits<DataType>::IntegralType IntegralType;
+  const unsigned row_size = width_ + 1;
+  memset (&first_order_integral_image_[0], 0, sizeof (ElementType) * row_size);
+  memset (&finite_values_integral_image_[0], 0, sizeof (unsigned) * row_size);
+  if (compute_second_order_integral_images_)
+    memset (&second_order_integral_image_[0], 0, sizeof (SecondOrderType) * row_size);
+
+  // Every row adds its prefix sums to the row above it. A single thread does so right away. Several threads
+  // add the prefix sums to the first row, which is all zeros, so that the rows are independent of each
+  // other, and add the rows up afterwards.
+  const bool add_rows_in_place = threads_ < 2;
+#ifdef _OPENMP
+#pragma omp parallel for schedule (static) num_threads (threads_)
+#endif
+  for (int rowIdx = 0; rowIdx < static_cast<int> (height_); ++rowIdx)
   {
-    for (unsigned rowIdx = 0; rowIdx < height_; ++rowIdx, data += row_stride,
-                                                previous_row = current_row, current_row += (width_ + 1),
-                                                count_previous_row = count_current_row, count_current_row += (width_ + 1))
+    const DataType *row_data = data + rowIdx * row_stride;
+    const unsigned previous_row_offset = add_rows_in_place ? rowIdx * row_size : 0;
+    ElementType* current_row = &first_order_integral_image_[(rowIdx + 1) * row_size];
+    const ElementType* previous_row = &first_order_integral_image_[previous_row_offset];
+    unsigned* count_current_row = &finite_values_integral_image_[(rowIdx + 1) * row_size];
+    const unsigned* count_previous_row = &finite_values_integral_image_[previous_row_offset];
+    current_row [0].setZero ();
+    count_current_row [0] = 0;
+
+    ElementType row_sum = ElementType::Zero ();
+    unsigned row_count = 0;
+    if (!compute_second_order_integral_images_)
     {
-      current_row [0].setZero ();
-      count_current_row [0] = 0;
       for (unsigned colIdx = 0, valIdx = 0; colIdx < width_; ++colIdx, valIdx += element_stride)
       {
-        current_row [colIdx + 1] = previous_row [colIdx + 1] + current_row [colIdx] - previous_row [colIdx];
-        count_current_row [colIdx + 1] = count_previous_row [colIdx + 1] + count_current_row [colIdx] - count_previous_row [colIdx];
-        const InputType* element = reinterpret_cast <const InputType*> (&data [valIdx]);
+        const InputType* element = reinterpret_cast <const InputType*> (&row_data [valIdx]);
         if (pcl_isfinite (element->sum ()))
         {
-          current_row [colIdx + 1] += element->template cast<typename IntegralImageTypeTraits<DataType>::IntegralType>();
-          ++(count_current_row [colIdx + 1]);
+          row_sum += element->template cast<IntegralType>();
+          ++row_count;
         }
+        current_row [colIdx + 1] = previous_row [colIdx + 1] + row_sum;
+        count_current_row [colIdx + 1] = count_previous_row [colIdx + 1] + row_count;
       }
     }
-  }
-  else
-  {
-    SecondOrderType* so_previous_row = &second_order_integral_image_[0];
-    SecondOrderType* so_current_row  = so_previous_row + (width_ + 1);
-    memset (so_previous_row, 0, sizeof (SecondOrderType) * (width_ + 1));
-
-    SecondOrderType so_element;
-    for (unsigned rowIdx = 0; rowIdx < height_; ++rowIdx, data += row_stride,
-                                                previous_row = current_row, current_row += (width_ + 1),
-                                                count_previous_row = count_current_row, count_current_row += (width_ + 1),
-                                                so_previous_row = so_current_row, so_current_row += (width_ + 1))
+    else
     {
-      current_row [0].setZero ();
+      SecondOrderType* so_current_row = &second_order_integral_image_[(rowIdx + 1) * row_size];
+      const SecondOrderType* so_previous_row = &second_order_integral_image_[previous_row_offset];
       so_current_row [0].setZero ();
-      count_current_row [0] = 0;
+
+      SecondOrderType so_row_sum = SecondOrderType::Zero ();
       for (unsigned colIdx = 0, valIdx = 0; colIdx < width_; ++colIdx, valIdx += element_stride)
       {
-        current_row [colIdx + 1] = previous_row [colIdx + 1] + current_row [colIdx] - previous_row [colIdx];
-        so_current_row [colIdx + 1] = so_previous_row [colIdx + 1] + so_current_row [colIdx] - so_previous_row [colIdx];
-        count_current_row [colIdx + 1] = count_previous_row [colIdx + 1] + count_current_row [colIdx] - count_previous_row [colIdx];
-
-        const InputType* element = reinterpret_cast <const InputType*> (&data [valIdx]);
+        const InputType* element = reinterpret_cast <const InputType*> (&row_data [valIdx]);
         if (pcl_isfinite (element->sum ()))
         {
-          current_row [colIdx + 1] += element->template cast<typename IntegralImageTypeTraits<DataType>::IntegralType>();
-          ++(count_current_row [colIdx + 1]);
+          row_sum += element->template cast<IntegralType>();
+          ++row_count;
           for (unsigned myIdx = 0, elIdx = 0; myIdx < Dimension; ++myIdx)
             for (unsigned mxIdx = myIdx; mxIdx < Dimension; ++mxIdx, ++elIdx)
-              so_current_row [colIdx + 1][elIdx] += (*element)[myIdx] * (*element)[mxIdx];
+              so_row_sum [elIdx] += (*element)[myIdx] * (*element)[mxIdx];
         }
+        current_row [colIdx + 1] = previous_row [colIdx + 1] + row_sum;
+        so_current_row [colIdx + 1] = so_previous_row [colIdx + 1] + so_row_sum;
+        count_current_row [colIdx + 1] = count_previous_row [colIdx + 1] + row_count;
       }
     }
   }
+
+  if (add_rows_in_place)
+    return;
+
+  // Add the rows up, skipping the first one which is all zeros
+  detail::accumulateIntegralImageRows (first_order_integral_image_[row_size].data (), row_size * Dimension, height_, threads_);
+  detail::accumulateIntegralImageRows (&finite_values_integral_image_[row_size], row_size, height_, threads_);
+  if (compute_second_order_integral_images_)
+    detail::accumulateIntegralImageRows (second_order_integral_image_[row_size].data (), row_size * second_order_size, height_, threads_);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -324,62 +406,73 @@ template <typename DataType> void
 pcl::IntegralImage2D<DataType, 1>::computeIntegralImages (
     const DataType *data, unsigned row_stride, unsigned element_stride)
 {
-  ElementType* previous_row = &first_order_integral_image_[0];
-  ElementType* current_row  = previous_row + (width_ + 1);
-  memset (previous_row, 0, sizeof (ElementType) * (width_ + 1));
-
-  unsigned* count_previous_row = &finite_values_integral_image_[0];
-  unsigned* count_current_row  = count_previous_row + (width_ + 1);
-  memset (count_previous_row, 0, sizeof (unsigned) * (width_ + 1));
-
-  if (!compute_second_order_integral_images_)
+  const unsigned row_size = width_ + 1;
+  memset (&first_order_integral_image_[0], 0, sizeof (ElementType) * row_size);
+  memset (&finite_values_integral_image_[0], 0, sizeof (unsigned) * row_size);
+  if (compute_second_order_integral_images_)
+    memset (&second_order_integral_image_[0], 0, sizeof (SecondOrderType) * row_size);
+
+  // Every row adds its prefix sums to the row above it, or to the first row when several threads are used
+  const bool add_rows_in_place = threads_ < 2;
+#ifdef _OPENMP
+#pragma omp parallel for schedule (static) num_threads (threads_)
+#endif
+  for (int rowIdx = 0; rowIdx < static_cast<int> (height_); ++rowIdx)
   {
-    for (unsigned rowIdx = 0; rowIdx < height_; ++rowIdx, data += row_stride,
-                                                previous_row = current_row, current_row += (width_ + 1),
-                                                count_previous_row = count_current_row, count_current_row += (width_ + 1))
+    const DataType *row_data = data + rowIdx * row_stride;
+    const unsigned previous_row_offset = add_rows_in_place ? rowIdx * row_size : 0;
+    ElementType* current_row = &first_order_integral_image_[(rowIdx + 1) * row_size];
+    const ElementType* previous_row = &first_order_integral_image_[previous_row_offset];
+    unsigned* count_current_row = &finite_values_integral_image_[(rowIdx + 1) * row_size];
+    const unsigned* count_previous_row = &finite_values_integral_image_[previous_row_offset];
+    current_row [0] = 0.0;
+    count_current_row [0] = 0;
+
+    ElementType row_sum = 0.0;
+    unsigned row_count = 0;
+    if (!compute_second_order_integral_images_)
     {
-      current_row [0] = 0.0;
-      count_current_row [0] = 0;
       for (unsigned colIdx = 0, valIdx = 0; colIdx < width_; ++colIdx, valIdx += element_stride)
       {
-        current_row [colIdx + 1] = previous_row [colIdx + 1] + current_row [colIdx] - previous_row [colIdx];
-        count_current_row [colIdx + 1] = count_previous_row [colIdx + 1] + count_current_row [colIdx] - count_previous_row [colIdx];
-        if (pcl_isfinite (data [valIdx]))
+        if (pcl_isfinite (row_data [valIdx]))
         {
-          current_row [colIdx + 1] += data [valIdx];
-          ++(count_current_row [colIdx + 1]);
+          row_sum += row_data [valIdx];
+          ++row_count;
         }
+        current_row [colIdx + 1] = previous_row [colIdx + 1] + row_sum;
+        count_current_row [colIdx + 1] = count_previous_row [colIdx + 1] + row_count;
       }
     }
-  }
-  else
-  {
-    SecondOrderType* so_previous_row = &second_order_integral_image_[0];
-    SecondOrderType* so_current_row  = so_previous_row + (width_ + 1);
-    memset (so_previous_row, 0, sizeof (SecondOrderType) * (width_ + 1));
-
-    for (unsigned rowIdx = 0; rowIdx < height_; ++rowIdx, data += row_stride,
-                                                previous_row = current_row, current_row += (width_ + 1),
-                                                count_previous_row = count_current_row, count_current_row += (width_ + 1),
-                                                so_previous_row = so_current_row, so_current_row += (width_ + 1))
+    else
     {
-      current_row [0] = 0.0;
+      SecondOrderType* so_current_row = &second_order_integral_image_[(rowIdx + 1) * row_size];
+      const SecondOrderType* so_previous_row = &second_order_integral_image_[previous_row_offset];
       so_current_row [0] = 0.0;
-      count_current_row [0] = 0;
+
+      SecondOrderType so_row_sum = 0.0;
       for (unsigned colIdx = 0, valIdx = 0; colIdx < width_; ++colIdx, valIdx += element_stride)
       {
-        current_row [colIdx + 1] = previous_row [colIdx + 1] + current_row [colIdx] - previous_row [colIdx];
-        so_current_row [colIdx + 1] = so_previous_row [colIdx + 1] + so_current_row [colIdx] - so_previous_row [colIdx];
-        count_current_row [colIdx + 1] = count_previous_row [colIdx + 1] + count_current_row [colIdx] - count_previous_row [colIdx];
-        if (pcl_isfinite (data[valIdx]))
+        if (pcl_isfinite (row_data [valIdx]))
         {
-          current_row [colIdx + 1] += data[valIdx];
-          so_current_row [colIdx + 1] += data[valIdx] * data[valIdx];
-          ++(count_current_row [colIdx + 1]);
+          row_sum += row_data [valIdx];
+          so_row_sum += row_data [valIdx] * row_data [valIdx];
+          ++row_count;
         }
+        current_row [colIdx + 1] = previous_row [colIdx + 1] + row_sum;
+        so_current_row [colIdx + 1] = so_previous_row [colIdx + 1] + so_row_sum;
+        count_current_row [colIdx + 1] = count_previous_row [colIdx + 1] + row_count;
       }
     }
   }
+
+  if (add_rows_in_place)
+    return;
+
+  // Add the rows up, skipping the first one which is all zeros
+  detail::accumulateIntegralImageRows (&first_order_integral_image_[row_size], row_size, height_, threads_);
+  detail::accumulateIntegralImageRows (&finite_values_integral_image_[row_size], row_size, height_, threads_);
+  if (compute_second_order_integral_images_)
+    detail::accumulateIntegralImageRows (&second_order_integral_image_[row_size], row_size, height_, threads_);
 }
 #endif    // PCL_INTEGRAL_IMAGE2D_IMPL_H_
 
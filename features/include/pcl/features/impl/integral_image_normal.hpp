@@ -40,6 +40,10 @@
 #define PCL_FEATURES_INTEGRALIMAGE_BASED_IMPL_NORMAL_ESTIMATOR_H_
 
 #include <pcl/features/integral_image_normal.h>
+#include <pcl/common/transforms.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 //////////////////////////////////////////////////////////////////////////////////////////
 template <typename PointInT, typename PointOutT>
@@ -87,6 +91,20 @@ pcl::IntegralImageNormalEstimation<PointInT, PointOutT>::initData ()
     initSimple3DGradientMethod ();
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointInT, typename PointOutT> void
+pcl::IntegralImageNormalEstimation<PointInT, PointOutT>::lazyInitData ()
+{
+  if (normal_estimation_method_ == COVARIANCE_MATRIX && !init_covariance_matrix_)
+    initCovarianceMatrixMethod ();
+  else if (normal_estimation_method_ == AVERAGE_3D_GRADIENT && !init_average_3d_gradient_)
+    initAverage3DGradientMethod ();
+  else if (normal_estimation_method_ == AVERAGE_DEPTH_CHANGE && !init_depth_change_)
+    initAverageDepthChangeMethod ();
+  else if (normal_estimation_method_ == SIMPLE_3D_GRADIENT && !init_simple_3d_gradient_)
+    initSimple3DGradientMethod ();
+}
+
 
 //////////////////////////////////////////////////////////////////////////////////////////
 template <typename PointInT, typename PointOutT> void
@@ -112,6 +130,7 @@ pcl::IntegralImageNormalEstimation<PointInT, PointOutT>::initSimple3DGradientMet
   const float *data_ = reinterpret_cast<const float*> (&input_->points[0]);
 
   integral_image_XYZ_.setSecondOrderComputation (false);
+  integral_image_XYZ_.setNumberOfThreads (threads_);
   integral_image_XYZ_.setInput (data_, input_->width, input_->height, element_stride, row_stride);
 
   init_simple_3d_gradient_ = true;
@@ -130,6 +149,7 @@ pcl::IntegralImageNormalEstimation<PointInT, PointOutT>::initCovarianceMatrixMet
   const float *data_ = reinterpret_cast<const float*> (&input_->points[0]);
 
   integral_image_XYZ_.setSecondOrderComputation (true);
+  integral_image_XYZ_.setNumberOfThreads (threads_);
   integral_image_XYZ_.setInput (data_, input_->width, input_->height, element_stride, row_stride);
 
   init_covariance_matrix_ = true;
@@ -141,6 +161,8 @@ template <typename PointInT, typename PointOutT> void
 pcl::IntegralImageNormalEstimation<PointInT, PointOutT>::initAverage3DGradientMethod ()
 {
   size_t data_size = (input_->points.size () << 2);
+  if (diff_x_ != NULL) delete[] diff_x_;
+  if (diff_y_ != NULL) delete[] diff_y_;
   diff_x_ = new float[data_size];
   diff_y_ = new float[data_size];
 
@@ -150,23 +172,34 @@ pcl::IntegralImageNormalEstimation<PointInT, PointOutT>::initAverage3DGradientMe
   // x u x
   // l x r
   // x d x
-  const PointInT* point_up = &(input_->points [1]);
-  const PointInT* point_dn = point_up + (input_->width << 1);//&(input_->points [1 + (input_->width << 1)]);
-  const PointInT* point_lf = &(input_->points [input_->width]);
-  const PointInT* point_rg = point_lf + 2; //&(input_->points [input_->width + 2]);
-  float* diff_x_ptr = diff_x_ + ((input_->width + 1) << 2);
-  float* diff_y_ptr = diff_y_ + ((input_->width + 1) << 2);
-  unsigned diff_skip = 8; // skip last element in row and the first in the next row
-
-  for (size_t ri = 1; ri < input_->height - 1; ++ri
-                                             , point_up += input_->width
-                                             , point_dn += input_->width
-                                             , point_lf += input_->width
-                                             , point_rg += input_->width
-                                             , diff_x_ptr += diff_skip
-                                             , diff_y_ptr += diff_skip)
+  const int width = input_->width;
+  const int height = input_->height;
+#ifdef _OPENMP
+#pragma omp parallel for schedule (static) num_threads (threads_)
+#endif
+  for (int ri = 1; ri < height - 1; ++ri)
   {
-    for (size_t ci = 0; ci < input_->width - 2; ++ci, diff_x_ptr += 4, diff_y_ptr += 4)
+    const PointInT* point_up = &(input_->points [(ri - 1) * width + 1]);
+    const PointInT* point_dn = &(input_->points [(ri + 1) * width + 1]);
+    const PointInT* point_lf = &(input_->points [ri * width]);
+    const PointInT* point_rg = point_lf + 2;
+    float* diff_x_ptr = diff_x_ + ((ri * width + 1) << 2);
+    float* diff_y_ptr = diff_y_ + ((ri * width + 1) << 2);
+
+    int ci = 0;
+#if defined(__SSE2__)
+    // Points laid out by PCL_ADD_POINT4D start with an x, y, z, padding quadruple and take one subtraction
+    // per difference, the differences of the padding are not part of the integral images
+    if (pcl::detail::HasPoint4D<PointInT>::value)
+    {
+      for (; ci < width - 2; ++ci, diff_x_ptr += 4, diff_y_ptr += 4)
+      {
+        _mm_storeu_ps (diff_x_ptr, _mm_sub_ps (_mm_loadu_ps (&point_rg[ci].x), _mm_loadu_ps (&point_lf[ci].x)));
+        _mm_storeu_ps (diff_y_ptr, _mm_sub_ps (_mm_loadu_ps (&point_dn[ci].x), _mm_loadu_ps (&point_up[ci].x)));
+      }
+    }
+#endif
+    for (; ci < width - 2; ++ci, diff_x_ptr += 4, diff_y_ptr += 4)
     {
       diff_x_ptr[0] = point_rg[ci].x - point_lf[ci].x;
       diff_x_ptr[1] = point_rg[ci].y - point_lf[ci].y;
@@ -179,6 +212,8 @@ pcl::IntegralImageNormalEstimation<PointInT, PointOutT>::initAverage3DGradientMe
   }
 
   // Compute integral images
+  integral_image_DX_.setNumberOfThreads (threads_);
+  integral_image_DY_.setNumberOfThreads (threads_);
   integral_image_DX_.setInput (diff_x_, input_->width, input_->height, 4, input_->width << 2);
   integral_image_DY_.setInput (diff_y_, input_->width, input_->height, 4, input_->width << 2);
   init_covariance_matrix_ = init_depth_change_ = init_simple_3d_gradient_ = false;
@@ -197,6 +232,7 @@ pcl::IntegralImageNormalEstimation<PointInT, PointOutT>::initAverageDepthChangeM
   const float *data_ = reinterpret_cast<const float*> (&input_->points[0]);
 
   // integral image over the z - value
+  integral_image_depth_.setNumberOfThreads (threads_);
   integral_image_depth_.setInput (&(data_[2]), input_->width, input_->height, element_stride, row_stride);
   init_depth_change_ = true;
   init_covariance_matrix_ = init_average_3d_gradient_ = init_simple_3d_gradient_ = false;
@@ -207,14 +243,23 @@ template <typename PointInT, typename PointOutT> void
 pcl::IntegralImageNormalEstimation<PointInT, PointOutT>::computePointNormal (
     const int pos_x, const int pos_y, const unsigned point_index, PointOutT &normal)
 {
+  lazyInitData ();
+  computePointNormal (pos_x, pos_y, point_index, rect_width_, rect_height_, normal);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointInT, typename PointOutT> void
+pcl::IntegralImageNormalEstimation<PointInT, PointOutT>::computePointNormal (
+    const int pos_x, const int pos_y, const unsigned point_index,
+    const int rect_width, const int rect_height, PointOutT &normal) const
+{
+  const int rect_width_2 = rect_width / 2, rect_width_4 = rect_width / 4;
+  const int rect_height_2 = rect_height / 2, rect_height_4 = rect_height / 4;
   float bad_point = std::numeric_limits<float>::quiet_NaN ();
 
   if (normal_estimation_method_ == COVARIANCE_MATRIX)
   {
-    if (!init_covariance_matrix_)
-      initCovarianceMatrixMethod ();
-
-    unsigned count = integral_image_XYZ_.getFiniteElementsCount (pos_x - (rect_width_2_), pos_y - (rect_height_2_), rect_width_, rect_height_);
+    unsigned count = integral_image_XYZ_.getFiniteElementsCount (pos_x - (rect_width_2), pos_y - (rect_height_2), rect_width, rect_height);
 
     // no valid points within the rectangular reagion?
     if (count == 0)
@@ -226,8 +271,8 @@ pcl::IntegralImageNormalEstimation<PointInT, PointOutT>::computePointNormal (
     EIGEN_ALIGN16 Eigen::Matrix3f covariance_matrix;
     Eigen::Vector3f center;
     typename IntegralImage2D<float, 3>::SecondOrderType so_elements;
-    center = integral_image_XYZ_.getFirstOrderSum(pos_x - rect_width_2_, pos_y - rect_height_2_, rect_width_, rect_height_).template cast<float> ();
-    so_elements = integral_image_XYZ_.getSecondOrderSum(pos_x - rect_width_2_, pos_y - rect_height_2_, rect_width_, rect_height_);
+    center = integral_image_XYZ_.getFirstOrderSum(pos_x - rect_width_2, pos_y - rect_height_2, rect_width, rect_height).template cast<float> ();
+    so_elements = integral_image_XYZ_.getSecondOrderSum(pos_x - rect_width_2, pos_y - rect_height_2, rect_width, rect_height);
 
     covariance_matrix.coeffRef (0) = static_cast<float> (so_elements [0]);
     covariance_matrix.coeffRef (1) = covariance_matrix.coeffRef (3) = static_cast<float> (so_elements [1]);
@@ -252,18 +297,15 @@ pcl::IntegralImageNormalEstimation<PointInT, PointOutT>::computePointNormal (
   }
   else if (normal_estimation_method_ == AVERAGE_3D_GRADIENT)
   {
-    if (!init_average_3d_gradient_)
-      initAverage3DGradientMethod ();
-
-    unsigned count_x = integral_image_DX_.getFiniteElementsCount (pos_x - rect_width_2_, pos_y - rect_height_2_, rect_width_, rect_height_);
-    unsigned count_y = integral_image_DY_.getFiniteElementsCount (pos_x - rect_width_2_, pos_y - rect_height_2_, rect_width_, rect_height_);
+    unsigned count_x = integral_image_DX_.getFiniteElementsCount (pos_x - rect_width_2, pos_y - rect_height_2, rect_width, rect_height);
+    unsigned count_y = integral_image_DY_.getFiniteElementsCount (pos_x - rect_width_2, pos_y - rect_height_2, rect_width, rect_height);
     if (count_x == 0 || count_y == 0)
     {
       normal.normal_x = normal.normal_y = normal.normal_z = normal.curvature = bad_point;
       return;
     }
-    Eigen::Vector3d gradient_x = integral_image_DX_.getFirstOrderSum (pos_x - rect_width_2_, pos_y - rect_height_2_, rect_width_, rect_height_);
-    Eigen::Vector3d gradient_y = integral_image_DY_.getFirstOrderSum (pos_x - rect_width_2_, pos_y - rect_height_2_, rect_width_, rect_height_);
+    Eigen::Vector3d gradient_x = integral_image_DX_.getFirstOrderSum (pos_x - rect_width_2, pos_y - rect_height_2, rect_width, rect_height);
+    Eigen::Vector3d gradient_y = integral_image_DY_.getFirstOrderSum (pos_x - rect_width_2, pos_y - rect_height_2, rect_width, rect_height);
 
     Eigen::Vector3d normal_vector = gradient_y.cross (gradient_x);
     double normal_length = normal_vector.squaredNorm ();
@@ -290,14 +332,11 @@ pcl::IntegralImageNormalEstimation<PointInT, PointOutT>::computePointNormal (
   }
   else if (normal_estimation_method_ == AVERAGE_DEPTH_CHANGE)
   {
-    if (!init_depth_change_)
-      initAverageDepthChangeMethod ();
-
     // width and height are at least 3 x 3
-    unsigned count_L_z = integral_image_depth_.getFiniteElementsCount (pos_x - rect_width_2_, pos_y - rect_height_4_, rect_width_2_, rect_height_2_);
-    unsigned count_R_z = integral_image_depth_.getFiniteElementsCount (pos_x + 1            , pos_y - rect_height_4_, rect_width_2_, rect_height_2_);
-    unsigned count_U_z = integral_image_depth_.getFiniteElementsCount (pos_x - rect_width_4_, pos_y - rect_height_2_, rect_width_2_, rect_height_2_);
-    unsigned count_D_z = integral_image_depth_.getFiniteElementsCount (pos_x - rect_width_4_, pos_y + 1             , rect_width_2_, rect_height_2_);
+    unsigned count_L_z = integral_image_depth_.getFiniteElementsCount (pos_x - rect_width_2, pos_y - rect_height_4, rect_width_2, rect_height_2);
+    unsigned count_R_z = integral_image_depth_.getFiniteElementsCount (pos_x + 1            , pos_y - rect_height_4, rect_width_2, rect_height_2);
+    unsigned count_U_z = integral_image_depth_.getFiniteElementsCount (pos_x - rect_width_4, pos_y - rect_height_2, rect_width_2, rect_height_2);
+    unsigned count_D_z = integral_image_depth_.getFiniteElementsCount (pos_x - rect_width_4, pos_y + 1             , rect_width_2, rect_height_2);
 
     if (count_L_z == 0 || count_R_z == 0 || count_U_z == 0 || count_D_z == 0)
     {
@@ -305,15 +344,15 @@ pcl::IntegralImageNormalEstimation<PointInT, PointOutT>::computePointNormal (
       return;
     }
 
-    float mean_L_z = static_cast<float> (integral_image_depth_.getFirstOrderSum (pos_x - rect_width_2_, pos_y - rect_height_4_, rect_width_2_, rect_height_2_) / count_L_z);
-    float mean_R_z = static_cast<float> (integral_image_depth_.getFirstOrderSum (pos_x + 1            , pos_y - rect_height_4_, rect_width_2_, rect_height_2_) / count_R_z);
-    float mean_U_z = static_cast<float> (integral_image_depth_.getFirstOrderSum (pos_x - rect_width_4_, pos_y - rect_height_2_, rect_width_2_, rect_height_2_) / count_U_z);
-    float mean_D_z = static_cast<float> (integral_image_depth_.getFirstOrderSum (pos_x - rect_width_4_, pos_y + 1             , rect_width_2_, rect_height_2_) / count_D_z);
+    float mean_L_z = static_cast<float> (integral_image_depth_.getFirstOrderSum (pos_x - rect_width_2, pos_y - rect_height_4, rect_width_2, rect_height_2) / count_L_z);
+    float mean_R_z = static_cast<float> (integral_image_depth_.getFirstOrderSum (pos_x + 1            , pos_y - rect_height_4, rect_width_2, rect_height_2) / count_R_z);
+    float mean_U_z = static_cast<float> (integral_image_depth_.getFirstOrderSum (pos_x - rect_width_4, pos_y - rect_height_2, rect_width_2, rect_height_2) / count_U_z);
+    float mean_D_z = static_cast<float> (integral_image_depth_.getFirstOrderSum (pos_x - rect_width_4, pos_y + 1             , rect_width_2, rect_height_2) / count_D_z);
 
-    PointInT pointL = input_->points[point_index - rect_width_4_ - 1];
-    PointInT pointR = input_->points[point_index + rect_width_4_ + 1];
-    PointInT pointU = input_->points[point_index - rect_height_4_ * input_->width - 1];
-    PointInT pointD = input_->points[point_index + rect_height_4_ * input_->width + 1];
+    PointInT pointL = input_->points[point_index - rect_width_4 - 1];
+    PointInT pointR = input_->points[point_index + rect_width_4 + 1];
+    PointInT pointU = input_->points[point_index - rect_height_4 * input_->width - 1];
+    PointInT pointD = input_->points[point_index + rect_height_4 * input_->width + 1];
 
     const float mean_x_z = mean_R_z - mean_L_z;
     const float mean_y_z = mean_D_z - mean_U_z;
@@ -349,15 +388,12 @@ pcl::IntegralImageNormalEstimation<PointInT, PointOutT>::computePointNormal (
   }
   else if (normal_estimation_method_ == SIMPLE_3D_GRADIENT)
   {
-    if (!init_simple_3d_gradient_)
-      initSimple3DGradientMethod ();
-
     // this method does not work if lots of NaNs are in the neighborhood of the point
-    Eigen::Vector3d gradient_x = integral_image_XYZ_.getFirstOrderSum (pos_x + rect_width_2_, pos_y - rect_height_2_, 1, rect_height_) -
-                                 integral_image_XYZ_.getFirstOrderSum (pos_x - rect_width_2_, pos_y - rect_height_2_, 1, rect_height_);
+    Eigen::Vector3d gradient_x = integral_image_XYZ_.getFirstOrderSum (pos_x + rect_width_2, pos_y - rect_height_2, 1, rect_height) -
+                                 integral_image_XYZ_.getFirstOrderSum (pos_x - rect_width_2, pos_y - rect_height_2, 1, rect_height);
 
-    Eigen::Vector3d gradient_y = integral_image_XYZ_.getFirstOrderSum (pos_x - rect_width_2_, pos_y + rect_height_2_, rect_width_, 1) -
-                                 integral_image_XYZ_.getFirstOrderSum (pos_x - rect_width_2_, pos_y - rect_height_2_, rect_width_, 1);
+    Eigen::Vector3d gradient_y = integral_image_XYZ_.getFirstOrderSum (pos_x - rect_width_2, pos_y + rect_height_2, rect_width, 1) -
+                                 integral_image_XYZ_.getFirstOrderSum (pos_x - rect_width_2, pos_y - rect_height_2, rect_width, 1);
     Eigen::Vector3d normal_vector = gradient_y.cross (gradient_x);
     double normal_length = normal_vector.squaredNorm ();
     if (normal_length == 0.0f)
@@ -462,6 +498,18 @@ template <typename PointInT, typename PointOutT> void
 pcl::IntegralImageNormalEstimation<PointInT, PointOutT>::computePointNormalMirror (
     const int pos_x, const int pos_y, const unsigned point_index, PointOutT &normal)
 {
+  lazyInitData ();
+  computePointNormalMirror (pos_x, pos_y, point_index, rect_width_, rect_height_, normal);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointInT, typename PointOutT> void
+pcl::IntegralImageNormalEstimation<PointInT, PointOutT>::computePointNormalMirror (
+    const int pos_x, const int pos_y, const unsigned point_index,
+    const int rect_width, const int rect_height, PointOutT &normal) const
+{
+  const int rect_width_2 = rect_width / 2, rect_width_4 = rect_width / 4;
+  const int rect_height_2 = rect_height / 2, rect_height_4 = rect_height / 4;
   float bad_point = std::numeric_limits<float>::quiet_NaN ();
 
   const int width = input_->width;
@@ -470,13 +518,10 @@ pcl::IntegralImageNormalEstimation<PointInT, PointOutT>::computePointNormalMirro
   // ==============================================================
   if (normal_estimation_method_ == COVARIANCE_MATRIX) 
   {
-    if (!init_covariance_matrix_)
-      initCovarianceMatrixMethod ();
-
-    const int start_x = pos_x - rect_width_2_;
-    const int start_y = pos_y - rect_height_2_;
-    const int end_x = start_x + rect_width_;
-    const int end_y = start_y + rect_height_;
+    const int start_x = pos_x - rect_width_2;
+    const int start_y = pos_y - rect_height_2;
+    const int end_x = start_x + rect_width;
+    const int end_y = start_y + rect_height;
 
     unsigned count = 0;
     sumArea<unsigned>(start_x, start_y, end_x, end_y, width, height, boost::bind(&IntegralImage2D<float, 3>::getFiniteElementsCountSE, &integral_image_XYZ_, _1, _2, _3, _4), count);
@@ -538,13 +583,10 @@ pcl::IntegralImageNormalEstimation<PointInT, PointOutT>::computePointNormalMirro
   // =======================================================
   else if (normal_estimation_method_ == AVERAGE_3D_GRADIENT) 
   {
-    if (!init_average_3d_gradient_)
-      initAverage3DGradientMethod ();
-
-    const int start_x = pos_x - rect_width_2_;
-    const int start_y = pos_y - rect_height_2_;
-    const int end_x = start_x + rect_width_;
-    const int end_y = start_y + rect_height_;
+    const int start_x = pos_x - rect_width_2;
+    const int start_y = pos_y - rect_height_2;
+    const int end_x = start_x + rect_width;
+    const int end_y = start_y + rect_height;
 
     unsigned count_x = 0;
     unsigned count_y = 0;
@@ -591,17 +633,14 @@ pcl::IntegralImageNormalEstimation<PointInT, PointOutT>::computePointNormalMirro
   // ======================================================
   else if (normal_estimation_method_ == AVERAGE_DEPTH_CHANGE) 
   {
-    if (!init_depth_change_)
-      initAverageDepthChangeMethod ();
-
-    int point_index_L_x = pos_x - rect_width_4_ - 1;
+    int point_index_L_x = pos_x - rect_width_4 - 1;
     int point_index_L_y = pos_y;
-    int point_index_R_x = pos_x + rect_width_4_ + 1;
+    int point_index_R_x = pos_x + rect_width_4 + 1;
     int point_index_R_y = pos_y;
     int point_index_U_x = pos_x - 1;
-    int point_index_U_y = pos_y - rect_height_4_;
+    int point_index_U_y = pos_y - rect_height_4;
     int point_index_D_x = pos_x + 1;
-    int point_index_D_y = pos_y + rect_height_4_;
+    int point_index_D_y = pos_y + rect_height_4;
 
     if (point_index_L_x < 0)
       point_index_L_x = -point_index_L_x;
@@ -617,25 +656,25 @@ pcl::IntegralImageNormalEstimation<PointInT, PointOutT>::computePointNormalMirro
     if (point_index_D_y >= height)
       point_index_D_y = height-(point_index_D_y-(height-1));
 
-    const int start_x_L = pos_x - rect_width_2_;
-    const int start_y_L = pos_y - rect_height_4_;
-    const int end_x_L = start_x_L + rect_width_2_;
-    const int end_y_L = start_y_L + rect_height_2_;
+    const int start_x_L = pos_x - rect_width_2;
+    const int start_y_L = pos_y - rect_height_4;
+    const int end_x_L = start_x_L + rect_width_2;
+    const int end_y_L = start_y_L + rect_height_2;
 
     const int start_x_R = pos_x + 1;
-    const int start_y_R = pos_y - rect_height_4_;
-    const int end_x_R = start_x_R + rect_width_2_;
-    const int end_y_R = start_y_R + rect_height_2_;
+    const int start_y_R = pos_y - rect_height_4;
+    const int end_x_R = start_x_R + rect_width_2;
+    const int end_y_R = start_y_R + rect_height_2;
 
-    const int start_x_U = pos_x - rect_width_4_;
-    const int start_y_U = pos_y - rect_height_2_;
-    const int end_x_U = start_x_U + rect_width_2_;
-    const int end_y_U = start_y_U + rect_height_2_;
+    const int start_x_U = pos_x - rect_width_4;
+    const int start_y_U = pos_y - rect_height_2;
+    const int end_x_U = start_x_U + rect_width_2;
+    const int end_y_U = start_y_U + rect_height_2;
 
-    const int start_x_D = pos_x - rect_width_4_;
+    const int start_x_D = pos_x - rect_width_4;
     const int start_y_D = pos_y + 1;
-    const int end_x_D = start_x_D + rect_width_2_;
-    const int end_y_D = start_y_D + rect_height_2_;
+    const int end_x_D = start_x_D + rect_width_2;
+    const int end_y_D = start_y_D + rect_height_2;
 
     unsigned count_L_z = 0;
     unsigned count_R_z = 0;
@@ -816,6 +855,14 @@ pcl::IntegralImageNormalEstimation<PointInT, PointOutT>::computeFeature (PointCl
     current_row -= input_->width;
   }
 
+  // The per point computations run in parallel, so they can neither initialize data nor throw
+  lazyInitData ();
+  if (border_policy_ == BORDER_POLICY_MIRROR && normal_estimation_method_ == SIMPLE_3D_GRADIENT)
+  {
+    delete[] depthChangeMap;
+    PCL_THROW_EXCEPTION (PCLException, "BORDER_POLICY_MIRROR not supported for normal estimation method SIMPLE_3D_GRADIENT");
+  }
+
   if (indices_->size () < input_->size ())
     computeFeaturePart (distanceMap, bad_point, output);
   else
@@ -830,7 +877,8 @@ pcl::IntegralImageNormalEstimation<PointInT, PointOutT>::computeFeatureFull (con
                                                                              const float &bad_point,
                                                                              PointCloudOut &output)
 {
-  unsigned index = 0;
+  const int width = input_->width;
+  const int height = input_->height;
 
   if (border_policy_ == BORDER_POLICY_IGNORE)
   {
@@ -865,70 +913,37 @@ pcl::IntegralImageNormalEstimation<PointInT, PointOutT>::computeFeatureFull (con
       }
     }
 
-    if (use_depth_dependent_smoothing_)
+    const int inner_border = static_cast<int> (border);
+    // The rows are independent, each point only reads the integral images and writes its own normal
+#ifdef _OPENMP
+#pragma omp parallel for schedule (dynamic) num_threads (threads_)
+#endif
+    for (int ri = inner_border; ri < height - inner_border; ++ri)
     {
-      index = border + input_->width * border;
-      unsigned skip = (border << 1);
-      for (unsigned ri = border; ri < input_->height - border; ++ri, index += skip)
+      for (int ci = inner_border; ci < width - inner_border; ++ci)
       {
-        for (unsigned ci = border; ci < input_->width - border; ++ci, ++index)
+        const unsigned index = ri * width + ci;
+        const float depth = input_->points[index].z;
+        if (!pcl_isfinite (depth))
         {
-          index = ri * input_->width + ci;
-
-          const float depth = input_->points[index].z;
-          if (!pcl_isfinite (depth))
-          {
-            output[index].getNormalVector3fMap ().setConstant (bad_point);
-            output[index].curvature = bad_point;
-            continue;
-          }
-
-          float smoothing = (std::min)(distanceMap[index], normal_smoothing_size_ + static_cast<float>(depth)/10.0f);
-
-          if (smoothing > 2.0f)
-          {
-            setRectSize (static_cast<int> (smoothing), static_cast<int> (smoothing));
-            computePointNormal (ci, ri, index, output [index]);
-          }
-          else
-          {
-            output[index].getNormalVector3fMap ().setConstant (bad_point);
-            output[index].curvature = bad_point;
-          }
+          output[index].getNormalVector3fMap ().setConstant (bad_point);
+          output[index].curvature = bad_point;
+          continue;
         }
-      }
-    }
-    else
-    {
-      float smoothing_constant = normal_smoothing_size_;
 
-      index = border + input_->width * border;
-      unsigned skip = (border << 1);
-      for (unsigned ri = border; ri < input_->height - border; ++ri, index += skip)
-      {
-        for (unsigned ci = border; ci < input_->width - border; ++ci, ++index)
+        float smoothing = use_depth_dependent_smoothing_ ?
+                          (std::min)(distanceMap[index], normal_smoothing_size_ + static_cast<float>(depth)/10.0f) :
+                          (std::min)(distanceMap[index], normal_smoothing_size_);
+
+        if (smoothing > 2.0f)
+        {
+          const int rect_size = static_cast<int> (smoothing);
+          computePointNormal (ci, ri, index, rect_size, rect_size, output [index]);
+        }
+        else
         {
-          index = ri * input_->width + ci;
-
-          if (!pcl_isfinite (input_->points[index].z))
-          {
-            output [index].getNormalVector3fMap ().setConstant (bad_point);
-            output [index].curvature = bad_point;
-            continue;
-          }
-
-          float smoothing = (std::min)(distanceMap[index], smoothing_constant);
-
-          if (smoothing > 2.0f)
-          {
-            setRectSize (static_cast<int> (smoothing), static_cast<int> (smoothing));
-            computePointNormal (ci, ri, index, output [index]);
-          }
-          else
-          {
-            output [index].getNormalVector3fMap ().setConstant (bad_point);
-            output [index].curvature = bad_point;
-          }
+          output[index].getNormalVector3fMap ().setConstant (bad_point);
+          output[index].curvature = bad_point;
         }
       }
     }
@@ -937,74 +952,35 @@ pcl::IntegralImageNormalEstimation<PointInT, PointOutT>::computeFeatureFull (con
   {
     output.is_dense = false;
 
-    if (use_depth_dependent_smoothing_)
+#ifdef _OPENMP
+#pragma omp parallel for schedule (dynamic) num_threads (threads_)
+#endif
+    for (int ri = 0; ri < height; ++ri)
     {
-      //index = 0;
-      //unsigned skip = 0;
-      //for (unsigned ri = 0; ri < input_->height; ++ri, index += skip)
-      for (unsigned ri = 0; ri < input_->height; ++ri)
+      for (int ci = 0; ci < width; ++ci)
       {
-        //for (unsigned ci = 0; ci < input_->width; ++ci, ++index)
-        for (unsigned ci = 0; ci < input_->width; ++ci)
+        const unsigned index = ri * width + ci;
+        const float depth = input_->points[index].z;
+        if (!pcl_isfinite (depth))
         {
-          index = ri * input_->width + ci;
-
-          const float depth = input_->points[index].z;
-          if (!pcl_isfinite (depth))
-          {
-            output[index].getNormalVector3fMap ().setConstant (bad_point);
-            output[index].curvature = bad_point;
-            continue;
-          }
-
-          float smoothing = (std::min)(distanceMap[index], normal_smoothing_size_ + static_cast<float>(depth)/10.0f);
-
-          if (smoothing > 2.0f)
-          {
-            setRectSize (static_cast<int> (smoothing), static_cast<int> (smoothing));
-            computePointNormalMirror (ci, ri, index, output [index]);
-          }
-          else
-          {
-            output[index].getNormalVector3fMap ().setConstant (bad_point);
-            output[index].curvature = bad_point;
-          }
+          output[index].getNormalVector3fMap ().setConstant (bad_point);
+          output[index].curvature = bad_point;
+          continue;
         }
-      }
-    }
-    else
-    {
-      float smoothing_constant = normal_smoothing_size_;
 
-      //index = border + input_->width * border;
-      //unsigned skip = (border << 1);
-      //for (unsigned ri = border; ri < input_->height - border; ++ri, index += skip)
-      for (unsigned ri = 0; ri < input_->height; ++ri)
-      {
-        //for (unsigned ci = border; ci < input_->width - border; ++ci, ++index)
-        for (unsigned ci = 0; ci < input_->width; ++ci)
+        float smoothing = use_depth_dependent_smoothing_ ?
+                          (std::min)(distanceMap[index], normal_smoothing_size_ + static_cast<float>(depth)/10.0f) :
+                          (std::min)(distanceMap[index], normal_smoothing_size_);
+
+        if (smoothing > 2.0f)
         {
-          index = ri * input_->width + ci;
-
-          if (!pcl_isfinite (input_->points[index].z))
-          {
-            output [index].getNormalVector3fMap ().setConstant (bad_point);
-            output [index].curvature = bad_point;
-            continue;
-          }
-
-          float smoothing = (std::min)(distanceMap[index], smoothing_constant);
-
-          if (smoothing > 2.0f)
-          {
-            setRectSize (static_cast<int> (smoothing), static_cast<int> (smoothing));
-            computePointNormalMirror (ci, ri, index, output [index]);
-          }
-          else
-          {
-            output [index].getNormalVector3fMap ().setConstant (bad_point);
-            output [index].curvature = bad_point;
-          }
+          const int rect_size = static_cast<int> (smoothing);
+          computePointNormalMirror (ci, ri, index, rect_size, rect_size, output [index]);
+        }
+        else
+        {
+          output[index].getNormalVector3fMap ().setConstant (bad_point);
+          output[index].curvature = bad_point;
         }
       }
     }
@@ -1017,165 +993,54 @@ pcl::IntegralImageNormalEstimation<PointInT, PointOutT>::computeFeaturePart (con
                                                                              const float &bad_point,
                                                                              PointCloudOut &output)
 {
-  if (border_policy_ == BORDER_POLICY_IGNORE)
+  output.is_dense = false;
+  const bool ignore_border = (border_policy_ == BORDER_POLICY_IGNORE);
+  unsigned border = int(normal_smoothing_size_);
+  unsigned bottom = input_->height > border ? input_->height - border : 0;
+  unsigned right = input_->width > border ? input_->width - border : 0;
+
+  // Each index only reads the integral images and writes its own normal
+#ifdef _OPENMP
+#pragma omp parallel for schedule (dynamic, 256) num_threads (threads_)
+#endif
+  for (int idx = 0; idx < static_cast<int> (indices_->size ()); ++idx)
   {
-    output.is_dense = false;
-    unsigned border = int(normal_smoothing_size_);
-    unsigned bottom = input_->height > border ? input_->height - border : 0;
-    unsigned right = input_->width > border ? input_->width - border : 0;
-    if (use_depth_dependent_smoothing_)
-    {
-      // Iterating over the entire index vector
-      for (std::size_t idx = 0; idx < indices_->size (); ++idx)
-      {
-        unsigned pt_index = (*indices_)[idx];
-        unsigned u = pt_index % input_->width;
-        unsigned v = pt_index / input_->width;
-        if (v < border || v > bottom)
-        {
-          output.points[idx].getNormalVector3fMap ().setConstant (bad_point);
-          output.points[idx].curvature = bad_point;
-          continue;
-        }
-
-        if (u < border || v > right)
-        {
-          output.points[idx].getNormalVector3fMap ().setConstant (bad_point);
-          output.points[idx].curvature = bad_point;
-          continue;
-        }
-
-        const float depth = input_->points[pt_index].z;
-        if (!pcl_isfinite (depth))
-        {
-          output.points[idx].getNormalVector3fMap ().setConstant (bad_point);
-          output.points[idx].curvature = bad_point;
-          continue;
-        }
-
-        float smoothing = (std::min)(distanceMap[pt_index], normal_smoothing_size_ + static_cast<float>(depth)/10.0f);
-        if (smoothing > 2.0f)
-        {
-          setRectSize (static_cast<int> (smoothing), static_cast<int> (smoothing));
-          computePointNormal (u, v, pt_index, output [idx]);
-        }
-        else
-        {
-          output[idx].getNormalVector3fMap ().setConstant (bad_point);
-          output[idx].curvature = bad_point;
-        }
-      }
-    }
-    else
+    unsigned pt_index = (*indices_)[idx];
+    unsigned u = pt_index % input_->width;
+    unsigned v = pt_index / input_->width;
+    if (ignore_border && (v < border || v > bottom || u < border || u > right))
     {
-      float smoothing_constant = normal_smoothing_size_;
-      // Iterating over the entire index vector
-      for (std::size_t idx = 0; idx < indices_->size (); ++idx)
-      {
-        unsigned pt_index = (*indices_)[idx];
-        unsigned u = pt_index % input_->width;
-        unsigned v = pt_index / input_->width;
-        if (v < border || v > bottom)
-        {
-          output.points[idx].getNormalVector3fMap ().setConstant (bad_point);
-          output.points[idx].curvature = bad_point;
-          continue;
-        }
-
-        if (u < border || v > right)
-        {
-          output.points[idx].getNormalVector3fMap ().setConstant (bad_point);
-          output.points[idx].curvature = bad_point;
-          continue;
-        }
-
-        if (!pcl_isfinite (input_->points[pt_index].z))
-        {
-          output [idx].getNormalVector3fMap ().setConstant (bad_point);
-          output [idx].curvature = bad_point;
-          continue;
-        }
-
-        float smoothing = (std::min)(distanceMap[pt_index], smoothing_constant);
-
-        if (smoothing > 2.0f)
-        {
-          setRectSize (static_cast<int> (smoothing), static_cast<int> (smoothing));
-          computePointNormal (u, v, pt_index, output [idx]);
-        }
-        else
-        {
-          output [pt_index].getNormalVector3fMap ().setConstant (bad_point);
-          output [pt_index].curvature = bad_point;
-        }
-      }
+      output.points[idx].getNormalVector3fMap ().setConstant (bad_point);
+      output.points[idx].curvature = bad_point;
+      continue;
     }
-  }// border_policy_ == BORDER_POLICY_IGNORE
-  else if (border_policy_ == BORDER_POLICY_MIRROR)
-  {
-    output.is_dense = false;
 
-    if (use_depth_dependent_smoothing_)
+    const float depth = input_->points[pt_index].z;
+    if (!pcl_isfinite (depth))
     {
-      for (std::size_t idx = 0; idx < indices_->size (); ++idx)
-      {
-        unsigned pt_index = (*indices_)[idx];
-        unsigned u = pt_index % input_->width;
-        unsigned v = pt_index / input_->width;
-
-        const float depth = input_->points[pt_index].z;
-        if (!pcl_isfinite (depth))
-        {
-          output[idx].getNormalVector3fMap ().setConstant (bad_point);
-          output[idx].curvature = bad_point;
-          continue;
-        }
+      output [idx].getNormalVector3fMap ().setConstant (bad_point);
+      output [idx].curvature = bad_point;
+      continue;
+    }
 
-        float smoothing = (std::min)(distanceMap[pt_index], normal_smoothing_size_ + static_cast<float>(depth)/10.0f);
+    float smoothing = use_depth_dependent_smoothing_ ?
+                      (std::min)(distanceMap[pt_index], normal_smoothing_size_ + static_cast<float>(depth)/10.0f) :
+                      (std::min)(distanceMap[pt_index], normal_smoothing_size_);
 
-        if (smoothing > 2.0f)
-        {
-          setRectSize (static_cast<int> (smoothing), static_cast<int> (smoothing));
-          computePointNormalMirror (u, v, pt_index, output [idx]);
-        }
-        else
-        {
-          output[idx].getNormalVector3fMap ().setConstant (bad_point);
-          output[idx].curvature = bad_point;
-        }
-      }
+    if (smoothing > 2.0f)
+    {
+      const int rect_size = static_cast<int> (smoothing);
+      if (ignore_border)
+        computePointNormal (u, v, pt_index, rect_size, rect_size, output [idx]);
+      else
+        computePointNormalMirror (u, v, pt_index, rect_size, rect_size, output [idx]);
     }
     else
     {
-      float smoothing_constant = normal_smoothing_size_;
-      for (size_t idx = 0; idx < indices_->size (); ++idx)
-      {
-        unsigned pt_index = (*indices_)[idx];
-        unsigned u = pt_index % input_->width;
-        unsigned v = pt_index / input_->width;
-
-        if (!pcl_isfinite (input_->points[pt_index].z))
-        {
-          output [idx].getNormalVector3fMap ().setConstant (bad_point);
-          output [idx].curvature = bad_point;
-          continue;
-        }
-
-        float smoothing = (std::min)(distanceMap[pt_index], smoothing_constant);
-
-        if (smoothing > 2.0f)
-        {
-          setRectSize (static_cast<int> (smoothing), static_cast<int> (smoothing));
-          computePointNormalMirror (u, v, pt_index, output [idx]);
-        }
-        else
-        {
-          output [idx].getNormalVector3fMap ().setConstant (bad_point);
-          output [idx].curvature = bad_point;
-        }
-      }
+      output [idx].getNormalVector3fMap ().setConstant (bad_point);
+      output [idx].curvature = bad_point;
     }
-  } // border_policy_ == BORDER_POLICY_MIRROR
+  }
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -44,59 +44,68 @@
 #include <pcl/features/normal_3d.h>
 
 ///////////////////////////////////////////////////////////////////////////////////////////
-template <typename PointInT, typename PointOutT> void
-pcl::NormalEstimation<PointInT, PointOutT>::computeFeature (PointCloudOut &output)
+template <typename PointInT, typename PointOutT> bool
+pcl::NormalEstimation<PointInT, PointOutT>::computeFeatureBlock (int begin, int end, PointCloudOut &output) const
 {
-  // Allocate enough space to hold the results
+  const int batch_size = detail::PLANE_FIT_BATCH_SIZE;
+
+  // Allocate enough space to hold the results, one neighborhood per plane fit
   // \note This resize is irrelevant for a radiusSearch ().
-  std::vector<int> nn_indices (k_);
+  std::vector<std::vector<int> > nn_indices (batch_size, std::vector<int> (k_));
   std::vector<float> nn_dists (k_);
 
-  output.is_dense = true;
-  // Save a few cycles by not checking every point for NaN/Inf values if the cloud is set to dense
-  if (input_->is_dense)
-  {
-    // Iterating over the entire index vector
-    for (size_t idx = 0; idx < indices_->size (); ++idx)
-    {
-      if (this->searchForNeighbors ((*indices_)[idx], search_parameter_, nn_indices, nn_dists) == 0)
-      {
-        output.points[idx].normal[0] = output.points[idx].normal[1] = output.points[idx].normal[2] = output.points[idx].curvature = std::numeric_limits<float>::quiet_NaN ();
-
-        output.is_dense = false;
-        continue;
-      }
-
-      computePointNormal (*surface_, nn_indices,
-                          output.points[idx].normal[0], output.points[idx].normal[1], output.points[idx].normal[2], output.points[idx].curvature);
+  const std::vector<int> *neighborhoods[batch_size];
+  int fit_idx[batch_size];
+  float plane[batch_size][4], curvature[batch_size];
 
-      flipNormalTowardsViewpoint (input_->points[(*indices_)[idx]], vpx_, vpy_, vpz_,
-                                  output.points[idx].normal[0], output.points[idx].normal[1], output.points[idx].normal[2]);
-
-    }
-  }
-  else
+  bool dense = true;
+  int idx = begin;
+  while (idx < end)
   {
-    // Iterating over the entire index vector
-    for (size_t idx = 0; idx < indices_->size (); ++idx)
+    // Collect the neighborhoods of the next batch of points
+    int nr_fits = 0;
+    for (; idx < end && nr_fits < batch_size; ++idx)
     {
-      if (!isFinite ((*input_)[(*indices_)[idx]]) ||
-          this->searchForNeighbors ((*indices_)[idx], search_parameter_, nn_indices, nn_dists) == 0)
+      // Save a few cycles by not checking every point for NaN/Inf values if the cloud is set to dense
+      if ((!input_->is_dense && !isFinite ((*input_)[(*indices_)[idx]])) ||
+          this->searchForNeighbors ((*indices_)[idx], search_parameter_, nn_indices[nr_fits], nn_dists) == 0)
       {
         output.points[idx].normal[0] = output.points[idx].normal[1] = output.points[idx].normal[2] = output.points[idx].curvature = std::numeric_limits<float>::quiet_NaN ();
 
-        output.is_dense = false;
+        dense = false;
         continue;
       }
+      neighborhoods[nr_fits] = &nn_indices[nr_fits];
+      fit_idx[nr_fits] = idx;
+      ++nr_fits;
+    }
+    if (nr_fits == 0)
+      continue;
 
-      computePointNormal (*surface_, nn_indices,
-                          output.points[idx].normal[0], output.points[idx].normal[1], output.points[idx].normal[2], output.points[idx].curvature);
+    detail::computePlaneFits (&surface_->points[0].x, sizeof (PointInT), surface_->is_dense,
+                              neighborhoods, nr_fits, &plane[0][0], curvature);
 
-      flipNormalTowardsViewpoint (input_->points[(*indices_)[idx]], vpx_, vpy_, vpz_,
-                                  output.points[idx].normal[0], output.points[idx].normal[1], output.points[idx].normal[2]);
+    for (int f = 0; f < nr_fits; ++f)
+    {
+      PointOutT &p = output.points[fit_idx[f]];
+      p.normal[0] = plane[f][0];
+      p.normal[1] = plane[f][1];
+      p.normal[2] = plane[f][2];
+      p.curvature = curvature[f];
 
+      flipNormalTowardsViewpoint (input_->points[(*indices_)[fit_idx[f]]], vpx_, vpy_, vpz_,
+                                  p.normal[0], p.normal[1], p.normal[2]);
     }
   }
+  return (dense);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointInT, typename PointOutT> void
+pcl::NormalEstimation<PointInT, PointOutT>::computeFeature (PointCloudOut &output)
+{
+  // Hand out whole runs of batches, so that every thread keeps all the lanes of its plane fits busy
+  output.is_dense = this->computeFeatureForAllIndices (output, 4 * detail::PLANE_FIT_BATCH_SIZE);
 }
 
 #define PCL_INSTANTIATE_NormalEstimation(T,NT) template class PCL_EXPORTS pcl::NormalEstimation<T,NT>;
@@ -45,7 +45,7 @@
 template <typename PointInT, typename PointNT, typename PointOutT> bool
 pcl::PFHEstimation<PointInT, PointNT, PointOutT>::computePairFeatures (
       const pcl::PointCloud<PointInT> &cloud, const pcl::PointCloud<PointNT> &normals,
-      int p_idx, int q_idx, float &f1, float &f2, float &f3, float &f4)
+      int p_idx, int q_idx, float &f1, float &f2, float &f3, float &f4) const
 {
   pcl::computePairFeatures (cloud.points[p_idx].getVector4fMap (), normals.points[p_idx].getNormalVector4fMap (),
                             cloud.points[q_idx].getVector4fMap (), normals.points[q_idx].getNormalVector4fMap (),
@@ -57,9 +57,11 @@ pcl::PFHEstimation<PointInT, PointNT, PointOutT>::computePairFeatures (
 template <typename PointInT, typename PointNT, typename PointOutT> void
 pcl::PFHEstimation<PointInT, PointNT, PointOutT>::computePointPFHSignature (
       const pcl::PointCloud<PointInT> &cloud, const pcl::PointCloud<PointNT> &normals,
-      const std::vector<int> &indices, int nr_split, Eigen::VectorXf &pfh_histogram)
+      const std::vector<int> &indices, int nr_split, Eigen::VectorXf &pfh_histogram) const
 {
   int h_index, h_p;
+  int f_index[3];
+  Eigen::Vector4f pfh_tuple;
 
   // Clear the resultant point histogram
   pfh_histogram.setZero ();
@@ -79,142 +81,85 @@ pcl::PFHEstimation<PointInT, PointNT, PointOutT>::computePointPFHSignature (
 
       if (use_cache_)
       {
-        // In order to create the key, always use the smaller index as the first key pair member
-        int p1, p2;
-  //      if (indices[i_idx] >= indices[j_idx])
-  //      {
-          p1 = indices[i_idx];
-          p2 = indices[j_idx];
-  //      }
-  //      else
-  //      {
-  //        p1 = indices[j_idx];
-  //        p2 = indices[i_idx];
-  //      }
-        key = std::pair<int, int> (p1, p2);
-
-        // Check to see if we already estimated this pair in the global hashmap
-        std::map<std::pair<int, int>, Eigen::Vector4f, std::less<std::pair<int, int> >, Eigen::aligned_allocator<Eigen::Vector4f> >::iterator fm_it = feature_map_.find (key);
-        if (fm_it != feature_map_.end ())
-          pfh_tuple_ = fm_it->second;
-        else
+        key = std::pair<int, int> (indices[i_idx], indices[j_idx]);
+
+        // Check to see if we already estimated this pair in the global cache
+        if (!feature_cache_.find (key, pfh_tuple))
         {
           // Compute the pair NNi to NNj
           if (!computePairFeatures (cloud, normals, indices[i_idx], indices[j_idx],
-                                    pfh_tuple_[0], pfh_tuple_[1], pfh_tuple_[2], pfh_tuple_[3]))
+                                    pfh_tuple[0], pfh_tuple[1], pfh_tuple[2], pfh_tuple[3]))
             continue;
+
+          // Save the value in the cache, which bounds its own size so that we don't go overboard on RAM usage
+          feature_cache_.insert (key, pfh_tuple);
         }
       }
       else
         if (!computePairFeatures (cloud, normals, indices[i_idx], indices[j_idx],
-                                  pfh_tuple_[0], pfh_tuple_[1], pfh_tuple_[2], pfh_tuple_[3]))
+                                  pfh_tuple[0], pfh_tuple[1], pfh_tuple[2], pfh_tuple[3]))
           continue;
 
       // Normalize the f1, f2, f3 features and push them in the histogram
-      f_index_[0] = static_cast<int> (floor (nr_split * ((pfh_tuple_[0] + M_PI) * d_pi_)));
-      if (f_index_[0] < 0)         f_index_[0] = 0;
-      if (f_index_[0] >= nr_split) f_index_[0] = nr_split - 1;
+      f_index[0] = static_cast<int> (floor (nr_split * ((pfh_tuple[0] + M_PI) * d_pi_)));
+      if (f_index[0] < 0)         f_index[0] = 0;
+      if (f_index[0] >= nr_split) f_index[0] = nr_split - 1;
 
-      f_index_[1] = static_cast<int> (floor (nr_split * ((pfh_tuple_[1] + 1.0) * 0.5)));
-      if (f_index_[1] < 0)         f_index_[1] = 0;
-      if (f_index_[1] >= nr_split) f_index_[1] = nr_split - 1;
+      f_index[1] = static_cast<int> (floor (nr_split * ((pfh_tuple[1] + 1.0) * 0.5)));
+      if (f_index[1] < 0)         f_index[1] = 0;
+      if (f_index[1] >= nr_split) f_index[1] = nr_split - 1;
 
-      f_index_[2] = static_cast<int> (floor (nr_split * ((pfh_tuple_[2] + 1.0) * 0.5)));
-      if (f_index_[2] < 0)         f_index_[2] = 0;
-      if (f_index_[2] >= nr_split) f_index_[2] = nr_split - 1;
+      f_index[2] = static_cast<int> (floor (nr_split * ((pfh_tuple[2] + 1.0) * 0.5)));
+      if (f_index[2] < 0)         f_index[2] = 0;
+      if (f_index[2] >= nr_split) f_index[2] = nr_split - 1;
 
       // Copy into the histogram
       h_index = 0;
       h_p     = 1;
       for (int d = 0; d < 3; ++d)
       {
-        h_index += h_p * f_index_[d];
+        h_index += h_p * f_index[d];
         h_p     *= nr_split;
       }
       pfh_histogram[h_index] += hist_incr;
-
-      if (use_cache_)
-      {
-        // Save the value in the hashmap
-        feature_map_[key] = pfh_tuple_;
-
-        // Use a maximum cache so that we don't go overboard on RAM usage
-        key_list_.push (key);
-        // Check to see if we need to remove an element due to exceeding max_size
-        if (key_list_.size () > max_cache_size_)
-        {
-          // Remove the last element.
-          feature_map_.erase (key_list_.back ());
-          key_list_.pop ();
-        }
-      }
     }
   }
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////
-template <typename PointInT, typename PointNT, typename PointOutT> void
-pcl::PFHEstimation<PointInT, PointNT, PointOutT>::computeFeature (PointCloudOut &output)
+template <typename PointInT, typename PointNT, typename PointOutT> bool
+pcl::PFHEstimation<PointInT, PointNT, PointOutT>::computePointFeature (
+    size_t index, std::vector<int> &nn_indices, std::vector<float> &nn_dists, PointOutT &output) const
 {
-  // Clear the feature map
-  feature_map_.clear ();
-  std::queue<std::pair<int, int> > empty;
-  std::swap (key_list_, empty);
-
-  pfh_histogram_.setZero (nr_subdiv_ * nr_subdiv_ * nr_subdiv_);
-
-  // Allocate enough space to hold the results
-  // \note This resize is irrelevant for a radiusSearch ().
-  std::vector<int> nn_indices (k_);
-  std::vector<float> nn_dists (k_);
+  const int nr_bins = nr_subdiv_ * nr_subdiv_ * nr_subdiv_;
 
-  output.is_dense = true;
   // Save a few cycles by not checking every point for NaN/Inf values if the cloud is set to dense
-  if (input_->is_dense)
+  if ((!input_->is_dense && !isFinite ((*input_)[(*indices_)[index]])) ||
+      this->searchForNeighbors ((*indices_)[index], search_parameter_, nn_indices, nn_dists) == 0)
   {
-    // Iterating over the entire index vector
-    for (size_t idx = 0; idx < indices_->size (); ++idx)
-    {
-      if (this->searchForNeighbors ((*indices_)[idx], search_parameter_, nn_indices, nn_dists) == 0)
-      {
-        for (int d = 0; d < pfh_histogram_.size (); ++d)
-          output.points[idx].histogram[d] = std::numeric_limits<float>::quiet_NaN ();
-
-        output.is_dense = false;
-        continue;
-      }
-
-      // Estimate the PFH signature at each patch
-      computePointPFHSignature (*surface_, *normals_, nn_indices, nr_subdiv_, pfh_histogram_);
-
-      // Copy into the resultant cloud
-      for (int d = 0; d < pfh_histogram_.size (); ++d)
-        output.points[idx].histogram[d] = pfh_histogram_[d];
-    }
+    for (int d = 0; d < nr_bins; ++d)
+      output.histogram[d] = std::numeric_limits<float>::quiet_NaN ();
+    return (false);
   }
-  else
-  {
-    // Iterating over the entire index vector
-    for (size_t idx = 0; idx < indices_->size (); ++idx)
-    {
-      if (!isFinite ((*input_)[(*indices_)[idx]]) ||
-          this->searchForNeighbors ((*indices_)[idx], search_parameter_, nn_indices, nn_dists) == 0)
-      {
-        for (int d = 0; d < pfh_histogram_.size (); ++d)
-          output.points[idx].histogram[d] = std::numeric_limits<float>::quiet_NaN ();
 
-        output.is_dense = false;
-        continue;
-      }
+  // Estimate the PFH signature at each patch
+  Eigen::VectorXf pfh_histogram (nr_bins);
+  computePointPFHSignature (*surface_, *normals_, nn_indices, nr_subdiv_, pfh_histogram);
 
-      // Estimate the PFH signature at each patch
-      computePointPFHSignature (*surface_, *normals_, nn_indices, nr_subdiv_, pfh_histogram_);
+  // Copy into the resultant cloud
+  for (int d = 0; d < nr_bins; ++d)
+    output.histogram[d] = pfh_histogram[d];
+  return (true);
+}
 
-      // Copy into the resultant cloud
-      for (int d = 0; d < pfh_histogram_.size (); ++d)
-        output.points[idx].histogram[d] = pfh_histogram_[d];
-    }
-  }
+//////////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointInT, typename PointNT, typename PointOutT> void
+pcl::PFHEstimation<PointInT, PointNT, PointOutT>::computeFeature (PointCloudOut &output)
+{
+  // Clear the feature cache and its statistics
+  feature_cache_.clear ();
+
+  output.is_dense = this->computeFeatureForAllIndices (output);
 }
 
 #define PCL_INSTANTIATE_PFHEstimation(T,NT,OutT) template class PCL_EXPORTS pcl::PFHEstimation<T,NT,OutT>;
@@ -47,118 +47,96 @@
 template <typename PointInT, typename PointNT, typename PointOutT> void
 pcl::PrincipalCurvaturesEstimation<PointInT, PointNT, PointOutT>::computePointPrincipalCurvatures (
       const pcl::PointCloud<PointNT> &normals, int p_idx, const std::vector<int> &indices,
-      float &pcx, float &pcy, float &pcz, float &pc1, float &pc2)
+      float &pcx, float &pcy, float &pcz, float &pc1, float &pc2) const
 {
   EIGEN_ALIGN16 Eigen::Matrix3f I = Eigen::Matrix3f::Identity ();
   Eigen::Vector3f n_idx (normals.points[p_idx].normal[0], normals.points[p_idx].normal[1], normals.points[p_idx].normal[2]);
   EIGEN_ALIGN16 Eigen::Matrix3f M = I - n_idx * n_idx.transpose ();    // projection matrix (into tangent plane)
 
-  // Project normals into the tangent plane
+  // Project normals into the tangent plane and estimate their centroid
   Eigen::Vector3f normal;
-  projected_normals_.resize (indices.size ());
-  xyz_centroid_.setZero ();
+  Eigen::Vector3f xyz_centroid = Eigen::Vector3f::Zero ();
   for (size_t idx = 0; idx < indices.size(); ++idx)
   {
     normal[0] = normals.points[indices[idx]].normal[0];
     normal[1] = normals.points[indices[idx]].normal[1];
     normal[2] = normals.points[indices[idx]].normal[2];
 
-    projected_normals_[idx] = M * normal;
-    xyz_centroid_ += projected_normals_[idx];
+    xyz_centroid += M * normal;
   }
-
-  // Estimate the XYZ centroid
-  xyz_centroid_ /= static_cast<float> (indices.size ());
+  xyz_centroid /= static_cast<float> (indices.size ());
 
   // Initialize to 0
-  covariance_matrix_.setZero ();
+  EIGEN_ALIGN16 Eigen::Matrix3f covariance_matrix = Eigen::Matrix3f::Zero ();
 
+  // The projections are recomputed rather than stored, so that no scratch space is shared between threads
+  Eigen::Vector3f demean;
   double demean_xy, demean_xz, demean_yz;
   // For each point in the cloud
   for (size_t idx = 0; idx < indices.size (); ++idx)
   {
-    demean_ = projected_normals_[idx] - xyz_centroid_;
+    normal[0] = normals.points[indices[idx]].normal[0];
+    normal[1] = normals.points[indices[idx]].normal[1];
+    normal[2] = normals.points[indices[idx]].normal[2];
+
+    demean = M * normal - xyz_centroid;
 
-    demean_xy = demean_[0] * demean_[1];
-    demean_xz = demean_[0] * demean_[2];
-    demean_yz = demean_[1] * demean_[2];
+    demean_xy = demean[0] * demean[1];
+    demean_xz = demean[0] * demean[2];
+    demean_yz = demean[1] * demean[2];
 
-    covariance_matrix_(0, 0) += demean_[0] * demean_[0];
-    covariance_matrix_(0, 1) += static_cast<float> (demean_xy);
-    covariance_matrix_(0, 2) += static_cast<float> (demean_xz);
+    covariance_matrix(0, 0) += demean[0] * demean[0];
+    covariance_matrix(0, 1) += static_cast<float> (demean_xy);
+    covariance_matrix(0, 2) += static_cast<float> (demean_xz);
 
-    covariance_matrix_(1, 0) += static_cast<float> (demean_xy);
-    covariance_matrix_(1, 1) += demean_[1] * demean_[1];
-    covariance_matrix_(1, 2) += static_cast<float> (demean_yz);
+    covariance_matrix(1, 0) += static_cast<float> (demean_xy);
+    covariance_matrix(1, 1) += demean[1] * demean[1];
+    covariance_matrix(1, 2) += static_cast<float> (demean_yz);
 
-    covariance_matrix_(2, 0) += static_cast<float> (demean_xz);
-    covariance_matrix_(2, 1) += static_cast<float> (demean_yz);
-    covariance_matrix_(2, 2) += demean_[2] * demean_[2];
+    covariance_matrix(2, 0) += static_cast<float> (demean_xz);
+    covariance_matrix(2, 1) += static_cast<float> (demean_yz);
+    covariance_matrix(2, 2) += demean[2] * demean[2];
   }
 
   // Extract the eigenvalues and eigenvectors
-  pcl::eigen33 (covariance_matrix_, eigenvalues_);
-  pcl::computeCorrespondingEigenVector (covariance_matrix_, eigenvalues_ [2], eigenvector_);
+  Eigen::Vector3f eigenvalues, eigenvector;
+  pcl::eigen33 (covariance_matrix, eigenvalues);
+  pcl::computeCorrespondingEigenVector (covariance_matrix, eigenvalues [2], eigenvector);
 
-  pcx = eigenvector_ [0];
-  pcy = eigenvector_ [1];
-  pcz = eigenvector_ [2];
+  pcx = eigenvector [0];
+  pcy = eigenvector [1];
+  pcz = eigenvector [2];
   float indices_size = 1.0f / static_cast<float> (indices.size ());
-  pc1 = eigenvalues_ [2] * indices_size;
-  pc2 = eigenvalues_ [1] * indices_size;
+  pc1 = eigenvalues [2] * indices_size;
+  pc2 = eigenvalues [1] * indices_size;
 }
 
-
 //////////////////////////////////////////////////////////////////////////////////////////////
-template <typename PointInT, typename PointNT, typename PointOutT> void
-pcl::PrincipalCurvaturesEstimation<PointInT, PointNT, PointOutT>::computeFeature (PointCloudOut &output)
+template <typename PointInT, typename PointNT, typename PointOutT> bool
+pcl::PrincipalCurvaturesEstimation<PointInT, PointNT, PointOutT>::computePointFeature (
+    size_t index, std::vector<int> &nn_indices, std::vector<float> &nn_dists, PointOutT &output) const
 {
-  // Allocate enough space to hold the results
-  // \note This resize is irrelevant for a radiusSearch ().
-  std::vector<int> nn_indices (k_);
-  std::vector<float> nn_dists (k_);
-
-  output.is_dense = true;
   // Save a few cycles by not checking every point for NaN/Inf values if the cloud is set to dense
-  if (input_->is_dense)
+  if ((!input_->is_dense && !isFinite ((*input_)[(*indices_)[index]])) ||
+      this->searchForNeighbors ((*indices_)[index], search_parameter_, nn_indices, nn_dists) == 0)
   {
-    // Iterating over the entire index vector
-    for (size_t idx = 0; idx < indices_->size (); ++idx)
-    {
-      if (this->searchForNeighbors ((*indices_)[idx], search_parameter_, nn_indices, nn_dists) == 0)
-      {
-        output.points[idx].principal_curvature[0] = output.points[idx].principal_curvature[1] = output.points[idx].principal_curvature[2] =
-          output.points[idx].pc1 = output.points[idx].pc2 = std::numeric_limits<float>::quiet_NaN ();
-        output.is_dense = false;
-        continue;
-      }
-
-      // Estimate the principal curvatures at each patch
-      computePointPrincipalCurvatures (*normals_, (*indices_)[idx], nn_indices,
-                                       output.points[idx].principal_curvature[0], output.points[idx].principal_curvature[1], output.points[idx].principal_curvature[2],
-                                       output.points[idx].pc1, output.points[idx].pc2);
-    }
-  }
-  else
-  {
-    // Iterating over the entire index vector
-    for (size_t idx = 0; idx < indices_->size (); ++idx)
-    {
-      if (!isFinite ((*input_)[(*indices_)[idx]]) ||
-          this->searchForNeighbors ((*indices_)[idx], search_parameter_, nn_indices, nn_dists) == 0)
-      {
-        output.points[idx].principal_curvature[0] = output.points[idx].principal_curvature[1] = output.points[idx].principal_curvature[2] =
-          output.points[idx].pc1 = output.points[idx].pc2 = std::numeric_limits<float>::quiet_NaN ();
-        output.is_dense = false;
-        continue;
-      }
-
-      // Estimate the principal curvatures at each patch
-      computePointPrincipalCurvatures (*normals_, (*indices_)[idx], nn_indices,
-                                       output.points[idx].principal_curvature[0], output.points[idx].principal_curvature[1], output.points[idx].principal_curvature[2],
-                                       output.points[idx].pc1, output.points[idx].pc2);
-    }
+    output.principal_curvature[0] = output.principal_curvature[1] = output.principal_curvature[2] =
+      output.pc1 = output.pc2 = std::numeric_limits<float>::quiet_NaN ();
+    return (false);
   }
+
+  // Estimate the principal curvatures at each patch
+  computePointPrincipalCurvatures (*normals_, (*indices_)[index], nn_indices,
+                                   output.principal_curvature[0], output.principal_curvature[1], output.principal_curvature[2],
+                                   output.pc1, output.pc2);
+  return (true);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointInT, typename PointNT, typename PointOutT> void
+pcl::PrincipalCurvaturesEstimation<PointInT, PointNT, PointOutT>::computeFeature (PointCloudOut &output)
+{
+  output.is_dense = this->computeFeatureForAllIndices (output);
 }
 
 #define PCL_INSTANTIATE_PrincipalCurvaturesEstimation(T,NT,OutT) template class PCL_EXPORTS pcl::PrincipalCurvaturesEstimation<T,NT,OutT>;
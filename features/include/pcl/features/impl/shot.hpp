@@ -772,17 +772,23 @@ pcl::SHOTEstimation<PointInT, PointNT, PointOutT, PointRFT>::computeFeature (pcl
 
   assert(descLength_ == 352);
 
-  shot_.setZero (descLength_);
+  int data_size = static_cast<int> (indices_->size ());
 
-  // Allocate enough space to hold the results
-  // \note This resize is irrelevant for a radiusSearch ().
-  std::vector<int> nn_indices (k_);
-  std::vector<float> nn_dists (k_);
-
-  output.is_dense = true;
+  bool dense = true;
   // Iterating over the entire index vector
-  for (size_t idx = 0; idx < indices_->size (); ++idx)
+#ifdef _OPENMP
+#pragma omp parallel for reduction (&& : dense) num_threads (threads_)
+#endif
+  for (int idx = 0; idx < data_size; ++idx)
   {
+    Eigen::VectorXf shot;
+    shot.setZero (descLength_);
+
+    // Allocate enough space to hold the results
+    // \note This resize is irrelevant for a radiusSearch ().
+    std::vector<int> nn_indices (k_);
+    std::vector<float> nn_dists (k_);
+
     bool lrf_is_nan = false;
     const PointRFT& current_frame = (*frames_)[idx];
     if (!pcl_isfinite (current_frame.x_axis[0]) ||
@@ -804,16 +810,16 @@ pcl::SHOTEstimation<PointInT, PointNT, PointOutT, PointRFT>::computeFeature (pcl
       for (int d = 0; d < 9; ++d)
         output.points[idx].rf[d] = std::numeric_limits<float>::quiet_NaN ();
 
-      output.is_dense = false;
+      dense = false;
       continue;
     }
 
     // Estimate the SHOT descriptor at each patch
-    computePointSHOT (static_cast<int> (idx), nn_indices, nn_dists, shot_);
+    computePointSHOT (idx, nn_indices, nn_dists, shot);
 
     // Copy into the resultant cloud
     for (int d = 0; d < descLength_; ++d)
-      output.points[idx].descriptor[d] = shot_[d];
+      output.points[idx].descriptor[d] = shot[d];
     for (int d = 0; d < 3; ++d)
     {
       output.points[idx].rf[d + 0] = frames_->points[idx].x_axis[d];
@@ -821,6 +827,7 @@ pcl::SHOTEstimation<PointInT, PointNT, PointOutT, PointRFT>::computeFeature (pcl
       output.points[idx].rf[d + 6] = frames_->points[idx].z_axis[d];
     }
   }
+  output.is_dense = dense;
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////
@@ -844,17 +851,27 @@ pcl::SHOTColorEstimation<PointInT, PointNT, PointOutT, PointRFT>::computeFeature
   radius1_4_ = search_radius_ / 4;
   radius1_2_ = search_radius_ / 2;
 
-  shot_.setZero (descLength_);
+  // RGB2CIELAB fills its static lookup tables on first use, do that before the threads share them
+  float l, a, b;
+  RGB2CIELAB (0, 0, 0, l, a, b);
 
-  // Allocate enough space to hold the results
-  // \note This resize is irrelevant for a radiusSearch ().
-  std::vector<int> nn_indices (k_);
-  std::vector<float> nn_dists (k_);
+  int data_size = static_cast<int> (indices_->size ());
 
-  output.is_dense = true;
+  bool dense = true;
   // Iterating over the entire index vector
-  for (size_t idx = 0; idx < indices_->size (); ++idx)
+#ifdef _OPENMP
+#pragma omp parallel for reduction (&& : dense) num_threads (threads_)
+#endif
+  for (int idx = 0; idx < data_size; ++idx)
   {
+    Eigen::VectorXf shot;
+    shot.setZero (descLength_);
+
+    // Allocate enough space to hold the results
+    // \note This resize is irrelevant for a radiusSearch ().
+    std::vector<int> nn_indices (k_);
+    std::vector<float> nn_dists (k_);
+
     bool lrf_is_nan = false;
     const PointRFT& current_frame = (*frames_)[idx];
     if (!pcl_isfinite (current_frame.x_axis[0]) ||
@@ -876,16 +893,16 @@ pcl::SHOTColorEstimation<PointInT, PointNT, PointOutT, PointRFT>::computeFeature
       for (int d = 0; d < 9; ++d)
         output.points[idx].rf[d] = std::numeric_limits<float>::quiet_NaN ();
 
-      output.is_dense = false;
+      dense = false;
       continue;
     }
 
-    // Compute the SHOT descriptor for the current 3D feature
-    computePointSHOT (static_cast<int> (idx), nn_indices, nn_dists, shot_);
+    // Estimate the SHOT descriptor at each patch
+    computePointSHOT (idx, nn_indices, nn_dists, shot);
 
     // Copy into the resultant cloud
     for (int d = 0; d < descLength_; ++d)
-      output.points[idx].descriptor[d] = shot_[d];
+      output.points[idx].descriptor[d] = shot[d];
     for (int d = 0; d < 3; ++d)
     {
       output.points[idx].rf[d + 0] = frames_->points[idx].x_axis[d];
@@ -893,6 +910,7 @@ pcl::SHOTColorEstimation<PointInT, PointNT, PointOutT, PointRFT>::computeFeature
       output.points[idx].rf[d + 6] = frames_->points[idx].z_axis[d];
     }
   }
+  output.is_dense = dense;
 }
 
 #define PCL_INSTANTIATE_SHOTEstimationBase(T,NT,OutT,RFT) template class PCL_EXPORTS pcl::SHOTEstimationBase<T,NT,OutT,RFT>;
@@ -119,150 +119,6 @@ pcl::SHOTColorEstimationOMP<PointInT, PointNT, PointOutT, PointRFT>::initCompute
   return (true);
 }
 
-//////////////////////////////////////////////////////////////////////////////////////////////
-template<typename PointInT, typename PointNT, typename PointOutT, typename PointRFT> void
-pcl::SHOTEstimationOMP<PointInT, PointNT, PointOutT, PointRFT>::computeFeature (PointCloudOut &output)
-{
-  descLength_ = nr_grid_sector_ * (nr_shape_bins_ + 1);
-
-  sqradius_ = search_radius_ * search_radius_;
-  radius3_4_ = (search_radius_ * 3) / 4;
-  radius1_4_ = search_radius_ / 4;
-  radius1_2_ = search_radius_ / 2;
-
-  assert(descLength_ == 352);
-
-  int data_size = static_cast<int> (indices_->size ());
-
-  output.is_dense = true;
-  // Iterating over the entire index vector
-#ifdef _OPENMP
-#pragma omp parallel for num_threads(threads_)
-#endif
-  for (int idx = 0; idx < data_size; ++idx)
-  {
-
-    Eigen::VectorXf shot;
-    shot.setZero (descLength_);
-
-    bool lrf_is_nan = false;
-    const PointRFT& current_frame = (*frames_)[idx];
-    if (!pcl_isfinite (current_frame.x_axis[0]) ||
-        !pcl_isfinite (current_frame.y_axis[0]) ||
-        !pcl_isfinite (current_frame.z_axis[0]))
-    {
-      PCL_WARN ("[pcl::%s::computeFeature] The local reference frame is not valid! Aborting description of point with index %d\n",
-        getClassName ().c_str (), (*indices_)[idx]);
-      lrf_is_nan = true;
-    }
-
-    // Allocate enough space to hold the results
-    // \note This resize is irrelevant for a radiusSearch ().
-    std::vector<int> nn_indices (k_);
-    std::vector<float> nn_dists (k_);
-
-    if (!isFinite ((*input_)[(*indices_)[idx]]) || lrf_is_nan || this->searchForNeighbors ((*indices_)[idx], search_parameter_, nn_indices,
-                                                                                           nn_dists) == 0)
-    {
-      // Copy into the resultant cloud
-      for (int d = 0; d < shot.size (); ++d)
-        output.points[idx].descriptor[d] = std::numeric_limits<float>::quiet_NaN ();
-      for (int d = 0; d < 9; ++d)
-        output.points[idx].rf[d] = std::numeric_limits<float>::quiet_NaN ();
-
-      output.is_dense = false;
-      continue;
-    }
-
-    // Estimate the SHOT at each patch
-    this->computePointSHOT (idx, nn_indices, nn_dists, shot);
-
-    // Copy into the resultant cloud
-    for (int d = 0; d < shot.size (); ++d)
-      output.points[idx].descriptor[d] = shot[d];
-    for (int d = 0; d < 3; ++d)
-    {
-      output.points[idx].rf[d + 0] = frames_->points[idx].x_axis[d];
-      output.points[idx].rf[d + 3] = frames_->points[idx].y_axis[d];
-      output.points[idx].rf[d + 6] = frames_->points[idx].z_axis[d];
-    }
-  }
-}
-
-//////////////////////////////////////////////////////////////////////////////////////////////
-template <typename PointInT, typename PointNT, typename PointOutT, typename PointRFT> void
-pcl::SHOTColorEstimationOMP<PointInT, PointNT, PointOutT, PointRFT>::computeFeature (PointCloudOut &output)
-{
-  descLength_ = (b_describe_shape_) ? nr_grid_sector_ * (nr_shape_bins_ + 1) : 0;
-  descLength_ += (b_describe_color_) ? nr_grid_sector_ * (nr_color_bins_ + 1) : 0;
-
-  assert( (!b_describe_color_ && b_describe_shape_ && descLength_ == 352) ||
-          (b_describe_color_ && !b_describe_shape_ && descLength_ == 992) ||
-          (b_describe_color_ && b_describe_shape_ && descLength_ == 1344)
-        );
-
-  sqradius_ = search_radius_ * search_radius_;
-  radius3_4_ = (search_radius_ * 3) / 4;
-  radius1_4_ = search_radius_ / 4;
-  radius1_2_ = search_radius_ / 2;
-
-  int data_size = static_cast<int> (indices_->size ());
-
-  output.is_dense = true;
-  // Iterating over the entire index vector
-#ifdef _OPENMP
-#pragma omp parallel for num_threads(threads_)
-#endif
-  for (int idx = 0; idx < data_size; ++idx)
-  {
-    Eigen::VectorXf shot;
-    shot.setZero (descLength_);
-
-    // Allocate enough space to hold the results
-    // \note This resize is irrelevant for a radiusSearch ().
-    std::vector<int> nn_indices (k_);
-    std::vector<float> nn_dists (k_);
-
-    bool lrf_is_nan = false;
-    const PointRFT& current_frame = (*frames_)[idx];
-    if (!pcl_isfinite (current_frame.x_axis[0]) ||
-        !pcl_isfinite (current_frame.y_axis[0]) ||
-        !pcl_isfinite (current_frame.z_axis[0]))
-    {
-      PCL_WARN ("[pcl::%s::computeFeature] The local reference frame is not valid! Aborting description of point with index %d\n",
-        getClassName ().c_str (), (*indices_)[idx]);
-      lrf_is_nan = true;
-    }
-
-    if (!isFinite ((*input_)[(*indices_)[idx]]) ||
-        lrf_is_nan ||
-        this->searchForNeighbors ((*indices_)[idx], search_parameter_, nn_indices, nn_dists) == 0)
-    {
-      // Copy into the resultant cloud
-      for (int d = 0; d < shot.size (); ++d)
-        output.points[idx].descriptor[d] = std::numeric_limits<float>::quiet_NaN ();
-      for (int d = 0; d < 9; ++d)
-        output.points[idx].rf[d] = std::numeric_limits<float>::quiet_NaN ();
-
-      output.is_dense = false;
-      continue;
-    }
-
-    // Estimate the SHOT at each patch
-    this->computePointSHOT (idx, nn_indices, nn_dists, shot);
-
-    // Copy into the resultant cloud
-    for (int d = 0; d < shot.size (); ++d)
-      output.points[idx].descriptor[d] = shot[d];
-    for (int d = 0; d < 3; ++d)
-    {
-      output.points[idx].rf[d + 0] = frames_->points[idx].x_axis[d];
-      output.points[idx].rf[d + 3] = frames_->points[idx].y_axis[d];
-      output.points[idx].rf[d + 6] = frames_->points[idx].z_axis[d];
-    }
-  }
-}
-
 #define PCL_INSTANTIATE_SHOTEstimationOMP(T,NT,OutT,RFT) template class PCL_EXPORTS pcl::SHOTEstimationOMP<T,NT,OutT,RFT>;
 #define PCL_INSTANTIATE_SHOTColorEstimationOMP(T,NT,OutT,RFT) template class PCL_EXPORTS pcl::SHOTColorEstimationOMP<T,NT,OutT,RFT>;
 
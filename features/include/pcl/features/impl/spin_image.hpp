@@ -319,23 +319,29 @@ pcl::SpinImageEstimation<PointInT, PointNT, PointOutT>::initCompute ()
 }
 
 
+//////////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointInT, typename PointNT, typename PointOutT> bool
+pcl::SpinImageEstimation<PointInT, PointNT, PointOutT>::computePointFeature (
+    size_t index, std::vector<int> &, std::vector<float> &, PointOutT &output) const
+{
+  Eigen::ArrayXXd res = computeSiForPoint (indices_->at (index));
+
+  // Copy into the resultant cloud
+  for (int iRow = 0; iRow < res.rows () ; iRow++)
+  {
+    for (int iCol = 0; iCol < res.cols () ; iCol++)
+    {
+      output.histogram[ iRow*res.cols () + iCol ] = static_cast<float> (res (iRow, iCol));
+    }
+  }
+  return (true);
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////
 template <typename PointInT, typename PointNT, typename PointOutT> void 
 pcl::SpinImageEstimation<PointInT, PointNT, PointOutT>::computeFeature (PointCloudOut &output)
 { 
-  for (int i_input = 0; i_input < static_cast<int> (indices_->size ()); ++i_input)
-  {
-    Eigen::ArrayXXd res = computeSiForPoint (indices_->at (i_input));
-
-    // Copy into the resultant cloud
-    for (int iRow = 0; iRow < res.rows () ; iRow++)
-    {
-      for (int iCol = 0; iCol < res.cols () ; iCol++)
-      {
-        output.points[i_input].histogram[ iRow*res.cols () + iCol ] = static_cast<float> (res (iRow, iCol));
-      }
-    }   
-  } 
+  this->computeFeatureForAllIndices (output);
 }
 
 #define PCL_INSTANTIATE_SpinImageEstimation(T,NT,OutT) template class PCL_EXPORTS pcl::SpinImageEstimation<T,NT,OutT>;
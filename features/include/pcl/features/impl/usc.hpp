@@ -141,7 +141,7 @@ pcl::UniqueShapeContext<PointInT, PointOutT, PointRFT>::initCompute ()
 
 //////////////////////////////////////////////////////////////////////////////////////////////
 template <typename PointInT, typename PointOutT, typename PointRFT> void
-pcl::UniqueShapeContext<PointInT, PointOutT, PointRFT>::computePointDescriptor (size_t index, /*float rf[9],*/ std::vector<float> &desc)
+pcl::UniqueShapeContext<PointInT, PointOutT, PointRFT>::computePointDescriptor (size_t index, /*float rf[9],*/ std::vector<float> &desc) const
 {
   pcl::Vector3fMapConst origin = input_->points[(*indices_)[index]].getVector3fMap ();
 
@@ -243,44 +243,45 @@ pcl::UniqueShapeContext<PointInT, PointOutT, PointRFT>::computePointDescriptor (
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////
-template <typename PointInT, typename PointOutT, typename PointRFT> void
-pcl::UniqueShapeContext<PointInT, PointOutT, PointRFT>::computeFeature (PointCloudOut &output)
+template <typename PointInT, typename PointOutT, typename PointRFT> bool
+pcl::UniqueShapeContext<PointInT, PointOutT, PointRFT>::computePointFeature (
+    size_t point_index, std::vector<int> &, std::vector<float> &, PointOutT &output) const
 {
-  assert (descriptor_length_ == 1960);
+  // If the point is not finite, set the descriptor to NaN and continue
+  const PointRFT& current_frame = (*frames_)[point_index];
+  if (!isFinite ((*input_)[(*indices_)[point_index]]) ||
+      !pcl_isfinite (current_frame.x_axis[0]) ||
+      !pcl_isfinite (current_frame.y_axis[0]) ||
+      !pcl_isfinite (current_frame.z_axis[0])  )
+  {
+    for (size_t i = 0; i < descriptor_length_; ++i)
+      output.descriptor[i] = std::numeric_limits<float>::quiet_NaN ();
 
-  output.is_dense = true;
+    memset (output.rf, 0, sizeof (output.rf[0]) * 9);
+    return (false);
+  }
 
-  for (size_t point_index = 0; point_index < indices_->size (); ++point_index)
+  for (int d = 0; d < 3; ++d)
   {
-    //output[point_index].descriptor.resize (descriptor_length_);
-
-    // If the point is not finite, set the descriptor to NaN and continue
-    const PointRFT& current_frame = (*frames_)[point_index];
-    if (!isFinite ((*input_)[(*indices_)[point_index]]) ||
-        !pcl_isfinite (current_frame.x_axis[0]) ||
-        !pcl_isfinite (current_frame.y_axis[0]) ||
-        !pcl_isfinite (current_frame.z_axis[0])  )
-    {
-      for (size_t i = 0; i < descriptor_length_; ++i)
-        output[point_index].descriptor[i] = std::numeric_limits<float>::quiet_NaN ();
+    output.rf[0 + d] = current_frame.x_axis[d];
+    output.rf[3 + d] = current_frame.y_axis[d];
+    output.rf[6 + d] = current_frame.z_axis[d];
+  }
 
-      memset (output[point_index].rf, 0, sizeof (output[point_index].rf[0]) * 9);
-      output.is_dense = false;
-      continue;
-    }
+  std::vector<float> descriptor (descriptor_length_);
+  computePointDescriptor (point_index, descriptor);
+  for (size_t j = 0; j < descriptor_length_; ++j)
+    output.descriptor[j] = descriptor[j];
+  return (true);
+}
 
-    for (int d = 0; d < 3; ++d)
-    {
-      output.points[point_index].rf[0 + d] = current_frame.x_axis[d];
-      output.points[point_index].rf[3 + d] = current_frame.y_axis[d];
-      output.points[point_index].rf[6 + d] = current_frame.z_axis[d];
-    }
+//////////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointInT, typename PointOutT, typename PointRFT> void
+pcl::UniqueShapeContext<PointInT, PointOutT, PointRFT>::computeFeature (PointCloudOut &output)
+{
+  assert (descriptor_length_ == 1960);
 
-    std::vector<float> descriptor (descriptor_length_);
-    computePointDescriptor (point_index, descriptor);
-    for (size_t j = 0; j < descriptor_length_; ++j)
-      output [point_index].descriptor[j] = descriptor[j];
-  }
+  output.is_dense = this->computeFeatureForAllIndices (output);
 }
 
 #define PCL_INSTANTIATE_UniqueShapeContext(T,OutT,RFT) template class PCL_EXPORTS pcl::UniqueShapeContext<T,OutT,RFT>;
@@ -41,6 +41,9 @@
 #define PCL_INTEGRAL_IMAGE2D_H_
 
 #include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace pcl
 {
@@ -120,7 +123,8 @@ namespace pcl
         finite_values_integral_image_ (),
         width_ (1), 
         height_ (1), 
-        compute_second_order_integral_images_ (compute_second_order_integral_images)
+        compute_second_order_integral_images_ (compute_second_order_integral_images),
+        threads_ (1)
       {
       }
 
@@ -134,6 +138,25 @@ namespace pcl
       void 
       setSecondOrderComputation (bool compute_second_order_integral_images);
 
+      /** \brief Set the number of threads used to compute the integral images. The rows are summed up in
+        * parallel first, then the threads split the columns to add up the rows.
+        * \param[in] nr_threads the number of hardware threads to use (0 sets the value back to automatic)
+        */
+      inline void
+      setNumberOfThreads (unsigned nr_threads = 0)
+      {
+#ifdef _OPENMP
+        threads_ = nr_threads != 0 ? nr_threads : static_cast<unsigned> (omp_get_num_procs ());
+#else
+        (void) nr_threads;
+        threads_ = 1;
+#endif
+      }
+
+      /** \brief Get the number of threads used to compute the integral images. */
+      inline unsigned
+      getNumberOfThreads () const { return (threads_); }
+
       /** \brief Set the input data to compute the integral image for
         * \param[in] data the input data
         * \param[in] width the width of the data
@@ -221,6 +244,9 @@ namespace pcl
 
       /** \brief Indicates whether second order integral images are available **/
       bool compute_second_order_integral_images_;
+
+      /** \brief The number of threads used to compute the integral images. */
+      unsigned threads_;
    };
 
    /**
@@ -242,7 +268,8 @@ namespace pcl
         second_order_integral_image_ (),
         finite_values_integral_image_ (),
         width_ (1), height_ (1), 
-        compute_second_order_integral_images_ (compute_second_order_integral_images)
+        compute_second_order_integral_images_ (compute_second_order_integral_images),
+        threads_ (1)
       {
       }
 
@@ -250,6 +277,25 @@ namespace pcl
       virtual
       ~IntegralImage2D () { }
 
+      /** \brief Set the number of threads used to compute the integral images. The rows are summed up in
+        * parallel first, then the threads split the columns to add up the rows.
+        * \param[in] nr_threads the number of hardware threads to use (0 sets the value back to automatic)
+        */
+      inline void
+      setNumberOfThreads (unsigned nr_threads = 0)
+      {
+#ifdef _OPENMP
+        threads_ = nr_threads != 0 ? nr_threads : static_cast<unsigned> (omp_get_num_procs ());
+#else
+        (void) nr_threads;
+        threads_ = 1;
+#endif
+      }
+
+      /** \brief Get the number of threads used to compute the integral images. */
+      inline unsigned
+      getNumberOfThreads () const { return (threads_); }
+
       /** \brief Set the input data to compute the integral image for
         * \param[in] data the input data
         * \param[in] width the width of the data
@@ -337,6 +383,9 @@ namespace pcl
 
       /** \brief Indicates whether second order integral images are available **/
       bool compute_second_order_integral_images_;
+
+      /** \brief The number of threads used to compute the integral images. */
+      unsigned threads_;
    };
  }
 
@@ -62,6 +62,9 @@ namespace pcl
     *        the 15th RoboCup International Symposium, Istanbul, Turkey.
     *        http://www.ais.uni-bonn.de/~holz/papers/holz_2011_robocup.pdf 
     *
+    * \note With setNumberOfThreads (), both the integral images and the normals are computed in parallel.
+    * The integral images are built when the input cloud is set, so set the number of threads first.
+    *
     * \author Stefan Holzer
     */
   template <typename PointInT, typename PointOutT>
@@ -72,6 +75,7 @@ namespace pcl
     using Feature<PointInT, PointOutT>::tree_;
     using Feature<PointInT, PointOutT>::k_;
     using Feature<PointInT, PointOutT>::indices_;
+    using Feature<PointInT, PointOutT>::threads_;
 
     public:
       typedef boost::shared_ptr<IntegralImageNormalEstimation<PointInT, PointOutT> > Ptr;
@@ -342,6 +346,39 @@ namespace pcl
       void
       initData ();
 
+      /** \brief Initialize the data structures of the normal estimation method chosen, unless they are up to
+        * date already. Called before the points are split among the threads.
+        */
+      void
+      lazyInitData ();
+
+      /** \brief Computes the normal at the specified position, using the given region size. Unlike the
+        * public computePointNormal (), this neither changes the region size nor initializes any data and can
+        * thus be called from several threads at once.
+        * \param[in] pos_x x position (pixel)
+        * \param[in] pos_y y position (pixel)
+        * \param[in] point_index the position index of the point
+        * \param[in] rect_width the width of the search rectangle
+        * \param[in] rect_height the height of the search rectangle
+        * \param[out] normal the output estimated normal
+        */
+      void
+      computePointNormal (const int pos_x, const int pos_y, const unsigned point_index,
+                          const int rect_width, const int rect_height, PointOutT &normal) const;
+
+      /** \brief Computes the normal at the specified position with mirroring for border handling, using the
+        * given region size. Can be called from several threads at once.
+        * \param[in] pos_x x position (pixel)
+        * \param[in] pos_y y position (pixel)
+        * \param[in] point_index the position index of the point
+        * \param[in] rect_width the width of the search rectangle
+        * \param[in] rect_height the height of the search rectangle
+        * \param[out] normal the output estimated normal
+        */
+      void
+      computePointNormalMirror (const int pos_x, const int pos_y, const unsigned point_index,
+                                const int rect_width, const int rect_height, PointOutT &normal) const;
+
     private:
 
       /** \brief Flip (in place) the estimated normal of a point towards a given viewpoint
@@ -357,7 +394,7 @@ namespace pcl
       inline void
       flipNormalTowardsViewpoint (const PointInT &point, 
                                   float vp_x, float vp_y, float vp_z,
-                                  float &nx, float &ny, float &nz)
+                                  float &nx, float &ny, float &nz) const
       {
         // See if we need to flip any plane normals
         vp_x -= point.x;
@@ -46,6 +46,30 @@
 
 namespace pcl
 {
+  namespace detail
+  {
+    /** \brief The number of neighborhoods NormalEstimation hands to computePlaneFits () at once. */
+    const int PLANE_FIT_BATCH_SIZE = 32;
+
+    /** \brief Compute the Least-Squares plane fits of several neighborhoods of the same cloud at once, with the
+      * same results as computePointNormal () for each neighborhood.
+      *
+      * The covariance matrices and eigenvalue problems of 8 (AVX), 4 (SSE2) or 1 neighborhood are solved side by
+      * side, depending on the instruction set libpcl_features was built with, not on the one of the caller.
+      * \param[in] cloud the x, y, z of the first point of the cloud the neighborhood indices refer to
+      * \param[in] point_step the size of a point of the cloud in bytes
+      * \param[in] is_dense true if all the points of the cloud are finite
+      * \param[in] neighborhoods pointers to the indices of each neighborhood
+      * \param[in] nr_neighborhoods the number of neighborhoods
+      * \param[out] planes the plane parameters a, b, c, d of each neighborhood, 4 floats per neighborhood
+      * \param[out] curvatures the surface curvature of each neighborhood
+      */
+    PCL_EXPORTS void
+    computePlaneFits (const float *cloud, size_t point_step, bool is_dense,
+                      const std::vector<int> *const *neighborhoods, int nr_neighborhoods,
+                      float *planes, float *curvatures);
+  }
+
   /** \brief Compute the Least-Squares plane fit for a given set of points, and return the estimated plane
     * parameters together with the surface curvature.
     * \param cloud the input point cloud
@@ -107,6 +131,35 @@ namespace pcl
     solvePlaneParameters (covariance_matrix, xyz_centroid, plane_parameters, curvature);
   }
 
+  /** \brief Compute the Least-Squares plane fits for several neighborhoods of the same cloud at once,
+    * and return the estimated plane parameters together with the surface curvatures.
+    *
+    * The covariance matrices and eigenvalue problems of several neighborhoods are solved side by side, see
+    * detail::computePlaneFits (). The results are those of calling computePointNormal () for each neighborhood,
+    * only faster.
+    * \param cloud the input point cloud
+    * \param neighborhoods the point cloud indices of each neighborhood
+    * \param plane_parameters the plane parameters of each neighborhood as: a, b, c, d (ax + by + cz + d = 0)
+    * \param curvatures the estimated surface curvature of each neighborhood
+    * \ingroup features
+    */
+  template <typename PointT> inline void
+  computePointNormal (const pcl::PointCloud<PointT> &cloud, const std::vector<std::vector<int> > &neighborhoods,
+                      std::vector<Eigen::Vector4f, Eigen::aligned_allocator<Eigen::Vector4f> > &plane_parameters,
+                      std::vector<float> &curvatures)
+  {
+    plane_parameters.resize (neighborhoods.size ());
+    curvatures.resize (neighborhoods.size ());
+    if (neighborhoods.empty ())
+      return;
+
+    std::vector<const std::vector<int>*> batch (neighborhoods.size ());
+    for (size_t i = 0; i < neighborhoods.size (); ++i)
+      batch[i] = &neighborhoods[i];
+    detail::computePlaneFits (cloud.empty () ? NULL : &cloud.points[0].x, sizeof (PointT), cloud.is_dense,
+                              &batch[0], static_cast<int> (batch.size ()), plane_parameters[0].data (), &curvatures[0]);
+  }
+
   /** \brief Flip (in place) the estimated normal of a point towards a given viewpoint
     * \param point a given point
     * \param vp_x the X coordinate of the viewpoint
@@ -188,8 +241,9 @@ namespace pcl
     * 3D point. If PointOutT is specified as pcl::Normal, the normal is stored in the first 3 components (0-2),
     * and the curvature is stored in component 3.
     *
-    * \note The code is stateful as we do not expect this class to be multicore parallelized. Please look at
-    * \ref NormalEstimationOMP for a parallel implementation.
+    * \note The normals are estimated detail::PLANE_FIT_BATCH_SIZE at a time, with the covariance matrices and
+    * eigenvalue problems of a batch solved side by side by detail::computePlaneFits (). The batches are split
+    * among the threads given to setNumberOfThreads (), see also \ref NormalEstimationOMP.
     * \author Radu B. Rusu
     * \ingroup features
     */
@@ -355,6 +409,16 @@ namespace pcl
       void
       computeFeature (PointCloudOut &output);
 
+      /** \brief Estimate the normals of the points at positions [\a begin, \a end) in \a indices_. The
+        * neighborhoods are searched one by one, and the plane fits are computed a batch at a time.
+        * \param[in] begin the position of the first point in \a indices_
+        * \param[in] end the position after the last point in \a indices_
+        * \param[out] output the resultant point cloud, already resized to the number of indices
+        * \return false if a point had no finite coordinates or no neighbors, true otherwise
+        */
+      bool
+      computeFeatureBlock (int begin, int end, PointCloudOut &output) const;
+
       /** \brief Values describing the viewpoint ("pinhole" camera model assumed). For per point viewpoints, inherit
         * from NormalEstimation and provide your own computeFeature (). By default, the viewpoint is set to 0,0,0. */
       float vpx_, vpy_, vpz_;
@@ -46,7 +46,8 @@
 namespace pcl
 {
   /** \brief NormalEstimationOMP estimates local surface properties at each 3D point, such as surface normals and
-    * curvatures, in parallel, using the OpenMP standard.
+    * curvatures, in parallel, using the OpenMP standard. It is a NormalEstimation that uses all the available
+    * threads by default, see Feature::setNumberOfThreads ().
     * \author Radu Bogdan Rusu
     * \ingroup features
     */
@@ -67,6 +68,7 @@ namespace pcl
       using NormalEstimation<PointInT, PointOutT>::search_parameter_;
       using NormalEstimation<PointInT, PointOutT>::surface_;
       using NormalEstimation<PointInT, PointOutT>::getViewPoint;
+      using NormalEstimation<PointInT, PointOutT>::threads_;
 
       typedef typename NormalEstimation<PointInT, PointOutT>::PointCloudOut PointCloudOut;
 
@@ -74,28 +76,11 @@ namespace pcl
       /** \brief Initialize the scheduler and set the number of threads to use.
         * \param nr_threads the number of hardware threads to use (0 sets the value back to automatic)
         */
-      NormalEstimationOMP (unsigned int nr_threads = 0) : threads_ (nr_threads)
+      NormalEstimationOMP (unsigned int nr_threads = 0)
       {
         feature_name_ = "NormalEstimationOMP";
+        this->setNumberOfThreads (nr_threads);
       }
-
-      /** \brief Initialize the scheduler and set the number of threads to use.
-        * \param nr_threads the number of hardware threads to use (0 sets the value back to automatic)
-        */
-      inline void 
-      setNumberOfThreads (unsigned int nr_threads = 0) { threads_ = nr_threads; }
-
-    protected:
-      /** \brief The number of threads the scheduler should use. */
-      unsigned int threads_;
-
-    private:
-      /** \brief Estimate normals for all points given in <setInputCloud (), setIndices ()> using the surface in
-        * setSearchSurface () and the spatial locator in setSearchMethod ()
-        * \param output the resultant point cloud model dataset that contains surface normals and curvatures
-        */
-      void 
-      computeFeature (PointCloudOut &output);
   };
 }
 
@@ -0,0 +1,277 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2012-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PCL_FEATURES_PAIR_FEATURE_CACHE_H_
+#define PCL_FEATURES_PAIR_FEATURE_CACHE_H_
+
+#include <pcl/pcl_macros.h>
+#include <Eigen/StdVector>
+#include <boost/shared_ptr.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/thread/mutex.hpp>
+#include <algorithm>
+#include <deque>
+#include <utility>
+#include <vector>
+
+namespace pcl
+{
+  /** \brief PairFeatureCache memoizes the features computed for ordered pairs of point indices, such as the
+    * PFH 4-tuples, so that pairs shared by overlapping neighborhoods are only estimated once.
+    *
+    * The cache is split into a fixed number of stripes, each guarded by its own mutex, so that it can be
+    * read and filled from several threads at once. There are never more stripes than cached pairs allowed,
+    * and every stripe holds at most its share of the maximum size and evicts its oldest entries first. The number of hits and misses is counted to help decide
+    * whether caching pays off for a given dataset.
+    *
+    * \ingroup features
+    */
+  template <typename FeatureT>
+  class PairFeatureCache
+  {
+    public:
+      typedef std::pair<int, int> Key;
+
+      /** \brief Constructor.
+        * \param[in] max_size the maximum number of cached pairs
+        * \param[in] nr_stripes the number of independently locked parts of the cache, at most \a max_size
+        */
+      PairFeatureCache (size_t max_size = 1000000, unsigned int nr_stripes = 64)
+        : stripes_ (), max_size_ (max_size), nr_stripes_ (nr_stripes)
+      {
+        createStripes ();
+      }
+
+      /** \brief Copy constructor. The copy has the same size limits but starts out empty. */
+      PairFeatureCache (const PairFeatureCache &src)
+        : stripes_ (), max_size_ (src.max_size_), nr_stripes_ (src.nr_stripes_)
+      {
+        createStripes ();
+      }
+
+      /** \brief Copy operator. The cached pairs are not copied, only the size limits. */
+      PairFeatureCache&
+      operator = (const PairFeatureCache &src)
+      {
+        if (this != &src)
+        {
+          max_size_ = src.max_size_;
+          nr_stripes_ = src.nr_stripes_;
+          createStripes ();
+        }
+        return (*this);
+      }
+
+      /** \brief Set the maximum number of cached pairs.
+        * \note The new limit is enforced as new pairs are inserted. If it changes the number of stripes, the
+        * cached pairs are dropped. Not thread-safe.
+        */
+      inline void
+      setMaximumSize (size_t max_size)
+      {
+        const size_t nr_stripes = getNumberOfStripes ();
+        max_size_ = max_size;
+        if (getNumberOfStripes () != nr_stripes)
+          createStripes ();
+      }
+
+      /** \brief Get the maximum number of cached pairs. */
+      inline size_t
+      getMaximumSize () const { return (max_size_); }
+
+      /** \brief Look up the feature of a pair, counting the query as a hit or a miss.
+        * \param[in] key the (source, target) point indices
+        * \param[out] feature the cached feature, untouched on a miss
+        * \return true if the pair was found
+        */
+      bool
+      find (const Key &key, FeatureT &feature) const
+      {
+        Stripe &stripe = getStripe (key);
+        boost::mutex::scoped_lock lock (stripe.mutex);
+        typename Map::const_iterator it = stripe.map.find (key);
+        if (it == stripe.map.end ())
+        {
+          ++stripe.misses;
+          return (false);
+        }
+        ++stripe.hits;
+        feature = it->second;
+        return (true);
+      }
+
+      /** \brief Store the feature of a pair, evicting the oldest pairs of its stripe if it is full.
+        * \param[in] key the (source, target) point indices
+        * \param[in] feature the feature to store
+        */
+      void
+      insert (const Key &key, const FeatureT &feature)
+      {
+        if (max_size_ == 0)
+          return;
+        // At least one pair per stripe, as there are at most max_size_ stripes
+        const size_t stripe_size = max_size_ / stripes_.size ();
+
+        Stripe &stripe = getStripe (key);
+        boost::mutex::scoped_lock lock (stripe.mutex);
+        // Another thread may have estimated the same pair in the meantime
+        if (!stripe.map.insert (std::make_pair (key, feature)).second)
+          return;
+        stripe.fifo.push_back (key);
+        while (stripe.fifo.size () > stripe_size)
+        {
+          stripe.map.erase (stripe.fifo.front ());
+          stripe.fifo.pop_front ();
+        }
+      }
+
+      /** \brief Remove all cached pairs and reset the statistics. */
+      void
+      clear ()
+      {
+        for (size_t i = 0; i < stripes_.size (); ++i)
+        {
+          boost::mutex::scoped_lock lock (stripes_[i]->mutex);
+          stripes_[i]->map.clear ();
+          stripes_[i]->fifo.clear ();
+          stripes_[i]->hits = stripes_[i]->misses = 0;
+        }
+      }
+
+      /** \brief Get the number of cached pairs. */
+      size_t
+      size () const
+      {
+        size_t total = 0;
+        for (size_t i = 0; i < stripes_.size (); ++i)
+        {
+          boost::mutex::scoped_lock lock (stripes_[i]->mutex);
+          total += stripes_[i]->map.size ();
+        }
+        return (total);
+      }
+
+      /** \brief Get the number of lookups that found their pair since the last clear (). */
+      uint64_t
+      getHits () const
+      {
+        uint64_t hits = 0;
+        for (size_t i = 0; i < stripes_.size (); ++i)
+        {
+          boost::mutex::scoped_lock lock (stripes_[i]->mutex);
+          hits += stripes_[i]->hits;
+        }
+        return (hits);
+      }
+
+      /** \brief Get the number of lookups that did not find their pair since the last clear (). */
+      uint64_t
+      getMisses () const
+      {
+        uint64_t misses = 0;
+        for (size_t i = 0; i < stripes_.size (); ++i)
+        {
+          boost::mutex::scoped_lock lock (stripes_[i]->mutex);
+          misses += stripes_[i]->misses;
+        }
+        return (misses);
+      }
+
+      /** \brief Get the fraction of lookups that found their pair, or 0 if there were none. */
+      double
+      getHitRate () const
+      {
+        const uint64_t hits = getHits (), lookups = hits + getMisses ();
+        return (lookups == 0 ? 0.0 : static_cast<double> (hits) / static_cast<double> (lookups));
+      }
+
+    private:
+      typedef boost::unordered_map<Key, FeatureT, boost::hash<Key>, std::equal_to<Key>,
+                                   Eigen::aligned_allocator<std::pair<const Key, FeatureT> > > Map;
+
+      /** \brief A part of the cache with its own lock, FIFO eviction order and statistics. */
+      struct Stripe
+      {
+        Stripe () : mutex (), map (), fifo (), hits (0), misses (0) {}
+
+        boost::mutex mutex;
+        Map map;
+        std::deque<Key> fifo;
+        uint64_t hits, misses;
+      };
+
+      /** \brief Get the number of stripes for the current limits: \a nr_stripes_, but at least 1 and at
+        * most \a max_size_, so that the stripe sizes never add up to more than \a max_size_.
+        */
+      inline size_t
+      getNumberOfStripes () const
+      {
+        return (std::max<size_t> (1, std::min<size_t> (nr_stripes_, max_size_)));
+      }
+
+      /** \brief Replace the stripes by empty ones. */
+      void
+      createStripes ()
+      {
+        stripes_.clear ();
+        stripes_.resize (getNumberOfStripes ());
+        for (size_t i = 0; i < stripes_.size (); ++i)
+          stripes_[i].reset (new Stripe);
+      }
+
+      /** \brief Get the stripe that holds a pair. */
+      inline Stripe&
+      getStripe (const Key &key) const
+      {
+        // Neighboring indices differ in their low bits, mix them before picking a stripe
+        size_t h = static_cast<size_t> (key.first) * 73856093u ^ static_cast<size_t> (key.second) * 19349663u;
+        return (*stripes_[h % stripes_.size ()]);
+      }
+
+      /** \brief The independently locked parts of the cache. */
+      std::vector<boost::shared_ptr<Stripe> > stripes_;
+
+      /** \brief The maximum number of cached pairs over all stripes. */
+      size_t max_size_;
+
+      /** \brief The requested number of stripes. */
+      unsigned int nr_stripes_;
+  };
+}
+
+#endif  //#ifndef PCL_FEATURES_PAIR_FEATURE_CACHE_H_
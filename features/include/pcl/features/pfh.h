@@ -44,7 +44,7 @@
 #include <pcl/point_types.h>
 #include <pcl/features/feature.h>
 #include <pcl/features/pfh_tools.h>
-#include <map>
+#include <pcl/features/pair_feature_cache.h>
 
 namespace pcl
 {
@@ -72,8 +72,8 @@ namespace pcl
     *     doesn't have finite 3D coordinates. Therefore, any point that contains
     *     NaN data on x, y, or z, will have its PFH feature property set to NaN.
     *
-    * \note The code is stateful as we do not expect this class to be multicore parallelized. Please look at
-    * \ref FPFHEstimationOMP for examples on parallel implementations of the FPFH (Fast Point Feature Histogram).
+    * \note The signatures of different points are estimated independently, use setNumberOfThreads () to run the
+    * estimation on several threads. The internal cache is shared by all the threads.
     *
     * \author Radu B. Rusu
     * \ingroup features
@@ -101,13 +101,9 @@ namespace pcl
         */
       PFHEstimation () : 
         nr_subdiv_ (5), 
-        pfh_histogram_ (),
-        pfh_tuple_ (),
         d_pi_ (1.0f / (2.0f * static_cast<float> (M_PI))), 
-        feature_map_ (),
-        key_list_ (),
         // Default 1GB memory size. Need to set it to something more conservative.
-        max_cache_size_ ((1ul*1024ul*1024ul*1024ul) / sizeof (std::pair<std::pair<int, int>, Eigen::Vector4f>)),
+        feature_cache_ ((1ul*1024ul*1024ul*1024ul) / sizeof (std::pair<std::pair<int, int>, Eigen::Vector4f>)),
         use_cache_ (false)
       {
         feature_name_ = "PFHEstimation";
@@ -119,14 +115,14 @@ namespace pcl
       inline void
       setMaximumCacheSize (unsigned int cache_size)
       {
-        max_cache_size_ = cache_size;
+        feature_cache_.setMaximumSize (cache_size);
       }
 
       /** \brief Get the maximum internal cache size. */
       inline unsigned int 
       getMaximumCacheSize ()
       {
-        return (max_cache_size_);
+        return (static_cast<unsigned int> (feature_cache_.getMaximumSize ()));
       }
 
       /** \brief Set whether to use an internal cache mechanism for removing redundant calculations or not. 
@@ -153,6 +149,29 @@ namespace pcl
         return (use_cache_);
       }
 
+      /** \brief Get the number of pairs found in the internal cache during the last compute (). */
+      inline uint64_t
+      getCacheHits () const
+      {
+        return (feature_cache_.getHits ());
+      }
+
+      /** \brief Get the number of pairs that had to be estimated during the last compute () while the
+        * internal cache was enabled.
+        */
+      inline uint64_t
+      getCacheMisses () const
+      {
+        return (feature_cache_.getMisses ());
+      }
+
+      /** \brief Get the fraction of the pairs found in the internal cache during the last compute (). */
+      inline double
+      getCacheHitRate () const
+      {
+        return (feature_cache_.getHitRate ());
+      }
+
       /** \brief Compute the 4-tuple representation containing the three angles and one distance between two points
         * represented by Cartesian coordinates and normals.
         * \note For explanations about the features, please see the literature mentioned above (the order of the
@@ -169,7 +188,7 @@ namespace pcl
         */
       bool 
       computePairFeatures (const pcl::PointCloud<PointInT> &cloud, const pcl::PointCloud<PointNT> &normals, 
-                           int p_idx, int q_idx, float &f1, float &f2, float &f3, float &f4);
+                           int p_idx, int q_idx, float &f1, float &f2, float &f3, float &f4) const;
 
       /** \brief Estimate the PFH (Point Feature Histograms) individual signatures of the three angular (f1, f2, f3)
         * features for a given point based on its spatial neighborhood of 3D points with normals
@@ -181,7 +200,7 @@ namespace pcl
         */
       void 
       computePointPFHSignature (const pcl::PointCloud<PointInT> &cloud, const pcl::PointCloud<PointNT> &normals, 
-                                const std::vector<int> &indices, int nr_split, Eigen::VectorXf &pfh_histogram);
+                                const std::vector<int> &indices, int nr_split, Eigen::VectorXf &pfh_histogram) const;
 
     protected:
       /** \brief Estimate the Point Feature Histograms (PFH) descriptors at a set of points given by
@@ -192,29 +211,26 @@ namespace pcl
       void 
       computeFeature (PointCloudOut &output);
 
+      /** \brief Estimate the PFH signature of the point at position \a index in \a indices_.
+        * \param[in] index the position of the query point in \a indices_
+        * \param[in,out] nn_indices a buffer for the neighbor indices
+        * \param[in,out] nn_dists a buffer for the neighbor distances
+        * \param[out] output the resultant PFH signature
+        */
+      bool
+      computePointFeature (size_t index, std::vector<int> &nn_indices, std::vector<float> &nn_dists,
+                           PointOutT &output) const;
+
       /** \brief The number of subdivisions for each angular feature interval. */
       int nr_subdiv_;
 
-      /** \brief Placeholder for a point's PFH signature. */
-      Eigen::VectorXf pfh_histogram_;
-
-      /** \brief Placeholder for a PFH 4-tuple. */
-      Eigen::Vector4f pfh_tuple_;
-
-      /** \brief Placeholder for a histogram index. */
-      int f_index_[3];
-
       /** \brief Float constant = 1.0 / (2.0 * M_PI) */
       float d_pi_; 
 
-      /** \brief Internal hashmap, used to optimize efficiency of redundant computations. */
-      std::map<std::pair<int, int>, Eigen::Vector4f, std::less<std::pair<int, int> >, Eigen::aligned_allocator<Eigen::Vector4f> > feature_map_;
-
-      /** \brief Queue of pairs saved, used to constrain memory usage. */
-      std::queue<std::pair<int, int> > key_list_;
-
-      /** \brief Maximum size of internal cache memory. */
-      unsigned int max_cache_size_;
+      /** \brief Internal pair cache, used to optimize efficiency of redundant computations. It is thread-safe,
+        * which is why it can be filled from the const per point estimation.
+        */
+      mutable PairFeatureCache<Eigen::Vector4f> feature_cache_;
 
       /** \brief Set to true to use the internal cache for removing redundant computations. */
       bool use_cache_;
@@ -61,7 +61,7 @@ namespace pcl
 
 
       PFHRGBEstimation ()
-        : nr_subdiv_ (5), pfhrgb_histogram_ (), pfhrgb_tuple_ (), d_pi_ (1.0f / (2.0f * static_cast<float> (M_PI)))
+        : nr_subdiv_ (5), d_pi_ (1.0f / (2.0f * static_cast<float> (M_PI)))
       {
         feature_name_ = "PFHRGBEstimation";
       }
@@ -69,29 +69,32 @@ namespace pcl
       bool
       computeRGBPairFeatures (const pcl::PointCloud<PointInT> &cloud, const pcl::PointCloud<PointNT> &normals,
                               int p_idx, int q_idx,
-                              float &f1, float &f2, float &f3, float &f4, float &f5, float &f6, float &f7);
+                              float &f1, float &f2, float &f3, float &f4, float &f5, float &f6, float &f7) const;
 
       void
       computePointPFHRGBSignature (const pcl::PointCloud<PointInT> &cloud, const pcl::PointCloud<PointNT> &normals,
-                                   const std::vector<int> &indices, int nr_split, Eigen::VectorXf &pfhrgb_histogram);
+                                   const std::vector<int> &indices, int nr_split, Eigen::VectorXf &pfhrgb_histogram) const;
 
     protected:
       void
       computeFeature (PointCloudOut &output);
 
+      /** \brief Estimate the PFHRGB signature of the point at position \a index in \a indices_.
+        * The signatures of different points are independent, use setNumberOfThreads () to estimate
+        * them on several threads.
+        * \param[in] index the position of the query point in \a indices_
+        * \param[in,out] nn_indices a buffer for the neighbor indices
+        * \param[in,out] nn_dists a buffer for the neighbor distances
+        * \param[out] output the resultant PFHRGB signature
+        */
+      bool
+      computePointFeature (size_t index, std::vector<int> &nn_indices, std::vector<float> &nn_dists,
+                           PointOutT &output) const;
+
     private:
       /** \brief The number of subdivisions for each angular feature interval. */
       int nr_subdiv_;
 
-      /** \brief Placeholder for a point's PFHRGB signature. */
-      Eigen::VectorXf pfhrgb_histogram_;
-
-      /** \brief Placeholder for a PFHRGB 7-tuple. */
-      Eigen::VectorXf pfhrgb_tuple_;
-
-      /** \brief Placeholder for a histogram index. */
-      int f_index_[7];
-
       /** \brief Float constant = 1.0 / (2.0 * M_PI) */
       float d_pi_;
   };
@@ -51,8 +51,7 @@ namespace pcl
     *
     * The recommended PointOutT is pcl::PrincipalCurvatures.
     *
-    * \note The code is stateful as we do not expect this class to be multicore parallelized. Please look at
-    * \ref NormalEstimationOMP for an example on how to extend this to parallel implementations.
+    * \note The per point estimation is stateless, use setNumberOfThreads () to run it on several threads.
     *
     * \author Radu B. Rusu, Jared Glover
     * \ingroup features
@@ -76,13 +75,7 @@ namespace pcl
       typedef pcl::PointCloud<PointInT> PointCloudIn;
 
       /** \brief Empty constructor. */
-      PrincipalCurvaturesEstimation () : 
-        projected_normals_ (), 
-        xyz_centroid_ (Eigen::Vector3f::Zero ()), 
-        demean_ (Eigen::Vector3f::Zero ()),
-        covariance_matrix_ (Eigen::Matrix3f::Zero ()),
-        eigenvector_ (Eigen::Vector3f::Zero ()),
-        eigenvalues_ (Eigen::Vector3f::Zero ())
+      PrincipalCurvaturesEstimation ()
       {
         feature_name_ = "PrincipalCurvaturesEstimation";
       };
@@ -102,7 +95,7 @@ namespace pcl
       void
       computePointPrincipalCurvatures (const pcl::PointCloud<PointNT> &normals,
                                        int p_idx, const std::vector<int> &indices,
-                                       float &pcx, float &pcy, float &pcz, float &pc1, float &pc2);
+                                       float &pcx, float &pcy, float &pcz, float &pc1, float &pc2) const;
 
     protected:
 
@@ -114,23 +107,15 @@ namespace pcl
       void
       computeFeature (PointCloudOut &output);
 
-    private:
-      /** \brief A pointer to the input dataset that contains the point normals of the XYZ dataset. */
-      std::vector<Eigen::Vector3f, Eigen::aligned_allocator<Eigen::Vector3f> > projected_normals_;
-
-      /** \brief SSE aligned placeholder for the XYZ centroid of a surface patch. */
-      Eigen::Vector3f xyz_centroid_;
-
-      /** \brief Temporary point placeholder. */
-      Eigen::Vector3f demean_;
-
-      /** \brief Placeholder for the 3x3 covariance matrix at each surface patch. */
-      EIGEN_ALIGN16 Eigen::Matrix3f covariance_matrix_;
-
-      /** \brief SSE aligned eigenvectors placeholder for a covariance matrix. */
-      Eigen::Vector3f eigenvector_;
-      /** \brief eigenvalues placeholder for a covariance matrix. */
-      Eigen::Vector3f eigenvalues_;
+      /** \brief Estimate the principal curvatures at the point at position \a index in \a indices_.
+        * \param[in] index the position of the query point in \a indices_
+        * \param[in,out] nn_indices a buffer for the neighbor indices
+        * \param[in,out] nn_dists a buffer for the neighbor distances
+        * \param[out] output the resultant principal curvature estimate
+        */
+      bool
+      computePointFeature (size_t index, std::vector<int> &nn_indices, std::vector<float> &nn_dists,
+                           PointOutT &output) const;
   };
 }
 
@@ -123,6 +123,14 @@ namespace pcl
       virtual void
       computeFeature (PointCloudOut& output);
 
+      /** \brief Computes the RoPS descriptor of the point at position \a index in \a indices_.
+        * The list of triangles of every point must have been built beforehand.
+        * \param[in] index the position of the query point in \a indices_
+        * \param[out] output the resultant RoPS histogram
+        */
+      bool
+      computePointFeature (size_t index, std::vector<int> &, std::vector<float> &, PointOutT& output) const;
+
       /** \brief This method simply builds the list of triangles for every point.
         * The list of triangles for each point consists of indices of triangles it belongs to.
         * The only purpose of this method is to improve perfomance of the algorithm.
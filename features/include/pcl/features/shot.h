@@ -242,6 +242,7 @@ namespace pcl
       using SHOTEstimationBase<PointInT, PointNT, PointOutT, PointRFT>::interpolateSingleChannel;
       using SHOTEstimationBase<PointInT, PointNT, PointOutT, PointRFT>::shot_;
       using FeatureWithLocalReferenceFrames<PointInT, PointRFT>::frames_;
+      using Feature<PointInT, PointOutT>::threads_;
 
       typedef typename Feature<PointInT, PointOutT>::PointCloudIn PointCloudIn;
 
@@ -320,6 +321,7 @@ namespace pcl
       using SHOTEstimationBase<PointInT, PointNT, PointOutT, PointRFT>::interpolateSingleChannel;
       using SHOTEstimationBase<PointInT, PointNT, PointOutT, PointRFT>::shot_;
       using FeatureWithLocalReferenceFrames<PointInT, PointRFT>::frames_;
+      using Feature<PointInT, PointOutT>::threads_;
 
       typedef typename Feature<PointInT, PointOutT>::PointCloudIn PointCloudIn;
 
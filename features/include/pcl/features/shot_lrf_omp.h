@@ -70,20 +70,15 @@ namespace pcl
       typedef boost::shared_ptr<SHOTLocalReferenceFrameEstimationOMP<PointInT, PointOutT> > Ptr;
       typedef boost::shared_ptr<const SHOTLocalReferenceFrameEstimationOMP<PointInT, PointOutT> > ConstPtr;
       /** \brief Constructor */
-    SHOTLocalReferenceFrameEstimationOMP () : threads_ (0)
+    SHOTLocalReferenceFrameEstimationOMP ()
       {
         feature_name_ = "SHOTLocalReferenceFrameEstimationOMP";
+        this->setNumberOfThreads (0);
       }
       
     /** \brief Empty destructor */
     virtual ~SHOTLocalReferenceFrameEstimationOMP () {}
 
-    /** \brief Initialize the scheduler and set the number of threads to use.
-     * \param nr_threads the number of hardware threads to use (0 sets the value back to automatic)
-     */
-     inline void
-     setNumberOfThreads (unsigned int nr_threads = 0) { threads_ = nr_threads; }
-
     protected:
       using Feature<PointInT, PointOutT>::feature_name_;
       using Feature<PointInT, PointOutT>::getClassName;
@@ -93,6 +88,7 @@ namespace pcl
       using Feature<PointInT, PointOutT>::surface_;
       using Feature<PointInT, PointOutT>::tree_;
       using Feature<PointInT, PointOutT>::search_parameter_;
+      using Feature<PointInT, PointOutT>::threads_;
       using SHOTLocalReferenceFrameEstimation<PointInT, PointOutT>::getLocalRF;
       typedef typename Feature<PointInT, PointOutT>::PointCloudIn PointCloudIn;
       typedef typename Feature<PointInT, PointOutT>::PointCloudOut PointCloudOut;
@@ -102,10 +98,6 @@ namespace pcl
         */
       virtual void
       computeFeature (PointCloudOut &output);
-
-      /** \brief The number of threads the scheduler should use. */
-      unsigned int threads_;
-
   };
 }
 
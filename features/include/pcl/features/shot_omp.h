@@ -51,6 +51,9 @@ namespace pcl
     *
     * The suggested PointOutT is pcl::SHOT352.
     *
+    * \note This is a SHOTEstimation that uses all available threads by default, and estimates the local
+    * reference frames with SHOTLocalReferenceFrameEstimationOMP.
+    *
     * \note If you use this code in any academic work, please cite:
     *
     *   - F. Tombari, S. Salti, L. Di Stefano
@@ -91,35 +94,22 @@ namespace pcl
       using SHOTEstimation<PointInT, PointNT, PointOutT, PointRFT>::radius3_4_;
       using SHOTEstimation<PointInT, PointNT, PointOutT, PointRFT>::radius1_4_;
       using SHOTEstimation<PointInT, PointNT, PointOutT, PointRFT>::radius1_2_;
+      using Feature<PointInT, PointOutT>::threads_;
 
       typedef typename Feature<PointInT, PointOutT>::PointCloudOut PointCloudOut;
       typedef typename Feature<PointInT, PointOutT>::PointCloudIn PointCloudIn;
 
       /** \brief Empty constructor. */
-      SHOTEstimationOMP (unsigned int nr_threads = 0) : SHOTEstimation<PointInT, PointNT, PointOutT, PointRFT> (), threads_ (nr_threads)
-      { };
-      /** \brief Initialize the scheduler and set the number of threads to use.
-        * \param nr_threads the number of hardware threads to use (0 sets the value back to automatic)
-        */
-      inline void
-      setNumberOfThreads (unsigned int nr_threads = 0) { threads_ = nr_threads; }
+      SHOTEstimationOMP (unsigned int nr_threads = 0) : SHOTEstimation<PointInT, PointNT, PointOutT, PointRFT> ()
+      {
+        this->setNumberOfThreads (nr_threads);
+      };
 
     protected:
 
-      /** \brief Estimate the Signatures of Histograms of OrienTations (SHOT) descriptors at a set of points given by
-        * <setInputCloud (), setIndices ()> using the surface in setSearchSurface () and the spatial locator in
-        * setSearchMethod ()
-        * \param output the resultant point cloud model dataset that contains the SHOT feature estimates
-        */
-      void
-      computeFeature (PointCloudOut &output);
-
       /** \brief This method should get called before starting the actual computation. */
       bool
       initCompute ();
-
-      /** \brief The number of threads the scheduler should use. */
-      unsigned int threads_;
   };
 
   /** \brief SHOTColorEstimationOMP estimates the Signature of Histograms of OrienTations (SHOT) descriptor for a given point cloud dataset
@@ -127,6 +117,9 @@ namespace pcl
     *
     * The suggested PointOutT is pcl::SHOT1344.
     *
+    * \note This is a SHOTColorEstimation that uses all available threads by default, and estimates the local
+    * reference frames with SHOTLocalReferenceFrameEstimationOMP.
+    *
     * \note If you use this code in any academic work, please cite:
     *
     *   - F. Tombari, S. Salti, L. Di Stefano
@@ -170,6 +163,7 @@ namespace pcl
       using SHOTColorEstimation<PointInT, PointNT, PointOutT, PointRFT>::b_describe_shape_;
       using SHOTColorEstimation<PointInT, PointNT, PointOutT, PointRFT>::b_describe_color_;
       using SHOTColorEstimation<PointInT, PointNT, PointOutT, PointRFT>::nr_color_bins_;
+      using Feature<PointInT, PointOutT>::threads_;
 
       typedef typename Feature<PointInT, PointOutT>::PointCloudOut PointCloudOut;
       typedef typename Feature<PointInT, PointOutT>::PointCloudIn PointCloudIn;
@@ -178,32 +172,16 @@ namespace pcl
       SHOTColorEstimationOMP (bool describe_shape = true,
                               bool describe_color = true,
                               unsigned int nr_threads = 0)
-        : SHOTColorEstimation<PointInT, PointNT, PointOutT, PointRFT> (describe_shape, describe_color), threads_ (nr_threads)
+        : SHOTColorEstimation<PointInT, PointNT, PointOutT, PointRFT> (describe_shape, describe_color)
       {
+        this->setNumberOfThreads (nr_threads);
       }
 
-      /** \brief Initialize the scheduler and set the number of threads to use.
-        * \param nr_threads the number of hardware threads to use (0 sets the value back to automatic)
-        */
-      inline void
-      setNumberOfThreads (unsigned int nr_threads = 0) { threads_ = nr_threads; }
-
     protected:
 
-      /** \brief Estimate the Signatures of Histograms of OrienTations (SHOT) descriptors at a set of points given by
-        * <setInputCloud (), setIndices ()> using the surface in setSearchSurface () and the spatial locator in
-        * setSearchMethod ()
-        * \param output the resultant point cloud model dataset that contains the SHOT feature estimates
-        */
-      void
-      computeFeature (PointCloudOut &output);
-
       /** \brief This method should get called before starting the actual computation. */
       bool
       initCompute ();
-
-      /** \brief The number of threads the scheduler should use. */
-      unsigned int threads_;
   };
 
 }
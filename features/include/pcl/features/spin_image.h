@@ -262,6 +262,14 @@ namespace pcl
       Eigen::ArrayXXd 
       computeSiForPoint (int index) const;
 
+      /** \brief Computes the spin-image of the point at position \a index in \a indices_ and stores it
+        * in \a output. The neighbor buffers are not used, computeSiForPoint () runs its own search.
+        * \param[in] index the position of the reference point in \a indices_
+        * \param[out] output the resultant spin-image histogram
+        */
+      bool
+      computePointFeature (size_t index, std::vector<int> &, std::vector<float> &, PointOutT &output) const;
+
     private:
       PointCloudNConstPtr input_normals_;
       PointCloudNConstPtr rotation_axes_cloud_;
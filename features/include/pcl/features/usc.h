@@ -143,7 +143,15 @@ namespace pcl
         * \param[out] desc descriptor to compute
         */
       void
-      computePointDescriptor (size_t index, std::vector<float> &desc);
+      computePointDescriptor (size_t index, std::vector<float> &desc) const;
+
+      /** \brief Compute the descriptor and copy the reference frame of the point at position \a index
+        * in \a indices_. The neighbor buffers are not used, computePointDescriptor () runs its own search.
+        * \param[in] index the position of the query point in \a indices_
+        * \param[out] output the resultant descriptor
+        */
+      bool
+      computePointFeature (size_t index, std::vector<int> &, std::vector<float> &, PointOutT &output) const;
 
       /** \brief Initialize computation by allocating all the intervals and the volume lookup table. */
       virtual bool
@@ -0,0 +1,348 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2012-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <pcl/features/normal_3d.h>
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+  /** \brief One float per neighborhood of a plane fit batch. Only the operations computePlaneFitBatch ()
+    * needs are provided, by FloatLanesAVX (8 lanes), FloatLanesSSE2 (4 lanes) and FloatLanesScalar (1 lane).
+    * They only exist in this file, the instruction set is the one libpcl_features is built with.
+    */
+  struct FloatLanesScalar
+  {
+    static const int SIZE = 1;
+    FloatLanesScalar () {}
+    explicit FloatLanesScalar (float value) : v (value) {}
+    static inline FloatLanesScalar load (const float *src) { return (FloatLanesScalar (src[0])); }
+    /** \brief Gather src[l][offset] into lane l. */
+    static inline FloatLanesScalar gather (const float *const *src, int offset) { return (FloatLanesScalar (src[0][offset])); }
+    inline void store (float *tgt) const { tgt[0] = v; }
+    float v;
+  };
+  // Without SIMD, the mask lanes produced by the comparisons are 1 where they hold and 0 elsewhere
+#define PCL_FLOAT_LANES_OP(op, expr) \
+  inline FloatLanesScalar op (const FloatLanesScalar &a, const FloatLanesScalar &b) \
+  { return (FloatLanesScalar (expr)); }
+  PCL_FLOAT_LANES_OP (operator +, a.v + b.v)
+  PCL_FLOAT_LANES_OP (operator -, a.v - b.v)
+  PCL_FLOAT_LANES_OP (operator *, a.v * b.v)
+  PCL_FLOAT_LANES_OP (operator /, a.v / b.v)
+  PCL_FLOAT_LANES_OP (min, std::min (a.v, b.v))
+  PCL_FLOAT_LANES_OP (max, std::max (a.v, b.v))
+  PCL_FLOAT_LANES_OP (greaterEqual, a.v >= b.v ? 1.0f : 0.0f)
+  PCL_FLOAT_LANES_OP (greater, a.v > b.v ? 1.0f : 0.0f)
+  PCL_FLOAT_LANES_OP (lessEqual, a.v <= b.v ? 1.0f : 0.0f)
+  PCL_FLOAT_LANES_OP (operator &, a.v * b.v)
+#undef PCL_FLOAT_LANES_OP
+  inline FloatLanesScalar sqrt (const FloatLanesScalar &a) { return (FloatLanesScalar (std::sqrt (a.v))); }
+  inline FloatLanesScalar abs (const FloatLanesScalar &a) { return (FloatLanesScalar (std::abs (a.v))); }
+  inline FloatLanesScalar select (const FloatLanesScalar &mask, const FloatLanesScalar &a, const FloatLanesScalar &b)
+  { return (mask.v != 0.0f ? a : b); }
+
+#if defined(__SSE2__)
+  struct FloatLanesSSE2
+  {
+    static const int SIZE = 4;
+    FloatLanesSSE2 () {}
+    FloatLanesSSE2 (__m128 value) : v (value) {}
+    explicit FloatLanesSSE2 (float value) : v (_mm_set1_ps (value)) {}
+    static inline FloatLanesSSE2 load (const float *src) { return (FloatLanesSSE2 (_mm_loadu_ps (src))); }
+    static inline FloatLanesSSE2 gather (const float *const *src, int offset)
+    {
+      return (FloatLanesSSE2 (_mm_setr_ps (src[0][offset], src[1][offset], src[2][offset], src[3][offset])));
+    }
+    inline void store (float *tgt) const { _mm_storeu_ps (tgt, v); }
+    __m128 v;
+  };
+  inline FloatLanesSSE2 operator + (const FloatLanesSSE2 &a, const FloatLanesSSE2 &b) { return (_mm_add_ps (a.v, b.v)); }
+  inline FloatLanesSSE2 operator - (const FloatLanesSSE2 &a, const FloatLanesSSE2 &b) { return (_mm_sub_ps (a.v, b.v)); }
+  inline FloatLanesSSE2 operator * (const FloatLanesSSE2 &a, const FloatLanesSSE2 &b) { return (_mm_mul_ps (a.v, b.v)); }
+  inline FloatLanesSSE2 operator / (const FloatLanesSSE2 &a, const FloatLanesSSE2 &b) { return (_mm_div_ps (a.v, b.v)); }
+  inline FloatLanesSSE2 min (const FloatLanesSSE2 &a, const FloatLanesSSE2 &b) { return (_mm_min_ps (a.v, b.v)); }
+  inline FloatLanesSSE2 max (const FloatLanesSSE2 &a, const FloatLanesSSE2 &b) { return (_mm_max_ps (a.v, b.v)); }
+  inline FloatLanesSSE2 sqrt (const FloatLanesSSE2 &a) { return (_mm_sqrt_ps (a.v)); }
+  inline FloatLanesSSE2 abs (const FloatLanesSSE2 &a) { return (_mm_andnot_ps (_mm_set1_ps (-0.0f), a.v)); }
+  /** \brief All bits set in the lanes where a >= b (a > b, a <= b), cleared elsewhere. */
+  inline FloatLanesSSE2 greaterEqual (const FloatLanesSSE2 &a, const FloatLanesSSE2 &b) { return (_mm_cmpge_ps (a.v, b.v)); }
+  inline FloatLanesSSE2 greater (const FloatLanesSSE2 &a, const FloatLanesSSE2 &b) { return (_mm_cmpgt_ps (a.v, b.v)); }
+  inline FloatLanesSSE2 lessEqual (const FloatLanesSSE2 &a, const FloatLanesSSE2 &b) { return (_mm_cmple_ps (a.v, b.v)); }
+  inline FloatLanesSSE2 operator & (const FloatLanesSSE2 &a, const FloatLanesSSE2 &b) { return (_mm_and_ps (a.v, b.v)); }
+  /** \brief Pick \a a in the lanes where \a mask is set and \a b elsewhere. */
+  inline FloatLanesSSE2 select (const FloatLanesSSE2 &mask, const FloatLanesSSE2 &a, const FloatLanesSSE2 &b) { return (_mm_or_ps (_mm_and_ps (mask.v, a.v), _mm_andnot_ps (mask.v, b.v))); }
+#endif
+
+#if defined(__AVX__)
+  struct FloatLanesAVX
+  {
+    static const int SIZE = 8;
+    FloatLanesAVX () {}
+    FloatLanesAVX (__m256 value) : v (value) {}
+    explicit FloatLanesAVX (float value) : v (_mm256_set1_ps (value)) {}
+    static inline FloatLanesAVX load (const float *src) { return (FloatLanesAVX (_mm256_loadu_ps (src))); }
+    static inline FloatLanesAVX gather (const float *const *src, int offset)
+    {
+      return (FloatLanesAVX (_mm256_setr_ps (src[0][offset], src[1][offset], src[2][offset], src[3][offset],
+                                             src[4][offset], src[5][offset], src[6][offset], src[7][offset])));
+    }
+    inline void store (float *tgt) const { _mm256_storeu_ps (tgt, v); }
+    __m256 v;
+  };
+  inline FloatLanesAVX operator + (const FloatLanesAVX &a, const FloatLanesAVX &b) { return (_mm256_add_ps (a.v, b.v)); }
+  inline FloatLanesAVX operator - (const FloatLanesAVX &a, const FloatLanesAVX &b) { return (_mm256_sub_ps (a.v, b.v)); }
+  inline FloatLanesAVX operator * (const FloatLanesAVX &a, const FloatLanesAVX &b) { return (_mm256_mul_ps (a.v, b.v)); }
+  inline FloatLanesAVX operator / (const FloatLanesAVX &a, const FloatLanesAVX &b) { return (_mm256_div_ps (a.v, b.v)); }
+  inline FloatLanesAVX min (const FloatLanesAVX &a, const FloatLanesAVX &b) { return (_mm256_min_ps (a.v, b.v)); }
+  inline FloatLanesAVX max (const FloatLanesAVX &a, const FloatLanesAVX &b) { return (_mm256_max_ps (a.v, b.v)); }
+  inline FloatLanesAVX sqrt (const FloatLanesAVX &a) { return (_mm256_sqrt_ps (a.v)); }
+  inline FloatLanesAVX abs (const FloatLanesAVX &a) { return (_mm256_andnot_ps (_mm256_set1_ps (-0.0f), a.v)); }
+  inline FloatLanesAVX greaterEqual (const FloatLanesAVX &a, const FloatLanesAVX &b) { return (_mm256_cmp_ps (a.v, b.v, _CMP_GE_OQ)); }
+  inline FloatLanesAVX greater (const FloatLanesAVX &a, const FloatLanesAVX &b) { return (_mm256_cmp_ps (a.v, b.v, _CMP_GT_OQ)); }
+  inline FloatLanesAVX lessEqual (const FloatLanesAVX &a, const FloatLanesAVX &b) { return (_mm256_cmp_ps (a.v, b.v, _CMP_LE_OQ)); }
+  inline FloatLanesAVX operator & (const FloatLanesAVX &a, const FloatLanesAVX &b) { return (_mm256_and_ps (a.v, b.v)); }
+  inline FloatLanesAVX select (const FloatLanesAVX &mask, const FloatLanesAVX &a, const FloatLanesAVX &b) { return (_mm256_blendv_ps (b.v, a.v, mask.v)); }
+#endif
+
+  /** \brief The widest lane type available to the library. */
+#if defined(__AVX__)
+  typedef FloatLanesAVX PlaneFitLanes;
+#elif defined(__SSE2__)
+  typedef FloatLanesSSE2 PlaneFitLanes;
+#else
+  typedef FloatLanesScalar PlaneFitLanes;
+#endif
+
+  /** \brief Fit least-squares planes to up to V::SIZE neighborhoods at once.
+    *
+    * The i-th neighbor of every neighborhood is gathered into one V, so that the covariance
+    * accumulation, the characteristic polynomial, the eigenvector extraction and the curvature run on all
+    * the neighborhoods with the same instructions. Only the trigonometric part of the closed-form cubic
+    * solve is done lane by lane. Each lane follows the steps of computeMeanAndCovarianceMatrix () and
+    * solvePlaneParameters (), including the handling of degenerate neighborhoods, which are set to NaN.
+    *
+    * \param[in] cloud the x, y, z of the first point of the cloud the neighborhood indices refer to
+    * \param[in] point_step the size of a point of the cloud in bytes
+    * \param[in] is_dense true if all the points of the cloud are finite
+    * \param[in] neighborhoods pointers to the indices of each neighborhood, the first \a nr_lanes are used
+    * \param[in] nr_lanes the number of neighborhoods to process, at most V::SIZE
+    * \param[out] plane the plane parameters a, b, c, d of each neighborhood, one row per coefficient
+    * \param[out] curvature the surface curvature of each neighborhood
+    * \tparam V the lane type, one of FloatLanesScalar, FloatLanesSSE2 and FloatLanesAVX
+    */
+  template <typename V> void
+  computePlaneFitBatch (const float *cloud, size_t point_step, bool is_dense,
+                        const std::vector<int> *const *neighborhoods,
+                        int nr_lanes, float (&plane)[4][V::SIZE], float (&curvature)[V::SIZE])
+  {
+    const int N = V::SIZE;
+
+    const int *indices[N];
+    size_t size[N], min_size = std::numeric_limits<size_t>::max (), max_size = 0;
+    for (int l = 0; l < N; ++l)
+    {
+      size[l] = l < nr_lanes ? neighborhoods[l]->size () : 0;
+      indices[l] = size[l] > 0 ? &(*neighborhoods[l])[0] : NULL;
+      min_size = std::min (min_size, size[l]);
+      max_size = std::max (max_size, size[l]);
+    }
+
+    // Accumulate xx, xy, xz, yy, yz, zz, x, y, z and the point count of every lane
+    const V zero (0.0f), one (1.0f);
+    V xx = zero, xy = zero, xz = zero, yy = zero, yz = zero, zz = zero, sx = zero, sy = zero, sz = zero, count = zero;
+    // Missing and invalid neighbors are read from a point at the origin and do not count
+    const float origin[3] = { 0.0f, 0.0f, 0.0f };
+    const char *points = reinterpret_cast<const char*> (cloud);
+    // While every lane has a neighbor left, a dense cloud needs no per lane tests
+    const size_t nr_full = is_dense ? min_size : 0;
+    const float *xyz[N], *weight[N];
+    const float weights[2] = { 0.0f, 1.0f };
+    for (size_t j = 0; j < max_size; ++j)
+    {
+      if (j < nr_full)
+      {
+        for (int l = 0; l < N; ++l)
+          xyz[l] = reinterpret_cast<const float*> (points + static_cast<size_t> (indices[l][j]) * point_step);
+        count = count + one;
+      }
+      else
+      {
+        for (int l = 0; l < N; ++l)
+        {
+          xyz[l] = origin;
+          weight[l] = &weights[0];
+          if (j >= size[l])
+            continue;
+          const float *p = reinterpret_cast<const float*> (points + static_cast<size_t> (indices[l][j]) * point_step);
+          if (!is_dense && (!pcl_isfinite (p[0]) || !pcl_isfinite (p[1]) || !pcl_isfinite (p[2])))
+            continue;
+          xyz[l] = p;
+          weight[l] = &weights[1];
+        }
+        count = count + V::gather (weight, 0);
+      }
+
+      // x, y and z are contiguous in all the PCL point types with coordinates
+      const V x = V::gather (xyz, 0), y = V::gather (xyz, 1), z = V::gather (xyz, 2);
+      xx = xx + x * x; xy = xy + x * y; xz = xz + x * z;
+      yy = yy + y * y; yz = yz + y * z; zz = zz + z * z;
+      sx = sx + x; sy = sy + y; sz = sz + z;
+    }
+
+    // Centroid and covariance
+    const V n = select (greater (count, zero), count, one);
+    const V cx = sx / n, cy = sy / n, cz = sz / n;
+    const V c00 = xx / n - cx * cx, c01 = xy / n - cx * cy, c02 = xz / n - cx * cz;
+    const V c11 = yy / n - cy * cy, c12 = yz / n - cy * cz, c22 = zz / n - cz * cz;
+
+    // Scale the matrices so their entries are in [-1,1]
+    V scale = max (max (max (abs (c00), abs (c01)), max (abs (c02), abs (c11))), max (abs (c12), abs (c22)));
+    scale = select (lessEqual (scale, V (std::numeric_limits<float>::min ())), one, scale);
+    const V m00 = c00 / scale, m01 = c01 / scale, m02 = c02 / scale;
+    const V m11 = c11 / scale, m12 = c12 / scale, m22 = c22 / scale;
+
+    // The characteristic equation is x^3 - c2*x^2 + c1*x - c0 = 0
+    const V two (2.0f);
+    const V p0 = m00 * m11 * m22
+               + two * m01 * m02 * m12
+                     - m00 * m12 * m12
+                     - m11 * m02 * m02
+                     - m22 * m01 * m01;
+    const V p1 = m00 * m11 -
+                 m01 * m01 +
+                 m00 * m22 -
+                 m02 * m02 +
+                 m11 * m22 -
+                 m12 * m12;
+    const V p2 = m00 + m11 + m22;
+
+    // Smallest root, as computed by pcl::computeRoots (): closed form, clamped to 0 when not positive.
+    // Only the angle of the trigonometric solution is computed lane by lane.
+    const V s_inv3 (1.0f / 3.0f), s_sqrt3 (std::sqrt (3.0f)), half (0.5f);
+    const V c2_over_3 = p2 * s_inv3;
+    const V a_over_3 = min ((p1 - p2 * c2_over_3) * s_inv3, zero);
+    const V half_b = half * (p0 + c2_over_3 * (two * c2_over_3 * c2_over_3 - p1));
+    const V q = min (half_b * half_b + a_over_3 * a_over_3 * a_over_3, zero);
+    const V rho = sqrt (zero - a_over_3);
+
+    float s_q[N], s_b[N], s_cos[N], s_sin[N];
+    sqrt (zero - q).store (s_q);
+    half_b.store (s_b);
+    for (int l = 0; l < N; ++l)
+    {
+      const float theta = std::atan2 (s_q[l], s_b[l]) * (1.0f / 3.0f);
+      s_cos[l] = std::cos (theta);
+      s_sin[l] = std::sin (theta);
+    }
+    const V cos_theta = V::load (s_cos), sin_theta = V::load (s_sin);
+    const V r0 = c2_over_3 + two * rho * cos_theta;
+    const V r1 = c2_over_3 - rho * (cos_theta + s_sqrt3 * sin_theta);
+    const V r2 = c2_over_3 - rho * (cos_theta - s_sqrt3 * sin_theta);
+    const V r = min (r0, min (r1, r2));
+    const V lambda = select (greaterEqual (abs (p0), V (std::numeric_limits<float>::epsilon ())) & greater (r, zero),
+                             r, zero);
+
+    // Eigenvector of the smallest eigenvalue: the longest cross product of two rows of (M - lambda I)
+    const V a00 = m00 - lambda, a11 = m11 - lambda, a22 = m22 - lambda;
+    const V v1x = m01 * m12 - m02 * a11, v1y = m02 * m01 - a00 * m12, v1z = a00 * a11 - m01 * m01;
+    const V v2x = m01 * a22 - m02 * m12, v2y = m02 * m02 - a00 * a22, v2z = a00 * m12 - m01 * m02;
+    const V v3x = a11 * a22 - m12 * m12, v3y = m12 * m02 - m01 * a22, v3z = m01 * m12 - a11 * m02;
+
+    const V len1 = v1x * v1x + v1y * v1y + v1z * v1z;
+    const V len2 = v2x * v2x + v2y * v2y + v2z * v2z;
+    const V len3 = v3x * v3x + v3y * v3y + v3z * v3z;
+
+    const V use1 = greaterEqual (len1, len2) & greaterEqual (len1, len3);
+    const V use2 = greaterEqual (len2, len1) & greaterEqual (len2, len3);
+    const V norm = sqrt (select (use1, len1, select (use2, len2, len3)));
+    const V nx = select (use1, v1x, select (use2, v2x, v3x)) / norm;
+    const V ny = select (use1, v1y, select (use2, v2y, v3y)) / norm;
+    const V nz = select (use1, v1z, select (use2, v2z, v3z)) / norm;
+    nx.store (plane[0]);
+    ny.store (plane[1]);
+    nz.store (plane[2]);
+
+    // Hessian form (D = nc . p_plane (centroid here) + p)
+    (zero - (nx * cx + ny * cy + nz * cz)).store (plane[3]);
+
+    // Compute the curvature surface change
+    const V eig_sum = c00 + c11 + c22;
+    const V eig_sum_nonzero = greater (abs (eig_sum), zero);
+    select (eig_sum_nonzero, abs (lambda * scale / select (eig_sum_nonzero, eig_sum, one)), zero).store (curvature);
+
+    // Neighborhoods with less than 3 points or without a single finite point have no plane
+    float s_count[N];
+    count.store (s_count);
+    for (int l = 0; l < nr_lanes; ++l)
+    {
+      if (size[l] < 3 || s_count[l] == 0.0f)
+      {
+        plane[0][l] = plane[1][l] = plane[2][l] = plane[3][l] = std::numeric_limits<float>::quiet_NaN ();
+        curvature[l] = std::numeric_limits<float>::quiet_NaN ();
+      }
+    }
+  }
+}
+//////////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::detail::computePlaneFits (const float *cloud, size_t point_step, bool is_dense,
+                               const std::vector<int> *const *neighborhoods, int nr_neighborhoods,
+                               float *planes, float *curvatures)
+{
+  const int batch_size = PlaneFitLanes::SIZE;
+  float plane[4][batch_size], curvature[batch_size];
+  for (int first = 0; first < nr_neighborhoods; first += batch_size)
+  {
+    const int nr_lanes = std::min (nr_neighborhoods - first, batch_size);
+    computePlaneFitBatch<PlaneFitLanes> (cloud, point_step, is_dense, neighborhoods + first, nr_lanes, plane, curvature);
+    for (int l = 0; l < nr_lanes; ++l)
+    {
+      for (int d = 0; d < 4; ++d)
+        planes[4 * (first + l) + d] = plane[d][l];
+      curvatures[first + l] = curvature[l];
+    }
+  }
+}
@@ -204,10 +204,78 @@ struct cloud_point_index_idx
   unsigned int idx;
   unsigned int cloud_point_index;
 
+  cloud_point_index_idx () : idx (0), cloud_point_index (0) {}
   cloud_point_index_idx (unsigned int idx_, unsigned int cloud_point_index_) : idx (idx_), cloud_point_index (cloud_point_index_) {}
   bool operator < (const cloud_point_index_idx &p) const { return (idx < p.idx); }
 };
 
+namespace pcl
+{
+  namespace detail
+  {
+    /** \brief Sort voxel indices by their voxel key with a stable least significant digit radix sort.
+      * Every pass histograms the current 8-bit digit per block of the input, and scatters the
+      * elements of each block to their sorted position. Blocks are processed in parallel.
+      * \param[in,out] index_vector the voxel indices to sort
+      * \param[in] max_idx the largest voxel key present in \a index_vector
+      * \param[in] nr_threads the number of threads (and input blocks) to use
+      */
+    inline void
+    radixSortVoxelIndices (std::vector<cloud_point_index_idx> &index_vector, unsigned int max_idx, unsigned int nr_threads)
+    {
+      const int nr_blocks = static_cast<int> (std::max (nr_threads, 1u));
+      const size_t size = index_vector.size ();
+      std::vector<cloud_point_index_idx> buffer (size);
+      std::vector<size_t> offsets (nr_blocks * 256);
+
+      std::vector<cloud_point_index_idx> *src = &index_vector, *dst = &buffer;
+      for (unsigned int shift = 0; shift < 32 && (max_idx >> shift) != 0; shift += 8)
+      {
+        std::fill (offsets.begin (), offsets.end (), 0);
+
+        // Count the occurrences of each digit in each block
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nr_blocks) schedule(static, 1)
+#endif
+        for (int b = 0; b < nr_blocks; ++b)
+        {
+          size_t *histogram = &offsets[b * 256];
+          const size_t end = size * (b + 1) / nr_blocks;
+          for (size_t i = size * b / nr_blocks; i < end; ++i)
+            ++histogram[((*src)[i].idx >> shift) & 0xff];
+        }
+
+        // Exclusive prefix sum ordered by digit first and block second, which keeps the sort stable
+        size_t sum = 0;
+        for (int digit = 0; digit < 256; ++digit)
+          for (int b = 0; b < nr_blocks; ++b)
+          {
+            const size_t count = offsets[b * 256 + digit];
+            offsets[b * 256 + digit] = sum;
+            sum += count;
+          }
+
+        // Scatter every block to its sorted position
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nr_blocks) schedule(static, 1)
+#endif
+        for (int b = 0; b < nr_blocks; ++b)
+        {
+          size_t *offset = &offsets[b * 256];
+          const size_t end = size * (b + 1) / nr_blocks;
+          for (size_t i = size * b / nr_blocks; i < end; ++i)
+            (*dst)[offset[((*src)[i].idx >> shift) & 0xff]++] = (*src)[i];
+        }
+
+        std::swap (src, dst);
+      }
+
+      if (src != &index_vector)
+        index_vector.swap (buffer);
+    }
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 template <typename PointT> void
 pcl::VoxelGrid<PointT>::applyFilter (PointCloud &output)
@@ -236,28 +304,34 @@ pcl::VoxelGrid<PointT>::applyFilter (PointCloud &output)
   int64_t dx = static_cast<int64_t>((max_p[0] - min_p[0]) * inverse_leaf_size_[0])+1;
   int64_t dy = static_cast<int64_t>((max_p[1] - min_p[1]) * inverse_leaf_size_[1])+1;
   int64_t dz = static_cast<int64_t>((max_p[2] - min_p[2]) * inverse_leaf_size_[2])+1;
+  // Evaluated in floating point first, the product itself may not fit into 64 bits
+  const double nr_voxels = static_cast<double> (dx) * static_cast<double> (dy) * static_cast<double> (dz);
+  const bool fits_32bit = nr_voxels <= static_cast<double> (std::numeric_limits<int32_t>::max ());
 
-  if ((dx*dy*dz) > static_cast<int64_t>(std::numeric_limits<int32_t>::max()))
+  if (!fits_32bit && (save_leaf_layout_ || nr_voxels >= static_cast<double> (std::numeric_limits<int64_t>::max ())))
   {
     PCL_WARN("[pcl::%s::applyFilter] Leaf size is too small for the input dataset. Integer indices would overflow.", getClassName().c_str());
     output = *input_;
     return;
   }
 
-  // Compute the minimum and maximum bounding box values
-  min_b_[0] = static_cast<int> (floor (min_p[0] * inverse_leaf_size_[0]));
-  max_b_[0] = static_cast<int> (floor (max_p[0] * inverse_leaf_size_[0]));
-  min_b_[1] = static_cast<int> (floor (min_p[1] * inverse_leaf_size_[1]));
-  max_b_[1] = static_cast<int> (floor (max_p[1] * inverse_leaf_size_[1]));
-  min_b_[2] = static_cast<int> (floor (min_p[2] * inverse_leaf_size_[2]));
-  max_b_[2] = static_cast<int> (floor (max_p[2] * inverse_leaf_size_[2]));
-
-  // Compute the number of divisions needed along all axis
-  div_b_ = max_b_ - min_b_ + Eigen::Vector4i::Ones ();
-  div_b_[3] = 0;
-
-  // Set up the division multiplier
-  divb_mul_ = Eigen::Vector4i (1, div_b_[0], div_b_[0] * div_b_[1], 0);
+  if (fits_32bit)
+  {
+    // Compute the minimum and maximum bounding box values
+    min_b_[0] = static_cast<int> (floor (min_p[0] * inverse_leaf_size_[0]));
+    max_b_[0] = static_cast<int> (floor (max_p[0] * inverse_leaf_size_[0]));
+    min_b_[1] = static_cast<int> (floor (min_p[1] * inverse_leaf_size_[1]));
+    max_b_[1] = static_cast<int> (floor (max_p[1] * inverse_leaf_size_[1]));
+    min_b_[2] = static_cast<int> (floor (min_p[2] * inverse_leaf_size_[2]));
+    max_b_[2] = static_cast<int> (floor (max_p[2] * inverse_leaf_size_[2]));
+
+    // Compute the number of divisions needed along all axis
+    div_b_ = max_b_ - min_b_ + Eigen::Vector4i::Ones ();
+    div_b_[3] = 0;
+
+    // Set up the division multiplier
+    divb_mul_ = Eigen::Vector4i (1, div_b_[0], div_b_[0] * div_b_[1], 0);
+  }
 
   int centroid_size = 4;
   if (downsample_all_data_)
@@ -275,10 +349,8 @@ pcl::VoxelGrid<PointT>::applyFilter (PointCloud &output)
     centroid_size += 3;
   }
 
-  std::vector<cloud_point_index_idx> index_vector;
-  index_vector.reserve (indices_->size ());
-
   // If we don't want to process the entire cloud, but rather filter points far away from the viewpoint first...
+  int distance_offset = -1;
   if (!filter_field_name_.empty ())
   {
     // Get the distance field index
@@ -286,74 +358,75 @@ pcl::VoxelGrid<PointT>::applyFilter (PointCloud &output)
     int distance_idx = pcl::getFieldIndex (*input_, filter_field_name_, fields);
     if (distance_idx == -1)
       PCL_WARN ("[pcl::%s::applyFilter] Invalid filter field name. Index is %d.\n", getClassName ().c_str (), distance_idx);
+    else
+      distance_offset = fields[distance_idx].offset;
+  }
 
-    // First pass: go over all points and insert them into the index_vector vector
-    // with calculated idx. Points with the same idx value will contribute to the
-    // same point of resulting CloudPoint
-    for (std::vector<int>::const_iterator it = indices_->begin (); it != indices_->end (); ++it)
+  // Sparse extents with small leaves: accumulate the occupied voxels only
+  if (!fits_32bit || use_hash_map_)
+  {
+    if (save_leaf_layout_)
     {
-      if (!input_->is_dense)
-        // Check if the point is invalid
-        if (!pcl_isfinite (input_->points[*it].x) || 
-            !pcl_isfinite (input_->points[*it].y) || 
-            !pcl_isfinite (input_->points[*it].z))
-          continue;
-
-      // Get the distance value
-      const uint8_t* pt_data = reinterpret_cast<const uint8_t*> (&input_->points[*it]);
-      float distance_value = 0;
-      memcpy (&distance_value, pt_data + fields[distance_idx].offset, sizeof (float));
-
-      if (filter_limit_negative_)
-      {
-        // Use a threshold for cutting out points which inside the interval
-        if ((distance_value < filter_limit_max_) && (distance_value > filter_limit_min_))
-          continue;
-      }
-      else
-      {
-        // Use a threshold for cutting out points which are too close/far away
-        if ((distance_value > filter_limit_max_) || (distance_value < filter_limit_min_))
-          continue;
-      }
-      
-      int ijk0 = static_cast<int> (floor (input_->points[*it].x * inverse_leaf_size_[0]) - static_cast<float> (min_b_[0]));
-      int ijk1 = static_cast<int> (floor (input_->points[*it].y * inverse_leaf_size_[1]) - static_cast<float> (min_b_[1]));
-      int ijk2 = static_cast<int> (floor (input_->points[*it].z * inverse_leaf_size_[2]) - static_cast<float> (min_b_[2]));
-
-      // Compute the centroid leaf index
-      int idx = ijk0 * divb_mul_[0] + ijk1 * divb_mul_[1] + ijk2 * divb_mul_[2];
-      index_vector.push_back (cloud_point_index_idx (static_cast<unsigned int> (idx), *it));
+      PCL_WARN ("[pcl::%s::applyFilter] The leaf layout is not saved in hash map mode.\n", getClassName ().c_str ());
+      leaf_layout_.clear ();
     }
+    applyFilterHashMap (min_p, max_p, distance_offset, rgba_index, centroid_size, output);
+    return;
   }
-  // No distance filtering, process all data
-  else
+
+  // First pass: go over all points and insert them into the index_vector vector
+  // with calculated idx. Points with the same idx value will contribute to the
+  // same point of resulting CloudPoint. Every thread fills its own contiguous block
+  // of index_vector, the blocks are compacted afterwards.
+  const int nr_indices = static_cast<int> (indices_->size ());
+  const int nr_blocks = static_cast<int> (threads_);
+  std::vector<cloud_point_index_idx> index_vector (nr_indices);
+  std::vector<int> block_sizes (nr_blocks, 0);
+  std::vector<unsigned int> block_max_idx (nr_blocks, 0);
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nr_blocks) schedule(static, 1)
+#endif
+  for (int b = 0; b < nr_blocks; ++b)
   {
-    // First pass: go over all points and insert them into the index_vector vector
-    // with calculated idx. Points with the same idx value will contribute to the
-    // same point of resulting CloudPoint
-    for (std::vector<int>::const_iterator it = indices_->begin (); it != indices_->end (); ++it)
+    const int begin = static_cast<int> (static_cast<int64_t> (nr_indices) * b / nr_blocks);
+    const int end = static_cast<int> (static_cast<int64_t> (nr_indices) * (b + 1) / nr_blocks);
+    int size = 0;
+    unsigned int max_idx = 0;
+    for (int i = begin; i < end; ++i)
     {
-      if (!input_->is_dense)
-        // Check if the point is invalid
-        if (!pcl_isfinite (input_->points[*it].x) || 
-            !pcl_isfinite (input_->points[*it].y) || 
-            !pcl_isfinite (input_->points[*it].z))
-          continue;
+      const PointT &point = input_->points[(*indices_)[i]];
+      if (!isPointValid (point, distance_offset))
+        continue;
 
-      int ijk0 = static_cast<int> (floor (input_->points[*it].x * inverse_leaf_size_[0]) - static_cast<float> (min_b_[0]));
-      int ijk1 = static_cast<int> (floor (input_->points[*it].y * inverse_leaf_size_[1]) - static_cast<float> (min_b_[1]));
-      int ijk2 = static_cast<int> (floor (input_->points[*it].z * inverse_leaf_size_[2]) - static_cast<float> (min_b_[2]));
+      int ijk0 = static_cast<int> (floor (point.x * inverse_leaf_size_[0]) - static_cast<float> (min_b_[0]));
+      int ijk1 = static_cast<int> (floor (point.y * inverse_leaf_size_[1]) - static_cast<float> (min_b_[1]));
+      int ijk2 = static_cast<int> (floor (point.z * inverse_leaf_size_[2]) - static_cast<float> (min_b_[2]));
 
       // Compute the centroid leaf index
-      int idx = ijk0 * divb_mul_[0] + ijk1 * divb_mul_[1] + ijk2 * divb_mul_[2];
-      index_vector.push_back (cloud_point_index_idx (static_cast<unsigned int> (idx), *it));
+      unsigned int idx = static_cast<unsigned int> (ijk0 * divb_mul_[0] + ijk1 * divb_mul_[1] + ijk2 * divb_mul_[2]);
+      index_vector[begin + size++] = cloud_point_index_idx (idx, (*indices_)[i]);
+      max_idx = std::max (max_idx, idx);
     }
+    block_sizes[b] = size;
+    block_max_idx[b] = max_idx;
   }
 
+  size_t nr_valid = 0;
+  unsigned int max_idx = 0;
+  for (int b = 0; b < nr_blocks; ++b)
+  {
+    const size_t begin = static_cast<size_t> (static_cast<int64_t> (nr_indices) * b / nr_blocks);
+    if (begin != nr_valid)
+      std::copy (index_vector.begin () + begin, index_vector.begin () + begin + block_sizes[b], index_vector.begin () + nr_valid);
+    nr_valid += block_sizes[b];
+    max_idx = std::max (max_idx, block_max_idx[b]);
+  }
+  index_vector.resize (nr_valid);
+
   // Second pass: sort the index_vector vector using value representing target cell as index
   // in effect all points belonging to the same output cell will be next to each other
-  std::sort (index_vector.begin (), index_vector.end (), std::less<cloud_point_index_idx> ());
+  pcl::detail::radixSortVoxelIndices (index_vector, max_idx, threads_);
 
   // Third pass: count output cells
   // we need to skip all the same, adjacenent idx values
@@ -406,88 +479,156 @@ pcl::VoxelGrid<PointT>::applyFilter (PointCloud &output)
     }
   }
   
-  index = 0;
+  // Every voxel is reduced independently, cp is the centroid final position in resulting PointCloud
   Eigen::VectorXf centroid = Eigen::VectorXf::Zero (centroid_size);
   Eigen::VectorXf temporary = Eigen::VectorXf::Zero (centroid_size);
-
-  for (unsigned int cp = 0; cp < first_and_last_indices_vector.size (); ++cp)
+#ifdef _OPENMP
+#pragma omp parallel for firstprivate (centroid, temporary) num_threads(threads_) schedule(dynamic, 256)
+#endif
+  for (int cp = 0; cp < static_cast<int> (first_and_last_indices_vector.size ()); ++cp)
   {
     // calculate centroid - sum values from all input points, that have the same idx value in index_vector array
-	unsigned int first_index = first_and_last_indices_vector[cp].first;
-	unsigned int last_index = first_and_last_indices_vector[cp].second;
-    if (!downsample_all_data_) 
-    {
-      centroid[0] = input_->points[index_vector[first_index].cloud_point_index].x;
-      centroid[1] = input_->points[index_vector[first_index].cloud_point_index].y;
-      centroid[2] = input_->points[index_vector[first_index].cloud_point_index].z;
-    }
-    else 
-    {
-      // ---[ RGB special case
-      if (rgba_index >= 0)
-      {
-        // Fill r/g/b data, assuming that the order is BGRA
-        pcl::RGB rgb;
-        memcpy (&rgb, reinterpret_cast<const char*> (&input_->points[index_vector[first_index].cloud_point_index]) + rgba_index, sizeof (RGB));
-        centroid[centroid_size-3] = rgb.r;
-        centroid[centroid_size-2] = rgb.g;
-        centroid[centroid_size-1] = rgb.b;
-      }
-      pcl::for_each_type <FieldList> (NdCopyPointEigenFunctor <PointT> (input_->points[index_vector[first_index].cloud_point_index], centroid));
-    }
+    unsigned int first_index = first_and_last_indices_vector[cp].first;
+    unsigned int last_index = first_and_last_indices_vector[cp].second;
+    centroid.setZero ();
+    for (unsigned int i = first_index; i < last_index; ++i) 
+      addToCentroid (input_->points[index_vector[i].cloud_point_index], rgba_index, temporary, centroid.data ());
 
-    for (unsigned int i = first_index + 1; i < last_index; ++i) 
-    {
-      if (!downsample_all_data_) 
-      {
-        centroid[0] += input_->points[index_vector[i].cloud_point_index].x;
-        centroid[1] += input_->points[index_vector[i].cloud_point_index].y;
-        centroid[2] += input_->points[index_vector[i].cloud_point_index].z;
-      }
-      else 
-      {
-        // ---[ RGB special case
-        if (rgba_index >= 0)
-        {
-          // Fill r/g/b data, assuming that the order is BGRA
-          pcl::RGB rgb;
-          memcpy (&rgb, reinterpret_cast<const char*> (&input_->points[index_vector[i].cloud_point_index]) + rgba_index, sizeof (RGB));
-          temporary[centroid_size-3] = rgb.r;
-          temporary[centroid_size-2] = rgb.g;
-          temporary[centroid_size-1] = rgb.b;
-        }
-        pcl::for_each_type <FieldList> (NdCopyPointEigenFunctor <PointT> (input_->points[index_vector[i].cloud_point_index], temporary));
-        centroid += temporary;
-      }
-    }
-
-    // index is centroid final position in resulting PointCloud
     if (save_leaf_layout_)
-      leaf_layout_[index_vector[first_index].idx] = index;
+      leaf_layout_[index_vector[first_index].idx] = cp;
 
     centroid /= static_cast<float> (last_index - first_index);
 
     // store centroid
-    // Do we need to process all the fields?
-    if (!downsample_all_data_) 
+    copyCentroidToPoint (centroid, rgba_index, output.points[cp]);
+  }
+  output.width = static_cast<uint32_t> (output.points.size ());
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> void
+pcl::VoxelGrid<PointT>::applyFilterHashMap (const Eigen::Vector4f &min_p, const Eigen::Vector4f &max_p,
+                                            int distance_offset, int rgba_index, int centroid_size,
+                                            PointCloud &output)
+{
+  typedef boost::unordered_map<uint64_t, unsigned int> VoxelMap;
+
+  // 64-bit grid layout, min_b_/max_b_/div_b_ are only meaningful when they fit into 32 bits
+  const int64_t min_b0 = static_cast<int64_t> (floor (min_p[0] * inverse_leaf_size_[0]));
+  const int64_t min_b1 = static_cast<int64_t> (floor (min_p[1] * inverse_leaf_size_[1]));
+  const int64_t min_b2 = static_cast<int64_t> (floor (min_p[2] * inverse_leaf_size_[2]));
+  const int64_t div0 = static_cast<int64_t> (floor (max_p[0] * inverse_leaf_size_[0])) - min_b0 + 1;
+  const int64_t div1 = static_cast<int64_t> (floor (max_p[1] * inverse_leaf_size_[1])) - min_b1 + 1;
+  const uint64_t mul1 = static_cast<uint64_t> (div0);
+  const uint64_t mul2 = static_cast<uint64_t> (div0) * static_cast<uint64_t> (div1);
+
+  // First pass: compute the 64-bit voxel index of every valid point, invalid points are marked
+  const int nr_indices = static_cast<int> (indices_->size ());
+  const uint64_t invalid = std::numeric_limits<uint64_t>::max ();
+  std::vector<uint64_t> voxel_indices (nr_indices);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(threads_)
+#endif
+  for (int i = 0; i < nr_indices; ++i)
+  {
+    const PointT &point = input_->points[(*indices_)[i]];
+    if (!isPointValid (point, distance_offset))
     {
-      output.points[index].x = centroid[0];
-      output.points[index].y = centroid[1];
-      output.points[index].z = centroid[2];
+      voxel_indices[i] = invalid;
+      continue;
     }
-    else 
+    const uint64_t ijk0 = static_cast<uint64_t> (static_cast<int64_t> (floor (point.x * inverse_leaf_size_[0])) - min_b0);
+    const uint64_t ijk1 = static_cast<uint64_t> (static_cast<int64_t> (floor (point.y * inverse_leaf_size_[1])) - min_b1);
+    const uint64_t ijk2 = static_cast<uint64_t> (static_cast<int64_t> (floor (point.z * inverse_leaf_size_[2])) - min_b2);
+    voxel_indices[i] = ijk0 + ijk1 * mul1 + ijk2 * mul2;
+  }
+
+  // Second pass: every thread numbers the voxels of a contiguous range of the points, in the order
+  // of the first point of every voxel within the range
+  const int nr_parts = std::max (1, std::min (static_cast<int> (threads_), nr_indices));
+  std::vector<unsigned int> voxel_slots (nr_indices);
+  std::vector<std::vector<uint64_t> > part_voxels (nr_parts);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nr_parts) schedule(static, 1)
+#endif
+  for (int part = 0; part < nr_parts; ++part)
+  {
+    const int begin = static_cast<int> (static_cast<int64_t> (nr_indices) * part / nr_parts);
+    const int end = static_cast<int> (static_cast<int64_t> (nr_indices) * (part + 1) / nr_parts);
+    VoxelMap voxel_map;
+    std::vector<uint64_t> &voxels = part_voxels[part];
+    for (int i = begin; i < end; ++i)
     {
-      pcl::for_each_type<FieldList> (pcl::NdCopyEigenPointFunctor <PointT> (centroid, output.points[index]));
-      // ---[ RGB special case
-      if (rgba_index >= 0) 
-      {
-        // pack r/g/b into rgb
-        float r = centroid[centroid_size-3], g = centroid[centroid_size-2], b = centroid[centroid_size-1];
-        int rgb = (static_cast<int> (r) << 16) | (static_cast<int> (g) << 8) | static_cast<int> (b);
-        memcpy (reinterpret_cast<char*> (&output.points[index]) + rgba_index, &rgb, sizeof (float));
-      }
+      if (voxel_indices[i] == invalid)
+        continue;
+      std::pair<VoxelMap::iterator, bool> it = voxel_map.insert (std::make_pair (voxel_indices[i], static_cast<unsigned int> (voxels.size ())));
+      if (it.second)
+        voxels.push_back (voxel_indices[i]);
+      voxel_slots[i] = it.first->second;
     }
-    ++index;
+  }
+
+  // Merge the ranges in order, so that the voxels are numbered by their first point whatever the number of threads
+  std::vector<std::vector<unsigned int> > part_slots (nr_parts);
+  VoxelMap voxel_map;
+  for (int part = 0; part < nr_parts; ++part)
+  {
+    const std::vector<uint64_t> &voxels = part_voxels[part];
+    part_slots[part].resize (voxels.size ());
+    for (size_t v = 0; v < voxels.size (); ++v)
+      part_slots[part][v] = voxel_map.insert (std::make_pair (voxels[v], static_cast<unsigned int> (voxel_map.size ()))).first->second;
+  }
+  const unsigned int nr_voxels = static_cast<unsigned int> (voxel_map.size ());
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nr_parts) schedule(static, 1)
+#endif
+  for (int part = 0; part < nr_parts; ++part)
+  {
+    const int begin = static_cast<int> (static_cast<int64_t> (nr_indices) * part / nr_parts);
+    const int end = static_cast<int> (static_cast<int64_t> (nr_indices) * (part + 1) / nr_parts);
+    for (int i = begin; i < end; ++i)
+      if (voxel_indices[i] != invalid)
+        voxel_slots[i] = part_slots[part][voxel_slots[i]];
+  }
+
+  // Third pass: group the points by voxel with a counting sort, keeping their input order within every voxel
+  std::vector<unsigned int> voxel_begin (nr_voxels + 1, 0);
+  for (int i = 0; i < nr_indices; ++i)
+    if (voxel_indices[i] != invalid)
+      ++voxel_begin[voxel_slots[i] + 1];
+  for (unsigned int v = 0; v < nr_voxels; ++v)
+    voxel_begin[v + 1] += voxel_begin[v];
+
+  std::vector<unsigned int> voxel_points (voxel_begin[nr_voxels]);
+  std::vector<unsigned int> voxel_fill (voxel_begin.begin (), voxel_begin.end () - 1);
+  for (int i = 0; i < nr_indices; ++i)
+    if (voxel_indices[i] != invalid)
+      voxel_points[voxel_fill[voxel_slots[i]]++] = i;
+
+  // Fourth pass: compute the centroids of the voxels with enough points, every voxel is reduced
+  // independently and in input order, so the result does not depend on the number of threads
+  std::vector<int> output_index (nr_voxels, -1);
+  int total = 0;
+  for (unsigned int v = 0; v < nr_voxels; ++v)
+    if (voxel_begin[v + 1] - voxel_begin[v] >= min_points_per_voxel_)
+      output_index[v] = total++;
+  output.points.resize (total);
+
+  Eigen::VectorXf centroid = Eigen::VectorXf::Zero (centroid_size);
+  Eigen::VectorXf temporary = Eigen::VectorXf::Zero (centroid_size);
+#ifdef _OPENMP
+#pragma omp parallel for firstprivate (centroid, temporary) num_threads(threads_) schedule(dynamic, 256)
+#endif
+  for (int v = 0; v < static_cast<int> (nr_voxels); ++v)
+  {
+    if (output_index[v] < 0)
+      continue;
+    centroid.setZero ();
+    for (unsigned int j = voxel_begin[v]; j < voxel_begin[v + 1]; ++j)
+      addToCentroid (input_->points[(*indices_)[voxel_points[j]]], rgba_index, temporary, centroid.data ());
+    centroid /= static_cast<float> (voxel_begin[v + 1] - voxel_begin[v]);
+    copyCentroidToPoint (centroid, rgba_index, output.points[output_index[v]]);
   }
   output.width = static_cast<uint32_t> (output.points.size ());
 }
@@ -43,6 +43,9 @@
 #include <pcl/filters/boost.h>
 #include <pcl/filters/filter.h>
 #include <map>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace pcl
 {
@@ -206,7 +209,9 @@ namespace pcl
         filter_limit_min_ (-FLT_MAX), 
         filter_limit_max_ (FLT_MAX),
         filter_limit_negative_ (false),
-        min_points_per_voxel_ (0)
+        min_points_per_voxel_ (0),
+        threads_ (1),
+        use_hash_map_ (false)
       {
         filter_name_ = "VoxelGrid";
       }
@@ -452,6 +457,41 @@ namespace pcl
         return (filter_limit_negative_);
       }
 
+      /** \brief Set the number of threads used to compute the voxel indices, sort them and compute
+        * the voxel centroids. The result does not depend on the number of threads.
+        * \param[in] nr_threads the number of hardware threads to use (0 sets the value back to automatic)
+        */
+      inline void
+      setNumberOfThreads (unsigned int nr_threads = 0)
+      {
+#ifdef _OPENMP
+        threads_ = nr_threads != 0 ? nr_threads : static_cast<unsigned int> (omp_get_num_procs ());
+#else
+        if (nr_threads != 1)
+          PCL_WARN ("[pcl::%s::setNumberOfThreads] PCL was compiled without OpenMP, using a single thread.\n", getClassName ().c_str ());
+        threads_ = 1;
+#endif
+      }
+
+      /** \brief Get the number of threads used to downsample the cloud. */
+      inline unsigned int
+      getNumberOfThreads () const { return (threads_); }
+
+      /** \brief Set to true to accumulate the voxel centroids in a hash map keyed on 64-bit voxel
+        * indices instead of sorting the points by voxel. The hash map only holds the occupied voxels,
+        * which makes it the better choice for large, sparse extents with small leaf sizes.
+        * It is used automatically if the number of voxels does not fit into 32-bit indices.
+        * \note The output points follow the order of the first input point of every voxel, whatever the
+        * number of threads. The leaf layout is not saved in this mode.
+        * \param[in] use_hash_map the new value (true/false)
+        */
+      inline void
+      setUseHashMap (bool use_hash_map) { use_hash_map_ = use_hash_map; }
+
+      /** \brief Returns true if the voxel centroids are accumulated in a hash map. */
+      inline bool
+      getUseHashMap () const { return (use_hash_map_); }
+
     protected:
       /** \brief The size of a leaf. */
       Eigen::Vector4f leaf_size_;
@@ -486,6 +526,12 @@ namespace pcl
       /** \brief Minimum number of points per voxel for the centroid to be computed */
       unsigned int min_points_per_voxel_;
 
+      /** \brief The number of threads the scheduler should use. */
+      unsigned int threads_;
+
+      /** \brief Set to true to accumulate the voxel centroids in a hash map instead of sorting the points. */
+      bool use_hash_map_;
+
       typedef typename pcl::traits::fieldList<PointT>::type FieldList;
 
       /** \brief Downsample a Point Cloud using a voxelized grid approach
@@ -493,6 +539,102 @@ namespace pcl
         */
       void 
       applyFilter (PointCloud &output);
+
+      /** \brief Downsample a Point Cloud by accumulating the voxel centroids in a hash map keyed on
+        * 64-bit voxel indices.
+        * \param[in] min_p the minimum corner of the bounding box of the points to downsample
+        * \param[in] max_p the maximum corner of the bounding box of the points to downsample
+        * \param[in] distance_offset the byte offset of the filter field, or -1 if no field filtering is done
+        * \param[in] rgba_index the byte offset of the rgb(a) field, or -1 if the point has no color
+        * \param[in] centroid_size the number of values accumulated per voxel
+        * \param[out] output the resultant point cloud
+        */
+      void
+      applyFilterHashMap (const Eigen::Vector4f &min_p, const Eigen::Vector4f &max_p,
+                          int distance_offset, int rgba_index, int centroid_size, PointCloud &output);
+
+      /** \brief Check whether a point is finite and within the filter field limits.
+        * \param[in] point the point to check
+        * \param[in] distance_offset the byte offset of the filter field, or -1 if no field filtering is done
+        */
+      inline bool
+      isPointValid (const PointT &point, int distance_offset) const
+      {
+        if (!input_->is_dense)
+          // Check if the point is invalid
+          if (!pcl_isfinite (point.x) || !pcl_isfinite (point.y) || !pcl_isfinite (point.z))
+            return (false);
+
+        if (distance_offset < 0)
+          return (true);
+
+        // Get the distance value
+        float distance_value = 0;
+        memcpy (&distance_value, reinterpret_cast<const uint8_t*> (&point) + distance_offset, sizeof (float));
+
+        if (filter_limit_negative_)
+          // Use a threshold for cutting out points which inside the interval
+          return (!((distance_value < filter_limit_max_) && (distance_value > filter_limit_min_)));
+        // Use a threshold for cutting out points which are too close/far away
+        return (!((distance_value > filter_limit_max_) || (distance_value < filter_limit_min_)));
+      }
+
+      /** \brief Add a point to the running sum of a voxel centroid.
+        * \param[in] point the point to add
+        * \param[in] rgba_index the byte offset of the rgb(a) field, or -1 if the point has no color
+        * \param[in,out] temporary scratch vector with the size of the centroid
+        * \param[in,out] centroid the running sum of the voxel centroid
+        */
+      inline void
+      addToCentroid (const PointT &point, int rgba_index, Eigen::VectorXf &temporary, float *centroid) const
+      {
+        if (!downsample_all_data_)
+        {
+          centroid[0] += point.x;
+          centroid[1] += point.y;
+          centroid[2] += point.z;
+          return;
+        }
+        // ---[ RGB special case
+        if (rgba_index >= 0)
+        {
+          // Fill r/g/b data, assuming that the order is BGRA
+          pcl::RGB rgb;
+          memcpy (&rgb, reinterpret_cast<const char*> (&point) + rgba_index, sizeof (RGB));
+          temporary[temporary.size () - 3] = rgb.r;
+          temporary[temporary.size () - 2] = rgb.g;
+          temporary[temporary.size () - 1] = rgb.b;
+        }
+        pcl::for_each_type <FieldList> (NdCopyPointEigenFunctor <PointT> (point, temporary));
+        Eigen::Map<Eigen::VectorXf> (centroid, temporary.size ()) += temporary;
+      }
+
+      /** \brief Store a voxel centroid into an output point.
+        * \param[in] centroid the voxel centroid
+        * \param[in] rgba_index the byte offset of the rgb(a) field, or -1 if the point has no color
+        * \param[out] point the output point
+        */
+      inline void
+      copyCentroidToPoint (const Eigen::VectorXf &centroid, int rgba_index, PointT &point) const
+      {
+        // Do we need to process all the fields?
+        if (!downsample_all_data_)
+        {
+          point.x = centroid[0];
+          point.y = centroid[1];
+          point.z = centroid[2];
+          return;
+        }
+        pcl::for_each_type<FieldList> (pcl::NdCopyEigenPointFunctor <PointT> (centroid, point));
+        // ---[ RGB special case
+        if (rgba_index >= 0)
+        {
+          // pack r/g/b into rgb
+          float r = centroid[centroid.size () - 3], g = centroid[centroid.size () - 2], b = centroid[centroid.size () - 1];
+          int rgb = (static_cast<int> (r) << 16) | (static_cast<int> (g) << 8) | static_cast<int> (b);
+          memcpy (reinterpret_cast<char*> (&point) + rgba_index, &rgb, sizeof (float));
+        }
+      }
   };
 
   /** \brief VoxelGrid assembles a local 3D grid over a given PointCloud, and downsamples + filters the data.
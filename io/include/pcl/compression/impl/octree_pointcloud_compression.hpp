@@ -43,6 +43,7 @@
 
 #include <iterator>
 #include <iostream>
+#include <sstream>
 #include <vector>
 #include <string.h>
 #include <iostream>
@@ -121,6 +122,10 @@ namespace pcl
         point_coder_.initializeEncoding ();
         point_coder_.setPointCount (static_cast<unsigned int> (cloud_arg->points.size ()));
 
+        // subtree boundaries are recorded while serializing, the root node is written first
+        subtree_segments_.clear ();
+        last_leaf_tree_size_ = 1;
+
         // serialize octree
         if (i_frame_)
           // i-frame encoding - encode tree structure without referencing previous buffer
@@ -134,7 +139,10 @@ namespace pcl
         this->writeFrameHeader (compressed_tree_data_out_arg);
 
         // apply entropy coding to the content of all data vectors and send data to output stream
-        this->entropyEncoding (compressed_tree_data_out_arg);
+        if (subtree_coding_)
+          this->subtreeEntropyEncoding (compressed_tree_data_out_arg);
+        else
+          this->entropyEncoding (compressed_tree_data_out_arg);
 
         // prepare for next frame
         this->switchBuffers ();
@@ -180,6 +188,28 @@ namespace pcl
         std::istream& compressed_tree_data_in_arg,
         PointCloudPtr &cloud_arg)
     {
+      decodeFrame (compressed_tree_data_in_arg, cloud_arg, NULL, NULL);
+    }
+
+    //////////////////////////////////////////////////////////////////////////////////////////////
+    template<typename PointT, typename LeafT, typename BranchT, typename OctreeT> void
+    OctreePointCloudCompression<PointT, LeafT, BranchT, OctreeT>::decodePointCloud (
+        std::istream& compressed_tree_data_in_arg,
+        PointCloudPtr &cloud_arg,
+        const Eigen::Vector3d &min_pt_arg,
+        const Eigen::Vector3d &max_pt_arg)
+    {
+      decodeFrame (compressed_tree_data_in_arg, cloud_arg, &min_pt_arg, &max_pt_arg);
+    }
+
+    //////////////////////////////////////////////////////////////////////////////////////////////
+    template<typename PointT, typename LeafT, typename BranchT, typename OctreeT> void
+    OctreePointCloudCompression<PointT, LeafT, BranchT, OctreeT>::decodeFrame (
+        std::istream& compressed_tree_data_in_arg,
+        PointCloudPtr &cloud_arg,
+        const Eigen::Vector3d *min_pt_arg,
+        const Eigen::Vector3d *max_pt_arg)
+    {
 
       // synchronize to frame header
       syncToHeader(compressed_tree_data_in_arg);
@@ -205,7 +235,28 @@ namespace pcl
       this->readFrameHeader (compressed_tree_data_in_arg);
 
       // decode data vectors from stream
-      this->entropyDecoding (compressed_tree_data_in_arg);
+      if (subtree_coded_frame_)
+      {
+        // subtrees can only be skipped in intra frames, prediction frames need the complete previous tree
+        unsigned char subtree_mask = 0xFF;
+        if (min_pt_arg && max_pt_arg && i_frame_)
+          subtree_mask = this->getSubtreeMask (*min_pt_arg, *max_pt_arg);
+        this->subtreeEntropyDecoding (compressed_tree_data_in_arg, subtree_mask);
+      }
+      else
+      {
+        this->entropyDecoding (compressed_tree_data_in_arg);
+        if (i_frame_)
+          tree_partially_decoded_ = false;
+      }
+
+      if (!i_frame_ && tree_partially_decoded_)
+      {
+        PCL_ERROR ("[pcl::io::OctreePointCloudCompression::decodePointCloud] Frame %d predicts from a partially decoded frame, waiting for the next intra frame!\n", frame_ID_);
+        output_->points.clear ();
+        output_->width = output_->height = 0;
+        return;
+      }
 
       // initialize color and point encoding
       color_coder_.initializeDecoding ();
@@ -372,8 +423,9 @@ namespace pcl
     template<typename PointT, typename LeafT, typename BranchT, typename OctreeT> void
     OctreePointCloudCompression<PointT, LeafT, BranchT, OctreeT>::writeFrameHeader (std::ostream& compressed_tree_data_out_arg)
     {
-      // encode header identifier
-      compressed_tree_data_out_arg.write (reinterpret_cast<const char*> (frame_header_identifier_), strlen (frame_header_identifier_));
+      // encode header identifier, which also tells whether subtree coding is used
+      const char* header_identifier = subtree_coding_ ? subtree_frame_header_identifier_ : frame_header_identifier_;
+      compressed_tree_data_out_arg.write (reinterpret_cast<const char*> (header_identifier), strlen (header_identifier));
       // encode point cloud header id
       compressed_tree_data_out_arg.write (reinterpret_cast<const char*> (&frame_ID_), sizeof (frame_ID_));
       // encode frame type (I/P-frame)
@@ -419,14 +471,30 @@ namespace pcl
     template<typename PointT, typename LeafT, typename BranchT, typename OctreeT> void
     OctreePointCloudCompression<PointT, LeafT, BranchT, OctreeT>::syncToHeader ( std::istream& compressed_tree_data_in_arg)
     {
-      // sync to frame header
-      unsigned int header_id_pos = 0;
-      while (header_id_pos < strlen (frame_header_identifier_))
+      // sync to either frame header, keeping the last characters read
+      const std::string header_identifier (frame_header_identifier_);
+      const std::string subtree_header_identifier (subtree_frame_header_identifier_);
+      const std::size_t window_size = std::max (header_identifier.size (), subtree_header_identifier.size ());
+      std::string window;
+      char readChar;
+      while (compressed_tree_data_in_arg.read (static_cast<char*> (&readChar), sizeof (readChar)))
       {
-        char readChar;
-        compressed_tree_data_in_arg.read (static_cast<char*> (&readChar), sizeof (readChar));
-        if (readChar != frame_header_identifier_[header_id_pos++])
-          header_id_pos = (frame_header_identifier_[0]==readChar)?1:0;
+        window.push_back (readChar);
+        if (window.size () > window_size)
+          window.erase (0, 1);
+
+        if (window.size () >= header_identifier.size () &&
+            window.compare (window.size () - header_identifier.size (), header_identifier.size (), header_identifier) == 0)
+        {
+          subtree_coded_frame_ = false;
+          return;
+        }
+        if (window.size () >= subtree_header_identifier.size () &&
+            window.compare (window.size () - subtree_header_identifier.size (), subtree_header_identifier.size (), subtree_header_identifier) == 0)
+        {
+          subtree_coded_frame_ = true;
+          return;
+        }
       }
     }
 
@@ -479,6 +547,21 @@ namespace pcl
       // reference to point indices vector stored within octree leaf
       const std::vector<int>& leafIdx = leaf_arg.getPointIndicesVector();
 
+      if (subtree_coding_)
+      {
+        // leaves are visited depth first, so the data of a top-level subtree is contiguous
+        const unsigned char child_idx = key_arg.getChildIdxWithDepthMask (this->depth_mask_);
+        if (subtree_segments_.empty () || subtree_segments_.back ().child_idx != child_idx)
+        {
+          SubtreeSegment segment;
+          segment.child_idx = child_idx;
+          getStreamSizes (segment.begin);
+          // branch nodes written since the last leaf of the previous subtree belong to this one
+          segment.begin[TREE_STREAM] = last_leaf_tree_size_;
+          subtree_segments_.push_back (segment);
+        }
+      }
+
       if (!do_voxel_grid_enDecoding_)
       {
         double lowerVoxelCorner[3];
@@ -504,6 +587,9 @@ namespace pcl
           // encode average color of all points within voxel
           color_coder_.encodeAverageOfPoints (leafIdx, point_color_offset_, this->input_);
       }
+
+      if (subtree_coding_)
+        last_leaf_tree_size_ = binary_tree_data_vector_.size ();
     }
 
     //////////////////////////////////////////////////////////////////////////////////////////////
@@ -561,6 +647,246 @@ namespace pcl
                                        output_->points.size (), point_color_offset_);
       }
     }
+
+    //////////////////////////////////////////////////////////////////////////////////////////////
+    template<typename PointT, typename LeafT, typename BranchT, typename OctreeT> void
+    OctreePointCloudCompression<PointT, LeafT, BranchT, OctreeT>::getStreamSizes (uint64_t sizes_arg[NR_SUBTREE_STREAMS])
+    {
+      // same selection of data vectors as entropyEncoding
+      sizes_arg[TREE_STREAM] = binary_tree_data_vector_.size ();
+      sizes_arg[COLOR_AVG_STREAM] = cloud_with_color_ ? color_coder_.getAverageDataVector ().size () : 0;
+      sizes_arg[POINT_COUNT_STREAM] = !do_voxel_grid_enDecoding_ ? point_count_data_vector_.size () : 0;
+      sizes_arg[POINT_DIFF_STREAM] = !do_voxel_grid_enDecoding_ ? point_coder_.getDifferentialDataVector ().size () : 0;
+      sizes_arg[COLOR_DIFF_STREAM] = (!do_voxel_grid_enDecoding_ && cloud_with_color_) ?
+                                     color_coder_.getDifferentialDataVector ().size () : 0;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////////////////////
+    template<typename PointT, typename LeafT, typename BranchT, typename OctreeT> std::vector<char>&
+    OctreePointCloudCompression<PointT, LeafT, BranchT, OctreeT>::getCharStream (int stream_arg)
+    {
+      switch (stream_arg)
+      {
+        case POINT_DIFF_STREAM:
+          return (point_coder_.getDifferentialDataVector ());
+        case COLOR_AVG_STREAM:
+          return (color_coder_.getAverageDataVector ());
+        case COLOR_DIFF_STREAM:
+          return (color_coder_.getDifferentialDataVector ());
+        default:
+          return (binary_tree_data_vector_);
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////////////////////////
+    template<typename PointT, typename LeafT, typename BranchT, typename OctreeT> void
+    OctreePointCloudCompression<PointT, LeafT, BranchT, OctreeT>::subtreeEntropyEncoding (std::ostream& compressed_tree_data_out_arg)
+    {
+      const int nr_segments = static_cast<int> (subtree_segments_.size ());
+      const int nr_tasks = nr_segments * NR_SUBTREE_STREAMS;
+
+      uint64_t end_sizes[NR_SUBTREE_STREAMS];
+      getStreamSizes (end_sizes);
+
+      std::vector<uint64_t> raw_sizes (nr_tasks);
+      std::vector<std::string> coded_data (nr_tasks);
+
+      // every stream of every subtree is range coded on its own
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(threads_) schedule(dynamic)
+#endif
+      for (int task = 0; task < nr_tasks; ++task)
+      {
+        const int segment = task / NR_SUBTREE_STREAMS;
+        const int stream = task % NR_SUBTREE_STREAMS;
+        const uint64_t begin = subtree_segments_[segment].begin[stream];
+        const uint64_t end = (segment + 1 < nr_segments) ? subtree_segments_[segment + 1].begin[stream] : end_sizes[stream];
+
+        raw_sizes[task] = end - begin;
+        if (begin == end)
+          continue;
+
+        StaticRangeCoder range_coder;
+        std::ostringstream coded_stream;
+        if (stream == POINT_COUNT_STREAM)
+        {
+          std::vector<unsigned int> data (point_count_data_vector_.begin () + begin, point_count_data_vector_.begin () + end);
+          range_coder.encodeIntVectorToStream (data, coded_stream);
+        }
+        else
+        {
+          const std::vector<char>& stream_data = getCharStream (stream);
+          std::vector<char> data (stream_data.begin () + begin, stream_data.begin () + end);
+          range_coder.encodeCharVectorToStream (data, coded_stream);
+        }
+        coded_data[task] = coded_stream.str ();
+      }
+
+      // write occupancy of the root node and the subtree index
+      compressed_tree_data_out_arg.write (&binary_tree_data_vector_[0], sizeof (char));
+      const unsigned char nr_subtrees = static_cast<unsigned char> (nr_segments);
+      compressed_tree_data_out_arg.write (reinterpret_cast<const char*> (&nr_subtrees), sizeof (nr_subtrees));
+
+      compressed_point_data_len_ = 2;
+      compressed_color_data_len_ = 0;
+      for (int segment = 0; segment < nr_segments; ++segment)
+      {
+        compressed_tree_data_out_arg.write (reinterpret_cast<const char*> (&subtree_segments_[segment].child_idx), sizeof (unsigned char));
+        for (int stream = 0; stream < NR_SUBTREE_STREAMS; ++stream)
+        {
+          const int task = segment * NR_SUBTREE_STREAMS + stream;
+          const uint64_t coded_size = coded_data[task].size ();
+          compressed_tree_data_out_arg.write (reinterpret_cast<const char*> (&raw_sizes[task]), sizeof (raw_sizes[task]));
+          compressed_tree_data_out_arg.write (reinterpret_cast<const char*> (&coded_size), sizeof (coded_size));
+
+          if (stream == COLOR_AVG_STREAM || stream == COLOR_DIFF_STREAM)
+            compressed_color_data_len_ += coded_size;
+          else
+            compressed_point_data_len_ += coded_size;
+        }
+      }
+
+      // write range coded data
+      for (int task = 0; task < nr_tasks; ++task)
+        compressed_tree_data_out_arg.write (coded_data[task].data (), coded_data[task].size ());
+
+      // flush output stream
+      compressed_tree_data_out_arg.flush ();
+    }
+
+    //////////////////////////////////////////////////////////////////////////////////////////////
+    template<typename PointT, typename LeafT, typename BranchT, typename OctreeT> void
+    OctreePointCloudCompression<PointT, LeafT, BranchT, OctreeT>::subtreeEntropyDecoding (std::istream& compressed_tree_data_in_arg,
+                                                                                          unsigned char subtree_mask_arg)
+    {
+      char root_node_bits;
+      unsigned char nr_subtrees;
+
+      // read occupancy of the root node and the subtree index
+      compressed_tree_data_in_arg.read (&root_node_bits, sizeof (root_node_bits));
+      compressed_tree_data_in_arg.read (reinterpret_cast<char*> (&nr_subtrees), sizeof (nr_subtrees));
+
+      const int nr_segments = nr_subtrees;
+      const int nr_tasks = nr_segments * NR_SUBTREE_STREAMS;
+      std::vector<unsigned char> child_idx (nr_segments);
+      std::vector<uint64_t> raw_sizes (nr_tasks);
+      std::vector<uint64_t> coded_sizes (nr_tasks);
+      std::vector<uint64_t> coded_offsets (nr_tasks + 1, 0);
+
+      for (int segment = 0; segment < nr_segments; ++segment)
+      {
+        compressed_tree_data_in_arg.read (reinterpret_cast<char*> (&child_idx[segment]), sizeof (unsigned char));
+        for (int stream = 0; stream < NR_SUBTREE_STREAMS; ++stream)
+        {
+          const int task = segment * NR_SUBTREE_STREAMS + stream;
+          compressed_tree_data_in_arg.read (reinterpret_cast<char*> (&raw_sizes[task]), sizeof (raw_sizes[task]));
+          compressed_tree_data_in_arg.read (reinterpret_cast<char*> (&coded_sizes[task]), sizeof (coded_sizes[task]));
+          coded_offsets[task + 1] = coded_offsets[task] + coded_sizes[task];
+        }
+      }
+
+      std::vector<char> coded_data (static_cast<std::size_t> (coded_offsets[nr_tasks]));
+      if (!coded_data.empty ())
+        compressed_tree_data_in_arg.read (&coded_data[0], coded_data.size ());
+
+      // decode the streams of the selected subtrees
+      std::vector<std::vector<char> > char_data (nr_tasks);
+      std::vector<std::vector<unsigned int> > int_data (nr_segments);
+
+      compressed_point_data_len_ = 2;
+      compressed_color_data_len_ = 0;
+      for (int task = 0; task < nr_tasks; ++task)
+      {
+        if (!(subtree_mask_arg & (1 << child_idx[task / NR_SUBTREE_STREAMS])))
+          continue;
+        const int stream = task % NR_SUBTREE_STREAMS;
+        if (stream == COLOR_AVG_STREAM || stream == COLOR_DIFF_STREAM)
+          compressed_color_data_len_ += coded_sizes[task];
+        else
+          compressed_point_data_len_ += coded_sizes[task];
+      }
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(threads_) schedule(dynamic)
+#endif
+      for (int task = 0; task < nr_tasks; ++task)
+      {
+        const int segment = task / NR_SUBTREE_STREAMS;
+        const int stream = task % NR_SUBTREE_STREAMS;
+        if (!(subtree_mask_arg & (1 << child_idx[segment])) || raw_sizes[task] == 0)
+          continue;
+
+        StaticRangeCoder range_coder;
+        std::istringstream coded_stream (std::string (&coded_data[static_cast<std::size_t> (coded_offsets[task])],
+                                                      static_cast<std::size_t> (coded_sizes[task])));
+        if (stream == POINT_COUNT_STREAM)
+        {
+          int_data[segment].resize (static_cast<std::size_t> (raw_sizes[task]));
+          range_coder.decodeStreamToIntVector (coded_stream, int_data[segment]);
+        }
+        else
+        {
+          char_data[task].resize (static_cast<std::size_t> (raw_sizes[task]));
+          range_coder.decodeStreamToCharVector (coded_stream, char_data[task]);
+        }
+      }
+
+      // concatenate the selected subtrees, skipped ones are removed from the root node
+      unsigned char root_mask = 0;
+      for (int segment = 0; segment < nr_segments; ++segment)
+        if (subtree_mask_arg & (1 << child_idx[segment]))
+          root_mask = static_cast<unsigned char> (root_mask | (1 << child_idx[segment]));
+      if (i_frame_)
+        tree_partially_decoded_ = (static_cast<unsigned char> (root_node_bits) & ~root_mask) != 0;
+      else
+        root_mask = 0xFF;
+
+      for (int stream = 0; stream < NR_SUBTREE_STREAMS; ++stream)
+      {
+        if (stream == POINT_COUNT_STREAM)
+          point_count_data_vector_.clear ();
+        else
+          getCharStream (stream).clear ();
+      }
+      binary_tree_data_vector_.push_back (static_cast<char> (root_node_bits & root_mask));
+
+      for (int segment = 0; segment < nr_segments; ++segment)
+      {
+        if (!(subtree_mask_arg & (1 << child_idx[segment])))
+          continue;
+        point_count_data_vector_.insert (point_count_data_vector_.end (), int_data[segment].begin (), int_data[segment].end ());
+        for (int stream = 0; stream < NR_SUBTREE_STREAMS; ++stream)
+        {
+          const std::vector<char>& data = char_data[segment * NR_SUBTREE_STREAMS + stream];
+          if (stream != POINT_COUNT_STREAM)
+            getCharStream (stream).insert (getCharStream (stream).end (), data.begin (), data.end ());
+        }
+      }
+      point_count_data_vector_iterator_ = point_count_data_vector_.begin ();
+    }
+
+    //////////////////////////////////////////////////////////////////////////////////////////////
+    template<typename PointT, typename LeafT, typename BranchT, typename OctreeT> unsigned char
+    OctreePointCloudCompression<PointT, LeafT, BranchT, OctreeT>::getSubtreeMask (const Eigen::Vector3d &min_pt_arg,
+                                                                                  const Eigen::Vector3d &max_pt_arg) const
+    {
+      // edge length of a top-level subtree
+      const double subtree_size = this->resolution_ * static_cast<double> (this->depth_mask_);
+
+      unsigned char subtree_mask = 0;
+      for (unsigned char child_idx = 0; child_idx < 8; ++child_idx)
+      {
+        const double min_x = this->min_x_ + ((child_idx & 4) ? subtree_size : 0.0);
+        const double min_y = this->min_y_ + ((child_idx & 2) ? subtree_size : 0.0);
+        const double min_z = this->min_z_ + ((child_idx & 1) ? subtree_size : 0.0);
+
+        if (min_x <= max_pt_arg.x () && min_x + subtree_size >= min_pt_arg.x () &&
+            min_y <= max_pt_arg.y () && min_y + subtree_size >= min_pt_arg.y () &&
+            min_z <= max_pt_arg.z () && min_z + subtree_size >= min_pt_arg.z ())
+          subtree_mask = static_cast<unsigned char> (subtree_mask | (1 << child_idx));
+      }
+      return (subtree_mask);
+    }
   }
 }
 
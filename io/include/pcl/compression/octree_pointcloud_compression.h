@@ -56,6 +56,10 @@
 #include <stdio.h>
 #include <string.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace pcl::octree;
 
 namespace pcl
@@ -125,7 +129,9 @@ namespace pcl
           compressed_point_data_len_ (), compressed_color_data_len_ (), selected_profile_(compressionProfile_arg),
           point_resolution_(pointResolution_arg), octree_resolution_(octreeResolution_arg),
           color_bit_resolution_(colorBitResolution_arg),
-          object_count_(0)
+          object_count_(0),
+          subtree_coding_ (false), subtree_coded_frame_ (false), tree_partially_decoded_ (false),
+          threads_ (1), subtree_segments_ (), last_leaf_tree_size_ (0)
         {
           initialization();
         }
@@ -212,8 +218,86 @@ namespace pcl
         void
         decodePointCloud (std::istream& compressed_tree_data_in_arg, PointCloudPtr &cloud_arg);
 
+        /** \brief Decode only the part of a point cloud around a region of interest from input stream
+          * \note Only intra frames encoded with subtree coding can be decoded partially: the top-level
+          * subtrees not overlapping the region are skipped, the decoded cloud may still contain points
+          * outside of it. Any other frame is decoded completely. Prediction frames following a partially
+          * decoded frame can not be reconstructed and are returned empty until the next intra frame.
+          * \param compressed_tree_data_in_arg: binary input stream containing compressed data
+          * \param cloud_arg: reference to decoded point cloud
+          * \param min_pt_arg: minimum corner of the region of interest
+          * \param max_pt_arg: maximum corner of the region of interest
+          */
+        void
+        decodePointCloud (std::istream& compressed_tree_data_in_arg, PointCloudPtr &cloud_arg,
+                          const Eigen::Vector3d &min_pt_arg, const Eigen::Vector3d &max_pt_arg);
+
+        /** \brief Enable/disable subtree coding. When enabled, the data of each of the (up to eight)
+          * top-level subtrees of the octree is range coded independently, in parallel, and indexed in
+          * the frame, which also allows decoding regions of interest.
+          * \param enable_arg: true to code top-level subtrees independently (default: false)
+          */
+        inline void
+        setSubtreeCoding (bool enable_arg)
+        {
+          subtree_coding_ = enable_arg;
+        }
+
+        /** \brief Get whether subtree coding is enabled. */
+        inline bool
+        getSubtreeCoding () const
+        {
+          return (subtree_coding_);
+        }
+
+        /** \brief Set the number of threads used to range code the subtrees.
+          * \param nr_threads the number of hardware threads to use (0 sets the value to the number of cores)
+          */
+        inline void
+        setNumberOfThreads (unsigned int nr_threads = 0)
+        {
+#ifdef _OPENMP
+          threads_ = nr_threads != 0 ? nr_threads : static_cast<unsigned int> (omp_get_num_procs ());
+#else
+          if (nr_threads != 1)
+            PCL_WARN ("[pcl::io::OctreePointCloudCompression::setNumberOfThreads] PCL was compiled without OpenMP, using a single thread.\n");
+          threads_ = 1;
+#endif
+        }
+
+        /** \brief Get the number of threads used to range code the subtrees. */
+        inline unsigned int
+        getNumberOfThreads () const
+        {
+          return (threads_);
+        }
+
       protected:
 
+        /** \brief Data vectors that are range coded, per subtree when subtree coding is enabled */
+        enum SubtreeStream
+        {
+          TREE_STREAM, POINT_COUNT_STREAM, POINT_DIFF_STREAM, COLOR_AVG_STREAM, COLOR_DIFF_STREAM,
+          NR_SUBTREE_STREAMS
+        };
+
+        /** \brief Offsets of the data of a top-level subtree in each of the data vectors */
+        struct SubtreeSegment
+        {
+          unsigned char child_idx;
+          uint64_t begin[NR_SUBTREE_STREAMS];
+        };
+
+        /** \brief Decode a frame, restricted to the subtrees overlapping a region of interest if given
+          * \param compressed_tree_data_in_arg: binary input stream containing compressed data
+          * \param cloud_arg: reference to decoded point cloud
+          * \param min_pt_arg: minimum corner of the region of interest or NULL
+          * \param max_pt_arg: maximum corner of the region of interest or NULL
+          */
+        void
+        decodeFrame (std::istream& compressed_tree_data_in_arg, PointCloudPtr &cloud_arg,
+                     const Eigen::Vector3d *min_pt_arg, const Eigen::Vector3d *max_pt_arg);
+
         /** \brief Write frame information to output stream
           * \param compressed_tree_data_out_arg: binary output stream
           */
@@ -244,6 +328,36 @@ namespace pcl
         void
         entropyDecoding (std::istream& compressed_tree_data_in_arg);
 
+        /** \brief Range code the data of each top-level subtree independently and output it with an index to binary stream
+          * \param compressed_tree_data_out_arg: binary output stream
+          */
+        void
+        subtreeEntropyEncoding (std::ostream& compressed_tree_data_out_arg);
+
+        /** \brief Decode the selected top-level subtrees of input binary stream to information vectors
+          * \param compressed_tree_data_in_arg: binary input stream
+          * \param subtree_mask_arg: bit mask of the top-level subtrees to decode
+          */
+        void
+        subtreeEntropyDecoding (std::istream& compressed_tree_data_in_arg, unsigned char subtree_mask_arg);
+
+        /** \brief Get the current size of each data vector coded in this frame, 0 for unused ones
+          * \param sizes_arg: output sizes, indexed by SubtreeStream
+          */
+        void
+        getStreamSizes (uint64_t sizes_arg[NR_SUBTREE_STREAMS]);
+
+        /** \brief Get the char data vector of a stream (all but POINT_COUNT_STREAM) */
+        std::vector<char>&
+        getCharStream (int stream_arg);
+
+        /** \brief Get the bit mask of the top-level subtrees overlapping a box
+          * \param min_pt_arg: minimum corner of the box
+          * \param max_pt_arg: maximum corner of the box
+          */
+        unsigned char
+        getSubtreeMask (const Eigen::Vector3d &min_pt_arg, const Eigen::Vector3d &max_pt_arg) const;
+
         /** \brief Encode leaf node information during serialization
           * \param leaf_arg: reference to new leaf node
           * \param key_arg: octree key of new leaf node
@@ -310,11 +424,24 @@ namespace pcl
 
         std::size_t object_count_;
 
+        // subtree coding
+        bool subtree_coding_;
+        bool subtree_coded_frame_;
+        bool tree_partially_decoded_;
+        unsigned int threads_;
+        std::vector<SubtreeSegment> subtree_segments_;
+        std::size_t last_leaf_tree_size_;
+
+        // frame header identifier of frames using subtree coding
+        static const char* subtree_frame_header_identifier_;
+
       };
 
     // define frame identifier
     template<typename PointT, typename LeafT, typename BranchT, typename OctreeT>
       const char* OctreePointCloudCompression<PointT, LeafT, BranchT, OctreeT>::frame_header_identifier_ = "<PCL-OCT-COMPRESSED>";
+    template<typename PointT, typename LeafT, typename BranchT, typename OctreeT>
+      const char* OctreePointCloudCompression<PointT, LeafT, BranchT, OctreeT>::subtree_frame_header_identifier_ = "<PCL-OCT-SUBTREES>";
   }
 
 }
@@ -52,6 +52,18 @@ namespace pcl
     class PCL_EXPORTS DeBayer
     {
       public:
+        DeBayer () : threads_ (1) {}
+
+        /** \brief Set the number of threads used to debayer bands of rows in parallel.
+          * \param[in] nr_threads the number of hardware threads to use (0 sets the value to the number of cores)
+          */
+        void
+        setNumberOfThreads (unsigned int nr_threads = 0);
+
+        /** \brief Get the number of threads used to debayer bands of rows in parallel. */
+        inline unsigned int
+        getNumberOfThreads () const { return (threads_); }
+
         // Debayering methods
         void
         debayerBilinear (
@@ -76,6 +88,9 @@ namespace pcl
             int bayer_line_step = 0,
             int bayer_line_step2 = 0,
             unsigned rgb_line_step = 0) const;
+
+      private:
+        unsigned int threads_;
     };
   }
 }
@@ -390,6 +390,225 @@ namespace pcl
                         fields_count * sizeof (uint8_t)], reinterpret_cast<char*> (&value), sizeof (uint8_t));
   }
 
+  namespace detail
+  {
+    /** \brief Convert a string the way copyStringValue does, for the values parseStringValue can't handle. */
+    template <typename Type> inline void
+    convertStringValue (const std::string &st, Type &value)
+    {
+      std::istringstream is (st);
+      is.imbue (std::locale::classic ());
+      if (!(is >> value))
+        value = static_cast<Type> (atof (st.c_str ()));
+    }
+
+    template <> inline void
+    convertStringValue<int8_t> (const std::string &st, int8_t &value)
+    {
+      int val;
+      convertStringValue<int> (st, val);
+      value = static_cast<int8_t> (val);
+    }
+
+    template <> inline void
+    convertStringValue<uint8_t> (const std::string &st, uint8_t &value)
+    {
+      int val;
+      convertStringValue<int> (st, val);
+      value = static_cast<uint8_t> (val);
+    }
+
+    /** \brief Parse [sign]digits[.digits][(e|E)[sign]digits] into a mantissa and a power of 10.
+      * \return false if the characters are not such a number, or if it has more than 19 significant digits
+      */
+    inline bool
+    parseDecimal (const char *begin, const char *end, bool &negative, uint64_t &mantissa, int &exponent)
+    {
+      const char *p = begin;
+      negative = false;
+      if (p != end && (*p == '-' || *p == '+'))
+        negative = (*p++ == '-');
+      mantissa = 0;
+      exponent = 0;
+      int digits = 0, significant_digits = 0;
+      for (; p != end && *p >= '0' && *p <= '9'; ++p, ++digits)
+      {
+        if (mantissa == 0 && *p == '0')
+          continue;
+        if (++significant_digits > 19)
+          return (false);
+        mantissa = mantissa * 10 + (*p - '0');
+      }
+      if (p != end && *p == '.')
+      {
+        for (++p; p != end && *p >= '0' && *p <= '9'; ++p, ++digits)
+        {
+          --exponent;
+          if (mantissa == 0 && *p == '0')
+            continue;
+          if (++significant_digits > 19)
+            return (false);
+          mantissa = mantissa * 10 + (*p - '0');
+        }
+      }
+      if (digits == 0)
+        return (false);
+      if (p != end && (*p == 'e' || *p == 'E'))
+      {
+        ++p;
+        bool negative_exponent = false;
+        if (p != end && (*p == '-' || *p == '+'))
+          negative_exponent = (*p++ == '-');
+        if (p == end)
+          return (false);
+        int e = 0;
+        for (; p != end && *p >= '0' && *p <= '9'; ++p)
+          if (e < 10000)
+            e = e * 10 + (*p - '0');
+        exponent += negative_exponent ? -e : e;
+      }
+      return (p == end);
+    }
+
+    /** \brief Parse a decimal integer that fits in a Type. */
+    template <typename Type> inline bool
+    parseInteger (const char *begin, const char *end, Type &value)
+    {
+      bool negative;
+      uint64_t mantissa;
+      int exponent;
+      if (!parseDecimal (begin, end, negative, mantissa, exponent) || exponent != 0)
+        return (false);
+      if (negative)
+      {
+        if (!std::numeric_limits<Type>::is_signed ||
+            mantissa > static_cast<uint64_t> (-static_cast<int64_t> (std::numeric_limits<Type>::min ())))
+          return (false);
+        value = static_cast<Type> (-static_cast<int64_t> (mantissa));
+      }
+      else
+      {
+        if (mantissa > static_cast<uint64_t> (std::numeric_limits<Type>::max ()))
+          return (false);
+        value = static_cast<Type> (mantissa);
+      }
+      return (true);
+    }
+
+    /** \brief Parse a floating point number when it can be rounded exactly with double arithmetic.
+      *
+      * A mantissa below 2^53 and a power of 10 up to 10^22 are both exact doubles, so
+      * their product or quotient is the correctly rounded value (Clinger's fast path).
+      */
+    inline bool
+    parseDouble (const char *begin, const char *end, double &value)
+    {
+      static const double powers[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                       1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+      bool negative;
+      uint64_t mantissa;
+      int exponent;
+      if (!parseDecimal (begin, end, negative, mantissa, exponent))
+        return (false);
+      if (mantissa == 0)
+        value = 0.0;
+      else if (mantissa <= (uint64_t (1) << 53) && exponent >= -22 && exponent <= 22)
+        value = exponent < 0 ? static_cast<double> (mantissa) / powers[-exponent]
+                             : static_cast<double> (mantissa) * powers[exponent];
+      else
+        return (false);
+      if (negative)
+        value = -value;
+      return (true);
+    }
+
+    /** \brief Parse a floating point number when it can be rounded exactly to a float.
+      *
+      * Small values use the float fast path. The others are rounded to a double first,
+      * which gives the same float unless the double falls exactly between two floats.
+      */
+    inline bool
+    parseFloat (const char *begin, const char *end, float &value)
+    {
+      static const float powers[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+      bool negative;
+      uint64_t mantissa;
+      int exponent;
+      if (!parseDecimal (begin, end, negative, mantissa, exponent))
+        return (false);
+      if (mantissa <= (uint64_t (1) << 24) && exponent >= -10 && exponent <= 10)
+      {
+        value = exponent < 0 ? static_cast<float> (mantissa) / powers[-exponent]
+                             : static_cast<float> (mantissa) * powers[exponent];
+        if (negative)
+          value = -value;
+        return (true);
+      }
+      double d;
+      if (!parseDouble (begin, end, d))
+        return (false);
+      if (d == 0.0)
+      {
+        value = static_cast<float> (d);
+        return (true);
+      }
+      if (std::abs (d) < std::numeric_limits<float>::min () || std::abs (d) > std::numeric_limits<float>::max ())
+        return (false);
+      uint64_t bits;
+      memcpy (&bits, &d, sizeof (double));
+      // 29 of the 52 bits of the double mantissa are dropped, a tie needs another rounding
+      if ((bits & 0x1FFFFFFF) == 0x10000000)
+        return (false);
+      value = static_cast<float> (d);
+      return (true);
+    }
+
+    template <typename Type> inline bool
+    parseNumber (const char *begin, const char *end, Type &value)
+    {
+      return (parseInteger<Type> (begin, end, value));
+    }
+
+    template <> inline bool
+    parseNumber<float> (const char *begin, const char *end, float &value)
+    {
+      return (parseFloat (begin, end, value));
+    }
+
+    template <> inline bool
+    parseNumber<double> (const char *begin, const char *end, double &value)
+    {
+      return (parseDouble (begin, end, value));
+    }
+  }
+
+  /** \brief Parse one single value of type T (uchar, char, uint, int, float, double, ...) from the characters [begin, end)
+    *
+    * Gives the same results as copyStringValue, without allocating or going
+    * through a std::istringstream for plain decimal numbers, and independently
+    * of the current locale. Other inputs fall back to copyStringValue's
+    * conversion.
+    *
+    * \param[in] begin the first character of the value
+    * \param[in] end the character following the last character of the value
+    * \param[out] value the converted value
+    * \return false if the value was "nan", true otherwise
+    */
+  template <typename Type> inline bool
+  parseStringValue (const char *begin, const char *end, Type &value)
+  {
+    if (detail::parseNumber<Type> (begin, end, value))
+      return (true);
+    const std::string st (begin, end);
+    if (boost::iequals (st, "nan"))
+    {
+      value = static_cast<Type> (std::numeric_limits<Type>::quiet_NaN ());
+      return (false);
+    }
+    detail::convertStringValue<Type> (st, value);
+    return (true);
+  }
+
   namespace io
   {
     /** \brief Load a file into a PointCloud2 according to extension.
@@ -46,6 +46,7 @@
 #include <pcl/point_cloud.h>
 #include <boost/asio.hpp>
 #include <string>
+#include <vector>
 
 #define HDL_Grabber_toRadians(x) ((x) * M_PI / 180.0)
 
@@ -165,12 +166,23 @@ namespace pcl
        */
       float getMaximumDistanceThreshold();
 
+      /** \brief When reading from a PCAP file, skip the delays recorded between
+        * packets and convert them as fast as the consumer keeps up. Useful for
+        * benchmarking. Has no effect when listening on the network.
+        * \param[in] enable true to replay as fast as possible (default: false)
+        */
+      void
+      setPlaybackAsFastAsPossible (bool enable);
+
     protected:
       static const int HDL_DATA_PORT = 2368;
       static const int HDL_NUM_ROT_ANGLES = 36001;
       static const int HDL_LASER_PER_FIRING = 32;
       static const int HDL_MAX_NUM_LASERS = 64;
       static const int HDL_FIRING_PER_PKT = 12;
+      static const int HDL_PACKET_SIZE = 1206;
+      static const int HDL_POINTS_PER_PKT = HDL_FIRING_PER_PKT * HDL_LASER_PER_FIRING;
+      static const size_t HDL_MAX_POOLED_PACKETS = 4096;
       static const boost::asio::ip::address HDL_DEFAULT_NETWORK_ADDRESS;
 
       enum HDLBlock
@@ -214,10 +226,57 @@ namespace pcl
           double cosVertOffsetCorrection;
       };
 
+      /** \brief Single precision copy of the laser corrections, with the
+        * azimuth correction stored as its cosine and sine.
+        */
+      struct HDLFloatCorrections
+      {
+          float cosAzimuthCorrection[HDL_MAX_NUM_LASERS];
+          float sinAzimuthCorrection[HDL_MAX_NUM_LASERS];
+          float distanceCorrection[HDL_MAX_NUM_LASERS];
+          float horizontalOffsetCorrection[HDL_MAX_NUM_LASERS];
+          float sinVertCorrection[HDL_MAX_NUM_LASERS];
+          float cosVertCorrection[HDL_MAX_NUM_LASERS];
+          float sinVertOffsetCorrection[HDL_MAX_NUM_LASERS];
+          float cosVertOffsetCorrection[HDL_MAX_NUM_LASERS];
+      };
+
+      /** \brief Converted returns of one packet; valid is 0 for returns outside the distance thresholds. */
+      struct HDLPacketPoints
+      {
+          float x[HDL_POINTS_PER_PKT];
+          float y[HDL_POINTS_PER_PKT];
+          float z[HDL_POINTS_PER_PKT];
+          float intensity[HDL_POINTS_PER_PKT];
+          unsigned char valid[HDL_POINTS_PER_PKT];
+          unsigned char laser[HDL_POINTS_PER_PKT];
+      };
+
+      /** \brief Convert all the returns of a packet with the current laser
+        * corrections and distance thresholds.
+        * \param[in] dataPacket the packet to convert
+        * \param[out] points the converted returns, in firing order
+        */
+      void
+      computePacketPoints (const HDLDataPacket *dataPacket, HDLPacketPoints &points) const;
+
+      /** \brief Refresh the single precision corrections used by computePacketPoints ()
+        * after laser_corrections_ changed.
+        */
+      void
+      updateFloatCorrections ();
+
+      HDLLaserCorrection laser_corrections_[HDL_MAX_NUM_LASERS];
+
     private:
-      static double *cos_lookup_table_;
-      static double *sin_lookup_table_;
+      static float *cos_lookup_table_;
+      static float *sin_lookup_table_;
       pcl::SynchronizedQueue<unsigned char *> hdl_data_;
+      /** \brief Every packet buffer ever allocated, and the ones currently free for reuse. */
+      std::vector<unsigned char *> packet_buffers_;
+      std::vector<unsigned char *> free_packet_buffers_;
+      boost::mutex packet_pool_mutex_;
+      boost::condition_variable packet_released_;
       boost::asio::ip::udp::endpoint udp_listener_endpoint_;
       boost::asio::ip::address source_address_filter_;
       unsigned short source_port_filter_;
@@ -226,7 +285,8 @@ namespace pcl
       std::string pcap_file_name_;
       boost::thread *queue_consumer_thread_;
       boost::thread *hdl_read_packet_thread_;
-      HDLLaserCorrection laser_corrections_[HDL_MAX_NUM_LASERS];
+      HDLFloatCorrections float_corrections_;
+      HDLPacketPoints packet_points_;
       bool terminate_read_packet_thread_;
       boost::shared_ptr<pcl::PointCloud<pcl::PointXYZ> > current_scan_xyz_,
           current_sweep_xyz_;
@@ -235,6 +295,7 @@ namespace pcl
       boost::shared_ptr<pcl::PointCloud<pcl::PointXYZRGBA> > current_scan_xyzrgb_,
           current_sweep_xyzrgb_;
       unsigned int last_azimuth_;
+      size_t last_sweep_size_;
       boost::signals2::signal<sig_cb_velodyne_hdl_sweep_point_cloud_xyz>* sweep_xyz_signal_;
       boost::signals2::signal<sig_cb_velodyne_hdl_sweep_point_cloud_xyzrgb>* sweep_xyzrgb_signal_;
       boost::signals2::signal<sig_cb_velodyne_hdl_sweep_point_cloud_xyzi>* sweep_xyzi_signal_;
@@ -244,10 +305,13 @@ namespace pcl
       pcl::RGB laser_rgb_mapping_[HDL_MAX_NUM_LASERS];
       float min_distance_threshold_;
       float max_distance_threshold_;
+      bool as_fast_as_possible_;
 
       void processVelodynePackets ();
       void enqueueHDLPacket (const unsigned char *data,
           std::size_t bytesReceived);
+      unsigned char *acquirePacketBuffer (bool wait);
+      void releasePacketBuffer (unsigned char *buffer);
       void initialize (const std::string& correctionsFile);
       void loadCorrectionsFile (const std::string& correctionsFile);
       void loadHDL32Corrections ();
@@ -256,11 +320,11 @@ namespace pcl
       void readPacketsFromPcap();
 #endif //#ifdef HAVE_PCAP
       void toPointClouds (HDLDataPacket *dataPacket);
+      template <typename CloudT> void
+      prepareCloud (boost::shared_ptr<CloudT> &cloud, size_t expected_size);
       void fireCurrentSweep ();
       void fireCurrentScan (const unsigned short startAngle,
           const unsigned short endAngle);
-      void computeXYZI (pcl::PointXYZI& pointXYZI, int azimuth,
-          HDLLaserReturn laserReturn, HDLLaserCorrection correction);
       bool isAddressUnspecified (const boost::asio::ip::address& ip_address);
   };
 }
@@ -190,6 +190,24 @@ namespace pcl
     void
     setNumberOfThreads (unsigned int nr_threads = 0);
 
+    /** \brief Load the frames in background threads, ahead of their publication.
+     * \param[in] max_frames number of frames kept loaded ahead of the published one, 0 to
+     * load each frame right after the previous one is published (default)
+     * \param[in] nr_threads number of threads loading frames in parallel
+     * \note Enabling read-ahead rewinds the grabber to the first frame.
+     */
+    void
+    setReadAhead (size_t max_frames, unsigned int nr_threads = 1);
+
+    /** \brief Publish the frames back to back, as soon as they are loaded, regardless of
+     * frames_per_second. start () then plays the frames in a background thread until they
+     * are exhausted (isRunning () turns false) or stop () is called. Meant for offline
+     * batch processing, best combined with setReadAhead ().
+     * \param[in] enable whether to play as fast as possible
+     */
+    void
+    setPlaybackAsFastAsPossible (bool enable);
+
     protected:
     /** \brief Convenience function to see how many frames this consists of
       */
@@ -230,8 +248,8 @@ namespace pcl
                   float frames_per_second = 0, 
                   bool repeat = false);
       
-    /** \brief Empty destructor */
-    virtual ~ImageGrabber () throw () {}
+    /** \brief Destructor. Stops the playback before the members used by publish () go away. */
+    virtual ~ImageGrabber () throw () { stop (); }
     
     // Inherited from FileGrabber
     const boost::shared_ptr< const pcl::PointCloud<PointT> >
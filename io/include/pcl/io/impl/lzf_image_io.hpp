@@ -40,6 +40,7 @@
 
 #include <pcl/console/print.h>
 #include <pcl/io/debayer.h>
+#include <algorithm>
 
 #define CLIP_CHAR(c) static_cast<unsigned char> ((c)>255?255:(c)<0?0:(c))
 
@@ -325,21 +326,19 @@ pcl::io::LZFYUV422ImageReader::read (
   unsigned char *color_y = reinterpret_cast<unsigned char*> (&uncompressed_data[wh2]);
   unsigned char *color_v = reinterpret_cast<unsigned char*> (&uncompressed_data[wh2 + getWidth () * getHeight ()]);
   
-  register int y_idx = 0;
-  for (int i = 0; i < wh2; ++i, y_idx += 2)
+  // Convert in blocks small enough to stay in cache, then scatter into the points
+  unsigned char color_r[2 * CONVERSION_BLOCK_SIZE], color_g[2 * CONVERSION_BLOCK_SIZE], color_b[2 * CONVERSION_BLOCK_SIZE];
+  for (int start = 0; start < wh2; start += CONVERSION_BLOCK_SIZE)
   {
-    int v = color_v[i] - 128;
-    int u = color_u[i] - 128;
-
-    PointT &pt1 = cloud.points[y_idx + 0];
-    pt1.r =  CLIP_CHAR (color_y[y_idx + 0] + ((v * 18678 + 8192 ) >> 14));
-    pt1.g =  CLIP_CHAR (color_y[y_idx + 0] + ((v * -9519 - u * 6472 + 8192) >> 14));
-    pt1.b =  CLIP_CHAR (color_y[y_idx + 0] + ((u * 33292 + 8192 ) >> 14));
-
-    PointT &pt2 = cloud.points[y_idx + 1];
-    pt2.r =  CLIP_CHAR (color_y[y_idx + 1] + ((v * 18678 + 8192 ) >> 14));
-    pt2.g =  CLIP_CHAR (color_y[y_idx + 1] + ((v * -9519 - u * 6472 + 8192) >> 14));
-    pt2.b =  CLIP_CHAR (color_y[y_idx + 1] + ((u * 33292 + 8192 ) >> 14));
+    int nr_pairs = std::min (CONVERSION_BLOCK_SIZE, wh2 - start);
+    convertToRGB (color_u + start, color_y + 2 * start, color_v + start, color_r, color_g, color_b, nr_pairs);
+    for (int j = 0; j < 2 * nr_pairs; ++j)
+    {
+      PointT &pt = cloud.points[2 * start + j];
+      pt.r = color_r[j];
+      pt.g = color_g[j];
+      pt.b = color_b[j];
+    }
   }
 
   return (true);
@@ -383,24 +382,23 @@ pcl::io::LZFYUV422ImageReader::readOMP (
   unsigned char *color_y = reinterpret_cast<unsigned char*> (&uncompressed_data[wh2]);
   unsigned char *color_v = reinterpret_cast<unsigned char*> (&uncompressed_data[wh2 + getWidth () * getHeight ()]);
   
+  int nr_blocks = (wh2 + CONVERSION_BLOCK_SIZE - 1) / CONVERSION_BLOCK_SIZE;
 #ifdef _OPENMP
 #pragma omp parallel for num_threads (num_threads)
 #endif//_OPENMP
-  for (int i = 0; i < wh2; ++i)
+  for (int block = 0; block < nr_blocks; ++block)
   {
-    int y_idx = 2*i;
-    int v = color_v[i] - 128;
-    int u = color_u[i] - 128;
-
-    PointT &pt1 = cloud.points[y_idx + 0];
-    pt1.r =  CLIP_CHAR (color_y[y_idx + 0] + ((v * 18678 + 8192 ) >> 14));
-    pt1.g =  CLIP_CHAR (color_y[y_idx + 0] + ((v * -9519 - u * 6472 + 8192) >> 14));
-    pt1.b =  CLIP_CHAR (color_y[y_idx + 0] + ((u * 33292 + 8192 ) >> 14));
-
-    PointT &pt2 = cloud.points[y_idx + 1];
-    pt2.r =  CLIP_CHAR (color_y[y_idx + 1] + ((v * 18678 + 8192 ) >> 14));
-    pt2.g =  CLIP_CHAR (color_y[y_idx + 1] + ((v * -9519 - u * 6472 + 8192) >> 14));
-    pt2.b =  CLIP_CHAR (color_y[y_idx + 1] + ((u * 33292 + 8192 ) >> 14));
+    unsigned char color_r[2 * CONVERSION_BLOCK_SIZE], color_g[2 * CONVERSION_BLOCK_SIZE], color_b[2 * CONVERSION_BLOCK_SIZE];
+    int start = block * CONVERSION_BLOCK_SIZE;
+    int nr_pairs = std::min (CONVERSION_BLOCK_SIZE, wh2 - start);
+    convertToRGB (color_u + start, color_y + 2 * start, color_v + start, color_r, color_g, color_b, nr_pairs);
+    for (int j = 0; j < 2 * nr_pairs; ++j)
+    {
+      PointT &pt = cloud.points[2 * start + j];
+      pt.r = color_r[j];
+      pt.g = color_g[j];
+      pt.b = color_b[j];
+    }
   }
 
   return (true);
@@ -487,6 +485,7 @@ pcl::io::LZFBayer8ImageReader::readOMP (
   // Convert Bayer8 to RGB24
   std::vector<unsigned char> rgb_buffer (getWidth () * getHeight () * 3);
   pcl::io::DeBayer i;
+  i.setNumberOfThreads (num_threads);
   i.debayerEdgeAware (reinterpret_cast<unsigned char*> (&uncompressed_data[0]), 
                      static_cast<unsigned char*> (&rgb_buffer[0]), 
                      getWidth (), getHeight ());
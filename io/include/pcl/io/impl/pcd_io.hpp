@@ -455,6 +455,17 @@ pcl::PCDWriter::writeBinaryCompressed (const std::string &file_name,
   return (0);
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> int
+pcl::PCDWriter::writeBinaryCompressedChunked (const std::string &file_name,
+                                              const pcl::PointCloud<PointT> &cloud,
+                                              unsigned int chunk_size)
+{
+  pcl::PCLPointCloud2 blob;
+  pcl::toPCLPointCloud2 (cloud, blob);
+  return (writeBinaryCompressedChunked (file_name, blob, cloud.sensor_origin_, cloud.sensor_orientation_, chunk_size));
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 template <typename PointT> int
 pcl::PCDWriter::writeASCII (const std::string &file_name, const pcl::PointCloud<PointT> &cloud, 
@@ -917,5 +928,35 @@ pcl::PCDWriter::writeASCII (const std::string &file_name,
   return (0);
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> int
+pcl::PCDStreamReader::readNext (unsigned int nr_points, pcl::PointCloud<PointT> &cloud)
+{
+  pcl::PCLPointCloud2 blob;
+  int res = readNext (nr_points, blob);
+  if (res >= 0)
+    pcl::fromPCLPointCloud2 (blob, cloud);
+  return (res);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> int
+pcl::PCDStreamWriter::open (const std::string &file_name,
+                            const Eigen::Vector4f &origin, const Eigen::Quaternionf &orientation)
+{
+  pcl::PCLPointCloud2 blob;
+  pcl::toPCLPointCloud2 (pcl::PointCloud<PointT> (), blob);
+  return (open (file_name, blob, origin, orientation));
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> int
+pcl::PCDStreamWriter::append (const pcl::PointCloud<PointT> &cloud)
+{
+  pcl::PCLPointCloud2 blob;
+  pcl::toPCLPointCloud2 (cloud, blob);
+  return (append (blob));
+}
+
 #endif  //#ifndef PCL_IO_PCD_IO_H_
 
@@ -0,0 +1,183 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2014-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef PCL_IO_READ_AHEAD_QUEUE_H_
+#define PCL_IO_READ_AHEAD_QUEUE_H_
+
+#include <pcl/io/boost.h>
+#include <pcl/io/impl/synchronized_queue.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace pcl
+{
+  /** \brief Loads the frames of a recorded sequence ahead of their use.
+    *
+    * Frames are loaded by several threads, thread t loading frames t, t + N,
+    * t + 2N, ... into its own bounded SynchronizedQueue, so that dequeue ()
+    * returns them in sequence order by visiting the queues in turn. Loader
+    * threads block once the queues hold the requested number of frames.
+    */
+  template <typename FrameT>
+  class ReadAheadQueue
+  {
+    public:
+      /** \brief Loads the frame at a given index, returns false if it could not be read. */
+      typedef boost::function<bool (size_t, FrameT&)> LoadFunction;
+
+      ReadAheadQueue () :
+        load_ (), queues_ (), threads_ (), first_ (0), nr_frames_ (0), repeat_ (false), next_ (0) { }
+
+      ~ReadAheadQueue ()
+      {
+        stop ();
+      }
+
+      /** \brief Start loading frames, any previous loading being stopped first.
+        * \param[in] load the function loading one frame
+        * \param[in] first index of the first frame to load
+        * \param[in] nr_frames number of frames in the sequence
+        * \param[in] repeat whether to start over from frame 0 after the last one
+        * \param[in] nr_threads number of loader threads
+        * \param[in] max_frames number of frames loaded ahead of dequeue ()
+        */
+      void
+      start (const LoadFunction &load, size_t first, size_t nr_frames, bool repeat,
+             unsigned int nr_threads, size_t max_frames)
+      {
+        stop ();
+        if (nr_frames == 0 || max_frames == 0)
+          return;
+
+        nr_threads = std::max (nr_threads, 1u);
+        load_ = load;
+        first_ = first % nr_frames;
+        nr_frames_ = nr_frames;
+        repeat_ = repeat;
+        next_ = 0;
+
+        const size_t queue_size = std::max<size_t> ((max_frames + nr_threads - 1) / nr_threads, 1);
+        for (unsigned int t = 0; t < nr_threads; ++t)
+          queues_.push_back (boost::shared_ptr<Queue> (new Queue (queue_size)));
+        for (unsigned int t = 0; t < nr_threads; ++t)
+          threads_.push_back (boost::shared_ptr<boost::thread> (
+                new boost::thread (boost::bind (&ReadAheadQueue::loadFrames, this, t))));
+      }
+
+      /** \brief Stop the loader threads and drop the frames not dequeued yet. */
+      void
+      stop ()
+      {
+        for (size_t t = 0; t < queues_.size (); ++t)
+          queues_[t]->stopQueue ();
+        for (size_t t = 0; t < threads_.size (); ++t)
+          threads_[t]->join ();
+        threads_.clear ();
+        queues_.clear ();
+        nr_frames_ = 0;
+      }
+
+      /** \brief Whether loading was started and frames remain to be dequeued. */
+      bool
+      hasNext () const
+      {
+        return (!queues_.empty () && (repeat_ || next_ < nr_frames_ - first_));
+      }
+
+      /** \brief Get the next frame of the sequence, waiting for it to be loaded.
+        * Frames that could not be loaded are skipped.
+        * \param[out] index the index of the frame
+        * \param[out] frame the frame
+        * \return false if there are no frames left
+        */
+      bool
+      dequeue (size_t &index, FrameT &frame)
+      {
+        while (hasNext ())
+        {
+          Slot slot;
+          if (!queues_[next_ % queues_.size ()]->dequeue (slot))
+            return (false);
+          ++next_;
+          if (slot.valid)
+          {
+            index = slot.index;
+            frame = slot.frame;
+            return (true);
+          }
+        }
+        return (false);
+      }
+
+    private:
+      struct Slot
+      {
+        Slot () : index (0), valid (false), frame () {}
+        size_t index;
+        bool valid;
+        FrameT frame;
+      };
+      typedef SynchronizedQueue<Slot> Queue;
+
+      void
+      loadFrames (unsigned int thread_index)
+      {
+        Queue &queue = *queues_[thread_index];
+        const size_t step = queues_.size ();
+        for (size_t seq = thread_index; repeat_ || seq < nr_frames_ - first_; seq += step)
+        {
+          Slot slot;
+          slot.index = (first_ + seq) % nr_frames_;
+          slot.valid = load_ (slot.index, slot.frame);
+          queue.enqueue (slot);
+          if (queue.isStopped ())
+            return;
+        }
+      }
+
+      LoadFunction load_;
+      std::vector<boost::shared_ptr<Queue> > queues_;
+      std::vector<boost::shared_ptr<boost::thread> > threads_;
+      size_t first_;
+      size_t nr_frames_;
+      bool repeat_;
+      size_t next_;
+  };
+}
+
+#endif  // PCL_IO_READ_AHEAD_QUEUE_H_
@@ -52,14 +52,22 @@ namespace pcl
   {
     public:
 
-      SynchronizedQueue () :
-        queue_(), mutex_(), cond_(), request_to_end_(false), enqueue_data_(true) { }
+      /** \param[in] max_size number of elements after which enqueue () blocks
+        * until one is dequeued, 0 for an unbounded queue
+        */
+      explicit SynchronizedQueue (size_t max_size = 0) :
+        queue_(), mutex_(), cond_(), not_full_cond_(), max_size_(max_size), request_to_end_(false), enqueue_data_(true) { }
 
       void
       enqueue (const T& data)
       {
         boost::unique_lock<boost::mutex> lock (mutex_);
 
+        while (max_size_ > 0 && queue_.size () >= max_size_ && (!request_to_end_))
+        {
+          not_full_cond_.wait (lock);
+        }
+
         if (enqueue_data_)
         {
           queue_.push (data);
@@ -85,6 +93,7 @@ namespace pcl
 
         result = queue_.front ();
         queue_.pop ();
+        not_full_cond_.notify_one ();
 
         return true;
       }
@@ -94,7 +103,16 @@ namespace pcl
       {
         boost::unique_lock<boost::mutex> lock (mutex_);
         request_to_end_ = true;
-        cond_.notify_one ();
+        cond_.notify_all ();
+        not_full_cond_.notify_all ();
+      }
+
+      /** \return true once stopQueue () was called; enqueue () then no longer blocks */
+      bool
+      isStopped () const
+      {
+        boost::unique_lock<boost::mutex> lock (mutex_);
+        return (request_to_end_);
       }
 
       unsigned int
@@ -126,6 +144,8 @@ namespace pcl
       std::queue<T> queue_;              // Use STL queue to store data
       mutable boost::mutex mutex_;       // The mutex to synchronise on
       boost::condition_variable cond_;   // The condition to wait for
+      boost::condition_variable not_full_cond_; // The condition bounded producers wait for
+      size_t max_size_;                  // Maximum number of queued elements, 0 if unbounded
 
       bool request_to_end_;
       bool enqueue_data_;
@@ -311,6 +311,24 @@ namespace pcl
         template <typename PointT> bool
         readOMP (const std::string &filename, pcl::PointCloud<PointT> &cloud, 
                  unsigned int num_threads=0);
+
+      protected:
+        /** \brief Number of pixel pairs converted at once by read and readOMP. */
+        static const int CONVERSION_BLOCK_SIZE = 512;
+
+        /** \brief Convert pairs of YUV422 pixels to planar RGB (using SSE2 where available).
+          * \param[in] color_u the U plane, one value per pixel pair
+          * \param[in] color_y the Y plane, one value per pixel
+          * \param[in] color_v the V plane, one value per pixel pair
+          * \param[out] color_r the red value of each pixel
+          * \param[out] color_g the green value of each pixel
+          * \param[out] color_b the blue value of each pixel
+          * \param[in] nr_pixel_pairs the number of pixel pairs to convert
+          */
+        static void
+        convertToRGB (const unsigned char *color_u, const unsigned char *color_y, const unsigned char *color_v,
+                      unsigned char *color_r, unsigned char *color_g, unsigned char *color_b,
+                      int nr_pixel_pairs);
     };
 
     /** \brief PCL-LZF 8-bit Bayer image format reader.
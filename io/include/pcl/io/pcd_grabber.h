@@ -130,6 +130,24 @@ namespace pcl
       /** \brief Returns whether the repeat flag is on */
       bool 
       isRepeatOn () const;
+
+      /** \brief Load the clouds in background threads, ahead of their publication.
+        * \param[in] max_frames number of clouds kept loaded ahead of the published one, 0 to
+        * load each cloud right after the previous one is published (default)
+        * \param[in] nr_threads number of threads loading clouds in parallel
+        * \note Enabling read-ahead rewinds the grabber to the first cloud.
+        */
+      void
+      setReadAhead (size_t max_frames, unsigned int nr_threads = 1);
+
+      /** \brief Publish the clouds back to back, as soon as they are loaded, regardless of
+        * frames_per_second. start () then plays the clouds in a background thread until they
+        * are exhausted (isRunning () turns false) or stop () is called. Meant for offline
+        * batch processing, best combined with setReadAhead ().
+        * \param[in] enable whether to play as fast as possible
+        */
+      void
+      setPlaybackAsFastAsPossible (bool enable);
   
       /** \brief Get cloud (in ROS form) at a particular location */
       bool
@@ -159,8 +177,8 @@ namespace pcl
       PCDGrabber (const std::string& pcd_path, float frames_per_second = 0, bool repeat = false);
       PCDGrabber (const std::vector<std::string>& pcd_files, float frames_per_second = 0, bool repeat = false);
       
-      /** \brief Virtual destructor. */
-      virtual ~PCDGrabber () throw () {}
+      /** \brief Virtual destructor. Stops the playback before the members used by publish () go away. */
+      virtual ~PCDGrabber () throw () { stop (); }
     
       // Inherited from FileGrabber
       const boost::shared_ptr< const pcl::PointCloud<PointT> >
@@ -42,6 +42,11 @@
 
 #include <pcl/point_cloud.h>
 #include <pcl/io/file_io.h>
+#include <fstream>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace pcl
 {
@@ -52,8 +57,8 @@ namespace pcl
   class PCL_EXPORTS PCDReader : public FileReader
   {
     public:
-      /** Empty constructor */
-      PCDReader () : FileReader () {}
+      /** \brief Constructor, using all the available threads (see setNumberOfThreads). */
+      PCDReader () : FileReader (), threads_ (1) { setNumberOfThreads (); }
       /** Empty destructor */
       ~PCDReader () {}
 
@@ -77,6 +82,15 @@ namespace pcl
         * addon: it adds sensor origin/orientation (aka viewpoint) information
         * to a dataset through the use of a new header field:
         *   - VIEWPOINT tx ty tz qw qx qy qz
+        *
+        * PCD_V7 files can also store their data as \b binary_compressed, a
+        * single LZF block, or as \b binary_compressed_chunked, where the
+        * points are split in chunks and each field of each chunk is an
+        * independent LZF block. The chunked data starts with its index: the
+        * number of chunks and the number of points per chunk (two unsigned
+        * 32 bit integers), followed by the compressed size of every block,
+        * chunk by chunk. A block whose compressed size equals its
+        * uncompressed size is stored as is.
         */
       enum
       {
@@ -98,7 +112,7 @@ namespace pcl
         * \param[out] origin the sensor acquisition origin (only for > PCD_V7 - null if not present)
         * \param[out] orientation the sensor acquisition orientation (only for > PCD_V7 - identity if not present)
         * \param[out] pcd_version the PCD version of the file (i.e., PCD_V6, PCD_V7)
-        * \param[out] data_type the type of data (0 = ASCII, 1 = Binary, 2 = Binary compressed) 
+        * \param[out] data_type the type of data (0 = ASCII, 1 = Binary, 2 = Binary compressed, 3 = Binary compressed chunked)
         * \param[out] data_idx the offset of cloud data within the file
         * \param[in] offset the offset of where to expect the PCD Header in the
         * file (optional parameter). One usage example for setting the offset
@@ -214,7 +228,80 @@ namespace pcl
         return (res);
       }
 
+      /** \brief Read a range of points, and optionally only some of their fields, from a PCD file.
+        *
+        * For binary_compressed_chunked files only the chunks overlapping the
+        * range are read and only the blocks of the requested fields are
+        * decompressed. The other formats are read entirely and then cropped.
+        *
+        * \param[in] file_name the name of the file containing the actual PointCloud data
+        * \param[out] cloud the resultant unorganized cloud, holding \a nr_points points
+        * \param[in] first_point the index of the first point to read
+        * \param[in] nr_points the number of points to read
+        * \param[in] field_names the names of the fields to read (all of them if empty)
+        * \param[in] offset the offset of where to expect the PCD Header in the file (see \ref read)
+        *
+        * \return
+        *  * < 0 (-1) on error
+        *  * == 0 on success
+        */
+      int
+      readRange (const std::string &file_name, pcl::PCLPointCloud2 &cloud,
+                 unsigned int first_point, unsigned int nr_points,
+                 const std::vector<std::string> &field_names = std::vector<std::string> (),
+                 const int offset = 0);
+
+      /** \brief Set the number of threads used to parse ASCII files and to decompress the chunks of binary_compressed_chunked files.
+        * Small files use fewer threads, one per 64 KB of ASCII data or per chunk. The default is automatic,
+        * so that loadPCDFile parses large files in parallel.
+        * \param[in] nr_threads the number of hardware threads to use (0 sets the value back to automatic)
+        */
+      inline void
+      setNumberOfThreads (unsigned int nr_threads = 0)
+      {
+#ifdef _OPENMP
+        threads_ = nr_threads != 0 ? nr_threads : static_cast<unsigned int> (omp_get_num_procs ());
+#else
+        if (nr_threads > 1)
+          PCL_WARN ("[pcl::PCDReader::setNumberOfThreads] PCL was compiled without OpenMP, using a single thread.\n");
+        threads_ = 1;
+#endif
+      }
+
+      /** \brief Get the number of threads used to parse ASCII files and to decompress the chunks of binary_compressed_chunked files. */
+      inline unsigned int
+      getNumberOfThreads () const { return (threads_); }
+
       EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    protected:
+      /** \brief Read a point cloud data header from a PCD file (see \ref readHeader).
+        * \param[in] allocate_data whether to resize cloud.data to hold all the points
+        */
+      int
+      readHeader (const std::string &file_name, pcl::PCLPointCloud2 &cloud,
+                  Eigen::Vector4f &origin, Eigen::Quaternionf &orientation, int &pcd_version,
+                  int &data_type, unsigned int &data_idx, const int offset, bool allocate_data);
+
+      /** \brief Read the points [first_point, first_point + nr_points) of a binary_compressed_chunked file.
+        * \param[in] file_name the name of the file
+        * \param[in] data_idx the offset of the chunk index within the file
+        * \param[in,out] cloud the cloud holding the header of the file, which receives the data
+        * \param[in] first_point the index of the first point to read
+        * \param[in] nr_points the number of points to read
+        * \param[in] field_indices the indices in cloud.fields of the fields to read
+        * \return 0 on success, -1 on error
+        */
+      int
+      readBinaryCompressedChunked (const std::string &file_name, unsigned int data_idx,
+                                   pcl::PCLPointCloud2 &cloud,
+                                   unsigned int first_point, unsigned int nr_points,
+                                   const std::vector<int> &field_indices);
+
+      /** \brief The number of threads used to parse ASCII data and to decompress the chunks. */
+      unsigned int threads_;
+
+      friend class PCDStreamReader;
   };
 
   /** \brief Point Cloud Data (PCD) file format writer.
@@ -224,7 +311,8 @@ namespace pcl
   class PCL_EXPORTS PCDWriter : public FileWriter
   {
     public:
-      PCDWriter() : FileWriter(), map_synchronization_(false) {}
+      /** \brief Constructor, using all the available threads (see setNumberOfThreads). */
+      PCDWriter() : FileWriter(), map_synchronization_(false), threads_ (1) { setNumberOfThreads (); }
       ~PCDWriter() {}
 
       /** \brief Set whether mmap() synchornization via msync() is desired before munmap() calls. 
@@ -241,6 +329,26 @@ namespace pcl
         map_synchronization_ = sync;
       }
 
+      /** \brief Set the number of threads used to compress the chunks of binary_compressed_chunked files.
+        * Small files use fewer threads, one per chunk. The default is automatic, as for PCDReader.
+        * \param[in] nr_threads the number of hardware threads to use (0 sets the value back to automatic)
+        */
+      inline void
+      setNumberOfThreads (unsigned int nr_threads = 0)
+      {
+#ifdef _OPENMP
+        threads_ = nr_threads != 0 ? nr_threads : static_cast<unsigned int> (omp_get_num_procs ());
+#else
+        if (nr_threads > 1)
+          PCL_WARN ("[pcl::PCDWriter::setNumberOfThreads] PCL was compiled without OpenMP, using a single thread.\n");
+        threads_ = 1;
+#endif
+      }
+
+      /** \brief Get the number of threads used to compress the chunks of binary_compressed_chunked files. */
+      inline unsigned int
+      getNumberOfThreads () const { return (threads_); }
+
       /** \brief Generate the header of a PCD file format
         * \param[in] cloud the point cloud data message
         * \param[in] origin the sensor acquisition origin
@@ -324,6 +432,26 @@ namespace pcl
                              const Eigen::Vector4f &origin = Eigen::Vector4f::Zero (), 
                              const Eigen::Quaternionf &orientation = Eigen::Quaternionf::Identity ());
 
+      /** \brief Save point cloud data to a PCD file containing n-D points, in BINARY_COMPRESSED_CHUNKED format
+        *
+        * The points are split in chunks of \a chunk_size points, and each
+        * field of each chunk is compressed independently, so that the chunks
+        * can be compressed and decompressed in parallel, and a range of
+        * points or a subset of the fields can be read without decompressing
+        * the whole file (see PCDReader::readRange).
+        *
+        * \param[in] file_name the output file name
+        * \param[in] cloud the point cloud data message
+        * \param[in] origin the sensor acquisition origin
+        * \param[in] orientation the sensor acquisition orientation
+        * \param[in] chunk_size the number of points per chunk
+        */
+      int
+      writeBinaryCompressedChunked (const std::string &file_name, const pcl::PCLPointCloud2 &cloud,
+                                    const Eigen::Vector4f &origin = Eigen::Vector4f::Zero (),
+                                    const Eigen::Quaternionf &orientation = Eigen::Quaternionf::Identity (),
+                                    unsigned int chunk_size = 65536);
+
       /** \brief Save point cloud data to a PCD file containing n-D points
         * \param[in] file_name the output file name
         * \param[in] cloud the point cloud data message
@@ -393,6 +521,16 @@ namespace pcl
       writeBinaryCompressed (const std::string &file_name, 
                              const pcl::PointCloud<PointT> &cloud);
 
+      /** \brief Save point cloud data to a chunked binary compressed PCD file
+        * \param[in] file_name the output file name
+        * \param[in] cloud the point cloud data message
+        * \param[in] chunk_size the number of points per chunk
+        */
+      template <typename PointT> int
+      writeBinaryCompressedChunked (const std::string &file_name,
+                                    const pcl::PointCloud<PointT> &cloud,
+                                    unsigned int chunk_size = 65536);
+
       /** \brief Save point cloud data to a PCD file containing n-D points, in BINARY format
         * \param[in] file_name the output file name
         * \param[in] cloud the point cloud data message
@@ -495,6 +633,227 @@ namespace pcl
     private:
       /** \brief Set to true if msync() should be called before munmap(). Prevents data loss on NFS systems. */
       bool map_synchronization_;
+
+      /** \brief The number of threads used to compress the chunks. */
+      unsigned int threads_;
+
+      friend class PCDStreamWriter;
+  };
+
+  /** \brief Point Cloud Data (PCD) file format reader, reading the points in pieces.
+    *
+    * Only the points returned by the last call to readNext are held in
+    * memory, so that clouds larger than the available memory can be
+    * processed. This holds for ASCII, binary and binary_compressed_chunked
+    * files; binary_compressed files are a single compressed block, which is
+    * decompressed entirely when the file is opened.
+    *
+    * \code
+    * pcl::PCDStreamReader reader;
+    * pcl::PointCloud<pcl::PointXYZ> cloud;
+    * reader.open ("huge.pcd");
+    * while (reader.readNext (1000000, cloud) > 0)
+    *   process (cloud);
+    * \endcode
+    * \ingroup io
+    */
+  class PCL_EXPORTS PCDStreamReader
+  {
+    public:
+      PCDStreamReader ();
+      ~PCDStreamReader () {}
+
+      /** \brief Open a PCD file and read its header.
+        * \param[in] file_name the name of the file to read
+        * \param[in] offset the offset of where to expect the PCD Header in the file (see PCDReader::read)
+        * \return 0 on success, -1 on error
+        */
+      int
+      open (const std::string &file_name, const int offset = 0);
+
+      /** \brief Close the file. */
+      void
+      close ();
+
+      /** \brief Check whether a file is open. */
+      inline bool
+      isOpen () const { return (fs_.is_open ()); }
+
+      /** \brief Get the header of the file: the fields, width and height of the cloud, without any data. */
+      inline const pcl::PCLPointCloud2&
+      getHeader () const { return (header_); }
+
+      /** \brief Get the sensor acquisition origin of the file. */
+      inline const Eigen::Vector4f&
+      getOrigin () const { return (origin_); }
+
+      /** \brief Get the sensor acquisition orientation of the file. */
+      inline const Eigen::Quaternionf&
+      getOrientation () const { return (orientation_); }
+
+      /** \brief Get the number of points of the file. */
+      inline unsigned int
+      getNumberOfPoints () const { return (header_.width * header_.height); }
+
+      /** \brief Get the number of points read so far. */
+      inline unsigned int
+      getNumberOfPointsRead () const { return (position_); }
+
+      /** \brief Read the next points of the file.
+        * \param[in] nr_points the maximum number of points to read
+        * \param[out] cloud the resultant unorganized cloud, holding the points read
+        * \return the number of points read, 0 at the end of the file, -1 on error
+        */
+      int
+      readNext (unsigned int nr_points, pcl::PCLPointCloud2 &cloud);
+
+      /** \brief Read the next points of the file into a templated PointCloud type.
+        * \param[in] nr_points the maximum number of points to read
+        * \param[out] cloud the resultant unorganized cloud, holding the points read
+        * \return the number of points read, 0 at the end of the file, -1 on error
+        */
+      template <typename PointT> int
+      readNext (unsigned int nr_points, pcl::PointCloud<PointT> &cloud);
+
+      EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    private:
+      /** \brief Read and decompress the next chunk of a binary_compressed_chunked file into chunk_. */
+      int
+      readChunk ();
+
+      /** \brief The name of the file being read. */
+      std::string file_name_;
+
+      /** \brief The file being read, positioned at the next points (or chunk) to read. */
+      std::ifstream fs_;
+
+      /** \brief The header of the file. */
+      pcl::PCLPointCloud2 header_;
+
+      /** \brief The sensor acquisition origin of the file. */
+      Eigen::Vector4f origin_;
+
+      /** \brief The sensor acquisition orientation of the file. */
+      Eigen::Quaternionf orientation_;
+
+      /** \brief The type of data of the file (see PCDReader::readHeader). */
+      int data_type_;
+
+      /** \brief The number of points read so far. */
+      unsigned int position_;
+
+      /** \brief The number of points per chunk of binary_compressed_chunked files. */
+      unsigned int chunk_size_;
+
+      /** \brief The compressed size of the blocks of binary_compressed_chunked files. */
+      std::vector<unsigned int> block_sizes_;
+
+      /** \brief The index of the next chunk to read. */
+      unsigned int next_chunk_;
+
+      /** \brief The points of the last chunk read (all the points of binary_compressed files), and the number of them already returned. */
+      std::vector<pcl::uint8_t> chunk_;
+      unsigned int chunk_position_;
+  };
+
+  /** \brief Point Cloud Data (PCD) file format writer, appending the points in pieces.
+    *
+    * The points are written in binary format as they are appended, and the
+    * number of points in the header is updated when the file is closed, so
+    * that clouds larger than the available memory can be written.
+    * \ingroup io
+    */
+  class PCL_EXPORTS PCDStreamWriter
+  {
+    public:
+      PCDStreamWriter () : file_name_ (), fs_ (), header_ (), origin_ (Eigen::Vector4f::Zero ()),
+        orientation_ (Eigen::Quaternionf::Identity ()), nr_points_ (0), file_lock_ () {}
+
+      /** \brief Close the file if it is open. */
+      ~PCDStreamWriter () { close (); }
+
+      /** \brief Create a PCD file holding the fields of a cloud.
+        * \param[in] file_name the output file name
+        * \param[in] cloud a cloud with the fields of the points to write (its data is not used)
+        * \param[in] origin the sensor acquisition origin
+        * \param[in] orientation the sensor acquisition orientation
+        * \return 0 on success, -1 on error
+        */
+      int
+      open (const std::string &file_name, const pcl::PCLPointCloud2 &cloud,
+            const Eigen::Vector4f &origin = Eigen::Vector4f::Zero (),
+            const Eigen::Quaternionf &orientation = Eigen::Quaternionf::Identity ());
+
+      /** \brief Create a PCD file holding points of type PointT.
+        * \param[in] file_name the output file name
+        * \param[in] origin the sensor acquisition origin
+        * \param[in] orientation the sensor acquisition orientation
+        * \return 0 on success, -1 on error
+        */
+      template <typename PointT> int
+      open (const std::string &file_name,
+            const Eigen::Vector4f &origin = Eigen::Vector4f::Zero (),
+            const Eigen::Quaternionf &orientation = Eigen::Quaternionf::Identity ());
+
+      /** \brief Append the points of a cloud, which must have the fields given to open, to the file.
+        * \return 0 on success, -1 on error
+        */
+      int
+      append (const pcl::PCLPointCloud2 &cloud);
+
+      /** \brief Append the points of a cloud to the file.
+        * \return 0 on success, -1 on error
+        */
+      template <typename PointT> int
+      append (const pcl::PointCloud<PointT> &cloud);
+
+      /** \brief Write the final number of points in the header and close the file.
+        * A file without points cannot be read back, so it is removed if nothing was appended.
+        * \return 0 on success, -1 on error (including when no point was appended)
+        */
+      int
+      close ();
+
+      /** \brief Check whether a file is open. */
+      inline bool
+      isOpen () const { return (fs_.is_open ()); }
+
+      /** \brief Get the number of points written so far. */
+      inline unsigned int
+      getNumberOfPoints () const { return (nr_points_); }
+
+      EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    private:
+      /** \brief Generate the header of the file for a given number of points.
+        *
+        * The numbers of points are padded so that the header keeps the same
+        * size, and can be rewritten in place when the file is closed.
+        */
+      std::string
+      generateHeader (unsigned int nr_points) const;
+
+      /** \brief The name of the file being written. */
+      std::string file_name_;
+
+      /** \brief The file being written. */
+      std::ofstream fs_;
+
+      /** \brief A cloud without data, holding the fields of the points. */
+      pcl::PCLPointCloud2 header_;
+
+      /** \brief The sensor acquisition origin. */
+      Eigen::Vector4f origin_;
+
+      /** \brief The sensor acquisition orientation. */
+      Eigen::Quaternionf orientation_;
+
+      /** \brief The number of points written so far. */
+      unsigned int nr_points_;
+
+      /** \brief The lock held on the file while it is written. */
+      boost::interprocess::file_lock file_lock_;
   };
 
   namespace io
@@ -674,6 +1033,23 @@ namespace pcl
       return (w.writeBinaryCompressed<PointT> (file_name, cloud));
     }
 
+    /** \brief Templated version for saving point cloud data to a PCD file
+      * containing a specific given cloud format, split in independently
+      * compressed chunks.
+      *
+      * \param[in] file_name the output file name
+      * \param[in] cloud the point cloud data message
+      * \param[in] chunk_size the number of points per chunk
+      * \ingroup io
+      */
+    template<typename PointT> inline int
+    savePCDFileBinaryCompressedChunked (const std::string &file_name, const pcl::PointCloud<PointT> &cloud,
+                                        unsigned int chunk_size = 65536)
+    {
+      PCDWriter w;
+      return (w.writeBinaryCompressedChunked<PointT> (file_name, cloud, chunk_size));
+    }
+
   }
 }
 
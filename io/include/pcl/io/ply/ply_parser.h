@@ -97,6 +97,15 @@ namespace pcl
           typedef boost::function<void ()> end_element_callback_type;
           typedef boost::tuple<begin_element_callback_type, end_element_callback_type> element_callbacks_type;
           typedef boost::function<element_callbacks_type (const std::string&, std::size_t)> element_definition_callback_type;
+
+          /** Callback for the raw data of a binary element made only of scalar properties. It
+            * receives the element name, the number of instances and the size in bytes of one
+            * instance, and returns the buffer the whole element is read into (already converted
+            * to host byte order), or NULL to parse the element property by property. When a
+            * buffer is returned, the begin/end element and property callbacks of that element
+            * are not called.
+            */
+          typedef boost::function<char* (const std::string&, std::size_t, std::size_t)> binary_element_callback_type;
          
           template <typename ScalarType>
           struct scalar_property_callback_type
@@ -301,12 +310,16 @@ namespace pcl
           inline void
           end_header_callback (const end_header_callback_type& end_header_callback);
 
+          inline void
+          binary_element_callback (const binary_element_callback_type& binary_element_callback);
+
           typedef int flags_type;
           enum flags { };
 
           ply_parser (flags_type flags = 0) : 
             flags_ (flags), 
             comment_callback_ (), obj_info_callback_ (), end_header_callback_ (), 
+            binary_element_callback_ (),
             line_number_ (0), current_element_ ()
           {}
               
@@ -320,6 +333,8 @@ namespace pcl
             property (const std::string& name) : name (name) {}
             virtual ~property () {}
             virtual bool parse (class ply_parser& ply_parser, format_type format, std::istream& istream) = 0;
+            /** Size in bytes of the property in a binary file, 0 if it is not fixed. */
+            virtual std::size_t size () const { return (0); }
             std::string name;
           };
             
@@ -338,6 +353,7 @@ namespace pcl
             { 
               return ply_parser.parse_scalar_property<scalar_type> (format, istream, callback); 
             }
+            std::size_t size () const { return (sizeof (scalar_type)); }
             callback_type callback;
           };
 
@@ -406,7 +422,16 @@ namespace pcl
           comment_callback_type comment_callback_;
           obj_info_callback_type obj_info_callback_;
           end_header_callback_type end_header_callback_;
+          binary_element_callback_type binary_element_callback_;
           
+          /** Read all the instances of a binary element made only of scalar properties in one
+            * go, if the binary element callback accepts it.
+            * \return 1 if the element was read, 0 if it has to be parsed property by property
+            * and -1 on read error
+            */
+          int
+          parse_binary_element (format_type format, std::istream& istream, const element& element);
+
           template <typename ScalarType> inline void 
           parse_scalar_property_definition (const std::string& property_name);
 
@@ -493,6 +518,11 @@ inline void pcl::io::ply::ply_parser::end_header_callback (const end_header_call
   end_header_callback_ = end_header_callback;
 }
 
+inline void pcl::io::ply::ply_parser::binary_element_callback (const binary_element_callback_type& binary_element_callback)
+{
+  binary_element_callback_ = binary_element_callback;
+}
+
 template <typename ScalarType>
 inline void pcl::io::ply::ply_parser::parse_scalar_property_definition (const std::string& property_name)
 {
@@ -451,6 +451,41 @@ namespace pcl
       void
       amendProperty (const std::string& old_name, const std::string& new_name, uint8_t datatype = 0);
 
+      /** Layout of a vertex scalar property: its size in a binary PLY record,
+        * the offset of the field it lands in and how it is converted.
+        */
+      struct VertexProperty
+      {
+        enum Conversion { COPY, RED, GREEN, BLUE, ALPHA, INTENSITY };
+
+        VertexProperty (std::size_t size, std::size_t offset, Conversion conversion)
+          : size (size), offset (offset), conversion (conversion) {}
+
+        std::size_t size;
+        std::size_t offset;
+        Conversion conversion;
+      };
+
+      /** \return the offset of the rgb field the last red property was packed in. */
+      std::size_t
+      vertexColorOffset () const;
+
+      /** Callback function for binary elements made only of fixed size properties.
+        * Vertices are read in one go, straight into the cloud data when the PLY
+        * record matches the point layout, otherwise in a buffer converted once
+        * parsing is done.
+        * param[in] element_name element name
+        * param[in] count number of instances
+        * param[in] size size in bytes of one instance
+        * \return the buffer to read the element into or NULL to use the callbacks
+        */
+      char*
+      binaryElementCallback (const std::string& element_name, std::size_t count, std::size_t size);
+
+      /** Convert the vertices read in one go to the cloud layout. */
+      void
+      convertVertexBuffer ();
+
       /** Callback function for the begin of vertex line */
       void
       vertexBeginCallback ();
@@ -525,6 +560,9 @@ namespace pcl
       std::vector<std::vector <int> > *range_grid_;
       size_t rgb_offset_before_;
       bool do_resize_;
+      //binary vertex fast path artifacts
+      std::vector<VertexProperty> vertex_properties_;
+      std::vector<char> vertex_buffer_;
       //face element artifact
       std::vector<pcl::Vertices> *polygons_;
     public:
@@ -699,6 +737,35 @@ namespace pcl
         return (this->write (file_name, blob, origin, orientation, binary, use_camera));
       }
       
+      /** \brief Write the vertices of a cloud in binary PLY format.
+        *
+        * Together with generateHeaderBinary and writeBinaryCamera, this allows
+        * writing a binary PLY file in pieces: the header, the vertices of each
+        * piece of the cloud, then the camera.
+        *
+        * \param[out] fpout the stream to write to, opened in binary mode
+        * \param[in] cloud the point cloud data message
+        * \param[in] rangegrid the index of each point in the range grid, -1 for the
+        * points to skip (all the points are written if empty)
+        */
+      void
+      writeBinaryVertices (std::ostream &fpout,
+                           const pcl::PCLPointCloud2 &cloud,
+                           const std::vector<pcl::io::ply::int32> &rangegrid = std::vector<pcl::io::ply::int32> ());
+
+      /** \brief Write the camera element of a binary PLY file (see writeBinaryVertices).
+        * \param[out] fpout the stream to write to, opened in binary mode
+        * \param[in] origin the sensor data acquisition origin (translation)
+        * \param[in] orientation the sensor data acquisition origin (rotation)
+        * \param[in] width the width of the cloud
+        * \param[in] height the height of the cloud
+        */
+      void
+      writeBinaryCamera (std::ostream &fpout,
+                         const Eigen::Vector4f &origin,
+                         const Eigen::Quaternionf &orientation,
+                         int width, int height);
+
     private:
       /** \brief Generate a PLY header.
         * \param[in] cloud the input point cloud
@@ -35,12 +35,125 @@
  *
  */
 #include <pcl/io/debayer.h>
+#include <pcl/console/print.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #define AVG(a,b) static_cast<unsigned char>((int(a) + int(b)) >> 1)
 #define AVG3(a,b,c) static_cast<unsigned char>((int(a) + int(b) + int(c)) / 3)
 #define AVG4(a,b,c,d) static_cast<unsigned char>((int(a) + int(b) + int(c) + int(d)) >> 2)
 #define WAVG4(a,b,c,d,x,y) static_cast<unsigned char>( ( (int(a) + int(b)) * int(x) + (int(c) + int(d)) * int(y) ) / ( (int(x) + (int(y))) << 1 ) )
 
+#if defined(__SSE2__)
+namespace
+{
+  /** \brief Load 16 bytes and widen the even (first) and odd (second) ones to 16 bit. */
+  inline void
+  loadEvenOdd (const unsigned char *bytes, __m128i &even, __m128i &odd)
+  {
+    const __m128i v = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (bytes));
+    even = _mm_and_si128 (v, _mm_set1_epi16 (0x00ff));
+    odd = _mm_srli_epi16 (v, 8);
+  }
+
+  /** \brief Join the values of the even and odd pixels (16 bit each, at most 255) into 16 bytes. */
+  inline __m128i
+  joinEvenOdd (const __m128i &even, const __m128i &odd)
+  {
+    return (_mm_or_si128 (even, _mm_slli_epi16 (odd, 8)));
+  }
+
+  /** \brief Squeeze 4 pixels stored as 32 bit RGB0 into the low 12 bytes. */
+  inline __m128i
+  packRGB0 (const __m128i &rgb0)
+  {
+    const __m128i even_pixels = _mm_set_epi32 (0, -1, 0, -1);
+    // move the odd pixels of both 64 bit halves next to the even ones, over the zero bytes ...
+    const __m128i halves = _mm_or_si128 (_mm_and_si128 (rgb0, even_pixels),
+                                         _mm_srli_epi64 (_mm_andnot_si128 (even_pixels, rgb0), 8));
+    // ... and the 6 bytes of the upper half next to the 6 bytes of the lower half
+    const __m128i lower_half = _mm_set_epi32 (0, 0, -1, -1);
+    return (_mm_or_si128 (_mm_and_si128 (halves, lower_half), _mm_srli_si128 (_mm_andnot_si128 (lower_half, halves), 2)));
+  }
+
+  /** \brief Interleave 16 red, green and blue values into 48 bytes of RGB. */
+  inline void
+  storeRGB (const __m128i &r, const __m128i &g, const __m128i &b, unsigned char *rgb)
+  {
+    const __m128i zero = _mm_setzero_si128 ();
+    const __m128i rg_lo = _mm_unpacklo_epi8 (r, g);
+    const __m128i rg_hi = _mm_unpackhi_epi8 (r, g);
+    const __m128i b0_lo = _mm_unpacklo_epi8 (b, zero);
+    const __m128i b0_hi = _mm_unpackhi_epi8 (b, zero);
+    const __m128i rgb_0 = packRGB0 (_mm_unpacklo_epi16 (rg_lo, b0_lo));
+    const __m128i rgb_1 = packRGB0 (_mm_unpackhi_epi16 (rg_lo, b0_lo));
+    const __m128i rgb_2 = packRGB0 (_mm_unpacklo_epi16 (rg_hi, b0_hi));
+    const __m128i rgb_3 = packRGB0 (_mm_unpackhi_epi16 (rg_hi, b0_hi));
+    _mm_storeu_si128 (reinterpret_cast<__m128i*> (rgb), _mm_or_si128 (rgb_0, _mm_slli_si128 (rgb_1, 12)));
+    _mm_storeu_si128 (reinterpret_cast<__m128i*> (rgb + 16), _mm_or_si128 (_mm_srli_si128 (rgb_1, 4), _mm_slli_si128 (rgb_2, 8)));
+    _mm_storeu_si128 (reinterpret_cast<__m128i*> (rgb + 32), _mm_or_si128 (_mm_srli_si128 (rgb_2, 8), _mm_slli_si128 (rgb_3, 4)));
+  }
+
+  /** \brief Bilinear debayering of 8 GR/BG pixel pairs of an inner row pair, the same integer averages as
+    * the scalar loop of DeBayer::debayerBilinear (), each 16 bit lane holding one pixel pair.
+    * \param[in] bayer_pixel the first green pixel of the GRGR line, the pixels [-1, 16] of the lines
+    * -bayer_line_step to bayer_line_step2 are read
+    */
+  inline void
+  debayerBilinearSSE2 (const unsigned char *bayer_pixel, unsigned char *rgb_buffer,
+                       int bayer_line_step, int bayer_line_step2, unsigned rgb_line_step)
+  {
+    // <line><e|o><offset>: the even/odd pixel of the pair, starting <offset> pixels to the right
+    __m128i up_e0, up_o0, up_e1, up_o1;
+    __m128i e_1, o_1, e0, o0, e1, o1;
+    __m128i down_e_1, down_o_1, down_e0, down_o0, down_e1, down_o1;
+    __m128i down2_e_1, down2_o_1, down2_e0, down2_o0;
+    loadEvenOdd (bayer_pixel - bayer_line_step, up_e0, up_o0);
+    loadEvenOdd (bayer_pixel - bayer_line_step + 1, up_e1, up_o1);
+    loadEvenOdd (bayer_pixel - 1, e_1, o_1);
+    loadEvenOdd (bayer_pixel, e0, o0);
+    loadEvenOdd (bayer_pixel + 1, e1, o1);
+    loadEvenOdd (bayer_pixel + bayer_line_step - 1, down_e_1, down_o_1);
+    loadEvenOdd (bayer_pixel + bayer_line_step, down_e0, down_o0);
+    loadEvenOdd (bayer_pixel + bayer_line_step + 1, down_e1, down_o1);
+    loadEvenOdd (bayer_pixel + bayer_line_step2 - 1, down2_e_1, down2_o_1);
+    loadEvenOdd (bayer_pixel + bayer_line_step2, down2_e0, down2_o0);
+
+    // GRGR line: G at the even pixels, R at the odd ones
+    const __m128i r_g = _mm_srli_epi16 (_mm_add_epi16 (o0, e_1), 1);
+    const __m128i b_g = _mm_srli_epi16 (_mm_add_epi16 (down_e0, up_e0), 1);
+    const __m128i g_r = _mm_srli_epi16 (_mm_add_epi16 (_mm_add_epi16 (e0, o1), _mm_add_epi16 (down_o0, up_o0)), 2);
+    const __m128i b_r = _mm_srli_epi16 (_mm_add_epi16 (_mm_add_epi16 (up_e0, up_o1), _mm_add_epi16 (down_e0, down_o1)), 2);
+    storeRGB (joinEvenOdd (r_g, o0), joinEvenOdd (e0, g_r), joinEvenOdd (b_g, b_r), rgb_buffer);
+
+    // BGBG line: B at the even pixels, G at the odd ones
+    const __m128i r_b = _mm_srli_epi16 (_mm_add_epi16 (_mm_add_epi16 (o0, down2_o0), _mm_add_epi16 (e_1, down2_e_1)), 2);
+    const __m128i g_b = _mm_srli_epi16 (_mm_add_epi16 (_mm_add_epi16 (e0, down2_e0), _mm_add_epi16 (down_e_1, down_o0)), 2);
+    const __m128i r_g2 = _mm_srli_epi16 (_mm_add_epi16 (o0, down2_o0), 1);
+    const __m128i b_g2 = _mm_srli_epi16 (_mm_add_epi16 (down_e0, down_o1), 1);
+    storeRGB (joinEvenOdd (r_b, r_g2), joinEvenOdd (g_b, down_o0), joinEvenOdd (down_e0, b_g2), rgb_buffer + rgb_line_step);
+  }
+}
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+void
+pcl::io::DeBayer::setNumberOfThreads (unsigned int nr_threads)
+{
+#ifdef _OPENMP
+  threads_ = nr_threads != 0 ? nr_threads : static_cast<unsigned int> (omp_get_num_procs ());
+#else
+  if (nr_threads != 1)
+    PCL_WARN ("[pcl::io::DeBayer::setNumberOfThreads] PCL was compiled without OpenMP, using a single thread.\n");
+  threads_ = 1;
+#endif
+}
+
 //////////////////////////////////////////////////////////////////////////////
 void
 pcl::io::DeBayer::debayerBilinear (
@@ -59,7 +172,7 @@ pcl::io::DeBayer::debayerBilinear (
 
   // padding skip for destination image
   unsigned rgb_line_skip = rgb_line_step - width * 3;
-  register unsigned yIdx, xIdx;
+  register unsigned xIdx;
   // first two pixel values for first two lines
   // Bayer         0 1 2
   //         0     G r g
@@ -175,8 +288,19 @@ pcl::io::DeBayer::debayerBilinear (
 
   // main processing
 
-  for (yIdx = 2; yIdx < height - 2; yIdx += 2)
+  // row pairs are independent of each other, process them in parallel bands
+  const unsigned char *bayer_rows = bayer_pixel;
+  unsigned char *rgb_rows = rgb_buffer;
+  const int nr_row_pairs = height > 3 ? static_cast<int> (height - 3) / 2 : 0;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads (threads_)
+#endif
+  for (int row_pair = 0; row_pair < nr_row_pairs; ++row_pair)
   {
+    const unsigned char *bayer_pixel = bayer_rows + row_pair * (bayer_line_step + width);
+    unsigned char *rgb_buffer = rgb_rows + row_pair * 2 * rgb_line_step;
+    unsigned xIdx;
+
     // first two pixel values
     // Bayer         0 1 2
     //        -1     b g b
@@ -216,8 +340,14 @@ pcl::io::DeBayer::debayerBilinear (
 
     rgb_buffer += 6;
     bayer_pixel += 2;
+    xIdx = 2;
+#if defined(__SSE2__)
+    // 16 pixels of both lines at a time, as long as the pixels up to xIdx + 16 are inside the line
+    for (; xIdx + 16 <= width - 2; xIdx += 16, rgb_buffer += 48, bayer_pixel += 16)
+      debayerBilinearSSE2 (bayer_pixel, rgb_buffer, bayer_line_step, bayer_line_step2, rgb_line_step);
+#endif
     // continue with rest of the line
-    for (xIdx = 2; xIdx < width - 2; xIdx += 2, rgb_buffer += 6, bayer_pixel += 2)
+    for (; xIdx < width - 2; xIdx += 2, rgb_buffer += 6, bayer_pixel += 2)
     {
       // GRGR line
       // Bayer        -1 0 1 2
@@ -294,9 +424,9 @@ pcl::io::DeBayer::debayerBilinear (
     rgb_buffer[rgb_line_step + 4] = bayer_pixel[bayer_line_step + 1];
     //rgb_pixel[rgb_line_step + 5] = bayer_pixel[line_step];
 
-    bayer_pixel += bayer_line_step + 2;
-    rgb_buffer += rgb_line_step + 6 + rgb_line_skip;
   }
+  bayer_pixel = bayer_rows + nr_row_pairs * (bayer_line_step + width);
+  rgb_buffer = rgb_rows + nr_row_pairs * 2 * rgb_line_step;
 
   //last two lines
   // Bayer         0 1 2
@@ -428,8 +558,7 @@ pcl::io::DeBayer::debayerEdgeAware (
 
   // padding skip for destination image
   unsigned rgb_line_skip = rgb_line_step - width * 3;
-  register unsigned yIdx, xIdx;
-  int dh, dv;
+  register unsigned xIdx;
 
   // first two pixel values for first two lines
   // Bayer         0 1 2
@@ -544,8 +673,20 @@ pcl::io::DeBayer::debayerEdgeAware (
   bayer_pixel += bayer_line_step + 2;
   rgb_buffer += rgb_line_step + 6 + rgb_line_skip;
   // main processing
-  for (yIdx = 2; yIdx < height - 2; yIdx += 2)
+  // row pairs are independent of each other, process them in parallel bands
+  const unsigned char *bayer_rows = bayer_pixel;
+  unsigned char *rgb_rows = rgb_buffer;
+  const int nr_row_pairs = height > 3 ? static_cast<int> (height - 3) / 2 : 0;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads (threads_)
+#endif
+  for (int row_pair = 0; row_pair < nr_row_pairs; ++row_pair)
   {
+    const unsigned char *bayer_pixel = bayer_rows + row_pair * (bayer_line_step + width);
+    unsigned char *rgb_buffer = rgb_rows + row_pair * 2 * rgb_line_step;
+    unsigned xIdx;
+    int dh, dv;
+
     // first two pixel values
     // Bayer         0 1 2
     //        -1     b g b
@@ -682,9 +823,9 @@ pcl::io::DeBayer::debayerEdgeAware (
     rgb_buffer[rgb_line_step + 4] = bayer_pixel[bayer_line_step + 1];
     //rgb_pixel[rgb_line_step + 5] = bayer_pixel[line_step];
 
-    bayer_pixel += bayer_line_step + 2;
-    rgb_buffer += rgb_line_step + 6 + rgb_line_skip;
   }
+  bayer_pixel = bayer_rows + nr_row_pairs * (bayer_line_step + width);
+  rgb_buffer = rgb_rows + nr_row_pairs * 2 * rgb_line_step;
 
   //last two lines
   // Bayer         0 1 2
@@ -816,8 +957,7 @@ pcl::io::DeBayer::debayerEdgeAwareWeighted (
 
   // padding skip for destination image
   unsigned rgb_line_skip = rgb_line_step - width * 3;
-  register unsigned yIdx, xIdx;
-  int dh, dv;
+  register unsigned xIdx;
 
   // first two pixel values for first two lines
   // Bayer         0 1 2
@@ -932,8 +1072,20 @@ pcl::io::DeBayer::debayerEdgeAwareWeighted (
   bayer_pixel += bayer_line_step + 2;
   rgb_buffer += rgb_line_step + 6 + rgb_line_skip;
   // main processing
-  for (yIdx = 2; yIdx < height - 2; yIdx += 2)
+  // row pairs are independent of each other, process them in parallel bands
+  const unsigned char *bayer_rows = bayer_pixel;
+  unsigned char *rgb_rows = rgb_buffer;
+  const int nr_row_pairs = height > 3 ? static_cast<int> (height - 3) / 2 : 0;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads (threads_)
+#endif
+  for (int row_pair = 0; row_pair < nr_row_pairs; ++row_pair)
   {
+    const unsigned char *bayer_pixel = bayer_rows + row_pair * (bayer_line_step + width);
+    unsigned char *rgb_buffer = rgb_rows + row_pair * 2 * rgb_line_step;
+    unsigned xIdx;
+    int dh, dv;
+
     // first two pixel values
     // Bayer         0 1 2
     //        -1     b g b
@@ -1065,9 +1217,9 @@ pcl::io::DeBayer::debayerEdgeAwareWeighted (
     rgb_buffer[rgb_line_step + 4] = bayer_pixel[bayer_line_step + 1];
     //rgb_pixel[rgb_line_step + 5] = bayer_pixel[line_step];
 
-    bayer_pixel += bayer_line_step + 2;
-    rgb_buffer += rgb_line_step + 6 + rgb_line_skip;
   }
+  bayer_pixel = bayer_rows + nr_row_pairs * (bayer_line_step + width);
+  rgb_buffer = rgb_rows + nr_row_pairs * 2 * rgb_line_step;
 
   //last two lines
   // Bayer         0 1 2
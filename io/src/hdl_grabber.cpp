@@ -50,8 +50,8 @@
 #endif // #ifdef HAVE_PCAP
 
 const boost::asio::ip::address pcl::HDLGrabber::HDL_DEFAULT_NETWORK_ADDRESS = boost::asio::ip::address::from_string ("192.168.3.255");
-double *pcl::HDLGrabber::cos_lookup_table_ = NULL;
-double *pcl::HDLGrabber::sin_lookup_table_ = NULL;
+float *pcl::HDLGrabber::cos_lookup_table_ = NULL;
+float *pcl::HDLGrabber::sin_lookup_table_ = NULL;
 
 using boost::asio::ip::udp;
 
@@ -59,6 +59,10 @@ using boost::asio::ip::udp;
 pcl::HDLGrabber::HDLGrabber (const std::string& correctionsFile,
                              const std::string& pcapFile) 
   : hdl_data_ ()
+  , packet_buffers_ ()
+  , free_packet_buffers_ ()
+  , packet_pool_mutex_ ()
+  , packet_released_ ()
   , udp_listener_endpoint_ (HDL_DEFAULT_NETWORK_ADDRESS, HDL_DATA_PORT)
   , source_address_filter_ ()
   , source_port_filter_ (443)
@@ -74,6 +78,7 @@ pcl::HDLGrabber::HDLGrabber (const std::string& correctionsFile,
   , current_scan_xyzrgb_ (new pcl::PointCloud<pcl::PointXYZRGBA> ())
   , current_sweep_xyzrgb_ (new pcl::PointCloud<pcl::PointXYZRGBA> ())
   , last_azimuth_ (65000)
+  , last_sweep_size_ (0)
   , sweep_xyz_signal_ ()
   , sweep_xyzrgb_signal_ ()
   , sweep_xyzi_signal_ ()
@@ -82,6 +87,7 @@ pcl::HDLGrabber::HDLGrabber (const std::string& correctionsFile,
   , scan_xyzi_signal_ ()
   , min_distance_threshold_(0.0)
   , max_distance_threshold_(10000.0)
+  , as_fast_as_possible_ (false)
 {
   initialize (correctionsFile);
 }
@@ -91,6 +97,10 @@ pcl::HDLGrabber::HDLGrabber (const boost::asio::ip::address& ipAddress,
                              const unsigned short int port, 
                              const std::string& correctionsFile) 
   : hdl_data_ ()
+  , packet_buffers_ ()
+  , free_packet_buffers_ ()
+  , packet_pool_mutex_ ()
+  , packet_released_ ()
   , udp_listener_endpoint_ (ipAddress, port)
   , source_address_filter_ ()
   , source_port_filter_ (443)
@@ -106,6 +116,7 @@ pcl::HDLGrabber::HDLGrabber (const boost::asio::ip::address& ipAddress,
   , current_scan_xyzrgb_ (new pcl::PointCloud<pcl::PointXYZRGBA> ())
   , current_sweep_xyzrgb_ (new pcl::PointCloud<pcl::PointXYZRGBA> ())
   , last_azimuth_ (65000)
+  , last_sweep_size_ (0)
   , sweep_xyz_signal_ ()
   , sweep_xyzrgb_signal_ ()
   , sweep_xyzi_signal_ ()
@@ -114,6 +125,7 @@ pcl::HDLGrabber::HDLGrabber (const boost::asio::ip::address& ipAddress,
   , scan_xyzi_signal_ ()
   , min_distance_threshold_(0.0)
   , max_distance_threshold_(10000.0)
+  , as_fast_as_possible_ (false)
 {
   initialize (correctionsFile);
 }
@@ -129,6 +141,9 @@ pcl::HDLGrabber::~HDLGrabber () throw ()
   disconnect_all_slots<sig_cb_velodyne_hdl_scan_point_cloud_xyz> ();
   disconnect_all_slots<sig_cb_velodyne_hdl_scan_point_cloud_xyzrgb> ();
   disconnect_all_slots<sig_cb_velodyne_hdl_scan_point_cloud_xyzi> ();
+
+  for (size_t i = 0; i < packet_buffers_.size (); ++i)
+    delete[] packet_buffers_[i];
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -137,13 +152,13 @@ pcl::HDLGrabber::initialize (const std::string& correctionsFile)
 {
   if (cos_lookup_table_ == NULL && sin_lookup_table_ == NULL)
   {
-    cos_lookup_table_ = static_cast<double *> (malloc (HDL_NUM_ROT_ANGLES * sizeof (*cos_lookup_table_)));
-    sin_lookup_table_ = static_cast<double *> (malloc (HDL_NUM_ROT_ANGLES * sizeof (*sin_lookup_table_)));
+    cos_lookup_table_ = static_cast<float *> (malloc (HDL_NUM_ROT_ANGLES * sizeof (*cos_lookup_table_)));
+    sin_lookup_table_ = static_cast<float *> (malloc (HDL_NUM_ROT_ANGLES * sizeof (*sin_lookup_table_)));
     for (unsigned int i = 0; i < HDL_NUM_ROT_ANGLES; i++)
     {
       double rad = (M_PI / 180.0) * (static_cast<double> (i) / 100.0);
-      cos_lookup_table_[i] = std::cos (rad);
-      sin_lookup_table_[i] = std::sin (rad);
+      cos_lookup_table_[i] = static_cast<float> (std::cos (rad));
+      sin_lookup_table_[i] = static_cast<float> (std::sin (rad));
     }
   }
 
@@ -157,6 +172,8 @@ pcl::HDLGrabber::initialize (const std::string& correctionsFile)
     laser_corrections_[i].cosVertOffsetCorrection = correction.verticalOffsetCorrection
                                        * correction.cosVertCorrection;
   }
+  updateFloatCorrections ();
+
   sweep_xyz_signal_ = createSignal<sig_cb_velodyne_hdl_sweep_point_cloud_xyz> ();
   sweep_xyzrgb_signal_ = createSignal<sig_cb_velodyne_hdl_sweep_point_cloud_xyzrgb> ();
   sweep_xyzi_signal_ =createSignal<sig_cb_velodyne_hdl_sweep_point_cloud_xyzi> ();
@@ -293,6 +310,25 @@ pcl::HDLGrabber::loadHDL32Corrections ()
   }
 }
 
+/////////////////////////////////////////////////////////////////////////////
+void
+pcl::HDLGrabber::updateFloatCorrections ()
+{
+  for (int i = 0; i < HDL_MAX_NUM_LASERS; i++)
+  {
+    const HDLLaserCorrection &correction = laser_corrections_[i];
+    const double azimuthCorrection = HDL_Grabber_toRadians (correction.azimuthCorrection);
+    float_corrections_.cosAzimuthCorrection[i] = static_cast<float> (std::cos (azimuthCorrection));
+    float_corrections_.sinAzimuthCorrection[i] = static_cast<float> (std::sin (azimuthCorrection));
+    float_corrections_.distanceCorrection[i] = static_cast<float> (correction.distanceCorrection);
+    float_corrections_.horizontalOffsetCorrection[i] = static_cast<float> (correction.horizontalOffsetCorrection);
+    float_corrections_.sinVertCorrection[i] = static_cast<float> (correction.sinVertCorrection);
+    float_corrections_.cosVertCorrection[i] = static_cast<float> (correction.cosVertCorrection);
+    float_corrections_.sinVertOffsetCorrection[i] = static_cast<float> (correction.sinVertOffsetCorrection);
+    float_corrections_.cosVertOffsetCorrection[i] = static_cast<float> (correction.cosVertOffsetCorrection);
+  }
+}
+
 /////////////////////////////////////////////////////////////////////////////
 void
 pcl::HDLGrabber::processVelodynePackets ()
@@ -305,10 +341,22 @@ pcl::HDLGrabber::processVelodynePackets ()
 
     toPointClouds (reinterpret_cast<HDLDataPacket *> (data));
 
-    free (data);
+    releasePacketBuffer (data);
   }
 }
 
+/////////////////////////////////////////////////////////////////////////////
+template <typename CloudT> void
+pcl::HDLGrabber::prepareCloud (boost::shared_ptr<CloudT> &cloud, size_t expected_size)
+{
+  // Subscribers may have kept the previous cloud, only recycle it if they did not
+  if (cloud && cloud.unique ())
+    cloud->clear ();
+  else
+    cloud.reset (new CloudT);
+  cloud->points.reserve (expected_size);
+}
+
 /////////////////////////////////////////////////////////////////////////////
 void
 pcl::HDLGrabber::toPointClouds (HDLDataPacket *dataPacket)
@@ -318,9 +366,17 @@ pcl::HDLGrabber::toPointClouds (HDLDataPacket *dataPacket)
   if (sizeof (HDLLaserReturn) != 3)
     return;
 
-  current_scan_xyz_.reset (new pcl::PointCloud<pcl::PointXYZ> ());
-  current_scan_xyzrgb_.reset (new pcl::PointCloud<pcl::PointXYZRGBA> ());
-  current_scan_xyzi_.reset (new pcl::PointCloud<pcl::PointXYZI> ());
+  // Only fill the clouds somebody listens to
+  const bool scan_xyz = scan_xyz_signal_->num_slots () > 0;
+  const bool scan_xyzrgb = scan_xyzrgb_signal_->num_slots () > 0;
+  const bool scan_xyzi = scan_xyzi_signal_->num_slots () > 0;
+  const bool sweep_xyz = sweep_xyz_signal_->num_slots () > 0;
+  const bool sweep_xyzrgb = sweep_xyzrgb_signal_->num_slots () > 0;
+  const bool sweep_xyzi = sweep_xyzi_signal_->num_slots () > 0;
+
+  prepareCloud (current_scan_xyz_, HDL_POINTS_PER_PKT);
+  prepareCloud (current_scan_xyzrgb_, HDL_POINTS_PER_PKT);
+  prepareCloud (current_scan_xyzi_, HDL_POINTS_PER_PKT);
 
   time_t  time_;
   time(&time_);
@@ -334,61 +390,69 @@ pcl::HDLGrabber::toPointClouds (HDLDataPacket *dataPacket)
   current_scan_xyzi_->header.seq = scanCounter;
   scanCounter++;
 
+  computePacketPoints (dataPacket, packet_points_);
+
   for (int i = 0; i < HDL_FIRING_PER_PKT; ++i)
   {
-    HDLFiringData firingData = dataPacket->firingData[i];
-    int offset = (firingData.blockIdentifier == BLOCK_0_TO_31) ? 0 : 32;
+    const unsigned int azimuth = dataPacket->firingData[i].rotationalPosition;
 
-    for (int j = 0; j < HDL_LASER_PER_FIRING; j++)
+    if (azimuth < last_azimuth_)
     {
-      if (firingData.rotationalPosition < last_azimuth_)
+      const size_t sweep_size = std::max (current_sweep_xyz_->size (),
+                                          std::max (current_sweep_xyzrgb_->size (), current_sweep_xyzi_->size ()));
+      if (sweep_size > 0)
       {
-        if (current_sweep_xyzrgb_->size () > 0)
-        {
-          current_sweep_xyz_->is_dense = current_sweep_xyzrgb_->is_dense = current_sweep_xyzi_->is_dense = false;
-          current_sweep_xyz_->header.stamp = velodyneTime;
-          current_sweep_xyzrgb_->header.stamp = velodyneTime;
-          current_sweep_xyzi_->header.stamp = velodyneTime;
-          current_sweep_xyz_->header.seq = sweepCounter;
-          current_sweep_xyzrgb_->header.seq = sweepCounter;
-          current_sweep_xyzi_->header.seq = sweepCounter;
-
-          sweepCounter++;
-
-          fireCurrentSweep ();
-        }
-        current_sweep_xyz_.reset (new pcl::PointCloud<pcl::PointXYZ> ());
-        current_sweep_xyzrgb_.reset (new pcl::PointCloud<pcl::PointXYZRGBA> ());
-        current_sweep_xyzi_.reset (new pcl::PointCloud<pcl::PointXYZI> ());
+        current_sweep_xyz_->is_dense = current_sweep_xyzrgb_->is_dense = current_sweep_xyzi_->is_dense = false;
+        current_sweep_xyz_->header.stamp = velodyneTime;
+        current_sweep_xyzrgb_->header.stamp = velodyneTime;
+        current_sweep_xyzi_->header.stamp = velodyneTime;
+        current_sweep_xyz_->header.seq = sweepCounter;
+        current_sweep_xyzrgb_->header.seq = sweepCounter;
+        current_sweep_xyzi_->header.seq = sweepCounter;
+
+        sweepCounter++;
+
+        fireCurrentSweep ();
+        last_sweep_size_ = sweep_size;
       }
+      prepareCloud (current_sweep_xyz_, sweep_xyz ? last_sweep_size_ : 0);
+      prepareCloud (current_sweep_xyzrgb_, sweep_xyzrgb ? last_sweep_size_ : 0);
+      prepareCloud (current_sweep_xyzi_, sweep_xyzi ? last_sweep_size_ : 0);
+    }
+
+    bool has_points = false;
+    for (int j = i * HDL_LASER_PER_FIRING; j < (i + 1) * HDL_LASER_PER_FIRING; j++)
+    {
+      if (!packet_points_.valid[j])
+        continue;
+      has_points = true;
 
       PointXYZ xyz;
       PointXYZI xyzi;
       PointXYZRGBA xyzrgb;
 
-      computeXYZI (xyzi, firingData.rotationalPosition, firingData.laserReturns[j], laser_corrections_[j + offset]);
-
-      xyz.x = xyzrgb.x = xyzi.x;
-      xyz.y = xyzrgb.y = xyzi.y;
-      xyz.z = xyzrgb.z = xyzi.z;
-
-      xyzrgb.rgba = laser_rgb_mapping_[j + offset].rgba;
-      if ((boost::math::isnan)(xyz.x) ||
-          (boost::math::isnan)(xyz.y) ||
-          (boost::math::isnan)(xyz.z)) {
-        continue;
-      }
-
-      current_scan_xyz_->push_back (xyz);
-      current_scan_xyzi_->push_back (xyzi);
-      current_scan_xyzrgb_->push_back (xyzrgb);
-
-      current_sweep_xyz_->push_back (xyz);
-      current_sweep_xyzi_->push_back (xyzi);
-      current_sweep_xyzrgb_->push_back (xyzrgb);
-
-      last_azimuth_ = firingData.rotationalPosition;
+      xyz.x = xyzrgb.x = xyzi.x = packet_points_.x[j];
+      xyz.y = xyzrgb.y = xyzi.y = packet_points_.y[j];
+      xyz.z = xyzrgb.z = xyzi.z = packet_points_.z[j];
+      xyzi.intensity = packet_points_.intensity[j];
+      xyzrgb.rgba = laser_rgb_mapping_[packet_points_.laser[j]].rgba;
+
+      if (scan_xyz)
+        current_scan_xyz_->push_back (xyz);
+      if (scan_xyzi)
+        current_scan_xyzi_->push_back (xyzi);
+      if (scan_xyzrgb)
+        current_scan_xyzrgb_->push_back (xyzrgb);
+
+      if (sweep_xyz)
+        current_sweep_xyz_->push_back (xyz);
+      if (sweep_xyzi)
+        current_sweep_xyzi_->push_back (xyzi);
+      if (sweep_xyzrgb)
+        current_sweep_xyzrgb_->push_back (xyzrgb);
     }
+    if (has_points)
+      last_azimuth_ = azimuth;
   }
 
   current_scan_xyz_->is_dense = current_scan_xyzrgb_->is_dense = current_scan_xyzi_->is_dense = true;
@@ -398,39 +462,50 @@ pcl::HDLGrabber::toPointClouds (HDLDataPacket *dataPacket)
 
 /////////////////////////////////////////////////////////////////////////////
 void
-pcl::HDLGrabber::computeXYZI (pcl::PointXYZI& point, int azimuth, 
-                              HDLLaserReturn laserReturn, HDLLaserCorrection correction)
+pcl::HDLGrabber::computePacketPoints (const HDLDataPacket *dataPacket, HDLPacketPoints &points) const
 {
-  double cosAzimuth, sinAzimuth;
+  const HDLFloatCorrections &c = float_corrections_;
+  const float min_distance = min_distance_threshold_;
+  const float max_distance = max_distance_threshold_;
 
-  double distanceM = laserReturn.distance * 0.002;
+  for (int i = 0; i < HDL_FIRING_PER_PKT; ++i)
+  {
+    const HDLFiringData &firingData = dataPacket->firingData[i];
+    const int offset = (firingData.blockIdentifier == BLOCK_0_TO_31) ? 0 : 32;
+    const int first = i * HDL_LASER_PER_FIRING;
 
-  if (distanceM < min_distance_threshold_ || distanceM > max_distance_threshold_) {
-    point.x = point.y = point.z = std::numeric_limits<float>::quiet_NaN();
-    point.intensity = static_cast<float> (laserReturn.intensity);
-    return;
-  }
+    // Corrupted rotational positions would read past the lookup tables
+    if (firingData.rotationalPosition >= HDL_NUM_ROT_ANGLES)
+    {
+      memset (points.valid + first, 0, HDL_LASER_PER_FIRING);
+      continue;
+    }
+    const float cosAzimuth = cos_lookup_table_[firingData.rotationalPosition];
+    const float sinAzimuth = sin_lookup_table_[firingData.rotationalPosition];
 
-  if (correction.azimuthCorrection == 0)
-  {
-    cosAzimuth = cos_lookup_table_[azimuth];
-    sinAzimuth = sin_lookup_table_[azimuth];
-  }
-  else
-  {
-    double azimuthInRadians = HDL_Grabber_toRadians ((static_cast<double> (azimuth) / 100.0) - correction.azimuthCorrection);
-    cosAzimuth = std::cos (azimuthInRadians);
-    sinAzimuth = std::sin (azimuthInRadians);
-  }
+    // The per laser azimuth correction is applied as a rotation by the
+    // precomputed correction angle, so no trigonometry is evaluated here
+    for (int j = 0; j < HDL_LASER_PER_FIRING; j++)
+    {
+      const int l = j + offset;
+      const int p = first + j;
+
+      float distanceM = static_cast<float> (firingData.laserReturns[j].distance) * 0.002f;
+      points.valid[p] = (distanceM >= min_distance && distanceM <= max_distance);
+      points.intensity[p] = static_cast<float> (firingData.laserReturns[j].intensity);
 
-  distanceM += correction.distanceCorrection;
+      const float cosCorrected = cosAzimuth * c.cosAzimuthCorrection[l] + sinAzimuth * c.sinAzimuthCorrection[l];
+      const float sinCorrected = sinAzimuth * c.cosAzimuthCorrection[l] - cosAzimuth * c.sinAzimuthCorrection[l];
 
-  double xyDistance = distanceM * correction.cosVertCorrection - correction.sinVertOffsetCorrection;
+      distanceM += c.distanceCorrection[l];
+      const float xyDistance = distanceM * c.cosVertCorrection[l] - c.sinVertOffsetCorrection[l];
 
-  point.x = static_cast<float> (xyDistance * sinAzimuth - correction.horizontalOffsetCorrection * cosAzimuth);
-  point.y = static_cast<float> (xyDistance * cosAzimuth + correction.horizontalOffsetCorrection * sinAzimuth);
-  point.z = static_cast<float> (distanceM * correction.sinVertCorrection + correction.cosVertOffsetCorrection);
-  point.intensity = static_cast<float> (laserReturn.intensity);
+      points.x[p] = xyDistance * sinCorrected - c.horizontalOffsetCorrection[l] * cosCorrected;
+      points.y[p] = xyDistance * cosCorrected + c.horizontalOffsetCorrection[l] * sinCorrected;
+      points.z[p] = distanceM * c.sinVertCorrection[l] + c.cosVertOffsetCorrection[l];
+      points.laser[p] = static_cast<unsigned char> (l);
+    }
+  }
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -470,20 +545,60 @@ void
 pcl::HDLGrabber::enqueueHDLPacket (const unsigned char *data,
     std::size_t bytesReceived)
 {
-  if (bytesReceived == 1206)
+  if (bytesReceived == HDL_PACKET_SIZE)
   {
-    unsigned char *dup = static_cast<unsigned char *> (malloc (bytesReceived * sizeof(unsigned char)));
+    // Only a PCAP replay running as fast as possible may wait for the consumer,
+    // packets arriving from the network can not be held back
+    unsigned char *dup = acquirePacketBuffer (as_fast_as_possible_ && !pcap_file_name_.empty ());
+    if (dup == NULL)
+      return;
     memcpy (dup, data, bytesReceived * sizeof(unsigned char));
 
+    // A stopped queue drops the packet, its buffer is freed with the pool
     hdl_data_.enqueue (dup);
   }
 }
 
+/////////////////////////////////////////////////////////////////////////////
+unsigned char *
+pcl::HDLGrabber::acquirePacketBuffer (bool wait)
+{
+  boost::unique_lock<boost::mutex> lock (packet_pool_mutex_);
+  while (wait && !terminate_read_packet_thread_ &&
+         free_packet_buffers_.empty () && packet_buffers_.size () >= HDL_MAX_POOLED_PACKETS)
+    packet_released_.wait (lock);
+
+  // stop () was called, the packet would not be processed anyway
+  if (terminate_read_packet_thread_)
+    return (NULL);
+
+  if (free_packet_buffers_.empty ())
+  {
+    packet_buffers_.push_back (new unsigned char[HDL_PACKET_SIZE]);
+    return (packet_buffers_.back ());
+  }
+  unsigned char *buffer = free_packet_buffers_.back ();
+  free_packet_buffers_.pop_back ();
+  return (buffer);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+void
+pcl::HDLGrabber::releasePacketBuffer (unsigned char *buffer)
+{
+  boost::unique_lock<boost::mutex> lock (packet_pool_mutex_);
+  free_packet_buffers_.push_back (buffer);
+  packet_released_.notify_one ();
+}
+
 /////////////////////////////////////////////////////////////////////////////
 void
 pcl::HDLGrabber::start ()
 {
-  terminate_read_packet_thread_ = false;
+  {
+    boost::unique_lock<boost::mutex> lock (packet_pool_mutex_);
+    terminate_read_packet_thread_ = false;
+  }
 
   if (isRunning ())
     return;
@@ -522,7 +637,12 @@ pcl::HDLGrabber::start ()
 void
 pcl::HDLGrabber::stop ()
 {
-  terminate_read_packet_thread_ = true;
+  // Wake up a reader waiting for a free packet buffer
+  {
+    boost::unique_lock<boost::mutex> lock (packet_pool_mutex_);
+    terminate_read_packet_thread_ = true;
+  }
+  packet_released_.notify_all ();
   hdl_data_.stopQueue ();
 
   if (hdl_read_packet_thread_ != NULL)
@@ -626,6 +746,13 @@ pcl::HDLGrabber::getMinimumDistanceThreshold() {
   return(min_distance_threshold_);
 }
 
+/////////////////////////////////////////////////////////////////////////////
+void
+pcl::HDLGrabber::setPlaybackAsFastAsPossible (bool enable)
+{
+  as_fast_as_possible_ = enable;
+}
+
 /////////////////////////////////////////////////////////////////////////////
 void
 pcl::HDLGrabber::readPacketsFromSocket ()
@@ -655,6 +782,11 @@ pcl::HDLGrabber::readPacketsFromPcap ()
   char errbuff[PCAP_ERRBUF_SIZE];
 
   pcap_t *pcap = pcap_open_offline (pcap_file_name_.c_str (), errbuff);
+  if (pcap == NULL)
+  {
+    PCL_ERROR ("[pcl::HDLGrabber::readPacketsFromPcap] Unable to open %s: %s\n", pcap_file_name_.c_str (), errbuff);
+    return;
+  }
 
   struct bpf_program filter;
   std::ostringstream stringStream;
@@ -680,33 +812,48 @@ pcl::HDLGrabber::readPacketsFromPcap ()
 
   lasttime.tv_sec = 0;
 
-  int returnValue = pcap_next_ex(pcap, &header, &data);
-
-  while (returnValue >= 0 && !terminate_read_packet_thread_)
+  // stop () interrupts this thread while it sleeps between packets, the file
+  // is closed however the loop is left
+  try
   {
-    if (lasttime.tv_sec == 0)
-    {
-      lasttime.tv_sec = header->ts.tv_sec;
-      lasttime.tv_usec = header->ts.tv_usec;
-    }
-    if (lasttime.tv_usec > header->ts.tv_usec)
+    int returnValue = pcap_next_ex(pcap, &header, &data);
+
+    while (returnValue >= 0 && !terminate_read_packet_thread_)
     {
-      lasttime.tv_usec -= 1000000;
-      lasttime.tv_sec++;
-    }
-    uSecDelay = ((header->ts.tv_sec - lasttime.tv_sec) * 1000000) +
-                (header->ts.tv_usec - lasttime.tv_usec);
+      if (lasttime.tv_sec == 0)
+      {
+        lasttime.tv_sec = header->ts.tv_sec;
+        lasttime.tv_usec = header->ts.tv_usec;
+      }
+      if (lasttime.tv_usec > header->ts.tv_usec)
+      {
+        lasttime.tv_usec -= 1000000;
+        lasttime.tv_sec++;
+      }
+      uSecDelay = ((header->ts.tv_sec - lasttime.tv_sec) * 1000000) +
+                  (header->ts.tv_usec - lasttime.tv_usec);
 
-    boost::this_thread::sleep(boost::posix_time::microseconds(uSecDelay));
+      if (!as_fast_as_possible_)
+        boost::this_thread::sleep(boost::posix_time::microseconds(uSecDelay));
 
-    lasttime.tv_sec = header->ts.tv_sec;
-    lasttime.tv_usec = header->ts.tv_usec;
+      lasttime.tv_sec = header->ts.tv_sec;
+      lasttime.tv_usec = header->ts.tv_usec;
 
-    // The ETHERNET header is 42 bytes long; unnecessary
-    enqueueHDLPacket(data + 42, header->len - 42);
+      // The ETHERNET header is 42 bytes long; unnecessary
+      enqueueHDLPacket(data + 42, header->len - 42);
 
-    returnValue = pcap_next_ex(pcap, &header, &data);
+      returnValue = pcap_next_ex(pcap, &header, &data);
+    }
+  }
+  catch (const boost::thread_interrupted&)
+  {
+  }
+  catch (...)
+  {
+    pcap_close (pcap);
+    throw;
   }
+  pcap_close (pcap);
 }
 #endif //#ifdef HAVE_PCAP
 
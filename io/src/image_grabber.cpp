@@ -43,6 +43,7 @@
 #include <pcl/for_each_type.h>
 #include <pcl/io/lzf_image_io.h>
 #include <pcl/console/time.h>
+#include <pcl/io/impl/read_ahead_queue.hpp>
 
 #ifdef PCL_BUILT_WITH_VTK
   #include <vtkImageReader2.h>
@@ -76,11 +77,43 @@ struct pcl::ImageGrabberBase::ImageGrabberImpl
                     float frames_per_second, 
                     bool repeat);
   
+  ~ImageGrabberImpl ();
+
   void 
   trigger ();
   //! Read ahead -- figure out whether we are in VTK image or PCLZF mode
   void 
   loadNextCloud ();
+
+  //! Publish the next cloud, returns false once there are no frames left
+  bool
+  publishNext ();
+  //! Publish clouds back to back until stopped or out of frames
+  void
+  playback ();
+  //! Set running_, which is shared by the playback thread and the callbacks
+  void
+  setRunning (bool running);
+  //! Get running_, which is shared by the playback thread and the callbacks
+  bool
+  isRunning () const;
+
+  //! A frame loaded by the read-ahead threads
+  struct Frame
+  {
+    pcl::PCLPointCloud2 cloud;
+    Eigen::Vector4f origin;
+    Eigen::Quaternionf orientation;
+    double fx, fy, cx, cy;
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  };
+
+  //! (Re)start the read-ahead threads from a given frame
+  void
+  startReadAhead (size_t first);
+  //! Load the frame at a given index, called from the read-ahead threads
+  bool
+  loadFrame (size_t idx, boost::shared_ptr<Frame> &frame) const;
   
   //! Get cloud at a particular location
   bool
@@ -135,6 +168,7 @@ struct pcl::ImageGrabberBase::ImageGrabberImpl
   float frames_per_second_;
   bool repeat_;
   bool running_;
+  mutable boost::mutex running_mutex_;
   // VTK
   std::vector<std::string> depth_image_files_;
   std::vector<std::string> rgb_image_files_;
@@ -168,6 +202,19 @@ struct pcl::ImageGrabberBase::ImageGrabberImpl
   double principal_point_y_;
 
   unsigned int num_threads_;
+
+  // Background loading and as fast as possible playback
+  boost::mutex read_ahead_mutex_;
+  size_t read_ahead_frames_;
+  unsigned int read_ahead_threads_;
+  bool as_fast_as_possible_;
+  boost::thread *playback_thread_;
+  pcl::ReadAheadQueue<boost::shared_ptr<Frame> > read_ahead_;
+#ifdef PCL_BUILT_WITH_VTK
+  // VTK creates its readers through a global object factory which is not thread safe, hence the
+  // read-ahead threads decode the image files one at a time
+  mutable boost::mutex vtk_reader_mutex_;
+#endif//PCL_BUILT_WITH_VTK
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -180,6 +227,7 @@ pcl::ImageGrabberBase::ImageGrabberImpl::ImageGrabberImpl (pcl::ImageGrabberBase
   , frames_per_second_ (frames_per_second)
   , repeat_ (repeat)
   , running_ (false)
+  , running_mutex_ ()
   , depth_image_files_ ()
   , rgb_image_files_ ()
   , time_trigger_ (1.0 / static_cast<double> (std::max (frames_per_second, 0.001f)), boost::bind (&ImageGrabberImpl::trigger, this))
@@ -195,6 +243,12 @@ pcl::ImageGrabberBase::ImageGrabberImpl::ImageGrabberImpl (pcl::ImageGrabberBase
   , principal_point_x_ (319.5)
   , principal_point_y_ (239.5)
   , num_threads_ (1)
+  , read_ahead_mutex_ ()
+  , read_ahead_frames_ (0)
+  , read_ahead_threads_ (1)
+  , as_fast_as_possible_ (false)
+  , playback_thread_ (0)
+  , read_ahead_ ()
 {
   if(pclzf_mode_)
   {
@@ -217,6 +271,7 @@ pcl::ImageGrabberBase::ImageGrabberImpl::ImageGrabberImpl (pcl::ImageGrabberBase
   , frames_per_second_ (frames_per_second)
   , repeat_ (repeat)
   , running_ (false)
+  , running_mutex_ ()
   , depth_image_files_ ()
   , rgb_image_files_ ()
   , time_trigger_ (1.0 / static_cast<double> (std::max (frames_per_second, 0.001f)), boost::bind (&ImageGrabberImpl::trigger, this))
@@ -232,6 +287,12 @@ pcl::ImageGrabberBase::ImageGrabberImpl::ImageGrabberImpl (pcl::ImageGrabberBase
   , principal_point_x_ (319.5)
   , principal_point_y_ (239.5)
   , num_threads_ (1)
+  , read_ahead_mutex_ ()
+  , read_ahead_frames_ (0)
+  , read_ahead_threads_ (1)
+  , as_fast_as_possible_ (false)
+  , playback_thread_ (0)
+  , read_ahead_ ()
 {
   loadDepthAndRGBFiles (depth_dir, rgb_dir);
   cur_frame_ = 0;
@@ -246,6 +307,7 @@ pcl::ImageGrabberBase::ImageGrabberImpl::ImageGrabberImpl (pcl::ImageGrabberBase
   , frames_per_second_ (frames_per_second)
   , repeat_ (repeat)
   , running_ (false)
+  , running_mutex_ ()
   , depth_image_files_ ()
   , rgb_image_files_ ()
   , time_trigger_ (1.0 / static_cast<double> (std::max (frames_per_second, 0.001f)), boost::bind (&ImageGrabberImpl::trigger, this))
@@ -261,11 +323,24 @@ pcl::ImageGrabberBase::ImageGrabberImpl::ImageGrabberImpl (pcl::ImageGrabberBase
   , principal_point_x_ (319.5)
   , principal_point_y_ (239.5)
   , num_threads_ (1)
+  , read_ahead_mutex_ ()
+  , read_ahead_frames_ (0)
+  , read_ahead_threads_ (1)
+  , as_fast_as_possible_ (false)
+  , playback_thread_ (0)
+  , read_ahead_ ()
 {
   depth_image_files_ = depth_image_files;
   cur_frame_ = 0;
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////
+pcl::ImageGrabberBase::ImageGrabberImpl::~ImageGrabberImpl ()
+{
+  // The loader threads use the file lists, stop them first
+  read_ahead_.stop ();
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 void 
 pcl::ImageGrabberBase::ImageGrabberImpl::loadNextCloud ()
@@ -289,12 +364,84 @@ pcl::ImageGrabberBase::ImageGrabberImpl::loadNextCloud ()
 void 
 pcl::ImageGrabberBase::ImageGrabberImpl::trigger ()
 {
+  publishNext ();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+bool
+pcl::ImageGrabberBase::ImageGrabberImpl::publishNext ()
+{
+  boost::mutex::scoped_lock read_ahead_lock (read_ahead_mutex_);
+  if (read_ahead_frames_ > 0)
+  {
+    size_t idx;
+    boost::shared_ptr<Frame> frame;
+    if (!read_ahead_.dequeue (idx, frame))
+      return (false);
+    cur_frame_ = idx + 1;
+    focal_length_x_ = frame->fx;
+    focal_length_y_ = frame->fy;
+    principal_point_x_ = frame->cx;
+    principal_point_y_ = frame->cy;
+    grabber_.publish (frame->cloud, frame->origin, frame->orientation);
+    return (true);
+  }
+
   if (valid_)
   {
     grabber_.publish (next_cloud_,origin_,orientation_);
   }
   // Preload the next cloud
   loadNextCloud ();
+  return (valid_ || cur_frame_ < numFrames ());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::ImageGrabberBase::ImageGrabberImpl::playback ()
+{
+  while (isRunning () && publishNext ())
+    ;
+  setRunning (false);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::ImageGrabberBase::ImageGrabberImpl::setRunning (bool running)
+{
+  boost::mutex::scoped_lock lock (running_mutex_);
+  running_ = running;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+bool
+pcl::ImageGrabberBase::ImageGrabberImpl::isRunning () const
+{
+  boost::mutex::scoped_lock lock (running_mutex_);
+  return (running_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::ImageGrabberBase::ImageGrabberImpl::startReadAhead (size_t first)
+{
+  if (read_ahead_frames_ == 0 || (!repeat_ && first >= numFrames ()))
+  {
+    read_ahead_.stop ();
+    return;
+  }
+  read_ahead_.start (boost::bind (&ImageGrabberImpl::loadFrame, this, _1, _2),
+                     first, numFrames (), repeat_,
+                     read_ahead_threads_, read_ahead_frames_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+bool
+pcl::ImageGrabberBase::ImageGrabberImpl::loadFrame (size_t idx, boost::shared_ptr<Frame> &frame) const
+{
+  frame.reset (new Frame);
+  return (getCloudAt (idx, frame->cloud, frame->origin, frame->orientation,
+                      frame->fx, frame->fy, frame->cx, frame->cy));
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -743,8 +890,8 @@ pcl::ImageGrabberBase::ImageGrabberImpl::getCloudPCLZF (size_t idx,
     else
     {
       if (!rgb.read (rgb_pclzf_file, cloud_color))
-        if (!yuv.readOMP (rgb_pclzf_file, cloud_color, num_threads_)) // Only YUV speeds up currently
-          bayer.read (rgb_pclzf_file, cloud_color);
+        if (!yuv.readOMP (rgb_pclzf_file, cloud_color, num_threads_))
+          bayer.readOMP (rgb_pclzf_file, cloud_color, num_threads_);
       depth.readOMP (depth_pclzf_file, cloud_color, num_threads_);
     }
     // handle timestamps
@@ -811,6 +958,7 @@ pcl::ImageGrabberBase::ImageGrabberImpl::getVtkImage (
     const std::string &filename, 
     vtkSmartPointer<vtkImageData> &image) const
 {
+  boost::mutex::scoped_lock vtk_reader_lock (vtk_reader_mutex_);
 
   vtkSmartPointer<vtkImageReader2> reader;
   // Check extension to generate the proper reader
@@ -901,12 +1049,25 @@ pcl::ImageGrabberBase::~ImageGrabberBase () throw ()
 void 
 pcl::ImageGrabberBase::start ()
 {
-  if (impl_->frames_per_second_ > 0)
+  if (impl_->as_fast_as_possible_)
   {
-    impl_->running_ = true;
+    // Called from a callback, i.e. by the playback thread itself: its loop simply goes on
+    if (impl_->playback_thread_ && impl_->playback_thread_->get_id () == boost::this_thread::get_id ())
+    {
+      impl_->setRunning (true);
+      return;
+    }
+    // Wait for a previous playback which ran out of frames
+    stop ();
+    impl_->setRunning (true);
+    impl_->playback_thread_ = new boost::thread (boost::bind (&ImageGrabberBase::ImageGrabberImpl::playback, impl_));
+  }
+  else if (impl_->frames_per_second_ > 0)
+  {
+    impl_->setRunning (true);
     impl_->time_trigger_.start ();
   }
-  else // manual trigger to preload the first cloud
+  else if (impl_->read_ahead_frames_ == 0) // manual trigger to preload the first cloud
     impl_->trigger ();
 }
 
@@ -914,10 +1075,21 @@ pcl::ImageGrabberBase::start ()
 void 
 pcl::ImageGrabberBase::stop ()
 {
+  if (impl_->playback_thread_)
+  {
+    impl_->setRunning (false);
+    // Called from a callback, i.e. by the playback thread itself, which exits once the callback
+    // returns; it is joined by the next call to start () or stop (), or by the destructor
+    if (impl_->playback_thread_->get_id () == boost::this_thread::get_id ())
+      return;
+    impl_->playback_thread_->join ();
+    delete impl_->playback_thread_;
+    impl_->playback_thread_ = 0;
+  }
   if (impl_->frames_per_second_ > 0)
   {
     impl_->time_trigger_.stop ();
-    impl_->running_ = false;
+    impl_->setRunning (false);
   }
 }
 
@@ -925,7 +1097,7 @@ pcl::ImageGrabberBase::stop ()
 void
 pcl::ImageGrabberBase::trigger ()
 {
-  if (impl_->frames_per_second_ > 0)
+  if (impl_->frames_per_second_ > 0 || impl_->as_fast_as_possible_)
     return;
   impl_->trigger ();
 }
@@ -934,7 +1106,7 @@ pcl::ImageGrabberBase::trigger ()
 bool 
 pcl::ImageGrabberBase::isRunning () const
 {
-  return (impl_->running_);
+  return (impl_->isRunning ());
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -948,7 +1120,10 @@ pcl::ImageGrabberBase::getName () const
 void 
 pcl::ImageGrabberBase::rewind ()
 {
+  boost::mutex::scoped_lock read_ahead_lock (impl_->read_ahead_mutex_);
   impl_->cur_frame_ = 0;
+  if (impl_->read_ahead_frames_ > 0)
+    impl_->startReadAhead (0);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -969,8 +1144,11 @@ pcl::ImageGrabberBase::isRepeatOn () const
 void
 pcl::ImageGrabberBase::setRGBImageFiles (const std::vector<std::string>& rgb_image_files) 
 {
+  boost::mutex::scoped_lock read_ahead_lock (impl_->read_ahead_mutex_);
+  impl_->read_ahead_.stop ();
   impl_->rgb_image_files_ = rgb_image_files;
   impl_->cur_frame_ = 0;
+  impl_->startReadAhead (0);
 }
 
 
@@ -981,6 +1159,9 @@ pcl::ImageGrabberBase::setCameraIntrinsics (const double focal_length_x,
                                             const double principal_point_x, 
                                             const double principal_point_y)
 {
+  boost::mutex::scoped_lock read_ahead_lock (impl_->read_ahead_mutex_);
+  // Frames loaded ahead used the previous intrinsics
+  impl_->read_ahead_.stop ();
   impl_->focal_length_x_ = focal_length_x;
   impl_->focal_length_y_ = focal_length_y;
   impl_->principal_point_x_ = principal_point_x;
@@ -992,6 +1173,7 @@ pcl::ImageGrabberBase::setCameraIntrinsics (const double focal_length_x,
     impl_->rewindOnce ();
     impl_->loadNextCloud ();
   }
+  impl_->startReadAhead (impl_->cur_frame_);
 }
 
 void
@@ -1012,7 +1194,10 @@ pcl::ImageGrabberBase::getCameraIntrinsics (double &focal_length_x,
 void
 pcl::ImageGrabberBase::setDepthImageUnits (const float units)
 {
+  boost::mutex::scoped_lock read_ahead_lock (impl_->read_ahead_mutex_);
+  impl_->read_ahead_.stop ();
   impl_->depth_image_units_ = units;
+  impl_->startReadAhead (impl_->cur_frame_);
 }
 ///////////////////////////////////////////////////////////////////////////////////////////
 size_t
@@ -1096,5 +1281,28 @@ pcl::ImageGrabberBase::getTimestampAtIndex (size_t idx, pcl::uint64_t &timestamp
 void
 pcl::ImageGrabberBase::setNumberOfThreads (unsigned int nr_threads)
 {
+  boost::mutex::scoped_lock read_ahead_lock (impl_->read_ahead_mutex_);
+  impl_->read_ahead_.stop ();
   impl_->num_threads_ = nr_threads;
+  impl_->startReadAhead (impl_->cur_frame_);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::ImageGrabberBase::setReadAhead (size_t max_frames, unsigned int nr_threads)
+{
+  boost::mutex::scoped_lock read_ahead_lock (impl_->read_ahead_mutex_);
+  impl_->read_ahead_frames_ = max_frames;
+  impl_->read_ahead_threads_ = std::max (nr_threads, 1u);
+  impl_->cur_frame_ = 0;
+  impl_->valid_ = false;
+  impl_->startReadAhead (0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::ImageGrabberBase::setPlaybackAsFastAsPossible (bool enable)
+{
+  stop ();
+  impl_->as_fast_as_possible_ = enable;
 }
@@ -40,9 +40,13 @@
 #include <pcl/console/print.h>
 #include <fcntl.h>
 #include <string.h>
+#include <algorithm>
 #include <boost/filesystem.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/xml_parser.hpp>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #ifdef _WIN32
 # include <io.h>
@@ -563,3 +567,76 @@ pcl::io::LZFDepth16ImageReader::readParameters (std::istream& is)
   return (true);
 }
 
+
+//////////////////////////////////////////////////////////////////////////////
+const int pcl::io::LZFYUV422ImageReader::CONVERSION_BLOCK_SIZE;
+
+//////////////////////////////////////////////////////////////////////////////
+void
+pcl::io::LZFYUV422ImageReader::convertToRGB (
+    const unsigned char *color_u, const unsigned char *color_y, const unsigned char *color_v,
+    unsigned char *color_r, unsigned char *color_g, unsigned char *color_b, int nr_pixel_pairs)
+{
+  int i = 0;
+#if defined(__SSE2__)
+  // 8 pixel pairs at a time. The chroma terms are computed in 32 bit with
+  // _mm_madd_epi16 on interleaved (v, u) pairs, so the result is identical to
+  // the scalar fixed point code below; 33292 does not fit in 16 bit and is
+  // applied as 2 * 16646.
+  const __m128i zero = _mm_setzero_si128 ();
+  const __m128i chroma_offset = _mm_set1_epi16 (128);
+  const __m128i rounding = _mm_set1_epi32 (8192);
+  const __m128i coeff_r = _mm_setr_epi16 (18678, 0, 18678, 0, 18678, 0, 18678, 0);
+  const __m128i coeff_g = _mm_setr_epi16 (-9519, -6472, -9519, -6472, -9519, -6472, -9519, -6472);
+  const __m128i coeff_b = _mm_setr_epi16 (0, 16646, 0, 16646, 0, 16646, 0, 16646);
+
+  for (; i + 8 <= nr_pixel_pairs; i += 8)
+  {
+    const __m128i u = _mm_sub_epi16 (_mm_unpacklo_epi8 (_mm_loadl_epi64 (reinterpret_cast<const __m128i*> (color_u + i)), zero), chroma_offset);
+    const __m128i v = _mm_sub_epi16 (_mm_unpacklo_epi8 (_mm_loadl_epi64 (reinterpret_cast<const __m128i*> (color_v + i)), zero), chroma_offset);
+    const __m128i vu_lo = _mm_unpacklo_epi16 (v, u);
+    const __m128i vu_hi = _mm_unpackhi_epi16 (v, u);
+
+    const __m128i r_offset = _mm_packs_epi32 (
+        _mm_srai_epi32 (_mm_add_epi32 (_mm_madd_epi16 (vu_lo, coeff_r), rounding), 14),
+        _mm_srai_epi32 (_mm_add_epi32 (_mm_madd_epi16 (vu_hi, coeff_r), rounding), 14));
+    const __m128i g_offset = _mm_packs_epi32 (
+        _mm_srai_epi32 (_mm_add_epi32 (_mm_madd_epi16 (vu_lo, coeff_g), rounding), 14),
+        _mm_srai_epi32 (_mm_add_epi32 (_mm_madd_epi16 (vu_hi, coeff_g), rounding), 14));
+    const __m128i b_offset = _mm_packs_epi32 (
+        _mm_srai_epi32 (_mm_add_epi32 (_mm_slli_epi32 (_mm_madd_epi16 (vu_lo, coeff_b), 1), rounding), 14),
+        _mm_srai_epi32 (_mm_add_epi32 (_mm_slli_epi32 (_mm_madd_epi16 (vu_hi, coeff_b), 1), rounding), 14));
+
+    // both pixels of a pair share the chroma, the saturating pack clips to [0, 255]
+    const __m128i y = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (color_y + 2 * i));
+    const __m128i y_lo = _mm_unpacklo_epi8 (y, zero);
+    const __m128i y_hi = _mm_unpackhi_epi8 (y, zero);
+
+    _mm_storeu_si128 (reinterpret_cast<__m128i*> (color_r + 2 * i),
+                      _mm_packus_epi16 (_mm_add_epi16 (y_lo, _mm_unpacklo_epi16 (r_offset, r_offset)),
+                                        _mm_add_epi16 (y_hi, _mm_unpackhi_epi16 (r_offset, r_offset))));
+    _mm_storeu_si128 (reinterpret_cast<__m128i*> (color_g + 2 * i),
+                      _mm_packus_epi16 (_mm_add_epi16 (y_lo, _mm_unpacklo_epi16 (g_offset, g_offset)),
+                                        _mm_add_epi16 (y_hi, _mm_unpackhi_epi16 (g_offset, g_offset))));
+    _mm_storeu_si128 (reinterpret_cast<__m128i*> (color_b + 2 * i),
+                      _mm_packus_epi16 (_mm_add_epi16 (y_lo, _mm_unpacklo_epi16 (b_offset, b_offset)),
+                                        _mm_add_epi16 (y_hi, _mm_unpackhi_epi16 (b_offset, b_offset))));
+  }
+#endif
+
+  for (; i < nr_pixel_pairs; ++i)
+  {
+    int v = color_v[i] - 128;
+    int u = color_u[i] - 128;
+    int r = (v * 18678 + 8192 ) >> 14;
+    int g = (v * -9519 - u * 6472 + 8192) >> 14;
+    int b = (u * 33292 + 8192 ) >> 14;
+
+    for (int j = 2 * i; j < 2 * i + 2; ++j)
+    {
+      color_r[j] = static_cast<unsigned char> (std::min (255, std::max (0, color_y[j] + r)));
+      color_g[j] = static_cast<unsigned char> (std::min (255, std::max (0, color_y[j] + g)));
+      color_b[j] = static_cast<unsigned char> (std::min (255, std::max (0, color_y[j] + b)));
+    }
+  }
+}
@@ -41,6 +41,7 @@
 #include <pcl/point_types.h>
 #include <pcl/io/pcd_io.h>
 #include <pcl/io/tar.h>
+#include <pcl/io/impl/read_ahead_queue.hpp>
         
 #ifdef _WIN32
 # include <io.h>
@@ -61,8 +62,36 @@ struct pcl::PCDGrabberBase::PCDGrabberImpl
 {
   PCDGrabberImpl (pcl::PCDGrabberBase& grabber, const std::string& pcd_path, float frames_per_second, bool repeat);
   PCDGrabberImpl (pcl::PCDGrabberBase& grabber, const std::vector<std::string>& pcd_files, float frames_per_second, bool repeat);
+  ~PCDGrabberImpl ();
   void trigger ();
   void readAhead ();
+
+  //! Publish the next cloud, returns false once there are no clouds left
+  bool publishNext ();
+  //! Publish clouds back to back until stopped or out of clouds
+  void playback ();
+  //! Set running_, which is shared by the playback thread and the callbacks
+  void setRunning (bool running);
+  //! Get running_, which is shared by the playback thread and the callbacks
+  bool isRunning () const;
+  //! Update has_next_ from the clouds left, called with read_ahead_mutex_ held
+  void updateHasNext ();
+  //! Get has_next_, without waiting for a playback or loader thread holding read_ahead_mutex_
+  bool hasNext () const;
+
+  //! A cloud loaded by the read-ahead threads
+  struct Frame
+  {
+    pcl::PCLPointCloud2 cloud;
+    Eigen::Vector4f origin;
+    Eigen::Quaternionf orientation;
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  };
+
+  //! (Re)start the read-ahead threads from the first cloud
+  void startReadAhead ();
+  //! Load the cloud at a given index, called from the read-ahead threads
+  bool loadFrame (size_t idx, boost::shared_ptr<Frame> &frame);
   
   // TAR reading I/O
   int openTARFile (const std::string &file_name);
@@ -88,6 +117,9 @@ struct pcl::PCDGrabberBase::PCDGrabberImpl
   float frames_per_second_;
   bool repeat_;
   bool running_;
+  //! Whether clouds are left to publish, a copy of the read-ahead state for isRunning ()
+  bool has_next_;
+  mutable boost::mutex running_mutex_;
   std::vector<std::string> pcd_files_;
   std::vector<std::string>::iterator pcd_iterator_;
   TimeTrigger time_trigger_;
@@ -112,6 +144,13 @@ struct pcl::PCDGrabberBase::PCDGrabberImpl
   // simultaneous asynchronous read-aheads
   boost::mutex read_ahead_mutex_;
 
+  // Background loading and as fast as possible playback
+  size_t read_ahead_frames_;
+  unsigned int read_ahead_threads_;
+  bool as_fast_as_possible_;
+  boost::thread *playback_thread_;
+  pcl::ReadAheadQueue<boost::shared_ptr<Frame> > read_ahead_;
+
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW 
 };
 
@@ -121,6 +160,8 @@ pcl::PCDGrabberBase::PCDGrabberImpl::PCDGrabberImpl (pcl::PCDGrabberBase& grabbe
   , frames_per_second_ (frames_per_second)
   , repeat_ (repeat)
   , running_ (false)
+  , has_next_ (false)
+  , running_mutex_ ()
   , pcd_files_ ()
   , pcd_iterator_ ()
   , time_trigger_ (1.0 / static_cast<double> (std::max (frames_per_second, 0.001f)), boost::bind (&PCDGrabberImpl::trigger, this))
@@ -133,10 +174,15 @@ pcl::PCDGrabberBase::PCDGrabberImpl::PCDGrabberImpl (pcl::PCDGrabberBase& grabbe
   , tar_file_ ()
   , tar_header_ ()
   , scraped_ (false)
+  , read_ahead_frames_ (0)
+  , read_ahead_threads_ (1)
+  , as_fast_as_possible_ (false)
+  , playback_thread_ (0)
 {
   pcd_files_.push_back (pcd_path);
   pcd_iterator_ = pcd_files_.begin ();
   readAhead ();
+  updateHasNext ();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -145,6 +191,8 @@ pcl::PCDGrabberBase::PCDGrabberImpl::PCDGrabberImpl (pcl::PCDGrabberBase& grabbe
   , frames_per_second_ (frames_per_second)
   , repeat_ (repeat)
   , running_ (false)
+  , has_next_ (false)
+  , running_mutex_ ()
   , pcd_files_ ()
   , pcd_iterator_ ()
   , time_trigger_ (1.0 / static_cast<double> (std::max (frames_per_second, 0.001f)), boost::bind (&PCDGrabberImpl::trigger, this))
@@ -157,10 +205,22 @@ pcl::PCDGrabberBase::PCDGrabberImpl::PCDGrabberImpl (pcl::PCDGrabberBase& grabbe
   , tar_file_ ()
   , tar_header_ ()
   , scraped_ (false)
+  , read_ahead_frames_ (0)
+  , read_ahead_threads_ (1)
+  , as_fast_as_possible_ (false)
+  , playback_thread_ (0)
 {
   pcd_files_ = pcd_files;
   pcd_iterator_ = pcd_files_.begin ();
   readAhead ();
+  updateHasNext ();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+pcl::PCDGrabberBase::PCDGrabberImpl::~PCDGrabberImpl ()
+{
+  // The loader threads use the file lists, stop them first
+  read_ahead_.stop ();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -285,13 +345,107 @@ pcl::PCDGrabberBase::PCDGrabberImpl::openTARFile (const std::string &file_name)
 ///////////////////////////////////////////////////////////////////////////////////////////
 void 
 pcl::PCDGrabberBase::PCDGrabberImpl::trigger ()
+{
+  publishNext ();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+bool
+pcl::PCDGrabberBase::PCDGrabberImpl::publishNext ()
 {
   boost::mutex::scoped_lock read_ahead_lock(read_ahead_mutex_);
+  if (read_ahead_frames_ > 0)
+  {
+    size_t idx;
+    boost::shared_ptr<Frame> frame;
+    bool dequeued = read_ahead_.dequeue (idx, frame);
+    updateHasNext ();
+    if (!dequeued)
+      return (false);
+    grabber_.publish (frame->cloud, frame->origin, frame->orientation);
+    return (true);
+  }
+
   if (valid_)
     grabber_.publish (next_cloud_,origin_,orientation_);
 
   // use remaining time, if there is time left!
   readAhead ();
+  updateHasNext ();
+  return (valid_ || pcd_iterator_ != pcd_files_.end () || tar_fd_ != -1);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::PCDGrabberBase::PCDGrabberImpl::playback ()
+{
+  while (isRunning () && publishNext ())
+    ;
+  setRunning (false);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::PCDGrabberBase::PCDGrabberImpl::setRunning (bool running)
+{
+  boost::mutex::scoped_lock lock (running_mutex_);
+  running_ = running;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+bool
+pcl::PCDGrabberBase::PCDGrabberImpl::isRunning () const
+{
+  boost::mutex::scoped_lock lock (running_mutex_);
+  return (running_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::PCDGrabberBase::PCDGrabberImpl::updateHasNext ()
+{
+  bool has_next;
+  if (read_ahead_frames_ > 0)
+    has_next = read_ahead_.hasNext ();
+  else
+    has_next = (pcd_iterator_ != pcd_files_.end ());
+  boost::mutex::scoped_lock lock (running_mutex_);
+  has_next_ = has_next;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+bool
+pcl::PCDGrabberBase::PCDGrabberImpl::hasNext () const
+{
+  boost::mutex::scoped_lock lock (running_mutex_);
+  return (has_next_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::PCDGrabberBase::PCDGrabberImpl::startReadAhead ()
+{
+  if (read_ahead_frames_ == 0)
+    read_ahead_.stop ();
+  else
+  {
+    scrapeForClouds ();
+    read_ahead_.start (boost::bind (&PCDGrabberImpl::loadFrame, this, _1, _2),
+                       0, cloud_idx_to_file_idx_.size (), repeat_,
+                       read_ahead_threads_, read_ahead_frames_);
+  }
+  updateHasNext ();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+bool
+pcl::PCDGrabberBase::PCDGrabberImpl::loadFrame (size_t idx, boost::shared_ptr<Frame> &frame)
+{
+  frame.reset (new Frame);
+  PCDReader reader;
+  int pcd_version;
+  const std::string &filename = pcd_files_[cloud_idx_to_file_idx_[idx]];
+  return (reader.read (filename, frame->cloud, frame->origin, frame->orientation, pcd_version, tar_offsets_[idx]) == 0);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -395,9 +549,22 @@ pcl::PCDGrabberBase::~PCDGrabberBase () throw ()
 void 
 pcl::PCDGrabberBase::start ()
 {
-  if (impl_->frames_per_second_ > 0)
+  if (impl_->as_fast_as_possible_)
   {
-    impl_->running_ = true;
+    // Called from a callback, i.e. by the playback thread itself: its loop simply goes on
+    if (impl_->playback_thread_ && impl_->playback_thread_->get_id () == boost::this_thread::get_id ())
+    {
+      impl_->setRunning (true);
+      return;
+    }
+    // Wait for a previous playback which ran out of clouds
+    stop ();
+    impl_->setRunning (true);
+    impl_->playback_thread_ = new boost::thread (boost::bind (&PCDGrabberBase::PCDGrabberImpl::playback, impl_));
+  }
+  else if (impl_->frames_per_second_ > 0)
+  {
+    impl_->setRunning (true);
     impl_->time_trigger_.start ();
   }
   else // manual trigger
@@ -410,10 +577,21 @@ pcl::PCDGrabberBase::start ()
 void 
 pcl::PCDGrabberBase::stop ()
 {
+  if (impl_->playback_thread_)
+  {
+    impl_->setRunning (false);
+    // Called from a callback, i.e. by the playback thread itself, which exits once the callback
+    // returns; it is joined by the next call to start () or stop (), or by the destructor
+    if (impl_->playback_thread_->get_id () == boost::this_thread::get_id ())
+      return;
+    impl_->playback_thread_->join ();
+    delete impl_->playback_thread_;
+    impl_->playback_thread_ = 0;
+  }
   if (impl_->frames_per_second_ > 0)
   {
     impl_->time_trigger_.stop ();
-    impl_->running_ = false;
+    impl_->setRunning (false);
   }
 }
 
@@ -421,7 +599,7 @@ pcl::PCDGrabberBase::stop ()
 void
 pcl::PCDGrabberBase::trigger ()
 {
-  if (impl_->frames_per_second_ > 0)
+  if (impl_->frames_per_second_ > 0 || impl_->as_fast_as_possible_)
     return;
   boost::thread non_blocking_call (boost::bind (&PCDGrabberBase::PCDGrabberImpl::trigger, impl_));
 
@@ -432,7 +610,10 @@ pcl::PCDGrabberBase::trigger ()
 bool 
 pcl::PCDGrabberBase::isRunning () const
 {
-  return (impl_->running_ && (impl_->pcd_iterator_ != impl_->pcd_files_.end()));
+  if (impl_->as_fast_as_possible_)
+    return (impl_->isRunning ());
+  // The playback thread holds read_ahead_mutex_ while it publishes, so use the copy of the read-ahead state
+  return (impl_->isRunning () && impl_->hasNext ());
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -446,7 +627,12 @@ pcl::PCDGrabberBase::getName () const
 void 
 pcl::PCDGrabberBase::rewind ()
 {
+  boost::mutex::scoped_lock read_ahead_lock (impl_->read_ahead_mutex_);
   impl_->pcd_iterator_ = impl_->pcd_files_.begin ();
+  if (impl_->read_ahead_frames_ > 0)
+    impl_->startReadAhead ();
+  else
+    impl_->updateHasNext ();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -463,6 +649,24 @@ pcl::PCDGrabberBase::isRepeatOn () const
   return (impl_->repeat_);
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::PCDGrabberBase::setReadAhead (size_t max_frames, unsigned int nr_threads)
+{
+  boost::mutex::scoped_lock read_ahead_lock (impl_->read_ahead_mutex_);
+  impl_->read_ahead_frames_ = max_frames;
+  impl_->read_ahead_threads_ = std::max (nr_threads, 1u);
+  impl_->startReadAhead ();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::PCDGrabberBase::setPlaybackAsFastAsPossible (bool enable)
+{
+  stop ();
+  impl_->as_fast_as_possible_ = enable;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 bool
 pcl::PCDGrabberBase::getCloudAt (size_t idx, 
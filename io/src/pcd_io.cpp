@@ -40,6 +40,7 @@
 #include <fstream>
 #include <fcntl.h>
 #include <string>
+#include <algorithm>
 #include <stdlib.h>
 #include <pcl/io/boost.h>
 #include <pcl/common/io.h>
@@ -64,6 +65,193 @@
 #endif
 #include <boost/version.hpp>
 
+///////////////////////////////////////////////////////////////////////////////////////////
+/** \brief Go over each field of a cloud and check that none of its values is NaN or Inf. */
+static bool
+hasOnlyFiniteValues (const pcl::PCLPointCloud2 &cloud)
+{
+  const int point_size = static_cast<int> (cloud.point_step);
+  for (uint32_t i = 0; i < cloud.width * cloud.height; ++i)
+  {
+    for (unsigned int d = 0; d < static_cast<unsigned int> (cloud.fields.size ()); ++d)
+    {
+      for (uint32_t c = 0; c < cloud.fields[d].count; ++c)
+      {
+        switch (cloud.fields[d].datatype)
+        {
+          case pcl::PCLPointField::INT8:
+          {
+            if (!pcl::isValueFinite<pcl::traits::asType<pcl::PCLPointField::INT8>::type>(cloud, i, point_size, d, c))
+              return (false);
+            break;
+          }
+          case pcl::PCLPointField::UINT8:
+          {
+            if (!pcl::isValueFinite<pcl::traits::asType<pcl::PCLPointField::UINT8>::type>(cloud, i, point_size, d, c))
+              return (false);
+            break;
+          }
+          case pcl::PCLPointField::INT16:
+          {
+            if (!pcl::isValueFinite<pcl::traits::asType<pcl::PCLPointField::INT16>::type>(cloud, i, point_size, d, c))
+              return (false);
+            break;
+          }
+          case pcl::PCLPointField::UINT16:
+          {
+            if (!pcl::isValueFinite<pcl::traits::asType<pcl::PCLPointField::UINT16>::type>(cloud, i, point_size, d, c))
+              return (false);
+            break;
+          }
+          case pcl::PCLPointField::INT32:
+          {
+            if (!pcl::isValueFinite<pcl::traits::asType<pcl::PCLPointField::INT32>::type>(cloud, i, point_size, d, c))
+              return (false);
+            break;
+          }
+          case pcl::PCLPointField::UINT32:
+          {
+            if (!pcl::isValueFinite<pcl::traits::asType<pcl::PCLPointField::UINT32>::type>(cloud, i, point_size, d, c))
+              return (false);
+            break;
+          }
+          case pcl::PCLPointField::FLOAT32:
+          {
+            if (!pcl::isValueFinite<pcl::traits::asType<pcl::PCLPointField::FLOAT32>::type>(cloud, i, point_size, d, c))
+              return (false);
+            break;
+          }
+          case pcl::PCLPointField::FLOAT64:
+          {
+            if (!pcl::isValueFinite<pcl::traits::asType<pcl::PCLPointField::FLOAT64>::type>(cloud, i, point_size, d, c))
+              return (false);
+            break;
+          }
+        }
+      }
+    }
+  }
+  return (true);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+static bool
+fieldOffsetLess (const pcl::PCLPointField &a, const pcl::PCLPointField &b)
+{
+  return (a.offset < b.offset);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+/** \brief Sort the fields of a cloud in the order of their data, as the binary PCD header lists them. */
+static std::vector<pcl::PCLPointField>
+sortFieldsByOffset (const std::vector<pcl::PCLPointField> &fields)
+{
+  std::vector<pcl::PCLPointField> sorted (fields);
+  std::stable_sort (sorted.begin (), sorted.end (), fieldOffsetLess);
+  return (sorted);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+static inline bool
+isSeparator (char c)
+{
+  return (c == ' ' || c == '\t' || c == '\r');
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+/** \brief Check whether the line [begin, end) holds only separators. */
+static bool
+isBlankLine (const char *begin, const char *end)
+{
+  for (; begin != end; ++begin)
+    if (!isSeparator (*begin))
+      return (false);
+  return (true);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+template <typename Type> static inline bool
+copyParsedValue (const char *begin, const char *end, pcl::PCLPointCloud2 &cloud,
+                 unsigned int point_index, unsigned int field_idx, unsigned int fields_count)
+{
+  Type value;
+  bool is_finite = pcl::parseStringValue<Type> (begin, end, value);
+  memcpy (&cloud.data[static_cast<size_t> (point_index) * cloud.point_step +
+                      cloud.fields[field_idx].offset +
+                      fields_count * sizeof (Type)], reinterpret_cast<char*> (&value), sizeof (Type));
+  return (is_finite);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+/** \brief Parse the values of one point from the ASCII line [begin, end) into a cloud.
+  * \param[in] begin the first character of the line
+  * \param[in] end the end of the line
+  * \param[out] cloud the cloud to copy the values to
+  * \param[in] point_index the index of the point
+  * \param[out] is_dense set to false if one of the values is NaN
+  * \return false if the line holds less values than the fields of the cloud
+  */
+static bool
+copyASCIIPoint (const char *begin, const char *end, pcl::PCLPointCloud2 &cloud,
+                unsigned int point_index, bool &is_dense)
+{
+  const char *p = begin;
+  for (unsigned int d = 0; d < static_cast<unsigned int> (cloud.fields.size ()); ++d)
+  {
+    for (unsigned int c = 0; c < cloud.fields[d].count; ++c)
+    {
+      // Find the next value
+      while (p != end && isSeparator (*p))
+        ++p;
+      if (p == end)
+        return (false);
+      const char *value_end = p;
+      while (value_end != end && !isSeparator (*value_end))
+        ++value_end;
+
+      // Ignore invalid padded dimensions that are inherited from binary data
+      if (cloud.fields[d].name != "_")
+      {
+        bool is_finite = true;
+        switch (cloud.fields[d].datatype)
+        {
+          case pcl::PCLPointField::INT8:
+            is_finite = copyParsedValue<pcl::traits::asType<pcl::PCLPointField::INT8>::type> (p, value_end, cloud, point_index, d, c);
+            break;
+          case pcl::PCLPointField::UINT8:
+            is_finite = copyParsedValue<pcl::traits::asType<pcl::PCLPointField::UINT8>::type> (p, value_end, cloud, point_index, d, c);
+            break;
+          case pcl::PCLPointField::INT16:
+            is_finite = copyParsedValue<pcl::traits::asType<pcl::PCLPointField::INT16>::type> (p, value_end, cloud, point_index, d, c);
+            break;
+          case pcl::PCLPointField::UINT16:
+            is_finite = copyParsedValue<pcl::traits::asType<pcl::PCLPointField::UINT16>::type> (p, value_end, cloud, point_index, d, c);
+            break;
+          case pcl::PCLPointField::INT32:
+            is_finite = copyParsedValue<pcl::traits::asType<pcl::PCLPointField::INT32>::type> (p, value_end, cloud, point_index, d, c);
+            break;
+          case pcl::PCLPointField::UINT32:
+            is_finite = copyParsedValue<pcl::traits::asType<pcl::PCLPointField::UINT32>::type> (p, value_end, cloud, point_index, d, c);
+            break;
+          case pcl::PCLPointField::FLOAT32:
+            is_finite = copyParsedValue<pcl::traits::asType<pcl::PCLPointField::FLOAT32>::type> (p, value_end, cloud, point_index, d, c);
+            break;
+          case pcl::PCLPointField::FLOAT64:
+            is_finite = copyParsedValue<pcl::traits::asType<pcl::PCLPointField::FLOAT64>::type> (p, value_end, cloud, point_index, d, c);
+            break;
+          default:
+            PCL_WARN ("[pcl::PCDReader::read] Incorrect field data type specified (%d)!\n",cloud.fields[d].datatype);
+            break;
+        }
+        if (!is_finite)
+          is_dense = false;
+      }
+      p = value_end;
+    }
+  }
+  return (true);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 void
 pcl::PCDWriter::setLockingPermissions (const std::string &file_name,
@@ -111,6 +299,16 @@ int
 pcl::PCDReader::readHeader (const std::string &file_name, pcl::PCLPointCloud2 &cloud,
                             Eigen::Vector4f &origin, Eigen::Quaternionf &orientation, 
                             int &pcd_version, int &data_type, unsigned int &data_idx, const int offset)
+{
+  return (readHeader (file_name, cloud, origin, orientation, pcd_version, data_type, data_idx, offset, true));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+int
+pcl::PCDReader::readHeader (const std::string &file_name, pcl::PCLPointCloud2 &cloud,
+                            Eigen::Vector4f &origin, Eigen::Quaternionf &orientation, 
+                            int &pcd_version, int &data_type, unsigned int &data_idx, const int offset,
+                            bool allocate_data)
 {
   // Default values
   data_idx = 0;
@@ -322,8 +520,6 @@ pcl::PCDReader::readHeader (const std::string &file_name, pcl::PCLPointCloud2 &c
       if (line_type.substr (0, 6) == "POINTS")
       {
         sstream >> nr_points;
-        // Need to allocate: N * point_step
-        cloud.data.resize (nr_points * cloud.point_step);
         continue;
       }
 
@@ -331,7 +527,9 @@ pcl::PCDReader::readHeader (const std::string &file_name, pcl::PCLPointCloud2 &c
       if (line_type.substr (0, 4) == "DATA")
       {
         data_idx = static_cast<int> (fs.tellg ());
-        if (st.at (1).substr (0, 17) == "binary_compressed")
+        if (st.at (1).substr (0, 25) == "binary_compressed_chunked")
+          data_type = 3;
+        else if (st.at (1).substr (0, 17) == "binary_compressed")
          data_type = 2;
         else
           if (st.at (1).substr (0, 6) == "binary")
@@ -390,6 +588,10 @@ pcl::PCDReader::readHeader (const std::string &file_name, pcl::PCLPointCloud2 &c
     return (-1);
   }
 
+  // Need to allocate: N * point_step
+  if (allocate_data)
+    cloud.data.resize (static_cast<size_t> (nr_points) * cloud.point_step);
+
   // Close file
   fs.close ();
 
@@ -694,121 +896,128 @@ pcl::PCDReader::read (const std::string &file_name, pcl::PCLPointCloud2 &cloud,
   // if ascii
   if (data_type == 0)
   {
-    // Re-open the file (readHeader closes it)
-    std::ifstream fs;
-    fs.open (file_name.c_str ());
-    if (!fs.is_open () || fs.fail ())
+    // Map the whole file (readHeader closes it)
+    int fd = pcl_open (file_name.c_str (), O_RDONLY);
+    if (fd == -1)
     {
       PCL_ERROR ("[pcl::PCDReader::read] Could not open file %s.\n", file_name.c_str ());
       return (-1);
     }
+    size_t file_size = static_cast<size_t> (boost::filesystem::file_size (file_name));
+#ifdef _WIN32
+    HANDLE fm = CreateFileMapping ((HANDLE) _get_osfhandle (fd), NULL, PAGE_READONLY, 0, 0, NULL);
+    char *map = static_cast<char*>(MapViewOfFile (fm, FILE_MAP_READ, 0, 0, 0));
+    if (map == NULL)
+    {
+      CloseHandle (fm);
+      pcl_close (fd);
+      PCL_ERROR ("[pcl::PCDReader::read] Error mapping view of file, %s\n", file_name.c_str ());
+      return (-1);
+    }
+#else
+    char *map = static_cast<char*> (mmap (0, file_size, PROT_READ, MAP_SHARED, fd, 0));
+    if (map == reinterpret_cast<char*> (-1))    // MAP_FAILED
+    {
+      pcl_close (fd);
+      PCL_ERROR ("[pcl::PCDReader::read] Error preparing mmap for ASCII PCD file.\n");
+      return (-1);
+    }
+#endif
 
-    fs.seekg (data_idx);
-
-    std::string line;
-    std::vector<std::string> st;
+    // Split the data in one block of whole lines per thread
+    const char *data = map + (std::min) (static_cast<size_t> (data_idx), file_size);
+    const char *data_end = map + file_size;
+    const int nr_blocks = static_cast<int> ((std::max) (1u, (std::min) (threads_, static_cast<unsigned int> ((data_end - data) / 65536 + 1))));
+    std::vector<const char*> blocks (nr_blocks + 1, data_end);
+    blocks[0] = data;
+    for (int b = 1; b < nr_blocks; ++b)
+    {
+      const char *p = (std::max) (data + (data_end - data) * static_cast<ptrdiff_t> (b) / nr_blocks, blocks[b - 1]);
+      p = static_cast<const char*> (memchr (p, '\n', data_end - p));
+      blocks[b] = p ? p + 1 : data_end;
+    }
 
-    // Read the rest of the file
-    try
+    // Count the points of each block, to know where each block starts in the cloud
+    std::vector<unsigned int> block_points (nr_blocks + 1, 0);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nr_blocks)
+#endif
+    for (int b = 0; b < nr_blocks; ++b)
     {
-      while (idx < nr_points && !fs.eof ())
+      for (const char *line = blocks[b]; line < blocks[b + 1]; )
       {
-        getline (fs, line);
-        // Ignore empty lines
-        if (line == "")
-          continue;
-
-        // Tokenize the line
-        boost::trim (line);
-        boost::split (st, line, boost::is_any_of ("\t\r "), boost::token_compress_on);
-        
-        if (idx >= nr_points)
-        {
-          PCL_WARN ("[pcl::PCDReader::read] input file %s has more points (%d) than advertised (%d)!\n", file_name.c_str (), idx, nr_points);
-          break;
-        }
-
-        size_t total = 0;
-        // Copy data
-        for (unsigned int d = 0; d < static_cast<unsigned int> (cloud.fields.size ()); ++d)
+        const char *line_end = static_cast<const char*> (memchr (line, '\n', blocks[b + 1] - line));
+        if (!line_end)
+          line_end = blocks[b + 1];
+        if (!isBlankLine (line, line_end))
+          ++block_points[b + 1];
+        line = line_end + 1;
+      }
+    }
+    for (int b = 0; b < nr_blocks; ++b)
+      block_points[b + 1] += block_points[b];
+    if (block_points[nr_blocks] > nr_points)
+      PCL_WARN ("[pcl::PCDReader::read] input file %s has more points (%d) than advertised (%d)!\n", file_name.c_str (), block_points[nr_blocks], nr_points);
+    idx = (std::min) (block_points[nr_blocks], nr_points);
+
+    // Parse the blocks. A point is read from each line, without splitting it in tokens
+    std::vector<int> dense (nr_blocks, 1);
+    std::vector<int> failed (nr_blocks, 0);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nr_blocks)
+#endif
+    for (int b = 0; b < nr_blocks; ++b)
+    {
+      unsigned int point_index = block_points[b];
+      for (const char *line = blocks[b]; line < blocks[b + 1] && point_index < nr_points; )
+      {
+        const char *line_end = static_cast<const char*> (memchr (line, '\n', blocks[b + 1] - line));
+        if (!line_end)
+          line_end = blocks[b + 1];
+        if (!isBlankLine (line, line_end))
         {
-          // Ignore invalid padded dimensions that are inherited from binary data
-          if (cloud.fields[d].name == "_")
-          {
-            total += cloud.fields[d].count; // jump over this many elements in the string token
-            continue;
-          }
-          for (unsigned int c = 0; c < cloud.fields[d].count; ++c)
+          bool is_dense = true;
+          if (!copyASCIIPoint (line, line_end, cloud, point_index, is_dense))
           {
-            switch (cloud.fields[d].datatype)
-            {
-              case pcl::PCLPointField::INT8:
-              {
-                copyStringValue<pcl::traits::asType<pcl::PCLPointField::INT8>::type> (
-                    st.at (total + c), cloud, idx, d, c);
-                break;
-              }
-              case pcl::PCLPointField::UINT8:
-              {
-                copyStringValue<pcl::traits::asType<pcl::PCLPointField::UINT8>::type> (
-                    st.at (total + c), cloud, idx, d, c);
-                break;
-              }
-              case pcl::PCLPointField::INT16:
-              {
-                copyStringValue<pcl::traits::asType<pcl::PCLPointField::INT16>::type> (
-                    st.at (total + c), cloud, idx, d, c);
-                break;
-              }
-              case pcl::PCLPointField::UINT16:
-              {
-                copyStringValue<pcl::traits::asType<pcl::PCLPointField::UINT16>::type> (
-                    st.at (total + c), cloud, idx, d, c);
-                break;
-              }
-              case pcl::PCLPointField::INT32:
-              {
-                copyStringValue<pcl::traits::asType<pcl::PCLPointField::INT32>::type> (
-                    st.at (total + c), cloud, idx, d, c);
-                break;
-              }
-              case pcl::PCLPointField::UINT32:
-              {
-                copyStringValue<pcl::traits::asType<pcl::PCLPointField::UINT32>::type> (
-                    st.at (total + c), cloud, idx, d, c);
-                break;
-              }
-              case pcl::PCLPointField::FLOAT32:
-              {
-                copyStringValue<pcl::traits::asType<pcl::PCLPointField::FLOAT32>::type> (
-                    st.at (total + c), cloud, idx, d, c);
-                break;
-              }
-              case pcl::PCLPointField::FLOAT64:
-              {
-                copyStringValue<pcl::traits::asType<pcl::PCLPointField::FLOAT64>::type> (
-                    st.at (total + c), cloud, idx, d, c);
-                break;
-              }
-              default:
-                PCL_WARN ("[pcl::PCDReader::read] Incorrect field data type specified (%d)!\n",cloud.fields[d].datatype);
-                break;
-            }
+            failed[b] = 1;
+            break;
           }
-          total += cloud.fields[d].count; // jump over this many elements in the string token
+          if (!is_dense)
+            dense[b] = 0;
+          ++point_index;
         }
-        idx++;
+        line = line_end + 1;
       }
     }
-    catch (const char *exception)
+
+    // Unmap the pages of memory
+#ifdef _WIN32
+    UnmapViewOfFile (map);
+    CloseHandle (fm);
+#else
+    munmap (map, file_size);
+#endif
+    pcl_close (fd);
+
+    for (int b = 0; b < nr_blocks; ++b)
     {
-      PCL_ERROR ("[pcl::PCDReader::read] %s\n", exception);
-      fs.close ();
-      return (-1);
+      if (failed[b])
+      {
+        PCL_ERROR ("[pcl::PCDReader::read] Not enough values for all the fields of a point in %s!\n", file_name.c_str ());
+        return (-1);
+      }
+      if (!dense[b])
+        cloud.is_dense = false;
     }
-
-    // Close file
-    fs.close ();
+  }
+  /// ---[ Binary compressed chunked mode only
+  else if (data_type == 3)
+  {
+    std::vector<int> field_indices (cloud.fields.size ());
+    for (size_t d = 0; d < cloud.fields.size (); ++d)
+      field_indices[d] = static_cast<int> (d);
+    if (readBinaryCompressedChunked (file_name, data_idx, cloud, 0, nr_points, field_indices) < 0)
+      return (-1);
   }
   else 
   /// ---[ Binary mode only
@@ -966,68 +1175,9 @@ pcl::PCDReader::read (const std::string &file_name, pcl::PCLPointCloud2 &cloud,
   // No need to do any extra checks if the data type is ASCII
   if (data_type != 0)
   {
-    int point_size = static_cast<int> (cloud.data.size () / (cloud.height * cloud.width));
     // Once copied, we need to go over each field and check if it has NaN/Inf values and assign cloud.is_dense to true or false
-    for (uint32_t i = 0; i < cloud.width * cloud.height; ++i)
-    {
-      for (unsigned int d = 0; d < static_cast<unsigned int> (cloud.fields.size ()); ++d)
-      {
-        for (uint32_t c = 0; c < cloud.fields[d].count; ++c)
-        {
-          switch (cloud.fields[d].datatype)
-          {
-            case pcl::PCLPointField::INT8:
-            {
-              if (!isValueFinite<pcl::traits::asType<pcl::PCLPointField::INT8>::type>(cloud, i, point_size, d, c))
-                cloud.is_dense = false;
-              break;
-            }
-            case pcl::PCLPointField::UINT8:
-            {
-              if (!isValueFinite<pcl::traits::asType<pcl::PCLPointField::UINT8>::type>(cloud, i, point_size, d, c))
-                cloud.is_dense = false;
-              break;
-            }
-            case pcl::PCLPointField::INT16:
-            {
-              if (!isValueFinite<pcl::traits::asType<pcl::PCLPointField::INT16>::type>(cloud, i, point_size, d, c))
-                cloud.is_dense = false;
-              break;
-            }
-            case pcl::PCLPointField::UINT16:
-            {
-              if (!isValueFinite<pcl::traits::asType<pcl::PCLPointField::UINT16>::type>(cloud, i, point_size, d, c))
-                cloud.is_dense = false;
-              break;
-            }
-            case pcl::PCLPointField::INT32:
-            {
-              if (!isValueFinite<pcl::traits::asType<pcl::PCLPointField::INT32>::type>(cloud, i, point_size, d, c))
-                cloud.is_dense = false;
-              break;
-            }
-            case pcl::PCLPointField::UINT32:
-            {
-              if (!isValueFinite<pcl::traits::asType<pcl::PCLPointField::UINT32>::type>(cloud, i, point_size, d, c))
-                cloud.is_dense = false;
-              break;
-            }
-            case pcl::PCLPointField::FLOAT32:
-            {
-              if (!isValueFinite<pcl::traits::asType<pcl::PCLPointField::FLOAT32>::type>(cloud, i, point_size, d, c))
-                cloud.is_dense = false;
-              break;
-            }
-            case pcl::PCLPointField::FLOAT64:
-            {
-              if (!isValueFinite<pcl::traits::asType<pcl::PCLPointField::FLOAT64>::type>(cloud, i, point_size, d, c))
-                cloud.is_dense = false;
-              break;
-            }
-          }
-        }
-      }
-    }
+    if (!hasOnlyFiniteValues (cloud))
+      cloud.is_dense = false;
   }
   double total_time = tt.toc ();
   PCL_DEBUG ("[pcl::PCDReader::read] Loaded %s as a %s cloud in %g ms with %d points. Available dimensions: %s.\n", 
@@ -1052,6 +1202,251 @@ pcl::PCDReader::read (const std::string &file_name, pcl::PCLPointCloud2 &cloud,
   return (0);
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int
+pcl::PCDReader::readRange (const std::string &file_name, pcl::PCLPointCloud2 &cloud,
+                           unsigned int first_point, unsigned int nr_points,
+                           const std::vector<std::string> &field_names, const int offset)
+{
+  Eigen::Vector4f origin;
+  Eigen::Quaternionf orientation;
+  int pcd_version;
+  int data_type;
+  unsigned int data_idx;
+
+  // Only the header: the data of the whole file must not be allocated for a range
+  pcl::PCLPointCloud2 header;
+  int res = readHeader (file_name, header, origin, orientation, pcd_version, data_type, data_idx, offset, false);
+  if (res < 0)
+    return (res);
+
+  if (static_cast<uint64_t> (first_point) + nr_points > static_cast<uint64_t> (header.width) * header.height)
+  {
+    PCL_ERROR ("[pcl::PCDReader::readRange] Points [%u, %u) requested from %s, which has only %u points!\n",
+               first_point, first_point + nr_points, file_name.c_str (), header.width * header.height);
+    return (-1);
+  }
+
+  // Find the requested fields
+  std::vector<int> field_indices;
+  if (field_names.empty ())
+  {
+    for (size_t d = 0; d < header.fields.size (); ++d)
+      field_indices.push_back (static_cast<int> (d));
+  }
+  else
+  {
+    for (size_t i = 0; i < field_names.size (); ++i)
+    {
+      int d = pcl::getFieldIndex (header, field_names[i]);
+      if (d < 0)
+      {
+        PCL_ERROR ("[pcl::PCDReader::readRange] Field %s not found in %s!\n", field_names[i].c_str (), file_name.c_str ());
+        return (-1);
+      }
+      field_indices.push_back (d);
+    }
+  }
+
+  // Only the chunks overlapping the range need to be read
+  if (data_type == 3)
+  {
+    cloud.header       = header.header;
+    cloud.fields       = header.fields;
+    cloud.width        = header.width;
+    cloud.height       = header.height;
+    cloud.is_bigendian = header.is_bigendian;
+    cloud.point_step   = header.point_step;
+    cloud.row_step     = header.row_step;
+    res = readBinaryCompressedChunked (file_name, data_idx, cloud, first_point, nr_points, field_indices);
+    if (res < 0)
+      return (res);
+    // Like the cropped formats below, a range is unorganized even when it covers the whole cloud
+    cloud.width = nr_points;
+    cloud.height = 1;
+    cloud.row_step = cloud.point_step * cloud.width;
+    cloud.is_dense = hasOnlyFiniteValues (cloud);
+    return (0);
+  }
+
+  // The other formats have no index, read everything and crop
+  pcl::PCLPointCloud2 full;
+  res = read (file_name, full, offset);
+  if (res < 0)
+    return (res);
+
+  cloud.header = full.header;
+  cloud.fields.resize (field_indices.size ());
+  cloud.point_step = 0;
+  for (size_t i = 0; i < field_indices.size (); ++i)
+  {
+    cloud.fields[i] = full.fields[field_indices[i]];
+    cloud.fields[i].offset = cloud.point_step;
+    cloud.point_step += full.fields[field_indices[i]].count * pcl::getFieldSize (full.fields[field_indices[i]].datatype);
+  }
+  cloud.width = nr_points;
+  cloud.height = 1;
+  cloud.row_step = cloud.point_step * cloud.width;
+  cloud.is_bigendian = full.is_bigendian;
+  cloud.data.resize (static_cast<size_t> (nr_points) * cloud.point_step);
+  cloud.is_dense = true;
+  for (unsigned int i = 0; i < nr_points; ++i)
+  {
+    for (size_t f = 0; f < field_indices.size (); ++f)
+    {
+      const pcl::PCLPointField &field = full.fields[field_indices[f]];
+      memcpy (&cloud.data[static_cast<size_t> (i) * cloud.point_step + cloud.fields[f].offset],
+              &full.data[(static_cast<size_t> (first_point) + i) * full.point_step + field.offset],
+              field.count * pcl::getFieldSize (field.datatype));
+    }
+  }
+  if (!full.is_dense)
+    cloud.is_dense = hasOnlyFiniteValues (cloud);
+  return (0);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int
+pcl::PCDReader::readBinaryCompressedChunked (const std::string &file_name, unsigned int data_idx,
+                                             pcl::PCLPointCloud2 &cloud,
+                                             unsigned int first_point, unsigned int nr_points,
+                                             const std::vector<int> &field_indices)
+{
+  std::ifstream fs;
+  fs.open (file_name.c_str (), std::ios::in | std::ios::binary);
+  if (!fs.is_open () || fs.fail ())
+  {
+    PCL_ERROR ("[pcl::PCDReader::read] Could not open file %s.\n", file_name.c_str ());
+    return (-1);
+  }
+  fs.seekg (data_idx);
+
+  // Read the chunk index
+  const unsigned int total_points = cloud.width * cloud.height;
+  const size_t nr_fields = cloud.fields.size ();
+  unsigned int nr_chunks = 0, chunk_size = 0;
+  fs.read (reinterpret_cast<char*> (&nr_chunks), sizeof (unsigned int));
+  fs.read (reinterpret_cast<char*> (&chunk_size), sizeof (unsigned int));
+  if (fs.fail () || chunk_size == 0 || nr_chunks != (total_points + chunk_size - 1) / chunk_size)
+  {
+    PCL_ERROR ("[pcl::PCDReader::read] Invalid chunk index in %s (%u chunks of %u points for %u points)!\n",
+               file_name.c_str (), nr_chunks, chunk_size, total_points);
+    return (-1);
+  }
+  std::vector<unsigned int> block_sizes (static_cast<size_t> (nr_chunks) * nr_fields);
+  if (!block_sizes.empty ())
+    fs.read (reinterpret_cast<char*> (&block_sizes[0]), block_sizes.size () * sizeof (unsigned int));
+  if (fs.fail ())
+  {
+    PCL_ERROR ("[pcl::PCDReader::read] Truncated chunk index in %s!\n", file_name.c_str ());
+    return (-1);
+  }
+
+  // Offsets of the chunks in the file
+  std::vector<uint64_t> chunk_offsets (nr_chunks + 1);
+  chunk_offsets[0] = static_cast<uint64_t> (data_idx) + 2 * sizeof (unsigned int) + block_sizes.size () * sizeof (unsigned int);
+  for (unsigned int c = 0; c < nr_chunks; ++c)
+  {
+    chunk_offsets[c + 1] = chunk_offsets[c];
+    for (size_t f = 0; f < nr_fields; ++f)
+      chunk_offsets[c + 1] += block_sizes[c * nr_fields + f];
+  }
+
+  // Pack the requested fields in the output cloud
+  std::vector<int> fields_sizes (nr_fields);
+  for (size_t f = 0; f < nr_fields; ++f)
+    fields_sizes[f] = cloud.fields[f].count * pcl::getFieldSize (cloud.fields[f].datatype);
+  std::vector<int> output_fields (nr_fields, -1);
+  std::vector<pcl::PCLPointField> fields (field_indices.size ());
+  unsigned int point_step = 0;
+  for (size_t i = 0; i < field_indices.size (); ++i)
+  {
+    output_fields[field_indices[i]] = static_cast<int> (i);
+    fields[i] = cloud.fields[field_indices[i]];
+    fields[i].offset = point_step;
+    point_step += fields_sizes[field_indices[i]];
+  }
+  cloud.fields = fields;
+  cloud.point_step = point_step;
+  if (nr_points != total_points)
+  {
+    cloud.width = nr_points;
+    cloud.height = 1;
+  }
+  cloud.row_step = cloud.point_step * cloud.width;
+  cloud.data.resize (static_cast<size_t> (nr_points) * point_step);
+  cloud.is_dense = true;
+  if (nr_points == 0)
+    return (0);
+
+  // Read the compressed chunks overlapping the range at once
+  const unsigned int first_chunk = first_point / chunk_size;
+  const unsigned int last_chunk = (first_point + nr_points - 1) / chunk_size;
+  std::vector<char> compressed (static_cast<size_t> (chunk_offsets[last_chunk + 1] - chunk_offsets[first_chunk]));
+  fs.seekg (static_cast<std::streamoff> (chunk_offsets[first_chunk]));
+  if (!compressed.empty ())
+    fs.read (&compressed[0], compressed.size ());
+  if (fs.fail ())
+  {
+    PCL_ERROR ("[pcl::PCDReader::read] Truncated data in %s!\n", file_name.c_str ());
+    return (-1);
+  }
+  fs.close ();
+
+  // Decompress the chunks in parallel, each one fills its own points
+  std::vector<int> failed (last_chunk - first_chunk + 1, 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads((std::min) (threads_, last_chunk - first_chunk + 1))
+#endif
+  for (int c = static_cast<int> (first_chunk); c <= static_cast<int> (last_chunk); ++c)
+  {
+    const unsigned int chunk_first = c * chunk_size;
+    const unsigned int chunk_count = (std::min) (chunk_size, total_points - chunk_first);
+    // The part of the chunk within the range
+    const unsigned int begin = (std::max) (first_point, chunk_first);
+    const unsigned int end = (std::min) (first_point + nr_points, chunk_first + chunk_count);
+
+    std::vector<char> plane;
+    const char *block = &compressed[static_cast<size_t> (chunk_offsets[c] - chunk_offsets[first_chunk])];
+    for (size_t f = 0; f < nr_fields; ++f)
+    {
+      const unsigned int block_size = block_sizes[c * nr_fields + f];
+      const unsigned int plane_size = chunk_count * fields_sizes[f];
+      const int out = output_fields[f];
+      if (out >= 0)
+      {
+        // Planes which did not compress are stored as is
+        const char *src = block;
+        if (block_size != plane_size)
+        {
+          plane.resize (plane_size);
+          if (pcl::lzfDecompress (block, block_size, &plane[0], plane_size) != plane_size)
+          {
+            failed[c - first_chunk] = 1;
+            break;
+          }
+          src = &plane[0];
+        }
+        // Unpack the xxyyzz planes to xyz
+        for (unsigned int i = begin; i < end; ++i)
+          memcpy (&cloud.data[static_cast<size_t> (i - first_point) * point_step + fields[out].offset],
+                  &src[(i - chunk_first) * fields_sizes[f]], fields_sizes[f]);
+      }
+      block += block_size;
+    }
+  }
+
+  for (size_t c = 0; c < failed.size (); ++c)
+  {
+    if (failed[c])
+    {
+      PCL_ERROR ("[pcl::PCDReader::read] Failed to decompress chunk %u of %s!\n", static_cast<unsigned> (first_chunk + c), file_name.c_str ());
+      return (-1);
+    }
+  }
+  return (0);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 std::string
 pcl::PCDWriter::generateHeaderASCII (const pcl::PCLPointCloud2 &cloud,
@@ -1703,3 +2098,481 @@ pcl::PCDWriter::writeBinaryCompressed (const std::string &file_name, const pcl::
   return (0);
 }
 
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int
+pcl::PCDWriter::writeBinaryCompressedChunked (const std::string &file_name, const pcl::PCLPointCloud2 &cloud,
+                                              const Eigen::Vector4f &origin, const Eigen::Quaternionf &orientation,
+                                              unsigned int chunk_size)
+{
+  if (cloud.data.empty ())
+  {
+    PCL_ERROR ("[pcl::PCDWriter::writeBinaryCompressedChunked] Input point cloud has no data!\n");
+    return (-1);
+  }
+  if (chunk_size == 0)
+  {
+    PCL_ERROR ("[pcl::PCDWriter::writeBinaryCompressedChunked] The number of points per chunk must be positive!\n");
+    return (-1);
+  }
+  std::string header = generateHeaderBinaryCompressed (cloud, origin, orientation);
+  if (header.empty ())
+    return (-1);
+
+  // Get the fields sizes, without the padding
+  std::vector<pcl::PCLPointField> fields;
+  std::vector<unsigned int> fields_sizes;
+  for (size_t i = 0; i < cloud.fields.size (); ++i)
+  {
+    if (cloud.fields[i].name == "_")
+      continue;
+    fields.push_back (cloud.fields[i]);
+    fields_sizes.push_back (cloud.fields[i].count * pcl::getFieldSize (cloud.fields[i].datatype));
+  }
+
+  const unsigned int nr_points = cloud.width * cloud.height;
+  const unsigned int nr_chunks = (nr_points + chunk_size - 1) / chunk_size;
+  const size_t nr_fields = fields.size ();
+
+  // Compress each field of each chunk independently. As in writeBinaryCompressed the fields
+  // are converted from XYZRGBXYZRGB to XXYYZZRGBRGB planes first to aid compression.
+  std::vector<std::vector<char> > blocks (static_cast<size_t> (nr_chunks) * nr_fields);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads((std::max) (1u, (std::min) (threads_, nr_chunks)))
+#endif
+  for (int c = 0; c < static_cast<int> (nr_chunks); ++c)
+  {
+    const unsigned int chunk_first = c * chunk_size;
+    const unsigned int chunk_count = (std::min) (chunk_size, nr_points - chunk_first);
+    std::vector<char> plane, compressed;
+    for (size_t f = 0; f < nr_fields; ++f)
+    {
+      const unsigned int plane_size = chunk_count * fields_sizes[f];
+      plane.resize (plane_size);
+      for (unsigned int i = 0; i < chunk_count; ++i)
+        memcpy (&plane[i * fields_sizes[f]], &cloud.data[static_cast<size_t> (chunk_first + i) * cloud.point_step + fields[f].offset], fields_sizes[f]);
+
+      // Keep the plane as is if it does not get smaller
+      compressed.resize (plane_size);
+      unsigned int compressed_size = 0;
+      if (plane_size > 1)
+        compressed_size = pcl::lzfCompress (&plane[0], plane_size, &compressed[0], plane_size - 1);
+      std::vector<char> &block = blocks[c * nr_fields + f];
+      if (compressed_size > 0)
+        block.assign (compressed.begin (), compressed.begin () + compressed_size);
+      else
+        block.swap (plane);
+    }
+  }
+
+  std::ofstream fs;
+  fs.open (file_name.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!fs.is_open () || fs.fail ())
+  {
+    PCL_ERROR ("[pcl::PCDWriter::writeBinaryCompressedChunked] Could not open file '%s' for writing!\n", file_name.c_str ());
+    return (-1);
+  }
+  // Mandatory lock file
+  boost::interprocess::file_lock file_lock;
+  setLockingPermissions (file_name, file_lock);
+
+  fs << header << "DATA binary_compressed_chunked\n";
+
+  // Write the chunk index, then the blocks
+  std::vector<unsigned int> index (2 + blocks.size ());
+  index[0] = nr_chunks;
+  index[1] = chunk_size;
+  for (size_t b = 0; b < blocks.size (); ++b)
+    index[2 + b] = static_cast<unsigned int> (blocks[b].size ());
+  fs.write (reinterpret_cast<const char*> (&index[0]), index.size () * sizeof (unsigned int));
+  for (size_t b = 0; b < blocks.size (); ++b)
+    if (!blocks[b].empty ())
+      fs.write (&blocks[b][0], blocks[b].size ());
+
+  fs.close ();
+  resetLockingPermissions (file_name, file_lock);
+  if (fs.fail ())
+  {
+    PCL_ERROR ("[pcl::PCDWriter::writeBinaryCompressedChunked] Error while writing '%s'!\n", file_name.c_str ());
+    return (-1);
+  }
+  return (0);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+pcl::PCDStreamReader::PCDStreamReader ()
+  : file_name_ ()
+  , fs_ ()
+  , header_ ()
+  , origin_ (Eigen::Vector4f::Zero ())
+  , orientation_ (Eigen::Quaternionf::Identity ())
+  , data_type_ (0)
+  , position_ (0)
+  , chunk_size_ (0)
+  , block_sizes_ ()
+  , next_chunk_ (0)
+  , chunk_ ()
+  , chunk_position_ (0)
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int
+pcl::PCDStreamReader::open (const std::string &file_name, const int offset)
+{
+  close ();
+
+  // Read the header only, the data is read by readNext
+  pcl::PCDReader reader;
+  int pcd_version;
+  unsigned int data_idx;
+  if (reader.readHeader (file_name, header_, origin_, orientation_, pcd_version, data_type_, data_idx, offset, false) < 0)
+    return (-1);
+  fs_.open (file_name.c_str (), std::ios::in | std::ios::binary);
+  if (!fs_.is_open () || fs_.fail ())
+  {
+    PCL_ERROR ("[pcl::PCDStreamReader::open] Could not open file %s.\n", file_name.c_str ());
+    close ();
+    return (-1);
+  }
+  fs_.seekg (data_idx);
+
+  // binary_compressed files are a single compressed block, which can only be read at once
+  if (data_type_ == 2)
+  {
+    PCL_WARN ("[pcl::PCDStreamReader::open] %s is binary_compressed, reading it entirely.\n", file_name.c_str ());
+    pcl::PCLPointCloud2 cloud;
+    if (reader.read (file_name, cloud, offset) < 0)
+    {
+      close ();
+      return (-1);
+    }
+    header_.fields = cloud.fields;
+    header_.point_step = cloud.point_step;
+    chunk_.swap (cloud.data);
+  }
+
+  // Only the chunk index of binary_compressed_chunked files is kept in memory
+  if (data_type_ == 3)
+  {
+    const unsigned int nr_points = getNumberOfPoints ();
+    unsigned int nr_chunks = 0;
+    fs_.read (reinterpret_cast<char*> (&nr_chunks), sizeof (unsigned int));
+    fs_.read (reinterpret_cast<char*> (&chunk_size_), sizeof (unsigned int));
+    if (fs_.fail () || chunk_size_ == 0 || nr_chunks != (nr_points + chunk_size_ - 1) / chunk_size_)
+    {
+      PCL_ERROR ("[pcl::PCDStreamReader::open] Invalid chunk index in %s!\n", file_name.c_str ());
+      close ();
+      return (-1);
+    }
+    block_sizes_.resize (static_cast<size_t> (nr_chunks) * header_.fields.size ());
+    if (!block_sizes_.empty ())
+      fs_.read (reinterpret_cast<char*> (&block_sizes_[0]), block_sizes_.size () * sizeof (unsigned int));
+    if (fs_.fail ())
+    {
+      PCL_ERROR ("[pcl::PCDStreamReader::open] Truncated chunk index in %s!\n", file_name.c_str ());
+      close ();
+      return (-1);
+    }
+  }
+
+  file_name_ = file_name;
+  return (0);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::PCDStreamReader::close ()
+{
+  if (fs_.is_open ())
+    fs_.close ();
+  fs_.clear ();
+  position_ = 0;
+  chunk_size_ = 0;
+  block_sizes_.clear ();
+  next_chunk_ = 0;
+  chunk_.clear ();
+  chunk_position_ = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int
+pcl::PCDStreamReader::readNext (unsigned int nr_points, pcl::PCLPointCloud2 &cloud)
+{
+  if (!fs_.is_open ())
+  {
+    PCL_ERROR ("[pcl::PCDStreamReader::readNext] No file is open!\n");
+    return (-1);
+  }
+
+  nr_points = (std::min) (nr_points, getNumberOfPoints () - position_);
+  cloud.header = header_.header;
+  cloud.fields = header_.fields;
+  cloud.point_step = header_.point_step;
+  cloud.width = nr_points;
+  cloud.height = 1;
+  cloud.row_step = cloud.point_step * cloud.width;
+  cloud.is_bigendian = header_.is_bigendian;
+  cloud.is_dense = true;
+  cloud.data.resize (static_cast<size_t> (nr_points) * cloud.point_step);
+  if (nr_points == 0)
+    return (0);
+
+  /// ---[ ASCII mode, one point per non blank line
+  if (data_type_ == 0)
+  {
+    std::string line;
+    unsigned int idx = 0;
+    while (idx < nr_points && std::getline (fs_, line))
+    {
+      const char *begin = line.c_str (), *end = begin + line.size ();
+      if (isBlankLine (begin, end))
+        continue;
+      bool is_dense = true;
+      if (!copyASCIIPoint (begin, end, cloud, idx, is_dense))
+      {
+        PCL_ERROR ("[pcl::PCDStreamReader::readNext] Not enough values for all the fields of point %u in %s!\n", position_ + idx, file_name_.c_str ());
+        return (-1);
+      }
+      if (!is_dense)
+        cloud.is_dense = false;
+      ++idx;
+    }
+    if (idx != nr_points)
+    {
+      PCL_ERROR ("[pcl::PCDStreamReader::readNext] Number of points read (%u) is different than expected (%u)\n", position_ + idx, getNumberOfPoints ());
+      return (-1);
+    }
+  }
+  /// ---[ Binary mode, the points are stored as is
+  else if (data_type_ == 1)
+  {
+    fs_.read (reinterpret_cast<char*> (&cloud.data[0]), cloud.data.size ());
+    if (fs_.fail ())
+    {
+      PCL_ERROR ("[pcl::PCDStreamReader::readNext] Truncated data in %s!\n", file_name_.c_str ());
+      return (-1);
+    }
+    cloud.is_dense = hasOnlyFiniteValues (cloud);
+  }
+  /// ---[ Binary compressed (chunked) mode, the chunks are decompressed one at a time
+  else
+  {
+    size_t idx = 0;
+    while (idx < nr_points)
+    {
+      const size_t chunk_points = chunk_.size () / cloud.point_step;
+      if (chunk_position_ == chunk_points)
+      {
+        if (readChunk () < 0)
+          return (-1);
+        continue;
+      }
+      const size_t count = (std::min) (static_cast<size_t> (nr_points) - idx, chunk_points - chunk_position_);
+      memcpy (&cloud.data[idx * cloud.point_step], &chunk_[chunk_position_ * cloud.point_step], count * cloud.point_step);
+      idx += count;
+      chunk_position_ += static_cast<unsigned int> (count);
+    }
+    cloud.is_dense = hasOnlyFiniteValues (cloud);
+  }
+
+  position_ += nr_points;
+  return (static_cast<int> (nr_points));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int
+pcl::PCDStreamReader::readChunk ()
+{
+  const size_t nr_fields = header_.fields.size ();
+  const unsigned int chunk_first = next_chunk_ * chunk_size_;
+  const unsigned int chunk_count = (std::min) (chunk_size_, getNumberOfPoints () - chunk_first);
+
+  size_t compressed_size = 0;
+  for (size_t f = 0; f < nr_fields; ++f)
+    compressed_size += block_sizes_[next_chunk_ * nr_fields + f];
+  std::vector<char> compressed (compressed_size);
+  if (!compressed.empty ())
+    fs_.read (&compressed[0], compressed.size ());
+  if (fs_.fail ())
+  {
+    PCL_ERROR ("[pcl::PCDStreamReader::readNext] Truncated data in %s!\n", file_name_.c_str ());
+    return (-1);
+  }
+
+  // Unpack the xxyyzz planes to xyz
+  chunk_.resize (static_cast<size_t> (chunk_count) * header_.point_step);
+  std::vector<char> plane;
+  size_t block_offset = 0;
+  for (size_t f = 0; f < nr_fields; ++f)
+  {
+    const unsigned int field_size = header_.fields[f].count * pcl::getFieldSize (header_.fields[f].datatype);
+    const unsigned int block_size = block_sizes_[next_chunk_ * nr_fields + f];
+    const unsigned int plane_size = chunk_count * field_size;
+    if (plane_size == 0)
+      continue;
+    // Planes which did not compress are stored as is
+    const char *src = &compressed[block_offset];
+    if (block_size != plane_size)
+    {
+      plane.resize (plane_size);
+      if (pcl::lzfDecompress (src, block_size, &plane[0], plane_size) != plane_size)
+      {
+        PCL_ERROR ("[pcl::PCDStreamReader::readNext] Failed to decompress chunk %u of %s!\n", next_chunk_, file_name_.c_str ());
+        return (-1);
+      }
+      src = &plane[0];
+    }
+    for (unsigned int i = 0; i < chunk_count; ++i)
+      memcpy (&chunk_[static_cast<size_t> (i) * header_.point_step + header_.fields[f].offset], &src[i * field_size], field_size);
+    block_offset += block_size;
+  }
+
+  ++next_chunk_;
+  chunk_position_ = 0;
+  return (0);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int
+pcl::PCDStreamWriter::open (const std::string &file_name, const pcl::PCLPointCloud2 &cloud,
+                            const Eigen::Vector4f &origin, const Eigen::Quaternionf &orientation)
+{
+  close ();
+
+  header_.header = cloud.header;
+  header_.fields = sortFieldsByOffset (cloud.fields);
+  header_.point_step = cloud.point_step;
+  header_.is_bigendian = cloud.is_bigendian;
+  header_.data.clear ();
+  origin_ = origin;
+  orientation_ = orientation;
+  nr_points_ = 0;
+
+  std::string header = generateHeader (0);
+  if (header.empty ())
+    return (-1);
+
+  fs_.open (file_name.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!fs_.is_open () || fs_.fail ())
+  {
+    PCL_ERROR ("[pcl::PCDStreamWriter::open] Could not open file '%s' for writing!\n", file_name.c_str ());
+    return (-1);
+  }
+  // Mandatory lock file
+  pcl::PCDWriter ().setLockingPermissions (file_name, file_lock_);
+
+  file_name_ = file_name;
+  fs_ << header;
+  return (0);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int
+pcl::PCDStreamWriter::append (const pcl::PCLPointCloud2 &cloud)
+{
+  if (!fs_.is_open ())
+  {
+    PCL_ERROR ("[pcl::PCDStreamWriter::append] No file is open!\n");
+    return (-1);
+  }
+
+  const std::vector<pcl::PCLPointField> fields = sortFieldsByOffset (cloud.fields);
+  bool same_fields = cloud.point_step == header_.point_step && fields.size () == header_.fields.size ();
+  for (size_t d = 0; same_fields && d < fields.size (); ++d)
+    same_fields = fields[d].name == header_.fields[d].name &&
+                  fields[d].offset == header_.fields[d].offset &&
+                  fields[d].datatype == header_.fields[d].datatype &&
+                  fields[d].count == header_.fields[d].count;
+  if (!same_fields)
+  {
+    PCL_ERROR ("[pcl::PCDStreamWriter::append] The fields of the cloud (%s) differ from the fields of %s (%s)!\n",
+               pcl::getFieldsList (cloud).c_str (), file_name_.c_str (), pcl::getFieldsList (header_).c_str ());
+    return (-1);
+  }
+
+  const unsigned int nr_points = cloud.width * cloud.height;
+  if (cloud.data.size () < static_cast<size_t> (nr_points) * cloud.point_step)
+  {
+    PCL_ERROR ("[pcl::PCDStreamWriter::append] Input point cloud has not enough data!\n");
+    return (-1);
+  }
+  if (nr_points > std::numeric_limits<unsigned int>::max () - nr_points_)
+  {
+    PCL_ERROR ("[pcl::PCDStreamWriter::append] %s can't hold more than %u points!\n", file_name_.c_str (), std::numeric_limits<unsigned int>::max ());
+    return (-1);
+  }
+
+  if (nr_points > 0)
+    fs_.write (reinterpret_cast<const char*> (&cloud.data[0]), static_cast<size_t> (nr_points) * cloud.point_step);
+  if (fs_.fail ())
+  {
+    PCL_ERROR ("[pcl::PCDStreamWriter::append] Error while writing '%s'!\n", file_name_.c_str ());
+    return (-1);
+  }
+  nr_points_ += nr_points;
+  return (0);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int
+pcl::PCDStreamWriter::close ()
+{
+  if (!fs_.is_open ())
+    return (0);
+
+  // PCDReader rejects files without points, do not leave one behind
+  if (nr_points_ == 0)
+  {
+    fs_.close ();
+    fs_.clear ();
+    pcl::PCDWriter ().resetLockingPermissions (file_name_, file_lock_);
+    boost::filesystem::remove (file_name_);
+    PCL_ERROR ("[pcl::PCDStreamWriter::close] No points were appended to '%s', the file was removed!\n", file_name_.c_str ());
+    return (-1);
+  }
+
+  // The header has the same size whatever the number of points, rewrite it in place
+  fs_.seekp (0);
+  fs_ << generateHeader (nr_points_);
+  fs_.close ();
+  pcl::PCDWriter ().resetLockingPermissions (file_name_, file_lock_);
+
+  const bool failed = fs_.fail ();
+  fs_.clear ();
+  if (failed)
+  {
+    PCL_ERROR ("[pcl::PCDStreamWriter::close] Error while writing '%s'!\n", file_name_.c_str ());
+    return (-1);
+  }
+  return (0);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+std::string
+pcl::PCDStreamWriter::generateHeader (unsigned int nr_points) const
+{
+  pcl::PCLPointCloud2 cloud;
+  cloud.fields = header_.fields;
+  cloud.point_step = header_.point_step;
+  cloud.width = nr_points;
+  cloud.height = 1;
+  std::string header = pcl::PCDWriter ().generateHeaderBinary (cloud, origin_, orientation_);
+  if (header.empty ())
+    return (header);
+
+  // Pad the numbers of points to the 10 digits of the largest one
+  std::istringstream is (header);
+  std::ostringstream oss;
+  std::string line;
+  while (std::getline (is, line))
+  {
+    if (line.substr (0, 6) == "WIDTH ")
+      line.resize (6 + 10, ' ');
+    else if (line.substr (0, 7) == "POINTS ")
+      line.resize (7 + 10, ' ');
+    oss << line << "\n";
+  }
+  oss << "DATA binary\n";
+  return (oss.str ());
+}
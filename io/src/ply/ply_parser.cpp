@@ -40,6 +40,55 @@
 
 #include <pcl/io/ply/ply_parser.h>
 
+int pcl::io::ply::ply_parser::parse_binary_element (format_type format, std::istream& istream, const element& element)
+{
+  if (!binary_element_callback_ || element.count == 0 || element.properties.empty ())
+    return 0;
+
+  std::vector<std::size_t> sizes (element.properties.size ());
+  std::size_t record_size = 0;
+  for (std::size_t p = 0; p < element.properties.size (); ++p)
+  {
+    sizes[p] = element.properties[p]->size ();
+    // list properties have no fixed size, they need the per property parser
+    if (sizes[p] == 0)
+      return 0;
+    record_size += sizes[p];
+  }
+
+  char* data = binary_element_callback_ (element.name, element.count, record_size);
+  if (!data)
+    return 0;
+
+  istream.read (data, static_cast<std::streamsize> (element.count * record_size));
+  if (!istream)
+  {
+    if (error_callback_)
+      error_callback_ (line_number_, "parse error");
+    return -1;
+  }
+
+  if (((format == binary_big_endian_format) && (host_byte_order == little_endian_byte_order)) ||
+      ((format == binary_little_endian_format) && (host_byte_order == big_endian_byte_order)))
+  {
+    for (std::size_t i = 0; i < element.count; ++i)
+    {
+      for (std::size_t p = 0; p < sizes.size (); ++p)
+      {
+        switch (sizes[p])
+        {
+          case 2: swap_byte_order<2> (data); break;
+          case 4: swap_byte_order<4> (data); break;
+          case 8: swap_byte_order<8> (data); break;
+          default: break;
+        }
+        data += sizes[p];
+      }
+    }
+  }
+  return 1;
+}
+
 bool pcl::io::ply::ply_parser::parse (const std::string& filename)
 {
   std::ifstream istream (filename.c_str (), std::ios::in | std::ios::binary);
@@ -573,6 +622,11 @@ bool pcl::io::ply::ply_parser::parse (const std::string& filename)
          ++element_iterator)
     {
       struct element& element = *(element_iterator->get ());
+      int bulk_read = parse_binary_element (format, istream, element);
+      if (bulk_read < 0)
+        return false;
+      if (bulk_read > 0)
+        continue;
       for (std::size_t element_index = 0; element_index < element.count; ++element_index)
       {
         if (element.begin_element_callback) {
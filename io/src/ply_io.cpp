@@ -63,6 +63,9 @@ pcl::PLYReader::elementDefinitionCallback (const std::string& element_name, std:
     cloud_->point_step = 0;
     cloud_->row_step = 0;
     vertex_count_ = 0;
+    vertex_properties_.clear ();
+    vertex_buffer_.clear ();
+    do_resize_ = false;
     return (boost::tuple<boost::function<void ()>, boost::function<void ()> > (
               boost::bind (&pcl::PLYReader::vertexBeginCallback, this),
               boost::bind (&pcl::PLYReader::vertexEndCallback, this)));
@@ -133,6 +136,7 @@ namespace pcl
     if (element_name == "vertex")
     {
       appendScalarProperty<pcl::io::ply::float32> (property_name, 1);
+      vertex_properties_.push_back (VertexProperty (sizeof (pcl::io::ply::float32), cloud_->fields.back ().offset, VertexProperty::COPY));
       return (boost::bind (&pcl::PLYReader::vertexScalarPropertyCallback<pcl::io::ply::float32>, this, _1));
     }
     else if (element_name == "camera")
@@ -205,22 +209,32 @@ namespace pcl
           (property_name == "diffuse_red") || (property_name == "diffuse_green") || (property_name == "diffuse_blue"))
       {
         if ((property_name == "red") || (property_name == "diffuse_red"))
+        {
           appendScalarProperty<pcl::io::ply::float32> ("rgb");
+          vertex_properties_.push_back (VertexProperty (sizeof (pcl::io::ply::uint8), cloud_->fields.back ().offset, VertexProperty::RED));
+        }
+        else if ((property_name == "green") || (property_name == "diffuse_green"))
+          vertex_properties_.push_back (VertexProperty (sizeof (pcl::io::ply::uint8), vertexColorOffset (), VertexProperty::GREEN));
+        else
+          vertex_properties_.push_back (VertexProperty (sizeof (pcl::io::ply::uint8), vertexColorOffset (), VertexProperty::BLUE));
         return boost::bind (&pcl::PLYReader::vertexColorCallback, this, property_name, _1);
       }
       else if (property_name == "alpha")
       {
         amendProperty ("rgb", "rgba", pcl::PCLPointField::UINT32);
+        vertex_properties_.push_back (VertexProperty (sizeof (pcl::io::ply::uint8), vertexColorOffset (), VertexProperty::ALPHA));
         return boost::bind (&pcl::PLYReader::vertexAlphaCallback, this, _1);
       }
       else if (property_name == "intensity")
       {
         appendScalarProperty<pcl::io::ply::float32> (property_name);
+        vertex_properties_.push_back (VertexProperty (sizeof (pcl::io::ply::uint8), cloud_->fields.back ().offset, VertexProperty::INTENSITY));
         return boost::bind (&pcl::PLYReader::vertexIntensityCallback, this, _1);
       }
       else
       {
         appendScalarProperty<pcl::io::ply::uint8> (property_name);
+        vertex_properties_.push_back (VertexProperty (sizeof (pcl::io::ply::uint8), cloud_->fields.back ().offset, VertexProperty::COPY));
         return boost::bind (&pcl::PLYReader::vertexScalarPropertyCallback<pcl::io::ply::uint8>, this, _1);
       }
     }
@@ -234,6 +248,7 @@ namespace pcl
     if (element_name == "vertex")
     {
       appendScalarProperty<pcl::io::ply::int32> (property_name, 1);
+      vertex_properties_.push_back (VertexProperty (sizeof (pcl::io::ply::int32), cloud_->fields.back ().offset, VertexProperty::COPY));
       return (boost::bind (&pcl::PLYReader::vertexScalarPropertyCallback<pcl::io::ply::int32>, this, _1));
     }
     if (element_name == "camera")
@@ -259,6 +274,7 @@ namespace pcl
     if (element_name == "vertex")
     {
       appendScalarProperty<Scalar> (property_name, 1);
+      vertex_properties_.push_back (VertexProperty (sizeof (Scalar), cloud_->fields.back ().offset, VertexProperty::COPY));
       return (boost::bind (&pcl::PLYReader::vertexScalarPropertyCallback<Scalar>, this, _1));
     }
     return (0);
@@ -423,6 +439,86 @@ pcl::PLYReader::vertexIntensityCallback (pcl::io::ply::uint8 intensity)
   vertex_offset_before_ += static_cast<int> (sizeof (pcl::io::ply::float32));
 }
 
+std::size_t
+pcl::PLYReader::vertexColorOffset () const
+{
+  std::vector<VertexProperty>::const_reverse_iterator finder = vertex_properties_.rbegin ();
+  for (; finder != vertex_properties_.rend (); ++finder)
+    if (finder->conversion == VertexProperty::RED)
+      return (finder->offset);
+  return (std::numeric_limits<std::size_t>::max ());
+}
+
+char*
+pcl::PLYReader::binaryElementCallback (const std::string& element_name, std::size_t count, std::size_t size)
+{
+  // Only vertices with fixed size properties are read in one go
+  if (element_name != "vertex" || do_resize_ || cloud_->data.empty ())
+    return (0);
+
+  std::size_t record_size = 0;
+  bool same_layout = true;
+  for (std::vector<VertexProperty>::const_iterator it = vertex_properties_.begin (); it != vertex_properties_.end (); ++it)
+  {
+    // a color component without its red counterpart has nowhere to go
+    if (it->offset == std::numeric_limits<std::size_t>::max ())
+      return (0);
+    if (it->conversion != VertexProperty::COPY || it->offset != record_size)
+      same_layout = false;
+    record_size += it->size;
+  }
+  if (record_size != size || count * cloud_->point_step > cloud_->data.size ())
+    return (0);
+
+  vertex_count_ = count;
+  // The file records are the points themselves: read them straight into the cloud
+  if (same_layout && size == cloud_->point_step)
+  {
+    vertex_buffer_.clear ();
+    return (reinterpret_cast<char*> (&cloud_->data[0]));
+  }
+  vertex_buffer_.resize (count * size);
+  return (&vertex_buffer_[0]);
+}
+
+void
+pcl::PLYReader::convertVertexBuffer ()
+{
+  const std::size_t record_size = vertex_buffer_.size () / vertex_count_;
+  for (std::size_t i = 0; i < vertex_count_; ++i)
+  {
+    const char* record = &vertex_buffer_[i * record_size];
+    pcl::uint8_t* point = &cloud_->data[i * cloud_->point_step];
+    for (std::vector<VertexProperty>::const_iterator it = vertex_properties_.begin (); it != vertex_properties_.end (); ++it)
+    {
+      if (it->conversion == VertexProperty::COPY)
+        memcpy (point + it->offset, record, it->size);
+      else if (it->conversion == VertexProperty::INTENSITY)
+      {
+        pcl::io::ply::float32 intensity = static_cast<pcl::io::ply::uint8> (*record);
+        memcpy (point + it->offset, &intensity, sizeof (pcl::io::ply::float32));
+      }
+      else
+      {
+        int shift = 0;
+        switch (it->conversion)
+        {
+          case VertexProperty::RED:   shift = 16; break;
+          case VertexProperty::GREEN: shift = 8; break;
+          case VertexProperty::ALPHA: shift = 24; break;
+          default: break;
+        }
+        uint32_t rgba;
+        memcpy (&rgba, point + it->offset, sizeof (uint32_t));
+        rgba |= uint32_t (static_cast<pcl::io::ply::uint8> (*record)) << shift;
+        memcpy (point + it->offset, &rgba, sizeof (uint32_t));
+      }
+      record += it->size;
+    }
+  }
+  std::vector<char> ().swap (vertex_buffer_);
+}
+
 void
 pcl::PLYReader::vertexBeginCallback ()
 {
@@ -553,7 +649,14 @@ pcl::PLYReader::parse (const std::string& istream_filename)
   pcl::io::ply::ply_parser::at<pcl::io::ply::uint32, pcl::io::ply::int8> (list_property_definition_callbacks) = boost::bind (&pcl::PLYReader::listPropertyDefinitionCallback<pcl::io::ply::uint32, pcl::io::ply::int8>, this, _1, _2);
   ply_parser.list_property_definition_callbacks (list_property_definition_callbacks);
 
-  return ply_parser.parse (istream_filename);
+  ply_parser.binary_element_callback (boost::bind (&pcl::PLYReader::binaryElementCallback, this, _1, _2, _3));
+
+  if (!ply_parser.parse (istream_filename))
+    return (false);
+  // Vertices read in one go whose layout differs from the cloud one
+  if (!vertex_buffer_.empty ())
+    convertVertexBuffer ();
+  return (true);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -1250,11 +1353,55 @@ pcl::PLYWriter::writeBinary (const std::string &file_name,
     return (-1);
   }
 
+  if (doRangeGrid)
+    writeBinaryVertices (fpout, cloud, rangegrid);
+  else
+    writeBinaryVertices (fpout, cloud);
+
+  if (use_camera)
+    writeBinaryCamera (fpout, origin, orientation, cloud.width, cloud.height);
+  else if (doRangeGrid)
+  {
+    // Write out range_grid
+    for (size_t i=0; i < nr_points; ++i)
+    {
+      pcl::io::ply::uint8 listlen;
+
+      if (rangegrid[i] >= 0)
+      {
+        listlen = 1;
+        fpout.write (reinterpret_cast<const char*> (&listlen), sizeof (pcl::io::ply::uint8));
+        fpout.write (reinterpret_cast<const char*> (&rangegrid[i]), sizeof (pcl::io::ply::int32));
+      }
+      else
+      {
+        listlen = 0;
+        fpout.write (reinterpret_cast<const char*> (&listlen), sizeof (pcl::io::ply::uint8));
+      }
+    }
+  }
+
+  // Close file
+  fpout.close ();
+  return (0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::PLYWriter::writeBinaryVertices (std::ostream &fpout,
+                                     const pcl::PCLPointCloud2 &cloud,
+                                     const std::vector<pcl::io::ply::int32> &rangegrid)
+{
+  unsigned int nr_points  = cloud.width * cloud.height;
+  if (nr_points == 0)
+    return;
+  unsigned int point_size = static_cast<unsigned int> (cloud.data.size () / nr_points);
+
   // Iterate through the points
   for (unsigned int i = 0; i < nr_points; ++i)
   {
     // Skip writing any invalid points from range_grid
-    if (doRangeGrid && rangegrid[i] < 0)
+    if (!rangegrid.empty () && rangegrid[i] < 0)
       continue;
 
     size_t total = 0;
@@ -1372,78 +1519,56 @@ pcl::PLYWriter::writeBinary (const std::string &file_name,
       }
     }
   }
+}
 
-  if (use_camera)
+////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::PLYWriter::writeBinaryCamera (std::ostream &fpout,
+                                   const Eigen::Vector4f &origin,
+                                   const Eigen::Quaternionf &orientation,
+                                   int width, int height)
+{
+  // Append sensor information
+  float t;
+  for (int i = 0; i < 3; ++i)
   {
-    // Append sensor information
-    float t;
-    for (int i = 0; i < 3; ++i)
-    {
-      if (origin[3] != 0)
-        t = origin[i]/origin[3];
-      else
-        t = origin[i];
-      fpout.write (reinterpret_cast<const char*> (&t), sizeof (float));
-    }
-    Eigen::Matrix3f R = orientation.toRotationMatrix ();
-    for (int i = 0; i < 3; ++i)
-      for (int j = 0; j < 3; ++j)
-    {
-      fpout.write (reinterpret_cast<const char*> (&R (i, j)),sizeof (float));
-    }
-
-    /////////////////////////////////////////////////////
-    // Append those properties directly.               //
-    // They are for perspective cameras so just put 0  //
-    //                                                 //
-    // property float focal                            //
-    // property float scalex                           //
-    // property float scaley                           //
-    // property float centerx                          //
-    // property float centery                          //
-    // and later on                                    //
-    // property float k1                               //
-    // property float k2                               //
-    /////////////////////////////////////////////////////
-
-    const float zerof = 0;
-    for (int i = 0; i < 5; ++i)
-      fpout.write (reinterpret_cast<const char*> (&zerof), sizeof (float));
-
-    // width and height
-    int width = cloud.width;
-    fpout.write (reinterpret_cast<const char*> (&width), sizeof (int));
-
-    int height = cloud.height;
-    fpout.write (reinterpret_cast<const char*> (&height), sizeof (int));
-
-    for (int i = 0; i < 2; ++i)
-      fpout.write (reinterpret_cast<const char*> (&zerof), sizeof (float));
+    if (origin[3] != 0)
+      t = origin[i]/origin[3];
+    else
+      t = origin[i];
+    fpout.write (reinterpret_cast<const char*> (&t), sizeof (float));
   }
-  else if (doRangeGrid)
+  Eigen::Matrix3f R = orientation.toRotationMatrix ();
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 3; ++j)
   {
-    // Write out range_grid
-    for (size_t i=0; i < nr_points; ++i)
-    {
-      pcl::io::ply::uint8 listlen;
-
-      if (rangegrid[i] >= 0)
-      {
-        listlen = 1;
-        fpout.write (reinterpret_cast<const char*> (&listlen), sizeof (pcl::io::ply::uint8));
-        fpout.write (reinterpret_cast<const char*> (&rangegrid[i]), sizeof (pcl::io::ply::int32));
-      }
-      else
-      {
-        listlen = 0;
-        fpout.write (reinterpret_cast<const char*> (&listlen), sizeof (pcl::io::ply::uint8));
-      }
-    }
+    fpout.write (reinterpret_cast<const char*> (&R (i, j)),sizeof (float));
   }
 
-  // Close file
-  fpout.close ();
-  return (0);
+  /////////////////////////////////////////////////////
+  // Append those properties directly.               //
+  // They are for perspective cameras so just put 0  //
+  //                                                 //
+  // property float focal                            //
+  // property float scalex                           //
+  // property float scaley                           //
+  // property float centerx                          //
+  // property float centery                          //
+  // and later on                                    //
+  // property float k1                               //
+  // property float k2                               //
+  /////////////////////////////////////////////////////
+
+  const float zerof = 0;
+  for (int i = 0; i < 5; ++i)
+    fpout.write (reinterpret_cast<const char*> (&zerof), sizeof (float));
+
+  // width and height
+  fpout.write (reinterpret_cast<const char*> (&width), sizeof (int));
+  fpout.write (reinterpret_cast<const char*> (&height), sizeof (int));
+
+  for (int i = 0; i < 2; ++i)
+    fpout.write (reinterpret_cast<const char*> (&zerof), sizeof (float));
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////
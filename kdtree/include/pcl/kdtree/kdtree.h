@@ -43,6 +43,7 @@
 #include <pcl/pcl_macros.h>
 #include <pcl/point_cloud.h>
 #include <pcl/point_representation.h>
+#include <pcl/neighborhoods.h>
 #include <pcl/common/io.h>
 #include <pcl/common/copy_point.h>
 
@@ -213,6 +214,23 @@ namespace pcl
         }
       }
 
+      /** \brief Search for the k-nearest neighbors of a batch of query points, using multiple threads.
+        * \param[in] cloud the point cloud data
+        * \param[in] indices the indices in \a cloud of \a valid (i.e., finite) query points. If indices is empty,
+        * neighbors will be searched for all points.
+        * \param[in] k the number of neighbors to search for
+        * \param[out] neighborhoods the resultant neighbors of all query points, in the order of \a indices
+        * \param[in] nr_threads the number of threads to use (0 sets the value to the number of cores)
+        */
+      virtual void
+      nearestKSearch (const PointCloud &cloud, const std::vector<int> &indices, int k,
+                      pcl::Neighborhoods &neighborhoods, unsigned int nr_threads = 0) const
+      {
+        const int nr_queries = static_cast<int> (indices.empty () ? cloud.size () : indices.size ());
+        pcl::detail::NearestKSearchFunctor<KdTree<PointT>, PointCloud> search (*this, cloud, indices, k);
+        pcl::detail::searchNeighborhoods (search, nr_queries, nr_threads, neighborhoods);
+      }
+
       /** \brief Search for all the nearest neighbors of the query point in a given radius.
         * \param[in] p_q the given query point
         * \param[in] radius the radius of the sphere bounding all of p_q's neighbors
@@ -307,6 +325,26 @@ namespace pcl
         }
       }
 
+      /** \brief Search for all the nearest neighbors of a batch of query points in a given radius, using multiple threads.
+        * \param[in] cloud the point cloud data
+        * \param[in] indices the indices in \a cloud of \a valid (i.e., finite) query points. If indices is empty,
+        * neighbors will be searched for all points.
+        * \param[in] radius the radius of the sphere bounding all of the query points' neighbors
+        * \param[out] neighborhoods the resultant neighbors of all query points, in the order of \a indices
+        * \param[in] max_nn if given, bounds the maximum returned neighbors to this value. If \a max_nn is set to
+        * 0 or to a number higher than the number of points in the input cloud, all neighbors in \a radius will be
+        * returned.
+        * \param[in] nr_threads the number of threads to use (0 sets the value to the number of cores)
+        */
+      virtual void
+      radiusSearch (const PointCloud &cloud, const std::vector<int> &indices, double radius,
+                    pcl::Neighborhoods &neighborhoods, unsigned int max_nn = 0, unsigned int nr_threads = 0) const
+      {
+        const int nr_queries = static_cast<int> (indices.empty () ? cloud.size () : indices.size ());
+        pcl::detail::RadiusSearchFunctor<KdTree<PointT>, PointCloud> search (*this, cloud, indices, radius, max_nn);
+        pcl::detail::searchNeighborhoods (search, nr_queries, nr_threads, neighborhoods);
+      }
+
       /** \brief Set the search epsilon precision (error bound) for nearest neighbors searches.
         * \param[in] eps precision (error bound) for nearest neighbors searches
         */
@@ -54,7 +54,10 @@ namespace pcl
       buffer_selector_ (0),
       tree_dirty_flag_ (false),
       octree_depth_ (0),
-      dynamic_depth_enabled_(false)
+      dynamic_depth_enabled_(false),
+      node_pool_enabled_ (false),
+      branch_node_pool_ (),
+      leaf_node_pool_ ()
     {
     }
 
@@ -58,7 +58,10 @@ namespace pcl
           depth_mask_ (0),
           octree_depth_ (0),
           dynamic_depth_enabled_ (false),
-          max_key_ ()
+          max_key_ (),
+          node_pool_enabled_ (false),
+          branch_node_pool_ (),
+          leaf_node_pool_ ()
       {
       }
 
@@ -42,6 +42,7 @@
 #include <vector>
 
 #include "octree_nodes.h"
+#include "octree_node_pool.h"
 #include "octree_container.h"
 #include "octree_key.h"
 #include "octree_iterator.h"
@@ -284,7 +285,10 @@ namespace pcl
             buffer_selector_ (source.buffer_selector_),
             tree_dirty_flag_ (source.tree_dirty_flag_),
             octree_depth_ (source.octree_depth_),
-            dynamic_depth_enabled_(source.dynamic_depth_enabled_)
+            dynamic_depth_enabled_(source.dynamic_depth_enabled_),
+            node_pool_enabled_ (source.node_pool_enabled_),
+            branch_node_pool_ (),
+            leaf_node_pool_ ()
         {
         }
 
@@ -301,6 +305,7 @@ namespace pcl
           tree_dirty_flag_ = source.tree_dirty_flag_;
           octree_depth_ = source.octree_depth_;
           dynamic_depth_enabled_ = source.dynamic_depth_enabled_;
+          node_pool_enabled_ = source.node_pool_enabled_;
           return (*this);
         }
 
@@ -400,6 +405,46 @@ namespace pcl
         void
         switchBuffers ();
 
+        /** \brief Enable or disable the recycling of octree nodes. When enabled, the nodes released by
+         *  deleteTree (), switchBuffers () or removeLeaf () are kept in a pool and reused for the next nodes
+         *  to be created, instead of being freed and allocated again. Disabling the pool frees all pooled nodes.
+         *  \param enable_arg: enable node recycling
+         * */
+        void
+        enableNodePool (bool enable_arg = true)
+        {
+          node_pool_enabled_ = enable_arg;
+          if (!node_pool_enabled_)
+          {
+            branch_node_pool_.deletePool ();
+            leaf_node_pool_.deletePool ();
+          }
+        }
+
+        /** \brief Check whether octree nodes are recycled through a node pool. */
+        bool
+        isNodePoolEnabled () const
+        {
+          return (node_pool_enabled_);
+        }
+
+        /** \brief Get the combined statistics of the branch and leaf node pools. */
+        OctreeNodePoolStatistics
+        getNodePoolStatistics () const
+        {
+          OctreeNodePoolStatistics stats = branch_node_pool_.getStatistics ();
+          stats += leaf_node_pool_.getStatistics ();
+          return (stats);
+        }
+
+        /** \brief Reset the statistics of the branch and leaf node pools. */
+        void
+        resetNodePoolStatistics ()
+        {
+          branch_node_pool_.resetStatistics ();
+          leaf_node_pool_.resetStatistics ();
+        }
+
         /** \brief Serialize octree into a binary output vector describing its branch node structure.
          *  \param binary_tree_out_arg: reference to output vector for writing binary tree structure.
          *  \param do_XOR_encoding_arg: select if binary tree structure should be generated based on current octree (false) of based on a XOR comparison between current and previous octree
@@ -650,14 +695,20 @@ namespace pcl
                 deleteBranch (*static_cast<BranchNode*> (branchChild));
 
                 // delete unused branch
-                delete (branchChild);
+                if (node_pool_enabled_)
+                  branch_node_pool_.pushNode (static_cast<BranchNode*> (branchChild));
+                else
+                  delete (branchChild);
                 break;
               }
 
               case LEAF_NODE:
               {
-                // push unused leaf to branch pool
-                delete (branchChild);
+                // push unused leaf to leaf pool
+                if (node_pool_enabled_)
+                  leaf_node_pool_.pushNode (static_cast<LeafNode*> (branchChild));
+                else
+                  delete (branchChild);
                 break;
               }
               default:
@@ -714,7 +765,7 @@ namespace pcl
         inline  BranchNode* createBranchChild (BranchNode& branch_arg,
             unsigned char child_idx_arg)
         {
-          BranchNode* new_branch_child = new BranchNode();
+          BranchNode* new_branch_child = node_pool_enabled_ ? branch_node_pool_.popNode () : new BranchNode ();
 
           branch_arg.setChildPtr (buffer_selector_, child_idx_arg,
               static_cast<OctreeNode*> (new_branch_child));
@@ -730,7 +781,7 @@ namespace pcl
         inline LeafNode*
         createLeafChild (BranchNode& branch_arg, unsigned char child_idx_arg)
         {
-          LeafNode* new_leaf_child = new LeafNode();
+          LeafNode* new_leaf_child = node_pool_enabled_ ? leaf_node_pool_.popNode () : new LeafNode ();
 
           branch_arg.setChildPtr(buffer_selector_, child_idx_arg, new_leaf_child);
 
@@ -916,6 +967,15 @@ namespace pcl
          *  \note Note that this parameter is ignored in octree2buf! */
         bool dynamic_depth_enabled_;
 
+        /** \brief Recycle nodes through the node pools */
+        bool node_pool_enabled_;
+
+        /** \brief Pool of unused branch nodes */
+        OctreeNodePool<BranchNode> branch_node_pool_;
+
+        /** \brief Pool of unused leaf nodes */
+        OctreeNodePool<LeafNode> leaf_node_pool_;
+
     };
   }
 }
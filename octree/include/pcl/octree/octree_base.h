@@ -43,6 +43,7 @@
 #include <vector>
 
 #include "octree_nodes.h"
+#include "octree_node_pool.h"
 #include "octree_container.h"
 #include "octree_key.h"
 #include "octree_iterator.h"
@@ -119,7 +120,10 @@ namespace pcl
           depth_mask_ (source.depth_mask_),
           octree_depth_ (source.octree_depth_),
           dynamic_depth_enabled_(source.dynamic_depth_enabled_),
-          max_key_ (source.max_key_)
+          max_key_ (source.max_key_),
+          node_pool_enabled_ (source.node_pool_enabled_),
+          branch_node_pool_ (),
+          leaf_node_pool_ ()
         {
         }
 
@@ -133,6 +137,7 @@ namespace pcl
           depth_mask_ = source.depth_mask_;
           max_key_ = source.max_key_;
           octree_depth_ = source.octree_depth_;
+          node_pool_enabled_ = source.node_pool_enabled_;
           return (*this);
         }
 
@@ -217,6 +222,46 @@ namespace pcl
         void
         deleteTree ( );
 
+        /** \brief Enable or disable the recycling of octree nodes. When enabled, the nodes released by
+         *  deleteTree () or removeLeaf () are kept in a pool and reused for the next nodes to be created,
+         *  instead of being freed and allocated again. Disabling the pool frees all pooled nodes.
+         *  \param enable_arg: enable node recycling
+         * */
+        void
+        enableNodePool (bool enable_arg = true)
+        {
+          node_pool_enabled_ = enable_arg;
+          if (!node_pool_enabled_)
+          {
+            branch_node_pool_.deletePool ();
+            leaf_node_pool_.deletePool ();
+          }
+        }
+
+        /** \brief Check whether octree nodes are recycled through a node pool. */
+        bool
+        isNodePoolEnabled () const
+        {
+          return (node_pool_enabled_);
+        }
+
+        /** \brief Get the combined statistics of the branch and leaf node pools. */
+        OctreeNodePoolStatistics
+        getNodePoolStatistics () const
+        {
+          OctreeNodePoolStatistics stats = branch_node_pool_.getStatistics ();
+          stats += leaf_node_pool_.getStatistics ();
+          return (stats);
+        }
+
+        /** \brief Reset the statistics of the branch and leaf node pools. */
+        void
+        resetNodePoolStatistics ()
+        {
+          branch_node_pool_.resetStatistics ();
+          leaf_node_pool_.resetStatistics ();
+        }
+
         /** \brief Serialize octree into a binary output vector describing its branch node structure.
          *  \param binary_tree_out_arg: reference to output vector for writing binary tree structure.
          * */
@@ -391,14 +436,20 @@ namespace pcl
                 // free child branch recursively
                 deleteBranch (*static_cast<BranchNode*> (branch_child));
                 // delete branch node
-                delete branch_child;
+                if (node_pool_enabled_)
+                  branch_node_pool_.pushNode (static_cast<BranchNode*> (branch_child));
+                else
+                  delete branch_child;
               }
                 break;
 
               case LEAF_NODE:
               {
                 // delete leaf node
-                delete branch_child;
+                if (node_pool_enabled_)
+                  leaf_node_pool_.pushNode (static_cast<LeafNode*> (branch_child));
+                else
+                  delete branch_child;
                 break;
               }
               default:
@@ -431,7 +482,7 @@ namespace pcl
         BranchNode* createBranchChild (BranchNode& branch_arg,
                                        unsigned char child_idx_arg)
         {
-          BranchNode* new_branch_child = new BranchNode();
+          BranchNode* new_branch_child = node_pool_enabled_ ? branch_node_pool_.popNode () : new BranchNode ();
           branch_arg[child_idx_arg] = static_cast<OctreeNode*> (new_branch_child);
 
           return new_branch_child;
@@ -445,7 +496,7 @@ namespace pcl
         LeafNode*
         createLeafChild (BranchNode& branch_arg, unsigned char child_idx_arg)
         {
-          LeafNode* new_leaf_child = new LeafNode();
+          LeafNode* new_leaf_child = node_pool_enabled_ ? leaf_node_pool_.popNode () : new LeafNode ();
           branch_arg[child_idx_arg] = static_cast<OctreeNode*> (new_leaf_child);
 
           return new_leaf_child;
@@ -590,6 +641,15 @@ namespace pcl
 
         /** \brief key range */
         OctreeKey max_key_;
+
+        /** \brief Recycle nodes through the node pools */
+        bool node_pool_enabled_;
+
+        /** \brief Pool of unused branch nodes */
+        OctreeNodePool<BranchNode> branch_node_pool_;
+
+        /** \brief Pool of unused leaf nodes */
+        OctreeNodePool<LeafNode> leaf_node_pool_;
     };
   }
 }
@@ -38,8 +38,11 @@
 #ifndef PCL_OCTREE_NODE_POOL_H
 #define PCL_OCTREE_NODE_POOL_H
 
+#include <cstddef>
 #include <vector>
 
+#include <boost/noncopyable.hpp>
+
 #include <pcl/pcl_macros.h>
 
 namespace pcl
@@ -47,18 +50,56 @@ namespace pcl
   namespace octree
   {
 
+    //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /** \brief @b Octree node pool statistics
+     * \note Memory figures only account for the node objects, not for heap memory owned by their containers.
+     */
+    struct OctreeNodePoolStatistics
+    {
+      /** \brief Empty constructor. */
+      OctreeNodePoolStatistics () :
+          pool_hits (0), allocations (0), pooled_nodes (0), memory (0), peak_memory (0)
+      {
+      }
+
+      /** \brief Accumulate the statistics of another pool. */
+      OctreeNodePoolStatistics&
+      operator += (const OctreeNodePoolStatistics& other)
+      {
+        pool_hits += other.pool_hits;
+        allocations += other.allocations;
+        pooled_nodes += other.pooled_nodes;
+        memory += other.memory;
+        peak_memory += other.peak_memory;
+        return (*this);
+      }
+
+      /** \brief Number of node requests served by recycling a pooled node. */
+      std::size_t pool_hits;
+      /** \brief Number of node requests that required a new heap allocation. */
+      std::size_t allocations;
+      /** \brief Number of unused nodes currently kept in the pool. */
+      std::size_t pooled_nodes;
+      /** \brief Current memory (in bytes) held by nodes handed out by the pool or kept in it. */
+      std::size_t memory;
+      /** \brief Peak value of \a memory since construction or since the last statistics reset. */
+      std::size_t peak_memory;
+    };
+
     //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     /** \brief @b Octree node pool
      * \note Used to reduce memory allocation and class instantiation events when generating octrees at high rate
+     * \note Nodes must be allocated with operator new, as the pool releases them with delete.
+     * \note Pooled nodes are owned by a single pool, hence pools cannot be copied.
      * \author Julius Kammerl (julius@kammerl.de)
      */
     template<typename NodeT>
-      class OctreeNodePool
+      class OctreeNodePool : boost::noncopyable
       {
       public:
         /** \brief Empty constructor. */
         OctreeNodePool () :
-            nodePool_ ()
+            nodePool_ (), pool_hits_ (0), allocations_ (0), used_nodes_ (0), peak_memory_ (0)
         {
         }
 
@@ -77,6 +118,12 @@ namespace pcl
         pushNode (NodeT* node_arg)
         {
           nodePool_.push_back (node_arg);
+
+          // nodes which were not handed out by this pool (e.g. deep copies) enlarge the pool
+          if (used_nodes_)
+            --used_nodes_;
+          else
+            updatePeakMemory ();
         }
 
         /** \brief Pop node from pool - Allocates new nodes if pool is empty
@@ -93,6 +140,9 @@ namespace pcl
             // leaf pool is empty
             // we need to create a new octree leaf class
             newLeafNode = new NodeT ();
+            ++allocations_;
+            ++used_nodes_;
+            updatePeakMemory ();
           }
           else
           {
@@ -100,6 +150,8 @@ namespace pcl
             newLeafNode = nodePool_.back ();
             nodePool_.pop_back ();
             newLeafNode->reset ();
+            ++pool_hits_;
+            ++used_nodes_;
           }
 
           return newLeafNode;
@@ -119,8 +171,63 @@ namespace pcl
           }
         }
 
+        /** \brief Get the number of unused nodes kept in the pool. */
+        inline std::size_t
+        size () const
+        {
+          return (nodePool_.size ());
+        }
+
+        /** \brief Get the allocation statistics of the pool. */
+        OctreeNodePoolStatistics
+        getStatistics () const
+        {
+          OctreeNodePoolStatistics stats;
+          stats.pool_hits = pool_hits_;
+          stats.allocations = allocations_;
+          stats.pooled_nodes = nodePool_.size ();
+          stats.memory = getMemory ();
+          stats.peak_memory = peak_memory_;
+          return (stats);
+        }
+
+        /** \brief Reset the hit and allocation counters, and the peak memory to the current memory. */
+        void
+        resetStatistics ()
+        {
+          pool_hits_ = allocations_ = 0;
+          peak_memory_ = getMemory ();
+        }
+
       protected:
+        /** \brief Memory held by the nodes handed out by the pool and by the pooled nodes. */
+        inline std::size_t
+        getMemory () const
+        {
+          return ((used_nodes_ + nodePool_.size ()) * sizeof (NodeT));
+        }
+
+        /** \brief Update the peak memory with the current memory. */
+        inline void
+        updatePeakMemory ()
+        {
+          if (getMemory () > peak_memory_)
+            peak_memory_ = getMemory ();
+        }
+
         std::vector<NodeT*> nodePool_;
+
+        /** \brief Number of node requests served from the pool. */
+        std::size_t pool_hits_;
+
+        /** \brief Number of nodes allocated by the pool. */
+        std::size_t allocations_;
+
+        /** \brief Number of nodes handed out by the pool and not returned yet. */
+        std::size_t used_nodes_;
+
+        /** \brief Peak memory in bytes. */
+        std::size_t peak_memory_;
       };
 
   }
@@ -48,6 +48,9 @@
 
 #include <Eigen/Core>
 
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_base_of.hpp>
+
 #include <pcl/pcl_macros.h>
 
 #include "octree_container.h"
@@ -134,6 +137,13 @@ namespace pcl
           return LEAF_NODE;
         }
 
+        /** \brief Reset leaf node container. */
+        void
+        reset ()
+        {
+          resetContainer (container_, boost::is_base_of<OctreeContainerBase, ContainerT> ());
+        }
+
         /** \brief Get const pointer to container */
         const ContainerT*
         operator->() const
@@ -191,6 +201,20 @@ namespace pcl
         }
 
       protected:
+        /** \brief Reset a container through the OctreeContainerBase interface. */
+        static void
+        resetContainer (OctreeContainerBase& container_arg, boost::true_type)
+        {
+          container_arg.reset ();
+        }
+
+        /** \brief Reset a plain data container (e.g. int) to its default value. */
+        static void
+        resetContainer (ContainerT& container_arg, boost::false_type)
+        {
+          container_arg = ContainerT ();
+        }
+
         ContainerT container_;
         
       public:
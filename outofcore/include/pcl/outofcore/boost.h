@@ -45,6 +45,9 @@
 
 #include <boost/filesystem.hpp>
 #include <boost/thread.hpp>
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/exception_ptr.hpp>
 #include <boost/random/uniform_int.hpp>
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
@@ -53,6 +56,7 @@
 #include <boost/random/uniform_int.hpp>
 #include <boost/random/bernoulli_distribution.hpp>
 #include <boost/foreach.hpp>
+#include <boost/functional/hash.hpp>
 #include <boost/lexical_cast.hpp>
 
 #endif //PCL_OUTOFCORE_BOOST_H_
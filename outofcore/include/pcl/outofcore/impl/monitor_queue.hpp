@@ -9,10 +9,22 @@ template<typename DataT>
 class MonitorQueue : boost::noncopyable
 {
 public:
+  // A capacity of 0 leaves the queue unbounded, otherwise push blocks while the queue is full
+  MonitorQueue (size_t capacity = 0) :
+      capacity_ (capacity)
+  {
+  }
+
   void
   push (const DataT& newData)
   {
     boost::mutex::scoped_lock lock (monitor_mutex_);
+
+    while (capacity_ > 0 && queue_.size () >= capacity_)
+    {
+      space_available_.wait (lock);
+    }
+
     queue_.push (newData);
     item_available_.notify_one ();
   }
@@ -22,21 +34,31 @@ public:
   {
     boost::mutex::scoped_lock lock (monitor_mutex_);
 
-    if (queue_.empty ())
+    while (queue_.empty ())
     {
       item_available_.wait (lock);
     }
 
     DataT temp (queue_.front ());
     queue_.pop ();
+    space_available_.notify_one ();
 
     return temp;
   }
 
+  size_t
+  size ()
+  {
+    boost::mutex::scoped_lock lock (monitor_mutex_);
+    return queue_.size ();
+  }
+
 private:
   std::queue<DataT> queue_;
+  size_t capacity_;
   boost::mutex monitor_mutex_;
   boost::condition item_available_;
+  boost::condition space_available_;
 };
 
 #endif //PCL_OUTOFCORE_MONITOR_QUEUE_IMPL_H_
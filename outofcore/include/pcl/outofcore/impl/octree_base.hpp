@@ -80,6 +80,10 @@ namespace pcl
       , metadata_ (new OutofcoreOctreeBaseMetadata ())
       , sample_percent_ (0.125)
       , lod_filter_ptr_ (new pcl::RandomSample<pcl::PCLPointCloud2> ())
+      , threads_ (1)
+      , write_queue_size_ (64)
+      , writer_ ()
+      , lod_mutex_ ()
     {
       //validate the root filename
       if (!this->checkExtension (root_name))
@@ -108,6 +112,10 @@ namespace pcl
       , metadata_ (new OutofcoreOctreeBaseMetadata ())
       , sample_percent_ (0.125)
       , lod_filter_ptr_ (new pcl::RandomSample<pcl::PCLPointCloud2> ())
+      , threads_ (1)
+      , write_queue_size_ (64)
+      , writer_ ()
+      , lod_mutex_ ()
     {
       //Enlarge the bounding box to a cube so our voxels will be cubes
       Eigen::Vector3d tmp_min = min;
@@ -130,6 +138,10 @@ namespace pcl
       , metadata_ (new OutofcoreOctreeBaseMetadata ())
       , sample_percent_ (0.125)
       , lod_filter_ptr_ (new pcl::RandomSample<pcl::PCLPointCloud2> ())
+      , threads_ (1)
+      , write_queue_size_ (64)
+      , writer_ ()
+      , lod_mutex_ ()
     {
       //Create a new outofcore tree
       this->init (max_depth, min, max, root_node_name, coord_sys);
@@ -211,7 +223,19 @@ namespace pcl
 
       const bool _FORCE_BB_CHECK = true;
       
-      uint64_t pt_added = root_node_->addDataToLeaf (p, _FORCE_BB_CHECK);
+      uint64_t pt_added = 0;
+      startAsyncWriter ();
+      try
+      {
+        pt_added = root_node_->addDataToLeaf (p, _FORCE_BB_CHECK);
+      }
+      catch (...)
+      {
+        // the insertion error takes precedence over the errors of the pending writes
+        writer_.reset ();
+        throw;
+      }
+      stopAsyncWriter ();
 
       assert (p.size () == pt_added);
 
@@ -242,10 +266,7 @@ namespace pcl
     template<typename ContainerT, typename PointT> boost::uint64_t
     OutofcoreOctreeBase<ContainerT, PointT>::addPointCloud_and_genLOD (PointCloudConstPtr point_cloud)
     {
-      // Lock the tree while writing
-      boost::unique_lock < boost::shared_mutex > lock (read_write_mutex_);
-      boost::uint64_t pt_added = root_node_->addDataToLeaf_and_genLOD (point_cloud->points, false);
-      return (pt_added);
+      return (addDataToLeaf_and_genLOD (point_cloud->points));
     }
 
     ////////////////////////////////////////////////////////////////////////////////
@@ -267,16 +288,62 @@ namespace pcl
     ////////////////////////////////////////////////////////////////////////////////
 
     template<typename ContainerT, typename PointT> boost::uint64_t
-    OutofcoreOctreeBase<ContainerT, PointT>::addDataToLeaf_and_genLOD (AlignedPointTVector& src)
+    OutofcoreOctreeBase<ContainerT, PointT>::addDataToLeaf_and_genLOD (const AlignedPointTVector& src)
     {
       // Lock the tree while writing
       boost::unique_lock < boost::shared_mutex > lock (read_write_mutex_);
-      boost::uint64_t pt_added = root_node_->addDataToLeaf_and_genLOD (src, false);
+
+      boost::uint64_t pt_added = 0;
+      startAsyncWriter ();
+      try
+      {
+        pt_added = root_node_->addDataToLeaf_and_genLOD (src, false);
+      }
+      catch (...)
+      {
+        // the insertion error takes precedence over the errors of the pending writes
+        writer_.reset ();
+        throw;
+      }
+      stopAsyncWriter ();
+
       return (pt_added);
     }
 
     ////////////////////////////////////////////////////////////////////////////////
 
+    template<typename ContainerT, typename PointT> void
+    OutofcoreOctreeBase<ContainerT, PointT>::setNumberOfThreads (unsigned int nr_threads)
+    {
+      boost::unique_lock < boost::shared_mutex > lock (read_write_mutex_);
+      threads_ = (nr_threads == 0) ? boost::thread::hardware_concurrency () : nr_threads;
+      if (threads_ == 0)
+        threads_ = 1;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+
+    template<typename ContainerT, typename PointT> void
+    OutofcoreOctreeBase<ContainerT, PointT>::startAsyncWriter ()
+    {
+      if (threads_ > 1 && root_node_->getDepth () < this->getDepth ())
+        writer_.reset (new OutofcoreAsyncWriter (write_queue_size_));
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+
+    template<typename ContainerT, typename PointT> void
+    OutofcoreOctreeBase<ContainerT, PointT>::stopAsyncWriter ()
+    {
+      // waits for all the queued writes to reach the node containers
+      boost::shared_ptr<OutofcoreAsyncWriter> writer;
+      writer.swap (writer_);
+      if (writer)
+        writer->flush ();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+
     template<typename Container, typename PointT> void
     OutofcoreOctreeBase<Container, PointT>::queryFrustum (const double planes[24], std::list<std::string>& file_names) const
     {
@@ -683,6 +750,9 @@ namespace pcl
     template<typename ContainerT, typename PointT> void
     OutofcoreOctreeBase<ContainerT, PointT>::incrementPointsInLOD (boost::uint64_t depth, boost::uint64_t new_point_count)
     {
+      // subtrees may be built concurrently
+      boost::mutex::scoped_lock lock (lod_mutex_);
+
       if (std::numeric_limits<uint64_t>::max () - metadata_->getLODPoints (depth) < new_point_count)
       {
         PCL_ERROR ("[pcl::outofcore::OutofcoreOctreeBase::incrementPointsInLOD] Overflow error. Too many points in depth %d of outofcore octree with root at %s\n", depth, metadata_->getMetadataFilename().c_str());
@@ -47,6 +47,7 @@
 #include <sstream>
 #include <string>
 #include <exception>
+#include <algorithm>
 
 #include <pcl/common/common.h>
 #include <pcl/visualization/common/common.h>
@@ -74,12 +75,6 @@ namespace pcl
     template<typename ContainerT, typename PointT>
     const std::string OutofcoreOctreeBaseNode<ContainerT, PointT>::node_container_extension = ".oct_dat";
 
-    template<typename ContainerT, typename PointT>
-    boost::mutex OutofcoreOctreeBaseNode<ContainerT, PointT>::rng_mutex_;
-
-    template<typename ContainerT, typename PointT>
-    boost::mt19937 OutofcoreOctreeBaseNode<ContainerT, PointT>::rand_gen_;
-
     template<typename ContainerT, typename PointT>
     const double OutofcoreOctreeBaseNode<ContainerT, PointT>::sample_percent_ = .125;
 
@@ -396,17 +391,18 @@ namespace pcl
         c[static_cast<size_t>(box)].push_back (&pt);
       }
       
-      boost::uint64_t points_added = 0;
+      boost::uint64_t (OutofcoreOctreeBaseNode::*add_to_child) (const std::vector<const PointT*>&, const bool) = &OutofcoreOctreeBaseNode::addDataToLeaf;
+
+      std::vector<ChildJob> jobs;
       for (size_t i = 0; i < 8; i++)
       {
         if (c[i].empty ())
           continue;
         if (!children_[i])
           createChild (i);
-        points_added += children_[i]->addDataToLeaf (c[i], true);
-        c[i].clear ();
+        jobs.push_back (boost::bind (add_to_child, children_[i], boost::cref (c[i]), true));
       }
-      return (points_added);
+      return (runChildJobs (jobs));
     }
     ////////////////////////////////////////////////////////////////////////////////
 
@@ -426,7 +422,7 @@ namespace pcl
         {
           root_node_->m_tree_->incrementPointsInLOD (this->depth_, p.size ());
           
-          payload_->insertRange (p.data (), p.size ());
+          writePayload (p);
           
           return (p.size ());
         }
@@ -444,8 +440,7 @@ namespace pcl
           if (!buff.empty ())
           {
             root_node_->m_tree_->incrementPointsInLOD (this->depth_, buff.size ());
-            payload_->insertRange (buff.data (), buff.size ());
-//            payload_->insertRange ( buff );
+            writePayload (buff);
             
           }
           return (buff.size ());
@@ -590,15 +585,25 @@ namespace pcl
       const uint64_t samplesize = static_cast<uint64_t>(percent * static_cast<double>(sampleBuff.size()));
       const uint64_t inputsize = sampleBuff.size();
 
+      // Seed a generator from the node and the size of its input, so that the sample does not depend on the
+      // order in which concurrently built subtrees draw their random numbers
+      std::size_t seed = rngseed;
+      const Eigen::Vector3d voxel_center = node_metadata_->getVoxelCenter ();
+      boost::hash_combine (seed, depth_);
+      boost::hash_combine (seed, voxel_center[0]);
+      boost::hash_combine (seed, voxel_center[1]);
+      boost::hash_combine (seed, voxel_center[2]);
+      boost::hash_combine (seed, inputsize);
+      boost::mt19937 rand_gen (static_cast<boost::uint32_t> (seed));
+
       if(samplesize > 0)
       {
         // Resize buffer to sample size
         insertBuff.resize(samplesize);
 
         // Create random number generator
-        boost::mutex::scoped_lock lock(rng_mutex_);
         boost::uniform_int<boost::uint64_t> buffdist(0, inputsize-1);
-        boost::variate_generator<boost::mt19937&, boost::uniform_int<boost::uint64_t> > buffdie(rand_gen_, buffdist);
+        boost::variate_generator<boost::mt19937&, boost::uniform_int<boost::uint64_t> > buffdie(rand_gen, buffdist);
 
         // Randomly pick sampled points
         for(boost::uint64_t i = 0; i < samplesize; ++i)
@@ -610,9 +615,8 @@ namespace pcl
       // Have to do it the slow way
       else
       {
-        boost::mutex::scoped_lock lock(rng_mutex_);
         boost::bernoulli_distribution<double> buffdist(percent);
-        boost::variate_generator<boost::mt19937&, boost::bernoulli_distribution<double> > buffcoin(rand_gen_, buffdist);
+        boost::variate_generator<boost::mt19937&, boost::bernoulli_distribution<double> > buffcoin(rand_gen, buffdist);
 
         for(boost::uint64_t i = 0; i < inputsize; ++i)
           if(buffcoin())
@@ -633,7 +637,7 @@ namespace pcl
         root_node_->m_tree_->incrementPointsInLOD (this->depth_, p.size ());
 
         // Insert point data
-        payload_->insertRange ( p );
+        writePayload (p);
         
         return (p.size ());
       }
@@ -655,7 +659,7 @@ namespace pcl
         if (!buff.empty ())
         {
           root_node_->m_tree_->incrementPointsInLOD (this->depth_, buff.size ());
-          payload_->insertRange ( buff );
+          writePayload (buff);
           
         }
         return (buff.size ());
@@ -846,7 +850,7 @@ namespace pcl
         // Increment point count for node
         root_node_->m_tree_->incrementPointsInLOD (this->depth_, insertBuff.size());
         // Insert sampled point data
-        payload_->insertRange (insertBuff);
+        writePayload (insertBuff);
         
       }
 
@@ -854,7 +858,7 @@ namespace pcl
       std::vector<AlignedPointTVector> c;
       subdividePoints(p, c, skip_bb_check);
 
-      boost::uint64_t points_added = 0;
+      std::vector<ChildJob> jobs;
       for(size_t i = 0; i < 8; i++)
       {
         // If child doesn't have points
@@ -866,14 +870,121 @@ namespace pcl
           createChild(i);
 
         // Recursively build children
-        points_added += children_[i]->addDataToLeaf_and_genLOD(c[i], true);
-        c[i].clear();
+        jobs.push_back (boost::bind (&OutofcoreOctreeBaseNode::addDataToLeaf_and_genLOD, children_[i], boost::cref (c[i]), true));
       }
 
+      return (runChildJobs (jobs));
+    }
+    ////////////////////////////////////////////////////////////////////////////////
+
+    template<typename ContainerT, typename PointT> boost::uint64_t
+    OutofcoreOctreeBaseNode<ContainerT, PointT>::runChildJobs (const std::vector<ChildJob>& jobs)
+    {
+      boost::uint64_t points_added = 0;
+
+      // only the subtrees of the root octants are built concurrently
+      const bool parallel = (this == root_node_) && root_node_->m_tree_->writer_ && (jobs.size () > 1);
+      if (!parallel)
+      {
+        for (size_t i = 0; i < jobs.size (); i++)
+          points_added += jobs[i] ();
+        return (points_added);
+      }
+
+      std::vector<boost::uint64_t> job_points_added (jobs.size (), 0);
+      size_t next_job = 0;
+      boost::mutex job_mutex;
+      boost::exception_ptr error;
+
+      const size_t nr_threads = std::min (static_cast<size_t> (root_node_->m_tree_->getNumberOfThreads ()), jobs.size ());
+
+      boost::thread_group workers;
+      for (size_t i = 0; i < nr_threads; i++)
+      {
+        workers.create_thread (boost::bind (&OutofcoreOctreeBaseNode::runChildJobsWorker, boost::cref (jobs), boost::ref (next_job),
+                                            boost::ref (job_mutex), boost::ref (job_points_added), boost::ref (error)));
+      }
+      workers.join_all ();
+
+      if (error)
+        boost::rethrow_exception (error);
+
+      for (size_t i = 0; i < job_points_added.size (); i++)
+        points_added += job_points_added[i];
+
       return (points_added);
     }
     ////////////////////////////////////////////////////////////////////////////////
 
+    template<typename ContainerT, typename PointT> void
+    OutofcoreOctreeBaseNode<ContainerT, PointT>::runChildJobsWorker (const std::vector<ChildJob>& jobs, size_t& next_job, boost::mutex& job_mutex,
+                                                                     std::vector<boost::uint64_t>& points_added, boost::exception_ptr& error)
+    {
+      for (;;)
+      {
+        size_t job = 0;
+        {
+          boost::mutex::scoped_lock lock (job_mutex);
+          if (next_job >= jobs.size () || error)
+            return;
+          job = next_job++;
+        }
+
+        try
+        {
+          points_added[job] = jobs[job] ();
+        }
+        catch (...)
+        {
+          boost::mutex::scoped_lock lock (job_mutex);
+          if (!error)
+            error = boost::current_exception ();
+        }
+      }
+    }
+    ////////////////////////////////////////////////////////////////////////////////
+
+    template<typename ContainerT, typename PointT> void
+    OutofcoreOctreeBaseNode<ContainerT, PointT>::writePayload (const AlignedPointTVector& p)
+    {
+      const boost::shared_ptr<OutofcoreAsyncWriter>& writer = root_node_->m_tree_->writer_;
+      if (!writer)
+      {
+        payload_->insertRange (p);
+        return;
+      }
+
+      boost::shared_ptr<AlignedPointTVector> points (new AlignedPointTVector (p));
+      writer->push (boost::bind (&OutofcoreOctreeBaseNode::insertRangeJob, payload_, points));
+    }
+    ////////////////////////////////////////////////////////////////////////////////
+
+    template<typename ContainerT, typename PointT> void
+    OutofcoreOctreeBaseNode<ContainerT, PointT>::writePayload (const std::vector<const PointT*>& p)
+    {
+      const boost::shared_ptr<OutofcoreAsyncWriter>& writer = root_node_->m_tree_->writer_;
+      if (!writer)
+      {
+        payload_->insertRange (p.data (), p.size ());
+        return;
+      }
+
+      boost::shared_ptr<AlignedPointTVector> points (new AlignedPointTVector ());
+      points->reserve (p.size ());
+      for (size_t i = 0; i < p.size (); i++)
+        points->push_back (*p[i]);
+      writer->push (boost::bind (&OutofcoreOctreeBaseNode::insertRangeJob, payload_, points));
+    }
+    ////////////////////////////////////////////////////////////////////////////////
+
+    template<typename ContainerT, typename PointT> void
+    OutofcoreOctreeBaseNode<ContainerT, PointT>::insertRangeJob (const boost::shared_ptr<ContainerT>& payload, const boost::shared_ptr<AlignedPointTVector>& points)
+    {
+      if (!points->empty ())
+        payload->insertRange (&(*points)[0], points->size ());
+    }
+    ////////////////////////////////////////////////////////////////////////////////
+
     template<typename ContainerT, typename PointT> void
     OutofcoreOctreeBaseNode<ContainerT, PointT>::createChild (const size_t idx)
     {
@@ -44,6 +44,7 @@
 #include <sstream>
 #include <cassert>
 #include <ctime>
+#include <algorithm>
 
 // Boost
 #include <pcl/outofcore/boost.h>
@@ -76,6 +77,16 @@ namespace pcl
     template<typename PointT>
     boost::uuids::random_generator OutofcoreOctreeDiskContainer<PointT>::uuid_gen_ (&rand_gen_);
 
+    template<typename PointT>
+    typename OutofcoreOctreeDiskContainer<PointT>::PayloadCache
+    OutofcoreOctreeDiskContainer<PointT>::payload_cache_ (256 * 1024);
+
+    template<typename PointT>
+    boost::mutex OutofcoreOctreeDiskContainer<PointT>::payload_cache_mutex_;
+
+    template<typename PointT>
+    size_t OutofcoreOctreeDiskContainer<PointT>::payload_cache_timestamp_ = 0;
+
     template<typename PointT>
     const uint64_t OutofcoreOctreeDiskContainer<PointT>::READ_BLOCK_SIZE_ = static_cast<uint64_t> (2e12);
     template<typename PointT>
@@ -168,32 +179,116 @@ namespace pcl
     {
       if (writebuff_.size () > 0)
       {
-        //construct the point cloud for this node
-        typename pcl::PointCloud<PointT>::Ptr cloud (new pcl::PointCloud<PointT>);
-        
-        cloud->width = static_cast<uint32_t> (writebuff_.size ());
-        cloud->height = 1;
-
-        cloud->points = writebuff_;
+        appendPayload (NULL, 0);
+      }
 
-        //write data to a pcd file
-        pcl::PCDWriter writer;
+      if (force_cache_dealloc)
+      {
+        AlignedPointTVector ().swap (writebuff_);
+      }
+    }
+    ////////////////////////////////////////////////////////////////////////////////
 
+    template<typename PointT> typename pcl::PointCloud<PointT>::ConstPtr
+    OutofcoreOctreeDiskContainer<PointT>::loadPayload () const
+    {
+      {
+        boost::mutex::scoped_lock lock (payload_cache_mutex_);
+        if (payload_cache_.hasKey (*disk_storage_filename_))
+        {
+          PayloadCacheItem& cache_item = payload_cache_.get (*disk_storage_filename_);
+          cache_item.timestamp = ++payload_cache_timestamp_;
+          return (cache_item.item);
+        }
+      }
 
-        PCL_WARN ("[pcl::outofcore::OutofcoreOctreeDiskContainer::%s] Flushing writebuffer in a dangerous way to file %s. This might overwrite data in destination file\n", __FUNCTION__, disk_storage_filename_->c_str ());
-        
-        // Write ascii for now to debug
-        int res = writer.writeBinaryCompressed (*disk_storage_filename_, *cloud);
-        (void)res;
-        assert (res == 0);
-        if (force_cache_dealloc)
+      typename pcl::PointCloud<PointT>::Ptr cloud (new pcl::PointCloud<PointT> ());
+      if (boost::filesystem::exists (*disk_storage_filename_))
+      {
+        // binary (compressed) PCD files are read through a single memory mapping
+        pcl::PCDReader reader;
+        int res = reader.read (*disk_storage_filename_, *cloud);
+        if (res != 0)
         {
-          writebuff_.resize (0);
+          PCL_ERROR ("[pcl::outofcore::OutofcoreOctreeDiskContainer::%s] Failed to read points from %s\n", __FUNCTION__, disk_storage_filename_->c_str ());
+          return (cloud);
         }
+
+        boost::mutex::scoped_lock lock (payload_cache_mutex_);
+        payload_cache_.erase (*disk_storage_filename_);
+        payload_cache_.insert (*disk_storage_filename_, PayloadCacheItem (cloud, ++payload_cache_timestamp_));
+      }
+      return (cloud);
+    }
+    ////////////////////////////////////////////////////////////////////////////////
+
+    template<typename PointT> void
+    OutofcoreOctreeDiskContainer<PointT>::appendPayload (const PointT* start, const uint64_t count)
+    {
+      typename pcl::PointCloud<PointT>::ConstPtr stored = loadPayload ();
+
+      // cached payloads may be shared with readers, so the points are appended to a copy
+      typename pcl::PointCloud<PointT>::Ptr cloud (new pcl::PointCloud<PointT> ());
+      cloud->points.reserve (stored->points.size () + writebuff_.size () + count);
+      cloud->points.insert (cloud->points.end (), stored->points.begin (), stored->points.end ());
+      cloud->points.insert (cloud->points.end (), writebuff_.begin (), writebuff_.end ());
+      if (count > 0)
+        cloud->points.insert (cloud->points.end (), start, start + count);
+
+      //assume unorganized point cloud
+      cloud->width = static_cast<uint32_t> (cloud->points.size ());
+      cloud->height = 1;
+
+      //save and close
+      PCDWriter writer;
+      int res = writer.writeBinaryCompressed (*disk_storage_filename_, *cloud);
+      (void)res;
+      assert (res == 0);
+
+      filelen_ = cloud->points.size ();
+      writebuff_.clear ();
+
+      boost::mutex::scoped_lock lock (payload_cache_mutex_);
+      payload_cache_.erase (*disk_storage_filename_);
+      payload_cache_.insert (*disk_storage_filename_, PayloadCacheItem (cloud, ++payload_cache_timestamp_));
+    }
+    ////////////////////////////////////////////////////////////////////////////////
+
+    template<typename PointT> void
+    OutofcoreOctreeDiskContainer<PointT>::invalidatePayload () const
+    {
+      boost::mutex::scoped_lock lock (payload_cache_mutex_);
+      payload_cache_.erase (*disk_storage_filename_);
+    }
+    ////////////////////////////////////////////////////////////////////////////////
+
+    template<typename PointT> void
+    OutofcoreOctreeDiskContainer<PointT>::setPayloadCacheCapacity (size_t capacity_kb)
+    {
+      boost::mutex::scoped_lock lock (payload_cache_mutex_);
+      payload_cache_.setCapacity (capacity_kb);
+      while (payload_cache_.size_ > capacity_kb && payload_cache_.evict ())
+      {
       }
     }
     ////////////////////////////////////////////////////////////////////////////////
 
+    template<typename PointT> size_t
+    OutofcoreOctreeDiskContainer<PointT>::getPayloadCacheCapacity ()
+    {
+      boost::mutex::scoped_lock lock (payload_cache_mutex_);
+      return (payload_cache_.capacity_);
+    }
+    ////////////////////////////////////////////////////////////////////////////////
+
+    template<typename PointT> void
+    OutofcoreOctreeDiskContainer<PointT>::clearPayloadCache ()
+    {
+      boost::mutex::scoped_lock lock (payload_cache_mutex_);
+      payload_cache_.clear ();
+    }
+    ////////////////////////////////////////////////////////////////////////////////
+
     template<typename PointT> PointT
     OutofcoreOctreeDiskContainer<PointT>::operator[] (uint64_t idx) const
     {
@@ -249,16 +344,24 @@ namespace pcl
         PCL_THROW_EXCEPTION (PCLException, "[pcl::outofcore::OutofcoreOctreeDiskContainer] Outofcore Octree Exception: Read indices exceed range");
       }
 
-      pcl::PCDReader reader;
-      typename pcl::PointCloud<PointT>::Ptr cloud (new pcl::PointCloud<PointT> ());
-      
-      int res = reader.read (*disk_storage_filename_, *cloud);
-      (void)res;
-      assert (res == 0);
-      
-      for (size_t i=0; i < cloud->points.size (); i++)
-        dst.push_back (cloud->points[i]);
-      
+      const uint64_t end = start + count;
+      dst.reserve (dst.size () + count);
+
+      // points stored in the PCD file
+      if (start < filelen_)
+      {
+        typename pcl::PointCloud<PointT>::ConstPtr payload = loadPayload ();
+        const uint64_t file_end = std::min (end, static_cast<uint64_t> (payload->points.size ()));
+        if (start < file_end)
+          dst.insert (dst.end (), payload->points.begin () + start, payload->points.begin () + file_end);
+      }
+
+      // points which have not been flushed to disk yet
+      if (end > filelen_)
+      {
+        const uint64_t buff_start = (start > filelen_) ? start - filelen_ : 0;
+        dst.insert (dst.end (), writebuff_.begin () + buff_start, writebuff_.begin () + (end - filelen_));
+      }
     }
     ////////////////////////////////////////////////////////////////////////////////
 
@@ -331,25 +434,14 @@ namespace pcl
         }
         std::sort (offsets.begin (), offsets.end ());
 
-        FILE* f = fopen (disk_storage_filename_->c_str (), "rb");
-        assert (f != NULL);
-        PointT p;
-        char* loc = reinterpret_cast<char*> (&p);
-        
+        typename pcl::PointCloud<PointT>::ConstPtr payload = loadPayload ();
+
         uint64_t filesamp = offsets.size ();
-        for (uint64_t i = 0; i < filesamp; i++)
+        dst.reserve (dst.size () + filesamp);
+        for (uint64_t i = 0; i < filesamp && offsets[i] < payload->points.size (); i++)
         {
-          int seekret = _fseeki64 (f, offsets[i] * static_cast<uint64_t> (sizeof(PointT)), SEEK_SET);
-          (void)seekret;
-          assert (seekret == 0);
-          size_t readlen = fread (loc, sizeof(PointT), 1, f);
-          (void)readlen;
-          assert (readlen == 1);
-
-          dst.push_back (p);
+          dst.push_back (payload->points[offsets[i]]);
         }
-
-        fclose (f);
       }
     }
     ////////////////////////////////////////////////////////////////////////////////
@@ -430,24 +522,13 @@ namespace pcl
         }
         std::sort (offsets.begin (), offsets.end ());
 
-        FILE* f = fopen (disk_storage_filename_->c_str (), "rb");
-        assert (f != NULL);
-        PointT p;
-        char* loc = reinterpret_cast<char*> (&p);
-        for (uint64_t i = 0; i < filesamp; i++)
+        typename pcl::PointCloud<PointT>::ConstPtr payload = loadPayload ();
+
+        dst.reserve (dst.size () + filesamp);
+        for (uint64_t i = 0; i < filesamp && offsets[i] < payload->points.size (); i++)
         {
-          int seekret = _fseeki64 (f, offsets[i] * static_cast<uint64_t> (sizeof(PointT)), SEEK_SET);
-          (void)seekret;
-          assert (seekret == 0);
-          size_t readlen = fread (loc, sizeof(PointT), 1, f);
-          (void)readlen;
-          assert (readlen == 1);
-
-          dst.push_back (p);
+          dst.push_back (payload->points[offsets[i]]);
         }
-        int res = fclose (f);
-        (void)res;
-        assert (res == 0);
       }
     }
     ////////////////////////////////////////////////////////////////////////////////
@@ -466,44 +547,7 @@ namespace pcl
     template<typename PointT> void
     OutofcoreOctreeDiskContainer<PointT>::insertRange (const AlignedPointTVector& src)
     {
-      const uint64_t count = src.size ();
-      
-      typename pcl::PointCloud<PointT>::Ptr tmp_cloud (new pcl::PointCloud<PointT> ());
-      
-      // If there's a pcd file with data          
-      if (boost::filesystem::exists (*disk_storage_filename_))
-      {
-        // Open the existing file
-        pcl::PCDReader reader;
-        int res = reader.read (*disk_storage_filename_, *tmp_cloud);
-        (void)res;
-        assert (res == 0);
-      }
-      // Otherwise create the point cloud which will be saved to the pcd file for the first time
-      else 
-      {
-        tmp_cloud->width = static_cast<uint32_t> (count + writebuff_.size ());
-        tmp_cloud->height = 1;
-      }            
-
-      for (size_t i = 0; i < src.size (); i++)
-        tmp_cloud->points.push_back (src[i]);
-      
-      // If there are any points in the write cache writebuff_, a different write cache than this one, concatenate
-      for (size_t i = 0; i < writebuff_.size (); i++)
-      {
-        tmp_cloud->points.push_back (writebuff_[i]);
-      }
-
-      //assume unorganized point cloud
-      tmp_cloud->width = static_cast<uint32_t> (tmp_cloud->points.size ());
-            
-      //save and close
-      PCDWriter writer;
-      
-      int res = writer.writeBinaryCompressed (*disk_storage_filename_, *tmp_cloud);
-      (void)res;
-      assert (res == 0);
+      appendPayload (src.empty () ? NULL : &src[0], src.size ());
     }
   
     ////////////////////////////////////////////////////////////////////////////////
@@ -535,7 +579,7 @@ namespace pcl
         assert (previous_num_pts == res_pts);
         
         writer.writeBinaryCompressed (*disk_storage_filename_, *tmp_cloud);
-            
+        filelen_ = tmp_cloud->width * tmp_cloud->height;
       }
       else //otherwise create the point cloud which will be saved to the pcd file for the first time
       {
@@ -543,8 +587,11 @@ namespace pcl
         int res = writer.writeBinaryCompressed (*disk_storage_filename_, *input_cloud);
         (void)res;
         assert (res == 0);
+        filelen_ = input_cloud->width * input_cloud->height;
       }            
 
+      invalidatePayload ();
+
     }
 
     ////////////////////////////////////////////////////////////////////////////////
@@ -628,64 +675,15 @@ namespace pcl
     template<typename PointT> void
     OutofcoreOctreeDiskContainer<PointT>::insertRange (const PointT* start, const uint64_t count)
     {
-      typename pcl::PointCloud<PointT>::Ptr tmp_cloud (new pcl::PointCloud<PointT> ());
-
-      // If there's a pcd file with data, read it in from disk for appending
-      if (boost::filesystem::exists (*disk_storage_filename_))
-      {
-        pcl::PCDReader reader;
-        // Open it
-        int res = reader.read (disk_storage_filename_->c_str (), *tmp_cloud);
-        (void)res; 
-        assert (res == 0);
-      }
-      else //otherwise create the pcd file
-      {
-        tmp_cloud->width = static_cast<uint32_t> (count) + static_cast<uint32_t> (writebuff_.size ());
-        tmp_cloud->height = 1;
-      }            
-
-      // Add any points in the cache
-      for (size_t i = 0; i < writebuff_.size (); i++)
-      {
-        tmp_cloud->points.push_back (writebuff_ [i]);
-      }
-
-      //add the new points passed with this function
-      for (size_t i = 0; i < count; i++)
-      {
-        tmp_cloud->points.push_back (*(start + i));
-      }
-
-      tmp_cloud->width = static_cast<uint32_t> (tmp_cloud->points.size ());
-      tmp_cloud->height = 1;
-            
-      //save and close
-      PCDWriter writer;
-
-      int res = writer.writeBinaryCompressed (*disk_storage_filename_, *tmp_cloud);
-      (void)res;
-      assert (res == 0);
+      appendPayload (start, count);
     }
     ////////////////////////////////////////////////////////////////////////////////
 
     template<typename PointT> boost::uint64_t
     OutofcoreOctreeDiskContainer<PointT>::getDataSize () const
     {
-      pcl::PCLPointCloud2 cloud_info;
-      Eigen::Vector4f origin;
-      Eigen::Quaternionf orientation;
-      int pcd_version;
-      int data_type;
-      unsigned int data_index;
-      
-      //read the header of the pcd file and get the number of points
-      PCDReader reader;
-      reader.readHeader (*disk_storage_filename_, cloud_info, origin, orientation, pcd_version, data_type, data_index, 0);
-      
-      boost::uint64_t total_points = cloud_info.width * cloud_info.height + writebuff_.size ();
-
-      return (total_points);
+      // filelen_ is read from the PCD header on construction and kept up to date by every write
+      return (filelen_ + writebuff_.size ());
     }
     ////////////////////////////////////////////////////////////////////////////////
 
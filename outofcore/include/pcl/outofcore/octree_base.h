@@ -47,6 +47,7 @@
 #include <pcl/outofcore/octree_base_node.h>
 #include <pcl/outofcore/octree_disk_container.h>
 #include <pcl/outofcore/octree_ram_container.h>
+#include <pcl/outofcore/outofcore_async_writer.h>
 
 //outofcore iterators
 #include <pcl/outofcore/outofcore_iterator_base.h>
@@ -239,6 +240,7 @@ namespace pcl
         // --------------------------------------------------------------------------------
         /** \brief Recursively add points to the tree 
          *  \note shared read_write_mutex lock occurs
+         *  \note the subtrees of the root octants are filled concurrently when \ref setNumberOfThreads is not 1
          */
         boost::uint64_t
         addDataToLeaf (const AlignedPointTVector &p);
@@ -290,9 +292,10 @@ namespace pcl
         /** \brief Recursively add points to the tree subsampling LODs on the way.
          *
          * shared read_write_mutex lock occurs
+         * \note the subtrees of the root octants are filled concurrently when \ref setNumberOfThreads is not 1
          */
         boost::uint64_t
-        addDataToLeaf_and_genLOD (AlignedPointTVector &p);
+        addDataToLeaf_and_genLOD (const AlignedPointTVector &p);
 
         // Frustrum/Box/Region REQUESTS/QUERIES: DB Accessors
         // -----------------------------------------------------------------------
@@ -564,6 +567,39 @@ namespace pcl
         {
           this->sample_percent_ = std::fabs (sample_percent_arg) > 1.0 ? 1.0 : std::fabs (sample_percent_arg);
         }
+
+        /** \brief Set the number of threads used when inserting points with \ref addDataToLeaf and
+         * \ref addDataToLeaf_and_genLOD. The input is partitioned by the octants of the root node, whose
+         * subtrees are then built concurrently; node containers are written by a single background writer.
+         * \param[in] nr_threads the number of threads to use (0 uses all the hardware threads, 1 inserts serially)
+         */
+        void
+        setNumberOfThreads (unsigned int nr_threads = 0);
+
+        /** \brief Returns the number of threads used when inserting points. */
+        inline unsigned int
+        getNumberOfThreads () const
+        {
+          return (threads_);
+        }
+
+        /** \brief Set the maximum number of container writes waiting for the background writer during a
+         * multi-threaded insertion; inserting threads block while the queue is full, which bounds the memory
+         * held by pending writes.
+         * \param[in] size maximum number of pending writes (0 for unbounded)
+         */
+        inline void
+        setWriteQueueSize (const size_t size)
+        {
+          write_queue_size_ = size;
+        }
+
+        /** \brief Returns the maximum number of pending container writes during a multi-threaded insertion. */
+        inline size_t
+        getWriteQueueSize () const
+        {
+          return (write_queue_size_);
+        }
 	
       protected:
         void
@@ -593,6 +629,16 @@ namespace pcl
         void
         saveToFile ();
 
+        /** \brief Start the background writer used by the node containers if points are inserted by multiple threads */
+        void
+        startAsyncWriter ();
+
+        /** \brief Wait for the pending container writes and stop the background writer
+         *  \throws the exception of the first container write that failed, if any
+         */
+        void
+        stopAsyncWriter ();
+
         /** \brief recursive portion of lod builder */
         void
         buildLODRecursive (const std::vector<BranchNode*>& current_branch);
@@ -657,6 +703,18 @@ namespace pcl
         double sample_percent_;
 
         pcl::RandomSample<pcl::PCLPointCloud2>::Ptr lod_filter_ptr_;
+
+        /** \brief Number of threads used to insert points */
+        unsigned int threads_;
+
+        /** \brief Maximum number of pending container writes */
+        size_t write_queue_size_;
+
+        /** \brief Background writer for the node containers; only set during multi-threaded insertions */
+        boost::shared_ptr<OutofcoreAsyncWriter> writer_;
+
+        /** \brief Mutex guarding the LOD point counts of the metadata */
+        boost::mutex lod_mutex_;
         
     };
   }
@@ -231,8 +231,6 @@ namespace pcl
         
         /** \brief Recursively add points to the leaf and children subsampling LODs
          * on the way down.
-         *
-         * \note rng_mutex_ lock occurs
          */
         virtual boost::uint64_t
         addDataToLeaf_and_genLOD (const AlignedPointTVector &p, const bool skip_bb_check);
@@ -360,7 +358,8 @@ namespace pcl
         void
         saveIdx (bool recursive);
 
-        /** \brief Randomly sample point data 
+        /** \brief Randomly sample point data; the generator is seeded from the node and the number of
+         *  input points, so the sample does not depend on the other subtrees built concurrently
          */
         void
         randomSample (const AlignedPointTVector &p, AlignedPointTVector &insertBuff, const bool skip_bb_check);
@@ -372,6 +371,37 @@ namespace pcl
         void
         subdividePoint (const PointT &point, std::vector< AlignedPointTVector > &c);
 
+        /** \brief Insertion job of a child octant, returning the number of points added */
+        typedef boost::function<boost::uint64_t ()> ChildJob;
+
+        /** \brief Runs the insertion jobs of the child octants. On the root node of a tree inserting with
+         *  multiple threads the jobs (i.e. the subtrees) are processed concurrently, otherwise in order.
+         *  \return total number of points added by the jobs
+         */
+        boost::uint64_t
+        runChildJobs (const std::vector<ChildJob> &jobs);
+
+        /** \brief Worker loop of \ref runChildJobs; takes the next pending job until all are done */
+        static void
+        runChildJobsWorker (const std::vector<ChildJob> &jobs, size_t &next_job, boost::mutex &job_mutex,
+                            std::vector<boost::uint64_t> &points_added, boost::exception_ptr &error);
+
+        /** \brief Appends points to the payload; queued on the tree's background writer during a
+         *  multi-threaded insertion
+         */
+        void
+        writePayload (const AlignedPointTVector &p);
+
+        /** \brief Appends the pointed to points to the payload; queued on the tree's background writer
+         *  during a multi-threaded insertion
+         */
+        void
+        writePayload (const std::vector<const PointT*> &p);
+
+        /** \brief Write job run by the tree's background writer */
+        static void
+        insertRangeJob (const boost::shared_ptr<ContainerT> &payload, const boost::shared_ptr<AlignedPointTVector> &points);
+
         /** \brief Add data to the leaf when at max depth of tree. If
          *   skip_bb_check is true, adds to the node regardless of the
          *   bounding box it represents; otherwise only adds points that
@@ -557,14 +587,7 @@ namespace pcl
          * to use deques for this... */
         boost::shared_ptr<ContainerT> payload_;
 
-        /** \brief Random number generator mutex */
-        static boost::mutex rng_mutex_;
-
-        /** \brief Mersenne Twister: A 623-dimensionally equidistributed uniform
-         * pseudo-random number generator */
-        static boost::mt19937 rand_gen_;
-
-        /** \brief Random number generator seed */
+        /** \brief Random number generator seed, combined with the node's position for the LOD samples */
         const static boost::uint32_t rngseed = 0xAABBCCDD;
         /** \brief Extension for this class to find the pcd files on disk */
         const static std::string pcd_extension;
@@ -46,6 +46,7 @@
 
 #include <pcl/outofcore/boost.h>
 #include <pcl/outofcore/octree_abstract_node_container.h>
+#include <pcl/outofcore/impl/lru_cache.hpp>
 #include <pcl/io/pcd_io.h>
 #include <pcl/PCLPointCloud2.h>
 
@@ -60,6 +61,27 @@ namespace pcl
 {
   namespace outofcore
   {
+    /** \brief Decoded point payload of a node, as stored in the payload cache of OutofcoreOctreeDiskContainer
+     *  \ingroup outofcore
+     */
+    template<typename PointT>
+    class OutofcoreDiskPayloadCacheItem : public LRUCacheItem<typename pcl::PointCloud<PointT>::Ptr>
+    {
+      public:
+        OutofcoreDiskPayloadCacheItem (const typename pcl::PointCloud<PointT>::Ptr &cloud, size_t timestamp)
+        {
+          this->item = cloud;
+          this->timestamp = timestamp;
+        }
+
+        /** \brief Size of the decoded points in kilobytes */
+        virtual size_t
+        sizeOf () const
+        {
+          return ((this->item->points.size () * sizeof (PointT)) / 1024 + 1);
+        }
+    };
+
   /** \class OutofcoreOctreeDiskContainer
    *  \note Code was adapted from the Urban Robotics out of core octree implementation. 
    *  Contact Jacob Schloss <jacob.schloss@urbanrobotics.net> with any questions. 
@@ -75,6 +97,9 @@ namespace pcl
   
       public:
         typedef typename OutofcoreAbstractNodeContainer<PointT>::AlignedPointTVector AlignedPointTVector;
+
+        typedef OutofcoreDiskPayloadCacheItem<PointT> PayloadCacheItem;
+        typedef LRUCache<std::string, PayloadCacheItem> PayloadCache;
         
         /** \brief Empty constructor creates disk container and sets filename from random uuid string*/
         OutofcoreOctreeDiskContainer ();
@@ -126,7 +151,8 @@ namespace pcl
 
         /** \brief Reads \b count points into memory from the disk container
          *
-         * Reads \b count points into memory from the disk container, reading at most 2 million elements at a time
+         * The payload file is decoded at most once (with a memory mapped read) and kept in the payload
+         * cache shared by all disk containers, so that repeated range reads of a node do not touch the disk.
          *
          * \param[in] start index of first point to read from disk
          * \param[in] count offset of last point to read from disk
@@ -206,6 +232,8 @@ namespace pcl
         {
           //clear elements that have not yet been written to disk
           writebuff_.clear ();
+          //drop the decoded payload
+          invalidatePayload ();
           //remove the binary data in the directory
           PCL_DEBUG ("[Octree Disk Container] Removing the point data from disk, in file %s\n",disk_storage_filename_->c_str ());
           boost::filesystem::remove (boost::filesystem::path (disk_storage_filename_->c_str ()));
@@ -223,36 +251,24 @@ namespace pcl
           if (boost::filesystem::exists (*disk_storage_filename_))
           {
             FILE* fxyz = fopen (path.string ().c_str (), "w");
+            assert (fxyz != NULL);
 
-            FILE* f = fopen (disk_storage_filename_->c_str (), "rb");
-            assert (f != NULL);
+            typename pcl::PointCloud<PointT>::ConstPtr payload = loadPayload ();
 
-            uint64_t num = size ();
-            PointT p;
-            char* loc = reinterpret_cast<char*> ( &p );
-
-            for (uint64_t i = 0; i < num; i++)
+            std::stringstream ss;
+            ss << std::fixed;
+            ss.precision (16);
+            for (size_t i = 0; i < payload->points.size (); i++)
             {
-              int seekret = _fseeki64 (f, i * sizeof (PointT), SEEK_SET);
-              (void)seekret;
-              assert (seekret == 0);
-              size_t readlen = fread (loc, sizeof (PointT), 1, f);
-              (void)readlen;
-              assert (readlen == 1);
-
-              //of << p.x << "\t" << p.y << "\t" << p.z << "\n";
-              std::stringstream ss;
-              ss << std::fixed;
-              ss.precision (16);
+              const PointT& p = payload->points[i];
+              ss.str ("");
               ss << p.x << "\t" << p.y << "\t" << p.z << "\n";
 
               fwrite (ss.str ().c_str (), 1, ss.str ().size (), fxyz);
             }
-            int res = fclose (f);
+            int res = fclose (fxyz);
             (void)res;
             assert (res == 0);
-            res = fclose (fxyz);
-            assert (res == 0);
           }
         }
 
@@ -264,9 +280,24 @@ namespace pcl
         static void
         getRandomUUIDString (std::string &s);
 
-        /** \brief Returns the number of points in the PCD file by reading the PCD header. */
+        /** \brief Returns the number of points stored in the PCD file and in the write buffer. */
         boost::uint64_t
         getDataSize () const;
+
+        /** \brief Set the capacity of the cache of decoded node payloads, shared by all disk containers
+         *  of this point type.
+         *  \param[in] capacity_kb capacity of the cache in kilobytes; 0 disables the cache
+         */
+        static void
+        setPayloadCacheCapacity (size_t capacity_kb);
+
+        /** \brief Get the capacity of the cache of decoded node payloads, in kilobytes. */
+        static size_t
+        getPayloadCacheCapacity ();
+
+        /** \brief Remove all decoded node payloads from the payload cache. */
+        static void
+        clearPayloadCache ();
         
       private:
         //no copy construction
@@ -278,6 +309,22 @@ namespace pcl
 
         void
         flushWritebuff (const bool force_cache_dealloc);
+
+        /** \brief Get the decoded points stored in the PCD file, from the payload cache if possible.
+         *  \return the stored points (empty if the file does not exist yet)
+         */
+        typename pcl::PointCloud<PointT>::ConstPtr
+        loadPayload () const;
+
+        /** \brief Append the points of the write buffer and \a count points from \a start to the
+         *  payload, and rewrite the PCD file in a single pass. The write buffer is emptied.
+         */
+        void
+        appendPayload (const PointT* start, const uint64_t count);
+
+        /** \brief Remove the decoded points of this container from the payload cache */
+        void
+        invalidatePayload () const;
     
         /** \brief Name of the storage file on disk (i.e., the PCD file) */
         boost::shared_ptr<std::string> disk_storage_filename_;
@@ -294,6 +341,11 @@ namespace pcl
 
         static const uint64_t WRITE_BUFF_MAX_;
 
+        /** \brief Cache of decoded payloads, keyed by file name */
+        static PayloadCache payload_cache_;
+        static boost::mutex payload_cache_mutex_;
+        static size_t payload_cache_timestamp_;
+
         static boost::mutex rng_mutex_;
         static boost::mt19937 rand_gen_;
         static boost::uuids::random_generator uuid_gen_;
@@ -0,0 +1,152 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2010-2012, Willow Garage, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage, Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * $Id$
+ */
+
+#ifndef PCL_OUTOFCORE_ASYNC_WRITER_H_
+#define PCL_OUTOFCORE_ASYNC_WRITER_H_
+
+#include <pcl/outofcore/boost.h>
+#include <pcl/outofcore/impl/monitor_queue.hpp>
+#include <pcl/console/print.h>
+
+namespace pcl
+{
+  namespace outofcore
+  {
+    /** \class OutofcoreAsyncWriter
+     *  \brief Executes disk write jobs in FIFO order on a single background thread.
+     *
+     *  Jobs are queued in a bounded \ref MonitorQueue, so producers block once
+     *  \a max_pending_jobs writes are waiting. Since all the jobs run on the same
+     *  thread, writes to the same node container are never reordered. The first
+     *  exception thrown by a job is kept and rethrown by \ref flush; the jobs
+     *  queued after a failed one are discarded. The destructor waits for all the
+     *  queued jobs to finish.
+     *
+     *  \ingroup outofcore
+     */
+    class OutofcoreAsyncWriter : boost::noncopyable
+    {
+      public:
+        typedef boost::function<void ()> Job;
+
+        /** \brief Starts the writer thread.
+         *  \param[in] max_pending_jobs maximum number of jobs waiting in the queue (0 for unbounded)
+         */
+        OutofcoreAsyncWriter (const size_t max_pending_jobs = 64)
+          : jobs_ (max_pending_jobs)
+          , thread_ ()
+          , error_ ()
+        {
+          thread_ = boost::thread (&OutofcoreAsyncWriter::run, this);
+        }
+
+        /** \brief Waits for the pending jobs and stops the writer thread, unless \ref flush was called. */
+        ~OutofcoreAsyncWriter ()
+        {
+          if (thread_.joinable ())
+          {
+            stop ();
+            if (error_)
+              PCL_ERROR ("[pcl::outofcore::OutofcoreAsyncWriter] A write job failed, its points were not written\n");
+          }
+        }
+
+        /** \brief Waits for the pending jobs and stops the writer thread; no jobs may be pushed afterwards.
+         *  \throws the exception of the first job that failed, if any
+         */
+        void
+        flush ()
+        {
+          if (thread_.joinable ())
+            stop ();
+          if (error_)
+            boost::rethrow_exception (error_);
+        }
+
+        /** \brief Queues a write job; blocks while the queue is full. */
+        void
+        push (const Job& job)
+        {
+          if (!job.empty ())
+            jobs_.push (job);
+        }
+
+      private:
+        void
+        stop ()
+        {
+          // an empty job terminates the writer loop
+          jobs_.push (Job ());
+          thread_.join ();
+        }
+
+        void
+        run ()
+        {
+          for (;;)
+          {
+            Job job = jobs_.pop ();
+            if (job.empty ())
+              break;
+
+            // keep draining the queue after a failure so that producers never block
+            if (error_)
+              continue;
+
+            try
+            {
+              job ();
+            }
+            catch (...)
+            {
+              error_ = boost::current_exception ();
+            }
+          }
+        }
+
+        MonitorQueue<Job> jobs_;
+
+        boost::thread thread_;
+
+        /** \brief Exception of the first failed job; only accessed by the writer thread until it is joined */
+        boost::exception_ptr error_;
+    };
+  }
+}
+
+#endif // PCL_OUTOFCORE_ASYNC_WRITER_H_
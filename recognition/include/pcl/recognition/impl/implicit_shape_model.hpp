@@ -1245,7 +1245,7 @@ pcl::ism::ImplicitShapeModelEstimation<FeatureSize, PointT, NormalT>::estimateFe
   typename pcl::search::Search<PointT>::Ptr tree = boost::shared_ptr<pcl::search::Search<PointT> > (new pcl::search::KdTree<PointT>);
 //  tree->setInputCloud (point_cloud);
 
-  feature_estimator_->setInputCloud (sampled_point_cloud->makeShared ());
+  feature_estimator_->setInputCloud (sampled_point_cloud);
 //  feature_estimator_->setSearchSurface (point_cloud->makeShared ());
   feature_estimator_->setSearchMethod (tree);
 
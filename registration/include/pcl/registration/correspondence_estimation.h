@@ -49,6 +49,9 @@
 #include <pcl/pcl_macros.h>
 
 #include <pcl/registration/correspondence_types.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace pcl
 {
@@ -102,6 +105,8 @@ namespace pcl
           , source_cloud_updated_ (true)
           , force_no_recompute_ (false)
           , force_no_recompute_reciprocal_ (false)
+          , threads_ (1)
+          , thread_correspondences_ ()
         {
         }
       
@@ -281,6 +286,26 @@ namespace pcl
         determineReciprocalCorrespondences (pcl::Correspondences &correspondences,
                                             double max_distance = std::numeric_limits<double>::max ()) = 0;
 
+        /** \brief Set the number of threads used to search the correspondences of the source points.
+          * The correspondences are found in the same order regardless of the number of threads.
+          * \param[in] nr_threads the number of hardware threads to use (0 sets the value back to automatic)
+          */
+        inline void
+        setNumberOfThreads (unsigned int nr_threads = 0)
+        {
+#ifdef _OPENMP
+          threads_ = nr_threads != 0 ? nr_threads : static_cast<unsigned int> (omp_get_num_procs ());
+#else
+          if (nr_threads != 1)
+            PCL_WARN ("[pcl::registration::%s::setNumberOfThreads] PCL was compiled without OpenMP, using a single thread.\n", getClassName ().c_str ());
+          threads_ = 1;
+#endif
+        }
+
+        /** \brief Get the number of threads used to search the correspondences. */
+        inline unsigned int
+        getNumberOfThreads () const { return (threads_); }
+
         /** \brief Provide a boost shared pointer to the PointRepresentation to be used 
           * when searching for nearest neighbors.
           *
@@ -351,6 +376,41 @@ namespace pcl
          * will never be recomputed*/
         bool force_no_recompute_reciprocal_;
 
+        /** \brief The number of threads used to search the correspondences. */
+        unsigned int threads_;
+
+        /** \brief Per block correspondence buffers of the multi-threaded searches, kept between calls so
+          * that the iterations of a registration do not reallocate them. */
+        std::vector<pcl::Correspondences> thread_correspondences_;
+
+        /** \brief Concatenate the per block correspondence buffers, in order.
+          * \param[out] correspondences the resultant correspondences
+          */
+        void
+        mergeThreadCorrespondences (pcl::Correspondences &correspondences) const;
+
+        /** \brief Determine the correspondences of the source points indices_[begin] to indices_[end - 1].
+          * Called by determineCorrespondencesAll, possibly from several threads at once on disjoint ranges.
+          * \note Subclasses which call determineCorrespondencesAll must override this method. The default
+          * implementation only reports an error and finds no correspondence.
+          * \param[in] begin the position of the first source point in indices_
+          * \param[in] end the position after the last source point in indices_
+          * \param[in] max_dist_sqr the maximum allowed squared distance between correspondences
+          * \param[in] reciprocal if true, only keep the reciprocal correspondences
+          * \param[out] correspondences the correspondences found, appended in the order of indices_
+          */
+        virtual void
+        determineCorrespondencesRange (size_t begin, size_t end, double max_dist_sqr, bool reciprocal,
+                                       pcl::Correspondences &correspondences) const;
+
+        /** \brief Determine the correspondences of all the source points through determineCorrespondencesRange,
+          * splitting them into one block per thread if requested.
+          * \param[out] correspondences the resultant correspondences
+          * \param[in] max_dist_sqr the maximum allowed squared distance between correspondences
+          * \param[in] reciprocal if true, only keep the reciprocal correspondences
+          */
+        void
+        determineCorrespondencesAll (pcl::Correspondences &correspondences, double max_dist_sqr, bool reciprocal);
      };
 
     /** \brief @b CorrespondenceEstimation represents the base class for
@@ -394,6 +454,7 @@ namespace pcl
         using CorrespondenceEstimationBase<PointSource, PointTarget, Scalar>::input_;
         using CorrespondenceEstimationBase<PointSource, PointTarget, Scalar>::indices_;
         using CorrespondenceEstimationBase<PointSource, PointTarget, Scalar>::input_fields_;
+        using CorrespondenceEstimationBase<PointSource, PointTarget, Scalar>::determineCorrespondencesAll;
         using PCLBase<PointSource>::deinitCompute;
 
         typedef pcl::search::KdTree<PointTarget> KdTree;
@@ -445,6 +506,18 @@ namespace pcl
           Ptr copy (new CorrespondenceEstimation<PointSource, PointTarget, Scalar> (*this));
           return (copy);
         }
+
+      protected:
+        /** \brief Determine the correspondences of the source points indices_[begin] to indices_[end - 1].
+          * \param[in] begin the position of the first source point in indices_
+          * \param[in] end the position after the last source point in indices_
+          * \param[in] max_dist_sqr the maximum allowed squared distance between correspondences
+          * \param[in] reciprocal if true, only keep the reciprocal correspondences
+          * \param[out] correspondences the correspondences found, appended in the order of indices_
+          */
+        virtual void
+        determineCorrespondencesRange (size_t begin, size_t end, double max_dist_sqr, bool reciprocal,
+                                       pcl::Correspondences &correspondences) const;
      };
   }
 }
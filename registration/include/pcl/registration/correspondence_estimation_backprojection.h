@@ -184,7 +184,7 @@ namespace pcl
           * cloud for computing correspondences. By default we use k = 10 nearest 
           * neighbors.
           */
-        inline void
+        inline unsigned int
         getKSearch () const { return (k_); }
         
         /** \brief Clone and cast to CorrespondenceEstimationBase */
@@ -201,11 +201,23 @@ namespace pcl
         using CorrespondenceEstimationBase<PointSource, PointTarget, Scalar>::tree_;
         using CorrespondenceEstimationBase<PointSource, PointTarget, Scalar>::tree_reciprocal_;
         using CorrespondenceEstimationBase<PointSource, PointTarget, Scalar>::target_;
+        using CorrespondenceEstimationBase<PointSource, PointTarget, Scalar>::determineCorrespondencesAll;
 
         /** \brief Internal computation initalization. */
         bool
         initCompute ();
 
+        /** \brief Determine the correspondences of the source points indices_[begin] to indices_[end - 1].
+          * \param[in] begin the position of the first source point in indices_
+          * \param[in] end the position after the last source point in indices_
+          * \param[in] max_dist_sqr the maximum allowed squared distance between correspondences
+          * \param[in] reciprocal if true, only keep the reciprocal correspondences
+          * \param[out] correspondences the correspondences found, appended in the order of indices_
+          */
+        virtual void
+        determineCorrespondencesRange (size_t begin, size_t end, double max_dist_sqr, bool reciprocal,
+                                       pcl::Correspondences &correspondences) const;
+
       private:
 
         /** \brief The normals computed at each point in the source cloud */
@@ -124,59 +124,65 @@ pcl::registration::CorrespondenceEstimationBase<PointSource, PointTarget, Scalar
 
 ///////////////////////////////////////////////////////////////////////////////////////////
 template <typename PointSource, typename PointTarget, typename Scalar> void
-pcl::registration::CorrespondenceEstimation<PointSource, PointTarget, Scalar>::determineCorrespondences (
-    pcl::Correspondences &correspondences, double max_distance)
+pcl::registration::CorrespondenceEstimationBase<PointSource, PointTarget, Scalar>::mergeThreadCorrespondences (
+    pcl::Correspondences &correspondences) const
 {
-  if (!initCompute ())
-    return;
+  size_t nr_valid_correspondences = 0;
+  for (size_t b = 0; b < thread_correspondences_.size (); ++b)
+    nr_valid_correspondences += thread_correspondences_[b].size ();
 
-  double max_dist_sqr = max_distance * max_distance;
-
-  correspondences.resize (indices_->size ());
+  correspondences.resize (nr_valid_correspondences);
+  pcl::Correspondences::iterator out = correspondences.begin ();
+  for (size_t b = 0; b < thread_correspondences_.size (); ++b)
+    out = std::copy (thread_correspondences_[b].begin (), thread_correspondences_[b].end (), out);
+}
 
-  std::vector<int> index (1);
-  std::vector<float> distance (1);
-  pcl::Correspondence corr;
-  unsigned int nr_valid_correspondences = 0;
-  
-  // Check if the template types are the same. If true, avoid a copy.
-  // Both point types MUST be registered using the POINT_CLOUD_REGISTER_POINT_STRUCT macro!
-  if (isSamePointType<PointSource, PointTarget> ())
+///////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointSource, typename PointTarget, typename Scalar> void
+pcl::registration::CorrespondenceEstimationBase<PointSource, PointTarget, Scalar>::determineCorrespondencesAll (
+    pcl::Correspondences &correspondences, double max_dist_sqr, bool reciprocal)
+{
+#ifdef _OPENMP
+  if (threads_ > 1 && indices_->size () > threads_)
   {
-    // Iterate over the input set of source indices
-    for (std::vector<int>::const_iterator idx = indices_->begin (); idx != indices_->end (); ++idx)
+    // Each block of source points fills its own buffer, which are then concatenated in order, so the
+    // result does not depend on the number of threads. The buffers keep their capacity between calls.
+    const int nr_blocks = static_cast<int> (threads_);
+    thread_correspondences_.resize (nr_blocks);
+#pragma omp parallel for schedule(static, 1) num_threads(threads_)
+    for (int b = 0; b < nr_blocks; ++b)
     {
-      tree_->nearestKSearch (input_->points[*idx], 1, index, distance);
-      if (distance[0] > max_dist_sqr)
-        continue;
-
-      corr.index_query = *idx;
-      corr.index_match = index[0];
-      corr.distance = distance[0];
-      correspondences[nr_valid_correspondences++] = corr;
+      thread_correspondences_[b].clear ();
+      determineCorrespondencesRange (indices_->size () * b / nr_blocks, indices_->size () * (b + 1) / nr_blocks,
+                                     max_dist_sqr, reciprocal, thread_correspondences_[b]);
     }
+    mergeThreadCorrespondences (correspondences);
+    return;
   }
-  else
-  {
-    PointTarget pt;
-    
-    // Iterate over the input set of source indices
-    for (std::vector<int>::const_iterator idx = indices_->begin (); idx != indices_->end (); ++idx)
-    {
-      // Copy the source data to a target PointTarget format so we can search in the tree
-      copyPoint (input_->points[*idx], pt);
+#endif
 
-      tree_->nearestKSearch (pt, 1, index, distance);
-      if (distance[0] > max_dist_sqr)
-        continue;
+  correspondences.clear ();
+  correspondences.reserve (indices_->size ());
+  determineCorrespondencesRange (0, indices_->size (), max_dist_sqr, reciprocal, correspondences);
+}
 
-      corr.index_query = *idx;
-      corr.index_match = index[0];
-      corr.distance = distance[0];
-      correspondences[nr_valid_correspondences++] = corr;
-    }
-  }
-  correspondences.resize (nr_valid_correspondences);
+///////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointSource, typename PointTarget, typename Scalar> void
+pcl::registration::CorrespondenceEstimationBase<PointSource, PointTarget, Scalar>::determineCorrespondencesRange (
+    size_t, size_t, double, bool, pcl::Correspondences &) const
+{
+  PCL_ERROR ("[pcl::registration::%s::determineCorrespondencesRange] Not implemented for this correspondence estimation.\n", getClassName ().c_str ());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointSource, typename PointTarget, typename Scalar> void
+pcl::registration::CorrespondenceEstimation<PointSource, PointTarget, Scalar>::determineCorrespondences (
+    pcl::Correspondences &correspondences, double max_distance)
+{
+  if (!initCompute ())
+    return;
+
+  determineCorrespondencesAll (correspondences, max_distance * max_distance, false);
   deinitCompute ();
 }
 
@@ -192,72 +198,63 @@ pcl::registration::CorrespondenceEstimation<PointSource, PointTarget, Scalar>::d
   // Set the internal point representation of choice
   if (!initComputeReciprocal())
     return;
-  double max_dist_sqr = max_distance * max_distance;
 
-  correspondences.resize (indices_->size());
+  determineCorrespondencesAll (correspondences, max_distance * max_distance, true);
+  deinitCompute ();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointSource, typename PointTarget, typename Scalar> void
+pcl::registration::CorrespondenceEstimation<PointSource, PointTarget, Scalar>::determineCorrespondencesRange (
+    size_t begin, size_t end, double max_dist_sqr, bool reciprocal, pcl::Correspondences &correspondences) const
+{
   std::vector<int> index (1);
   std::vector<float> distance (1);
   std::vector<int> index_reciprocal (1);
   std::vector<float> distance_reciprocal (1);
   pcl::Correspondence corr;
-  unsigned int nr_valid_correspondences = 0;
-  int target_idx = 0;
 
   // Check if the template types are the same. If true, avoid a copy.
   // Both point types MUST be registered using the POINT_CLOUD_REGISTER_POINT_STRUCT macro!
-  if (isSamePointType<PointSource, PointTarget> ())
-  {
-    // Iterate over the input set of source indices
-    for (std::vector<int>::const_iterator idx = indices_->begin (); idx != indices_->end (); ++idx)
-    {
-      tree_->nearestKSearch (input_->points[*idx], 1, index, distance);
-      if (distance[0] > max_dist_sqr)
-        continue;
+  const bool same_point_type = isSamePointType<PointSource, PointTarget> ();
+  PointTarget pt_src;
+  PointSource pt_tgt;
 
-      target_idx = index[0];
-
-      tree_reciprocal_->nearestKSearch (target_->points[target_idx], 1, index_reciprocal, distance_reciprocal);
-      if (distance_reciprocal[0] > max_dist_sqr || *idx != index_reciprocal[0])
-        continue;
-
-      corr.index_query = *idx;
-      corr.index_match = index[0];
-      corr.distance = distance[0];
-      correspondences[nr_valid_correspondences++] = corr;
-    }
-  }
-  else
+  // Iterate over the input set of source indices
+  for (size_t i = begin; i < end; ++i)
   {
-    PointTarget pt_src;
-    PointSource pt_tgt;
-   
-    // Iterate over the input set of source indices
-    for (std::vector<int>::const_iterator idx = indices_->begin (); idx != indices_->end (); ++idx)
+    const int idx = (*indices_)[i];
+    if (same_point_type)
+      tree_->nearestKSearch (input_->points[idx], 1, index, distance);
+    else
     {
       // Copy the source data to a target PointTarget format so we can search in the tree
-      copyPoint (input_->points[*idx], pt_src);
-
+      copyPoint (input_->points[idx], pt_src);
       tree_->nearestKSearch (pt_src, 1, index, distance);
-      if (distance[0] > max_dist_sqr)
-        continue;
-
-      target_idx = index[0];
-
-      // Copy the target data to a target PointSource format so we can search in the tree_reciprocal
-      copyPoint (target_->points[target_idx], pt_tgt);
+    }
+    if (distance[0] > max_dist_sqr)
+      continue;
 
-      tree_reciprocal_->nearestKSearch (pt_tgt, 1, index_reciprocal, distance_reciprocal);
-      if (distance_reciprocal[0] > max_dist_sqr || *idx != index_reciprocal[0])
+    if (reciprocal)
+    {
+      const int target_idx = index[0];
+      if (same_point_type)
+        tree_reciprocal_->nearestKSearch (target_->points[target_idx], 1, index_reciprocal, distance_reciprocal);
+      else
+      {
+        // Copy the target data to a target PointSource format so we can search in the tree_reciprocal
+        copyPoint (target_->points[target_idx], pt_tgt);
+        tree_reciprocal_->nearestKSearch (pt_tgt, 1, index_reciprocal, distance_reciprocal);
+      }
+      if (distance_reciprocal[0] > max_dist_sqr || idx != index_reciprocal[0])
         continue;
-
-      corr.index_query = *idx;
-      corr.index_match = index[0];
-      corr.distance = distance[0];
-      correspondences[nr_valid_correspondences++] = corr;
     }
+
+    corr.index_query = idx;
+    corr.index_match = index[0];
+    corr.distance = distance[0];
+    correspondences.push_back (corr);
   }
-  correspondences.resize (nr_valid_correspondences);
-  deinitCompute ();
 }
 
 //#define PCL_INSTANTIATE_CorrespondenceEstimation(T,U) template class PCL_EXPORTS pcl::registration::CorrespondenceEstimation<T,U>;
@@ -62,93 +62,8 @@ pcl::registration::CorrespondenceEstimationBackProjection<PointSource, PointTarg
   if (!initCompute ())
     return;
 
-  correspondences.resize (indices_->size ());
-
-  std::vector<int> nn_indices (k_);
-  std::vector<float> nn_dists (k_);
-
-  float min_dist = std::numeric_limits<float>::max ();
-  int min_index = 0;
-  
-  pcl::Correspondence corr;
-  unsigned int nr_valid_correspondences = 0;
-
-  // Check if the template types are the same. If true, avoid a copy.
-  // Both point types MUST be registered using the POINT_CLOUD_REGISTER_POINT_STRUCT macro!
-  if (isSamePointType<PointSource, PointTarget> ())
-  {
-    PointTarget pt;
-    // Iterate over the input set of source indices
-    for (std::vector<int>::const_iterator idx_i = indices_->begin (); idx_i != indices_->end (); ++idx_i)
-    {
-      tree_->nearestKSearch (input_->points[*idx_i], k_, nn_indices, nn_dists);
-
-      // Among the K nearest neighbours find the one with minimum perpendicular distance to the normal
-      min_dist = std::numeric_limits<float>::max ();
-      
-      // Find the best correspondence
-      for (size_t j = 0; j < nn_indices.size (); j++)
-      {
-        float cos_angle = source_normals_->points[*idx_i].normal_x * target_normals_->points[nn_indices[j]].normal_x +
-                          source_normals_->points[*idx_i].normal_y * target_normals_->points[nn_indices[j]].normal_y +
-                          source_normals_->points[*idx_i].normal_z * target_normals_->points[nn_indices[j]].normal_z ;
-        float dist = nn_dists[j] * (2.0f - cos_angle * cos_angle);
-        
-        if (dist < min_dist)
-        {
-          min_dist = dist;
-          min_index = static_cast<int> (j);
-        }
-      }
-      if (min_dist > max_distance)
-        continue;
-
-      corr.index_query = *idx_i;
-      corr.index_match = nn_indices[min_index];
-      corr.distance = nn_dists[min_index];//min_dist;
-      correspondences[nr_valid_correspondences++] = corr;
-    }
-  }
-  else
-  {
-    PointTarget pt;
-    
-    // Iterate over the input set of source indices
-    for (std::vector<int>::const_iterator idx_i = indices_->begin (); idx_i != indices_->end (); ++idx_i)
-    {
-      tree_->nearestKSearch (input_->points[*idx_i], k_, nn_indices, nn_dists);
- 
-      // Among the K nearest neighbours find the one with minimum perpendicular distance to the normal
-      min_dist = std::numeric_limits<float>::max ();
-      
-      // Find the best correspondence
-      for (size_t j = 0; j < nn_indices.size (); j++)
-      {
-        PointSource pt_src;
-        // Copy the source data to a target PointTarget format so we can search in the tree
-        copyPoint (input_->points[*idx_i], pt_src);
-
-        float cos_angle = source_normals_->points[*idx_i].normal_x * target_normals_->points[nn_indices[j]].normal_x +
-                          source_normals_->points[*idx_i].normal_y * target_normals_->points[nn_indices[j]].normal_y +
-                          source_normals_->points[*idx_i].normal_z * target_normals_->points[nn_indices[j]].normal_z ;
-        float dist = nn_dists[j] * (2.0f - cos_angle * cos_angle);
-        
-        if (dist < min_dist)
-        {
-          min_dist = dist;
-          min_index = static_cast<int> (j);
-        }
-      }
-      if (min_dist > max_distance)
-        continue;
-      
-      corr.index_query = *idx_i;
-      corr.index_match = nn_indices[min_index];
-      corr.distance = nn_dists[min_index];//min_dist;
-      correspondences[nr_valid_correspondences++] = corr;
-    }
-  }
-  correspondences.resize (nr_valid_correspondences);
+  // As before, the squared distances are compared to max_distance itself
+  determineCorrespondencesAll (correspondences, max_distance, false);
   deinitCompute ();
 }
 
@@ -160,115 +75,65 @@ pcl::registration::CorrespondenceEstimationBackProjection<PointSource, PointTarg
   if (!initCompute ())
     return;
 
-  // Set the internal point representation of choice
-  if(!initComputeReciprocal())
+  if (!initComputeReciprocal ())
     return;
 
-  correspondences.resize (indices_->size ());
+  // As before, the squared distances are compared to max_distance itself
+  determineCorrespondencesAll (correspondences, max_distance, true);
+  deinitCompute ();
+}
 
+///////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointSource, typename PointTarget, typename NormalT, typename Scalar> void
+pcl::registration::CorrespondenceEstimationBackProjection<PointSource, PointTarget, NormalT, Scalar>::determineCorrespondencesRange (
+    size_t begin, size_t end, double max_dist_sqr, bool reciprocal, pcl::Correspondences &correspondences) const
+{
   std::vector<int> nn_indices (k_);
   std::vector<float> nn_dists (k_);
   std::vector<int> index_reciprocal (1);
   std::vector<float> distance_reciprocal (1);
-
-  float min_dist = std::numeric_limits<float>::max ();
-  int min_index = 0;
-  
   pcl::Correspondence corr;
-  unsigned int nr_valid_correspondences = 0;
-  int target_idx = 0;
 
-  // Check if the template types are the same. If true, avoid a copy.
-  // Both point types MUST be registered using the POINT_CLOUD_REGISTER_POINT_STRUCT macro!
-  if (isSamePointType<PointSource, PointTarget> ())
+  // Iterate over the input set of source indices
+  for (size_t i = begin; i < end; ++i)
   {
-    PointTarget pt;
-    // Iterate over the input set of source indices
-    for (std::vector<int>::const_iterator idx_i = indices_->begin (); idx_i != indices_->end (); ++idx_i)
+    const int idx = (*indices_)[i];
+    tree_->nearestKSearch (input_->points[idx], k_, nn_indices, nn_dists);
+
+    // Among the K nearest neighbours find the one with minimum perpendicular distance to the normal
+    float min_dist = std::numeric_limits<float>::max ();
+    int min_index = 0;
+
+    // Find the best correspondence
+    for (size_t j = 0; j < nn_indices.size (); j++)
     {
-      tree_->nearestKSearch (input_->points[*idx_i], k_, nn_indices, nn_dists);
+      float cos_angle = source_normals_->points[idx].normal_x * target_normals_->points[nn_indices[j]].normal_x +
+                        source_normals_->points[idx].normal_y * target_normals_->points[nn_indices[j]].normal_y +
+                        source_normals_->points[idx].normal_z * target_normals_->points[nn_indices[j]].normal_z ;
+      float dist = nn_dists[j] * (2.0f - cos_angle * cos_angle);
 
-      // Among the K nearest neighbours find the one with minimum perpendicular distance to the normal
-      min_dist = std::numeric_limits<float>::max ();
-      
-      // Find the best correspondence
-      for (size_t j = 0; j < nn_indices.size (); j++)
+      if (dist < min_dist)
       {
-        float cos_angle = source_normals_->points[*idx_i].normal_x * target_normals_->points[nn_indices[j]].normal_x +
-                          source_normals_->points[*idx_i].normal_y * target_normals_->points[nn_indices[j]].normal_y +
-                          source_normals_->points[*idx_i].normal_z * target_normals_->points[nn_indices[j]].normal_z ;
-        float dist = nn_dists[j] * (2.0f - cos_angle * cos_angle);
-        
-        if (dist < min_dist)
-        {
-          min_dist = dist;
-          min_index = static_cast<int> (j);
-        }
+        min_dist = dist;
+        min_index = static_cast<int> (j);
       }
-      if (min_dist > max_distance)
-        continue;
-
-      // Check if the correspondence is reciprocal
-      target_idx = nn_indices[min_index];
-      tree_reciprocal_->nearestKSearch (target_->points[target_idx], 1, index_reciprocal, distance_reciprocal);
-
-      if (*idx_i != index_reciprocal[0])
-        continue;
-
-      corr.index_query = *idx_i;
-      corr.index_match = nn_indices[min_index];
-      corr.distance = nn_dists[min_index];//min_dist;
-      correspondences[nr_valid_correspondences++] = corr;
     }
-  }
-  else
-  {
-    PointTarget pt;
-    
-    // Iterate over the input set of source indices
-    for (std::vector<int>::const_iterator idx_i = indices_->begin (); idx_i != indices_->end (); ++idx_i)
-    {
-      tree_->nearestKSearch (input_->points[*idx_i], k_, nn_indices, nn_dists);
- 
-      // Among the K nearest neighbours find the one with minimum perpendicular distance to the normal
-      min_dist = std::numeric_limits<float>::max ();
-      
-      // Find the best correspondence
-      for (size_t j = 0; j < nn_indices.size (); j++)
-      {
-        PointSource pt_src;
-        // Copy the source data to a target PointTarget format so we can search in the tree
-        copyPoint (input_->points[*idx_i], pt_src);
+    if (min_dist > max_dist_sqr)
+      continue;
 
-        float cos_angle = source_normals_->points[*idx_i].normal_x * target_normals_->points[nn_indices[j]].normal_x +
-                          source_normals_->points[*idx_i].normal_y * target_normals_->points[nn_indices[j]].normal_y +
-                          source_normals_->points[*idx_i].normal_z * target_normals_->points[nn_indices[j]].normal_z ;
-        float dist = nn_dists[j] * (2.0f - cos_angle * cos_angle);
-        
-        if (dist < min_dist)
-        {
-          min_dist = dist;
-          min_index = static_cast<int> (j);
-        }
-      }
-      if (min_dist > max_distance)
-        continue;
-      
+    if (reciprocal)
+    {
       // Check if the correspondence is reciprocal
-      target_idx = nn_indices[min_index];
-      tree_reciprocal_->nearestKSearch (target_->points[target_idx], 1, index_reciprocal, distance_reciprocal);
-
-      if (*idx_i != index_reciprocal[0])
+      tree_reciprocal_->nearestKSearch (target_->points[nn_indices[min_index]], 1, index_reciprocal, distance_reciprocal);
+      if (idx != index_reciprocal[0])
         continue;
-
-      corr.index_query = *idx_i;
-      corr.index_match = nn_indices[min_index];
-      corr.distance = nn_dists[min_index];//min_dist;
-      correspondences[nr_valid_correspondences++] = corr;
     }
+
+    corr.index_query = idx;
+    corr.index_match = nn_indices[min_index];
+    corr.distance = nn_dists[min_index];//min_dist;
+    correspondences.push_back (corr);
   }
-  correspondences.resize (nr_valid_correspondences);
-  deinitCompute ();
 }
 
 #endif    // PCL_REGISTRATION_IMPL_CORRESPONDENCE_ESTIMATION_BACK_PROJECTION_HPP_
@@ -46,6 +46,7 @@ template<typename PointSource, typename PointTarget>
 pcl::NormalDistributionsTransform<PointSource, PointTarget>::NormalDistributionsTransform () 
   : target_cells_ ()
   , resolution_ (1.0f)
+  , search_method_ (KDTREE)
   , step_size_ (0.1)
   , outlier_ratio_ (0.55)
   , gauss_d1_ ()
@@ -178,6 +179,66 @@ pcl::NormalDistributionsTransform<PointSource, PointTarget>::computeDerivatives
                                                                                  PointCloudSource &trans_cloud,
                                                                                  Eigen::Matrix<double, 6, 1> &p,
                                                                                  bool compute_hessian)
+{
+  // Precompute Angular Derivatives (eq. 6.19 and 6.21)[Magnusson 2009]
+  computeAngleDerivatives (p);
+
+  // Update gradient and hessian for each point, line 17 in Algorithm 2 [Magnusson 2009]
+  return (accumulateDerivatives (trans_cloud, score_gradient, hessian, compute_hessian));
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename PointSource, typename PointTarget> double
+pcl::NormalDistributionsTransform<PointSource, PointTarget>::accumulateDerivatives (const PointCloudSource &trans_cloud,
+                                                                                    Eigen::Matrix<double, 6, 1> &score_gradient,
+                                                                                    Eigen::Matrix<double, 6, 6> &hessian,
+                                                                                    bool compute_hessian) const
+{
+  score_gradient.setZero ();
+  hessian.setZero ();
+  double score = 0;
+
+#ifdef _OPENMP
+  if (threads_ > 1)
+  {
+    // Accumulate each block of points separately, then sum the blocks in order
+    const int nr_blocks = static_cast<int> (threads_);
+    const size_t nr_points = input_->points.size ();
+    const size_t block_size = (nr_points + nr_blocks - 1) / nr_blocks;
+    std::vector<double> block_scores (nr_blocks, 0);
+    std::vector<Eigen::Matrix<double, 6, 1>, Eigen::aligned_allocator<Eigen::Matrix<double, 6, 1> > > block_gradients (nr_blocks, Eigen::Matrix<double, 6, 1>::Zero ());
+    std::vector<Eigen::Matrix<double, 6, 6>, Eigen::aligned_allocator<Eigen::Matrix<double, 6, 6> > > block_hessians (nr_blocks, Eigen::Matrix<double, 6, 6>::Zero ());
+
+#pragma omp parallel for schedule(static, 1) num_threads(threads_)
+    for (int block = 0; block < nr_blocks; ++block)
+    {
+      const size_t begin = (std::min) (block * block_size, nr_points);
+      const size_t end = (std::min) (begin + block_size, nr_points);
+      block_scores[block] = computeDerivativesRange (begin, end, trans_cloud, block_gradients[block], block_hessians[block], compute_hessian);
+    }
+
+    for (int block = 0; block < nr_blocks; ++block)
+    {
+      score += block_scores[block];
+      score_gradient += block_gradients[block];
+      if (compute_hessian)
+        hessian += block_hessians[block];
+    }
+    return (score);
+  }
+#endif
+
+  score = computeDerivativesRange (0, input_->points.size (), trans_cloud, score_gradient, hessian, compute_hessian);
+  return (score);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename PointSource, typename PointTarget> double
+pcl::NormalDistributionsTransform<PointSource, PointTarget>::computeDerivativesRange (size_t begin, size_t end,
+                                                                                      const PointCloudSource &trans_cloud,
+                                                                                      Eigen::Matrix<double, 6, 1> &score_gradient,
+                                                                                      Eigen::Matrix<double, 6, 6> &hessian,
+                                                                                      bool compute_hessian) const
 {
   // Original Point and Transformed Point
   PointSource x_pt, x_trans_pt;
@@ -187,25 +248,24 @@ pcl::NormalDistributionsTransform<PointSource, PointTarget>::computeDerivatives
   TargetGridLeafConstPtr cell;
   // Inverse Covariance of Occupied Voxel
   Eigen::Matrix3d c_inv;
-
-  score_gradient.setZero ();
-  hessian.setZero ();
+  // Point Gradient and Hessian, kept local so that ranges can be processed concurrently
+  Eigen::Matrix<double, 3, 6> point_gradient;
+  Eigen::Matrix<double, 18, 6> point_hessian;
+  point_gradient.setZero ();
+  point_gradient.block<3, 3>(0, 0).setIdentity ();
+  point_hessian.setZero ();
+
+  std::vector<TargetGridLeafConstPtr> neighborhood;
   double score = 0;
 
-  // Precompute Angular Derivatives (eq. 6.19 and 6.21)[Magnusson 2009]
-  computeAngleDerivatives (p);
-
-  // Update gradient and hessian for each point, line 17 in Algorithm 2 [Magnusson 2009]
-  for (size_t idx = 0; idx < input_->points.size (); idx++)
+  for (size_t idx = begin; idx < end; idx++)
   {
     x_trans_pt = trans_cloud.points[idx];
 
-    // Find nieghbors (Radius search has been experimentally faster than direct neighbor checking.
-    std::vector<TargetGridLeafConstPtr> neighborhood;
-    std::vector<float> distances;
-    target_cells_.radiusSearch (x_trans_pt, resolution_, neighborhood, distances);
+    // Find nieghbors
+    findNeighborhood (x_trans_pt, neighborhood);
 
-    for (typename std::vector<TargetGridLeafConstPtr>::iterator neighborhood_it = neighborhood.begin (); neighborhood_it != neighborhood.end (); neighborhood_it++)
+    for (typename std::vector<TargetGridLeafConstPtr>::const_iterator neighborhood_it = neighborhood.begin (); neighborhood_it != neighborhood.end (); neighborhood_it++)
     {
       cell = *neighborhood_it;
       x_pt = input_->points[idx];
@@ -219,15 +279,41 @@ pcl::NormalDistributionsTransform<PointSource, PointTarget>::computeDerivatives
       c_inv = cell->getInverseCov ();
 
       // Compute derivative of transform function w.r.t. transform vector, J_E and H_E in Equations 6.18 and 6.20 [Magnusson 2009]
-      computePointDerivatives (x);
+      computePointDerivatives (x, point_gradient, point_hessian, compute_hessian);
       // Update score, gradient and hessian, lines 19-21 in Algorithm 2, according to Equations 6.10, 6.12 and 6.13, respectively [Magnusson 2009]
-      score += updateDerivatives (score_gradient, hessian, x_trans, c_inv, compute_hessian);
-
+      score += updateDerivatives (score_gradient, hessian, point_gradient, point_hessian, x_trans, c_inv, compute_hessian);
     }
   }
   return (score);
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename PointSource, typename PointTarget> void
+pcl::NormalDistributionsTransform<PointSource, PointTarget>::findNeighborhood (const PointSource &x_trans_pt,
+                                                                               std::vector<TargetGridLeafConstPtr> &neighborhood) const
+{
+  switch (search_method_)
+  {
+    case DIRECT1:
+      target_cells_.getVoxelAtPoint (x_trans_pt, neighborhood);
+      break;
+    case DIRECT7:
+      target_cells_.getFaceNeighborsAtPoint (x_trans_pt, neighborhood);
+      break;
+    case DIRECT26:
+      target_cells_.getAllNeighborsAtPoint (x_trans_pt, neighborhood);
+      break;
+    case KDTREE:
+    default:
+    {
+      // Radius search has been experimentally faster than direct neighbor checking of all 26 neighbors
+      std::vector<float> distances;
+      target_cells_.radiusSearch (x_trans_pt, resolution_, neighborhood, distances);
+      break;
+    }
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 template<typename PointSource, typename PointTarget> void
 pcl::NormalDistributionsTransform<PointSource, PointTarget>::computeAngleDerivatives (Eigen::Matrix<double, 6, 1> &p, bool compute_hessian)
@@ -308,17 +394,27 @@ pcl::NormalDistributionsTransform<PointSource, PointTarget>::computeAngleDerivat
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 template<typename PointSource, typename PointTarget> void
 pcl::NormalDistributionsTransform<PointSource, PointTarget>::computePointDerivatives (Eigen::Vector3d &x, bool compute_hessian)
+{
+  computePointDerivatives (x, point_gradient_, point_hessian_, compute_hessian);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename PointSource, typename PointTarget> void
+pcl::NormalDistributionsTransform<PointSource, PointTarget>::computePointDerivatives (const Eigen::Vector3d &x,
+                                                                                      Eigen::Matrix<double, 3, 6> &point_gradient,
+                                                                                      Eigen::Matrix<double, 18, 6> &point_hessian,
+                                                                                      bool compute_hessian) const
 {
   // Calculate first derivative of Transformation Equation 6.17 w.r.t. transform vector p.
   // Derivative w.r.t. ith element of transform vector corresponds to column i, Equation 6.18 and 6.19 [Magnusson 2009]
-  point_gradient_ (1, 3) = x.dot (j_ang_a_);
-  point_gradient_ (2, 3) = x.dot (j_ang_b_);
-  point_gradient_ (0, 4) = x.dot (j_ang_c_);
-  point_gradient_ (1, 4) = x.dot (j_ang_d_);
-  point_gradient_ (2, 4) = x.dot (j_ang_e_);
-  point_gradient_ (0, 5) = x.dot (j_ang_f_);
-  point_gradient_ (1, 5) = x.dot (j_ang_g_);
-  point_gradient_ (2, 5) = x.dot (j_ang_h_);
+  point_gradient (1, 3) = x.dot (j_ang_a_);
+  point_gradient (2, 3) = x.dot (j_ang_b_);
+  point_gradient (0, 4) = x.dot (j_ang_c_);
+  point_gradient (1, 4) = x.dot (j_ang_d_);
+  point_gradient (2, 4) = x.dot (j_ang_e_);
+  point_gradient (0, 5) = x.dot (j_ang_f_);
+  point_gradient (1, 5) = x.dot (j_ang_g_);
+  point_gradient (2, 5) = x.dot (j_ang_h_);
 
   if (compute_hessian)
   {
@@ -334,15 +430,15 @@ pcl::NormalDistributionsTransform<PointSource, PointTarget>::computePointDerivat
 
     // Calculate second derivative of Transformation Equation 6.17 w.r.t. transform vector p.
     // Derivative w.r.t. ith and jth elements of transform vector corresponds to the 3x1 block matrix starting at (3i,j), Equation 6.20 and 6.21 [Magnusson 2009]
-    point_hessian_.block<3, 1>(9, 3) = a;
-    point_hessian_.block<3, 1>(12, 3) = b;
-    point_hessian_.block<3, 1>(15, 3) = c;
-    point_hessian_.block<3, 1>(9, 4) = b;
-    point_hessian_.block<3, 1>(12, 4) = d;
-    point_hessian_.block<3, 1>(15, 4) = e;
-    point_hessian_.block<3, 1>(9, 5) = c;
-    point_hessian_.block<3, 1>(12, 5) = e;
-    point_hessian_.block<3, 1>(15, 5) = f;
+    point_hessian.block<3, 1>(9, 3) = a;
+    point_hessian.block<3, 1>(12, 3) = b;
+    point_hessian.block<3, 1>(15, 3) = c;
+    point_hessian.block<3, 1>(9, 4) = b;
+    point_hessian.block<3, 1>(12, 4) = d;
+    point_hessian.block<3, 1>(15, 4) = e;
+    point_hessian.block<3, 1>(9, 5) = c;
+    point_hessian.block<3, 1>(12, 5) = e;
+    point_hessian.block<3, 1>(15, 5) = f;
   }
 }
 
@@ -352,6 +448,18 @@ pcl::NormalDistributionsTransform<PointSource, PointTarget>::updateDerivatives (
                                                                                 Eigen::Matrix<double, 6, 6> &hessian,
                                                                                 Eigen::Vector3d &x_trans, Eigen::Matrix3d &c_inv,
                                                                                 bool compute_hessian)
+{
+  return (updateDerivatives (score_gradient, hessian, point_gradient_, point_hessian_, x_trans, c_inv, compute_hessian));
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename PointSource, typename PointTarget> double
+pcl::NormalDistributionsTransform<PointSource, PointTarget>::updateDerivatives (Eigen::Matrix<double, 6, 1> &score_gradient,
+                                                                                Eigen::Matrix<double, 6, 6> &hessian,
+                                                                                const Eigen::Matrix<double, 3, 6> &point_gradient,
+                                                                                const Eigen::Matrix<double, 18, 6> &point_hessian,
+                                                                                const Eigen::Vector3d &x_trans, const Eigen::Matrix3d &c_inv,
+                                                                                bool compute_hessian) const
 {
   Eigen::Vector3d cov_dxd_pi;
   // e^(-d_2/2 * (x_k - mu_k)^T Sigma_k^-1 (x_k - mu_k)) Equation 6.9 [Magnusson 2009]
@@ -372,7 +480,7 @@ pcl::NormalDistributionsTransform<PointSource, PointTarget>::updateDerivatives (
   for (int i = 0; i < 6; i++)
   {
     // Sigma_k^-1 d(T(x,p))/dpi, Reusable portion of Equation 6.12 and 6.13 [Magnusson 2009]
-    cov_dxd_pi = c_inv * point_gradient_.col (i);
+    cov_dxd_pi = c_inv * point_gradient.col (i);
 
     // Update gradient, Equation 6.12 [Magnusson 2009]
     score_gradient (i) += x_trans.dot (cov_dxd_pi) * e_x_cov_x;
@@ -382,9 +490,9 @@ pcl::NormalDistributionsTransform<PointSource, PointTarget>::updateDerivatives (
       for (int j = 0; j < hessian.cols (); j++)
       {
         // Update hessian, Equation 6.13 [Magnusson 2009]
-        hessian (i, j) += e_x_cov_x * (-gauss_d2_ * x_trans.dot (cov_dxd_pi) * x_trans.dot (c_inv * point_gradient_.col (j)) +
-                                    x_trans.dot (c_inv * point_hessian_.block<3, 1>(3 * i, j)) +
-                                    point_gradient_.col (j).dot (cov_dxd_pi) );
+        hessian (i, j) += e_x_cov_x * (-gauss_d2_ * x_trans.dot (cov_dxd_pi) * x_trans.dot (c_inv * point_gradient.col (j)) +
+                                    x_trans.dot (c_inv * point_hessian.block<3, 1>(3 * i, j)) +
+                                    point_gradient.col (j).dot (cov_dxd_pi) );
       }
     }
   }
@@ -397,56 +505,26 @@ template<typename PointSource, typename PointTarget> void
 pcl::NormalDistributionsTransform<PointSource, PointTarget>::computeHessian (Eigen::Matrix<double, 6, 6> &hessian,
                                                                              PointCloudSource &trans_cloud, Eigen::Matrix<double, 6, 1> &)
 {
-  // Original Point and Transformed Point
-  PointSource x_pt, x_trans_pt;
-  // Original Point and Transformed Point (for math)
-  Eigen::Vector3d x, x_trans;
-  // Occupied Voxel
-  TargetGridLeafConstPtr cell;
-  // Inverse Covariance of Occupied Voxel
-  Eigen::Matrix3d c_inv;
-
-  hessian.setZero ();
-
   // Precompute Angular Derivatives unessisary because only used after regular derivative calculation
 
   // Update hessian for each point, line 17 in Algorithm 2 [Magnusson 2009]
-  for (size_t idx = 0; idx < input_->points.size (); idx++)
-  {
-    x_trans_pt = trans_cloud.points[idx];
-
-    // Find nieghbors (Radius search has been experimentally faster than direct neighbor checking.
-    std::vector<TargetGridLeafConstPtr> neighborhood;
-    std::vector<float> distances;
-    target_cells_.radiusSearch (x_trans_pt, resolution_, neighborhood, distances);
-
-    for (typename std::vector<TargetGridLeafConstPtr>::iterator neighborhood_it = neighborhood.begin (); neighborhood_it != neighborhood.end (); neighborhood_it++)
-    {
-      cell = *neighborhood_it;
-
-      {
-        x_pt = input_->points[idx];
-        x = Eigen::Vector3d (x_pt.x, x_pt.y, x_pt.z);
-
-        x_trans = Eigen::Vector3d (x_trans_pt.x, x_trans_pt.y, x_trans_pt.z);
-
-        // Denorm point, x_k' in Equations 6.12 and 6.13 [Magnusson 2009]
-        x_trans -= cell->getMean ();
-        // Uses precomputed covariance for speed.
-        c_inv = cell->getInverseCov ();
-
-        // Compute derivative of transform function w.r.t. transform vector, J_E and H_E in Equations 6.18 and 6.20 [Magnusson 2009]
-        computePointDerivatives (x);
-        // Update hessian, lines 21 in Algorithm 2, according to Equations 6.10, 6.12 and 6.13, respectively [Magnusson 2009]
-        updateHessian (hessian, x_trans, c_inv);
-      }
-    }
-  }
+  Eigen::Matrix<double, 6, 1> score_gradient;
+  accumulateDerivatives (trans_cloud, score_gradient, hessian, true);
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 template<typename PointSource, typename PointTarget> void
 pcl::NormalDistributionsTransform<PointSource, PointTarget>::updateHessian (Eigen::Matrix<double, 6, 6> &hessian, Eigen::Vector3d &x_trans, Eigen::Matrix3d &c_inv)
+{
+  updateHessian (hessian, point_gradient_, point_hessian_, x_trans, c_inv);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename PointSource, typename PointTarget> void
+pcl::NormalDistributionsTransform<PointSource, PointTarget>::updateHessian (Eigen::Matrix<double, 6, 6> &hessian,
+                                                                            const Eigen::Matrix<double, 3, 6> &point_gradient,
+                                                                            const Eigen::Matrix<double, 18, 6> &point_hessian,
+                                                                            const Eigen::Vector3d &x_trans, const Eigen::Matrix3d &c_inv) const
 {
   Eigen::Vector3d cov_dxd_pi;
   // e^(-d_2/2 * (x_k - mu_k)^T Sigma_k^-1 (x_k - mu_k)) Equation 6.9 [Magnusson 2009]
@@ -462,14 +540,14 @@ pcl::NormalDistributionsTransform<PointSource, PointTarget>::updateHessian (Eige
   for (int i = 0; i < 6; i++)
   {
     // Sigma_k^-1 d(T(x,p))/dpi, Reusable portion of Equation 6.12 and 6.13 [Magnusson 2009]
-    cov_dxd_pi = c_inv * point_gradient_.col (i);
+    cov_dxd_pi = c_inv * point_gradient.col (i);
 
     for (int j = 0; j < hessian.cols (); j++)
     {
       // Update hessian, Equation 6.13 [Magnusson 2009]
-      hessian (i, j) += e_x_cov_x * (-gauss_d2_ * x_trans.dot (cov_dxd_pi) * x_trans.dot (c_inv * point_gradient_.col (j)) +
-                                  x_trans.dot (c_inv * point_hessian_.block<3, 1>(3 * i, j)) +
-                                  point_gradient_.col (j).dot (cov_dxd_pi) );
+      hessian (i, j) += e_x_cov_x * (-gauss_d2_ * x_trans.dot (cov_dxd_pi) * x_trans.dot (c_inv * point_gradient.col (j)) +
+                                  x_trans.dot (c_inv * point_hessian.block<3, 1>(3 * i, j)) +
+                                  point_gradient.col (j).dot (cov_dxd_pi) );
     }
   }
 
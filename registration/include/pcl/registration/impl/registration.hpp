@@ -89,6 +89,8 @@ pcl::Registration<PointSource, PointTarget, Scalar>::initCompute ()
   {
     correspondence_estimation_->setSearchMethodTarget (tree_, force_no_recompute_);
     correspondence_estimation_->setSearchMethodSource (tree_reciprocal_, force_no_recompute_reciprocal_);
+    if (threads_set_)
+      correspondence_estimation_->setNumberOfThreads (threads_);
   }
   
   // Note: we /cannot/ update the search method on all correspondence rejectors, because we know 
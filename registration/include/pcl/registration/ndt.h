@@ -90,6 +90,18 @@ namespace pcl
       typedef boost::shared_ptr< NormalDistributionsTransform<PointSource, PointTarget> > Ptr;
       typedef boost::shared_ptr< const NormalDistributionsTransform<PointSource, PointTarget> > ConstPtr;
 
+      /** \brief The methods used to find the occupied voxels near a transformed source point.
+        * KDTREE searches the voxel centroids within \ref resolution_ of the point, the DIRECT methods look
+        * up the voxel containing the point (DIRECT1), together with its 6 face neighbors (DIRECT7) or
+        * with all of its 26 neighbors (DIRECT26) directly in the voxel grid.
+        */
+      enum NeighborSearchMethod
+      {
+        KDTREE,
+        DIRECT26,
+        DIRECT7,
+        DIRECT1
+      };
 
       /** \brief Constructor.
         * Sets \ref outlier_ratio_ to 0.35, \ref step_size_ to 0.05 and \ref resolution_ to 1.0
@@ -169,6 +181,23 @@ namespace pcl
         outlier_ratio_ = outlier_ratio;
       }
 
+      /** \brief Set the method used to find the occupied voxels near each transformed source point.
+        * \note The direct lookups trade some accuracy near the voxel borders for a much cheaper search.
+        * \param[in] method the neighbor search method (KDTREE by default)
+        */
+      inline void
+      setNeighborhoodSearchMethod (NeighborSearchMethod method)
+      {
+        search_method_ = method;
+      }
+
+      /** \brief Get the method used to find the occupied voxels near each transformed source point. */
+      inline NeighborSearchMethod
+      getNeighborhoodSearchMethod () const
+      {
+        return (search_method_);
+      }
+
       /** \brief Get the registration alignment probability.
         * \return transformation probability
         */
@@ -229,6 +258,8 @@ namespace pcl
       using Registration<PointSource, PointTarget>::corr_dist_threshold_;
       using Registration<PointSource, PointTarget>::inlier_threshold_;
 
+      using Registration<PointSource, PointTarget>::threads_;
+
       using Registration<PointSource, PointTarget>::update_visualizer_;
 
       /** \brief Estimate the transformation and returns the transformed source (input) as output.
@@ -272,6 +303,45 @@ namespace pcl
                           Eigen::Matrix<double, 6, 1> &p,
                           bool compute_hessian = true);
 
+      /** \brief Accumulate the score, gradient and (optionally) hessian of all the points of the transformed cloud.
+        * \note The points are split in \ref threads_ contiguous blocks which are accumulated in parallel and summed
+        * in block order, so the result does not depend on the thread scheduling.
+        * \param[in] trans_cloud transformed point cloud
+        * \param[out] score_gradient the gradient vector of the probability function w.r.t. the transformation vector
+        * \param[out] hessian the hessian matrix of the probability function w.r.t. the transformation vector
+        * \param[in] compute_hessian flag to calculate hessian, unnessissary for step calculation.
+        * \return the score of the transformed cloud
+        */
+      double
+      accumulateDerivatives (const PointCloudSource &trans_cloud,
+                             Eigen::Matrix<double, 6, 1> &score_gradient,
+                             Eigen::Matrix<double, 6, 6> &hessian,
+                             bool compute_hessian) const;
+
+      /** \brief Accumulate the contributions of the points [begin, end) to the derivatives of probability function w.r.t. the transformation vector.
+        * \note Only reads the members of the class, so disjoint ranges can be processed in parallel.
+        * \param[in] begin the index of the first point
+        * \param[in] end the index after the last point
+        * \param[in] trans_cloud transformed point cloud
+        * \param[in,out] score_gradient the gradient vector of the probability function w.r.t. the transformation vector
+        * \param[in,out] hessian the hessian matrix of the probability function w.r.t. the transformation vector
+        * \param[in] compute_hessian flag to calculate hessian, unnessissary for step calculation.
+        * \return the score of the points
+        */
+      double
+      computeDerivativesRange (size_t begin, size_t end,
+                               const PointCloudSource &trans_cloud,
+                               Eigen::Matrix<double, 6, 1> &score_gradient,
+                               Eigen::Matrix<double, 6, 6> &hessian,
+                               bool compute_hessian) const;
+
+      /** \brief Find the occupied voxels near a transformed point, using \ref search_method_.
+        * \param[in] x_trans_pt the transformed point
+        * \param[out] neighborhood the occupied voxels near the point
+        */
+      void
+      findNeighborhood (const PointSource &x_trans_pt, std::vector<TargetGridLeafConstPtr> &neighborhood) const;
+
       /** \brief Compute individual point contirbutions to derivatives of probability function w.r.t. the transformation vector.
         * \note Equation 6.10, 6.12 and 6.13 [Magnusson 2009].
         * \param[in,out] score_gradient the gradient vector of the probability function w.r.t. the transformation vector
@@ -286,6 +356,24 @@ namespace pcl
                          Eigen::Vector3d &x_trans, Eigen::Matrix3d &c_inv,
                          bool compute_hessian = true);
 
+      /** \brief Compute individual point contirbutions to derivatives of probability function w.r.t. the transformation vector.
+        * \note Equation 6.10, 6.12 and 6.13 [Magnusson 2009].
+        * \param[in,out] score_gradient the gradient vector of the probability function w.r.t. the transformation vector
+        * \param[in,out] hessian the hessian matrix of the probability function w.r.t. the transformation vector
+        * \param[in] point_gradient the first order derivative of the transformation of the point, see \ref point_gradient_
+        * \param[in] point_hessian the second order derivative of the transformation of the point, see \ref point_hessian_
+        * \param[in] x_trans transformed point minus mean of occupied covariance voxel
+        * \param[in] c_inv covariance of occupied covariance voxel
+        * \param[in] compute_hessian flag to calculate hessian, unnessissary for step calculation.
+        */
+      double
+      updateDerivatives (Eigen::Matrix<double, 6, 1> &score_gradient,
+                         Eigen::Matrix<double, 6, 6> &hessian,
+                         const Eigen::Matrix<double, 3, 6> &point_gradient,
+                         const Eigen::Matrix<double, 18, 6> &point_hessian,
+                         const Eigen::Vector3d &x_trans, const Eigen::Matrix3d &c_inv,
+                         bool compute_hessian = true) const;
+
       /** \brief Precompute anglular components of derivatives.
         * \note Equation 6.19 and 6.21 [Magnusson 2009].
         * \param[in] p the current transform vector
@@ -302,6 +390,19 @@ namespace pcl
       void
       computePointDerivatives (Eigen::Vector3d &x, bool compute_hessian = true);
 
+      /** \brief Compute point derivatives.
+        * \note Equation 6.18-21 [Magnusson 2009].
+        * \param[in] x point from the input cloud
+        * \param[in,out] point_gradient the first order derivative of the transformation of the point, see \ref point_gradient_
+        * \param[in,out] point_hessian the second order derivative of the transformation of the point, see \ref point_hessian_
+        * \param[in] compute_hessian flag to calculate hessian, unnessissary for step calculation.
+        */
+      void
+      computePointDerivatives (const Eigen::Vector3d &x,
+                               Eigen::Matrix<double, 3, 6> &point_gradient,
+                               Eigen::Matrix<double, 18, 6> &point_hessian,
+                               bool compute_hessian = true) const;
+
       /** \brief Compute hessian of probability function w.r.t. the transformation vector.
         * \note Equation 6.13 [Magnusson 2009].
         * \param[out] hessian the hessian matrix of the probability function w.r.t. the transformation vector
@@ -323,6 +424,20 @@ namespace pcl
       updateHessian (Eigen::Matrix<double, 6, 6> &hessian,
                      Eigen::Vector3d &x_trans, Eigen::Matrix3d &c_inv);
 
+      /** \brief Compute individual point contirbutions to hessian of probability function w.r.t. the transformation vector.
+        * \note Equation 6.13 [Magnusson 2009].
+        * \param[in,out] hessian the hessian matrix of the probability function w.r.t. the transformation vector
+        * \param[in] point_gradient the first order derivative of the transformation of the point, see \ref point_gradient_
+        * \param[in] point_hessian the second order derivative of the transformation of the point, see \ref point_hessian_
+        * \param[in] x_trans transformed point minus mean of occupied covariance voxel
+        * \param[in] c_inv covariance of occupied covariance voxel
+        */
+      void
+      updateHessian (Eigen::Matrix<double, 6, 6> &hessian,
+                     const Eigen::Matrix<double, 3, 6> &point_gradient,
+                     const Eigen::Matrix<double, 18, 6> &point_hessian,
+                     const Eigen::Vector3d &x_trans, const Eigen::Matrix3d &c_inv) const;
+
       /** \brief Compute line search step length and update transform and probability derivatives using More-Thuente method.
         * \note Search Algorithm [More, Thuente 1994]
         * \param[in] x initial transformation vector, \f$ x \f$ in Equation 1.3 (Moore, Thuente 1994) and \f$ \vec{p} \f$ in Algorithm 2 [Magnusson 2009]
@@ -422,6 +537,9 @@ namespace pcl
       /** \brief The side length of voxels. */
       float resolution_;
 
+      /** \brief The method used to find the occupied voxels near each transformed source point. */
+      NeighborSearchMethod search_method_;
+
       /** \brief The maximum step length. */
       double step_size_;
 
@@ -123,6 +123,8 @@ namespace pcl
         , source_cloud_updated_ (true)
         , force_no_recompute_ (false)
         , force_no_recompute_reciprocal_ (false)
+        , threads_ (1)
+        , threads_set_ (false)
         , update_visualizer_ (NULL)
         , point_representation_ ()
       {
@@ -288,6 +290,30 @@ namespace pcl
       inline int 
       getMaximumIterations () { return (max_iterations_); }
 
+      /** \brief Set the number of threads used by the registration method. Once set, it is passed on to the
+        * correspondence estimation, which searches the correspondences of the source points in parallel,
+        * overriding the number of threads of the estimator. It is also used by the methods which parallelize
+        * their own per point computations (e.g. NDT). Unless this is called, the correspondence estimation
+        * keeps its own setting.
+        * \param[in] nr_threads the number of hardware threads to use (0 sets the value back to automatic)
+        */
+      inline void
+      setNumberOfThreads (unsigned int nr_threads = 0)
+      {
+        threads_set_ = true;
+#ifdef _OPENMP
+        threads_ = nr_threads != 0 ? nr_threads : static_cast<unsigned int> (omp_get_num_procs ());
+#else
+        if (nr_threads != 1)
+          PCL_WARN ("[pcl::%s::setNumberOfThreads] PCL was compiled without OpenMP, using a single thread.\n", getClassName ().c_str ());
+        threads_ = 1;
+#endif
+      }
+
+      /** \brief Get the number of threads used by the registration method. */
+      inline unsigned int
+      getNumberOfThreads () const { return (threads_); }
+
       /** \brief Set the number of iterations RANSAC should run for.
         * \param[in] ransac_iterations is the number of iterations RANSAC should run for
         */
@@ -568,6 +594,13 @@ namespace pcl
        * will never be recomputed*/
       bool force_no_recompute_reciprocal_;
 
+      /** \brief The number of threads used by the registration method. */
+      unsigned int threads_;
+
+      /** \brief Whether the number of threads was set by the user, and is thus passed on to the
+        * correspondence estimation. */
+      bool threads_set_;
+
       /** \brief Callback function to update intermediate source point cloud position during it's registration
         * to the target point cloud.
         */
@@ -58,73 +58,70 @@ pcl::MEstimatorSampleConsensus<PointT>::computeModel (int debug_verbosity_level)
   double d_best_penalty = std::numeric_limits<double>::max();
   double k = 1.0;
 
-  std::vector<int> best_model;
-  std::vector<int> selection;
-  Eigen::VectorXf model_coefficients;
   std::vector<double> distances;
 
   int n_inliers_count = 0;
   unsigned skipped_count = 0;
-  // supress infinite loops by just allowing 10 x maximum allowed iterations for invalid model parameters!
-  const unsigned max_skip = max_iterations_ * 10;
-  
-  // Iterate
-  while (iterations_ < k && skipped_count < max_skip)
+  bool stop = false;
+
+  // The hypotheses are drawn and the best model is updated one thread at a time, while the distances
+  // and penalties are computed in parallel, each thread into its own buffer. With a single thread this
+  // is the plain serial loop.
+#ifdef _OPENMP
+#pragma omp parallel num_threads(threads_)
+#endif
   {
-    // Get X samples which satisfy the model criteria
-    sac_model_->getSamples (iterations_, selection);
+    std::vector<int> selection;
+    Eigen::VectorXf model_coefficients;
+    std::vector<double> distances;
 
-    if (selection.empty ()) break;
-
-    // Search for inliers in the point cloud for the current plane model M
-    if (!sac_model_->computeModelCoefficients (selection, model_coefficients))
-    {
-      //iterations_++;
-      ++ skipped_count;
-      continue;
-     }
-
-    double d_cur_penalty = 0;
-    // Iterate through the 3d points and calculate the distances from them to the model
-    sac_model_->getDistancesToModel (model_coefficients, distances);
-    
-    if (distances.empty () && k > 1.0)
-      continue;
-
-    for (size_t i = 0; i < distances.size (); ++i)
-      d_cur_penalty += (std::min) (distances[i], threshold_);
-
-    // Better match ?
-    if (d_cur_penalty < d_best_penalty)
+    while (true)
     {
-      d_best_penalty = d_cur_penalty;
-
-      // Save the current model/coefficients selection as being the best so far
-      model_              = selection;
-      model_coefficients_ = model_coefficients;
-
-      n_inliers_count = 0;
-      // Need to compute the number of inliers for this model to adapt k
+      bool drawn = false;
+#ifdef _OPENMP
+#pragma omp critical (pcl_msac)
+#endif
+      {
+        if (!stop)
+          drawn = drawHypothesis (k, skipped_count, selection, model_coefficients);
+        stop = !drawn;
+      }
+      if (!drawn)
+        break;
+
+      // Iterate through the 3d points and calculate the distances from them to the model
+      sac_model_->getDistancesToModel (model_coefficients, distances);
+      if (distances.empty ())
+        continue;
+
+      double d_cur_penalty = 0;
       for (size_t i = 0; i < distances.size (); ++i)
-        if (distances[i] <= threshold_)
-          ++n_inliers_count;
-
-      // Compute the k parameter (k=log(z)/log(1-w^n))
-      double w = static_cast<double> (n_inliers_count) / static_cast<double> (sac_model_->getIndices ()->size ());
-      double p_no_outliers = 1.0 - pow (w, static_cast<double> (selection.size ()));
-      p_no_outliers = (std::max) (std::numeric_limits<double>::epsilon (), p_no_outliers);       // Avoid division by -Inf
-      p_no_outliers = (std::min) (1.0 - std::numeric_limits<double>::epsilon (), p_no_outliers);   // Avoid division by 0.
-      k = log (1.0 - probability_) / log (p_no_outliers);
-    }
-
-    ++iterations_;
-    if (debug_verbosity_level > 1)
-      PCL_DEBUG ("[pcl::MEstimatorSampleConsensus::computeModel] Trial %d out of %d. Best penalty is %f.\n", iterations_, static_cast<int> (ceil (k)), d_best_penalty);
-    if (iterations_ > max_iterations_)
-    {
-      if (debug_verbosity_level > 0)
-        PCL_DEBUG ("[pcl::MEstimatorSampleConsensus::computeModel] MSAC reached the maximum number of trials.\n");
-      break;
+        d_cur_penalty += (std::min) (distances[i], threshold_);
+
+#ifdef _OPENMP
+#pragma omp critical (pcl_msac)
+#endif
+      {
+        // Better match ?
+        if (d_cur_penalty < d_best_penalty)
+        {
+          d_best_penalty = d_cur_penalty;
+
+          // Save the current model/coefficients selection as being the best so far
+          model_              = selection;
+          model_coefficients_ = model_coefficients;
+
+          // Need to compute the number of inliers for this model to adapt k
+          int n_model_inliers = 0;
+          for (size_t i = 0; i < distances.size (); ++i)
+            if (distances[i] <= threshold_)
+              ++n_model_inliers;
+
+          k = computeRequiredTrials (n_model_inliers, selection.size ());
+        }
+        if (debug_verbosity_level > 1)
+          PCL_DEBUG ("[pcl::MEstimatorSampleConsensus::computeModel] Trial %d out of %d. Best penalty is %f.\n", iterations_, static_cast<int> (ceil (k)), d_best_penalty);
+      }
     }
   }
 
@@ -57,68 +57,52 @@ pcl::RandomSampleConsensus<PointT>::computeModel (int)
   iterations_ = 0;
   int n_best_inliers_count = -INT_MAX;
   double k = 1.0;
-
-  std::vector<int> selection;
-  Eigen::VectorXf model_coefficients;
-
-  double log_probability  = log (1.0 - probability_);
-  double one_over_indices = 1.0 / static_cast<double> (sac_model_->getIndices ()->size ());
-
-  int n_inliers_count = 0;
   unsigned skipped_count = 0;
-  // supress infinite loops by just allowing 10 x maximum allowed iterations for invalid model parameters!
-  const unsigned max_skip = max_iterations_ * 10;
-  
-  // Iterate
-  while (iterations_ < k && skipped_count < max_skip)
-  {
-    // Get X samples which satisfy the model criteria
-    sac_model_->getSamples (iterations_, selection);
+  bool stop = false;
 
-    if (selection.empty ()) 
-    {
-      PCL_ERROR ("[pcl::RandomSampleConsensus::computeModel] No samples could be selected!\n");
-      break;
-    }
-
-    // Search for inliers in the point cloud for the current plane model M
-    if (!sac_model_->computeModelCoefficients (selection, model_coefficients))
-    {
-      //++iterations_;
-      ++skipped_count;
-      continue;
-    }
-
-    // Select the inliers that are within threshold_ from the model
-    //sac_model_->selectWithinDistance (model_coefficients, threshold_, inliers);
-    //if (inliers.empty () && k > 1.0)
-    //  continue;
-
-    n_inliers_count = sac_model_->countWithinDistance (model_coefficients, threshold_);
-
-    // Better match ?
-    if (n_inliers_count > n_best_inliers_count)
-    {
-      n_best_inliers_count = n_inliers_count;
-
-      // Save the current model/inlier/coefficients selection as being the best so far
-      model_              = selection;
-      model_coefficients_ = model_coefficients;
-
-      // Compute the k parameter (k=log(z)/log(1-w^n))
-      double w = static_cast<double> (n_best_inliers_count) * one_over_indices;
-      double p_no_outliers = 1.0 - pow (w, static_cast<double> (selection.size ()));
-      p_no_outliers = (std::max) (std::numeric_limits<double>::epsilon (), p_no_outliers);       // Avoid division by -Inf
-      p_no_outliers = (std::min) (1.0 - std::numeric_limits<double>::epsilon (), p_no_outliers);   // Avoid division by 0.
-      k = log_probability / log (p_no_outliers);
-    }
+  // The hypotheses are drawn and the best model is updated one thread at a time, while the (expensive)
+  // inlier counting runs in parallel. With a single thread this is the plain serial loop.
+#ifdef _OPENMP
+#pragma omp parallel num_threads(threads_)
+#endif
+  {
+    std::vector<int> selection;
+    Eigen::VectorXf model_coefficients;
 
-    ++iterations_;
-    PCL_DEBUG ("[pcl::RandomSampleConsensus::computeModel] Trial %d out of %f: %d inliers (best is: %d so far).\n", iterations_, k, n_inliers_count, n_best_inliers_count);
-    if (iterations_ > max_iterations_)
+    while (true)
     {
-      PCL_DEBUG ("[pcl::RandomSampleConsensus::computeModel] RANSAC reached the maximum number of trials.\n");
-      break;
+      bool drawn = false;
+#ifdef _OPENMP
+#pragma omp critical (pcl_ransac)
+#endif
+      {
+        if (!stop)
+          drawn = drawHypothesis (k, skipped_count, selection, model_coefficients);
+        stop = !drawn;
+      }
+      if (!drawn)
+        break;
+
+      // Select the inliers that are within threshold_ from the model
+      const int n_inliers_count = sac_model_->countWithinDistance (model_coefficients, threshold_);
+
+#ifdef _OPENMP
+#pragma omp critical (pcl_ransac)
+#endif
+      {
+        // Better match ?
+        if (n_inliers_count > n_best_inliers_count)
+        {
+          n_best_inliers_count = n_inliers_count;
+
+          // Save the current model/inlier/coefficients selection as being the best so far
+          model_              = selection;
+          model_coefficients_ = model_coefficients;
+
+          k = computeRequiredTrials (n_best_inliers_count, selection.size ());
+        }
+        PCL_DEBUG ("[pcl::RandomSampleConsensus::computeModel] Trial %d out of %f: %d inliers (best is: %d so far).\n", iterations_, k, n_inliers_count, n_best_inliers_count);
+      }
     }
   }
 
@@ -189,26 +189,39 @@ pcl::SampleConsensusModelCylinder<PointT, PointNT>::selectWithinDistance (
   Eigen::Vector4f line_dir (model_coefficients[3], model_coefficients[4], model_coefficients[5], 0);
   float ptdotdir = line_pt.dot (line_dir);
   float dirdotdir = 1.0f / line_dir.dot (line_dir);
-  // Iterate through the 3d points and calculate the distances from them to the sphere
-  for (size_t i = 0; i < indices_->size (); ++i)
-  {
-    // Aproximate the distance from the point to the cylinder as the difference between
-    // dist(point,cylinder_axis) and cylinder radius
-    Eigen::Vector4f pt (input_->points[(*indices_)[i]].x, input_->points[(*indices_)[i]].y, input_->points[(*indices_)[i]].z, 0);
-    Eigen::Vector4f n  (normals_->points[(*indices_)[i]].normal[0], normals_->points[(*indices_)[i]].normal[1], normals_->points[(*indices_)[i]].normal[2], 0);
-    double d_euclid = fabs (pointToLineDistance (pt, model_coefficients) - model_coefficients[6]);
 
-    // Calculate the point's projection on the cylinder axis
-    float k = (pt.dot (line_dir) - ptdotdir) * dirdotdir;
-    Eigen::Vector4f pt_proj = line_pt + k * line_dir;
-    Eigen::Vector4f dir = pt - pt_proj;
-    dir.normalize ();
-
-    // Calculate the angular distance between the point normal and the (dir=pt_proj->pt) vector
-    double d_normal = fabs (getAngle3D (n, dir));
-    d_normal = (std::min) (d_normal, M_PI - d_normal);
+  size_t i = 0;
+#if defined (__SSE2__)
+  const float line_norm = line_dir.norm ();
+  const __m128 line_pt4[3]  = { _mm_set1_ps (line_pt[0]), _mm_set1_ps (line_pt[1]), _mm_set1_ps (line_pt[2]) };
+  const __m128 line_dir4[3] = { _mm_set1_ps (line_dir[0] / line_norm), _mm_set1_ps (line_dir[1] / line_norm), _mm_set1_ps (line_dir[2] / line_norm) };
+  const __m128 radius = _mm_set1_ps (model_coefficients[6]);
+  const __m128 euclid_weight = _mm_set1_ps (static_cast<float> (1 - normal_distance_weight_));
+  const __m128 threshold4 = _mm_set1_ps (static_cast<float> (threshold));
+
+  // Four points at a time: only the points within the euclidean bound need the exact evaluation
+  for (; i + 4 <= indices_->size (); i += 4)
+  {
+    const int mask = _mm_movemask_ps (_mm_cmplt_ps (euclideanBound4 (i, line_pt4, line_dir4, radius, euclid_weight), threshold4));
+    for (int j = 0; mask != 0 && j < 4; ++j)
+    {
+      if (!(mask & (1 << j)))
+        continue;
+      double distance = pointToCylinderDistance ((*indices_)[i + j], model_coefficients, line_pt, line_dir, ptdotdir, dirdotdir);
+      if (distance < threshold)
+      {
+        inliers[nr_p] = (*indices_)[i + j];
+        error_sqr_dists_[nr_p] = distance;
+        ++nr_p;
+      }
+    }
+  }
+#endif
 
-    double distance = fabs (normal_distance_weight_ * d_normal + (1 - normal_distance_weight_) * d_euclid); 
+  // Iterate through the (remaining) 3d points and calculate the distances from them to the cylinder
+  for (; i < indices_->size (); ++i)
+  {
+    double distance = pointToCylinderDistance ((*indices_)[i], model_coefficients, line_pt, line_dir, ptdotdir, dirdotdir);
     if (distance < threshold)
     {
       // Returns the indices of the points whose distances are smaller than the threshold
@@ -236,31 +249,92 @@ pcl::SampleConsensusModelCylinder<PointT, PointNT>::countWithinDistance (
   Eigen::Vector4f line_dir (model_coefficients[3], model_coefficients[4], model_coefficients[5], 0);
   float ptdotdir = line_pt.dot (line_dir);
   float dirdotdir = 1.0f / line_dir.dot (line_dir);
-  // Iterate through the 3d points and calculate the distances from them to the sphere
-  for (size_t i = 0; i < indices_->size (); ++i)
-  {
-    // Aproximate the distance from the point to the cylinder as the difference between
-    // dist(point,cylinder_axis) and cylinder radius
-    Eigen::Vector4f pt (input_->points[(*indices_)[i]].x, input_->points[(*indices_)[i]].y, input_->points[(*indices_)[i]].z, 0);
-    Eigen::Vector4f n  (normals_->points[(*indices_)[i]].normal[0], normals_->points[(*indices_)[i]].normal[1], normals_->points[(*indices_)[i]].normal[2], 0);
-    double d_euclid = fabs (pointToLineDistance (pt, model_coefficients) - model_coefficients[6]);
-
-    // Calculate the point's projection on the cylinder axis
-    float k = (pt.dot (line_dir) - ptdotdir) * dirdotdir;
-    Eigen::Vector4f pt_proj = line_pt + k * line_dir;
-    Eigen::Vector4f dir = pt - pt_proj;
-    dir.normalize ();
 
-    // Calculate the angular distance between the point normal and the (dir=pt_proj->pt) vector
-    double d_normal = fabs (getAngle3D (n, dir));
-    d_normal = (std::min) (d_normal, M_PI - d_normal);
+  size_t i = 0;
+#if defined (__SSE2__)
+  const float line_norm = line_dir.norm ();
+  const __m128 line_pt4[3]  = { _mm_set1_ps (line_pt[0]), _mm_set1_ps (line_pt[1]), _mm_set1_ps (line_pt[2]) };
+  const __m128 line_dir4[3] = { _mm_set1_ps (line_dir[0] / line_norm), _mm_set1_ps (line_dir[1] / line_norm), _mm_set1_ps (line_dir[2] / line_norm) };
+  const __m128 radius = _mm_set1_ps (model_coefficients[6]);
+  const __m128 euclid_weight = _mm_set1_ps (static_cast<float> (1 - normal_distance_weight_));
+  const __m128 threshold4 = _mm_set1_ps (static_cast<float> (threshold));
+
+  // Four points at a time: only the points within the euclidean bound need the exact evaluation
+  for (; i + 4 <= indices_->size (); i += 4)
+  {
+    const int mask = _mm_movemask_ps (_mm_cmplt_ps (euclideanBound4 (i, line_pt4, line_dir4, radius, euclid_weight), threshold4));
+    for (int j = 0; mask != 0 && j < 4; ++j)
+    {
+      if (!(mask & (1 << j)))
+        continue;
+      if (pointToCylinderDistance ((*indices_)[i + j], model_coefficients, line_pt, line_dir, ptdotdir, dirdotdir) < threshold)
+        nr_p++;
+    }
+  }
+#endif
 
-    if (fabs (normal_distance_weight_ * d_normal + (1 - normal_distance_weight_) * d_euclid) < threshold)
+  // Iterate through the (remaining) 3d points and calculate the distances from them to the cylinder
+  for (; i < indices_->size (); ++i)
+  {
+    if (pointToCylinderDistance ((*indices_)[i], model_coefficients, line_pt, line_dir, ptdotdir, dirdotdir) < threshold)
       nr_p++;
   }
   return (nr_p);
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT, typename PointNT> double
+pcl::SampleConsensusModelCylinder<PointT, PointNT>::pointToCylinderDistance (
+      int index, const Eigen::VectorXf &model_coefficients,
+      const Eigen::Vector4f &line_pt, const Eigen::Vector4f &line_dir,
+      float ptdotdir, float dirdotdir)
+{
+  // Aproximate the distance from the point to the cylinder as the difference between
+  // dist(point,cylinder_axis) and cylinder radius
+  Eigen::Vector4f pt (input_->points[index].x, input_->points[index].y, input_->points[index].z, 0);
+  Eigen::Vector4f n  (normals_->points[index].normal[0], normals_->points[index].normal[1], normals_->points[index].normal[2], 0);
+  double d_euclid = fabs (pointToLineDistance (pt, model_coefficients) - model_coefficients[6]);
+
+  // Calculate the point's projection on the cylinder axis
+  float k = (pt.dot (line_dir) - ptdotdir) * dirdotdir;
+  Eigen::Vector4f pt_proj = line_pt + k * line_dir;
+  Eigen::Vector4f dir = pt - pt_proj;
+  dir.normalize ();
+
+  // Calculate the angular distance between the point normal and the (dir=pt_proj->pt) vector
+  double d_normal = fabs (getAngle3D (n, dir));
+  d_normal = (std::min) (d_normal, M_PI - d_normal);
+
+  return (fabs (normal_distance_weight_ * d_normal + (1 - normal_distance_weight_) * d_euclid));
+}
+
+#if defined (__SSE2__)
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT, typename PointNT> inline __m128
+pcl::SampleConsensusModelCylinder<PointT, PointNT>::euclideanBound4 (
+      size_t i, const __m128 line_pt[3], const __m128 line_dir[3],
+      const __m128 &radius, const __m128 &euclid_weight) const
+{
+  __m128 x, y, z;
+  this->loadPoints4 (i, x, y, z);
+
+  // dist(point,cylinder_axis) = ||(line_pt - p) x line_dir||, with line_dir normalized
+  const __m128 vx = _mm_sub_ps (line_pt[0], x);
+  const __m128 vy = _mm_sub_ps (line_pt[1], y);
+  const __m128 vz = _mm_sub_ps (line_pt[2], z);
+  const __m128 cx = _mm_sub_ps (_mm_mul_ps (vy, line_dir[2]), _mm_mul_ps (vz, line_dir[1]));
+  const __m128 cy = _mm_sub_ps (_mm_mul_ps (vz, line_dir[0]), _mm_mul_ps (vx, line_dir[2]));
+  const __m128 cz = _mm_sub_ps (_mm_mul_ps (vx, line_dir[1]), _mm_mul_ps (vy, line_dir[0]));
+  const __m128 dist = _mm_sqrt_ps (_mm_add_ps (_mm_add_ps (_mm_mul_ps (cx, cx), _mm_mul_ps (cy, cy)), _mm_mul_ps (cz, cz)));
+
+  // |dist - radius|, minus a small relative margin which keeps the bound below the exact scalar
+  // distance despite the different rounding of the two computations
+  const __m128 d_euclid = _mm_sub_ps (_mm_andnot_ps (_mm_set1_ps (-0.0f), _mm_sub_ps (dist, radius)),
+                                      _mm_mul_ps (_mm_add_ps (dist, radius), _mm_set1_ps (1e-5f)));
+  return (_mm_mul_ps (euclid_weight, d_euclid));
+}
+#endif
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 template <typename PointT, typename PointNT> void
 pcl::SampleConsensusModelCylinder<PointT, PointNT>::optimizeModelCoefficients (
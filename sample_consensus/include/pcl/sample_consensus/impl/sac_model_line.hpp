@@ -138,8 +138,22 @@ pcl::SampleConsensusModelLine<PointT>::selectWithinDistance (
   Eigen::Vector4f line_dir (model_coefficients[3], model_coefficients[4], model_coefficients[5], 0);
   line_dir.normalize ();
 
-  // Iterate through the 3d points and calculate the distances from them to the line
-  for (size_t i = 0; i < indices_->size (); ++i)
+  size_t i = 0;
+#if defined (__SSE2__)
+  const __m128 line_pt4[3]  = { _mm_set1_ps (line_pt[0]), _mm_set1_ps (line_pt[1]), _mm_set1_ps (line_pt[2]) };
+  const __m128 line_dir4[3] = { _mm_set1_ps (line_dir[0]), _mm_set1_ps (line_dir[1]), _mm_set1_ps (line_dir[2]) };
+  const __m128 sqr_threshold4 = _mm_set1_ps (static_cast<float> (sqr_threshold));
+
+  // Four points at a time
+  for (; i + 4 <= indices_->size (); i += 4)
+  {
+    const __m128 sqr_distance = sqrDistance4 (i, line_pt4, line_dir4);
+    this->appendInliers4 (i, _mm_movemask_ps (_mm_cmplt_ps (sqr_distance, sqr_threshold4)), sqr_distance, inliers, nr_p);
+  }
+#endif
+
+  // Iterate through the (remaining) 3d points and calculate the distances from them to the line
+  for (; i < indices_->size (); ++i)
   {
     // Calculate the distance from the point to the line
     // D = ||(P2-P1) x (P1-P0)|| / ||P2-P1|| = norm (cross (p2-p1, p2-p0)) / norm(p2-p1)
@@ -175,8 +189,21 @@ pcl::SampleConsensusModelLine<PointT>::countWithinDistance (
   Eigen::Vector4f line_dir (model_coefficients[3], model_coefficients[4], model_coefficients[5], 0);
   line_dir.normalize ();
 
-  // Iterate through the 3d points and calculate the distances from them to the line
-  for (size_t i = 0; i < indices_->size (); ++i)
+  size_t i = 0;
+#if defined (__SSE2__)
+  const __m128 line_pt4[3]  = { _mm_set1_ps (line_pt[0]), _mm_set1_ps (line_pt[1]), _mm_set1_ps (line_pt[2]) };
+  const __m128 line_dir4[3] = { _mm_set1_ps (line_dir[0]), _mm_set1_ps (line_dir[1]), _mm_set1_ps (line_dir[2]) };
+  const __m128 sqr_threshold4 = _mm_set1_ps (static_cast<float> (sqr_threshold));
+
+  // Four points at a time; the comparison sets the lanes of the inliers to -1
+  __m128i nr_p4 = _mm_setzero_si128 ();
+  for (; i + 4 <= indices_->size (); i += 4)
+    nr_p4 = _mm_sub_epi32 (nr_p4, _mm_castps_si128 (_mm_cmplt_ps (sqrDistance4 (i, line_pt4, line_dir4), sqr_threshold4)));
+  nr_p = this->horizontalSum (nr_p4);
+#endif
+
+  // Iterate through the (remaining) 3d points and calculate the distances from them to the line
+  for (; i < indices_->size (); ++i)
   {
     // Calculate the distance from the point to the line
     // D = ||(P2-P1) x (P1-P0)|| / ||P2-P1|| = norm (cross (p2-p1, p2-p0)) / norm(p2-p1)
@@ -188,6 +215,26 @@ pcl::SampleConsensusModelLine<PointT>::countWithinDistance (
   return (nr_p);
 }
 
+#if defined (__SSE2__)
+//////////////////////////////////////////////////////////////////////////
+template <typename PointT> inline __m128
+pcl::SampleConsensusModelLine<PointT>::sqrDistance4 (
+      size_t i, const __m128 line_pt[3], const __m128 line_dir[3]) const
+{
+  __m128 x, y, z;
+  this->loadPoints4 (i, x, y, z);
+
+  // ||(line_pt - p) x line_dir||^2, with line_dir normalized
+  const __m128 vx = _mm_sub_ps (line_pt[0], x);
+  const __m128 vy = _mm_sub_ps (line_pt[1], y);
+  const __m128 vz = _mm_sub_ps (line_pt[2], z);
+  const __m128 cx = _mm_sub_ps (_mm_mul_ps (vy, line_dir[2]), _mm_mul_ps (vz, line_dir[1]));
+  const __m128 cy = _mm_sub_ps (_mm_mul_ps (vz, line_dir[0]), _mm_mul_ps (vx, line_dir[2]));
+  const __m128 cz = _mm_sub_ps (_mm_mul_ps (vx, line_dir[1]), _mm_mul_ps (vy, line_dir[0]));
+  return (_mm_add_ps (_mm_add_ps (_mm_mul_ps (cx, cx), _mm_mul_ps (cy, cy)), _mm_mul_ps (cz, cz)));
+}
+#endif
+
 //////////////////////////////////////////////////////////////////////////
 template <typename PointT> void
 pcl::SampleConsensusModelLine<PointT>::optimizeModelCoefficients (
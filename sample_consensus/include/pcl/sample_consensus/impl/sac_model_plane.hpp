@@ -154,8 +154,24 @@ pcl::SampleConsensusModelPlane<PointT>::selectWithinDistance (
   inliers.resize (indices_->size ());
   error_sqr_dists_.resize (indices_->size ());
 
-  // Iterate through the 3d points and calculate the distances from them to the plane
-  for (size_t i = 0; i < indices_->size (); ++i)
+  size_t i = 0;
+#if defined (__SSE2__)
+  const __m128 a = _mm_set1_ps (model_coefficients[0]);
+  const __m128 b = _mm_set1_ps (model_coefficients[1]);
+  const __m128 c = _mm_set1_ps (model_coefficients[2]);
+  const __m128 d = _mm_set1_ps (model_coefficients[3]);
+  const __m128 threshold4 = _mm_set1_ps (static_cast<float> (threshold));
+
+  // Four points at a time
+  for (; i + 4 <= indices_->size (); i += 4)
+  {
+    const __m128 distance = distance4 (i, a, b, c, d);
+    this->appendInliers4 (i, _mm_movemask_ps (_mm_cmplt_ps (distance, threshold4)), distance, inliers, nr_p);
+  }
+#endif
+
+  // Iterate through the (remaining) 3d points and calculate the distances from them to the plane
+  for (; i < indices_->size (); ++i)
   {
     // Calculate the distance from the point to the plane normal as the dot product
     // D = (P-A).N/|N|
@@ -192,8 +208,23 @@ pcl::SampleConsensusModelPlane<PointT>::countWithinDistance (
 
   int nr_p = 0;
 
-  // Iterate through the 3d points and calculate the distances from them to the plane
-  for (size_t i = 0; i < indices_->size (); ++i)
+  size_t i = 0;
+#if defined (__SSE2__)
+  const __m128 a = _mm_set1_ps (model_coefficients[0]);
+  const __m128 b = _mm_set1_ps (model_coefficients[1]);
+  const __m128 c = _mm_set1_ps (model_coefficients[2]);
+  const __m128 d = _mm_set1_ps (model_coefficients[3]);
+  const __m128 threshold4 = _mm_set1_ps (static_cast<float> (threshold));
+
+  // Four points at a time; the comparison sets the lanes of the inliers to -1
+  __m128i nr_p4 = _mm_setzero_si128 ();
+  for (; i + 4 <= indices_->size (); i += 4)
+    nr_p4 = _mm_sub_epi32 (nr_p4, _mm_castps_si128 (_mm_cmplt_ps (distance4 (i, a, b, c, d), threshold4)));
+  nr_p = this->horizontalSum (nr_p4);
+#endif
+
+  // Iterate through the (remaining) 3d points and calculate the distances from them to the plane
+  for (; i < indices_->size (); ++i)
   {
     // Calculate the distance from the point to the plane normal as the dot product
     // D = (P-A).N/|N|
@@ -207,6 +238,22 @@ pcl::SampleConsensusModelPlane<PointT>::countWithinDistance (
   return (nr_p);
 }
 
+#if defined (__SSE2__)
+//////////////////////////////////////////////////////////////////////////
+template <typename PointT> inline __m128
+pcl::SampleConsensusModelPlane<PointT>::distance4 (
+      size_t i, const __m128 &a, const __m128 &b, const __m128 &c, const __m128 &d) const
+{
+  __m128 x, y, z;
+  this->loadPoints4 (i, x, y, z);
+
+  // |a*x + b*y + c*z + d|, the absolute value by clearing the sign bit
+  const __m128 distance = _mm_add_ps (_mm_add_ps (_mm_mul_ps (a, x), _mm_mul_ps (b, y)),
+                                      _mm_add_ps (_mm_mul_ps (c, z), d));
+  return (_mm_andnot_ps (_mm_set1_ps (-0.0f), distance));
+}
+#endif
+
 //////////////////////////////////////////////////////////////////////////
 template <typename PointT> void
 pcl::SampleConsensusModelPlane<PointT>::optimizeModelCoefficients (
@@ -69,6 +69,9 @@ namespace pcl
       using SampleConsensus<PointT>::model_coefficients_;
       using SampleConsensus<PointT>::inliers_;
       using SampleConsensus<PointT>::probability_;
+      using SampleConsensus<PointT>::threads_;
+      using SampleConsensus<PointT>::drawHypothesis;
+      using SampleConsensus<PointT>::computeRequiredTrials;
 
       /** \brief RANSAC (RAndom SAmple Consensus) main constructor
         * \param[in] model a Sample Consensus model
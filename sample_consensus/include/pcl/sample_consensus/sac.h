@@ -45,6 +45,9 @@
 #include <pcl/sample_consensus/sac_model.h>
 #include <ctime>
 #include <set>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace pcl
 {
@@ -78,6 +81,7 @@ namespace pcl
         , iterations_ (0)
         , threshold_ (std::numeric_limits<double>::max ())
         , max_iterations_ (1000)
+        , threads_ (1)
         , rng_alg_ ()
         , rng_ (new boost::uniform_01<boost::mt19937> (rng_alg_))
       {
@@ -104,6 +108,7 @@ namespace pcl
         , iterations_ (0)
         , threshold_ (threshold)
         , max_iterations_ (1000)
+        , threads_ (1)
         , rng_alg_ ()
         , rng_ (new boost::uniform_01<boost::mt19937> (rng_alg_))
       {
@@ -164,6 +169,28 @@ namespace pcl
       inline double 
       getProbability () { return (probability_); }
 
+      /** \brief Set the number of threads used to evaluate the model hypotheses in parallel. Only
+        * RandomSampleConsensus and MEstimatorSampleConsensus make use of it (default: 1).
+        * \param[in] nr_threads the number of hardware threads to use (0 sets the value back to automatic)
+        * \note with more than one thread the hypotheses are evaluated in a non deterministic order, so the
+        * resulting model may differ between runs even with a fixed random seed.
+        */
+      inline void
+      setNumberOfThreads (unsigned int nr_threads = 0)
+      {
+#ifdef _OPENMP
+        threads_ = nr_threads != 0 ? nr_threads : static_cast<unsigned int> (omp_get_num_procs ());
+#else
+        if (nr_threads != 1)
+          PCL_WARN ("[pcl::SampleConsensus::setNumberOfThreads] PCL was compiled without OpenMP, using a single thread.\n");
+        threads_ = 1;
+#endif
+      }
+
+      /** \brief Get the number of threads used to evaluate the model hypotheses. */
+      inline unsigned int
+      getNumberOfThreads () const { return (threads_); }
+
       /** \brief Compute the actual model. Pure virtual. */
       virtual bool 
       computeModel (int debug_verbosity_level = 0) = 0;
@@ -306,6 +333,61 @@ namespace pcl
       getModelCoefficients (Eigen::VectorXf &model_coefficients) { model_coefficients = model_coefficients_; }
 
     protected:
+      /** \brief Draw the next model hypothesis of a computeModel () loop. Samples are drawn until one gives
+        * valid model coefficients, which then counts as a trial in iterations_.
+        * \param[in] k the number of trials needed to reach the desired probability_
+        * \param[in,out] skipped_count the number of samples that gave invalid model coefficients so far
+        * \param[out] selection the indices of the samples making up the hypothesis
+        * \param[out] model_coefficients the coefficients of the hypothesis
+        * \return false if no more hypotheses should be drawn
+        */
+      bool
+      drawHypothesis (double k, unsigned &skipped_count,
+                      std::vector<int> &selection, Eigen::VectorXf &model_coefficients)
+      {
+        // supress infinite loops by just allowing 10 x maximum allowed iterations for invalid model parameters!
+        const unsigned max_skip = max_iterations_ * 10;
+        while (iterations_ < k && skipped_count < max_skip)
+        {
+          if (iterations_ > max_iterations_)
+          {
+            PCL_DEBUG ("[pcl::SampleConsensus::drawHypothesis] Reached the maximum number of trials.\n");
+            return (false);
+          }
+
+          // Get X samples which satisfy the model criteria
+          sac_model_->getSamples (iterations_, selection);
+          if (selection.empty ())
+          {
+            PCL_ERROR ("[pcl::SampleConsensus::drawHypothesis] No samples could be selected!\n");
+            return (false);
+          }
+
+          if (sac_model_->computeModelCoefficients (selection, model_coefficients))
+          {
+            ++iterations_;
+            return (true);
+          }
+          ++skipped_count;
+        }
+        return (false);
+      }
+
+      /** \brief Compute the number of trials k needed so that, with probability_, at least one of them
+        * is drawn from inliers only: k=log(1-probability_)/log(1-w^n).
+        * \param[in] nr_inliers the number of inliers w of the best model so far, out of all indices
+        * \param[in] sample_size the number of samples n making up a hypothesis
+        */
+      double
+      computeRequiredTrials (int nr_inliers, size_t sample_size) const
+      {
+        double w = static_cast<double> (nr_inliers) / static_cast<double> (sac_model_->getIndices ()->size ());
+        double p_no_outliers = 1.0 - pow (w, static_cast<double> (sample_size));
+        p_no_outliers = (std::max) (std::numeric_limits<double>::epsilon (), p_no_outliers);       // Avoid division by -Inf
+        p_no_outliers = (std::min) (1.0 - std::numeric_limits<double>::epsilon (), p_no_outliers);   // Avoid division by 0.
+        return (log (1.0 - probability_) / log (p_no_outliers));
+      }
+
       /** \brief The underlying data model used (i.e. what is it that we attempt to search for). */
       SampleConsensusModelPtr sac_model_;
 
@@ -330,6 +412,9 @@ namespace pcl
       /** \brief Maximum number of iterations before giving up. */
       int max_iterations_;
 
+      /** \brief The number of threads used to evaluate the model hypotheses. */
+      unsigned int threads_;
+
       /** \brief Boost-based random number generator algorithm. */
       boost::mt19937 rng_alg_;
 
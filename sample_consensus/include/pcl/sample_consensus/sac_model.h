@@ -45,6 +45,9 @@
 #include <ctime>
 #include <limits.h>
 #include <set>
+#if defined (__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #include <pcl/console/print.h>
 #include <pcl/point_cloud.h>
@@ -499,6 +502,65 @@ namespace pcl
         std::copy (shuffled_indices_.begin (), shuffled_indices_.begin () + sample_size, sample.begin ());
       }
 
+#if defined (__SSE2__)
+      /** \brief Load the coordinates of the points indexed by indices_[i] to indices_[i+3], transposed into
+        * one register per coordinate. Used by the vectorized distance kernels of the models.
+        * \note the coordinates are loaded one by one, so that no bytes past z are read from point types
+        * that only store x, y and z
+        * \param[in] i position of the first of the four points in indices_
+        * \param[out] x the x coordinates of the four points
+        * \param[out] y the y coordinates of the four points
+        * \param[out] z the z coordinates of the four points
+        */
+      inline void
+      loadPoints4 (size_t i, __m128 &x, __m128 &y, __m128 &z) const
+      {
+        const PointT &p0 = input_->points[(*indices_)[i    ]];
+        const PointT &p1 = input_->points[(*indices_)[i + 1]];
+        const PointT &p2 = input_->points[(*indices_)[i + 2]];
+        const PointT &p3 = input_->points[(*indices_)[i + 3]];
+        x = _mm_setr_ps (p0.x, p1.x, p2.x, p3.x);
+        y = _mm_setr_ps (p0.y, p1.y, p2.y, p3.y);
+        z = _mm_setr_ps (p0.z, p1.z, p2.z, p3.z);
+      }
+
+      /** \brief Append the points indices_[i] to indices_[i+3] whose bits are set in \a mask to the inliers,
+        * storing their distances in error_sqr_dists_.
+        * \param[in] i position of the first of the four points in indices_
+        * \param[in] mask inlier mask of the four points, as given by _mm_movemask_ps
+        * \param[in] distances the distances of the four points to the model
+        * \param[out] inliers the inliers, which must be large enough to hold the new ones
+        * \param[in,out] nr_p the number of inliers
+        */
+      inline void
+      appendInliers4 (size_t i, int mask, const __m128 &distances, std::vector<int> &inliers, int &nr_p)
+      {
+        if (mask == 0)
+          return;
+
+        float d[4];
+        _mm_storeu_ps (d, distances);
+        for (int j = 0; j < 4; ++j)
+        {
+          if (mask & (1 << j))
+          {
+            inliers[nr_p] = (*indices_)[i + j];
+            error_sqr_dists_[nr_p] = static_cast<double> (d[j]);
+            ++nr_p;
+          }
+        }
+      }
+
+      /** \brief Sum the four 32 bit integers of a register. */
+      static inline int
+      horizontalSum (const __m128i &v)
+      {
+        __m128i sum = _mm_add_epi32 (v, _mm_shuffle_epi32 (v, _MM_SHUFFLE (1, 0, 3, 2)));
+        sum = _mm_add_epi32 (sum, _mm_shuffle_epi32 (sum, _MM_SHUFFLE (2, 3, 0, 1)));
+        return (_mm_cvtsi128_si32 (sum));
+      }
+#endif
+
       /** \brief Check whether a model is valid given the user constraints.
         * \param[in] model_coefficients the set of model coefficients
         */
@@ -293,6 +293,36 @@ namespace pcl
       bool
       isSampleGood (const std::vector<int> &samples) const;
 
+      /** \brief Compute the weighted euclidean and angular distance from a point to a cylinder.
+        * \param[in] index the index of the point in input_ and normals_
+        * \param[in] model_coefficients the coefficients of the cylinder (point_on_axis, axis_direction, cylinder_radius_R)
+        * \param[in] line_pt the point on the cylinder axis
+        * \param[in] line_dir the direction of the cylinder axis
+        * \param[in] ptdotdir the dot product of \a line_pt and \a line_dir
+        * \param[in] dirdotdir the inverse squared norm of \a line_dir
+        */
+      double
+      pointToCylinderDistance (int index,
+                               const Eigen::VectorXf &model_coefficients,
+                               const Eigen::Vector4f &line_pt,
+                               const Eigen::Vector4f &line_dir,
+                               float ptdotdir, float dirdotdir);
+
+#if defined (__SSE2__)
+      /** \brief Compute a lower bound of (1 - normal_distance_weight_) times the euclidean distance of the points
+        * indices_[i] to indices_[i+3] to a cylinder. Points for which it exceeds the threshold are outliers
+        * regardless of their normals, which lets most outliers skip the exact scalar evaluation.
+        * \param[in] i position of the first of the four points in indices_
+        * \param[in] line_pt the x, y and z coordinates of a point on the axis, each broadcast to all four lanes
+        * \param[in] line_dir the x, y and z components of the normalized axis direction, each broadcast to all four lanes
+        * \param[in] radius the cylinder radius, broadcast to all four lanes
+        * \param[in] euclid_weight (1 - normal_distance_weight_), broadcast to all four lanes
+        */
+      inline __m128
+      euclideanBound4 (size_t i, const __m128 line_pt[3], const __m128 line_dir[3],
+                       const __m128 &radius, const __m128 &euclid_weight) const;
+#endif
+
     private:
       /** \brief The axis along which we need to search for a plane perpendicular to. */
       Eigen::Vector3f axis_;
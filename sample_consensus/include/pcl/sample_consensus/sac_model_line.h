@@ -197,6 +197,16 @@ namespace pcl
         */
       bool
       isSampleGood (const std::vector<int> &samples) const;
+
+#if defined (__SSE2__)
+      /** \brief Compute the squared distances of the points indices_[i] to indices_[i+3] to a line.
+        * \param[in] i position of the first of the four points in indices_
+        * \param[in] line_pt the x, y and z coordinates of a point on the line, each broadcast to all four lanes
+        * \param[in] line_dir the x, y and z components of the normalized line direction, each broadcast to all four lanes
+        */
+      inline __m128
+      sqrDistance4 (size_t i, const __m128 line_pt[3], const __m128 line_dir[3]) const;
+#endif
   };
 }
 
@@ -264,6 +264,15 @@ namespace pcl
         return (true);
       }
 
+#if defined (__SSE2__)
+      /** \brief Compute the absolute distances of the points indices_[i] to indices_[i+3] to a plane.
+        * \param[in] i position of the first of the four points in indices_
+        * \param[in] a,b,c,d the plane coefficients, each broadcast to all four lanes
+        */
+      inline __m128
+      distance4 (size_t i, const __m128 &a, const __m128 &b, const __m128 &c, const __m128 &d) const;
+#endif
+
     private:
       /** \brief Check if a sample of indices results in a good sample of points
         * indices.
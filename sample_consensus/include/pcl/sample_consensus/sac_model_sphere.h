@@ -225,6 +225,16 @@ namespace pcl
       bool
       isSampleGood(const std::vector<int> &samples) const;
 
+#if defined (__SSE2__)
+      /** \brief Compute the absolute distances of the points indices_[i] to indices_[i+3] to a sphere.
+        * \param[in] i position of the first of the four points in indices_
+        * \param[in] a,b,c the sphere center, each coordinate broadcast to all four lanes
+        * \param[in] r the sphere radius, broadcast to all four lanes
+        */
+      inline __m128
+      distance4 (size_t i, const __m128 &a, const __m128 &b, const __m128 &c, const __m128 &r) const;
+#endif
+
     private:
       /** \brief Temporary pointer to a list of given indices for optimizeModelCoefficients () */
       const std::vector<int> *tmp_inliers_;
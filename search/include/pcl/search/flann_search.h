@@ -105,6 +105,9 @@ namespace pcl
       using Search<PointT>::sorted_results_;
 
       public:
+        using Search<PointT>::nearestKSearch;
+        using Search<PointT>::radiusSearch;
+
         typedef boost::shared_ptr<FlannSearch<PointT, FlannDistance> > Ptr;
         typedef boost::shared_ptr<const FlannSearch<PointT, FlannDistance> > ConstPtr;
         
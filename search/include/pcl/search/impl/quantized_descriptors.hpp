@@ -0,0 +1,122 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2014-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PCL_SEARCH_IMPL_QUANTIZED_DESCRIPTORS_H_
+#define PCL_SEARCH_IMPL_QUANTIZED_DESCRIPTORS_H_
+
+#include <pcl/search/quantized_descriptors.h>
+#include <pcl/common/quantized_descriptors.h>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> void
+pcl::search::QuantizedDescriptorSearch<PointT>::setInputCloud (
+    const PointCloudConstPtr& cloud, const IndicesConstPtr& indices)
+{
+  input_ = cloud;
+  indices_ = indices;
+  pcl::squaredCodeNorms (*input_, code_norms_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> int
+pcl::search::QuantizedDescriptorSearch<PointT>::nearestKSearch (
+    const PointT &point, int k, std::vector<int> &k_indices, std::vector<float> &k_sqr_distances) const
+{
+  return (scan (point, k > 0 ? static_cast<size_t> (k) : 0, std::numeric_limits<float>::infinity (),
+                k_indices, k_sqr_distances));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> int
+pcl::search::QuantizedDescriptorSearch<PointT>::radiusSearch (
+    const PointT& point, double radius, std::vector<int> &k_indices,
+    std::vector<float> &k_sqr_distances, unsigned int max_nn) const
+{
+  return (scan (point, max_nn > 0 ? max_nn : std::numeric_limits<size_t>::max (),
+                static_cast<float> (radius * radius), k_indices, k_sqr_distances));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> int
+pcl::search::QuantizedDescriptorSearch<PointT>::scan (
+    const PointT &point, size_t k, float max_sqr_distance,
+    std::vector<int> &k_indices, std::vector<float> &k_sqr_distances) const
+{
+  std::vector<float> sqr_distances;
+  pcl::squaredDescriptorDistances (point, *input_, code_norms_, sqr_distances);
+
+  // The k best (distance, index) pairs, in a max-heap: pairs sort by distance first and then by index.
+  // NaN distances fail the comparison with max_sqr_distance.
+  std::vector<std::pair<float, int> > candidates;
+  const size_t nr_candidates = indices_ ? indices_->size () : sqr_distances.size ();
+  for (size_t i = 0; i < nr_candidates; ++i)
+  {
+    const int index = indices_ ? (*indices_)[i] : static_cast<int> (i);
+    if (!(sqr_distances[index] <= max_sqr_distance))
+      continue;
+    const std::pair<float, int> candidate (sqr_distances[index], index);
+    if (candidates.size () < k)
+    {
+      candidates.push_back (candidate);
+      std::push_heap (candidates.begin (), candidates.end ());
+    }
+    else if (k > 0 && candidate < candidates.front ())
+    {
+      std::pop_heap (candidates.begin (), candidates.end ());
+      candidates.back () = candidate;
+      std::push_heap (candidates.begin (), candidates.end ());
+    }
+  }
+  std::sort_heap (candidates.begin (), candidates.end ());
+
+  const size_t nr_found = candidates.size ();
+  k_indices.resize (nr_found);
+  k_sqr_distances.resize (nr_found);
+  for (size_t i = 0; i < nr_found; ++i)
+  {
+    k_sqr_distances[i] = candidates[i].first;
+    k_indices[i] = candidates[i].second;
+  }
+  return (static_cast<int> (nr_found));
+}
+
+#define PCL_INSTANTIATE_QuantizedDescriptorSearch(T) template class PCL_EXPORTS pcl::search::QuantizedDescriptorSearch<T>;
+
+#endif    // PCL_SEARCH_IMPL_QUANTIZED_DESCRIPTORS_H_
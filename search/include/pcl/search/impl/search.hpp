@@ -135,6 +135,17 @@ pcl::search::Search<PointT>::nearestKSearch (
   }
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> void
+pcl::search::Search<PointT>::nearestKSearch (
+    const PointCloud& cloud, const std::vector<int>& indices, int k,
+    pcl::Neighborhoods &neighborhoods, unsigned int nr_threads) const
+{
+  const int nr_queries = static_cast<int> (indices.empty () ? cloud.size () : indices.size ());
+  pcl::detail::NearestKSearchFunctor<Search<PointT>, PointCloud> search (*this, cloud, indices, k);
+  pcl::detail::searchNeighborhoods (search, nr_queries, nr_threads, neighborhoods);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 template <typename PointT> int
 pcl::search::Search<PointT>::radiusSearch (
@@ -190,6 +201,21 @@ pcl::search::Search<PointT>::radiusSearch (
   }
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> void
+pcl::search::Search<PointT>::radiusSearch (
+    const PointCloud& cloud,
+    const std::vector<int>& indices,
+    double radius,
+    pcl::Neighborhoods &neighborhoods,
+    unsigned int max_nn,
+    unsigned int nr_threads) const
+{
+  const int nr_queries = static_cast<int> (indices.empty () ? cloud.size () : indices.size ());
+  pcl::detail::RadiusSearchFunctor<Search<PointT>, PointCloud> search (*this, cloud, indices, radius, max_nn);
+  pcl::detail::searchNeighborhoods (search, nr_queries, nr_threads, neighborhoods);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 template <typename PointT> void
 pcl::search::Search<PointT>::sortResults (
@@ -88,6 +88,8 @@ namespace pcl
         using pcl::search::Search<PointT>::input_;
         using pcl::search::Search<PointT>::indices_;
         using pcl::search::Search<PointT>::sorted_results_;
+        using pcl::search::Search<PointT>::nearestKSearch;
+        using pcl::search::Search<PointT>::radiusSearch;
 
         /** \brief Octree constructor.
           * \param[in] resolution octree resolution at lowest octree level
@@ -0,0 +1,137 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2014-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PCL_SEARCH_QUANTIZED_DESCRIPTORS_H_
+#define PCL_SEARCH_QUANTIZED_DESCRIPTORS_H_
+
+#include <pcl/search/kdtree.h>
+
+namespace pcl
+{
+  namespace search
+  {
+    /** \brief Exhaustive nearest neighbor search on the byte codes of quantized descriptors
+      * (pcl::QuantizedSHOT352 or pcl::QuantizedFPFHSignature33), see pcl::squaredDescriptorDistances ().
+      *
+      * It derives from search::KdTree so that it can be given to
+      * CorrespondenceEstimation::setSearchMethodTarget (), but does not build a kd-tree: every query
+      * is compared with every descriptor of the input cloud. This pays off for the libraries of up to a
+      * few thousand descriptors described in pcl::nearestDescriptors (). The distances are the squared
+      * Euclidean distances between the restored bins, descriptors with a non-finite bin are never
+      * returned. Ties are resolved towards the lower index, and the results are always sorted.
+      * \ingroup search
+      */
+    template<typename PointT>
+    class QuantizedDescriptorSearch : public KdTree<PointT>
+    {
+      public:
+        typedef typename Search<PointT>::PointCloudConstPtr PointCloudConstPtr;
+        typedef typename KdTree<PointT>::IndicesConstPtr IndicesConstPtr;
+
+        typedef boost::shared_ptr<QuantizedDescriptorSearch<PointT> > Ptr;
+        typedef boost::shared_ptr<const QuantizedDescriptorSearch<PointT> > ConstPtr;
+
+        using Search<PointT>::input_;
+        using Search<PointT>::indices_;
+        using Search<PointT>::name_;
+        using Search<PointT>::nearestKSearch;
+        using Search<PointT>::radiusSearch;
+
+        /** \brief Empty constructor. */
+        QuantizedDescriptorSearch () : KdTree<PointT> (true), code_norms_ ()
+        {
+          name_ = "QuantizedDescriptorSearch";
+        }
+
+        /** \brief Empty destructor. */
+        virtual
+        ~QuantizedDescriptorSearch ()
+        {
+        }
+
+        /** \brief Provide a pointer to the descriptors to search in.
+          * \param[in] cloud the const boost shared pointer to the descriptors
+          * \param[in] indices the indices of the descriptors to search in (all of them if NULL)
+          */
+        void
+        setInputCloud (const PointCloudConstPtr& cloud,
+                       const IndicesConstPtr& indices = IndicesConstPtr ());
+
+        /** \brief Search for the k nearest descriptors of the given query descriptor.
+          * \param[in] point the query descriptor
+          * \param[in] k the number of neighbors to search for
+          * \param[out] k_indices the resultant indices of the nearest descriptors
+          * \param[out] k_sqr_distances the resultant squared distances to the nearest descriptors
+          * \return the number of neighbors found, 0 if the query has a non-finite bin
+          */
+        int
+        nearestKSearch (const PointT &point, int k,
+                        std::vector<int> &k_indices,
+                        std::vector<float> &k_sqr_distances) const;
+
+        /** \brief Search for all the descriptors within a given distance of the query descriptor.
+          * \param[in] point the query descriptor
+          * \param[in] radius the largest Euclidean distance between the restored bins
+          * \param[out] k_indices the resultant indices of the descriptors found
+          * \param[out] k_sqr_distances the resultant squared distances to the descriptors found
+          * \param[in] max_nn if not 0, only the \a max_nn nearest descriptors are returned
+          * \return the number of neighbors found, 0 if the query has a non-finite bin
+          */
+        int
+        radiusSearch (const PointT& point, double radius,
+                      std::vector<int> &k_indices,
+                      std::vector<float> &k_sqr_distances,
+                      unsigned int max_nn = 0) const;
+
+      private:
+        /** \brief Compute the distances to the searched descriptors and keep the \a k nearest ones
+          * below \a max_sqr_distance, sorted.
+          */
+        int
+        scan (const PointT &point, size_t k, float max_sqr_distance,
+              std::vector<int> &k_indices, std::vector<float> &k_sqr_distances) const;
+
+        /** \brief The squared norms of the byte codes of input_, see pcl::squaredCodeNorms (). */
+        std::vector<uint32_t> code_norms_;
+    };
+  }
+}
+
+#ifdef PCL_NO_PRECOMPILE
+#include <pcl/search/impl/quantized_descriptors.hpp>
+#endif
+
+#endif    // PCL_SEARCH_QUANTIZED_DESCRIPTORS_H_
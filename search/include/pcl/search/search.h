@@ -40,6 +40,7 @@
 #define PCL_SEARCH_SEARCH_H_
 
 #include <pcl/point_cloud.h>
+#include <pcl/neighborhoods.h>
 #include <pcl/for_each_type.h>
 #include <pcl/common/concatenate.h>
 #include <pcl/common/copy_point.h>
@@ -219,6 +220,17 @@ namespace pcl
                         int k, std::vector< std::vector<int> >& k_indices,
                         std::vector< std::vector<float> >& k_sqr_distances) const;
 
+        /** \brief Search for the k-nearest neighbors of a batch of query points, using multiple threads.
+          * \param[in] cloud the point cloud data
+          * \param[in] indices the indices in \a cloud. If indices is empty, neighbors will be searched for all points.
+          * \param[in] k the number of neighbors to search for
+          * \param[out] neighborhoods the resultant neighbors of all query points, in the order of \a indices
+          * \param[in] nr_threads the number of threads to use (0 sets the value to the number of cores)
+          */
+        virtual void
+        nearestKSearch (const PointCloud& cloud, const std::vector<int>& indices,
+                        int k, pcl::Neighborhoods &neighborhoods, unsigned int nr_threads = 0) const;
+
         /** \brief Search for the k-nearest neighbors for the given query point. Use this method if the query points are of a different type than the points in the data set (e.g. PointXYZRGBA instead of PointXYZ).
           * \param[in] cloud the point cloud data
           * \param[in] indices a vector of point cloud indices to query for nearest neighbors
@@ -355,6 +367,24 @@ namespace pcl
                       std::vector< std::vector<float> > &k_sqr_distances,
                       unsigned int max_nn = 0) const;
 
+        /** \brief Search for all the nearest neighbors of a batch of query points in a given radius, using multiple threads.
+          * \param[in] cloud the point cloud data
+          * \param[in] indices the indices in \a cloud. If indices is empty, neighbors will be searched for all points.
+          * \param[in] radius the radius of the sphere bounding all of the query points' neighbors
+          * \param[out] neighborhoods the resultant neighbors of all query points, in the order of \a indices
+          * \param[in] max_nn if given, bounds the maximum returned neighbors to this value. If \a max_nn is set to
+          * 0 or to a number higher than the number of points in the input cloud, all neighbors in \a radius will be
+          * returned.
+          * \param[in] nr_threads the number of threads to use (0 sets the value to the number of cores)
+          */
+        virtual void
+        radiusSearch (const PointCloud& cloud,
+                      const std::vector<int>& indices,
+                      double radius,
+                      pcl::Neighborhoods &neighborhoods,
+                      unsigned int max_nn = 0,
+                      unsigned int nr_threads = 0) const;
+
         /** \brief Search for all the nearest neighbors of the query points in a given radius.
           * \param[in] cloud the point cloud data
           * \param[in] indices a vector of point cloud indices to query for nearest neighbors
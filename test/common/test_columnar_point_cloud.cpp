@@ -0,0 +1,234 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2014-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <pcl/point_types.h>
+#include <pcl/point_cloud.h>
+#include <pcl/conversions.h>
+#include <pcl/columnar_point_cloud.h>
+#include <pcl/common/common.h>
+#include <pcl/common/centroid.h>
+#include <pcl/common/transforms.h>
+
+using namespace pcl;
+
+PointCloud<PointXYZRGBNormal> cloud;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, ColumnarPointCloudConversion)
+{
+  ColumnarPointCloud columnar;
+  toColumnarPointCloud (cloud, columnar);
+
+  EXPECT_EQ (cloud.width, columnar.width);
+  EXPECT_EQ (cloud.height, columnar.height);
+  EXPECT_EQ (cloud.size (), columnar.size ());
+  EXPECT_TRUE (columnar.hasXYZ ());
+
+  const float *x = columnar.getColumn<float> ("x");
+  const float *normal_z = columnar.getColumn<float> ("normal_z");
+  ASSERT_TRUE (x != NULL);
+  ASSERT_TRUE (normal_z != NULL);
+  EXPECT_TRUE (columnar.getColumn<double> ("x") == NULL);
+  EXPECT_TRUE (columnar.getColumn<float> ("intensity") == NULL);
+  for (size_t i = 0; i < cloud.size (); ++i)
+  {
+    EXPECT_EQ (cloud[i].x, x[i]);
+    EXPECT_EQ (cloud[i].normal_z, normal_z[i]);
+  }
+
+  // Back to AoS
+  PointCloud<PointXYZRGBNormal> cloud_back;
+  fromColumnarPointCloud (columnar, cloud_back);
+  ASSERT_EQ (cloud.size (), cloud_back.size ());
+  for (size_t i = 0; i < cloud.size (); ++i)
+  {
+    EXPECT_EQ (cloud[i].x, cloud_back[i].x);
+    EXPECT_EQ (cloud[i].y, cloud_back[i].y);
+    EXPECT_EQ (cloud[i].z, cloud_back[i].z);
+    EXPECT_EQ (cloud[i].rgba, cloud_back[i].rgba);
+    EXPECT_EQ (cloud[i].normal_x, cloud_back[i].normal_x);
+    EXPECT_EQ (cloud[i].curvature, cloud_back[i].curvature);
+  }
+
+  // Only the fields that exist in both are copied
+  PointCloud<PointXYZ> cloud_xyz;
+  fromColumnarPointCloud (columnar, cloud_xyz);
+  ASSERT_EQ (cloud.size (), cloud_xyz.size ());
+  for (size_t i = 0; i < cloud.size (); ++i)
+    EXPECT_EQ (cloud[i].z, cloud_xyz[i].z);
+
+  // Through the binary blob
+  PCLPointCloud2 msg;
+  toPCLPointCloud2 (columnar, msg);
+  PointCloud<PointXYZRGBNormal> cloud_msg;
+  fromPCLPointCloud2 (msg, cloud_msg);
+  ASSERT_EQ (cloud.size (), cloud_msg.size ());
+  for (size_t i = 0; i < cloud.size (); ++i)
+  {
+    EXPECT_EQ (cloud[i].y, cloud_msg[i].y);
+    EXPECT_EQ (cloud[i].rgba, cloud_msg[i].rgba);
+    EXPECT_EQ (cloud[i].normal_y, cloud_msg[i].normal_y);
+  }
+
+  toPCLPointCloud2 (cloud, msg);
+  ColumnarPointCloud columnar_msg;
+  fromPCLPointCloud2 (msg, columnar_msg);
+  EXPECT_EQ (columnar.getFields ().size (), columnar_msg.getFields ().size ());
+  const float *curvature = columnar_msg.getColumn<float> ("curvature");
+  ASSERT_TRUE (curvature != NULL);
+  for (size_t i = 0; i < cloud.size (); ++i)
+    EXPECT_EQ (cloud[i].curvature, curvature[i]);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, ColumnarPointCloudKernels)
+{
+  for (int dense = 0; dense < 2; ++dense)
+  {
+    PointCloud<PointXYZRGBNormal> input = cloud;
+    input.is_dense = dense == 1;
+    if (!input.is_dense)
+      input[5].y = input[17].z = std::numeric_limits<float>::quiet_NaN ();
+
+    ColumnarPointCloud columnar;
+    toColumnarPointCloud (input, columnar);
+
+    Eigen::Vector4f min_aos, max_aos, min_soa, max_soa;
+    getMinMax3D (input, min_aos, max_aos);
+    getMinMax3D (columnar, min_soa, max_soa);
+    for (int d = 0; d < 4; ++d)
+    {
+      EXPECT_EQ (min_aos[d], min_soa[d]);
+      EXPECT_EQ (max_aos[d], max_soa[d]);
+    }
+
+    Eigen::Vector4f centroid_aos, centroid_soa;
+    EXPECT_EQ (compute3DCentroid (input, centroid_aos), compute3DCentroid (columnar, centroid_soa));
+    for (int d = 0; d < 4; ++d)
+      EXPECT_NEAR (centroid_aos[d], centroid_soa[d], 1e-4);
+
+    Eigen::Matrix3f covariance_aos, covariance_soa;
+    EXPECT_EQ (computeCovarianceMatrix (input, centroid_aos, covariance_aos),
+               computeCovarianceMatrix (columnar, centroid_aos, covariance_soa));
+    for (int r = 0; r < 3; ++r)
+      for (int c = 0; c < 3; ++c)
+        EXPECT_NEAR (covariance_aos (r, c), covariance_soa (r, c), 1e-2);
+
+    Eigen::Affine3f transform = Eigen::Translation3f (1.0f, -2.0f, 0.5f) *
+                                Eigen::AngleAxisf (0.3f, Eigen::Vector3f (1, 2, 3).normalized ());
+    PointCloud<PointXYZRGBNormal> transformed_aos;
+    transformPointCloud (input, transformed_aos, transform);
+    ColumnarPointCloud transformed_soa;
+    transformPointCloud (columnar, transformed_soa, transform);
+    PointCloud<PointXYZRGBNormal> transformed_back;
+    fromColumnarPointCloud (transformed_soa, transformed_back);
+    ASSERT_EQ (transformed_aos.size (), transformed_back.size ());
+    for (size_t i = 0; i < transformed_aos.size (); ++i)
+    {
+      if (!pcl_isfinite (transformed_aos[i].y) || !pcl_isfinite (transformed_aos[i].z))
+        continue;
+      EXPECT_NEAR (transformed_aos[i].x, transformed_back[i].x, 1e-4);
+      EXPECT_NEAR (transformed_aos[i].y, transformed_back[i].y, 1e-4);
+      EXPECT_NEAR (transformed_aos[i].z, transformed_back[i].z, 1e-4);
+      EXPECT_EQ (transformed_aos[i].rgba, transformed_back[i].rgba);
+    }
+
+    // In place, xyz only
+    ColumnarPointCloud xyz_only;
+    transformPointCloud (columnar, xyz_only, transform, false);
+    EXPECT_EQ (3, xyz_only.getFields ().size ());
+    transformPointCloud (columnar, columnar, transform);
+    const float *x = columnar.getColumn<float> ("x");
+    const float *x_only = xyz_only.getColumn<float> ("x");
+    for (size_t i = 0; i < columnar.size (); ++i)
+      EXPECT_EQ (x[i], x_only[i]);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, ColumnarPointCloudEmpty)
+{
+  PointCloud<PointXYZ> empty;
+  ColumnarPointCloud columnar;
+  toColumnarPointCloud (empty, columnar);
+  EXPECT_TRUE (columnar.empty ());
+  EXPECT_TRUE (columnar.hasXYZ ());
+
+  // Empty blob, the fields are kept
+  PCLPointCloud2 msg;
+  toPCLPointCloud2 (columnar, msg);
+  EXPECT_TRUE (msg.data.empty ());
+  ColumnarPointCloud columnar_back;
+  fromPCLPointCloud2 (msg, columnar_back);
+  EXPECT_TRUE (columnar_back.empty ());
+  EXPECT_TRUE (columnar_back.hasXYZ ());
+
+  ColumnarPointCloud transformed;
+  transformPointCloud (columnar_back, transformed, Eigen::Affine3f::Identity ());
+  EXPECT_TRUE (transformed.empty ());
+  EXPECT_TRUE (transformed.hasXYZ ());
+
+  Eigen::Vector4f centroid;
+  EXPECT_EQ (0, compute3DCentroid (columnar_back, centroid));
+}
+
+/* ---[ */
+int
+main (int argc, char** argv)
+{
+  cloud.width = 64;
+  cloud.height = 32;
+  cloud.is_dense = true;
+  cloud.resize (cloud.width * cloud.height);
+  srand (42);
+  for (size_t i = 0; i < cloud.size (); ++i)
+  {
+    cloud[i].x = static_cast<float> (rand ()) / RAND_MAX * 10.0f - 5.0f;
+    cloud[i].y = static_cast<float> (rand ()) / RAND_MAX * 4.0f;
+    cloud[i].z = static_cast<float> (rand ()) / RAND_MAX * 2.0f + 1.0f;
+    cloud[i].rgba = static_cast<uint32_t> (rand ());
+    cloud[i].normal_x = static_cast<float> (rand ()) / RAND_MAX;
+    cloud[i].normal_y = static_cast<float> (rand ()) / RAND_MAX;
+    cloud[i].normal_z = static_cast<float> (rand ()) / RAND_MAX;
+    cloud[i].curvature = static_cast<float> (i);
+  }
+
+  testing::InitGoogleTest (&argc, argv);
+  return (RUN_ALL_TESTS ());
+}
+/* ]--- */
@@ -42,6 +42,8 @@
 #include <pcl/point_types.h>
 #include <pcl/point_cloud.h>
 #include <pcl/point_types_conversion.h>
+#include <pcl/point_representation.h>
+#include <pcl/common/quantized_descriptors.h>
 #include <iomanip>
 #include <iostream>
 
@@ -85,6 +87,208 @@ TEST (PointTypeConversions, PointXYZRGBtoPointXYZHSV)
   EXPECT_NEAR (hsv.v, 0.980392, 1e-2);
 }
 
+TEST (PointTypeConversions, FPFHSignature33toQuantizedFPFHSignature33)
+{
+  const float step = 1.0f / pcl::QuantizedFPFHSignature33::quantizationScale ();
+
+  pcl::FPFHSignature33 fpfh, restored;
+  for (int i = 0; i < 33; ++i)
+    fpfh.histogram[i] = 100.0f * static_cast<float> (i) / 32.0f;
+  fpfh.histogram[5] = 33.3333f;
+  fpfh.histogram[6] = 150.0f;
+  fpfh.histogram[7] = -1.0f;
+  fpfh.histogram[8] = std::numeric_limits<float>::quiet_NaN ();
+
+  pcl::QuantizedFPFHSignature33 quantized;
+  pcl::FPFHSignature33toQuantizedFPFHSignature33 (fpfh, quantized);
+  pcl::QuantizedFPFHSignature33toFPFHSignature33 (quantized, restored);
+
+  EXPECT_EQ (quantized.histogram[0], 0);
+  EXPECT_EQ (quantized.histogram[32], 254);
+  // Out of range bins are clamped, non-finite bins stay non-finite
+  EXPECT_EQ (quantized.histogram[6], 254);
+  EXPECT_EQ (quantized.histogram[7], 0);
+  EXPECT_EQ (quantized.histogram[8], 255);
+  EXPECT_TRUE (pcl_isnan (restored.histogram[8]));
+  for (int i = 0; i < 33; ++i)
+  {
+    if (i >= 6 && i <= 8)
+      continue;
+    EXPECT_NEAR (restored.histogram[i], fpfh.histogram[i], 0.5f * step + 1e-4f);
+  }
+}
+
+TEST (PointTypeConversions, SHOT352toQuantizedSHOT352)
+{
+  pcl::PointCloud<pcl::SHOT352> shots, restored;
+  shots.width = 2;
+  shots.height = 3;
+  shots.is_dense = false;
+  shots.header.frame_id = "shots";
+  shots.points.resize (6);
+  for (size_t p = 0; p < shots.points.size (); ++p)
+  {
+    for (int i = 0; i < 352; ++i)
+      shots.points[p].descriptor[i] = static_cast<float> ((i * 7 + p * 13) % 353) / 352.0f;
+    for (int i = 0; i < 9; ++i)
+      shots.points[p].rf[i] = static_cast<float> (p) - static_cast<float> (i) * 0.25f;
+  }
+  shots.points[4].descriptor[10] = std::numeric_limits<float>::quiet_NaN ();
+  // A descriptor with small bins keeps its resolution
+  for (int i = 0; i < 352; ++i)
+    shots.points[5].descriptor[i] *= 0.01f;
+
+  pcl::PointCloud<pcl::QuantizedSHOT352> quantized;
+  pcl::PointCloudSHOT352toQuantizedSHOT352 (shots, quantized);
+  pcl::PointCloudQuantizedSHOT352toSHOT352 (quantized, restored);
+
+  EXPECT_EQ (quantized.width, shots.width);
+  EXPECT_EQ (quantized.height, shots.height);
+  EXPECT_EQ (quantized.is_dense, shots.is_dense);
+  EXPECT_EQ (quantized.header.frame_id, shots.header.frame_id);
+  ASSERT_EQ (restored.points.size (), shots.points.size ());
+  for (size_t p = 0; p < shots.points.size (); ++p)
+  {
+    float max_bin = 0.0f;
+    for (int i = 0; i < 352; ++i)
+      if (pcl_isfinite (shots.points[p].descriptor[i]))
+        max_bin = std::max (max_bin, shots.points[p].descriptor[i]);
+    EXPECT_EQ (quantized.points[p].scale, max_bin);
+    const float step = max_bin / static_cast<float> (pcl::QuantizedSHOT352::maxCode ());
+    for (int i = 0; i < 352; ++i)
+    {
+      if (p == 4 && i == 10)
+        EXPECT_TRUE (pcl_isnan (restored.points[p].descriptor[i]));
+      else
+        EXPECT_NEAR (restored.points[p].descriptor[i], shots.points[p].descriptor[i], 0.5f * step + 1e-6f * max_bin);
+    }
+    for (int i = 0; i < 9; ++i)
+    {
+      EXPECT_EQ (quantized.points[p].rf[i], shots.points[p].rf[i]);
+      EXPECT_EQ (restored.points[p].rf[i], shots.points[p].rf[i]);
+    }
+  }
+
+  // An all zero descriptor stays zero
+  pcl::SHOT352 zero;
+  pcl::QuantizedSHOT352 quantized_zero;
+  for (int i = 0; i < 352; ++i)
+    zero.descriptor[i] = 0.0f;
+  pcl::SHOT352toQuantizedSHOT352 (zero, quantized_zero);
+  pcl::QuantizedSHOT352toSHOT352 (quantized_zero, zero);
+  EXPECT_EQ (quantized_zero.scale, 0.0f);
+  for (int i = 0; i < 352; ++i)
+    EXPECT_EQ (zero.descriptor[i], 0.0f);
+
+  // The default representation restores the bins and rejects the ones that were not finite
+  pcl::DefaultPointRepresentation<pcl::QuantizedSHOT352> representation;
+  ASSERT_EQ (representation.getNumberOfDimensions (), 352);
+  float vector[352];
+  representation.vectorize (quantized.points[0], vector);
+  for (int i = 0; i < 352; ++i)
+    EXPECT_EQ (vector[i], restored.points[0].descriptor[i]);
+  EXPECT_TRUE (representation.isValid (quantized.points[0]));
+  EXPECT_FALSE (representation.isValid (quantized.points[4]));
+}
+
+/** \brief Squared distance between the restored bins of two quantized descriptors. */
+template <typename PointT> float
+restoredSquaredDistance (const PointT &a, const PointT &b)
+{
+  pcl::DefaultPointRepresentation<PointT> representation;
+  const int size = representation.getNumberOfDimensions ();
+  std::vector<float> va (size), vb (size);
+  representation.vectorize (a, va);
+  representation.vectorize (b, vb);
+  float distance = 0.0f;
+  for (int i = 0; i < size; ++i)
+    distance += (va[i] - vb[i]) * (va[i] - vb[i]);
+  return (distance);
+}
+
+TEST (PointTypeConversions, QuantizedDescriptorDistances)
+{
+  // Sparse histograms of varying magnitude, like the ones of real surfaces
+  const int nr_targets = 150, nr_queries = 60;
+  pcl::PointCloud<pcl::SHOT352> shots (nr_targets + nr_queries, 1);
+  pcl::PointCloud<pcl::FPFHSignature33> fpfhs (nr_targets + nr_queries, 1);
+  srand (0);
+  for (int p = 0; p < nr_targets + nr_queries; ++p)
+  {
+    const float magnitude = 0.2f + static_cast<float> (p % 7) * 0.1f;
+    for (int i = 0; i < 352; ++i)
+    {
+      const float r = static_cast<float> (rand ()) / static_cast<float> (RAND_MAX);
+      shots.points[p].descriptor[i] = r > 0.7f ? magnitude * (r - 0.7f) : 0.0f;
+    }
+    for (int i = 0; i < 33; ++i)
+      fpfhs.points[p].histogram[i] = 100.0f * static_cast<float> (rand ()) / static_cast<float> (RAND_MAX);
+  }
+  // Invalid descriptors are skipped as targets and give no match as queries
+  shots.points[3].descriptor[100] = std::numeric_limits<float>::quiet_NaN ();
+  shots.points[nr_targets + 5].descriptor[0] = std::numeric_limits<float>::quiet_NaN ();
+  fpfhs.points[3].histogram[32] = std::numeric_limits<float>::quiet_NaN ();
+
+  pcl::PointCloud<pcl::QuantizedSHOT352> quantized_shots;
+  pcl::PointCloud<pcl::QuantizedFPFHSignature33> quantized_fpfhs;
+  pcl::PointCloudSHOT352toQuantizedSHOT352 (shots, quantized_shots);
+  pcl::PointCloudFPFHSignature33toQuantizedFPFHSignature33 (fpfhs, quantized_fpfhs);
+
+  // The byte level distances match the ones between the restored bins
+  for (int p = 1; p < nr_targets; ++p)
+  {
+    const float shot_distance = restoredSquaredDistance (quantized_shots.points[0], quantized_shots.points[p]);
+    const float fpfh_distance = restoredSquaredDistance (quantized_fpfhs.points[0], quantized_fpfhs.points[p]);
+    if (p == 3)
+    {
+      EXPECT_TRUE (pcl_isnan (pcl::squaredDescriptorDistance (quantized_shots.points[0], quantized_shots.points[p])));
+      EXPECT_TRUE (pcl_isnan (pcl::squaredDescriptorDistance (quantized_fpfhs.points[0], quantized_fpfhs.points[p])));
+      continue;
+    }
+    EXPECT_NEAR (pcl::squaredDescriptorDistance (quantized_shots.points[0], quantized_shots.points[p]),
+                 shot_distance, 1e-5f * shot_distance + 1e-7f);
+    EXPECT_NEAR (pcl::squaredDescriptorDistance (quantized_fpfhs.points[0], quantized_fpfhs.points[p]),
+                 fpfh_distance, 1e-5f * fpfh_distance + 1e-4f);
+  }
+  EXPECT_EQ (pcl::squaredDescriptorDistance (quantized_shots.points[1], quantized_shots.points[1]), 0.0f);
+
+  pcl::PointCloud<pcl::QuantizedSHOT352> shot_targets, shot_queries;
+  shot_targets.points.assign (quantized_shots.points.begin (), quantized_shots.points.begin () + nr_targets);
+  shot_queries.points.assign (quantized_shots.points.begin () + nr_targets, quantized_shots.points.end ());
+  pcl::PointCloud<pcl::QuantizedFPFHSignature33> fpfh_targets, fpfh_queries;
+  fpfh_targets.points.assign (quantized_fpfhs.points.begin (), quantized_fpfhs.points.begin () + nr_targets);
+  fpfh_queries.points.assign (quantized_fpfhs.points.begin () + nr_targets, quantized_fpfhs.points.end ());
+
+  // The brute force search finds the same neighbors as a search on the restored bins, for any thread count
+  for (unsigned int threads = 1; threads <= 4; threads += 3)
+  {
+    std::vector<int> shot_indices, fpfh_indices;
+    std::vector<float> shot_distances, fpfh_distances;
+    pcl::nearestDescriptors (shot_queries, shot_targets, shot_indices, shot_distances, threads);
+    pcl::nearestDescriptors (fpfh_queries, fpfh_targets, fpfh_indices, fpfh_distances, threads);
+    ASSERT_EQ (shot_indices.size (), shot_queries.points.size ());
+    ASSERT_EQ (fpfh_indices.size (), fpfh_queries.points.size ());
+
+    EXPECT_EQ (shot_indices[5], -1);
+    for (int q = 0; q < nr_queries; ++q)
+    {
+      float nearest_shot = std::numeric_limits<float>::max (), nearest_fpfh = std::numeric_limits<float>::max ();
+      for (int p = 0; p < nr_targets; ++p)
+      {
+        if (p == 3)
+          continue;
+        nearest_shot = std::min (nearest_shot, restoredSquaredDistance (shot_queries.points[q], shot_targets.points[p]));
+        nearest_fpfh = std::min (nearest_fpfh, restoredSquaredDistance (fpfh_queries.points[q], fpfh_targets.points[p]));
+      }
+      EXPECT_NE (shot_indices[q], 3);
+      EXPECT_NE (fpfh_indices[q], 3);
+      if (q != 5)
+        EXPECT_NEAR (shot_distances[q], nearest_shot, 1e-5f * nearest_shot + 1e-7f);
+      EXPECT_NEAR (fpfh_distances[q], nearest_fpfh, 1e-5f * nearest_fpfh + 1e-4f);
+    }
+  }
+}
+
 int
 main (int argc, char** argv)
 {
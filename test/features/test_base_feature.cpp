@@ -40,6 +40,8 @@
 #include <gtest/gtest.h>
 #include <pcl/point_cloud.h>
 #include <pcl/features/feature.h>
+#include <pcl/features/impl/feature.hpp>
+#include <pcl/exceptions.h>
 #include <pcl/io/pcd_io.h>
 #include <pcl/common/centroid.h>
 
@@ -152,6 +154,58 @@ TEST (PCL, BaseFeature)
   EXPECT_NEAR (curvature, 0.0693136, 1e-4);
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/** \brief A feature that copies the curvature of its input and throws for points with a negative x. */
+class ThrowingFeature : public Feature<PointXYZ, Normal>
+{
+  public:
+    ThrowingFeature () { feature_name_ = "ThrowingFeature"; }
+
+  protected:
+    bool
+    computePointFeature (size_t index, std::vector<int> &, std::vector<float> &, Normal &output) const
+    {
+      const PointXYZ &point = input_->points[(*indices_)[index]];
+      if (point.x < 0)
+        throw BadArgumentException ("negative x", __FILE__, "computePointFeature", __LINE__);
+      output.curvature = point.x;
+      return (true);
+    }
+
+    void
+    computeFeature (PointCloudOut &output)
+    {
+      output.is_dense = computeFeatureForAllIndices (output);
+    }
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, BaseFeatureWorkerException)
+{
+  PointCloud<PointXYZ>::Ptr points (new PointCloud<PointXYZ> (cloud));
+  ThrowingFeature f;
+  f.setInputCloud (points);
+  f.setSearchMethod (tree);
+  f.setKSearch (1);
+
+  for (unsigned int nr_threads = 1; nr_threads <= 4; nr_threads += 3)
+  {
+    f.setNumberOfThreads (nr_threads);
+
+    // Without failures every point is estimated
+    for (size_t i = 0; i < points->size (); ++i)
+      points->points[i].x = static_cast<float> (i);
+    PointCloud<Normal> output;
+    f.compute (output);
+    ASSERT_EQ (output.size (), points->size ());
+    EXPECT_EQ (output.points[points->size () - 1].curvature, static_cast<float> (points->size () - 1));
+
+    // The exception reaches the caller with its original type, whichever thread threw it
+    points->points[points->size () / 2].x = -1.0f;
+    EXPECT_THROW (f.compute (output), BadArgumentException);
+  }
+}
+
 /* ---[ */
 int
 main (int argc, char** argv)
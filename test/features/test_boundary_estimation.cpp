@@ -130,6 +130,36 @@ TEST (PCL, BoundaryEstimation)
   EXPECT_EQ (pt, true);
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, BoundaryEstimationMultiThreaded)
+{
+  // Estimate normals first
+  NormalEstimation<PointXYZ, Normal> n;
+  PointCloud<Normal>::Ptr normals (new PointCloud<Normal> ());
+  n.setInputCloud (cloud.makeShared ());
+  n.setSearchMethod (tree);
+  n.setKSearch (10);
+  n.compute (*normals);
+
+  BoundaryEstimation<PointXYZ, Normal, Boundary> b;
+  b.setInputCloud (cloud.makeShared ());
+  b.setInputNormals (normals);
+  b.setSearchMethod (tree);
+  b.setKSearch (10);
+
+  PointCloud<Boundary> bps_serial, bps_parallel;
+  b.compute (bps_serial);
+
+  b.setNumberOfThreads (4);
+  b.compute (bps_parallel);
+
+  // Every point is estimated independently, so the results must not depend on the number of threads
+  ASSERT_EQ (bps_serial.points.size (), bps_parallel.points.size ());
+  EXPECT_EQ (bps_serial.is_dense, bps_parallel.is_dense);
+  for (size_t i = 0; i < bps_serial.points.size (); ++i)
+    EXPECT_EQ (bps_serial.points[i].boundary_point, bps_parallel.points[i].boundary_point);
+}
+
 /* ---[ */
 int
 main (int argc, char** argv)
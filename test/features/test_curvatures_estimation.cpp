@@ -143,6 +143,43 @@ TEST (PCL, PrincipalCurvaturesEstimation)
   EXPECT_NEAR (pcs->points[indices.size () - 1].pc2, 0.17906941473484039, 1e-4);
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, PrincipalCurvaturesEstimationMultiThreaded)
+{
+  // Estimate normals first
+  NormalEstimation<PointXYZ, Normal> n;
+  PointCloud<Normal>::Ptr normals (new PointCloud<Normal> ());
+  n.setInputCloud (cloud.makeShared ());
+  n.setSearchMethod (tree);
+  n.setKSearch (10);
+  n.compute (*normals);
+
+  PrincipalCurvaturesEstimation<PointXYZ, Normal, PrincipalCurvatures> pc;
+  EXPECT_EQ (pc.getNumberOfThreads (), 1);
+  pc.setInputCloud (cloud.makeShared ());
+  pc.setInputNormals (normals);
+  pc.setSearchMethod (tree);
+  pc.setKSearch (10);
+
+  PointCloud<PrincipalCurvatures> pcs_serial, pcs_parallel;
+  pc.compute (pcs_serial);
+
+  pc.setNumberOfThreads (4);
+  pc.compute (pcs_parallel);
+
+  // Every point is estimated independently, so the results must not depend on the number of threads
+  ASSERT_EQ (pcs_serial.points.size (), pcs_parallel.points.size ());
+  EXPECT_EQ (pcs_serial.is_dense, pcs_parallel.is_dense);
+  for (size_t i = 0; i < pcs_serial.points.size (); ++i)
+  {
+    EXPECT_EQ (pcs_serial.points[i].principal_curvature[0], pcs_parallel.points[i].principal_curvature[0]);
+    EXPECT_EQ (pcs_serial.points[i].principal_curvature[1], pcs_parallel.points[i].principal_curvature[1]);
+    EXPECT_EQ (pcs_serial.points[i].principal_curvature[2], pcs_parallel.points[i].principal_curvature[2]);
+    EXPECT_EQ (pcs_serial.points[i].pc1, pcs_parallel.points[i].pc1);
+    EXPECT_EQ (pcs_serial.points[i].pc2, pcs_parallel.points[i].pc2);
+  }
+}
+
 /* ---[ */
 int
 main (int argc, char** argv)
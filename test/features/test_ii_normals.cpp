@@ -490,6 +490,78 @@ TEST (PCL, IINormalEstimationSimple3DGradient)
   }
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, IINormalEstimationMultiThreaded)
+{
+  // A curved surface with a hole, so that the border handling and the depth changes come into play
+  PointCloud<PointXYZ>::Ptr surface (new PointCloud<PointXYZ>);
+  surface->width = 160;
+  surface->height = 120;
+  surface->points.resize (surface->width * surface->height);
+  surface->is_dense = false;
+  for (size_t v = 0; v < surface->height; ++v)
+  {
+    for (size_t u = 0; u < surface->width; ++u)
+    {
+      PointXYZ &p = (*surface) (u, v);
+      p.x = static_cast<float> (u) * 0.01f;
+      p.y = static_cast<float> (v) * 0.01f;
+      p.z = 2.0f + 0.1f * sinf (static_cast<float> (u) * 0.1f) * cosf (static_cast<float> (v) * 0.07f);
+      if (u > 40 && u < 50 && v > 30 && v < 45)
+        p.x = p.y = p.z = std::numeric_limits<float>::quiet_NaN ();
+    }
+  }
+
+  // Every other point, to go through computeFeaturePart as well
+  IndicesPtr indices (new std::vector<int>);
+  for (int i = 0; i < static_cast<int> (surface->points.size ()); i += 2)
+    indices->push_back (i);
+
+  const IntegralImageNormalEstimation<PointXYZ, Normal>::NormalEstimationMethod methods[] =
+    { ne.COVARIANCE_MATRIX, ne.AVERAGE_3D_GRADIENT, ne.AVERAGE_DEPTH_CHANGE, ne.SIMPLE_3D_GRADIENT };
+  const IntegralImageNormalEstimation<PointXYZ, Normal>::BorderPolicy policies[] =
+    { ne.BORDER_POLICY_IGNORE, ne.BORDER_POLICY_MIRROR };
+
+  for (int m = 0; m < 4; ++m)
+  {
+    for (int b = 0; b < 2; ++b)
+    {
+      if (methods[m] == ne.SIMPLE_3D_GRADIENT && policies[b] == ne.BORDER_POLICY_MIRROR)
+        continue;
+      for (int part = 0; part < 2; ++part)
+      {
+        PointCloud<Normal> output[2];
+        for (int run = 0; run < 2; ++run)
+        {
+          IntegralImageNormalEstimation<PointXYZ, Normal> estimation;
+          estimation.setNumberOfThreads (run == 0 ? 1 : 4);
+          estimation.setNormalEstimationMethod (methods[m]);
+          estimation.setBorderPolicy (policies[b]);
+          estimation.setNormalSmoothingSize (8.0f);
+          estimation.setDepthDependentSmoothing (part == 1);
+          estimation.setInputCloud (surface);
+          if (part == 1)
+            estimation.setIndices (indices);
+          estimation.compute (output[run]);
+        }
+
+        // Neither the integral images nor the normals depend on the number of threads
+        ASSERT_EQ (output[0].points.size (), output[1].points.size ());
+        for (size_t i = 0; i < output[0].points.size (); ++i)
+        {
+          const Normal &n1 = output[0].points[i], &n2 = output[1].points[i];
+          EXPECT_EQ (pcl_isfinite (n1.normal_x), pcl_isfinite (n2.normal_x));
+          if (!pcl_isfinite (n1.normal_x) || !pcl_isfinite (n2.normal_x))
+            continue;
+          EXPECT_EQ (n1.normal_x, n2.normal_x);
+          EXPECT_EQ (n1.normal_y, n2.normal_y);
+          EXPECT_EQ (n1.normal_z, n2.normal_z);
+        }
+      }
+    }
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 TEST (PCL, IINormalEstimationSimple3DGradientUnorganized)
 {
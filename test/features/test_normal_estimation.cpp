@@ -90,6 +90,92 @@ TEST (PCL, computePointNormal)
 //  cerr << plane_parameters << "\n";
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, computePointNormalBatch)
+{
+  // Neighborhoods of varying size, including degenerate ones, so that the batches have uneven lanes
+  vector<vector<int> > neighborhoods;
+  for (size_t i = 0; i < 23; ++i)
+  {
+    vector<int> nn_indices;
+    vector<float> nn_dists;
+    tree->nearestKSearch (static_cast<int> (i), 2 + static_cast<int> (i % 9), nn_indices, nn_dists);
+    neighborhoods.push_back (nn_indices);
+  }
+  neighborhoods.push_back (vector<int> ());
+
+  vector<Eigen::Vector4f, Eigen::aligned_allocator<Eigen::Vector4f> > plane_parameters;
+  vector<float> curvatures;
+  computePointNormal (cloud, neighborhoods, plane_parameters, curvatures);
+  ASSERT_EQ (plane_parameters.size (), neighborhoods.size ());
+  ASSERT_EQ (curvatures.size (), neighborhoods.size ());
+
+  // Every neighborhood must match the single neighborhood plane fit
+  for (size_t i = 0; i < neighborhoods.size (); ++i)
+  {
+    Eigen::Vector4f expected;
+    float expected_curvature;
+    computePointNormal (cloud, neighborhoods[i], expected, expected_curvature);
+    if (!pcl_isfinite (expected_curvature))
+    {
+      EXPECT_FALSE (pcl_isfinite (curvatures[i]));
+      continue;
+    }
+    for (int d = 0; d < 4; ++d)
+      EXPECT_NEAR (plane_parameters[i][d], expected[d], 1e-5);
+    EXPECT_NEAR (curvatures[i], expected_curvature, 1e-5);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, computePointNormalBatchNonDense)
+{
+  // NaN neighbors must be skipped, lanes left without finite neighbors must have no plane
+  PointCloud<PointXYZ> nan_cloud = cloud;
+  nan_cloud.is_dense = false;
+  for (size_t i = 0; i < nan_cloud.size (); i += 3)
+    nan_cloud[i].x = nan_cloud[i].y = nan_cloud[i].z = std::numeric_limits<float>::quiet_NaN ();
+
+  vector<vector<int> > neighborhoods;
+  for (size_t i = 0; i < 37; ++i)
+  {
+    vector<int> nn_indices;
+    vector<float> nn_dists;
+    tree->nearestKSearch (static_cast<int> (i), 3 + static_cast<int> (i % 11), nn_indices, nn_dists);
+    neighborhoods.push_back (nn_indices);
+  }
+  // Only NaN points
+  neighborhoods.push_back (vector<int> (4, 0));
+  neighborhoods.push_back (vector<int> ());
+  neighborhoods[5].push_back (3);
+
+  vector<Eigen::Vector4f, Eigen::aligned_allocator<Eigen::Vector4f> > plane_parameters;
+  vector<float> curvatures;
+  computePointNormal (nan_cloud, neighborhoods, plane_parameters, curvatures);
+  ASSERT_EQ (plane_parameters.size (), neighborhoods.size ());
+
+  for (size_t i = 0; i < neighborhoods.size (); ++i)
+  {
+    Eigen::Vector4f expected;
+    float expected_curvature;
+    computePointNormal (nan_cloud, neighborhoods[i], expected, expected_curvature);
+    if (!pcl_isfinite (expected_curvature))
+    {
+      EXPECT_FALSE (pcl_isfinite (curvatures[i]));
+      continue;
+    }
+    for (int d = 0; d < 4; ++d)
+    {
+      // Two finite points leave the plane undefined while the curvature is still computed
+      if (!pcl_isfinite (expected[d]))
+        EXPECT_FALSE (pcl_isfinite (plane_parameters[i][d]));
+      else
+        EXPECT_NEAR (plane_parameters[i][d], expected[d], 1e-5);
+    }
+    EXPECT_NEAR (curvatures[i], expected_curvature, 1e-5);
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 TEST (PCL, NormalEstimation)
 {
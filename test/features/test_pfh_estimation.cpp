@@ -262,6 +262,118 @@ TEST (PCL, PFHEstimation)
   (cloud.makeShared (), normals, test_indices, 125);
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, PFHEstimationCacheMultiThreaded)
+{
+  // Estimate normals first
+  NormalEstimation<PointXYZ, Normal> n;
+  PointCloud<Normal>::Ptr normals (new PointCloud<Normal> ());
+  n.setInputCloud (cloud.makeShared ());
+  n.setSearchMethod (tree);
+  n.setKSearch (10);
+  n.compute (*normals);
+
+  PFHEstimation<PointXYZ, Normal, PFHSignature125> pfh;
+  pfh.setInputCloud (cloud.makeShared ());
+  pfh.setInputNormals (normals);
+  pfh.setSearchMethod (tree);
+  pfh.setKSearch (10);
+
+  // Reference without the cache, on a single thread
+  PointCloud<PFHSignature125> reference, cached;
+  pfh.compute (reference);
+  EXPECT_EQ (pfh.getCacheHits (), 0);
+  EXPECT_EQ (pfh.getCacheMisses (), 0);
+
+  // Overlapping neighborhoods share most of their pairs, the cache must be hit
+  pfh.setUseInternalCache (true);
+  pfh.setNumberOfThreads (4);
+  pfh.compute (cached);
+  EXPECT_GT (pfh.getCacheHits (), 0);
+  EXPECT_GT (pfh.getCacheMisses (), 0);
+  EXPECT_GT (pfh.getCacheHitRate (), 0.0);
+  EXPECT_LT (pfh.getCacheHitRate (), 1.0);
+
+  ASSERT_EQ (reference.points.size (), cached.points.size ());
+  for (size_t i = 0; i < reference.points.size (); ++i)
+    for (int d = 0; d < 125; ++d)
+      ASSERT_EQ (reference.points[i].histogram[d], cached.points[i].histogram[d]);
+
+  // A cache that is too small to hold a neighborhood must not change the result either
+  pfh.setMaximumCacheSize (16);
+  pfh.compute (cached);
+  for (size_t i = 0; i < reference.points.size (); ++i)
+    for (int d = 0; d < 125; ++d)
+      ASSERT_EQ (reference.points[i].histogram[d], cached.points[i].histogram[d]);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, PairFeatureCache)
+{
+  typedef PairFeatureCache<Eigen::Vector4f> Cache;
+  const Eigen::Vector4f f (1.0f, 2.0f, 3.0f, 4.0f);
+  Eigen::Vector4f g;
+
+  // A single stripe evicts the oldest pairs first
+  Cache fifo (4, 1);
+  for (int i = 0; i < 6; ++i)
+    fifo.insert (Cache::Key (i, i + 1), f * static_cast<float> (i));
+  EXPECT_EQ (fifo.size (), 4);
+  EXPECT_FALSE (fifo.find (Cache::Key (0, 1), g));
+  EXPECT_FALSE (fifo.find (Cache::Key (1, 2), g));
+  EXPECT_TRUE (fifo.find (Cache::Key (2, 3), g));
+  EXPECT_EQ (g, f * 2.0f);
+  EXPECT_TRUE (fifo.find (Cache::Key (5, 6), g));
+  EXPECT_EQ (g, f * 5.0f);
+  // Pairs are ordered
+  EXPECT_FALSE (fifo.find (Cache::Key (6, 5), g));
+
+  // Statistics
+  EXPECT_EQ (fifo.getHits (), 2);
+  EXPECT_EQ (fifo.getMisses (), 3);
+  EXPECT_DOUBLE_EQ (fifo.getHitRate (), 0.4);
+
+  // Inserting a cached pair again keeps the first feature
+  fifo.insert (Cache::Key (5, 6), f);
+  EXPECT_EQ (fifo.size (), 4);
+  EXPECT_TRUE (fifo.find (Cache::Key (5, 6), g));
+  EXPECT_EQ (g, f * 5.0f);
+
+  fifo.clear ();
+  EXPECT_EQ (fifo.size (), 0);
+  EXPECT_EQ (fifo.getHits (), 0);
+  EXPECT_EQ (fifo.getMisses (), 0);
+  EXPECT_EQ (fifo.getHitRate (), 0.0);
+
+  // More stripes than allowed pairs: the limit still holds
+  Cache striped (16, 64);
+  for (int i = 0; i < 1000; ++i)
+    striped.insert (Cache::Key (i, 2 * i), f);
+  EXPECT_GT (striped.size (), 0);
+  EXPECT_LE (striped.size (), 16);
+
+  striped.setMaximumSize (2);
+  for (int i = 0; i < 1000; ++i)
+    striped.insert (Cache::Key (i, 2 * i), f);
+  EXPECT_GT (striped.size (), 0);
+  EXPECT_LE (striped.size (), 2);
+
+  striped.setMaximumSize (0);
+  striped.clear ();
+  striped.insert (Cache::Key (0, 1), f);
+  EXPECT_EQ (striped.size (), 0);
+
+  // Copies keep the limits but not the pairs
+  fifo.insert (Cache::Key (0, 1), f);
+  Cache copy (fifo);
+  EXPECT_EQ (copy.getMaximumSize (), 4);
+  EXPECT_EQ (copy.size (), 0);
+  Cache assigned;
+  assigned = fifo;
+  EXPECT_EQ (assigned.getMaximumSize (), 4);
+  EXPECT_EQ (assigned.size (), 0);
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 TEST (PCL, FPFHEstimation)
 {
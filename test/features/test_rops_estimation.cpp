@@ -117,6 +117,39 @@ TEST (ROPSFeature, InvalidParameters)
   EXPECT_EQ (0, histograms->points.size ());
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (ROPSFeature, MultiThreaded)
+{
+  float support_radius = 0.0285f;
+
+  pcl::search::KdTree<pcl::PointXYZ>::Ptr search_method (new pcl::search::KdTree<pcl::PointXYZ>);
+  search_method->setInputCloud (cloud);
+
+  pcl::ROPSEstimation <pcl::PointXYZ, pcl::Histogram <135> > feature_estimator;
+  feature_estimator.setSearchMethod (search_method);
+  feature_estimator.setSearchSurface (cloud);
+  feature_estimator.setInputCloud (cloud);
+  feature_estimator.setIndices (indices);
+  feature_estimator.setTriangles (triangles);
+  feature_estimator.setRadiusSearch (support_radius);
+  feature_estimator.setNumberOfPartitionBins (5);
+  feature_estimator.setNumberOfRotations (3);
+  feature_estimator.setSupportRadius (support_radius);
+
+  pcl::PointCloud<pcl::Histogram <135> > histograms_serial, histograms_parallel;
+  feature_estimator.compute (histograms_serial);
+
+  feature_estimator.setNumberOfThreads (4);
+  feature_estimator.compute (histograms_parallel);
+
+  // Every point is estimated independently, so the results must not depend on the number of threads
+  ASSERT_EQ (histograms_serial.points.size (), histograms_parallel.points.size ());
+  EXPECT_NE (0, histograms_serial.points.size ());
+  for (size_t i = 0; i < histograms_serial.points.size (); ++i)
+    for (int j = 0; j < 135; ++j)
+      ASSERT_EQ (histograms_serial.points[i].histogram[j], histograms_parallel.points[i].histogram[j]);
+}
+
 /* ---[ */
 int
 main (int argc, char** argv)
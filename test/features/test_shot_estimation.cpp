@@ -46,6 +46,8 @@
 #include "pcl/features/shot_lrf.h"
 #include <pcl/features/3dsc.h>
 #include <pcl/features/usc.h>
+#include <pcl/point_types_conversion.h>
+#include <pcl/common/quantized_descriptors.h>
 
 using namespace pcl;
 using namespace pcl::io;
@@ -923,6 +925,38 @@ TEST (PCL,3DSCEstimation)
   testSHOTIndicesAndSearchSurface<ShapeContext3DEstimation<PointXYZ, Normal, ShapeContext1980>, PointXYZ, Normal, ShapeContext1980> (cloudptr, normals, test_indices);
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, 3DSCEstimationMultiThreaded)
+{
+  float radius = 20.0f * 0.002f;
+
+  // Estimate normals first
+  NormalEstimation<PointXYZ, Normal> ne;
+  PointCloud<Normal>::Ptr normals (new PointCloud<Normal> ());
+  ne.setInputCloud (cloud.makeShared ());
+  ne.setSearchMethod (tree);
+  ne.setRadiusSearch (radius);
+  ne.compute (*normals);
+
+  // Both estimators use the same seed, the X axes are drawn in index order before the estimation
+  PointCloud<ShapeContext1980> sc3ds_serial, sc3ds_parallel;
+  for (int nr_threads = 1; nr_threads <= 4; nr_threads += 3)
+  {
+    ShapeContext3DEstimation<PointXYZ, Normal, ShapeContext1980> sc3d;
+    sc3d.setInputCloud (cloud.makeShared ());
+    sc3d.setInputNormals (normals);
+    sc3d.setSearchMethod (tree);
+    sc3d.setRadiusSearch (radius);
+    sc3d.setMinimalRadius (radius / 10.0f);
+    sc3d.setPointDensityRadius (radius / 5.0f);
+    sc3d.setNumberOfThreads (nr_threads);
+    sc3d.compute (nr_threads == 1 ? sc3ds_serial : sc3ds_parallel);
+  }
+
+  EXPECT_EQ (sc3ds_serial.is_dense, sc3ds_parallel.is_dense);
+  checkDesc<ShapeContext1980> (sc3ds_serial, sc3ds_parallel);
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 TEST (PCL, USCEstimation)
 {
@@ -978,6 +1012,110 @@ TEST (PCL, USCEstimation)
   testSHOTLocalReferenceFrame<UniqueShapeContext<PointXYZ, UniqueShapeContext1960>, PointXYZ, Normal, UniqueShapeContext1960> (cloud.makeShared (), normals, test_indices);
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, USCEstimationMultiThreaded)
+{
+  float radius = 20.0f * 0.002f;
+
+  UniqueShapeContext<PointXYZ, UniqueShapeContext1960> uscd;
+  uscd.setInputCloud (cloud.makeShared ());
+  uscd.setSearchMethod (tree);
+  uscd.setRadiusSearch (radius);
+  uscd.setMinimalRadius (radius / 10.0f);
+  uscd.setPointDensityRadius (radius / 5.0f);
+  uscd.setLocalRadius (radius);
+
+  PointCloud<UniqueShapeContext1960> uscds_serial, uscds_parallel;
+  uscd.compute (uscds_serial);
+
+  uscd.setNumberOfThreads (4);
+  uscd.compute (uscds_parallel);
+
+  // Every point is estimated independently, so the results must not depend on the number of threads
+  EXPECT_EQ (uscds_serial.is_dense, uscds_parallel.is_dense);
+  checkDesc<UniqueShapeContext1960> (uscds_serial, uscds_parallel);
+  for (size_t i = 0; i < uscds_serial.points.size (); ++i)
+    for (int j = 0; j < 9; ++j)
+      ASSERT_EQ (uscds_serial.points[i].rf[j], uscds_parallel.points[i].rf[j]);
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, QuantizedSHOTNearestNeighbors)
+{
+  // SHOT descriptors of the bunny and of a noisy copy of it
+  const double mr = 0.002;
+  PointCloud<PointXYZ>::Ptr noisy (new PointCloud<PointXYZ> (cloud));
+  srand (0);
+  for (size_t i = 0; i < noisy->points.size (); ++i)
+  {
+    noisy->points[i].x += static_cast<float> (2 * mr) * (static_cast<float> (rand ()) / static_cast<float> (RAND_MAX) - 0.5f);
+    noisy->points[i].y += static_cast<float> (2 * mr) * (static_cast<float> (rand ()) / static_cast<float> (RAND_MAX) - 0.5f);
+    noisy->points[i].z += static_cast<float> (2 * mr) * (static_cast<float> (rand ()) / static_cast<float> (RAND_MAX) - 0.5f);
+  }
+
+  PointCloud<SHOT352> targets, queries;
+  for (int c = 0; c < 2; ++c)
+  {
+    PointCloud<PointXYZ>::Ptr input = c == 0 ? cloud.makeShared () : noisy;
+    KdTreePtr input_tree (new search::KdTree<PointXYZ> (false));
+    NormalEstimation<PointXYZ, Normal> n;
+    PointCloud<Normal>::Ptr normals (new PointCloud<Normal> ());
+    n.setInputCloud (input);
+    n.setSearchMethod (input_tree);
+    n.setRadiusSearch (20 * mr);
+    n.compute (*normals);
+
+    SHOTEstimation<PointXYZ, Normal, SHOT352> shot;
+    shot.setInputCloud (input);
+    shot.setInputNormals (normals);
+    shot.setSearchMethod (input_tree);
+    shot.setRadiusSearch (20 * mr);
+    shot.compute (c == 0 ? targets : queries);
+  }
+
+  PointCloud<QuantizedSHOT352> quantized_targets, quantized_queries;
+  PointCloudSHOT352toQuantizedSHOT352 (targets, quantized_targets);
+  PointCloudSHOT352toQuantizedSHOT352 (queries, quantized_queries);
+  vector<int> quantized_nearest;
+  vector<float> quantized_distances;
+  nearestDescriptors (quantized_queries, quantized_targets, quantized_nearest, quantized_distances);
+
+  // The nearest neighbors found on the byte codes are the ones found on the float descriptors, and they
+  // match the noisy points to the original ones as often
+  int nr_queries = 0, nr_matches = 0, nr_correct = 0, nr_quantized_correct = 0;
+  for (size_t q = 0; q < queries.points.size (); ++q)
+  {
+    if (!pcl_isfinite (queries.points[q].descriptor[0]))
+      continue;
+    int nearest = -1;
+    float nearest_distance = std::numeric_limits<float>::max ();
+    for (size_t p = 0; p < targets.points.size (); ++p)
+    {
+      if (!pcl_isfinite (targets.points[p].descriptor[0]))
+        continue;
+      float distance = 0.0f;
+      for (int i = 0; i < 352; ++i)
+        distance += (queries.points[q].descriptor[i] - targets.points[p].descriptor[i]) *
+                    (queries.points[q].descriptor[i] - targets.points[p].descriptor[i]);
+      if (distance < nearest_distance)
+      {
+        nearest_distance = distance;
+        nearest = static_cast<int> (p);
+      }
+    }
+    ++nr_queries;
+    if (quantized_nearest[q] == nearest)
+      ++nr_matches;
+    if (nearest == static_cast<int> (q))
+      ++nr_correct;
+    if (quantized_nearest[q] == static_cast<int> (q))
+      ++nr_quantized_correct;
+  }
+  ASSERT_GT (nr_queries, 300);
+  EXPECT_GE (nr_matches, nr_queries * 95 / 100);
+  EXPECT_GE (nr_quantized_correct, nr_correct - nr_queries / 100);
+}
+
 /* ---[ */
 int
 main (int argc, char** argv)
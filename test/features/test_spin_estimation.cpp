@@ -280,6 +280,40 @@ TEST (PCL, IntensitySpinEstimation)
   }
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, SpinImageEstimationMultiThreaded)
+{
+  // Estimate normals first
+  double mr = 0.002;
+  NormalEstimation<PointXYZ, Normal> n;
+  PointCloud<Normal>::Ptr normals (new PointCloud<Normal> ());
+  n.setInputCloud (cloud.makeShared ());
+  n.setSearchMethod (tree);
+  n.setRadiusSearch (20 * mr);
+  n.compute (*normals);
+
+  typedef Histogram<153> SpinImage;
+  SpinImageEstimation<PointXYZ, Normal, SpinImage> spin_est (8, 0.5, 16);
+  spin_est.setInputCloud (cloud.makeShared ());
+  spin_est.setInputNormals (normals);
+  spin_est.setSearchMethod (tree);
+  spin_est.setRadiusSearch (40 * mr);
+  spin_est.setAngularDomain ();
+
+  PointCloud<SpinImage> spin_images_serial, spin_images_parallel;
+  spin_est.compute (spin_images_serial);
+
+  spin_est.setNumberOfThreads (4);
+  spin_est.compute (spin_images_parallel);
+
+  // Every point is estimated independently, so the results must not depend on the number of threads
+  ASSERT_EQ (spin_images_serial.points.size (), spin_images_parallel.points.size ());
+  EXPECT_EQ (spin_images_serial.is_dense, spin_images_parallel.is_dense);
+  for (size_t i = 0; i < spin_images_serial.points.size (); ++i)
+    for (int j = 0; j < 153; ++j)
+      ASSERT_EQ (spin_images_serial.points[i].histogram[j], spin_images_parallel.points[i].histogram[j]);
+}
+
 /* ---[ */
 int
 main (int argc, char** argv)
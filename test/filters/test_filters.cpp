@@ -690,6 +690,91 @@ TEST (VoxelGrid, Filters)
   EXPECT_LE (output.points[neighbors2.at (0)].z - output.points[centroidIdx2].z, 0.02 * 2);
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (VoxelGrid_Parallel, Filters)
+{
+  PointCloud<PointXYZ> output, output_parallel;
+  VoxelGrid<PointXYZ> grid;
+
+  grid.setLeafSize (0.02f, 0.02f, 0.02f);
+  grid.setInputCloud (cloud);
+  grid.setSaveLeafLayout (true);
+  grid.filter (output);
+  vector<int> leaf_layout = grid.getLeafLayout ();
+
+  // The parallel path must give the same points in the same order
+  grid.setNumberOfThreads (4);
+  grid.filter (output_parallel);
+
+  ASSERT_EQ (output.points.size (), output_parallel.points.size ());
+  for (size_t i = 0; i < output.points.size (); ++i)
+  {
+    EXPECT_NEAR (output.points[i].x, output_parallel.points[i].x, 1e-6);
+    EXPECT_NEAR (output.points[i].y, output_parallel.points[i].y, 1e-6);
+    EXPECT_NEAR (output.points[i].z, output_parallel.points[i].z, 1e-6);
+  }
+  EXPECT_TRUE (leaf_layout == grid.getLeafLayout ());
+
+  // The hash map gives the same centroids, in another order
+  grid.setSaveLeafLayout (false);
+  grid.setUseHashMap (true);
+  grid.filter (output_parallel);
+
+  ASSERT_EQ (output.points.size (), output_parallel.points.size ());
+  for (size_t i = 0; i < output_parallel.points.size (); ++i)
+  {
+    Eigen::Vector3i ijk = grid.getGridCoordinates (output_parallel.points[i].x,
+                                                   output_parallel.points[i].y,
+                                                   output_parallel.points[i].z) - grid.getMinBoxCoordinates ();
+    int centroid_idx = leaf_layout[ijk.dot (grid.getDivisionMultiplier ())];
+    ASSERT_NE (centroid_idx, -1);
+    EXPECT_NEAR (output.points[centroid_idx].x, output_parallel.points[i].x, 1e-6);
+    EXPECT_NEAR (output.points[centroid_idx].y, output_parallel.points[i].y, 1e-6);
+    EXPECT_NEAR (output.points[centroid_idx].z, output_parallel.points[i].z, 1e-6);
+  }
+
+  // The hash map output does not depend on the number of threads either
+  PointCloud<PointXYZ> output_hash;
+  grid.setNumberOfThreads (1);
+  grid.filter (output_hash);
+
+  ASSERT_EQ (output_hash.points.size (), output_parallel.points.size ());
+  for (size_t i = 0; i < output_hash.points.size (); ++i)
+  {
+    EXPECT_EQ (output_hash.points[i].x, output_parallel.points[i].x);
+    EXPECT_EQ (output_hash.points[i].y, output_parallel.points[i].y);
+    EXPECT_EQ (output_hash.points[i].z, output_parallel.points[i].z);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (VoxelGrid_LargeExtent, Filters)
+{
+  // 1 km x 1 km x 100 m at 1 cm leaves does not fit into 32-bit voxel indices
+  PointCloud<PointXYZ>::Ptr input (new PointCloud<PointXYZ>);
+  input->push_back (PointXYZ (0.0f, 0.0f, 0.0f));
+  input->push_back (PointXYZ (0.002f, 0.0f, 0.0f));
+  input->push_back (PointXYZ (1000.004f, 1000.004f, 100.004f));
+  input->push_back (PointXYZ (1000.002f, 1000.004f, 100.004f));
+  input->push_back (PointXYZ (500.0f, 500.0f, 50.0f));
+
+  PointCloud<PointXYZ> output;
+  VoxelGrid<PointXYZ> grid;
+  grid.setLeafSize (0.01f, 0.01f, 0.01f);
+  grid.setInputCloud (input);
+  grid.filter (output);
+
+  EXPECT_EQ (int (output.points.size ()), 3);
+  EXPECT_EQ (int (output.width), 3);
+  EXPECT_EQ (int (output.height), 1);
+
+  grid.setMinimumPointsNumberPerVoxel (2);
+  grid.setNumberOfThreads (2);
+  grid.filter (output);
+
+  EXPECT_EQ (int (output.points.size ()), 2);
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 TEST (VoxelGrid_RGB, Filters)
 {
@@ -39,6 +39,16 @@ cloud_callback_vector (std::vector<CloudT::ConstPtr> *vector_to_fill,
   vector_to_fill->push_back (input_cloud);
 }
 
+// Helper function stopping the grabber from its own callback
+void
+cloud_callback_stop (pcl::Grabber *grabber,
+                     std::vector<CloudT::ConstPtr> *vector_to_fill,
+                     const CloudT::ConstPtr &input_cloud)
+{
+  vector_to_fill->push_back (input_cloud);
+  grabber->stop ();
+}
+
 TEST (PCL, PCDGrabber)
 {
   pcl::PCDGrabber<PointT> grabber (pcd_files_, 10, false); // TODO add directory functionality
@@ -108,6 +118,54 @@ TEST (PCL, PCDGrabber)
 
 }
 
+TEST (PCL, PCDGrabberReadAhead)
+{
+  pcl::PCDGrabber<PointT> grabber (pcd_files_, 0, false);
+  grabber.setReadAhead (4, 2);
+  grabber.setPlaybackAsFastAsPossible (true);
+  vector<CloudT::ConstPtr> grabbed_clouds;
+  boost::function<void (const pcl::PointCloud<pcl::PointXYZRGBA>::ConstPtr&)> 
+    fxn = boost::bind (cloud_callback_vector, &grabbed_clouds, _1);
+  grabber.registerCallback (fxn);
+  grabber.start ();
+  size_t niter = 0;
+  while (grabber.isRunning () && ++niter < 1000)
+    boost::this_thread::sleep (boost::posix_time::microseconds (10000));
+  EXPECT_FALSE (grabber.isRunning ());
+  grabber.stop ();
+
+  // The clouds come out in order although they are loaded by two threads
+  ASSERT_EQ (pcds_.size (), grabbed_clouds.size ());
+  for (size_t i = 0; i < pcds_.size (); i++)
+  {
+    ASSERT_EQ (grabbed_clouds[i]->size (), pcds_[i]->size ());
+    for (size_t j = 0; j < pcds_[i]->size (); j++)
+    {
+      const PointT &pcd_pt = pcds_[i]->at(j);
+      const PointT &grabbed_pt = grabbed_clouds[i]->at(j);
+      if (pcl_isnan (pcd_pt.z))
+        EXPECT_TRUE (pcl_isnan (grabbed_pt.z));
+      else
+        EXPECT_FLOAT_EQ (pcd_pt.z, grabbed_pt.z);
+      EXPECT_EQ (pcd_pt.rgba, grabbed_pt.rgba);
+    }
+  }
+
+  // Triggered playback from the read-ahead queue after a rewind
+  grabber.setPlaybackAsFastAsPossible (false);
+  grabber.rewind ();
+  CloudT::ConstPtr cloud_buffer;
+  bool signal_received = false;
+  grabber.registerCallback (boost::function<void (const pcl::PointCloud<pcl::PointXYZRGBA>::ConstPtr&)> (
+                              boost::bind (cloud_callback, &signal_received, &cloud_buffer, _1)));
+  grabber.trigger ();
+  niter = 0;
+  while (!signal_received && ++niter < 100)
+    boost::this_thread::sleep (boost::posix_time::microseconds (10000));
+  ASSERT_TRUE (signal_received);
+  ASSERT_EQ (cloud_buffer->size (), pcds_[0]->size ());
+}
+
 TEST (PCL, ImageGrabberTIFF)
 {
   // Get all clouds from the grabber
@@ -348,6 +406,65 @@ TEST (PCL, ImageGrabberOMP)
   }
 }
 
+TEST (PCL, ImageGrabberReadAhead)
+{
+  pcl::ImageGrabber<PointT> grabber (pclzf_dir_, 0, false, true);
+  grabber.setReadAhead (4, 2);
+  grabber.setPlaybackAsFastAsPossible (true);
+  vector<CloudT::ConstPtr> pclzf_clouds;
+  boost::function<void (const pcl::PointCloud<pcl::PointXYZRGBA>::ConstPtr&)> 
+    fxn = boost::bind (cloud_callback_vector, &pclzf_clouds, _1);
+  grabber.registerCallback (fxn);
+  grabber.start ();
+  size_t niter = 0;
+  while (grabber.isRunning () && ++niter < 1000)
+    boost::this_thread::sleep (boost::posix_time::microseconds (10000));
+  EXPECT_FALSE (grabber.isRunning ());
+  grabber.stop ();
+
+  ASSERT_EQ (pcds_.size (), pclzf_clouds.size ());
+  for (size_t i = 0; i < pcds_.size (); i++)
+  {
+    CloudT::ConstPtr cloud_from_file_grabber = grabber[i];
+    ASSERT_EQ (pclzf_clouds[i]->size (), cloud_from_file_grabber->size ());
+    for (size_t j = 0; j < pcds_[i]->size (); j++)
+    {
+      const PointT &pcd_pt = pcds_[i]->at(j);
+      const PointT &pclzf_pt = pclzf_clouds[i]->at(j);
+      if (pcl_isnan (pcd_pt.z))
+        EXPECT_TRUE (pcl_isnan (pclzf_pt.z));
+      else
+        EXPECT_FLOAT_EQ (pcd_pt.z, pclzf_pt.z);
+      EXPECT_EQ (pcd_pt.r, pclzf_pt.r);
+      EXPECT_EQ (pcd_pt.g, pclzf_pt.g);
+      EXPECT_EQ (pcd_pt.b, pclzf_pt.b);
+    }
+  }
+}
+
+TEST (PCL, ImageGrabberStopFromCallback)
+{
+  pcl::ImageGrabber<PointT> grabber (pclzf_dir_, 0, false, true);
+  grabber.setReadAhead (4, 2);
+  grabber.setPlaybackAsFastAsPossible (true);
+  vector<CloudT::ConstPtr> pclzf_clouds;
+  boost::function<void (const pcl::PointCloud<pcl::PointXYZRGBA>::ConstPtr&)> 
+    fxn = boost::bind (cloud_callback_stop, &grabber, &pclzf_clouds, _1);
+  grabber.registerCallback (fxn);
+
+  // The playback thread must not join itself when the callback stops the grabber
+  for (size_t run = 1; run <= 2; run++)
+  {
+    grabber.start ();
+    size_t niter = 0;
+    while (grabber.isRunning () && ++niter < 1000)
+      boost::this_thread::sleep (boost::posix_time::microseconds (10000));
+    EXPECT_FALSE (grabber.isRunning ());
+    grabber.stop ();
+    EXPECT_EQ (run, pclzf_clouds.size ());
+  }
+}
+
 TEST (PCL, ImageGrabberTimestamps)
 {
   // Initialize the grabber but don't load
@@ -0,0 +1,182 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2014-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <pcl/point_types.h>
+#include <pcl/io/hdl_grabber.h>
+
+#include <cmath>
+#include <cstring>
+
+/** \brief Gives the tests access to the packet conversion of the HDL grabber. */
+class HDLGrabberTest : public pcl::HDLGrabber
+{
+  public:
+    using pcl::HDLGrabber::HDL_FIRING_PER_PKT;
+    using pcl::HDLGrabber::HDL_LASER_PER_FIRING;
+    using pcl::HDLGrabber::HDL_MAX_NUM_LASERS;
+    using pcl::HDLGrabber::BLOCK_0_TO_31;
+    using pcl::HDLGrabber::BLOCK_32_TO_63;
+    using pcl::HDLGrabber::HDLLaserReturn;
+    using pcl::HDLGrabber::HDLDataPacket;
+    using pcl::HDLGrabber::HDLLaserCorrection;
+    using pcl::HDLGrabber::HDLPacketPoints;
+    using pcl::HDLGrabber::laser_corrections_;
+    using pcl::HDLGrabber::updateFloatCorrections;
+    using pcl::HDLGrabber::computePacketPoints;
+
+    /** \brief Set non trivial corrections for all the lasers. */
+    void
+    setCorrections ()
+    {
+      for (int i = 0; i < HDL_MAX_NUM_LASERS; ++i)
+      {
+        HDLLaserCorrection &correction = laser_corrections_[i];
+        correction.azimuthCorrection = i % 3 == 0 ? 0.0 : -5.0 + 0.3 * i;
+        correction.verticalCorrection = -30.0 + i * 0.7;
+        correction.distanceCorrection = 0.01 * (i % 7);
+        correction.verticalOffsetCorrection = 0.2 - 0.003 * i;
+        correction.horizontalOffsetCorrection = i % 2 == 0 ? 0.026 : -0.026;
+        correction.cosVertCorrection = std::cos (HDL_Grabber_toRadians (correction.verticalCorrection));
+        correction.sinVertCorrection = std::sin (HDL_Grabber_toRadians (correction.verticalCorrection));
+        correction.sinVertOffsetCorrection = correction.verticalOffsetCorrection * correction.sinVertCorrection;
+        correction.cosVertOffsetCorrection = correction.verticalOffsetCorrection * correction.cosVertCorrection;
+      }
+      updateFloatCorrections ();
+    }
+
+    /** \brief The per return conversion the grabber used before whole packets were converted at once. */
+    void
+    computeXYZI (pcl::PointXYZI &point, int azimuth, HDLLaserReturn laserReturn, const HDLLaserCorrection &correction)
+    {
+      double cosAzimuth, sinAzimuth;
+
+      double distanceM = laserReturn.distance * 0.002;
+
+      if (distanceM < getMinimumDistanceThreshold () || distanceM > getMaximumDistanceThreshold ())
+      {
+        point.x = point.y = point.z = std::numeric_limits<float>::quiet_NaN ();
+        point.intensity = static_cast<float> (laserReturn.intensity);
+        return;
+      }
+
+      double azimuthInRadians = HDL_Grabber_toRadians ((static_cast<double> (azimuth) / 100.0) - correction.azimuthCorrection);
+      cosAzimuth = std::cos (azimuthInRadians);
+      sinAzimuth = std::sin (azimuthInRadians);
+
+      distanceM += correction.distanceCorrection;
+
+      double xyDistance = distanceM * correction.cosVertCorrection - correction.sinVertOffsetCorrection;
+
+      point.x = static_cast<float> (xyDistance * sinAzimuth - correction.horizontalOffsetCorrection * cosAzimuth);
+      point.y = static_cast<float> (xyDistance * cosAzimuth + correction.horizontalOffsetCorrection * sinAzimuth);
+      point.z = static_cast<float> (distanceM * correction.sinVertCorrection + correction.cosVertOffsetCorrection);
+      point.intensity = static_cast<float> (laserReturn.intensity);
+    }
+};
+
+TEST (PCL, HDLGrabberComputePacketPoints)
+{
+  HDLGrabberTest grabber;
+  grabber.setCorrections ();
+  float min_distance = 0.5f, max_distance = 100.0f;
+  grabber.setMinimumDistanceThreshold (min_distance);
+  grabber.setMaximumDistanceThreshold (max_distance);
+
+  // A synthetic packet covering both laser blocks, the whole azimuth range and
+  // returns inside and outside the distance thresholds
+  HDLGrabberTest::HDLDataPacket packet;
+  memset (&packet, 0, sizeof (packet));
+  for (int i = 0; i < HDLGrabberTest::HDL_FIRING_PER_PKT; ++i)
+  {
+    packet.firingData[i].blockIdentifier = i % 2 == 0 ? HDLGrabberTest::BLOCK_0_TO_31 : HDLGrabberTest::BLOCK_32_TO_63;
+    packet.firingData[i].rotationalPosition = static_cast<unsigned short> ((i * 3271 + 17) % 36000);
+    for (int j = 0; j < HDLGrabberTest::HDL_LASER_PER_FIRING; ++j)
+    {
+      packet.firingData[i].laserReturns[j].distance = static_cast<unsigned short> ((i * 911 + j * 1733) % 60000);
+      packet.firingData[i].laserReturns[j].intensity = static_cast<unsigned char> (i * 32 + j);
+    }
+  }
+  packet.firingData[3].rotationalPosition = 0;
+  packet.firingData[4].rotationalPosition = 35999;
+
+  HDLGrabberTest::HDLPacketPoints points;
+  grabber.computePacketPoints (&packet, points);
+
+  int nr_valid = 0;
+  for (int i = 0; i < HDLGrabberTest::HDL_FIRING_PER_PKT; ++i)
+  {
+    const int offset = i % 2 == 0 ? 0 : 32;
+    for (int j = 0; j < HDLGrabberTest::HDL_LASER_PER_FIRING; ++j)
+    {
+      const int p = i * HDLGrabberTest::HDL_LASER_PER_FIRING + j;
+      pcl::PointXYZI expected;
+      grabber.computeXYZI (expected, packet.firingData[i].rotationalPosition,
+                           packet.firingData[i].laserReturns[j], grabber.laser_corrections_[j + offset]);
+
+      EXPECT_EQ (points.laser[p], j + offset);
+      EXPECT_EQ (points.intensity[p], expected.intensity);
+      EXPECT_EQ (points.valid[p] != 0, pcl_isfinite (expected.x));
+      if (!points.valid[p])
+        continue;
+      ++nr_valid;
+      // Single precision lookup tables and rotations against double trigonometry
+      const float tolerance = 1e-6f * max_distance + 1e-5f;
+      EXPECT_NEAR (points.x[p], expected.x, tolerance);
+      EXPECT_NEAR (points.y[p], expected.y, tolerance);
+      EXPECT_NEAR (points.z[p], expected.z, tolerance);
+    }
+  }
+  EXPECT_GT (nr_valid, HDLGrabberTest::HDL_FIRING_PER_PKT * HDLGrabberTest::HDL_LASER_PER_FIRING / 2);
+  EXPECT_LT (nr_valid, HDLGrabberTest::HDL_FIRING_PER_PKT * HDLGrabberTest::HDL_LASER_PER_FIRING);
+
+  // Corrupted rotational positions give no points
+  packet.firingData[5].rotationalPosition = 40000;
+  grabber.computePacketPoints (&packet, points);
+  for (int j = 0; j < HDLGrabberTest::HDL_LASER_PER_FIRING; ++j)
+    EXPECT_EQ (points.valid[5 * HDLGrabberTest::HDL_LASER_PER_FIRING + j], 0);
+}
+
+/* ---[ */
+int
+main (int argc, char** argv)
+{
+  testing::InitGoogleTest (&argc, argv);
+  return (RUN_ALL_TESTS ());
+}
+/* ]--- */
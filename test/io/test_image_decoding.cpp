@@ -0,0 +1,204 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2014-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <pcl/io/lzf_image_io.h>
+#include <pcl/io/debayer.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+/** \brief Gives the tests access to the YUV422 conversion kernel. */
+class LZFYUV422ImageReaderTest : public pcl::io::LZFYUV422ImageReader
+{
+  public:
+    using pcl::io::LZFYUV422ImageReader::convertToRGB;
+};
+
+/** \brief The scalar fixed point conversion the YUV422 reader used before convertToRGB (). */
+inline unsigned char
+clipChar (int c)
+{
+  return (static_cast<unsigned char> (std::min (255, std::max (0, c))));
+}
+
+TEST (PCL, LZFYUV422ConvertToRGB)
+{
+  // Every (u, v) pair, followed by an odd number of pairs handled by the scalar tail
+  const int nr_pixel_pairs = 256 * 256 + 7;
+  std::vector<unsigned char> u (nr_pixel_pairs), v (nr_pixel_pairs), y (2 * nr_pixel_pairs);
+  srand (0);
+  for (int i = 0; i < nr_pixel_pairs; ++i)
+  {
+    u[i] = static_cast<unsigned char> (i < 256 * 256 ? i % 256 : rand () % 256);
+    v[i] = static_cast<unsigned char> (i < 256 * 256 ? i / 256 : rand () % 256);
+  }
+  // Extreme luma values make the clipping happen on both sides
+  for (int i = 0; i < 2 * nr_pixel_pairs; ++i)
+    y[i] = static_cast<unsigned char> (i % 3 == 0 ? 0 : (i % 3 == 1 ? 255 : rand () % 256));
+
+  std::vector<unsigned char> r (2 * nr_pixel_pairs), g (2 * nr_pixel_pairs), b (2 * nr_pixel_pairs);
+  LZFYUV422ImageReaderTest::convertToRGB (&u[0], &y[0], &v[0], &r[0], &g[0], &b[0], nr_pixel_pairs);
+
+  for (int i = 0; i < nr_pixel_pairs; ++i)
+  {
+    const int cv = v[i] - 128;
+    const int cu = u[i] - 128;
+    for (int j = 2 * i; j < 2 * i + 2; ++j)
+    {
+      ASSERT_EQ (r[j], clipChar (y[j] + ((cv * 18678 + 8192 ) >> 14))) << "pixel " << j;
+      ASSERT_EQ (g[j], clipChar (y[j] + ((cv * -9519 - cu * 6472 + 8192) >> 14))) << "pixel " << j;
+      ASSERT_EQ (b[j], clipChar (y[j] + ((cu * 33292 + 8192 ) >> 14))) << "pixel " << j;
+    }
+  }
+}
+
+/** \brief Bilinear interpolation of the pixel (x, y) of a GRBG Bayer image, with truncating integer averages. */
+void
+bilinearPixel (const std::vector<unsigned char> &bayer, int width, int x, int y, int rgb[3])
+{
+  const unsigned char *p = &bayer[y * width + x];
+  const int cross = (p[-1] + p[1] + p[-width] + p[width]) >> 2;
+  const int diagonal = (p[-width - 1] + p[-width + 1] + p[width - 1] + p[width + 1]) >> 2;
+  const int horizontal = (p[-1] + p[1]) >> 1;
+  const int vertical = (p[-width] + p[width]) >> 1;
+  if (y % 2 == 0 && x % 2 == 0)       // G on a GRGR line
+    rgb[0] = horizontal, rgb[1] = p[0], rgb[2] = vertical;
+  else if (y % 2 == 0)                // R
+    rgb[0] = p[0], rgb[1] = cross, rgb[2] = diagonal;
+  else if (x % 2 == 0)                // B
+    rgb[0] = diagonal, rgb[1] = cross, rgb[2] = p[0];
+  else                                // G on a BGBG line
+    rgb[0] = vertical, rgb[1] = p[0], rgb[2] = horizontal;
+}
+
+/** \brief Check the inner rows of debayerBilinear () against bilinearPixel (). */
+void
+checkBilinearDebayer (unsigned width, unsigned height, unsigned rgb_line_step)
+{
+  std::vector<unsigned char> bayer (width * height);
+  for (size_t i = 0; i < bayer.size (); ++i)
+    bayer[i] = static_cast<unsigned char> (i % 7 == 0 ? 255 : rand () % 256);
+
+  const unsigned line_step = rgb_line_step == 0 ? width * 3 : rgb_line_step;
+  std::vector<unsigned char> rgb (line_step * height, 7);
+  pcl::io::DeBayer debayer;
+  debayer.debayerBilinear (&bayer[0], &rgb[0], width, height, 0, 0, rgb_line_step);
+
+  // The inner row pairs, without the two pixels at both ends of the lines
+  const unsigned last_row = 2 * ((height - 3) / 2) + 1;
+  for (unsigned y = 2; y <= last_row; ++y)
+    for (unsigned x = 2; x < width - 2; ++x)
+    {
+      int expected[3];
+      bilinearPixel (bayer, width, x, y, expected);
+      for (int c = 0; c < 3; ++c)
+        ASSERT_EQ (expected[c], rgb[y * line_step + 3 * x + c])
+          << "pixel (" << x << ", " << y << "), channel " << c << ", " << width << "x" << height;
+    }
+  // The padding at the end of the lines is left untouched
+  for (unsigned y = 0; y < height; ++y)
+    for (unsigned i = width * 3; i < line_step; ++i)
+      ASSERT_EQ (7, rgb[y * line_step + i]);
+}
+
+TEST (PCL, DeBayerBilinear)
+{
+  srand (0);
+  checkBilinearDebayer (640, 480, 0);
+  // Lines with a scalar tail after the 16 pixel blocks, exactly one block, and no block at all
+  checkBilinearDebayer (70, 12, 0);
+  checkBilinearDebayer (20, 8, 0);
+  checkBilinearDebayer (18, 8, 0);
+  checkBilinearDebayer (86, 10, 86 * 3 + 5);
+}
+
+/** \brief Debayer a random image with 1 and 4 threads and check the results are identical. */
+void
+checkParallelDebayer (unsigned width, unsigned height, unsigned rgb_line_step)
+{
+  std::vector<unsigned char> bayer (width * height);
+  for (size_t i = 0; i < bayer.size (); ++i)
+    bayer[i] = static_cast<unsigned char> (rand () % 256);
+
+  const size_t rgb_size = (rgb_line_step == 0 ? width * 3 : rgb_line_step) * height;
+  pcl::io::DeBayer serial, parallel;
+  serial.setNumberOfThreads (1);
+  parallel.setNumberOfThreads (4);
+
+  for (int method = 0; method < 3; ++method)
+  {
+    // The padding at the end of the lines is not written, give it the same content
+    std::vector<unsigned char> serial_rgb (rgb_size, 7), parallel_rgb (rgb_size, 7);
+    if (method == 0)
+    {
+      serial.debayerBilinear (&bayer[0], &serial_rgb[0], width, height, 0, 0, rgb_line_step);
+      parallel.debayerBilinear (&bayer[0], &parallel_rgb[0], width, height, 0, 0, rgb_line_step);
+    }
+    else if (method == 1)
+    {
+      serial.debayerEdgeAware (&bayer[0], &serial_rgb[0], width, height, 0, 0, rgb_line_step);
+      parallel.debayerEdgeAware (&bayer[0], &parallel_rgb[0], width, height, 0, 0, rgb_line_step);
+    }
+    else
+    {
+      serial.debayerEdgeAwareWeighted (&bayer[0], &serial_rgb[0], width, height, 0, 0, rgb_line_step);
+      parallel.debayerEdgeAwareWeighted (&bayer[0], &parallel_rgb[0], width, height, 0, 0, rgb_line_step);
+    }
+    EXPECT_TRUE (serial_rgb == parallel_rgb) << "method " << method << ", " << width << "x" << height;
+  }
+}
+
+TEST (PCL, DeBayerParallel)
+{
+  srand (0);
+  checkParallelDebayer (64, 48, 0);
+  // Odd number of row pairs and padded output lines
+  checkParallelDebayer (64, 46, 64 * 3 + 5);
+  checkParallelDebayer (640, 480, 0);
+}
+
+/* ---[ */
+int
+main (int argc, char** argv)
+{
+  testing::InitGoogleTest (&argc, argv);
+  return (RUN_ALL_TESTS ());
+}
+/* ]--- */
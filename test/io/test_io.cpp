@@ -47,6 +47,7 @@
 #include <pcl/io/ply_io.h>
 #include <pcl/io/ascii_io.h>
 #include <fstream>
+#include <boost/filesystem.hpp>
 #include <locale>
 #include <stdexcept>
 
@@ -761,6 +762,137 @@ TEST (PCL, PCDReaderWriterASCIIColorPrecision)
   }
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, ParseStringValue)
+{
+  srand (static_cast<unsigned int> (time (NULL)));
+  for (int i = 0; i < 100000; ++i)
+  {
+    // Values of all magnitudes, printed with all precisions, must match std::istringstream
+    double v = (rand () / (RAND_MAX + 1.0) - 0.5) * pow (10.0, rand () % 40 - 20);
+    std::ostringstream os;
+    os.imbue (std::locale::classic ());
+    os << std::setprecision (1 + rand () % 17);
+    if (i % 2)
+      os << std::scientific;
+    os << v;
+    const std::string st = os.str ();
+
+    float f_ref, f;
+    double d_ref, d;
+    std::istringstream is_f (st), is_d (st);
+    is_f >> f_ref;
+    is_d >> d_ref;
+    EXPECT_TRUE (parseStringValue (st.c_str (), st.c_str () + st.size (), f));
+    EXPECT_TRUE (parseStringValue (st.c_str (), st.c_str () + st.size (), d));
+    ASSERT_EQ (f, f_ref) << st;
+    ASSERT_EQ (d, d_ref) << st;
+  }
+
+  const char *values[] = { "0", "-0", "+12", "-128", "255", "-32768", "70000", "1.5", "1e3" };
+  for (size_t i = 0; i < sizeof (values) / sizeof (values[0]); ++i)
+  {
+    const std::string st (values[i]);
+    int8_t c_ref, c;
+    uint8_t uc_ref, uc;
+    int16_t s_ref, s;
+    uint32_t u_ref, u;
+    detail::convertStringValue (st, c_ref);
+    detail::convertStringValue (st, uc_ref);
+    detail::convertStringValue (st, s_ref);
+    detail::convertStringValue (st, u_ref);
+    parseStringValue (st.c_str (), st.c_str () + st.size (), c);
+    parseStringValue (st.c_str (), st.c_str () + st.size (), uc);
+    parseStringValue (st.c_str (), st.c_str () + st.size (), s);
+    parseStringValue (st.c_str (), st.c_str () + st.size (), u);
+    EXPECT_EQ (c, c_ref) << st;
+    EXPECT_EQ (uc, uc_ref) << st;
+    EXPECT_EQ (s, s_ref) << st;
+    EXPECT_EQ (u, u_ref) << st;
+  }
+
+  float f;
+  EXPECT_FALSE (parseStringValue ("NaN", "NaN" + 3, f));
+  EXPECT_TRUE (pcl_isnan (f));
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, PCDReaderASCIIParallel)
+{
+  std::ofstream fs;
+  fs.open ("parallel_ascii.pcd");
+  fs << "# .PCD v0.7 - Point Cloud Data file format\n"
+        "VERSION 0.7\n"
+        "FIELDS x y z _ label\n"
+        "SIZE 4 4 4 1 4\n"
+        "TYPE F F F U U\n"
+        "COUNT 1 1 1 2 1\n"
+        "WIDTH 100000\n"
+        "HEIGHT 1\n"
+        "VIEWPOINT 0 0 0 1 0 0 0\n"
+        "POINTS 100000\n"
+        "DATA ascii\n";
+  std::vector<float> values (100000);
+  srand (static_cast<unsigned int> (time (NULL)));
+  for (size_t i = 0; i < values.size (); ++i)
+  {
+    values[i] = static_cast<float> (1024.0 * rand () / (RAND_MAX + 1.0));
+    // Blank lines and Windows line endings are ignored
+    if (i % 1000 == 0)
+      fs << " \r\n";
+    fs << std::setprecision (9) << values[i] << "\t" << (i == 5 ? "nan" : "1e-3") << " -" << values[i]
+       << " 0 0 " << i << "\r\n";
+  }
+  fs.close ();
+
+  PCDReader reader;
+  reader.setNumberOfThreads (4);
+  PointCloud<PointXYZL> cloud;
+  EXPECT_EQ (reader.read ("parallel_ascii.pcd", cloud), 0);
+  ASSERT_EQ (cloud.size (), values.size ());
+  EXPECT_FALSE (cloud.is_dense);
+  for (size_t i = 0; i < cloud.size (); ++i)
+  {
+    ASSERT_EQ (cloud[i].x, values[i]);
+    if (i == 5)
+      EXPECT_TRUE (pcl_isnan (cloud[i].y));
+    else
+      ASSERT_EQ (cloud[i].y, 1e-3f);
+    ASSERT_EQ (cloud[i].z, -values[i]);
+    ASSERT_EQ (cloud[i].label, i);
+  }
+
+  // loadPCDFile uses all the available threads by default and reads the same points
+  PointCloud<PointXYZL> cloud_default;
+  EXPECT_EQ (loadPCDFile ("parallel_ascii.pcd", cloud_default), 0);
+  ASSERT_EQ (cloud_default.size (), cloud.size ());
+  for (size_t i = 0; i < cloud.size (); ++i)
+  {
+    ASSERT_EQ (cloud_default[i].x, cloud[i].x);
+    ASSERT_EQ (cloud_default[i].z, cloud[i].z);
+    ASSERT_EQ (cloud_default[i].label, cloud[i].label);
+  }
+
+  // Missing values are an error
+  fs.open ("parallel_ascii.pcd");
+  fs << "VERSION 0.7\n"
+        "FIELDS x y z\n"
+        "SIZE 4 4 4\n"
+        "TYPE F F F\n"
+        "COUNT 1 1 1\n"
+        "WIDTH 2\n"
+        "HEIGHT 1\n"
+        "POINTS 2\n"
+        "DATA ascii\n"
+        "1 2 3\n"
+        "1 2\n";
+  fs.close ();
+  pcl::PCLPointCloud2 blob;
+  EXPECT_LT (reader.read ("parallel_ascii.pcd", blob), 0);
+
+  remove ("parallel_ascii.pcd");
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 TEST (PCL, ASCIIReader)
@@ -865,6 +997,106 @@ TEST (PCL, PLYReaderWriter)
   }
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename T> void
+writePLYValue (std::ofstream &fs, const std::string &format, T value)
+{
+  if (format == "ascii")
+  {
+    fs << boost::lexical_cast<std::string> (+value) << " ";
+    return;
+  }
+  char bytes[sizeof (T)];
+  memcpy (bytes, &value, sizeof (T));
+  if (format == "binary_big_endian")
+    std::reverse (bytes, bytes + sizeof (T));
+  fs.write (bytes, sizeof (T));
+}
+
+void
+writePLYTestFile (const std::string &file_name, const std::string &format, bool with_color, size_t nr_points)
+{
+  std::ofstream fs (file_name.c_str (), std::ios::binary);
+  fs << "ply\nformat " << format << " 1.0\nelement vertex " << nr_points << "\n"
+     << "property float x\nproperty float y\nproperty float z\n";
+  if (with_color)
+    fs << "property uchar red\nproperty uchar green\nproperty uchar blue\nproperty uchar alpha\n"
+       << "property uchar intensity\nproperty double curvature\n";
+  else
+    fs << "property float intensity\nproperty int label\n";
+  fs << "end_header\n";
+  for (size_t i = 0; i < nr_points; ++i)
+  {
+    writePLYValue (fs, format, static_cast<float> (i) * 0.5f);
+    writePLYValue (fs, format, -static_cast<float> (i));
+    writePLYValue (fs, format, static_cast<float> (i) / 3.0f);
+    if (with_color)
+    {
+      writePLYValue (fs, format, static_cast<uint8_t> (i % 256));
+      writePLYValue (fs, format, static_cast<uint8_t> ((3 * i) % 256));
+      writePLYValue (fs, format, static_cast<uint8_t> ((7 * i) % 256));
+      writePLYValue (fs, format, static_cast<uint8_t> (255 - i % 256));
+      writePLYValue (fs, format, static_cast<uint8_t> ((5 * i) % 256));
+      writePLYValue (fs, format, static_cast<double> (i) * 0.25);
+    }
+    else
+    {
+      writePLYValue (fs, format, static_cast<float> (i) + 0.5f);
+      writePLYValue (fs, format, static_cast<int32_t> (i) - 10);
+    }
+    if (format == "ascii")
+      fs << "\n";
+  }
+}
+
+TEST (PCL, PLYReaderBinary)
+{
+  const size_t nr_points = 300;
+  const char* formats[] = { "binary_little_endian", "binary_big_endian" };
+
+  for (int with_color = 0; with_color < 2; ++with_color)
+  {
+    // The ASCII file goes through the per property callbacks and is the reference
+    writePLYTestFile ("test_pcl_io_ascii.ply", "ascii", with_color != 0, nr_points);
+    pcl::PCLPointCloud2 expected;
+    PLYReader reader;
+    ASSERT_EQ (reader.read ("test_pcl_io_ascii.ply", expected), 0);
+    ASSERT_EQ (expected.width * expected.height, nr_points);
+
+    for (int f = 0; f < 2; ++f)
+    {
+      writePLYTestFile ("test_pcl_io_binary.ply", formats[f], with_color != 0, nr_points);
+      pcl::PCLPointCloud2 cloud;
+      ASSERT_EQ (reader.read ("test_pcl_io_binary.ply", cloud), 0);
+
+      EXPECT_EQ (cloud.width, expected.width);
+      EXPECT_EQ (cloud.height, expected.height);
+      EXPECT_EQ (cloud.point_step, expected.point_step);
+      ASSERT_EQ (cloud.fields.size (), expected.fields.size ());
+      for (size_t i = 0; i < cloud.fields.size (); ++i)
+      {
+        EXPECT_EQ (cloud.fields[i].name, expected.fields[i].name);
+        EXPECT_EQ (cloud.fields[i].offset, expected.fields[i].offset);
+        EXPECT_EQ (cloud.fields[i].datatype, expected.fields[i].datatype);
+      }
+      ASSERT_EQ (cloud.data.size (), expected.data.size ());
+      EXPECT_TRUE (cloud.data == expected.data);
+    }
+
+    if (with_color)
+    {
+      PointCloud<PointXYZRGBA> cloud;
+      fromPCLPointCloud2 (expected, cloud);
+      EXPECT_EQ (cloud[10].r, 10);
+      EXPECT_EQ (cloud[10].g, 30);
+      EXPECT_EQ (cloud[10].b, 70);
+      EXPECT_EQ (cloud[10].a, 245);
+    }
+  }
+  remove ("test_pcl_io_ascii.ply");
+  remove ("test_pcl_io_binary.ply");
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 struct PointXYZFPFH33
@@ -1114,6 +1346,253 @@ TEST (PCL, LZFExtended)
   }
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, LZFChunked)
+{
+  PointCloud<PointXYZRGBNormal> cloud, cloud2;
+  cloud.width  = 640;
+  cloud.height = 480;
+  cloud.points.resize (cloud.width * cloud.height);
+  cloud.is_dense = true;
+
+  srand (static_cast<unsigned int> (time (NULL)));
+  size_t nr_p = cloud.points.size ();
+  // Randomly create a new point cloud, with a constant field which compresses well
+  for (size_t i = 0; i < nr_p; ++i)
+  {
+    cloud.points[i].x = static_cast<float> (1024 * rand () / (RAND_MAX + 1.0));
+    cloud.points[i].y = static_cast<float> (1024 * rand () / (RAND_MAX + 1.0));
+    cloud.points[i].z = static_cast<float> (1024 * rand () / (RAND_MAX + 1.0));
+    cloud.points[i].normal_x = static_cast<float> (1024 * rand () / (RAND_MAX + 1.0));
+    cloud.points[i].normal_y = static_cast<float> (1024 * rand () / (RAND_MAX + 1.0));
+    cloud.points[i].normal_z = 1.0f;
+    cloud.points[i].rgb = static_cast<float> (1024 * rand () / (RAND_MAX + 1.0));
+  }
+
+  // The last chunk is only partially filled
+  PCDWriter writer;
+  writer.setNumberOfThreads (4);
+  int res = writer.writeBinaryCompressedChunked<PointXYZRGBNormal> ("test_pcl_io_compressed_chunked.pcd", cloud, 10000);
+  EXPECT_EQ (res, 0);
+
+  PCDReader reader;
+  reader.setNumberOfThreads (4);
+  res = reader.read<PointXYZRGBNormal> ("test_pcl_io_compressed_chunked.pcd", cloud2);
+  EXPECT_EQ (res, 0);
+
+  EXPECT_EQ (cloud2.width, cloud.width);
+  EXPECT_EQ (cloud2.height, cloud.height);
+  EXPECT_EQ (cloud2.is_dense, cloud.is_dense);
+  EXPECT_EQ (cloud2.points.size (), cloud.points.size ());
+
+  for (size_t i = 0; i < cloud2.points.size (); ++i)
+  {
+    ASSERT_EQ (cloud2.points[i].x, cloud.points[i].x);
+    ASSERT_EQ (cloud2.points[i].y, cloud.points[i].y);
+    ASSERT_EQ (cloud2.points[i].z, cloud.points[i].z);
+    ASSERT_EQ (cloud2.points[i].normal_x, cloud.points[i].normal_x);
+    ASSERT_EQ (cloud2.points[i].normal_y, cloud.points[i].normal_y);
+    ASSERT_EQ (cloud2.points[i].normal_z, cloud.points[i].normal_z);
+    ASSERT_EQ (cloud2.points[i].rgb, cloud.points[i].rgb);
+  }
+
+  // Read a range spanning several chunks, and only some of the fields
+  std::vector<std::string> fields;
+  fields.push_back ("normal_z");
+  fields.push_back ("x");
+  pcl::PCLPointCloud2 blob;
+  res = reader.readRange ("test_pcl_io_compressed_chunked.pcd", blob, 12345, 30000, fields);
+  EXPECT_EQ (res, 0);
+  EXPECT_EQ (blob.width, 30000);
+  EXPECT_EQ (blob.height, 1);
+  EXPECT_EQ (blob.fields.size (), 2);
+  EXPECT_EQ (blob.point_step, 2 * sizeof (float));
+
+  PointCloud<PointNormal> range;
+  fromPCLPointCloud2 (blob, range);
+  ASSERT_EQ (range.points.size (), 30000);
+  for (size_t i = 0; i < range.points.size (); ++i)
+  {
+    ASSERT_EQ (range.points[i].x, cloud.points[12345 + i].x);
+    ASSERT_EQ (range.points[i].normal_z, cloud.points[12345 + i].normal_z);
+  }
+
+  // A range covering the whole organized cloud is unorganized as well
+  res = reader.readRange ("test_pcl_io_compressed_chunked.pcd", blob, 0, cloud.width * cloud.height, fields);
+  EXPECT_EQ (res, 0);
+  EXPECT_EQ (blob.width, cloud.width * cloud.height);
+  EXPECT_EQ (blob.height, 1);
+  EXPECT_EQ (blob.row_step, blob.width * blob.point_step);
+
+  // The other formats are cropped after being read entirely
+  writer.writeBinary<PointXYZRGBNormal> ("test_pcl_io_compressed_chunked.pcd", cloud);
+  res = reader.readRange ("test_pcl_io_compressed_chunked.pcd", blob, 0, cloud.width * cloud.height, fields);
+  EXPECT_EQ (res, 0);
+  EXPECT_EQ (blob.width, cloud.width * cloud.height);
+  EXPECT_EQ (blob.height, 1);
+  res = reader.readRange ("test_pcl_io_compressed_chunked.pcd", blob, 12345, 30000, fields);
+  EXPECT_EQ (res, 0);
+  fromPCLPointCloud2 (blob, range);
+  ASSERT_EQ (range.points.size (), 30000);
+  for (size_t i = 0; i < range.points.size (); ++i)
+  {
+    ASSERT_EQ (range.points[i].x, cloud.points[12345 + i].x);
+    ASSERT_EQ (range.points[i].normal_z, cloud.points[12345 + i].normal_z);
+  }
+
+  // Out of range requests fail
+  EXPECT_LT (reader.readRange ("test_pcl_io_compressed_chunked.pcd", blob, 300000, 10000), 0);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, LZFChunkedRangeOfLargeFile)
+{
+  // A file announcing 2^26 points (768 MB of xyz data). Only its index and its first chunk are present,
+  // stored uncompressed, which is all a range within the first chunk needs.
+  const unsigned int nr_points = 1u << 26, chunk_size = 1u << 16, nr_chunks = nr_points / chunk_size;
+  std::ofstream fs ("test_pcl_io_large_chunked.pcd", std::ios::out | std::ios::binary | std::ios::trunc);
+  fs << "# .PCD v0.7 - Point Cloud Data file format\n"
+        "VERSION 0.7\n"
+        "FIELDS x y z\n"
+        "SIZE 4 4 4\n"
+        "TYPE F F F\n"
+        "COUNT 1 1 1\n"
+        "WIDTH " << nr_points << "\n"
+        "HEIGHT 1\n"
+        "VIEWPOINT 0 0 0 1 0 0 0\n"
+        "POINTS " << nr_points << "\n"
+        "DATA binary_compressed_chunked\n";
+  std::vector<unsigned int> index (2 + 3 * nr_chunks, chunk_size * static_cast<unsigned int> (sizeof (float)));
+  index[0] = nr_chunks;
+  index[1] = chunk_size;
+  fs.write (reinterpret_cast<const char*> (&index[0]), index.size () * sizeof (unsigned int));
+  // The xx..yy..zz.. planes of the first chunk
+  std::vector<float> planes (3 * chunk_size);
+  for (unsigned int i = 0; i < chunk_size; ++i)
+  {
+    planes[i] = static_cast<float> (i);
+    planes[chunk_size + i] = static_cast<float> (2 * i);
+    planes[2 * chunk_size + i] = static_cast<float> (3 * i);
+  }
+  fs.write (reinterpret_cast<const char*> (&planes[0]), planes.size () * sizeof (float));
+  fs.close ();
+
+  // Only the header, the index and the first chunk are read, the data of the whole file is never allocated
+  PCDReader reader;
+  pcl::PCLPointCloud2 blob;
+  EXPECT_EQ (reader.readRange ("test_pcl_io_large_chunked.pcd", blob, 1000, 10), 0);
+  EXPECT_EQ (blob.width, 10);
+  EXPECT_EQ (blob.height, 1);
+  EXPECT_EQ (blob.data.size (), 10 * 3 * sizeof (float));
+  EXPECT_EQ (blob.data.capacity (), 10 * 3 * sizeof (float));
+
+  PointCloud<PointXYZ> range;
+  fromPCLPointCloud2 (blob, range);
+  ASSERT_EQ (range.points.size (), 10);
+  for (size_t i = 0; i < range.points.size (); ++i)
+  {
+    EXPECT_EQ (range.points[i].x, static_cast<float> (1000 + i));
+    EXPECT_EQ (range.points[i].y, static_cast<float> (2 * (1000 + i)));
+    EXPECT_EQ (range.points[i].z, static_cast<float> (3 * (1000 + i)));
+  }
+
+  remove ("test_pcl_io_large_chunked.pcd");
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, PCDStreamReaderWriter)
+{
+  PointCloud<PointXYZRGBNormal> cloud;
+  cloud.width  = 100000;
+  cloud.height = 1;
+  cloud.points.resize (cloud.width * cloud.height);
+  cloud.is_dense = true;
+
+  srand (static_cast<unsigned int> (time (NULL)));
+  for (size_t i = 0; i < cloud.points.size (); ++i)
+  {
+    cloud.points[i].x = static_cast<float> (1024.0 * rand () / (RAND_MAX + 1.0));
+    cloud.points[i].y = static_cast<float> (1024.0 * rand () / (RAND_MAX + 1.0));
+    cloud.points[i].z = static_cast<float> (1024.0 * rand () / (RAND_MAX + 1.0));
+    cloud.points[i].normal_x = static_cast<float> (i);
+    cloud.points[i].rgb = static_cast<float> (1024.0 * rand () / (RAND_MAX + 1.0));
+  }
+
+  // Append the cloud in pieces of different sizes
+  PCDStreamWriter writer;
+  EXPECT_EQ (writer.open<PointXYZRGBNormal> ("test_pcl_io_stream.pcd"), 0);
+  for (size_t first = 0; first < cloud.points.size (); )
+  {
+    PointCloud<PointXYZRGBNormal> piece;
+    for (size_t i = first; i < cloud.points.size () && i < first + 7001; ++i)
+      piece.push_back (cloud.points[i]);
+    EXPECT_EQ (writer.append (piece), 0);
+    first += piece.points.size ();
+  }
+  EXPECT_EQ (writer.getNumberOfPoints (), cloud.points.size ());
+  EXPECT_EQ (writer.close (), 0);
+
+  PointCloud<PointXYZRGBNormal> cloud2;
+  EXPECT_EQ (loadPCDFile ("test_pcl_io_stream.pcd", cloud2), 0);
+  ASSERT_EQ (cloud2.points.size (), cloud.points.size ());
+  for (size_t i = 0; i < cloud2.points.size (); ++i)
+  {
+    ASSERT_EQ (cloud2.points[i].x, cloud.points[i].x);
+    ASSERT_EQ (cloud2.points[i].normal_x, cloud.points[i].normal_x);
+    ASSERT_EQ (cloud2.points[i].rgb, cloud.points[i].rgb);
+  }
+
+  // Clouds with other fields are rejected
+  PointCloud<PointXYZ> xyz;
+  xyz.push_back (PointXYZ (1.0f, 2.0f, 3.0f));
+  EXPECT_EQ (writer.open<PointXYZRGBNormal> ("test_pcl_io_stream.pcd"), 0);
+  EXPECT_LT (writer.append (xyz), 0);
+
+  // Closing without points fails, and does not leave an unreadable file
+  EXPECT_LT (writer.close (), 0);
+  EXPECT_FALSE (writer.isOpen ());
+  EXPECT_FALSE (boost::filesystem::exists ("test_pcl_io_stream.pcd"));
+
+  // Read the cloud back in pieces, from all the formats
+  PCDWriter w;
+  for (int format = 0; format < 4; ++format)
+  {
+    if (format == 0)
+      w.writeASCII<PointXYZRGBNormal> ("test_pcl_io_stream.pcd", cloud);
+    else if (format == 1)
+      w.writeBinary<PointXYZRGBNormal> ("test_pcl_io_stream.pcd", cloud);
+    else if (format == 2)
+      w.writeBinaryCompressed<PointXYZRGBNormal> ("test_pcl_io_stream.pcd", cloud);
+    else
+      w.writeBinaryCompressedChunked<PointXYZRGBNormal> ("test_pcl_io_stream.pcd", cloud, 10000);
+
+    PCDStreamReader reader;
+    EXPECT_EQ (reader.open ("test_pcl_io_stream.pcd"), 0);
+    EXPECT_EQ (reader.getNumberOfPoints (), cloud.points.size ());
+    PointCloud<PointXYZRGBNormal> piece;
+    size_t first = 0;
+    int nr_points;
+    while ((nr_points = reader.readNext (12345, piece)) > 0)
+    {
+      EXPECT_EQ (piece.points.size (), static_cast<size_t> (nr_points));
+      for (size_t i = 0; i < piece.points.size (); ++i)
+      {
+        ASSERT_EQ (piece.points[i].normal_x, cloud.points[first + i].normal_x);
+        if (format == 0)
+          ASSERT_FLOAT_EQ (piece.points[i].x, cloud.points[first + i].x);
+        else
+          ASSERT_EQ (piece.points[i].x, cloud.points[first + i].x);
+      }
+      first += piece.points.size ();
+    }
+    EXPECT_EQ (nr_points, 0);
+    EXPECT_EQ (first, cloud.points.size ());
+    EXPECT_EQ (reader.getNumberOfPointsRead (), cloud.points.size ());
+  }
+
+  remove ("test_pcl_io_stream.pcd");
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 TEST (PCL, Locale)
 {
@@ -41,6 +41,9 @@
 
 #include <pcl/compression/entropy_range_coder.h>
 #include <pcl/compression/impl/entropy_range_coder.hpp>
+#include <pcl/compression/octree_pointcloud_compression.h>
+#include <pcl/compression/impl/octree_pointcloud_compression.hpp>
+#include <pcl/point_types.h>
 
 #include <gtest/gtest.h>
 #include <vector>
@@ -169,6 +172,83 @@ TEST (PCL, Static_Range_Coder_Test)
 }
 
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, Octree_Compression_Subtree_Coding_Test)
+{
+  typedef pcl::io::OctreePointCloudCompression<pcl::PointXYZRGBA> Compression;
+  typedef pcl::PointCloud<pcl::PointXYZRGBA> Cloud;
+
+  Compression plain_encoder (pcl::io::MANUAL_CONFIGURATION, false, 0.001, 0.01, false, 30, true, 6);
+  Compression subtree_encoder (pcl::io::MANUAL_CONFIGURATION, false, 0.001, 0.01, false, 30, true, 6);
+  Compression plain_decoder, subtree_decoder;
+  subtree_encoder.setSubtreeCoding (true);
+  subtree_encoder.setNumberOfThreads (4);
+  subtree_decoder.setNumberOfThreads (4);
+
+  // an intra frame followed by prediction frames
+  for (int frame = 0; frame < 3; ++frame)
+  {
+    Cloud::Ptr cloud (new Cloud);
+    for (int i = 0; i < 5000; ++i)
+    {
+      pcl::PointXYZRGBA p;
+      p.x = static_cast<float> (rand () % 1000) / 1000.0f;
+      p.y = static_cast<float> (rand () % 1000) / 1000.0f;
+      p.z = static_cast<float> (rand () % 1000) / 1000.0f + static_cast<float> (frame) * 0.01f;
+      p.rgba = static_cast<uint32_t> (rand ());
+      cloud->push_back (p);
+    }
+
+    std::stringstream plain_stream, subtree_stream;
+    plain_encoder.encodePointCloud (cloud, plain_stream);
+    subtree_encoder.encodePointCloud (cloud, subtree_stream);
+
+    Cloud::Ptr plain_cloud (new Cloud), subtree_cloud (new Cloud);
+    plain_decoder.decodePointCloud (plain_stream, plain_cloud);
+    subtree_decoder.decodePointCloud (subtree_stream, subtree_cloud);
+
+    // subtree coding only changes how the data is range coded
+    ASSERT_EQ (plain_cloud->size (), subtree_cloud->size ());
+    for (size_t i = 0; i < plain_cloud->size (); ++i)
+    {
+      EXPECT_EQ (plain_cloud->points[i].x, subtree_cloud->points[i].x);
+      EXPECT_EQ (plain_cloud->points[i].y, subtree_cloud->points[i].y);
+      EXPECT_EQ (plain_cloud->points[i].z, subtree_cloud->points[i].z);
+      EXPECT_EQ (plain_cloud->points[i].rgba, subtree_cloud->points[i].rgba);
+    }
+  }
+
+  // decode a region of interest of an intra frame
+  Cloud::Ptr cloud (new Cloud);
+  for (int i = 0; i < 5000; ++i)
+  {
+    pcl::PointXYZRGBA p;
+    p.x = static_cast<float> (rand () % 1000) / 1000.0f;
+    p.y = static_cast<float> (rand () % 1000) / 1000.0f;
+    p.z = static_cast<float> (rand () % 1000) / 1000.0f;
+    cloud->push_back (p);
+  }
+  Compression roi_encoder (pcl::io::MANUAL_CONFIGURATION, false, 0.001, 0.01, false, 30, true, 6);
+  Compression roi_decoder;
+  roi_encoder.setSubtreeCoding (true);
+
+  std::stringstream roi_stream;
+  roi_encoder.encodePointCloud (cloud, roi_stream);
+  Cloud::Ptr roi_cloud (new Cloud);
+  const Eigen::Vector3d min_pt (0.0, 0.0, 0.0), max_pt (0.2, 0.2, 0.2);
+  roi_decoder.decodePointCloud (roi_stream, roi_cloud, min_pt, max_pt);
+
+  size_t inside_roi = 0, decoded_inside_roi = 0;
+  for (size_t i = 0; i < cloud->size (); ++i)
+    if (cloud->points[i].x <= 0.2f && cloud->points[i].y <= 0.2f && cloud->points[i].z <= 0.2f)
+      ++inside_roi;
+  for (size_t i = 0; i < roi_cloud->size (); ++i)
+    if (roi_cloud->points[i].x <= 0.2f && roi_cloud->points[i].y <= 0.2f && roi_cloud->points[i].z <= 0.2f)
+      ++decoded_inside_roi;
+
+  EXPECT_LT (roi_cloud->size (), cloud->size ());
+  EXPECT_EQ (inside_roi, decoded_inside_roi);
+}
 
 /* ---[ */
 int
@@ -207,6 +207,38 @@ TEST (PCL, KdTreeFLANN_nearestKSearch)
   }
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, KdTreeFLANN_batchSearch)
+{
+  KdTreeFLANN<MyPoint> kdtree;
+  kdtree.setInputCloud (cloud_big.makeShared ());
+  int no_of_neighbors = 10;
+  double radius = 15.0;
+
+  Neighborhoods knn, radius_nn;
+  kdtree.nearestKSearch (cloud_big, vector<int> (), no_of_neighbors, knn, 4);
+  kdtree.radiusSearch (cloud_big, vector<int> (), radius, radius_nn, 0, 4);
+  ASSERT_EQ (knn.size (), cloud_big.points.size ());
+  ASSERT_EQ (radius_nn.size (), cloud_big.points.size ());
+  EXPECT_EQ (knn.offsets.back (), knn.indices.size ());
+  EXPECT_EQ (radius_nn.offsets.back (), radius_nn.indices.size ());
+
+  vector<int> k_indices, batch_indices;
+  vector<float> k_distances, batch_distances;
+  for (int i = 0; i < static_cast<int> (cloud_big.points.size ()); ++i)
+  {
+    kdtree.nearestKSearch (cloud_big, i, no_of_neighbors, k_indices, k_distances);
+    knn.getNeighbors (i, batch_indices, batch_distances);
+    EXPECT_TRUE (k_indices == batch_indices);
+    EXPECT_TRUE (k_distances == batch_distances);
+
+    kdtree.radiusSearch (cloud_big, i, radius, k_indices, k_distances);
+    radius_nn.getNeighbors (i, batch_indices, batch_distances);
+    EXPECT_TRUE (k_indices == batch_indices);
+    EXPECT_TRUE (k_distances == batch_distances);
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 class MyPointRepresentationXY : public PointRepresentation<MyPoint>
 {
@@ -1081,6 +1081,84 @@ TEST (PCL, Octree_Pointcloud_Change_Detector_Test)
 
 }
 
+TEST (PCL, Octree_Node_Pool_Test)
+{
+  OctreeBase<int> octree;
+  octree.setTreeDepth (8);
+  octree.enableNodePool ();
+
+  srand (static_cast<unsigned int> (time (NULL)));
+
+  std::vector<OctreeKey> keys (256);
+  for (size_t i = 0; i < keys.size (); i++)
+    keys[i] = OctreeKey (rand () % 256, rand () % 256, rand () % 256);
+
+  for (size_t i = 0; i < keys.size (); i++)
+    *octree.createLeaf (keys[i].x, keys[i].y, keys[i].z) = static_cast<int> (i);
+
+  std::size_t node_count = octree.getLeafCount () + octree.getBranchCount () - 1;
+  OctreeNodePoolStatistics stats = octree.getNodePoolStatistics ();
+  ASSERT_EQ (stats.allocations, node_count);
+  ASSERT_EQ (stats.pool_hits, 0u);
+
+  // all nodes are moved to the pool
+  octree.deleteTree ();
+  stats = octree.getNodePoolStatistics ();
+  ASSERT_EQ (stats.pooled_nodes, node_count);
+  ASSERT_EQ (octree.getLeafCount (), 0u);
+
+  // rebuilding the same tree reuses all nodes, with freshly reset leaf containers
+  octree.resetNodePoolStatistics ();
+  for (size_t i = 0; i < keys.size (); i++)
+  {
+    int* leaf = octree.createLeaf (keys[i].x, keys[i].y, keys[i].z);
+    if (*leaf == 0)
+      *leaf = static_cast<int> (i) + 1;
+  }
+  stats = octree.getNodePoolStatistics ();
+  ASSERT_EQ (stats.allocations, 0u);
+  ASSERT_EQ (stats.pool_hits, node_count);
+  ASSERT_EQ (stats.pooled_nodes, 0u);
+  ASSERT_EQ (stats.peak_memory, stats.memory);
+  for (size_t i = 0; i < keys.size (); i++)
+    ASSERT_NE (*octree.findLeaf (keys[i].x, keys[i].y, keys[i].z), 0);
+
+  // change detection with and without node pool must give identical results
+  OctreePointCloudChangeDetector<PointXYZ> detector (0.1f);
+  OctreePointCloudChangeDetector<PointXYZ> pooled_detector (0.1f);
+  pooled_detector.enableNodePool ();
+  pooled_detector.defineBoundingBox (0.0, 0.0, 0.0, 10.0, 10.0, 10.0);
+  detector.defineBoundingBox (0.0, 0.0, 0.0, 10.0, 10.0, 10.0);
+
+  for (int frame = 0; frame < 5; frame++)
+  {
+    PointCloud<PointXYZ>::Ptr cloudIn (new PointCloud<PointXYZ> (1000, 1));
+    for (size_t i = 0; i < cloudIn->points.size (); i++)
+      cloudIn->points[i] = PointXYZ (static_cast<float> (10.0 * rand () / RAND_MAX),
+                                     static_cast<float> (10.0 * rand () / RAND_MAX),
+                                     static_cast<float> (10.0 * rand () / RAND_MAX));
+
+    detector.switchBuffers ();
+    pooled_detector.switchBuffers ();
+    detector.setInputCloud (cloudIn);
+    pooled_detector.setInputCloud (cloudIn);
+    detector.addPointsFromInputCloud ();
+    pooled_detector.addPointsFromInputCloud ();
+
+    std::vector<int> new_points, pooled_new_points;
+    detector.getPointIndicesFromNewVoxels (new_points);
+    pooled_detector.getPointIndicesFromNewVoxels (pooled_new_points);
+    ASSERT_EQ (new_points.size (), pooled_new_points.size ());
+    for (size_t i = 0; i < new_points.size (); i++)
+      ASSERT_EQ (new_points[i], pooled_new_points[i]);
+    ASSERT_EQ (detector.getLeafCount (), pooled_detector.getLeafCount ());
+  }
+
+  stats = pooled_detector.getNodePoolStatistics ();
+  EXPECT_GT (stats.pool_hits, 0u);
+  EXPECT_GE (stats.peak_memory, stats.memory);
+}
+
 TEST (PCL, Octree_Pointcloud_Voxel_Centroid_Test)
 {
 
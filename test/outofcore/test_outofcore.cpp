@@ -949,6 +949,148 @@ TEST_F (OutofcoreTest, PointCloud2_Query)
   cleanUpFilesystem ();
 }
 
+//test that multi-threaded insertion stores the same points as the serial insertion
+TEST_F (OutofcoreTest, Outofcore_MultiThreadedConstruction)
+{
+  cleanUpFilesystem ();
+
+  const Eigen::Vector3d min (-32.0, -32.0, -32.0);
+  const Eigen::Vector3d max (32.0, 32.0, 32.0);
+  const boost::uint64_t depth = 3;
+
+  boost::mt19937 rng (rngseed);
+  boost::uniform_real<float> dist (-31.0f, 31.0f);
+
+  AlignedPointTVector some_points (numPts);
+  for (size_t i = 0; i < numPts; i++)
+    some_points[i] = PointT (dist (rng), dist (rng), dist (rng));
+
+  octree_disk serial_leaf (depth, min, max, filename_otreeA, "ECEF");
+  octree_disk parallel_leaf (depth, min, max, filename_otreeB, "ECEF");
+  parallel_leaf.setNumberOfThreads (4);
+  parallel_leaf.setWriteQueueSize (4);
+  EXPECT_EQ (4, parallel_leaf.getNumberOfThreads ());
+
+  EXPECT_EQ (numPts, serial_leaf.addDataToLeaf (some_points));
+  EXPECT_EQ (numPts, parallel_leaf.addDataToLeaf (some_points));
+
+  AlignedPointTVector serial_result, parallel_result;
+  serial_leaf.queryBBIncludes (min, max, depth, serial_result);
+  parallel_leaf.queryBBIncludes (min, max, depth, parallel_result);
+  ASSERT_EQ (numPts, serial_result.size ());
+  ASSERT_EQ (serial_result.size (), parallel_result.size ());
+  for (size_t i = 0; i < serial_result.size (); i++)
+    EXPECT_TRUE (compPt (serial_result[i], parallel_result[i]));
+
+  octree_disk serial_lod (depth, min, max, filename_otreeA_LOD, "ECEF");
+  octree_disk parallel_lod (depth, min, max, filename_otreeB_LOD, "ECEF");
+  parallel_lod.setNumberOfThreads (4);
+
+  serial_lod.addDataToLeaf_and_genLOD (some_points);
+  parallel_lod.addDataToLeaf_and_genLOD (some_points);
+
+  //LOD samples are seeded per node, so they do not depend on the number of threads
+  for (boost::uint64_t d = 0; d <= depth; d++)
+  {
+    EXPECT_EQ (serial_lod.getNumPointsAtDepth (d), parallel_lod.getNumPointsAtDepth (d));
+
+    AlignedPointTVector serial_lod_result, parallel_lod_result;
+    serial_lod.queryBBIncludes (min, max, d, serial_lod_result);
+    parallel_lod.queryBBIncludes (min, max, d, parallel_lod_result);
+    ASSERT_EQ (serial_lod_result.size (), parallel_lod_result.size ());
+    for (size_t i = 0; i < serial_lod_result.size (); i++)
+      EXPECT_TRUE (compPt (serial_lod_result[i], parallel_lod_result[i]));
+  }
+
+  cleanUpFilesystem ();
+}
+
+void
+appendJobIndex (std::vector<int>& done, int index)
+{
+  done.push_back (index);
+}
+
+void
+failingJob ()
+{
+  throw std::runtime_error ("disk full");
+}
+
+//test that a failed write job is reported by flush and stops the later jobs
+TEST (PCL, Outofcore_AsyncWriterError)
+{
+  std::vector<int> done;
+  pcl::outofcore::OutofcoreAsyncWriter writer (2);
+  writer.push (boost::bind (&appendJobIndex, boost::ref (done), 0));
+  writer.push (&failingJob);
+  for (int i = 1; i < 8; i++)
+    writer.push (boost::bind (&appendJobIndex, boost::ref (done), i));
+
+  EXPECT_THROW (writer.flush (), std::exception);
+  ASSERT_EQ (1, done.size ());
+  EXPECT_EQ (0, done[0]);
+
+  pcl::outofcore::OutofcoreAsyncWriter ok_writer;
+  for (int i = 1; i < 8; i++)
+    ok_writer.push (boost::bind (&appendJobIndex, boost::ref (done), i));
+  EXPECT_NO_THROW (ok_writer.flush ());
+  EXPECT_EQ (8, done.size ());
+}
+
+//test the range reads and the cached payloads of the disk container
+TEST_F (OutofcoreTest, DiskContainer_ReadRange)
+{
+  cleanUpFilesystem ();
+  boost::filesystem::create_directory (outofcore_path.parent_path ());
+
+  const boost::filesystem::path payload_path = outofcore_path.parent_path () / "payload.pcd";
+
+  AlignedPointTVector points;
+  for (size_t i = 0; i < 100; i++)
+    points.push_back (PointT (static_cast<float> (i), 0.0f, 0.0f));
+
+  {
+    OutofcoreOctreeDiskContainer<PointT> container (payload_path);
+    container.insertRange (&points[0], 60);
+    EXPECT_EQ (60, container.size ());
+
+    for (size_t i = 60; i < 100; i++)
+      container.push_back (points[i]);
+    EXPECT_EQ (100, container.size ());
+
+    //range spanning the file and the write buffer
+    AlignedPointTVector dst;
+    container.readRange (50, 20, dst);
+    ASSERT_EQ (20, dst.size ());
+    for (size_t i = 0; i < dst.size (); i++)
+      EXPECT_EQ (static_cast<float> (50 + i), dst[i].x);
+  }
+
+  //reopen from disk, with and without the payload cache
+  for (int pass = 0; pass < 2; pass++)
+  {
+    if (pass == 1)
+      OutofcoreOctreeDiskContainer<PointT>::clearPayloadCache ();
+
+    OutofcoreOctreeDiskContainer<PointT> container (payload_path);
+    EXPECT_EQ (100, container.size ());
+
+    AlignedPointTVector dst;
+    container.readRange (10, 5, dst);
+    ASSERT_EQ (5, dst.size ());
+    for (size_t i = 0; i < dst.size (); i++)
+      EXPECT_EQ (static_cast<float> (10 + i), dst[i].x);
+
+    dst.clear ();
+    container.readRange (0, container.size (), dst);
+    ASSERT_EQ (100, dst.size ());
+    EXPECT_EQ (99.0f, dst.back ().x);
+  }
+
+  cleanUpFilesystem ();
+}
+
 /* [--- */
 int
 main (int argc, char** argv)
@@ -40,6 +40,14 @@
 #include <pcl/registration/correspondence_estimation_normal_shooting.h>
 #include <pcl/features/normal_3d.h>
 #include <pcl/kdtree/kdtree.h>
+#include <pcl/kdtree/kdtree_flann.h>
+#include <pcl/point_types_conversion.h>
+#include <pcl/common/quantized_descriptors.h>
+#include <pcl/search/quantized_descriptors.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 TEST (CorrespondenceEstimation, CorrespondenceEstimationNormalShooting)
@@ -119,6 +127,128 @@ TEST (CorrespondenceEstimation, CorrespondenceEstimationSetSearchMethod)
   
 }
 
+//////////////////////////////////////////////////////////////////////////////////////
+TEST (CorrespondenceEstimation, CorrespondenceEstimationQuantizedSHOT)
+{
+  // Random sparse SHOT descriptors, and the same ones slightly perturbed
+  srand (0);
+  pcl::PointCloud<pcl::SHOT352> targets, queries;
+  targets.resize (200);
+  queries.resize (200);
+  for (size_t p = 0; p < targets.size (); ++p)
+  {
+    for (int i = 0; i < 9; ++i)
+      targets[p].rf[i] = 0.0f;
+    for (int i = 0; i < 352; ++i)
+    {
+      targets[p].descriptor[i] = rand () % 4 == 0 ? static_cast<float> (rand ()) / static_cast<float> (RAND_MAX) : 0.0f;
+      queries[p].descriptor[i] = targets[p].descriptor[i] + 0.01f * static_cast<float> (rand ()) / static_cast<float> (RAND_MAX);
+    }
+  }
+
+  pcl::PointCloud<pcl::QuantizedSHOT352>::Ptr quantized_targets (new pcl::PointCloud<pcl::QuantizedSHOT352>);
+  pcl::PointCloud<pcl::QuantizedSHOT352>::Ptr quantized_queries (new pcl::PointCloud<pcl::QuantizedSHOT352>);
+  pcl::PointCloudSHOT352toQuantizedSHOT352 (targets, *quantized_targets);
+  pcl::PointCloudSHOT352toQuantizedSHOT352 (queries, *quantized_queries);
+
+  std::vector<int> nearest;
+  std::vector<float> nearest_distances;
+  pcl::nearestDescriptors (*quantized_queries, *quantized_targets, nearest, nearest_distances);
+
+  // Directly through the precompiled FLANN tree
+  pcl::KdTreeFLANN<pcl::QuantizedSHOT352> tree;
+  tree.setInputCloud (quantized_targets);
+  std::vector<int> k_indices (1);
+  std::vector<float> k_distances (1);
+  for (size_t q = 0; q < quantized_queries->size (); ++q)
+  {
+    ASSERT_EQ (1, tree.nearestKSearch ((*quantized_queries)[q], 1, k_indices, k_distances));
+    EXPECT_EQ (static_cast<int> (q), k_indices[0]);
+    EXPECT_EQ (nearest[q], k_indices[0]);
+    EXPECT_NEAR (nearest_distances[q], k_distances[0], 1e-4);
+  }
+
+  // Through the default search method of the correspondence estimation
+  pcl::registration::CorrespondenceEstimation<pcl::QuantizedSHOT352, pcl::QuantizedSHOT352> ce;
+  ce.setInputSource (quantized_queries);
+  ce.setInputTarget (quantized_targets);
+  pcl::Correspondences corr;
+  ce.determineCorrespondences (corr);
+  ASSERT_EQ (quantized_queries->size (), corr.size ());
+  for (size_t i = 0; i < corr.size (); ++i)
+  {
+    EXPECT_EQ (corr[i].index_query, corr[i].index_match);
+    EXPECT_EQ (nearest[corr[i].index_query], corr[i].index_match);
+  }
+
+  // Through the byte level search given as target search method
+  pcl::search::QuantizedDescriptorSearch<pcl::QuantizedSHOT352>::Ptr byte_search (new pcl::search::QuantizedDescriptorSearch<pcl::QuantizedSHOT352>);
+  ce.setSearchMethodTarget (byte_search);
+  pcl::Correspondences byte_corr;
+  ce.determineCorrespondences (byte_corr);
+  ASSERT_EQ (quantized_queries->size (), byte_corr.size ());
+  for (size_t i = 0; i < byte_corr.size (); ++i)
+  {
+    EXPECT_EQ (nearest[byte_corr[i].index_query], byte_corr[i].index_match);
+    EXPECT_EQ (nearest_distances[byte_corr[i].index_query], byte_corr[i].distance);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+TEST (CorrespondenceEstimation, QuantizedDescriptorSearch)
+{
+  pcl::PointCloud<pcl::FPFHSignature33> signatures;
+  signatures.resize (300);
+  srand (0);
+  for (size_t p = 0; p < signatures.size (); ++p)
+    for (int i = 0; i < 33; ++i)
+      signatures[p].histogram[i] = static_cast<float> (rand () % 20);
+  // A signature that cannot be restored is never returned
+  signatures[7].histogram[3] = std::numeric_limits<float>::quiet_NaN ();
+
+  pcl::PointCloud<pcl::QuantizedFPFHSignature33>::Ptr quantized (new pcl::PointCloud<pcl::QuantizedFPFHSignature33>);
+  pcl::PointCloudFPFHSignature33toQuantizedFPFHSignature33 (signatures, *quantized);
+
+  boost::shared_ptr<std::vector<int> > indices (new std::vector<int>);
+  for (int i = 0; i < 300; i += 2)
+    indices->push_back (i);
+
+  pcl::search::QuantizedDescriptorSearch<pcl::QuantizedFPFHSignature33> search;
+  for (int with_indices = 0; with_indices < 2; ++with_indices)
+  {
+    search.setInputCloud (quantized, with_indices ? indices : boost::shared_ptr<std::vector<int> > ());
+    for (size_t q = 10; q < 30; ++q)
+    {
+      // Exhaustive reference, sorted by distance and then by index
+      std::vector<std::pair<float, int> > expected;
+      for (int j = 0; j < 300; ++j)
+        if ((!with_indices || j % 2 == 0) && j != 7)
+          expected.push_back (std::make_pair (pcl::squaredDescriptorDistance ((*quantized)[q], (*quantized)[j]), j));
+      std::sort (expected.begin (), expected.end ());
+
+      std::vector<int> k_indices;
+      std::vector<float> k_sqr_distances;
+      ASSERT_EQ (5, search.nearestKSearch ((*quantized)[q], 5, k_indices, k_sqr_distances));
+      for (int i = 0; i < 5; ++i)
+      {
+        EXPECT_EQ (expected[i].second, k_indices[i]);
+        EXPECT_EQ (expected[i].first, k_sqr_distances[i]);
+      }
+
+      const double radius = std::sqrt (static_cast<double> (expected[10].first));
+      const int nr_in_radius = search.radiusSearch ((*quantized)[q], radius, k_indices, k_sqr_distances);
+      ASSERT_EQ (static_cast<int> (std::upper_bound (expected.begin (), expected.end (), std::make_pair (expected[10].first, 300)) - expected.begin ()), nr_in_radius);
+      for (int i = 0; i < nr_in_radius; ++i)
+        EXPECT_EQ (expected[i].second, k_indices[i]);
+      EXPECT_EQ (3, search.radiusSearch ((*quantized)[q], radius, k_indices, k_sqr_distances, 3));
+    }
+  }
+
+  std::vector<int> k_indices;
+  std::vector<float> k_sqr_distances;
+  EXPECT_EQ (0, search.nearestKSearch ((*quantized)[7], 5, k_indices, k_sqr_distances));
+}
+
 /* ---[ */
 int
   main (int argc, char** argv)
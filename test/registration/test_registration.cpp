@@ -199,6 +199,66 @@ TEST (PCL, IterativeClosestPoint)
 //  EXPECT_EQ (transformation (3, 3), 1);
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, IterativeClosestPointMultiThreaded)
+{
+  PointCloud<PointXYZ> cloud_reg_serial, cloud_reg_parallel;
+
+  IterativeClosestPoint<PointXYZ, PointXYZ> reg;
+  reg.setInputSource (cloud_source.makeShared ());
+  reg.setInputTarget (cloud_target.makeShared ());
+  reg.setMaximumIterations (50);
+  reg.setTransformationEpsilon (1e-8);
+  reg.setMaxCorrespondenceDistance (0.05);
+  reg.align (cloud_reg_serial);
+  const Eigen::Matrix4f transformation_serial = reg.getFinalTransformation ();
+
+  // The correspondences do not depend on the number of threads, hence neither does the result
+  reg.setNumberOfThreads (4);
+#ifdef _OPENMP
+  EXPECT_EQ (4, reg.getNumberOfThreads ());
+#else
+  EXPECT_EQ (1, reg.getNumberOfThreads ());
+#endif
+  reg.align (cloud_reg_parallel);
+  EXPECT_EQ (int (cloud_reg_parallel.points.size ()), int (cloud_source.points.size ()));
+
+  const Eigen::Matrix4f transformation_parallel = reg.getFinalTransformation ();
+  for (int i = 0; i < 4; ++i)
+    for (int j = 0; j < 4; ++j)
+      EXPECT_EQ (transformation_serial (i, j), transformation_parallel (i, j));
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, IterativeClosestPointCorrespondenceEstimationThreads)
+{
+  PointCloud<PointXYZ> cloud_reg;
+
+  IterativeClosestPoint<PointXYZ, PointXYZ> reg;
+  reg.setInputSource (cloud_source.makeShared ());
+  reg.setInputTarget (cloud_target.makeShared ());
+  reg.setMaximumIterations (5);
+
+  // The number of threads of the correspondence estimation is kept unless set on the registration
+  registration::CorrespondenceEstimation<PointXYZ, PointXYZ>::Ptr corr_est (new registration::CorrespondenceEstimation<PointXYZ, PointXYZ>);
+  corr_est->setNumberOfThreads (3);
+  reg.setCorrespondenceEstimation (corr_est);
+  reg.align (cloud_reg);
+#ifdef _OPENMP
+  EXPECT_EQ (3, corr_est->getNumberOfThreads ());
+#else
+  EXPECT_EQ (1, corr_est->getNumberOfThreads ());
+#endif
+
+  reg.setNumberOfThreads (2);
+  reg.align (cloud_reg);
+#ifdef _OPENMP
+  EXPECT_EQ (2, corr_est->getNumberOfThreads ());
+#else
+  EXPECT_EQ (1, corr_est->getNumberOfThreads ());
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 void
 sampleRandomTransform (Eigen::Affine3f &trans, float max_angle, float max_trans)
@@ -625,6 +685,49 @@ TEST (PCL, NormalDistributionsTransform)
   }
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, NormalDistributionsTransformMultiThreaded)
+{
+  typedef PointNormal PointT;
+  PointCloud<PointT>::Ptr src (new PointCloud<PointT>);
+  copyPointCloud (cloud_source, *src);
+  PointCloud<PointT>::Ptr tgt (new PointCloud<PointT>);
+  copyPointCloud (cloud_target, *tgt);
+  PointCloud<PointT> output;
+
+  NormalDistributionsTransform<PointT, PointT> reg;
+  reg.setStepSize (0.05);
+  reg.setResolution (0.025f);
+  reg.setInputSource (src);
+  reg.setInputTarget (tgt);
+  reg.setMaximumIterations (50);
+  reg.setTransformationEpsilon (1e-8);
+  reg.setNumberOfThreads (1);
+  reg.align (output);
+  Eigen::Matrix4f serial_transformation = reg.getFinalTransformation ();
+  double serial_probability = reg.getTransformationProbability ();
+
+#ifdef _OPENMP
+  // Summing the per thread contributions reorders the floating point additions, but must not change the result
+  reg.setNumberOfThreads (4);
+  EXPECT_EQ (reg.getNumberOfThreads (), 4);
+  reg.align (output);
+  EXPECT_EQ (int (output.points.size ()), int (cloud_source.points.size ()));
+  EXPECT_LT (reg.getFitnessScore (), 0.001);
+  EXPECT_NEAR (reg.getTransformationProbability (), serial_probability, 1e-4);
+  for (int y = 0; y < 4; y++)
+    for (int x = 0; x < 4; x++)
+      EXPECT_NEAR (reg.getFinalTransformation () (y, x), serial_transformation (y, x), 1e-4);
+#endif
+
+  // The direct voxel lookups skip the kd-tree search
+  typedef NormalDistributionsTransform<PointT, PointT> NDT;
+  reg.setNeighborhoodSearchMethod (NDT::DIRECT7);
+  EXPECT_EQ (reg.getNeighborhoodSearchMethod (), NDT::DIRECT7);
+  reg.align (output);
+  EXPECT_EQ (int (output.points.size ()), int (cloud_source.points.size ()));
+  EXPECT_LT (reg.getFitnessScore (), 0.001);
+}
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 TEST (PCL, SampleConsensusInitialAlignment)
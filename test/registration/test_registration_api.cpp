@@ -45,6 +45,8 @@
 #include <pcl/io/pcd_io.h>
 #include <pcl/registration/eigen.h>
 #include <pcl/registration/correspondence_estimation.h>
+#include <pcl/registration/correspondence_estimation_normal_shooting.h>
+#include <pcl/registration/correspondence_estimation_backprojection.h>
 #include <pcl/registration/correspondence_rejection_distance.h>
 #include <pcl/registration/correspondence_rejection_median_distance.h>
 #include <pcl/registration/correspondence_rejection_surface_normal.h>
@@ -122,6 +124,105 @@ TEST (PCL, CorrespondenceEstimationReciprocal)
   }
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, CorrespondenceEstimationMultiThreaded)
+{
+  CloudXYZConstPtr source (new CloudXYZ (cloud_source));
+  CloudXYZConstPtr target (new CloudXYZ (cloud_target));
+
+  boost::shared_ptr<pcl::Correspondences> correspondences (new pcl::Correspondences);
+  pcl::registration::CorrespondenceEstimation<PointXYZ, PointXYZ> corr_est;
+  corr_est.setInputSource (source);
+  corr_est.setInputTarget (target);
+  corr_est.setNumberOfThreads (4);
+
+  // the result must not depend on the number of threads, also when the buffers are reused
+  for (int run = 0; run < 2; ++run)
+  {
+    corr_est.determineCorrespondences (*correspondences);
+    EXPECT_EQ (int (correspondences->size ()), nr_original_correspondences);
+    if (int (correspondences->size ()) == nr_original_correspondences)
+    {
+      for (int i = 0; i < nr_original_correspondences; ++i)
+      {
+        EXPECT_EQ ((*correspondences)[i].index_query, i);
+        EXPECT_EQ ((*correspondences)[i].index_match, correspondences_original[i][1]);
+      }
+    }
+
+    corr_est.determineReciprocalCorrespondences (*correspondences);
+    EXPECT_EQ (int (correspondences->size ()), nr_reciprocal_correspondences);
+    if (int (correspondences->size ()) == nr_reciprocal_correspondences)
+    {
+      for (int i = 0; i < nr_reciprocal_correspondences; ++i)
+      {
+        EXPECT_EQ ((*correspondences)[i].index_query, correspondences_reciprocal[i][0]);
+        EXPECT_EQ ((*correspondences)[i].index_match, correspondences_reciprocal[i][1]);
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename CorrespondenceEstimationT> void
+checkMultiThreadedCorrespondences (CorrespondenceEstimationT &corr_est)
+{
+  pcl::Correspondences serial, parallel;
+  for (int reciprocal = 0; reciprocal < 2; ++reciprocal)
+  {
+    corr_est.setNumberOfThreads (1);
+    if (reciprocal)
+      corr_est.determineReciprocalCorrespondences (serial);
+    else
+      corr_est.determineCorrespondences (serial);
+    EXPECT_FALSE (serial.empty ());
+
+    corr_est.setNumberOfThreads (4);
+    if (reciprocal)
+      corr_est.determineReciprocalCorrespondences (parallel);
+    else
+      corr_est.determineCorrespondences (parallel);
+
+    ASSERT_EQ (serial.size (), parallel.size ());
+    for (size_t i = 0; i < serial.size (); ++i)
+    {
+      EXPECT_EQ (serial[i].index_query, parallel[i].index_query);
+      EXPECT_EQ (serial[i].index_match, parallel[i].index_match);
+      EXPECT_EQ (serial[i].distance, parallel[i].distance);
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, CorrespondenceEstimationNormalsMultiThreaded)
+{
+  CloudNormalPtr source (new CloudNormal ());
+  pcl::copyPointCloud (cloud_source, *source);
+  CloudNormalPtr target (new CloudNormal ());
+  pcl::copyPointCloud (cloud_target, *target);
+
+  pcl::NormalEstimation<PointNormal, PointNormal> norm_est;
+  norm_est.setSearchMethod (pcl::search::KdTree<PointNormal>::Ptr (new pcl::search::KdTree<PointNormal>));
+  norm_est.setKSearch (10);
+  norm_est.setInputCloud (source);
+  norm_est.compute (*source);
+  norm_est.setInputCloud (target);
+  norm_est.compute (*target);
+
+  pcl::registration::CorrespondenceEstimationNormalShooting<PointNormal, PointNormal, PointNormal> corr_est_shooting;
+  corr_est_shooting.setInputSource (source);
+  corr_est_shooting.setSourceNormals (source);
+  corr_est_shooting.setInputTarget (target);
+  checkMultiThreadedCorrespondences (corr_est_shooting);
+
+  pcl::registration::CorrespondenceEstimationBackProjection<PointNormal, PointNormal, PointNormal> corr_est_backprojection;
+  corr_est_backprojection.setInputSource (source);
+  corr_est_backprojection.setSourceNormals (source);
+  corr_est_backprojection.setInputTarget (target);
+  corr_est_backprojection.setTargetNormals (target);
+  checkMultiThreadedCorrespondences (corr_est_backprojection);
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 TEST (PCL, CorrespondenceRejectorDistance)
 {
@@ -147,6 +147,49 @@ TEST (SampleConsensusModelPlane, RANSAC)
   verifyPlaneSac (model, sac);
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (SampleConsensusModelPlane, RANSACMultiThreaded)
+{
+  srand (0);
+
+  // Create a shared plane model pointer directly
+  SampleConsensusModelPlanePtr model (new SampleConsensusModelPlane<PointXYZ> (cloud_));
+
+  // Create the RANSAC object, evaluating the hypotheses with 4 threads
+  RandomSampleConsensus<PointXYZ> sac (model, 0.03);
+  sac.setNumberOfThreads (4);
+
+  verifyPlaneSac (model, sac);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (SampleConsensusModelPlane, CountWithinDistance)
+{
+  SampleConsensusModelPlanePtr model (new SampleConsensusModelPlane<PointXYZ> (cloud_));
+
+  // Use a number of indices which is not a multiple of 4 to exercise the remainder of the vectorized loops
+  std::vector<int> indices (indices_.begin (), indices_.end () - 3);
+  model->setIndices (indices);
+
+  Eigen::VectorXf coeff (4);
+  coeff << plane_coeffs_[0], plane_coeffs_[1], plane_coeffs_[2], 1.0f;
+  coeff /= coeff.head<3> ().norm ();
+
+  std::vector<int> inliers;
+  model->selectWithinDistance (coeff, 0.03, inliers);
+  EXPECT_LT (2000, inliers.size ());
+  EXPECT_EQ (inliers.size (), model->countWithinDistance (coeff, 0.03));
+
+  // The inliers, and their distances, must match the scalar evaluation of the model
+  std::vector<double> distances;
+  model->getDistancesToModel (coeff, distances);
+  std::vector<int> expected_inliers;
+  for (size_t i = 0; i < distances.size (); ++i)
+    if (distances[i] < 0.03)
+      expected_inliers.push_back (indices[i]);
+  EXPECT_EQ (expected_inliers, inliers);
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 TEST (SampleConsensusModelPlane, LMedS)
 {
@@ -175,6 +218,21 @@ TEST (SampleConsensusModelPlane, MSAC)
   verifyPlaneSac (model, sac);
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (SampleConsensusModelPlane, MSACMultiThreaded)
+{
+  srand (0);
+
+  // Create a shared plane model pointer directly
+  SampleConsensusModelPlanePtr model (new SampleConsensusModelPlane<PointXYZ> (cloud_));
+
+  // Create the MSAC object, evaluating the hypotheses with 4 threads
+  MEstimatorSampleConsensus<PointXYZ> sac (model, 0.03);
+  sac.setNumberOfThreads (4);
+
+  verifyPlaneSac (model, sac);
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 TEST (SampleConsensusModelPlane, RRANSAC)
 {
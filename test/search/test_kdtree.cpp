@@ -195,6 +195,53 @@ TEST (PCL, KdTree_multipointKnnSearch)
   }
 }
 
+/* Test for KdTree batch searches with multiple threads */
+TEST (PCL, KdTree_batchSearch)
+{
+  unsigned int no_of_neighbors = 20;
+  double radius = 20.0;
+
+  pcl::search::Search<PointXYZ>* kdtree = new pcl::search::KdTree<PointXYZ> ();
+  kdtree->setInputCloud (cloud_big.makeShared ());
+
+  std::vector<int> query_indices;
+  for (int i = 0; i < static_cast<int> (cloud_big.points.size ()); i += 3)
+    query_indices.push_back (i);
+
+  pcl::Neighborhoods knn, radius_nn;
+  kdtree->nearestKSearch (cloud_big, query_indices, no_of_neighbors, knn, 4);
+  kdtree->radiusSearch (cloud_big, query_indices, radius, radius_nn, 0, 4);
+  ASSERT_EQ (knn.size (), query_indices.size ());
+  ASSERT_EQ (radius_nn.size (), query_indices.size ());
+
+  vector<int> k_indices;
+  vector<float> k_distances;
+  for (size_t i = 0; i < query_indices.size (); ++i)
+  {
+    kdtree->nearestKSearch (cloud_big, query_indices[i], no_of_neighbors, k_indices, k_distances);
+    ASSERT_EQ (k_indices.size (), knn.getNumberOfNeighbors (i));
+    for (size_t j = 0; j < k_indices.size (); ++j)
+    {
+      EXPECT_EQ (k_indices[j], knn.indices[knn.offsets[i] + j]);
+      EXPECT_EQ (k_distances[j], knn.sqr_distances[knn.offsets[i] + j]);
+    }
+
+    kdtree->radiusSearch (cloud_big, query_indices[i], radius, k_indices, k_distances);
+    ASSERT_EQ (k_indices.size (), radius_nn.getNumberOfNeighbors (i));
+    for (size_t j = 0; j < k_indices.size (); ++j)
+    {
+      EXPECT_EQ (k_indices[j], radius_nn.indices[radius_nn.offsets[i] + j]);
+      EXPECT_EQ (k_distances[j], radius_nn.sqr_distances[radius_nn.offsets[i] + j]);
+    }
+  }
+
+  // An empty index vector queries the whole cloud
+  kdtree->nearestKSearch (cloud_big, std::vector<int> (), no_of_neighbors, knn, 0);
+  EXPECT_EQ (knn.size (), cloud_big.points.size ());
+  EXPECT_EQ (knn.indices.size (), cloud_big.points.size () * no_of_neighbors);
+  delete kdtree;
+}
+
 int
 main (int argc, char** argv)
 {
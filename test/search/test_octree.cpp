@@ -362,6 +362,47 @@ TEST (PCL, Octree_Pointcloud_Neighbours_Within_Radius_Search)
   }
 }
 
+TEST (PCL, Octree_Pointcloud_Batch_Search)
+{
+  PointCloud<PointXYZ>::Ptr cloudIn (new PointCloud<PointXYZ> ());
+  cloudIn->width = 5000;
+  cloudIn->height = 1;
+  cloudIn->points.resize (cloudIn->width * cloudIn->height);
+  srand (static_cast<unsigned int> (time (NULL)));
+  for (size_t i = 0; i < cloudIn->points.size (); ++i)
+    cloudIn->points[i] = PointXYZ (static_cast<float> (10.0 * (rand () / static_cast<double> (RAND_MAX))),
+                                   static_cast<float> (10.0 * (rand () / static_cast<double> (RAND_MAX))),
+                                   static_cast<float> (10.0 * (rand () / static_cast<double> (RAND_MAX))));
+
+  pcl::search::Octree<PointXYZ> octree (0.5);
+  octree.setInputCloud (cloudIn);
+
+  std::vector<int> queries;
+  for (int i = 0; i < static_cast<int> (cloudIn->points.size ()); i += 7)
+    queries.push_back (i);
+
+  pcl::Neighborhoods knn, radius_nn;
+  octree.nearestKSearch (*cloudIn, queries, 8, knn, 4);
+  octree.radiusSearch (*cloudIn, queries, 0.6, radius_nn, 0, 4);
+  ASSERT_EQ (knn.size (), queries.size ());
+  ASSERT_EQ (radius_nn.size (), queries.size ());
+
+  std::vector<int> k_indices;
+  std::vector<float> k_sqr_distances;
+  for (size_t i = 0; i < queries.size (); ++i)
+  {
+    octree.nearestKSearch (*cloudIn, queries[i], 8, k_indices, k_sqr_distances);
+    ASSERT_EQ (knn.getNumberOfNeighbors (i), k_indices.size ());
+    for (size_t j = 0; j < k_indices.size (); ++j)
+      EXPECT_EQ (k_indices[j], knn.indices[knn.offsets[i] + j]);
+
+    octree.radiusSearch (*cloudIn, queries[i], 0.6, k_indices, k_sqr_distances);
+    ASSERT_EQ (radius_nn.getNumberOfNeighbors (i), k_indices.size ());
+    for (size_t j = 0; j < k_indices.size (); ++j)
+      EXPECT_EQ (k_indices[j], radius_nn.indices[radius_nn.offsets[i] + j]);
+  }
+}
+
 /* ---[ */
 int
 main (int argc, char** argv)
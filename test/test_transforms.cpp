@@ -358,6 +358,114 @@ TEST (PCL, Matrix4Affine3Transform)
   EXPECT_FLOAT_EQ (pt.z, ct[0].z); 
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, TransformLargeCloudWithNormals)
+{
+  // Large enough to be split over threads
+  PointCloud<PointNormal> c;
+  c.width = 100000;
+  c.height = 1;
+  c.resize (c.width);
+  srand (0);
+  for (size_t i = 0; i < c.size (); ++i)
+  {
+    c[i].getVector3fMap () = Eigen::Vector3f::Random () * 10.0f;
+    c[i].getNormalVector3fMap () = Eigen::Vector3f::Random ().normalized ();
+  }
+  c.is_dense = false;
+  c[42].y = std::numeric_limits<float>::quiet_NaN ();
+
+  Eigen::Affine3f transform = Eigen::Translation3f (1.0f, -2.0f, 3.0f) *
+                              Eigen::AngleAxisf (0.7f, Eigen::Vector3f (1.0f, 1.0f, -1.0f).normalized ());
+  Eigen::Affine3d transform_d = transform.cast<double> ();
+
+  PointCloud<PointNormal> ct, ct_d;
+  transformPointCloudWithNormals (c, ct, transform);
+  transformPointCloudWithNormals (c, ct_d, transform_d);
+  PointCloud<PointNormal> c_inplace = c;
+  transformPointCloud (c_inplace, transform);
+
+  ASSERT_EQ (c.size (), ct.size ());
+  ASSERT_EQ (c.size (), ct_d.size ());
+  for (size_t i = 0; i < c.size (); ++i)
+  {
+    if (i == 42)
+    {
+      // Invalid points are left untouched
+      EXPECT_EQ (c[i].x, ct[i].x);
+      EXPECT_EQ (c[i].normal_x, ct[i].normal_x);
+      EXPECT_EQ (c[i].x, c_inplace[i].x);
+      continue;
+    }
+    Eigen::Vector3f p = transform * c[i].getVector3fMap ();
+    Eigen::Vector3f n = transform.linear () * c[i].getNormalVector3fMap ();
+    for (int d = 0; d < 3; ++d)
+    {
+      EXPECT_NEAR (p[d], ct[i].data[d], 1e-4);
+      EXPECT_NEAR (n[d], ct[i].data_n[d], 1e-5);
+      EXPECT_NEAR (p[d], ct_d[i].data[d], 1e-4);
+      EXPECT_NEAR (n[d], ct_d[i].data_n[d], 1e-5);
+      EXPECT_NEAR (p[d], c_inplace[i].data[d], 1e-4);
+      // Only the points are transformed
+      EXPECT_EQ (c[i].data_n[d], c_inplace[i].data_n[d]);
+    }
+    // The padding of the 4D point and normal is kept
+    EXPECT_EQ (1.0f, ct[i].data[3]);
+    EXPECT_EQ (0.0f, ct[i].data_n[3]);
+    EXPECT_EQ (1.0f, ct_d[i].data[3]);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+// Point types without the PCL_ADD_POINT4D / PCL_ADD_NORMAL4D unions go through their fields
+struct PlainPointNormal
+{
+  float label;
+  float x, y, z;
+  float normal_x, normal_y, normal_z;
+};
+
+TEST (PCL, TransformPlainPointType)
+{
+  PointCloud<PlainPointNormal> c, ct;
+  c.resize (10);
+  for (size_t i = 0; i < c.size (); ++i)
+  {
+    c[i].label = static_cast<float> (i);
+    c[i].x = static_cast<float> (i);
+    c[i].y = 1.0f - static_cast<float> (i);
+    c[i].z = 0.5f * static_cast<float> (i);
+    c[i].normal_x = 0.0f;
+    c[i].normal_y = 0.6f;
+    c[i].normal_z = 0.8f;
+  }
+  Eigen::Affine3f transform = Eigen::Translation3f (1.0f, -2.0f, 3.0f) *
+                              Eigen::AngleAxisf (0.7f, Eigen::Vector3f (1.0f, 1.0f, -1.0f).normalized ());
+
+  transformPointCloudWithNormals (c, ct, transform);
+  ASSERT_EQ (c.size (), ct.size ());
+  for (size_t i = 0; i < c.size (); ++i)
+  {
+    Eigen::Vector3f p = transform * Eigen::Vector3f (c[i].x, c[i].y, c[i].z);
+    Eigen::Vector3f n = transform.linear () * Eigen::Vector3f (c[i].normal_x, c[i].normal_y, c[i].normal_z);
+    EXPECT_NEAR (p[0], ct[i].x, 1e-4);
+    EXPECT_NEAR (p[1], ct[i].y, 1e-4);
+    EXPECT_NEAR (p[2], ct[i].z, 1e-4);
+    EXPECT_NEAR (n[0], ct[i].normal_x, 1e-5);
+    EXPECT_NEAR (n[1], ct[i].normal_y, 1e-5);
+    EXPECT_NEAR (n[2], ct[i].normal_z, 1e-5);
+    EXPECT_EQ (c[i].label, ct[i].label);
+  }
+
+  transformPointCloud (c, transform);
+  for (size_t i = 0; i < c.size (); ++i)
+  {
+    EXPECT_NEAR (ct[i].x, c[i].x, 1e-6);
+    EXPECT_NEAR (ct[i].y, c[i].y, 1e-6);
+    EXPECT_NEAR (ct[i].z, c[i].z, 1e-6);
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////
 TEST (PCL, commonTransform)
 {
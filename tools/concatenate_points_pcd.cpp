@@ -45,6 +45,8 @@
 **/
 
 #include <iostream>
+#include <cstdio>
+#include <pcl/console/parse.h>
 #include <pcl/console/time.h>
 #include <pcl/io/pcd_io.h>
 #include <pcl/point_types.h>
@@ -103,7 +105,7 @@ loadCloud (const std::string &filename, pcl::PCLPointCloud2 &cloud)
   return (true);
 }
 
-void
+bool
 saveCloud (const std::string &filename, const pcl::PCLPointCloud2 &output)
 {
   using namespace pcl::console;
@@ -113,11 +115,43 @@ saveCloud (const std::string &filename, const pcl::PCLPointCloud2 &output)
   print_highlight ("Saving "); print_value ("%s ", filename.c_str ());
 
   pcl::PCDWriter w;
-  w.writeBinaryCompressed (filename, output, translation, orientation);
+  if (w.writeBinaryCompressed (filename, output, translation, orientation) < 0)
+    return (false);
   
   print_info ("[done, "); print_value ("%g", tt.toc ()); print_info (" ms : "); print_value ("%d", output.width * output.height); print_info (" points]\n");
+  return (true);
 }
 
+bool
+appendCloud (const std::string &filename, pcl::PCDStreamWriter &writer)
+{
+  using namespace pcl::console;
+  TicToc tt;
+  print_highlight ("Appending "); print_value ("%s ", filename.c_str ());
+
+  tt.tic ();
+  pcl::PCDStreamReader reader;
+  if (reader.open (filename) < 0)
+    return (false);
+
+  // Create the output file with the fields of the first cloud
+  if (!writer.isOpen () &&
+      writer.open ("output.pcd", reader.getHeader (), reader.getOrigin (), reader.getOrientation ()) < 0)
+    return (false);
+
+  // Copy the points by pieces, so that the clouds never need to fit in memory
+  pcl::PCLPointCloud2 cloud;
+  int nr_points;
+  while ((nr_points = reader.readNext (1000000, cloud)) > 0)
+    if (writer.append (cloud) < 0)
+      return (false);
+  if (nr_points < 0)
+    return (false);
+  print_info ("[done, "); print_value ("%g", tt.toc ()); print_info (" ms : "); print_value ("%d", reader.getNumberOfPoints ()); print_info (" points]\n");
+  print_info ("Available dimensions: "); print_value ("%s\n", pcl::getFieldsList (reader.getHeader ()).c_str ());
+
+  return (true);
+}
 
 /* ---[ */
 int
@@ -125,28 +159,58 @@ main (int argc, char** argv)
 {
   if (argc < 2)
   {
-    std::cerr << "Syntax is: " << argv[0] << " <filename 1..N.pcd>" << std::endl;
+    std::cerr << "Syntax is: " << argv[0] << " [-stream 0|1] <filename 1..N.pcd>" << std::endl;
     std::cerr << "Result will be saved to output.pcd" << std::endl;
+    std::cerr << "  -stream 1 copies the points into a binary output.pcd by pieces, without loading the clouds" << std::endl;
+    std::cerr << "            (default 0: the clouds are loaded and output.pcd is binary_compressed)" << std::endl;
     return (-1);
   }
 
   std::vector<int> file_indices = parseFileExtensionArgument (argc, argv, ".pcd");
+  bool stream = false;
+  pcl::console::parse_argument (argc, argv, "-stream", stream);
+
+  if (!stream)
+  {
+    pcl::PCLPointCloud2 cloud_all;
+    for (size_t i = 0; i < file_indices.size (); ++i)
+    {
+      // Load the Point Cloud
+      pcl::PCLPointCloud2 cloud;
+      if (!loadCloud (argv[file_indices[i]], cloud))
+      {
+        pcl::console::print_error ("Failed to load %s, output.pcd was not written.\n", argv[file_indices[i]]);
+        return (-1);
+      }
+      pcl::concatenatePointCloud (cloud_all, cloud, cloud_all);
+      PCL_INFO ("Total number of points so far: %u. Total data size: %lu bytes.\n", cloud_all.width * cloud_all.height, cloud_all.data.size ());
+    }
 
-  //pcl::PointCloud<pcl::PointXYZ> cloud_all;
-  pcl::PCLPointCloud2 cloud_all;
+    return (saveCloud ("output.pcd", cloud_all) ? 0 : -1);
+  }
+
+  pcl::PCDStreamWriter writer;
   for (size_t i = 0; i < file_indices.size (); ++i)
   {
-    // Load the Point Cloud
-    pcl::PCLPointCloud2 cloud;
-    loadCloud (argv[file_indices[i]], cloud);
-    //pcl::PointCloud<pcl::PointXYZ> cloud;
-    //pcl::io::loadPCDFile (argv[file_indices[i]], cloud);
-    //cloud_all += cloud;
-    pcl::concatenatePointCloud (cloud_all, cloud, cloud_all);
-    PCL_INFO ("Total number of points so far: %u. Total data size: %lu bytes.\n", cloud_all.width * cloud_all.height, cloud_all.data.size ());
+    if (!appendCloud (argv[file_indices[i]], writer))
+    {
+      pcl::console::print_error ("Failed to append %s, output.pcd was not written.\n", argv[file_indices[i]]);
+      // Do not leave a partial output behind
+      if (writer.isOpen ())
+      {
+        writer.close ();
+        std::remove ("output.pcd");
+      }
+      return (-1);
+    }
+    PCL_INFO ("Total number of points so far: %u.\n", writer.getNumberOfPoints ());
   }
 
-  saveCloud ("output.pcd", cloud_all);
+  if (writer.close () < 0)
+  {
+    std::remove ("output.pcd");
+    return (-1);
+  }
   
   return (0);
 }
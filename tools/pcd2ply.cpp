@@ -37,6 +37,7 @@
  *
  */
 
+#include <cstdio>
 #include <pcl/io/pcd_io.h>
 #include <pcl/io/ply_io.h>
 #include <pcl/console/print.h>
@@ -82,6 +83,51 @@ saveCloud (const std::string &filename, const pcl::PCLPointCloud2 &cloud, bool b
   print_info ("[done, "); print_value ("%g", tt.toc ()); print_info (" ms : "); print_value ("%d", cloud.width * cloud.height); print_info (" points]\n");
 }
 
+bool
+convertCloud (const std::string &pcd_filename, const std::string &ply_filename)
+{
+  TicToc tt;
+  tt.tic ();
+
+  print_highlight ("Converting "); print_value ("%s ", pcd_filename.c_str ());
+
+  pcl::PCDStreamReader reader;
+  if (reader.open (pcd_filename) < 0)
+    return (false);
+
+  std::ofstream fs (ply_filename.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!fs)
+  {
+    print_error ("Error during opening (%s)!\n", ply_filename.c_str ());
+    return (false);
+  }
+
+  // The header only needs the fields and the size of the cloud, the points are converted by pieces.
+  // Like saveCloud, write a zero origin and an identity orientation
+  pcl::PLYWriter writer;
+  fs << writer.generateHeaderBinary (reader.getHeader (), Eigen::Vector4f::Zero (), Eigen::Quaternionf::Identity (),
+                                     reader.getNumberOfPoints (), true);
+  pcl::PCLPointCloud2 cloud;
+  int nr_points;
+  while ((nr_points = reader.readNext (1000000, cloud)) > 0 && fs)
+    writer.writeBinaryVertices (fs, cloud);
+  if (nr_points >= 0 && fs)
+    writer.writeBinaryCamera (fs, Eigen::Vector4f::Zero (), Eigen::Quaternionf::Identity (),
+                              reader.getHeader ().width, reader.getHeader ().height);
+  fs.close ();
+
+  // Do not leave a partial output behind
+  if (nr_points < 0 || fs.fail ())
+  {
+    print_error ("Error during writing (%s)!\n", ply_filename.c_str ());
+    std::remove (ply_filename.c_str ());
+    return (false);
+  }
+
+  print_info ("[done, "); print_value ("%g", tt.toc ()); print_info (" ms : "); print_value ("%d", reader.getNumberOfPoints ()); print_info (" points]\n");
+  return (true);
+}
+
 /* ---[ */
 int
 main (int argc, char** argv)
@@ -111,6 +157,10 @@ main (int argc, char** argv)
   print_info ("PLY output format: "); print_value ("%s, ", (format ? "binary" : "ascii"));
   print_value ("%s\n", (use_camera ? "using camera" : "no camera"));
 
+  // Binary PLY files with a camera can be written as the PCD file is read, in constant memory
+  if (format && use_camera)
+    return (convertCloud (argv[pcd_file_indices[0]], argv[ply_file_indices[0]]) ? 0 : -1);
+
   // Load the first file
   pcl::PCLPointCloud2 cloud;
   if (!loadCloud (argv[pcd_file_indices[0]], cloud)) 
@@ -39,6 +39,12 @@
 #include <pcl/console/print.h>
 #include <pcl/console/parse.h>
 #include <pcl/console/time.h>
+#include <boost/filesystem.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace std;
 using namespace pcl;
@@ -51,40 +57,96 @@ printHelp (int, char **argv)
   print_error ("Syntax is: %s input.xyz output.pcd\n", argv[0]);
 }
 
+/** \brief Parse the points of the lines in [begin, end) that hold exactly three values. */
+void
+parsePoints (const char *begin, const char *end, PointCloud<PointXYZ>::VectorType &points)
+{
+  for (const char *line = begin; line < end; )
+  {
+    const char *line_end = static_cast<const char*> (memchr (line, '\n', end - line));
+    if (!line_end)
+      line_end = end;
+
+    // Find the values of the line, without splitting it
+    const char *values[4][2];
+    int nr_values = 0;
+    for (const char *p = line; p != line_end && nr_values < 4; )
+    {
+      while (p != line_end && (*p == ' ' || *p == '\t' || *p == '\r'))
+        ++p;
+      if (p == line_end)
+        break;
+      values[nr_values][0] = p;
+      while (p != line_end && *p != ' ' && *p != '\t' && *p != '\r')
+        ++p;
+      values[nr_values++][1] = p;
+    }
+    line = line_end + 1;
+
+    if (nr_values != 3)
+      continue;
+
+    PointXYZ point;
+    parseStringValue (values[0][0], values[0][1], point.x);
+    parseStringValue (values[1][0], values[1][1], point.y);
+    parseStringValue (values[2][0], values[2][1], point.z);
+    points.push_back (point);
+  }
+}
+
 bool
 loadCloud (const string &filename, PointCloud<PointXYZ> &cloud)
 {
-  ifstream fs;
-  fs.open (filename.c_str (), ios::binary);
-  if (!fs.is_open () || fs.fail ())
+  cloud.width = 0; cloud.height = 1; cloud.is_dense = true;
+  cloud.points.clear ();
+
+  // Map the file and parse it in place
+  boost::iostreams::mapped_file_source file;
+  try
   {
-    PCL_ERROR ("Could not open file '%s'! Error : %s\n", filename.c_str (), strerror (errno)); 
-    fs.close ();
+    if (boost::filesystem::file_size (filename) == 0)
+      return (true);
+    file.open (filename);
+  }
+  catch (const std::exception &e)
+  {
+    PCL_ERROR ("Could not open file '%s'! Error : %s\n", filename.c_str (), e.what ());
     return (false);
   }
-  
-  string line;
-  vector<string> st;
-
-  while (!fs.eof ())
+  if (!file.is_open ())
   {
-    getline (fs, line);
-    // Ignore empty lines
-    if (line == "")
-      continue;
-
-    // Tokenize the line
-    boost::trim (line);
-    boost::split (st, line, boost::is_any_of ("\t\r "), boost::token_compress_on);
-
-    if (st.size () != 3)
-      continue;
+    PCL_ERROR ("Could not map file '%s'!\n", filename.c_str ());
+    return (false);
+  }
 
-    cloud.push_back (PointXYZ (float (atof (st[0].c_str ())), float (atof (st[1].c_str ())), float (atof (st[2].c_str ()))));
+  // Split the data in one block of whole lines per thread, the blocks are concatenated in order
+  const char *data = file.data ();
+  const char *data_end = data + file.size ();
+  int nr_threads = 1;
+#ifdef _OPENMP
+  nr_threads = omp_get_num_procs ();
+#endif
+  const int nr_blocks = static_cast<int> (std::max<size_t> (1, std::min<size_t> (nr_threads, file.size () / 65536 + 1)));
+  vector<const char*> blocks (nr_blocks + 1, data_end);
+  blocks[0] = data;
+  for (int b = 1; b < nr_blocks; ++b)
+  {
+    const char *p = std::max (data + (data_end - data) * static_cast<ptrdiff_t> (b) / nr_blocks, blocks[b - 1]);
+    p = static_cast<const char*> (memchr (p, '\n', data_end - p));
+    blocks[b] = p ? p + 1 : data_end;
   }
-  fs.close ();
 
-  cloud.width = uint32_t (cloud.size ()); cloud.height = 1; cloud.is_dense = true;
+  vector<PointCloud<PointXYZ>::VectorType> block_points (nr_blocks);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nr_blocks)
+#endif
+  for (int b = 0; b < nr_blocks; ++b)
+    parsePoints (blocks[b], blocks[b + 1], block_points[b]);
+  file.close ();
+
+  for (int b = 0; b < nr_blocks; ++b)
+    cloud.points.insert (cloud.points.end (), block_points[b].begin (), block_points[b].end ());
+  cloud.width = uint32_t (cloud.size ());
   return (true);
 }
 